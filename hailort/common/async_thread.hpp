@@ -12,6 +12,8 @@
 #include <functional>
 #include <thread>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
 
 namespace hailort
 {
@@ -57,6 +59,95 @@ private:
 template<typename T>
 using AsyncThreadPtr = std::unique_ptr<AsyncThread<T>>;
 
+/**
+ * Like AsyncThread, but the thread is kept alive between functions, so running a function asynchronously doesn't
+ * cost a thread creation each time. Call run() to start a function and get() to wait for its result (only one
+ * function can run at a time).
+ */
+template<typename T>
+class ReusableThread final {
+public:
+    ReusableThread() :
+        m_func(),
+        m_result(),
+        m_has_result(false),
+        m_is_running(true),
+        m_thread([this]() {
+            worker_loop();
+        })
+    {}
+
+    ~ReusableThread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_is_running = false;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    /**
+     * NOTE! this object is not moveable by purpose, see AsyncThread.
+     */
+    ReusableThread(const ReusableThread<T> &) = delete;
+    ReusableThread(ReusableThread<T> &&other) = delete;
+    ReusableThread<T>& operator=(const ReusableThread<T>&) = delete;
+    ReusableThread<T>& operator=(ReusableThread<T> &&) = delete;
+
+    void run(std::function<T(void)> func)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_func = std::move(func);
+            m_has_result = false;
+        }
+        m_cv.notify_all();
+    }
+
+    T get()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_has_result; });
+        m_has_result = false;
+        return std::move(m_result);
+    }
+
+private:
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this] { return !m_is_running || (nullptr != m_func); });
+            if (!m_is_running) {
+                return;
+            }
+
+            auto func = std::move(m_func);
+            m_func = nullptr;
+            lock.unlock();
+            auto result = func();
+            lock.lock();
+
+            m_result = std::move(result);
+            m_has_result = true;
+            m_cv.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::function<T(void)> m_func;
+    T m_result;
+    bool m_has_result;
+    bool m_is_running;
+    // Must be the last member, so the thread starts after all other members are initialized
+    std::thread m_thread;
+};
+
+template<typename T>
+using ReusableThreadPtr = std::unique_ptr<ReusableThread<T>>;
+
 } /* namespace hailort */
 
 #endif /* _ASYNC_THREAD_HPP_ */
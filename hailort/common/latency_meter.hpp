@@ -12,6 +12,7 @@
 
 #include "hailo/expected.hpp"
 #include "common/circular_buffer.hpp"
+#include "common/runtime_statistics_internal.hpp"
 
 #include <set>
 #include <mutex>
@@ -32,7 +33,8 @@ public:
     explicit LatencyMeter(const std::set<std::string> &output_names, size_t timestamps_list_length) :
         m_start_timestamps(timestamps_list_length),
         m_latency_count(0),
-        m_latency_sum(0)
+        m_latency_sum(0),
+        m_latency_histogram("latency")
     {
         for (auto &ch : output_names) {
             m_end_timestamps_per_channel.emplace(ch, TimestampsArray(timestamps_list_length));
@@ -78,11 +80,26 @@ public:
         if (clear) {
             m_latency_sum = duration();
             m_latency_count = 0;
+            m_latency_histogram.get_and_clear();
         }
 
         return latency;
     }
 
+    /**
+     * Queries a percentile (e.g. 99.9) of the latency measured since the last clear (see get_latency).
+     */
+    Expected<duration> get_latency_percentile(double percentile)
+    {
+        std::lock_guard<std::mutex> lock_guard(m_lock);
+
+        auto latency_sec = m_latency_histogram.percentile(percentile);
+        if (!latency_sec) {
+            return make_unexpected(latency_sec.status());
+        }
+        return std::chrono::duration_cast<duration>(std::chrono::duration<double>(latency_sec.value()));
+    }
+
 private:
     void update_latency()
     {
@@ -107,6 +124,7 @@ private:
         // calculate the latency
         m_latency_sum += (end - start);
         m_latency_count++;
+        m_latency_histogram.add_data_point(std::chrono::duration<double>(end - start).count());
 
         // pop fronts
         m_start_timestamps.pop_front();
@@ -122,6 +140,7 @@ private:
 
     size_t m_latency_count;
     duration m_latency_sum;
+    HistogramAccumulator<double> m_latency_histogram; // In seconds
 };
 
 using LatencyMeterPtr = std::shared_ptr<LatencyMeter>;
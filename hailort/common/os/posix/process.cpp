@@ -12,6 +12,8 @@
 #include "common/utils.hpp"
 #include "hailo/buffer.hpp"
 
+#include <sys/resource.h>
+
 namespace hailort
 {
 
@@ -25,6 +27,17 @@ Expected<std::pair<int32_t, std::string>> Process::create_and_wait_for_output(co
     return std::make_pair(process_exit_code, output_expected.value());
 }
 
+Expected<std::chrono::microseconds> Process::get_cpu_time()
+{
+    struct rusage usage = {};
+    CHECK_AS_EXPECTED(0 == getrusage(RUSAGE_SELF, &usage), HAILO_INTERNAL_FAILURE, "getrusage failed with errno {}", errno);
+
+    const auto to_microseconds = [](const struct timeval &time) {
+        return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+    };
+    return to_microseconds(usage.ru_utime) + to_microseconds(usage.ru_stime);
+}
+
 Expected<Process::PopenWrapper> Process::PopenWrapper::create(const std::string &command_line)
 {
     hailo_status status = HAILO_UNINITIALIZED;
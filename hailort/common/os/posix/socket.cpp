@@ -15,8 +15,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <string.h>
 #include <array>
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/udp.h>
+#include <linux/net_tstamp.h>
+#include <time.h>
+#endif
+
 namespace hailort
 {
 
@@ -208,6 +217,42 @@ hailo_status Socket::enable_broadcast()
     return HAILO_SUCCESS;
 }
 
+static hailo_status get_send_error_status(int error)
+{
+    if ((EWOULDBLOCK == error) || (EAGAIN == error)) {
+        LOGGER__ERROR("Udp send timeout");
+        return HAILO_TIMEOUT;
+    } else if (EINTR == error) {
+        LOGGER__ERROR("Udp send interrupted!");
+        return HAILO_INTERRUPTED_BY_SIGNAL;
+    } else if (EPIPE == error) {
+        // When socket is aborted from another thread sendto will return errno EPIPE
+        LOGGER__INFO("Udp send aborted!");
+        return HAILO_STREAM_ABORTED_BY_USER;
+    } else {
+        LOGGER__ERROR("Udp failed to send data, errno:{}.", error);
+        return HAILO_ETH_SEND_FAILURE;
+    }
+}
+
+static hailo_status get_recv_error_status(int error, bool log_timeouts_in_debug)
+{
+    if ((EWOULDBLOCK == error) || (EAGAIN == error)) {
+        if (log_timeouts_in_debug) {
+            LOGGER__DEBUG("Udp recvfrom failed with timeout");
+        } else {
+            LOGGER__ERROR("Udp recvfrom failed with timeout");
+        }
+        return HAILO_TIMEOUT;
+    } else if (EINTR == error) {
+        LOGGER__ERROR("Udp recv interrupted!");
+        return HAILO_INTERRUPTED_BY_SIGNAL;
+    } else {
+        LOGGER__ERROR("Udp failed to recv data");
+        return HAILO_ETH_RECV_FAILURE;
+    }
+}
+
 hailo_status Socket::send_to(const uint8_t *src_buffer, size_t src_buffer_size, int flags,
     const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *bytes_sent)
 {
@@ -221,20 +266,7 @@ hailo_status Socket::send_to(const uint8_t *src_buffer, size_t src_buffer_size,
     number_of_sent_bytes = sendto(m_socket_fd, src_buffer, src_buffer_size, flags,
         dest_addr,  dest_addr_size);
     if (-1 == number_of_sent_bytes) {
-        if ((EWOULDBLOCK == errno) || (EAGAIN == errno)) {
-            LOGGER__ERROR("Udp send timeout");
-            return HAILO_TIMEOUT;
-        } else if (EINTR == errno) {
-            LOGGER__ERROR("Udp send interrupted!");
-            return HAILO_INTERRUPTED_BY_SIGNAL;
-        } else if (EPIPE == errno) {
-            // When socket is aborted from another thread sendto will return errno EPIPE
-            LOGGER__INFO("Udp send aborted!");
-            return HAILO_STREAM_ABORTED_BY_USER;
-        } else {
-            LOGGER__ERROR("Udp failed to send data, errno:{}.", errno);
-            return HAILO_ETH_SEND_FAILURE;
-        }
+        return get_send_error_status(errno);
     }
 
     *bytes_sent = (size_t)number_of_sent_bytes;
@@ -255,20 +287,7 @@ hailo_status Socket::recv_from(uint8_t *dest_buffer, size_t dest_buffer_size, in
     number_of_received_bytes = recvfrom(m_socket_fd, dest_buffer, dest_buffer_size, flags,
         src_addr, &result_src_addr_size);
     if (-1 == number_of_received_bytes) {
-        if ((EWOULDBLOCK == errno) || (EAGAIN == errno)) {
-            if (log_timeouts_in_debug) {
-                LOGGER__DEBUG("Udp recvfrom failed with timeout");
-            } else {
-                LOGGER__ERROR("Udp recvfrom failed with timeout");
-            }
-            return HAILO_TIMEOUT;
-        } else if (EINTR == errno) {
-            LOGGER__ERROR("Udp recv interrupted!");
-            return HAILO_INTERRUPTED_BY_SIGNAL;
-        } else {
-            LOGGER__ERROR("Udp failed to recv data");
-            return HAILO_ETH_RECV_FAILURE;
-        }
+        return get_recv_error_status(errno, log_timeouts_in_debug);
     }
     else if ((0 == number_of_received_bytes) && (0 != dest_buffer_size)) {
         LOGGER__INFO("Udp socket was aborted");
@@ -284,6 +303,217 @@ hailo_status Socket::recv_from(uint8_t *dest_buffer, size_t dest_buffer_size, in
     return HAILO_SUCCESS;
 }
 
+hailo_status Socket::enable_tx_time()
+{
+#if defined(__linux__) && defined(SO_TXTIME)
+    struct sock_txtime tx_time_config = {};
+    tx_time_config.clockid = CLOCK_MONOTONIC;
+    if (0 != setsockopt(m_socket_fd, SOL_SOCKET, SO_TXTIME, &tx_time_config, sizeof(tx_time_config))) {
+        LOGGER__DEBUG("Failed to enable SO_TXTIME (errno={})", errno);
+        return HAILO_NOT_SUPPORTED;
+    }
+    return HAILO_SUCCESS;
+#else
+    return HAILO_NOT_SUPPORTED;
+#endif
+}
+
+hailo_status Socket::send_to_multiple(const socket_datagram_t *datagrams, size_t count, const uint8_t *header,
+    size_t header_size, int flags, const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *datagrams_sent)
+{
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(datagrams);
+    CHECK_ARG_NOT_NULL(dest_addr);
+    CHECK_ARG_NOT_NULL(datagrams_sent);
+    CHECK((0 < count) && (count <= MAX_DATAGRAMS_PER_CALL), HAILO_INVALID_ARGUMENT,
+        "Invalid datagrams count {} (max {})", count, MAX_DATAGRAMS_PER_CALL);
+    CHECK((0 == header_size) || (nullptr != header), HAILO_INVALID_ARGUMENT, "Datagram header is null");
+
+#if defined(__linux__)
+    std::array<struct mmsghdr, MAX_DATAGRAMS_PER_CALL> messages{};
+    std::array<std::array<struct iovec, 2>, MAX_DATAGRAMS_PER_CALL> iovecs{};
+    union tx_time_control_t {
+        char buffer[CMSG_SPACE(sizeof(uint64_t))];
+        struct cmsghdr align;
+    };
+    std::array<tx_time_control_t, MAX_DATAGRAMS_PER_CALL> controls{};
+    for (size_t i = 0; i < count; i++) {
+        size_t iovecs_count = 0;
+        if (0 < header_size) {
+            iovecs[i][iovecs_count++] = {const_cast<uint8_t*>(header), header_size};
+        }
+        iovecs[i][iovecs_count++] = {datagrams[i].buffer, datagrams[i].size};
+
+        messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(dest_addr);
+        messages[i].msg_hdr.msg_namelen = dest_addr_size;
+        messages[i].msg_hdr.msg_iov = iovecs[i].data();
+        messages[i].msg_hdr.msg_iovlen = iovecs_count;
+
+#if defined(SO_TXTIME)
+        if (0 != datagrams[i].tx_time_ns) {
+            messages[i].msg_hdr.msg_control = controls[i].buffer;
+            messages[i].msg_hdr.msg_controllen = sizeof(controls[i].buffer);
+            auto *cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_TXTIME;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+            memcpy(CMSG_DATA(cmsg), &datagrams[i].tx_time_ns, sizeof(uint64_t));
+        }
+#endif
+    }
+
+    auto number_of_sent_datagrams = sendmmsg(m_socket_fd, messages.data(), static_cast<unsigned int>(count), flags);
+    if (-1 == number_of_sent_datagrams) {
+        return get_send_error_status(errno);
+    }
+
+    *datagrams_sent = static_cast<size_t>(number_of_sent_datagrams);
+    return HAILO_SUCCESS;
+#else
+    // No sendmmsg, so each datagram is sent by its own call (the header is gathered by sendmsg)
+    for (size_t i = 0; i < count; i++) {
+        std::array<struct iovec, 2> iovecs{};
+        size_t iovecs_count = 0;
+        if (0 < header_size) {
+            iovecs[iovecs_count++] = {const_cast<uint8_t*>(header), header_size};
+        }
+        iovecs[iovecs_count++] = {datagrams[i].buffer, datagrams[i].size};
+
+        struct msghdr message = {};
+        message.msg_name = const_cast<sockaddr*>(dest_addr);
+        message.msg_namelen = dest_addr_size;
+        message.msg_iov = iovecs.data();
+        message.msg_iovlen = static_cast<int>(iovecs_count);
+        if (-1 == sendmsg(m_socket_fd, &message, flags)) {
+            if (0 < i) {
+                // The error will be returned by the next call
+                *datagrams_sent = i;
+                return HAILO_SUCCESS;
+            }
+            return get_send_error_status(errno);
+        }
+    }
+
+    *datagrams_sent = count;
+    return HAILO_SUCCESS;
+#endif
+}
+
+hailo_status Socket::recv_from_multiple(socket_datagram_t *datagrams, size_t count, int flags, sockaddr *src_addr,
+    socklen_t src_addr_size, size_t *datagrams_received)
+{
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(datagrams);
+    CHECK_ARG_NOT_NULL(src_addr);
+    CHECK_ARG_NOT_NULL(datagrams_received);
+    CHECK((0 < count) && (count <= MAX_DATAGRAMS_PER_CALL), HAILO_INVALID_ARGUMENT,
+        "Invalid datagrams count {} (max {})", count, MAX_DATAGRAMS_PER_CALL);
+
+#if defined(__linux__)
+    std::array<struct mmsghdr, MAX_DATAGRAMS_PER_CALL> messages{};
+    std::array<struct iovec, MAX_DATAGRAMS_PER_CALL> iovecs{};
+    for (size_t i = 0; i < count; i++) {
+        iovecs[i] = {datagrams[i].buffer, datagrams[i].size};
+        // All of the datagrams come from the same address, so they all write it to src_addr
+        messages[i].msg_hdr.msg_name = src_addr;
+        messages[i].msg_hdr.msg_namelen = src_addr_size;
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // MSG_WAITFORONE - the socket timeout applies only to the first datagram, the rest are received if they're ready
+    auto number_of_received_datagrams = recvmmsg(m_socket_fd, messages.data(), static_cast<unsigned int>(count),
+        flags | MSG_WAITFORONE, nullptr);
+    if (-1 == number_of_received_datagrams) {
+        return get_recv_error_status(errno, false);
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(number_of_received_datagrams); i++) {
+        if ((0 == messages[i].msg_len) && (0 != datagrams[i].size)) {
+            LOGGER__INFO("Udp socket was aborted");
+            return HAILO_STREAM_ABORTED_BY_USER;
+        }
+        CHECK(0 == (messages[i].msg_hdr.msg_flags & MSG_TRUNC), HAILO_ETH_RECV_FAILURE,
+            "Received a datagram larger than its buffer ({} bytes)", datagrams[i].size);
+        CHECK(messages[i].msg_hdr.msg_namelen <= src_addr_size, HAILO_ETH_RECV_FAILURE, "src_addr size invalid");
+        datagrams[i].size = messages[i].msg_len;
+    }
+
+    *datagrams_received = static_cast<size_t>(number_of_received_datagrams);
+    return HAILO_SUCCESS;
+#else
+    // No recvmmsg, so a single datagram is received
+    size_t number_of_received_bytes = 0;
+    auto status = recv_from(datagrams[0].buffer, datagrams[0].size, flags, src_addr, src_addr_size,
+        &number_of_received_bytes);
+    if (HAILO_SUCCESS != status) {
+        return status;
+    }
+
+    datagrams[0].size = number_of_received_bytes;
+    *datagrams_received = 1;
+    return HAILO_SUCCESS;
+#endif
+}
+
+hailo_status Socket::send_to_segmented(const uint8_t *src_buffer, size_t src_buffer_size, size_t segment_size, int flags,
+    const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *bytes_sent)
+{
+#if defined(__linux__) && defined(UDP_SEGMENT)
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(src_buffer);
+    CHECK_ARG_NOT_NULL(dest_addr);
+    CHECK_ARG_NOT_NULL(bytes_sent);
+    CHECK((0 < segment_size) && (segment_size <= MAX_UDP_PAYLOAD_SIZE), HAILO_INVALID_ARGUMENT,
+        "Invalid segment size {}", segment_size);
+    CHECK((src_buffer_size <= MAX_SEGMENTED_SEND_SIZE) && (src_buffer_size <= (segment_size * MAX_SEGMENTS_PER_CALL)),
+        HAILO_INVALID_ARGUMENT, "Too many bytes ({}) for a segmented send (segment size {})", src_buffer_size, segment_size);
+
+    struct iovec iov = {const_cast<uint8_t*>(src_buffer), src_buffer_size};
+    union {
+        char buffer[CMSG_SPACE(sizeof(uint16_t))];
+        struct cmsghdr align;
+    } control = {};
+
+    struct msghdr message = {};
+    message.msg_name = const_cast<sockaddr*>(dest_addr);
+    message.msg_namelen = dest_addr_size;
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    auto *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    const auto gso_size = static_cast<uint16_t>(segment_size);
+    memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+    auto number_of_sent_bytes = sendmsg(m_socket_fd, &message, flags);
+    if (-1 == number_of_sent_bytes) {
+        // EIO - the outgoing interface doesn't support checksum offload (required for segmentation)
+        if ((EIO == errno) || (EINVAL == errno) || (ENOPROTOOPT == errno) || (EOPNOTSUPP == errno)) {
+            LOGGER__DEBUG("Udp segmentation offload isn't supported (errno={})", errno);
+            return HAILO_NOT_SUPPORTED;
+        }
+        return get_send_error_status(errno);
+    }
+
+    *bytes_sent = static_cast<size_t>(number_of_sent_bytes);
+    return HAILO_SUCCESS;
+#else
+    (void)src_buffer;
+    (void)src_buffer_size;
+    (void)segment_size;
+    (void)flags;
+    (void)dest_addr;
+    (void)dest_addr_size;
+    (void)bytes_sent;
+    return HAILO_NOT_SUPPORTED;
+#endif
+}
+
 hailo_status Socket::has_data(sockaddr *src_addr, socklen_t src_addr_size, bool log_timeouts_in_debug)
 {
     hailo_status status = HAILO_UNINITIALIZED;
@@ -22,4 +22,21 @@ Expected<std::pair<int32_t, std::string>> Process::create_and_wait_for_output(co
     return make_unexpected(HAILO_NOT_IMPLEMENTED);
 }
 
+Expected<std::chrono::microseconds> Process::get_cpu_time()
+{
+    FILETIME creation_time{};
+    FILETIME exit_time{};
+    FILETIME kernel_time{};
+    FILETIME user_time{};
+    CHECK_AS_EXPECTED(GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time),
+        HAILO_INTERNAL_FAILURE, "GetProcessTimes failed with {}", GetLastError());
+
+    // FILETIME is measured in 100-nanosecond units
+    const auto to_microseconds = [](const FILETIME &time) {
+        const uint64_t time_100ns = (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        return std::chrono::microseconds(time_100ns / 10);
+    };
+    return to_microseconds(kernel_time) + to_microseconds(user_time);
+}
+
 } /* namespace hailort */
@@ -195,6 +195,12 @@ hailo_status Socket::enable_broadcast()
     return HAILO_SUCCESS;
 }
 
+hailo_status Socket::enable_tx_time()
+{
+    // Windows has no way to schedule the send time of a datagram
+    return HAILO_NOT_SUPPORTED;
+}
+
 hailo_status Socket::send_to(const uint8_t *src_buffer, size_t src_buffer_size, int flags,
     const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *bytes_sent)
 {
@@ -254,6 +260,80 @@ hailo_status Socket::recv_from(uint8_t *dest_buffer, size_t dest_buffer_size, in
     return HAILO_SUCCESS;
 }
 
+hailo_status Socket::send_to_multiple(const socket_datagram_t *datagrams, size_t count, const uint8_t *header,
+    size_t header_size, int flags, const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *datagrams_sent)
+{
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(datagrams);
+    CHECK_ARG_NOT_NULL(dest_addr);
+    CHECK_ARG_NOT_NULL(datagrams_sent);
+    CHECK((0 == header_size) || (nullptr != header), HAILO_INVALID_ARGUMENT, "Datagram header is null");
+
+    // There's no sendmmsg on windows, so each datagram is sent by its own call (the header is gathered by WSASendTo)
+    for (size_t i = 0; i < count; i++) {
+        std::array<WSABUF, 2> buffers{};
+        DWORD buffers_count = 0;
+        if (0 < header_size) {
+            buffers[buffers_count].buf = reinterpret_cast<char*>(const_cast<uint8_t*>(header));
+            buffers[buffers_count].len = static_cast<ULONG>(header_size);
+            buffers_count++;
+        }
+        buffers[buffers_count].buf = reinterpret_cast<char*>(datagrams[i].buffer);
+        buffers[buffers_count].len = static_cast<ULONG>(datagrams[i].size);
+        buffers_count++;
+
+        DWORD number_of_sent_bytes = 0;
+        auto socket_rc = WSASendTo(m_socket_fd, buffers.data(), buffers_count, &number_of_sent_bytes, flags, dest_addr,
+            dest_addr_size, nullptr, nullptr);
+        if (SOCKET_ERROR == socket_rc) {
+            const int wsale = WSAGetLastError();
+            if (0 < i) {
+                // The error will be returned by the next call
+                *datagrams_sent = i;
+                return HAILO_SUCCESS;
+            }
+            if (WSAETIMEDOUT == wsale) {
+                LOGGER__ERROR("Udp send timeout");
+                return HAILO_TIMEOUT;
+            } else {
+                LOGGER__ERROR("Udp failed to send data, WSALE={}.", wsale);
+                return HAILO_ETH_SEND_FAILURE;
+            }
+        }
+    }
+
+    *datagrams_sent = count;
+    return HAILO_SUCCESS;
+}
+
+hailo_status Socket::recv_from_multiple(socket_datagram_t *datagrams, size_t count, int flags, sockaddr *src_addr,
+    socklen_t src_addr_size, size_t *datagrams_received)
+{
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(datagrams);
+    CHECK_ARG_NOT_NULL(datagrams_received);
+    CHECK(0 < count, HAILO_INVALID_ARGUMENT, "No datagrams to receive");
+
+    // There's no recvmmsg on windows, so a single datagram is received
+    size_t number_of_received_bytes = 0;
+    auto status = recv_from(datagrams[0].buffer, datagrams[0].size, flags, src_addr, src_addr_size,
+        &number_of_received_bytes);
+    if (HAILO_SUCCESS != status) {
+        return status;
+    }
+
+    datagrams[0].size = number_of_received_bytes;
+    *datagrams_received = 1;
+    return HAILO_SUCCESS;
+}
+
+hailo_status Socket::send_to_segmented(const uint8_t * /* src_buffer */, size_t /* src_buffer_size */,
+    size_t /* segment_size */, int /* flags */, const sockaddr * /* dest_addr */, socklen_t /* dest_addr_size */,
+    size_t * /* bytes_sent */)
+{
+    return HAILO_NOT_SUPPORTED;
+}
+
 hailo_status Socket::has_data(sockaddr *src_addr, socklen_t src_addr_size, bool log_timeouts_in_debug)
 {
     int number_of_received_bytes = SOCKET_ERROR;
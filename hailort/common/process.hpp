@@ -16,6 +16,7 @@
 #include "hailo/expected.hpp"
 
 #include <string>
+#include <chrono>
 
 namespace hailort
 {
@@ -27,6 +28,8 @@ public:
     // * If the process' output size exceeds max_output_size, the output will be truncated to max_output_size
     // * We remove the trailing newline if it's the last char
     static Expected<std::pair<int32_t, std::string>> create_and_wait_for_output(const std::string &command_line, uint32_t max_output_size);
+    // Returns the CPU time (user + system) consumed by the current process so far
+    static Expected<std::chrono::microseconds> get_cpu_time();
     Process() = delete;
 
 private:
@@ -4,7 +4,7 @@
  **/
 /**
  * @file runtime_statistics_internal.hpp
- * @brief Implementation of Accumulator<T> interface
+ * @brief Implementations of Accumulator<T> interface
  **/
 
 #ifndef _HAILO_RUNTIME_STATISTICS_INTERNAL_HPP_
@@ -12,9 +12,12 @@
 
 #include "hailo/runtime_statistics.hpp"
 
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <mutex>
 #include <limits>
+#include <vector>
 
 namespace hailort
 {
@@ -212,6 +215,329 @@ private:
     T m_sum; // the sum of data added with add_data_point, before inversion
 };
 
+/*! Mergeable snapshot of the values added to a HistogramAccumulator */
+class HistogramSnapshot final
+{
+public:
+    // Log-linear (HDR style) buckets: each power of two in [2^MIN_EXPONENT, 2^MAX_EXPONENT) is split into
+    // SUB_BUCKETS_COUNT linear buckets, so a reported percentile is within ~1.6% of the real value.
+    // The range covers latencies from ~60ns (in seconds) up to fps/queue sizes of ~4e9.
+    static constexpr int MIN_EXPONENT = -24;
+    static constexpr int MAX_EXPONENT = 32;
+    static constexpr size_t SUB_BUCKETS_COUNT = 32;
+    // The first bucket holds values below the range (e.g. 0), the last one holds values above it
+    static constexpr size_t BUCKETS_COUNT = ((MAX_EXPONENT - MIN_EXPONENT) * SUB_BUCKETS_COUNT) + 2;
+
+    HistogramSnapshot() :
+        m_buckets(BUCKETS_COUNT, 0),
+        m_count(0),
+        m_sum(0),
+        m_sum_of_squares(0),
+        m_min(std::numeric_limits<double>::infinity()),
+        m_max(-std::numeric_limits<double>::infinity())
+    {}
+
+    static size_t bucket_index(double value)
+    {
+        if (!(value >= std::ldexp(1.0, MIN_EXPONENT))) {
+            // Also catches NaN
+            return 0;
+        }
+        int exponent = 0;
+        // value = mantissa * 2^exponent, where mantissa is in [0.5, 1)
+        const auto mantissa = std::frexp(value, &exponent);
+        if (exponent > MAX_EXPONENT) {
+            return BUCKETS_COUNT - 1;
+        }
+        const auto sub_bucket = std::min(static_cast<size_t>(((2 * mantissa) - 1) * SUB_BUCKETS_COUNT), SUB_BUCKETS_COUNT - 1);
+        return 1 + (static_cast<size_t>(exponent - 1 - MIN_EXPONENT) * SUB_BUCKETS_COUNT) + sub_bucket;
+    }
+
+    // Returns the middle of the bucket's range
+    static double bucket_value(size_t index)
+    {
+        assert((0 < index) && (index < (BUCKETS_COUNT - 1)));
+        const auto octave = static_cast<int>((index - 1) / SUB_BUCKETS_COUNT);
+        const auto sub_bucket = static_cast<double>((index - 1) % SUB_BUCKETS_COUNT);
+        const auto octave_start = std::ldexp(1.0, MIN_EXPONENT + octave);
+        return octave_start * (1 + ((sub_bucket + 0.5) / SUB_BUCKETS_COUNT));
+    }
+
+    void add_bucket(size_t index, uint64_t count)
+    {
+        m_buckets[index] += count;
+        m_count += count;
+    }
+
+    void add_totals(double sum, double sum_of_squares, double min, double max)
+    {
+        m_sum += sum;
+        m_sum_of_squares += sum_of_squares;
+        m_min = std::min(m_min, min);
+        m_max = std::max(m_max, max);
+    }
+
+    void merge(const HistogramSnapshot &other)
+    {
+        for (size_t i = 0; i < BUCKETS_COUNT; i++) {
+            add_bucket(i, other.m_buckets[i]);
+        }
+        add_totals(other.m_sum, other.m_sum_of_squares, other.m_min, other.m_max);
+    }
+
+    size_t count() const { return static_cast<size_t>(m_count); }
+
+    Expected<double> min() const
+    {
+        if (m_count < 1) {
+            return make_unexpected(HAILO_UNINITIALIZED);
+        }
+        return Expected<double>(m_min);
+    }
+
+    Expected<double> max() const
+    {
+        if (m_count < 1) {
+            return make_unexpected(HAILO_UNINITIALIZED);
+        }
+        return Expected<double>(m_max);
+    }
+
+    Expected<double> mean() const
+    {
+        if (m_count < 1) {
+            return make_unexpected(HAILO_UNINITIALIZED);
+        }
+        return Expected<double>(m_sum / static_cast<double>(m_count));
+    }
+
+    // Sample variance
+    Expected<double> var() const
+    {
+        if (m_count < 2) {
+            return make_unexpected(HAILO_UNINITIALIZED);
+        }
+        const auto count = static_cast<double>(m_count);
+        // Rounding errors may result in a tiny negative variance
+        return Expected<double>(std::max(0.0, (m_sum_of_squares - ((m_sum * m_sum) / count)) / (count - 1)));
+    }
+
+    Expected<double> sd() const
+    {
+        auto variance = var();
+        if (!variance) {
+            return make_unexpected(variance.status());
+        }
+        return Expected<double>(std::sqrt(variance.value()));
+    }
+
+    Expected<double> mean_sd() const
+    {
+        auto standard_deviation = sd();
+        if (!standard_deviation) {
+            return make_unexpected(standard_deviation.status());
+        }
+        return Expected<double>(standard_deviation.value() / std::sqrt(static_cast<double>(m_count)));
+    }
+
+    Expected<double> percentile(double percentile) const
+    {
+        if ((m_count < 1) || (percentile < 0) || (percentile > 100)) {
+            return make_unexpected(HAILO_NOT_AVAILABLE);
+        }
+
+        const auto rank = std::max(static_cast<uint64_t>(1),
+            static_cast<uint64_t>(std::ceil((percentile / 100) * static_cast<double>(m_count))));
+        uint64_t cumulative_count = 0;
+        size_t index = 0;
+        for (; index < BUCKETS_COUNT; index++) {
+            cumulative_count += m_buckets[index];
+            if (cumulative_count >= rank) {
+                break;
+            }
+        }
+
+        if (0 == index) {
+            return Expected<double>(m_min);
+        }
+        if (index >= (BUCKETS_COUNT - 1)) {
+            return Expected<double>(m_max);
+        }
+        // The exact min/max are known, so the bucket's value is clamped to them
+        return Expected<double>(std::min(m_max, std::max(m_min, bucket_value(index))));
+    }
+
+    AccumulatorResults to_results() const
+    {
+        std::map<double, double> percentiles;
+        for (const auto reported_percentile : AccumulatorResults::reported_percentiles()) {
+            auto value = percentile(reported_percentile);
+            if (value) {
+                percentiles.emplace(reported_percentile, value.value());
+            }
+        }
+        return AccumulatorResults(Expected<size_t>(count()), min(), max(), mean(), var(), sd(), mean_sd(), percentiles);
+    }
+
+private:
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count;
+    double m_sum;
+    double m_sum_of_squares;
+    double m_min;
+    double m_max;
+};
+
+// Small per-thread index, used to spread concurrent writers over different shards
+inline size_t get_current_thread_shard_index()
+{
+    static std::atomic<size_t> next_index(0);
+    static thread_local const size_t index = next_index++;
+    return index;
+}
+
+/*! Accumulator that also tracks the distribution of its values (see HistogramSnapshot), so it can report percentiles.
+    add_data_point is lock free: every thread updates the atomic counters of its own shard, and the shards are merged
+    when the statistics are read. */
+template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+class HistogramAccumulator : public Accumulator<T>
+{
+public:
+    // Creation isn't thread safe
+    HistogramAccumulator(const std::string& data_type) :
+        Accumulator<T>(data_type),
+        m_shards(new Shard[SHARDS_COUNT])
+    {}
+    HistogramAccumulator(HistogramAccumulator &&) = default;
+    HistogramAccumulator(const HistogramAccumulator &) = delete;
+    HistogramAccumulator &operator=(HistogramAccumulator &&) = delete;
+    HistogramAccumulator &operator=(const HistogramAccumulator &) = delete;
+    virtual ~HistogramAccumulator() = default;
+
+    virtual void add_data_point(T data) override
+    {
+        auto &shard = m_shards[get_current_thread_shard_index() % SHARDS_COUNT];
+        const auto value = static_cast<double>(data);
+        atomic_update(shard.sum, [value](double current) { return current + value; });
+        atomic_update(shard.sum_of_squares, [value](double current) { return current + (value * value); });
+        atomic_update(shard.min, [value](double current) { return std::min(current, value); });
+        atomic_update(shard.max, [value](double current) { return std::max(current, value); });
+        shard.buckets[HistogramSnapshot::bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const
+    {
+        return create_snapshot(false);
+    }
+
+    HistogramSnapshot snapshot_and_clear()
+    {
+        return create_snapshot(true);
+    }
+
+    virtual AccumulatorResults get() const override
+    {
+        return snapshot().to_results();
+    }
+
+    virtual AccumulatorResults get_and_clear() override
+    {
+        return snapshot_and_clear().to_results();
+    }
+
+    virtual Expected<size_t> count() const override
+    {
+        return Expected<size_t>(snapshot().count());
+    }
+
+    virtual Expected<double> min() const override
+    {
+        return snapshot().min();
+    }
+
+    virtual Expected<double> max() const override
+    {
+        return snapshot().max();
+    }
+
+    virtual Expected<double> mean() const override
+    {
+        return snapshot().mean();
+    }
+
+    virtual Expected<double> var() const override
+    {
+        return snapshot().var();
+    }
+
+    virtual Expected<double> sd() const override
+    {
+        return snapshot().sd();
+    }
+
+    virtual Expected<double> mean_sd() const override
+    {
+        return snapshot().mean_sd();
+    }
+
+    virtual Expected<double> percentile(double percentile) const override
+    {
+        return snapshot().percentile(percentile);
+    }
+
+private:
+    static constexpr size_t SHARDS_COUNT = 4;
+
+    struct Shard {
+        Shard() :
+            sum(0),
+            sum_of_squares(0),
+            min(std::numeric_limits<double>::infinity()),
+            max(-std::numeric_limits<double>::infinity())
+        {
+            for (auto &bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<double> sum;
+        std::atomic<double> sum_of_squares;
+        std::atomic<double> min;
+        std::atomic<double> max;
+        std::array<std::atomic<uint64_t>, HistogramSnapshot::BUCKETS_COUNT> buckets;
+    };
+
+    template<typename Func>
+    static void atomic_update(std::atomic<double> &atomic_value, Func func)
+    {
+        auto current = atomic_value.load(std::memory_order_relaxed);
+        while (!atomic_value.compare_exchange_weak(current, func(current), std::memory_order_relaxed)) {}
+    }
+
+    // A data point that is added while clearing may be counted in the next snapshot, but it is never lost
+    HistogramSnapshot create_snapshot(bool clear) const
+    {
+        HistogramSnapshot result;
+        for (size_t shard_index = 0; shard_index < SHARDS_COUNT; shard_index++) {
+            auto &shard = m_shards[shard_index];
+            for (size_t i = 0; i < HistogramSnapshot::BUCKETS_COUNT; i++) {
+                result.add_bucket(i, clear ? shard.buckets[i].exchange(0, std::memory_order_relaxed) :
+                    shard.buckets[i].load(std::memory_order_relaxed));
+            }
+            if (clear) {
+                result.add_totals(shard.sum.exchange(0), shard.sum_of_squares.exchange(0),
+                    shard.min.exchange(std::numeric_limits<double>::infinity()),
+                    shard.max.exchange(-std::numeric_limits<double>::infinity()));
+            } else {
+                result.add_totals(shard.sum.load(), shard.sum_of_squares.load(), shard.min.load(), shard.max.load());
+            }
+        }
+        return result;
+    }
+
+    std::unique_ptr<Shard[]> m_shards;
+};
+
 } /* namespace hailort */
 
 #endif /* _HAILO_RUNTIME_STATISTICS_INTERNAL_HPP_ */
@@ -31,6 +31,21 @@ namespace hailort
 
 #define CHECK_VALID_SOCKET_AS_EXPECTED(sock) CHECK((sock) != INVALID_SOCKET, make_unexpected(HAILO_ETH_FAILURE), "Invalid socket")
 
+// Max datagrams sent/received by a single call of Socket::send_to_multiple/recv_from_multiple
+#define MAX_DATAGRAMS_PER_CALL (64)
+// Max total size of the segments sent by a single call of Socket::send_to_segmented (a single UDP datagram before segmentation)
+#define MAX_SEGMENTED_SEND_SIZE (64 * 1024 - 1024)
+#define MAX_SEGMENTS_PER_CALL (64)
+
+// A single datagram of Socket::send_to_multiple/recv_from_multiple
+typedef struct {
+    uint8_t *buffer;
+    // The size of buffer. Updated to the size of the received datagram by recv_from_multiple
+    size_t size;
+    // The time to send the datagram at (CLOCK_MONOTONIC nanosecs, see Socket::enable_tx_time). 0 sends it right away
+    uint64_t tx_time_ns;
+} socket_datagram_t;
+
 class Socket final {
 public:
     static Expected<Socket> create(int af, int type, int protocol);
@@ -51,6 +66,10 @@ public:
     hailo_status set_recv_buffer_size_max();
     hailo_status set_timeout(const std::chrono::milliseconds timeout_ms, timeval_t *timeout);
     hailo_status enable_broadcast();
+    // Makes the kernel hold each datagram of send_to_multiple until its tx_time_ns (SO_TXTIME). The times are enforced
+    // by the qdisc of the outgoing interface (fq or etf) - other qdiscs send the datagrams right away.
+    // Returns HAILO_NOT_SUPPORTED where it isn't available.
+    hailo_status enable_tx_time();
     hailo_status abort();
 
     // TODO: Should these be in udp.cpp?
@@ -61,6 +80,18 @@ public:
         sockaddr *src_addr, socklen_t src_addr_size, size_t *bytes_received, bool log_timeouts_in_debug = false);
     hailo_status has_data(sockaddr *src_addr, socklen_t src_addr_size, bool log_timeouts_in_debug = false);
 
+    // Batched variants - one syscall for up to MAX_DATAGRAMS_PER_CALL datagrams (sendmmsg/recvmmsg), where supported.
+    // Each datagram is sent after header (if header_size isn't 0). *datagrams_sent may be smaller than count.
+    hailo_status send_to_multiple(const socket_datagram_t *datagrams, size_t count, const uint8_t *header,
+        size_t header_size, int flags, const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *datagrams_sent);
+    // Waits for the first datagram, and receives the following ones only if they already arrived
+    hailo_status recv_from_multiple(socket_datagram_t *datagrams, size_t count, int flags, sockaddr *src_addr,
+        socklen_t src_addr_size, size_t *datagrams_received);
+    // Sends src_buffer as datagrams of segment_size bytes (the last one may be smaller), segmented by the kernel
+    // (UDP GSO). Returns HAILO_NOT_SUPPORTED if the kernel (or the outgoing interface) doesn't support it.
+    hailo_status send_to_segmented(const uint8_t *src_buffer, size_t src_buffer_size, size_t segment_size, int flags,
+        const sockaddr *dest_addr, socklen_t dest_addr_size, size_t *bytes_sent);
+
 private:
     class SocketModuleWrapper final {
     public:
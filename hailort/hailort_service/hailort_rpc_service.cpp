@@ -124,7 +124,11 @@ grpc::Status HailoRtRpcService::VDevice_configure(grpc::ServerContext*, const VD
                     .stream_interface = static_cast<hailo_stream_interface_t>(proto_streams_params.stream_interface()),
                     .direction = stream_direction,
                     {.pcie_output_params = {
-                        .reserved = 0
+                        .completion_params = {
+                            .completion_mode = static_cast<hailo_stream_completion_mode_t>(proto_streams_params.completion_mode()),
+                            .busy_poll_timeout_us = proto_streams_params.busy_poll_timeout_us(),
+                            .transfers_per_interrupt = static_cast<uint16_t>(proto_streams_params.transfers_per_interrupt())
+                        }
                     }}
                 };
             }
@@ -460,6 +464,12 @@ grpc::Status HailoRtRpcService::ConfiguredNetworkGroup_get_config_params(grpc::S
         auto stream_params = name_stream_params_pair.second;
         proto_stream_params->set_stream_interface(stream_params.stream_interface);
         proto_stream_params->set_direction(stream_params.direction);
+        if (HAILO_D2H_STREAM == stream_params.direction) {
+            const auto &completion_params = stream_params.pcie_output_params.completion_params;
+            proto_stream_params->set_completion_mode(completion_params.completion_mode);
+            proto_stream_params->set_busy_poll_timeout_us(completion_params.busy_poll_timeout_us);
+            proto_stream_params->set_transfers_per_interrupt(completion_params.transfers_per_interrupt);
+        }
     }
     for (const auto &name_network_params_pair : net_configure_params.network_params_by_name) {
         auto proto_name_network_params = proto_network_configure_params->add_network_params_map();
@@ -23,6 +23,7 @@
 */
 
 #include "hailort_rpc_service.hpp"
+#include "metrics_endpoint.hpp"
 #include "rpc/rpc_definitions.hpp"
 #include "common/utils.hpp"
 #include "common/filesystem.hpp"
@@ -30,6 +31,7 @@
 
 #include <syslog.h>
 #include <sys/stat.h>
+#include <cstring>
 
 void RunService() {
     std::string server_address(hailort::HAILO_DEFAULT_UDS_ADDR);
@@ -41,6 +43,19 @@ void RunService() {
     builder.RegisterService(&service);
     std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
     chmod(hailort::HAILO_DEFAULT_SERVICE_ADDR.c_str(), S_IROTH | S_IWOTH | S_IRUSR | S_IWUSR);
+
+    // The metrics endpoint is optional - the service keeps running without it
+    std::unique_ptr<hailort::MetricsEndpoint> metrics_endpoint;
+    auto metrics_address = std::getenv(HAILORT_SERVICE_METRICS_ADDRESS_ENV_VAR);
+    if ((nullptr != metrics_address) && (0 != std::strlen(metrics_address))) {
+        auto endpoint = hailort::MetricsEndpoint::create(metrics_address);
+        if (endpoint) {
+            metrics_endpoint = endpoint.release();
+        } else {
+            syslog(LOG_ERR, "Failed to start metrics endpoint on %s, status=%i", metrics_address, endpoint.status());
+        }
+    }
+
     server->Wait();
 }
 
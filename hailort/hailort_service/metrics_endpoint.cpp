@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics_endpoint.cpp
+ * @brief Minimal HTTP endpoint serving the MetricsRegistry in the OpenMetrics text format
+ **/
+
+#include "metrics_endpoint.hpp"
+#include "hailo/metrics.hpp"
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace hailort
+{
+
+static const std::string UNIX_SOCKET_PREFIX = "unix:";
+static constexpr int LISTEN_BACKLOG = 8;
+static constexpr int ACCEPT_POLL_TIMEOUT_MS = 200;
+static constexpr time_t CLIENT_TIMEOUT_SEC = 1;
+static constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+Expected<std::unique_ptr<MetricsEndpoint>> MetricsEndpoint::create(const std::string &address)
+{
+    const bool is_unix = (0 == address.compare(0, UNIX_SOCKET_PREFIX.size(), UNIX_SOCKET_PREFIX));
+    const auto unix_socket_path = is_unix ? address.substr(UNIX_SOCKET_PREFIX.size()) : "";
+
+    auto listen_fd = is_unix ? listen_unix(unix_socket_path) : listen_tcp(address);
+    CHECK_EXPECTED(listen_fd);
+
+    auto endpoint = make_unique_nothrow<MetricsEndpoint>(listen_fd.value(), unix_socket_path);
+    if (nullptr == endpoint) {
+        close(listen_fd.value());
+        LOGGER__ERROR("Failed to allocate metrics endpoint");
+        return make_unexpected(HAILO_OUT_OF_HOST_MEMORY);
+    }
+    return endpoint;
+}
+
+MetricsEndpoint::MetricsEndpoint(int listen_fd, const std::string &unix_socket_path) :
+    m_listen_fd(listen_fd),
+    m_unix_socket_path(unix_socket_path),
+    m_is_running(true),
+    m_thread([this]() { serve(); })
+{}
+
+MetricsEndpoint::~MetricsEndpoint()
+{
+    m_is_running = false;
+    m_thread.join();
+    close(m_listen_fd);
+    if (!m_unix_socket_path.empty()) {
+        unlink(m_unix_socket_path.c_str());
+    }
+}
+
+Expected<int> MetricsEndpoint::listen_tcp(const std::string &address)
+{
+    const auto colon = address.rfind(':');
+    CHECK_AS_EXPECTED(std::string::npos != colon, HAILO_INVALID_ARGUMENT,
+        "Metrics address '{}' should be '<ip>:<port>' or 'unix:<path>'", address);
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    const auto host = address.substr(0, colon);
+    CHECK_AS_EXPECTED(1 == inet_pton(AF_INET, host.empty() ? "0.0.0.0" : host.c_str(), &addr.sin_addr),
+        HAILO_INVALID_ARGUMENT, "Invalid metrics address '{}'", address);
+    const auto port = std::strtoul(address.c_str() + colon + 1, nullptr, 10);
+    CHECK_AS_EXPECTED((0 < port) && (port <= UINT16_MAX), HAILO_INVALID_ARGUMENT, "Invalid metrics port in '{}'", address);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    CHECK_AS_EXPECTED(-1 != fd, HAILO_ETH_FAILURE, "Failed to create metrics socket, errno = {}", errno);
+
+    const int reuse = 1;
+    if ((0 != setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse))) ||
+        (0 != bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) ||
+        (0 != listen(fd, LISTEN_BACKLOG))) {
+        LOGGER__ERROR("Failed to listen on metrics address '{}', errno = {}", address, errno);
+        close(fd);
+        return make_unexpected(HAILO_ETH_FAILURE);
+    }
+    return fd;
+}
+
+Expected<int> MetricsEndpoint::listen_unix(const std::string &path)
+{
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    CHECK_AS_EXPECTED(!path.empty() && (path.size() < sizeof(addr.sun_path)), HAILO_INVALID_ARGUMENT,
+        "Invalid metrics socket path '{}'", path);
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    CHECK_AS_EXPECTED(-1 != fd, HAILO_FILE_OPERATION_FAILURE, "Failed to create metrics socket, errno = {}", errno);
+
+    // A leftover socket from a previous run would fail the bind
+    unlink(path.c_str());
+    if ((0 != bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) || (0 != listen(fd, LISTEN_BACKLOG))) {
+        LOGGER__ERROR("Failed to listen on metrics socket '{}', errno = {}", path, errno);
+        close(fd);
+        return make_unexpected(HAILO_FILE_OPERATION_FAILURE);
+    }
+    return fd;
+}
+
+void MetricsEndpoint::serve()
+{
+    while (m_is_running) {
+        pollfd pfd = {};
+        pfd.fd = m_listen_fd;
+        pfd.events = POLLIN;
+        const auto ret = poll(&pfd, 1, ACCEPT_POLL_TIMEOUT_MS);
+        if (ret <= 0) {
+            continue;
+        }
+
+        const int client_fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (-1 == client_fd) {
+            continue;
+        }
+        // Scrapes are rare and short, so clients are served one at a time
+        handle_client(client_fd);
+        close(client_fd);
+    }
+}
+
+void MetricsEndpoint::handle_client(int client_fd)
+{
+    timeval timeout = {};
+    timeout.tv_sec = CLIENT_TIMEOUT_SEC;
+    (void)setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    (void)setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // Only the request line matters - read until the end of the headers
+    std::string request;
+    char chunk[512];
+    while ((std::string::npos == request.find("\r\n\r\n")) && (request.size() < MAX_REQUEST_SIZE)) {
+        const auto bytes_read = recv(client_fd, chunk, sizeof(chunk), 0);
+        if (bytes_read <= 0) {
+            break;
+        }
+        request.append(chunk, static_cast<size_t>(bytes_read));
+    }
+
+    std::string response;
+    if (0 == request.compare(0, 4, "GET ")) {
+        const auto body = MetricsRegistry::get_instance().serialize();
+        response = "HTTP/1.0 200 OK\r\n"
+            "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+    } else {
+        response = "HTTP/1.0 405 Method Not Allowed\r\nAllow: GET\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+
+    size_t offset = 0;
+    while (offset < response.size()) {
+        const auto bytes_sent = send(client_fd, response.data() + offset, response.size() - offset, MSG_NOSIGNAL);
+        if (bytes_sent <= 0) {
+            LOGGER__WARNING("Failed to send metrics response, errno = {}", errno);
+            return;
+        }
+        offset += static_cast<size_t>(bytes_sent);
+    }
+}
+
+} /* namespace hailort */
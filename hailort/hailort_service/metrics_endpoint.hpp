@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics_endpoint.hpp
+ * @brief Minimal HTTP endpoint serving the MetricsRegistry in the OpenMetrics text format
+ *
+ * Any GET request is answered with MetricsRegistry::serialize(), so the endpoint can be scraped by Prometheus
+ * (e.g. http://<host>:<port>/metrics). The endpoint is enabled by setting HAILORT_SERVICE_METRICS_ADDRESS to either
+ * "<ipv4 address>:<port>" or "unix:<socket path>".
+ **/
+
+#ifndef HAILO_METRICS_ENDPOINT_HPP_
+#define HAILO_METRICS_ENDPOINT_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace hailort
+{
+
+#define HAILORT_SERVICE_METRICS_ADDRESS_ENV_VAR ("HAILORT_SERVICE_METRICS_ADDRESS")
+
+class MetricsEndpoint final
+{
+public:
+    static Expected<std::unique_ptr<MetricsEndpoint>> create(const std::string &address);
+    MetricsEndpoint(int listen_fd, const std::string &unix_socket_path);
+    ~MetricsEndpoint();
+
+    MetricsEndpoint(const MetricsEndpoint &) = delete;
+    MetricsEndpoint &operator=(const MetricsEndpoint &) = delete;
+
+private:
+    static Expected<int> listen_tcp(const std::string &address);
+    static Expected<int> listen_unix(const std::string &path);
+
+    void serve();
+    void handle_client(int client_fd);
+
+    const int m_listen_fd;
+    const std::string m_unix_socket_path;
+    std::atomic_bool m_is_running;
+    std::thread m_thread;
+};
+
+} /* namespace hailort */
+
+#endif /* HAILO_METRICS_ENDPOINT_HPP_ */
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file autotune_command.cpp
+ * @brief Sweep the batch size and scheduler parameters of networks, and recommend a config
+ **/
+
+#include "autotune_command.hpp"
+#include "hailo/hailort_common.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+constexpr size_t AUTOTUNE_NUMBER_WIDTH = 12;
+constexpr size_t AUTOTUNE_LINE_LENGTH = (AUTOTUNE_NUMBER_WIDTH * 6) + 2;
+static const char *DEFAULT_AUTOTUNE_CONFIG_PATH = "autotune_config.json";
+
+template<typename T>
+static std::string to_default_str(const std::vector<T> &values)
+{
+    std::stringstream stream;
+    stream << "(default:";
+    for (const auto &value : values) {
+        stream << " " << value;
+    }
+    stream << ")";
+    return stream.str();
+}
+
+AutotuneCommand::AutotuneCommand(CLI::App &parent_app) :
+    Command(parent_app.add_subcommand("autotune",
+        "Sweep the batch size and scheduler parameters of networks running together, and recommend a config "
+        "(which can be loaded with \"hailortcli run2 --config\")")),
+    m_hef_paths(), m_vdevice_params(), m_not_measure_power(false)
+{
+    const auto defaults = NetworkGroupTuner::get_default_params();
+    m_batch_sizes = defaults.batch_sizes;
+    m_scheduler_thresholds = defaults.scheduler_thresholds;
+    for (const auto &timeout : defaults.scheduler_timeouts) {
+        m_scheduler_timeouts_ms.push_back(static_cast<uint32_t>(timeout.count()));
+    }
+
+    add_vdevice_options(m_app, m_vdevice_params);
+    m_app->add_option("hefs", m_hef_paths, "Paths of the HEFs to tune (all of their network groups run together)")
+        ->check(CLI::ExistingFile)
+        ->required();
+
+    auto sweep_params = m_app->add_option_group("Sweep Parameters");
+    sweep_params->add_option("--batch-sizes", m_batch_sizes, "Batch sizes to try " + to_default_str(m_batch_sizes))
+        ->check(CLI::PositiveNumber);
+    sweep_params->add_option("--scheduler-thresholds", m_scheduler_thresholds,
+        "Scheduler thresholds to try (thresholds above the batch size are skipped) " + to_default_str(m_scheduler_thresholds))
+        ->check(CLI::PositiveNumber);
+    sweep_params->add_option("--scheduler-timeouts", m_scheduler_timeouts_ms,
+        "Scheduler timeouts to try, in milliseconds " + to_default_str(m_scheduler_timeouts_ms))
+        ->check(CLI::NonNegativeNumber);
+    sweep_params->add_option("--warmup-duration", m_warmup_duration_ms,
+        "Time to run each trial before measuring it, in milliseconds")
+        ->default_val(defaults.warmup_duration.count());
+    sweep_params->add_option("--trial-duration", m_trial_duration_ms, "Time to measure each trial, in milliseconds")
+        ->default_val(defaults.trial_duration.count())
+        ->check(CLI::PositiveNumber);
+    sweep_params->add_option("--max-p99-latency", m_max_p99_latency_ms,
+        "The maximal p99 latency of the recommended config, in milliseconds (0 means unbounded)")
+        ->default_val(defaults.max_p99_latency.count());
+    sweep_params->add_flag("--no-power", m_not_measure_power, "Skip power measurement, even if the platform supports it");
+
+    m_app->add_option("-o,--output", m_config_path, "Path of the recommended config file")
+        ->default_val(DEFAULT_AUTOTUNE_CONFIG_PATH);
+}
+
+void AutotuneCommand::print_trials_header()
+{
+    std::cout << "  " <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << "Batch" <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << "Threshold" <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << "Timeout(ms)" <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << "FPS" <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << "p99(ms)" <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << "Power(W)" <<
+        "\n" << std::string(AUTOTUNE_LINE_LENGTH, '-') << std::endl;
+}
+
+void AutotuneCommand::print_trial(const NetworkGroupTunerTrial &trial, bool is_recommended)
+{
+    std::stringstream power;
+    if (std::isnan(trial.power_watts)) {
+        power << "-";
+    } else {
+        power << std::setprecision(2) << std::fixed << trial.power_watts;
+    }
+
+    std::cout << (is_recommended ? "* " : (trial.meets_latency_bound ? "  " : "! ")) <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << trial.batch_size <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << trial.scheduler_threshold <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << trial.scheduler_timeout.count() <<
+        std::setprecision(1) << std::fixed <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << trial.total_fps <<
+        std::setprecision(2) <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << trial.max_p99_latency_ms <<
+        std::setw(AUTOTUNE_NUMBER_WIDTH) << std::left << power.str() << std::endl;
+}
+
+hailo_status AutotuneCommand::execute()
+{
+    NetworkGroupTunerParams params{};
+    params.batch_sizes = m_batch_sizes;
+    params.scheduler_thresholds = m_scheduler_thresholds;
+    for (const auto timeout_ms : m_scheduler_timeouts_ms) {
+        params.scheduler_timeouts.emplace_back(timeout_ms);
+    }
+    params.warmup_duration = std::chrono::milliseconds(m_warmup_duration_ms);
+    params.trial_duration = std::chrono::milliseconds(m_trial_duration_ms);
+    params.max_p99_latency = std::chrono::milliseconds(m_max_p99_latency_ms);
+    params.measure_power = !m_not_measure_power && !m_vdevice_params.multi_process_service;
+
+    hailo_vdevice_params_t vdevice_params = {};
+    auto status = hailo_init_vdevice_params(&vdevice_params);
+    CHECK_SUCCESS(status);
+    if (m_vdevice_params.device_count != HAILO_DEFAULT_DEVICE_COUNT) {
+        vdevice_params.device_count = m_vdevice_params.device_count;
+    }
+    std::vector<hailo_device_id_t> dev_ids;
+    if (!m_vdevice_params.device_params.device_ids.empty()) {
+        auto dev_ids_exp = get_device_ids(m_vdevice_params.device_params);
+        CHECK_EXPECTED_AS_STATUS(dev_ids_exp);
+
+        auto dev_ids_struct_exp = HailoRTCommon::to_device_ids_vector(dev_ids_exp.value());
+        CHECK_EXPECTED_AS_STATUS(dev_ids_struct_exp);
+        dev_ids = dev_ids_struct_exp.release();
+
+        vdevice_params.device_ids = dev_ids.data();
+        vdevice_params.device_count = static_cast<uint32_t>(dev_ids.size());
+    }
+    // The scheduler parameters are tuned, so the scheduler must be enabled
+    vdevice_params.scheduling_algorithm = HAILO_SCHEDULING_ALGORITHM_ROUND_ROBIN;
+    vdevice_params.group_id = m_vdevice_params.group_id.c_str();
+    vdevice_params.multi_process_service = m_vdevice_params.multi_process_service;
+
+    std::cout << "Tuning " << m_hef_paths.size() << " HEF(s)" << std::endl;
+    if (0 != params.max_p99_latency.count()) {
+        std::cout << "('!' marks trials above the p99 latency bound of " << params.max_p99_latency.count() << "ms)" << std::endl;
+    }
+    print_trials_header();
+    auto result = NetworkGroupTuner::tune(m_hef_paths, params, vdevice_params,
+        [](const NetworkGroupTunerTrial &trial) { print_trial(trial, false); });
+    CHECK_EXPECTED_AS_STATUS(result, "Tuning failed");
+
+    std::cout << "\nRecommended trial:" << std::endl;
+    print_trials_header();
+    print_trial(result->trials[result->recommended_trial_index], true);
+
+    status = NetworkGroupTuner::save_config(result->recommended_params, m_config_path);
+    CHECK_SUCCESS(status);
+    std::cout << "\nRecommended config was written to " << m_config_path <<
+        " (run it with \"hailortcli run2 --config " << m_config_path << "\")" << std::endl;
+    return HAILO_SUCCESS;
+}
@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file autotune_command.hpp
+ * @brief Sweep the batch size and scheduler parameters of networks, and recommend a config
+ **/
+
+#ifndef _HAILO_AUTOTUNE_COMMAND_HPP_
+#define _HAILO_AUTOTUNE_COMMAND_HPP_
+
+#include "hailortcli.hpp"
+#include "command.hpp"
+#include "hailo/network_group_tuner.hpp"
+
+#include "CLI/CLI.hpp"
+
+class AutotuneCommand : public Command {
+public:
+    explicit AutotuneCommand(CLI::App &parent_app);
+    hailo_status execute() override;
+
+private:
+    static void print_trials_header();
+    static void print_trial(const NetworkGroupTunerTrial &trial, bool is_recommended);
+
+    std::vector<std::string> m_hef_paths;
+    hailo_vdevice_params m_vdevice_params;
+    std::vector<uint16_t> m_batch_sizes;
+    std::vector<uint32_t> m_scheduler_thresholds;
+    std::vector<uint32_t> m_scheduler_timeouts_ms;
+    uint32_t m_warmup_duration_ms;
+    uint32_t m_trial_duration_ms;
+    uint32_t m_max_p99_latency_ms;
+    bool m_not_measure_power;
+    std::string m_config_path;
+};
+
+#endif /* _HAILO_AUTOTUNE_COMMAND_HPP_ */
@@ -10,6 +10,7 @@
 #include "benchmark_command.hpp"
 #include "hailortcli.hpp"
 #include "infer_stats_printer.hpp"
+#include "common/process.hpp"
 
 #include <iostream>
 
@@ -19,6 +20,7 @@ BenchmarkCommand::BenchmarkCommand(CLI::App &parent_app) :
     m_params({})
 {
     add_vdevice_options(m_app, m_params.vdevice_params);
+    add_completion_params_options(m_app, m_params.completion_params);
     m_params.measure_overall_latency = false;
     m_params.power_measurement.measure_current = false;
     m_params.show_progress = true;
@@ -69,8 +71,19 @@ hailo_status BenchmarkCommand::execute()
     CHECK_EXPECTED_AS_STATUS(hw_only_mode_info, "hw_only measuring failed");
     
     std::cout << "Measuring FPS " << (!m_not_measure_power ? "and Power " : "") << "in streaming mode" << std::endl; 
+    auto cpu_time_before_streaming = Process::get_cpu_time();
+    CHECK_EXPECTED_AS_STATUS(cpu_time_before_streaming);
+    const auto streaming_start_time = std::chrono::steady_clock::now();
     auto streaming_mode_info = fps_streaming_mode();
     CHECK_EXPECTED_AS_STATUS(streaming_mode_info, "FPS in streaming mode failed");
+    auto cpu_time_after_streaming = Process::get_cpu_time();
+    CHECK_EXPECTED_AS_STATUS(cpu_time_after_streaming);
+    const auto streaming_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - streaming_start_time);
+    // Percentage of a single CPU core, used by the whole process during the streaming measurement
+    const double streaming_cpu_usage = 100.0 *
+        static_cast<double>((cpu_time_after_streaming.value() - cpu_time_before_streaming.value()).count()) /
+        static_cast<double>(std::max(streaming_time.count(), static_cast<std::chrono::microseconds::rep>(1)));
 
     // TODO - HRT-6931 - measure latency only in the case of single device. 
     std::cout << "Measuring HW Latency" << std::endl;
@@ -104,6 +117,7 @@ hailo_status BenchmarkCommand::execute()
             std::cout << "        (overall)                 = " << InferResultsFormatUtils::latency_result_to_ms(overall_latency.value()) << " ms" << std::endl;
         }
     }
+    std::cout << "CPU usage (streaming)             = " << streaming_cpu_usage << " %" << std::endl;
     if (!m_not_measure_power) {
         for (const auto &pair : streaming_mode_info->m_power_measurements) {
             std::cout << "Device " << pair.first << ":" << std::endl;
@@ -130,6 +130,19 @@ DotWriter::HtmlString PipelineGraphNode::format_runtime_stats(const std::vector<
         string_stream << "sd=" << InferResultsFormatUtils::format_statistic(accumulator_result.sd()) << ", ";
         string_stream << "mean_sd=" << InferResultsFormatUtils::format_statistic(accumulator_result.mean_sd());
         lines.emplace_back(string_stream.str());
+
+        // Only accumulators that track the distribution of their values report percentiles
+        string_stream.str("");
+        for (const auto percentile : AccumulatorResults::reported_percentiles()) {
+            const auto value = accumulator_result.percentile(percentile);
+            if (value) {
+                string_stream << (string_stream.tellp() > 0 ? ", " : "") << "p" << InferResultsFormatUtils::format_percentile(percentile)
+                    << "=" << InferResultsFormatUtils::format_statistic(value);
+            }
+        }
+        if (string_stream.tellp() > 0) {
+            lines.emplace_back(string_stream.str());
+        }
     }
 
     return create_multiline_label(lines, Align::LEFT);
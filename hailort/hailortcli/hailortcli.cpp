@@ -9,6 +9,7 @@
  * HailoRT command line interface.
  **/
 #include "run2/run2_command.hpp"
+#include "run2/bench_scenario_command.hpp"
 #include "hailortcli.hpp"
 #include "scan_command.hpp"
 #include "power_measurement_command.hpp"
@@ -20,6 +21,7 @@
 #include "fw_config_command.hpp"
 #include "fw_logger_command.hpp"
 #include "benchmark_command.hpp"
+#include "autotune_command.hpp"
 #include "mon_command.hpp"
 #if defined(__GNUC__)
 #include "udp_rate_limiter_command.hpp"
@@ -190,6 +192,8 @@ public:
         add_subcommand<Run2Command>();
         add_subcommand<ScanSubcommand>();
         add_subcommand<BenchmarkCommand>();
+        add_subcommand<AutotuneCommand>();
+        add_subcommand<BenchScenarioCommand>();
         add_subcommand<PowerMeasurementSubcommand>();
         add_subcommand<SensorConfigCommand>();
         add_subcommand<BoardConfigCommand>();
@@ -49,6 +49,14 @@ std::string InferResultsFormatUtils::format_statistic(const Expected<size_t> &st
     return std::to_string(statistic.value());
 }
 
+std::string InferResultsFormatUtils::format_percentile(double percentile)
+{
+    // 99.9 -> "99.9", 50 -> "50"
+    std::stringstream string_stream;
+    string_stream << percentile;
+    return string_stream.str();
+}
+
 double InferResultsFormatUtils::latency_result_to_ms(std::chrono::nanoseconds latency)
 {
     return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(latency).count();
@@ -113,7 +121,7 @@ void InferStatsPrinter::print(const std::vector<std::string> &network_groups_nam
     }
     if (m_pipeline_stats_csv_file.is_open() && (inference_result)) {
         std::cout << "> Writing pipeline statistics to '" << m_pipeline_stats_csv_path << "'... ";
-        m_pipeline_stats_csv_file << "net_name,vstream_name,param_type,element,mean,min,max,var,sd,mean_sd,index" << std::endl;
+        m_pipeline_stats_csv_file << "net_name,vstream_name,param_type,element,mean,min,max,var,sd,mean_sd,p50,p90,p99,p99.9,index" << std::endl;
         for (auto &network_group_results : inference_result->network_group_results()) {
             print_pipeline_elem_stats_csv(network_group_results.network_group_name(), network_group_results.m_fps_accumulators);
             print_pipeline_elem_stats_csv(network_group_results.network_group_name(), network_group_results.m_latency_accumulators);
@@ -378,6 +386,15 @@ void InferStatsPrinter::print_stdout_single_element(const T &results, size_t fra
         std::cout << "    Overall Latency: " << InferResultsFormatUtils::latency_result_to_ms(overall_latency.value()) << " ms" << std::endl;
     }
 
+    if (!results.m_overall_latency_percentiles.empty()) {
+        std::cout << "    Overall Latency Percentiles:";
+        for (const auto &percentile_latency : results.m_overall_latency_percentiles) {
+            std::cout << " p" << InferResultsFormatUtils::format_percentile(percentile_latency.first) << "="
+                << InferResultsFormatUtils::latency_result_to_ms(percentile_latency.second) << "ms";
+        }
+        std::cout << std::endl;
+    }
+
 }
 
 void InferStatsPrinter::print_stdout(Expected<InferResult> &inference_result)
@@ -482,6 +499,9 @@ void InferStatsPrinter::write_accumulator_results(std::ofstream &output_stream,
     output_stream << InferResultsFormatUtils::format_statistic(accumulator_result.var()) << ",";
     output_stream << InferResultsFormatUtils::format_statistic(accumulator_result.sd()) << ",";
     output_stream << InferResultsFormatUtils::format_statistic(accumulator_result.mean_sd()) << ",";
+    for (const auto percentile : AccumulatorResults::reported_percentiles()) {
+        output_stream << InferResultsFormatUtils::format_statistic(accumulator_result.percentile(percentile)) << ",";
+    }
     if (NO_INDEX != index) {
         output_stream << index;
     }
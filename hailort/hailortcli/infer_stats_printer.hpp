@@ -23,6 +23,7 @@ public:
 
     static std::string format_statistic(const Expected<double> &statistic, uint32_t precision = DEFAULT_FLOATING_POINT_PRECISION);
     static std::string format_statistic(const Expected<size_t> &statistic);
+    static std::string format_percentile(double percentile);
     static double latency_result_to_ms(std::chrono::nanoseconds latency);
 };
 
@@ -26,7 +26,8 @@ public:
         m_total_recv_frame_size(total_recv_frame_size),
         m_infer_duration(nullptr),
         m_hw_latency(nullptr),
-        m_overall_latency(nullptr)
+        m_overall_latency(nullptr),
+        m_overall_latency_percentiles()
     {}
 
     Expected<double> infer_duration() const{
@@ -87,6 +88,8 @@ public:
     std::shared_ptr<double> m_infer_duration;
     std::shared_ptr<std::chrono::nanoseconds> m_hw_latency;
     std::shared_ptr<std::chrono::nanoseconds> m_overall_latency;
+    // <percentile, latency>
+    std::map<double, std::chrono::nanoseconds> m_overall_latency_percentiles;
 };
 
 struct NetworkGroupInferResult
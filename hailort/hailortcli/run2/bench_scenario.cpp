@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file bench_scenario.cpp
+ * @brief Multi-model benchmark scenario files and their reports
+ **/
+
+#include "bench_scenario.hpp"
+#include "common/utils.hpp"
+
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace hailort;
+using json = nlohmann::json;
+using ordered_json = nlohmann::ordered_json;
+
+constexpr uint64_t DEFAULT_SCENARIO_WARMUP_DURATION_MS = 2000;
+constexpr uint64_t DEFAULT_SCENARIO_STEADY_STATE_DURATION_MS = 10000;
+constexpr uint64_t DEFAULT_SCENARIO_COOLDOWN_DURATION_MS = 10000;
+
+static const char *SCENARIO_DEVICE_COUNT_KEY = "device_count";
+static const char *SCENARIO_WARMUP_DURATION_KEY = "warmup_duration_ms";
+static const char *SCENARIO_STEADY_STATE_DURATION_KEY = "steady_state_duration_ms";
+static const char *SCENARIO_COOLDOWN_DURATION_KEY = "cooldown_duration_ms";
+static const char *SCENARIO_MODELS_KEY = "models";
+static const char *SCENARIO_HEF_KEY = "hef";
+static const char *SCENARIO_NETWORK_GROUP_NAME_KEY = "network_group_name";
+static const char *SCENARIO_BATCH_SIZE_KEY = "batch_size";
+static const char *SCENARIO_SCHEDULER_THRESHOLD_KEY = "scheduler_threshold";
+static const char *SCENARIO_SCHEDULER_TIMEOUT_KEY = "scheduler_timeout_ms";
+static const char *SCENARIO_FRAMERATE_KEY = "framerate";
+static const char *SCENARIO_ARRIVAL_PROCESS_KEY = "arrival_process";
+static const char *SCENARIO_BURST_SIZE_KEY = "burst_size";
+static const char *SCENARIO_SCHEDULER_PRIORITY_KEY = "scheduler_priority";
+
+// Unknown keys are rejected, so a typo doesn't silently change a scenario that is compared across versions
+static hailo_status check_keys(const json &object, const std::vector<std::string> &known_keys, const std::string &path)
+{
+    for (const auto &item : object.items()) {
+        CHECK(item.key() != SCENARIO_SCHEDULER_PRIORITY_KEY, HAILO_NOT_SUPPORTED,
+            "'{}' in scenario file {} isn't supported - the scheduler is round robin. Use '{}' and '{}' instead",
+            SCENARIO_SCHEDULER_PRIORITY_KEY, path, SCENARIO_SCHEDULER_THRESHOLD_KEY, SCENARIO_SCHEDULER_TIMEOUT_KEY);
+        CHECK(std::find(known_keys.begin(), known_keys.end(), item.key()) != known_keys.end(), HAILO_INVALID_ARGUMENT,
+            "Unknown key '{}' in scenario file {}", item.key(), path);
+    }
+    return HAILO_SUCCESS;
+}
+
+// Returns default_value if the key is missing
+static Expected<uint64_t> get_unsigned(const json &object, const char *key, uint64_t default_value, uint64_t max_value,
+    const std::string &path)
+{
+    const auto field = object.find(key);
+    if (object.end() == field) {
+        return default_value;
+    }
+    CHECK_AS_EXPECTED(field->is_number_unsigned() && (field->get<uint64_t>() <= max_value), HAILO_INVALID_ARGUMENT,
+        "'{}' in scenario file {} must be an integer between 0 and {}", key, path, max_value);
+    return field->get<uint64_t>();
+}
+
+static Expected<std::string> get_string(const json &object, const char *key, const std::string &default_value,
+    const std::string &path)
+{
+    const auto field = object.find(key);
+    if (object.end() == field) {
+        return std::string(default_value);
+    }
+    CHECK_AS_EXPECTED(field->is_string(), HAILO_INVALID_ARGUMENT, "'{}' in scenario file {} must be a string", key, path);
+    return field->get<std::string>();
+}
+
+static Expected<ArrivalProcess> parse_arrival_process(const std::string &arrival_process, const std::string &path)
+{
+    static const std::map<std::string, ArrivalProcess> arrival_processes = {
+        { "closed", ArrivalProcess::CLOSED_LOOP },
+        { "uniform", ArrivalProcess::UNIFORM },
+        { "poisson", ArrivalProcess::POISSON },
+        { "bursty", ArrivalProcess::BURSTY }
+    };
+    const auto it = arrival_processes.find(arrival_process);
+    CHECK_AS_EXPECTED(arrival_processes.end() != it, HAILO_INVALID_ARGUMENT,
+        "Invalid '{}' '{}' in scenario file {} (should be closed, uniform, poisson or bursty)",
+        SCENARIO_ARRIVAL_PROCESS_KEY, arrival_process, path);
+    return Expected<ArrivalProcess>(it->second);
+}
+
+static Expected<NetworkParams> parse_model(const json &model, const std::string &path)
+{
+    CHECK_AS_EXPECTED(model.is_object(), HAILO_INVALID_ARGUMENT, "Invalid model in scenario file {}", path);
+    CHECK_SUCCESS_AS_EXPECTED(check_keys(model, {SCENARIO_HEF_KEY, SCENARIO_NETWORK_GROUP_NAME_KEY, SCENARIO_BATCH_SIZE_KEY,
+        SCENARIO_SCHEDULER_THRESHOLD_KEY, SCENARIO_SCHEDULER_TIMEOUT_KEY, SCENARIO_FRAMERATE_KEY, SCENARIO_ARRIVAL_PROCESS_KEY,
+        SCENARIO_BURST_SIZE_KEY}, path));
+    CHECK_AS_EXPECTED(model.end() != model.find(SCENARIO_HEF_KEY), HAILO_INVALID_ARGUMENT,
+        "Model in scenario file {} must have a '{}'", path, SCENARIO_HEF_KEY);
+
+    auto hef_path = get_string(model, SCENARIO_HEF_KEY, "", path);
+    CHECK_EXPECTED(hef_path);
+    auto net_group_name = get_string(model, SCENARIO_NETWORK_GROUP_NAME_KEY, "", path);
+    CHECK_EXPECTED(net_group_name);
+    auto batch_size = get_unsigned(model, SCENARIO_BATCH_SIZE_KEY, HAILO_DEFAULT_BATCH_SIZE, UINT16_MAX, path);
+    CHECK_EXPECTED(batch_size);
+    auto threshold = get_unsigned(model, SCENARIO_SCHEDULER_THRESHOLD_KEY, 0, UINT32_MAX, path);
+    CHECK_EXPECTED(threshold);
+    auto timeout = get_unsigned(model, SCENARIO_SCHEDULER_TIMEOUT_KEY, 0, UINT32_MAX, path);
+    CHECK_EXPECTED(timeout);
+    auto framerate = get_unsigned(model, SCENARIO_FRAMERATE_KEY, UNLIMITED_FRAMERATE, UINT32_MAX, path);
+    CHECK_EXPECTED(framerate);
+    auto arrival_process_name = get_string(model, SCENARIO_ARRIVAL_PROCESS_KEY, "closed", path);
+    CHECK_EXPECTED(arrival_process_name);
+    auto arrival_process = parse_arrival_process(arrival_process_name.value(), path);
+    CHECK_EXPECTED(arrival_process);
+    auto burst_size = get_unsigned(model, SCENARIO_BURST_SIZE_KEY, DEFAULT_BURST_SIZE, UINT32_MAX, path);
+    CHECK_EXPECTED(burst_size);
+    CHECK_AS_EXPECTED((ArrivalProcess::CLOSED_LOOP == arrival_process.value()) || (UNLIMITED_FRAMERATE != framerate.value()),
+        HAILO_INVALID_ARGUMENT, "Model {} in scenario file {} must have a '{}' (its arrival process is {})", hef_path.value(),
+        path, SCENARIO_FRAMERATE_KEY, arrival_process_name.value());
+    CHECK_AS_EXPECTED(0 != burst_size.value(), HAILO_INVALID_ARGUMENT, "'{}' in scenario file {} must be positive",
+        SCENARIO_BURST_SIZE_KEY, path);
+
+    NetworkParams params{};
+    params.hef_path = hef_path.release();
+    params.net_group_name = net_group_name.release();
+    params.batch_size = static_cast<uint16_t>(batch_size.value());
+    params.scheduler_threshold = static_cast<uint32_t>(threshold.value());
+    params.scheduler_timeout_ms = static_cast<uint32_t>(timeout.value());
+    params.framerate = static_cast<uint32_t>(framerate.value());
+    params.arrival_process = arrival_process.value();
+    params.burst_size = static_cast<uint32_t>(burst_size.value());
+    return params;
+}
+
+Expected<BenchScenario> BenchScenario::load(const std::string &path)
+{
+    std::ifstream file(path);
+    CHECK_AS_EXPECTED(file.is_open(), HAILO_OPEN_FILE_FAILURE, "Failed opening scenario file {}", path);
+
+    const auto scenario_json = json::parse(file, nullptr, false);
+    CHECK_AS_EXPECTED(!scenario_json.is_discarded() && scenario_json.is_object(), HAILO_INVALID_ARGUMENT,
+        "Scenario file {} isn't a valid JSON object", path);
+    CHECK_SUCCESS_AS_EXPECTED(check_keys(scenario_json, {SCENARIO_DEVICE_COUNT_KEY, SCENARIO_WARMUP_DURATION_KEY,
+        SCENARIO_STEADY_STATE_DURATION_KEY, SCENARIO_COOLDOWN_DURATION_KEY, SCENARIO_MODELS_KEY}, path));
+
+    auto device_count = get_unsigned(scenario_json, SCENARIO_DEVICE_COUNT_KEY, HAILO_DEFAULT_DEVICE_COUNT, UINT32_MAX, path);
+    CHECK_EXPECTED(device_count);
+    auto warmup_duration = get_unsigned(scenario_json, SCENARIO_WARMUP_DURATION_KEY, DEFAULT_SCENARIO_WARMUP_DURATION_MS,
+        UINT32_MAX, path);
+    CHECK_EXPECTED(warmup_duration);
+    auto steady_state_duration = get_unsigned(scenario_json, SCENARIO_STEADY_STATE_DURATION_KEY,
+        DEFAULT_SCENARIO_STEADY_STATE_DURATION_MS, UINT32_MAX, path);
+    CHECK_EXPECTED(steady_state_duration);
+    auto cooldown_duration = get_unsigned(scenario_json, SCENARIO_COOLDOWN_DURATION_KEY, DEFAULT_SCENARIO_COOLDOWN_DURATION_MS,
+        UINT32_MAX, path);
+    CHECK_EXPECTED(cooldown_duration);
+    CHECK_AS_EXPECTED(0 != device_count.value(), HAILO_INVALID_ARGUMENT, "'{}' in scenario file {} must be positive",
+        SCENARIO_DEVICE_COUNT_KEY, path);
+    CHECK_AS_EXPECTED(0 != steady_state_duration.value(), HAILO_INVALID_ARGUMENT, "'{}' in scenario file {} must be positive",
+        SCENARIO_STEADY_STATE_DURATION_KEY, path);
+
+    const auto models = scenario_json.find(SCENARIO_MODELS_KEY);
+    CHECK_AS_EXPECTED((scenario_json.end() != models) && models->is_array() && !models->empty(), HAILO_INVALID_ARGUMENT,
+        "Scenario file {} must have a non empty '{}' array", path, SCENARIO_MODELS_KEY);
+
+    BenchScenario scenario{};
+    scenario.device_count = static_cast<uint32_t>(device_count.value());
+    scenario.warmup_duration = std::chrono::milliseconds(warmup_duration.value());
+    scenario.steady_state_duration = std::chrono::milliseconds(steady_state_duration.value());
+    scenario.cooldown_duration = std::chrono::milliseconds(cooldown_duration.value());
+    for (const auto &model : *models) {
+        auto params = parse_model(model, path);
+        CHECK_EXPECTED(params);
+        scenario.models.emplace_back(params.release());
+    }
+    return scenario;
+}
+
+static std::string power_to_string(double power_watts)
+{
+    return std::isnan(power_watts) ? "-" : fmt::format("{:.2f} W", power_watts);
+}
+
+void BenchScenarioReport::print(const BenchScenarioResult &result)
+{
+    std::cout << fmt::format("> Scenario steady state ({} device(s), {} ms): power {}", result.device_count,
+        result.steady_state_duration.count(), power_to_string(result.power_watts)) << std::endl;
+    for (const auto &model : result.models) {
+        const auto &load_result = model.load_result;
+        std::cout << fmt::format("  {} ({}): offered {}, throughput {:.2f} fps{}, {} switches, active {:.1f}%",
+            load_result.network_name, arrival_process_to_string(load_result.arrival_process),
+            (0 == load_result.offered_fps) ? "unlimited" : fmt::format("{:.2f} fps", load_result.offered_fps),
+            load_result.throughput_fps, load_result.drained ? "" : " (not drained)", model.switches_count,
+            model.active_ratio * 100) << std::endl;
+        std::cout << fmt::format("    Latency: mean {:.3f} ms, p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+            to_ms(load_result.latency.mean()), to_ms(load_result.latency.percentile(50)),
+            to_ms(load_result.latency.percentile(90)), to_ms(load_result.latency.percentile(99)),
+            to_ms(load_result.latency.max())) << std::endl;
+    }
+}
+
+hailo_status BenchScenarioReport::write_csv(const BenchScenarioResult &result, const std::string &path)
+{
+    std::ofstream file(path, std::ios::out);
+    CHECK(file.good(), HAILO_OPEN_FILE_FAILURE, "Failed opening file {}, errno: {}", path, errno);
+
+    file << "net_name,arrival_process,offered_fps,throughput_fps,frames_count,drained,switches,active_ratio,latency_mean_ms";
+    for (const auto percentile : report_percentiles()) {
+        file << ",latency_p" << percentile << "_ms";
+    }
+    file << ",latency_max_ms,device_count,power_watts" << std::endl;
+
+    for (const auto &model : result.models) {
+        const auto &load_result = model.load_result;
+        file << load_result.network_name << "," << arrival_process_to_string(load_result.arrival_process) << ","
+             << load_result.offered_fps << "," << load_result.throughput_fps << "," << load_result.frames_count << ","
+             << load_result.drained << "," << model.switches_count << "," << model.active_ratio << ","
+             << to_ms(load_result.latency.mean());
+        for (const auto percentile : report_percentiles()) {
+            file << "," << to_ms(load_result.latency.percentile(percentile));
+        }
+        // An empty power cell means it wasn't measured
+        file << "," << to_ms(load_result.latency.max()) << "," << result.device_count << ","
+             << (std::isnan(result.power_watts) ? "" : std::to_string(result.power_watts)) << std::endl;
+    }
+    CHECK(file.good(), HAILO_FILE_OPERATION_FAILURE, "Failed writing to file {}", path);
+    return HAILO_SUCCESS;
+}
+
+hailo_status BenchScenarioReport::write_json(const BenchScenarioResult &result, const std::string &path)
+{
+    ordered_json models = ordered_json::array();
+    for (const auto &model : result.models) {
+        const auto &load_result = model.load_result;
+        ordered_json model_json;
+        model_json["net_name"] = load_result.network_name;
+        model_json["arrival_process"] = arrival_process_to_string(load_result.arrival_process);
+        model_json["offered_fps"] = load_result.offered_fps;
+        model_json["throughput_fps"] = load_result.throughput_fps;
+        model_json["frames_count"] = load_result.frames_count;
+        model_json["drained"] = load_result.drained;
+        model_json["switches"] = model.switches_count;
+        model_json["active_ratio"] = model.active_ratio;
+        model_json["latency"] = histogram_to_json(load_result.latency);
+        models.push_back(model_json);
+    }
+
+    ordered_json report;
+    report["device_count"] = result.device_count;
+    report["steady_state_duration_ms"] = result.steady_state_duration.count();
+    // NaN is written as null - the power wasn't measured
+    report["power_watts"] = result.power_watts;
+    report["models"] = models;
+
+    std::ofstream file(path, std::ios::out);
+    CHECK(file.good(), HAILO_OPEN_FILE_FAILURE, "Failed opening file {}, errno: {}", path, errno);
+    file << report.dump(4) << std::endl;
+    CHECK(file.good(), HAILO_FILE_OPERATION_FAILURE, "Failed writing to file {}", path);
+    return HAILO_SUCCESS;
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file bench_scenario.hpp
+ * @brief Multi-model benchmark scenario files and their reports
+ *
+ * A scenario is a (JSON) file describing the models that run together on a scheduled VDevice, and how long each
+ * phase of the run lasts. For example:
+ *  {
+ *      "device_count": 2,
+ *      "warmup_duration_ms": 2000,
+ *      "steady_state_duration_ms": 10000,
+ *      "cooldown_duration_ms": 10000,
+ *      "models": [
+ *          { "hef": "yolov5m.hef", "batch_size": 4, "scheduler_threshold": 2, "scheduler_timeout_ms": 20,
+ *            "framerate": 60, "arrival_process": "poisson" },
+ *          { "hef": "resnet_v1_50.hef", "network_group_name": "resnet_v1_50", "batch_size": 8 }
+ *      ]
+ *  }
+ * All of the fields but "models" and "hef" are optional. A model without a framerate runs in closed loop.
+ **/
+
+#ifndef _HAILO_HAILORTCLI_RUN2_BENCH_SCENARIO_HPP_
+#define _HAILO_HAILORTCLI_RUN2_BENCH_SCENARIO_HPP_
+
+#include "network_runner.hpp"
+#include "load_generator.hpp"
+
+#include "hailo/expected.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+struct BenchScenario
+{
+    static hailort::Expected<BenchScenario> load(const std::string &path);
+
+    uint32_t device_count;
+    // The models run before they are measured, so the scheduler and the queues reach a steady state
+    std::chrono::milliseconds warmup_duration;
+    std::chrono::milliseconds steady_state_duration;
+    // The time the open loop models are given to drain their backlog after the steady state
+    std::chrono::milliseconds cooldown_duration;
+    std::vector<NetworkParams> models;
+};
+
+struct BenchScenarioModelResult
+{
+    // The steady state measurements. In closed loop the latency is from writing a frame until its first output is read.
+    LoadStepResult load_result;
+    // Times the model was switched to on a device during the steady state
+    uint64_t switches_count;
+    // The time the model was active on the devices, as a fraction of the steady state (may exceed 1 with several devices)
+    double active_ratio;
+};
+
+struct BenchScenarioResult
+{
+    uint32_t device_count;
+    std::chrono::milliseconds steady_state_duration;
+    // The sum of the average power of the physical devices during the steady state, or NaN if it wasn't measured
+    double power_watts;
+    std::vector<BenchScenarioModelResult> models;
+};
+
+class BenchScenarioReport final
+{
+public:
+    static void print(const BenchScenarioResult &result);
+    static hailo_status write_csv(const BenchScenarioResult &result, const std::string &path);
+    static hailo_status write_json(const BenchScenarioResult &result, const std::string &path);
+};
+
+#endif /* _HAILO_HAILORTCLI_RUN2_BENCH_SCENARIO_HPP_ */
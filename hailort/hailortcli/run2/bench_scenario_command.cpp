@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file bench_scenario_command.cpp
+ * @brief Run a multi-model benchmark scenario file
+ **/
+
+#include "bench_scenario_command.hpp"
+#include "live_printer.hpp"
+#include "timer_live_track.hpp"
+#include "threads_utils.hpp"
+#include "../power_measurement_command.hpp"
+
+#include "hailo/vdevice.hpp"
+#include "hailo/metrics.hpp"
+
+#include <cmath>
+#include <limits>
+#include <thread>
+
+using namespace hailort;
+
+constexpr uint32_t SCENARIO_POWER_SAMPLING_PERIOD_US = 1100;
+constexpr uint32_t SCENARIO_POWER_AVERAGING_FACTOR = 256;
+
+// The scheduler's counters of every network group (see network_group_scheduler.cpp)
+struct SchedulerCounters
+{
+    uint64_t switches_count;
+    uint64_t active_time_us;
+};
+
+BenchScenarioCommand::BenchScenarioCommand(CLI::App &parent_app) :
+    Command(parent_app.add_subcommand("bench-scenario",
+        "Run a multi-model benchmark scenario file (warmup, steady state and cooldown), and report the steady state "
+        "fps, latency, scheduler switches and power of every model")),
+    m_not_measure_power(false)
+{
+    m_app->add_option("scenario", m_scenario_path, "Path of the scenario (JSON) file")
+        ->check(CLI::ExistingFile)
+        ->required();
+    m_app->add_option("--csv", m_csv_path, "Write the results to a CSV file");
+    m_app->add_option("--json", m_json_path, "Write the results to a JSON file");
+    m_app->add_flag("--no-power", m_not_measure_power, "Skip power measurement, even if the platform supports it");
+}
+
+static Expected<std::vector<SchedulerCounters>> read_scheduler_counters(std::vector<std::shared_ptr<NetworkRunner>> &net_runners)
+{
+    // The counters are created by the scheduler when the network groups are added, so these return the live ones
+    std::vector<SchedulerCounters> counters;
+    for (auto &net_runner : net_runners) {
+        const MetricLabels labels = {{"network_group", net_runner->get_name()}};
+        auto switches = MetricsRegistry::get_instance().get_counter("hailort_scheduler_switches",
+            "Times the network group was switched to on a device (or had its batch size changed)", labels);
+        CHECK_EXPECTED(switches);
+        auto active_time = MetricsRegistry::get_instance().get_counter("hailort_scheduler_active_microseconds",
+            "Time the network group was active on a device", labels);
+        CHECK_EXPECTED(active_time);
+        counters.emplace_back(SchedulerCounters{switches.value()->value(), active_time.value()->value()});
+    }
+    return counters;
+}
+
+static std::vector<LongPowerMeasurement> start_power_measurements(std::vector<std::reference_wrapper<Device>> &physical_devices)
+{
+    std::vector<LongPowerMeasurement> power_measurements;
+    for (auto &device : physical_devices) {
+        auto power_measurement = PowerMeasurementSubcommand::start_power_measurement(device, HAILO_DVM_OPTIONS_AUTO,
+            HAILO_POWER_MEASUREMENT_TYPES__POWER, SCENARIO_POWER_SAMPLING_PERIOD_US, SCENARIO_POWER_AVERAGING_FACTOR);
+        if (!power_measurement) {
+            LOGGER__WARNING("Failed starting power measurement on device {}, the power won't be measured",
+                device.get().get_dev_id());
+            for (auto &started_measurement : power_measurements) {
+                (void) started_measurement.stop();
+            }
+            return {};
+        }
+        power_measurements.emplace_back(power_measurement.release());
+    }
+    return power_measurements;
+}
+
+// Returns the sum of the average power of the devices, or NaN if it wasn't measured
+static double stop_power_measurements(std::vector<LongPowerMeasurement> &power_measurements)
+{
+    if (power_measurements.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    double total_power = 0;
+    bool is_measured = true;
+    for (auto &power_measurement : power_measurements) {
+        if (HAILO_SUCCESS != power_measurement.stop()) {
+            is_measured = false;
+            continue;
+        }
+        total_power += power_measurement.data().average_value;
+    }
+    return is_measured ? total_power : std::numeric_limits<double>::quiet_NaN();
+}
+
+hailo_status BenchScenarioCommand::run_phases(const BenchScenario &scenario,
+    std::vector<std::shared_ptr<NetworkRunner>> &net_runners, std::vector<std::reference_wrapper<Device>> &physical_devices,
+    BenchScenarioResult &result)
+{
+    // Warmup - the open loop backlog is drained before the steady state, so the warmup frames aren't measured
+    for (auto &net_runner : net_runners) {
+        if (net_runner->is_open_loop()) {
+            net_runner->start_load_step(1.0, scenario.warmup_duration);
+        }
+    }
+    std::this_thread::sleep_for(scenario.warmup_duration);
+    for (auto &net_runner : net_runners) {
+        if (!net_runner->is_open_loop()) {
+            continue;
+        }
+        if (!net_runner->wait_for_load_drain(scenario.cooldown_duration)) {
+            LOGGER__WARNING("{} wasn't drained {} ms after the warmup, the offered load is above the sustainable throughput",
+                net_runner->get_name(), scenario.cooldown_duration.count());
+        }
+        (void) net_runner->get_load_step_result();
+    }
+
+    // Steady state
+    auto counters_before = read_scheduler_counters(net_runners);
+    CHECK_EXPECTED_AS_STATUS(counters_before);
+    auto power_measurements = start_power_measurements(physical_devices);
+    const auto steady_state_start = std::chrono::steady_clock::now();
+    for (auto &net_runner : net_runners) {
+        if (net_runner->is_open_loop()) {
+            net_runner->start_load_step(1.0, scenario.steady_state_duration);
+        } else {
+            net_runner->start_closed_loop_measurement();
+        }
+    }
+    std::this_thread::sleep_for(scenario.steady_state_duration);
+
+    std::vector<LoadStepResult> load_results(net_runners.size());
+    for (size_t i = 0; i < net_runners.size(); i++) {
+        if (!net_runners[i]->is_open_loop()) {
+            load_results[i] = net_runners[i]->get_closed_loop_result();
+        }
+    }
+    const std::chrono::duration<double, std::micro> steady_state_elapsed = std::chrono::steady_clock::now() - steady_state_start;
+    result.power_watts = stop_power_measurements(power_measurements);
+    auto counters_after = read_scheduler_counters(net_runners);
+    CHECK_EXPECTED_AS_STATUS(counters_after);
+
+    // Cooldown - the open loop frames that arrived during the steady state are measured until they are received
+    for (size_t i = 0; i < net_runners.size(); i++) {
+        if (!net_runners[i]->is_open_loop()) {
+            continue;
+        }
+        if (!net_runners[i]->wait_for_load_drain(scenario.cooldown_duration)) {
+            LOGGER__WARNING("{} wasn't drained after a cooldown of {} ms, the offered load is above the sustainable throughput",
+                net_runners[i]->get_name(), scenario.cooldown_duration.count());
+        }
+        load_results[i] = net_runners[i]->get_load_step_result();
+    }
+
+    for (size_t i = 0; i < net_runners.size(); i++) {
+        const auto active_time_us = counters_after.value()[i].active_time_us - counters_before.value()[i].active_time_us;
+        result.models.emplace_back(BenchScenarioModelResult{
+            load_results[i],
+            counters_after.value()[i].switches_count - counters_before.value()[i].switches_count,
+            static_cast<double>(active_time_us) / steady_state_elapsed.count()
+        });
+    }
+    return HAILO_SUCCESS;
+}
+
+hailo_status BenchScenarioCommand::execute()
+{
+    auto scenario = BenchScenario::load(m_scenario_path);
+    CHECK_EXPECTED_AS_STATUS(scenario);
+
+    hailo_vdevice_params_t vdevice_params = {};
+    CHECK_SUCCESS(hailo_init_vdevice_params(&vdevice_params));
+    vdevice_params.device_count = scenario->device_count;
+    // The models share the devices, so the scheduler must be enabled
+    vdevice_params.scheduling_algorithm = HAILO_SCHEDULING_ALGORITHM_ROUND_ROBIN;
+    auto vdevice = VDevice::create(vdevice_params);
+    CHECK_EXPECTED_AS_STATUS(vdevice);
+
+    // The runners keep a reference to their params, which are owned by the scenario
+    std::vector<std::shared_ptr<NetworkRunner>> net_runners;
+    for (auto &net_params : scenario->models) {
+        auto net_runner = NetworkRunner::create_shared(*vdevice->get(), net_params);
+        CHECK_EXPECTED_AS_STATUS(net_runner);
+        net_runners.emplace_back(net_runner.release());
+    }
+
+    std::vector<std::reference_wrapper<Device>> physical_devices;
+    if (!m_not_measure_power) {
+        auto devices = vdevice.value()->get_physical_devices();
+        if (devices) {
+            physical_devices = devices.release();
+        } else {
+            LOGGER__WARNING("Failed getting the physical devices with status {}, the power won't be measured", devices.status());
+        }
+    }
+
+    BenchScenarioResult result{};
+    result.device_count = scenario->device_count;
+    result.steady_state_duration = scenario->steady_state_duration;
+    result.power_watts = std::numeric_limits<double>::quiet_NaN();
+    hailo_status status = HAILO_UNINITIALIZED;
+    hailo_status threads_status = HAILO_UNINITIALIZED;
+    {
+        LivePrinter live_printer(std::chrono::seconds(1));
+        live_printer.add(std::make_shared<TimerLiveTrack>(scenario->warmup_duration + scenario->steady_state_duration));
+
+        auto shutdown_event = Event::create(Event::State::not_signalled);
+        CHECK_EXPECTED_AS_STATUS(shutdown_event);
+        std::vector<AsyncThreadPtr<hailo_status>> threads;
+        for (auto &net_runner : net_runners) {
+            threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([&net_runner, &shutdown_event, &live_printer](){
+                return net_runner->run(shutdown_event.value(), live_printer);
+            }));
+        }
+        live_printer.start();
+        status = run_phases(scenario.value(), net_runners, physical_devices, result);
+        shutdown_event->signal();
+        threads_status = wait_for_threads(threads);
+    }
+    CHECK_SUCCESS(status);
+    CHECK_SUCCESS(threads_status);
+
+    BenchScenarioReport::print(result);
+    if (!m_csv_path.empty()) {
+        CHECK_SUCCESS(BenchScenarioReport::write_csv(result, m_csv_path));
+    }
+    if (!m_json_path.empty()) {
+        CHECK_SUCCESS(BenchScenarioReport::write_json(result, m_json_path));
+    }
+    return HAILO_SUCCESS;
+}
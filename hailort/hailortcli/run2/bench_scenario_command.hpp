@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file bench_scenario_command.hpp
+ * @brief Run a multi-model benchmark scenario file
+ **/
+
+#ifndef _HAILO_HAILORTCLI_RUN2_BENCH_SCENARIO_COMMAND_HPP_
+#define _HAILO_HAILORTCLI_RUN2_BENCH_SCENARIO_COMMAND_HPP_
+
+#include "../command.hpp"
+#include "bench_scenario.hpp"
+#include "network_runner.hpp"
+
+#include "hailo/device.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class BenchScenarioCommand : public Command {
+public:
+    explicit BenchScenarioCommand(CLI::App &parent_app);
+    hailo_status execute() override;
+
+private:
+    static hailo_status run_phases(const BenchScenario &scenario, std::vector<std::shared_ptr<NetworkRunner>> &net_runners,
+        std::vector<std::reference_wrapper<hailort::Device>> &physical_devices, BenchScenarioResult &result);
+
+    std::string m_scenario_path;
+    std::string m_csv_path;
+    std::string m_json_path;
+    bool m_not_measure_power;
+};
+
+#endif /* _HAILO_HAILORTCLI_RUN2_BENCH_SCENARIO_COMMAND_HPP_ */
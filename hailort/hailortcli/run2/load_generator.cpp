@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file load_generator.cpp
+ * @brief Open-loop load generation and latency-under-load reporting
+ **/
+
+#include "load_generator.hpp"
+#include "common/utils.hpp"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/fmt/fmt.h>
+#include <fstream>
+#include <iostream>
+
+using namespace hailort;
+using ordered_json = nlohmann::ordered_json;
+
+std::string arrival_process_to_string(ArrivalProcess arrival_process)
+{
+    switch (arrival_process) {
+    case ArrivalProcess::CLOSED_LOOP:
+        return "closed";
+    case ArrivalProcess::UNIFORM:
+        return "uniform";
+    case ArrivalProcess::POISSON:
+        return "poisson";
+    case ArrivalProcess::BURSTY:
+        return "bursty";
+    default:
+        return "unknown";
+    }
+}
+
+LoadGenerator::LoadGenerator(ArrivalProcess arrival_process, double rate_fps, uint32_t burst_size) :
+    m_arrival_process(arrival_process),
+    m_rate_fps(rate_fps),
+    m_burst_size(std::max(burst_size, 1u)),
+    m_is_stopped(false),
+    m_is_step_active(false),
+    m_load_scale(1.0),
+    m_step_start(),
+    m_step_end(),
+    m_step_first_frame(0),
+    m_burst_remaining(0),
+    m_random_engine(std::random_device()()),
+    m_arrivals(),
+    m_read_frames_count(0),
+    m_last_read_time(),
+    m_queueing_delay("queueing_delay"),
+    m_latency("latency")
+{}
+
+void LoadGenerator::start_step(double load_scale, std::chrono::milliseconds duration)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_step_active = true;
+        m_load_scale = load_scale;
+        m_step_start = std::chrono::steady_clock::now();
+        m_step_end = m_step_start + duration;
+        m_step_first_frame = m_arrivals.size();
+        m_burst_remaining = 0;
+        m_last_read_time = m_step_start;
+        m_queueing_delay.snapshot_and_clear();
+        m_latency.snapshot_and_clear();
+    }
+    m_cv.notify_all();
+}
+
+bool LoadGenerator::wait_for_drain(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Frames that arrived while the writers were blocked weren't generated yet
+    generate_all_step_arrivals();
+    m_cv.notify_all();
+    return m_cv.wait_for(lock, timeout, [this]() {
+        return m_is_stopped || (m_read_frames_count >= m_arrivals.size());
+    }) && !m_is_stopped;
+}
+
+LoadStepResult LoadGenerator::get_step_result(const std::string &network_name)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    LoadStepResult result{};
+    result.network_name = network_name;
+    result.arrival_process = m_arrival_process;
+    result.load_scale = m_load_scale;
+    result.offered_fps = m_rate_fps * m_load_scale;
+    result.frames_count = m_arrivals.size() - m_step_first_frame;
+    result.drained = (m_read_frames_count >= m_arrivals.size());
+    const auto active_duration = std::chrono::duration<double>(m_last_read_time - m_step_start).count();
+    result.throughput_fps = (active_duration > 0) ? (static_cast<double>(result.frames_count) / active_duration) : 0;
+    result.queueing_delay = m_queueing_delay.snapshot_and_clear();
+    result.latency = m_latency.snapshot_and_clear();
+    return result;
+}
+
+void LoadGenerator::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_stopped = true;
+    }
+    m_cv.notify_all();
+}
+
+Expected<LoadGenerator::time_point> LoadGenerator::wait_for_arrival(size_t frame_index)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (frame_index >= m_arrivals.size()) {
+        if (m_is_stopped) {
+            return make_unexpected(HAILO_SHUTDOWN_EVENT_SIGNALED);
+        }
+        if (!generate_next_arrival()) {
+            // The current step is over, wait for the next one
+            m_cv.wait(lock);
+        }
+    }
+
+    auto arrival = m_arrivals[frame_index];
+    m_cv.wait_until(lock, arrival, [this]() { return m_is_stopped; });
+    if (m_is_stopped) {
+        return make_unexpected(HAILO_SHUTDOWN_EVENT_SIGNALED);
+    }
+    return arrival;
+}
+
+void LoadGenerator::add_write_done(time_point arrival)
+{
+    m_queueing_delay.add_data_point(std::chrono::duration<double>(std::chrono::steady_clock::now() - arrival).count());
+}
+
+void LoadGenerator::add_read_done(size_t frame_index)
+{
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        assert(frame_index < m_arrivals.size());
+        m_latency.add_data_point(std::chrono::duration<double>(now - m_arrivals[frame_index]).count());
+        m_read_frames_count = frame_index + 1;
+        m_last_read_time = now;
+    }
+    m_cv.notify_all();
+}
+
+bool LoadGenerator::generate_next_arrival()
+{
+    if (!m_is_step_active) {
+        return false;
+    }
+
+    const bool is_first_in_step = (m_arrivals.size() == m_step_first_frame);
+    const auto last_arrival = is_first_in_step ? m_step_start : m_arrivals.back();
+    const auto rate = m_rate_fps * m_load_scale;
+
+    std::chrono::duration<double> interval(0);
+    switch (m_arrival_process) {
+    case ArrivalProcess::UNIFORM:
+        interval = std::chrono::duration<double>(is_first_in_step ? 0 : (1 / rate));
+        break;
+    case ArrivalProcess::POISSON:
+        interval = std::chrono::duration<double>(std::exponential_distribution<double>(rate)(m_random_engine));
+        break;
+    case ArrivalProcess::BURSTY:
+        if (0 < m_burst_remaining) {
+            m_burst_remaining--;
+        } else {
+            // Bursts arrive at (rate / burst_size), so the average frame rate is still rate
+            interval = std::chrono::duration<double>(
+                std::exponential_distribution<double>(rate / m_burst_size)(m_random_engine));
+            m_burst_remaining = m_burst_size - 1;
+        }
+        break;
+    default:
+        assert(false);
+        return false;
+    }
+
+    const auto arrival = last_arrival + std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+    if (arrival >= m_step_end) {
+        // No more arrivals in this step (re-drawing could place a late arrival after the drain began)
+        m_is_step_active = false;
+        return false;
+    }
+    m_arrivals.push_back(arrival);
+    return true;
+}
+
+void LoadGenerator::generate_all_step_arrivals()
+{
+    while (generate_next_arrival()) {}
+}
+
+double to_ms(const Expected<double> &seconds)
+{
+    return seconds ? (seconds.value() * 1000) : 0;
+}
+
+const std::vector<double> &report_percentiles()
+{
+    static const auto percentiles = AccumulatorResults::reported_percentiles();
+    return percentiles;
+}
+
+void LoadCurveReport::print(const std::vector<LoadStepResult> &results)
+{
+    std::cout << "> Latency under load:" << std::endl;
+    for (const auto &result : results) {
+        std::cout << fmt::format("  {} ({}, x{:.2f}): offered {:.2f} fps, throughput {:.2f} fps{}", result.network_name,
+            arrival_process_to_string(result.arrival_process), result.load_scale, result.offered_fps, result.throughput_fps,
+            result.drained ? "" : " (not drained)") << std::endl;
+        std::cout << fmt::format("    Queueing delay: mean {:.3f} ms, p99 {:.3f} ms", to_ms(result.queueing_delay.mean()),
+            to_ms(result.queueing_delay.percentile(99))) << std::endl;
+        std::cout << fmt::format("    Latency: mean {:.3f} ms, p50 {:.3f} ms, p99 {:.3f} ms, p99.9 {:.3f} ms", to_ms(result.latency.mean()),
+            to_ms(result.latency.percentile(50)), to_ms(result.latency.percentile(99)), to_ms(result.latency.percentile(99.9))) << std::endl;
+    }
+}
+
+hailo_status LoadCurveReport::write_csv(const std::vector<LoadStepResult> &results, const std::string &path)
+{
+    std::ofstream file(path, std::ios::out);
+    CHECK(file.good(), HAILO_OPEN_FILE_FAILURE, "Failed opening file {}, errno: {}", path, errno);
+
+    file << "net_name,arrival_process,load_scale,offered_fps,throughput_fps,frames_count,drained,queueing_delay_mean_ms";
+    for (const auto percentile : report_percentiles()) {
+        file << ",queueing_delay_p" << percentile << "_ms";
+    }
+    file << ",latency_mean_ms";
+    for (const auto percentile : report_percentiles()) {
+        file << ",latency_p" << percentile << "_ms";
+    }
+    file << std::endl;
+
+    for (const auto &result : results) {
+        file << result.network_name << "," << arrival_process_to_string(result.arrival_process) << "," << result.load_scale << ","
+             << result.offered_fps << "," << result.throughput_fps << "," << result.frames_count << "," << result.drained << ","
+             << to_ms(result.queueing_delay.mean());
+        for (const auto percentile : report_percentiles()) {
+            file << "," << to_ms(result.queueing_delay.percentile(percentile));
+        }
+        file << "," << to_ms(result.latency.mean());
+        for (const auto percentile : report_percentiles()) {
+            file << "," << to_ms(result.latency.percentile(percentile));
+        }
+        file << std::endl;
+    }
+    CHECK(file.good(), HAILO_FILE_OPERATION_FAILURE, "Failed writing to file {}", path);
+    return HAILO_SUCCESS;
+}
+
+ordered_json histogram_to_json(const HistogramSnapshot &histogram)
+{
+    ordered_json json;
+    json["mean_ms"] = to_ms(histogram.mean());
+    for (const auto percentile : report_percentiles()) {
+        json[fmt::format("p{}_ms", percentile)] = to_ms(histogram.percentile(percentile));
+    }
+    json["max_ms"] = to_ms(histogram.max());
+    return json;
+}
+
+hailo_status LoadCurveReport::write_json(const std::vector<LoadStepResult> &results, const std::string &path)
+{
+    ordered_json steps = ordered_json::array();
+    for (const auto &result : results) {
+        ordered_json step;
+        step["net_name"] = result.network_name;
+        step["arrival_process"] = arrival_process_to_string(result.arrival_process);
+        step["load_scale"] = result.load_scale;
+        step["offered_fps"] = result.offered_fps;
+        step["throughput_fps"] = result.throughput_fps;
+        step["frames_count"] = result.frames_count;
+        step["drained"] = result.drained;
+        step["queueing_delay"] = histogram_to_json(result.queueing_delay);
+        step["latency"] = histogram_to_json(result.latency);
+        steps.push_back(step);
+    }
+
+    std::ofstream file(path, std::ios::out);
+    CHECK(file.good(), HAILO_OPEN_FILE_FAILURE, "Failed opening file {}, errno: {}", path, errno);
+    file << ordered_json{{"load_steps", steps}}.dump(4) << std::endl;
+    CHECK(file.good(), HAILO_FILE_OPERATION_FAILURE, "Failed writing to file {}", path);
+    return HAILO_SUCCESS;
+}
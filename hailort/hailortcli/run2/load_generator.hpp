@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file load_generator.hpp
+ * @brief Open-loop load generation and latency-under-load reporting
+ *
+ * In open-loop mode frames "arrive" according to an arrival process that doesn't depend on how fast the device
+ * consumes them, so a slow device builds up a backlog (as with real cameras/clients) instead of slowing the sender.
+ * The run is split into load steps, each one offering a different fraction of the configured rate. Between steps
+ * the backlog is drained, so every step is measured independently.
+ **/
+
+#ifndef _HAILO_HAILORTCLI_RUN2_LOAD_GENERATOR_HPP_
+#define _HAILO_HAILORTCLI_RUN2_LOAD_GENERATOR_HPP_
+
+#include "hailo/expected.hpp"
+#include "common/runtime_statistics_internal.hpp"
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class ArrivalProcess {
+    CLOSED_LOOP,    // A frame is written as soon as the previous write returns (optionally paced by --framerate)
+    UNIFORM,        // Open loop - frames arrive at a constant rate
+    POISSON,        // Open loop - exponentially distributed inter-arrival times
+    BURSTY          // Open loop - bursts of frames arrive together, the bursts arrive as a Poisson process
+};
+
+std::string arrival_process_to_string(ArrivalProcess arrival_process);
+
+struct LoadStepResult
+{
+    std::string network_name;
+    ArrivalProcess arrival_process;
+    double load_scale;
+    double offered_fps;
+    double throughput_fps;
+    size_t frames_count;
+    bool drained;
+    // Time from a frame's arrival until its write returns (seconds)
+    hailort::HistogramSnapshot queueing_delay;
+    // Time from a frame's arrival until its first output is read (seconds)
+    hailort::HistogramSnapshot latency;
+};
+
+class LoadGenerator final
+{
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    LoadGenerator(ArrivalProcess arrival_process, double rate_fps, uint32_t burst_size);
+
+    // Issues arrivals at (rate_fps * load_scale) for the given duration, starting now
+    void start_step(double load_scale, std::chrono::milliseconds duration);
+    // Waits until all frames that arrived during the current step were received. Returns false on timeout.
+    bool wait_for_drain(std::chrono::milliseconds timeout);
+    // Returns the results of the current step and clears its statistics
+    LoadStepResult get_step_result(const std::string &network_name);
+    void stop();
+
+    // Blocks until the frame arrives. Returns HAILO_SHUTDOWN_EVENT_SIGNALED if stop() was called.
+    hailort::Expected<time_point> wait_for_arrival(size_t frame_index);
+    void add_write_done(time_point arrival);
+    void add_read_done(size_t frame_index);
+
+private:
+    // These functions are to be called after acquiring the mutex
+    bool generate_next_arrival();
+    void generate_all_step_arrivals();
+
+    const ArrivalProcess m_arrival_process;
+    const double m_rate_fps;
+    const uint32_t m_burst_size;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_is_stopped;
+    bool m_is_step_active;
+    double m_load_scale;
+    time_point m_step_start;
+    time_point m_step_end;
+    size_t m_step_first_frame;
+    uint32_t m_burst_remaining;
+    std::mt19937 m_random_engine;
+    // Arrival time of every frame (indexed by the frame index, across all steps)
+    std::vector<time_point> m_arrivals;
+    size_t m_read_frames_count;
+    time_point m_last_read_time;
+
+    hailort::HistogramAccumulator<double> m_queueing_delay;
+    hailort::HistogramAccumulator<double> m_latency;
+};
+
+/* Helpers for reporting the latency histograms (which are in seconds) in milliseconds */
+double to_ms(const hailort::Expected<double> &seconds);
+const std::vector<double> &report_percentiles();
+nlohmann::ordered_json histogram_to_json(const hailort::HistogramSnapshot &histogram);
+
+/* Writes the load steps results as a throughput/latency curve */
+class LoadCurveReport final
+{
+public:
+    static void print(const std::vector<LoadStepResult> &results);
+    static hailo_status write_csv(const std::vector<LoadStepResult> &results, const std::string &path);
+    static hailo_status write_json(const std::vector<LoadStepResult> &results, const std::string &path);
+};
+
+#endif /* _HAILO_HAILORTCLI_RUN2_LOAD_GENERATOR_HPP_ */
@@ -8,25 +8,11 @@
  **/
 
 #include "network_runner.hpp"
-#include "common/async_thread.hpp"
+#include "threads_utils.hpp"
 #include "hailort_defaults.hpp" //TODO: not API
 
 using namespace hailort;
 
-//TODO: duplicated
-static hailo_status wait_for_threads(std::vector<AsyncThreadPtr<hailo_status>> &threads)
-{
-    auto last_error_status = HAILO_SUCCESS;
-    for (auto &thread : threads) {
-        auto thread_status = thread->get();
-        if ((HAILO_SUCCESS != thread_status) && (HAILO_STREAM_ABORTED_BY_USER != thread_status)) {
-            last_error_status = thread_status;
-            LOGGER__ERROR("Thread failed with with status {}", thread_status);
-        }
-    }
-    return last_error_status;
-}
-
 VStreamParams::VStreamParams() : name(), params(HailoRTDefaults::get_vstreams_params())
 {
 }
@@ -34,12 +20,20 @@ VStreamParams::VStreamParams() : name(), params(HailoRTDefaults::get_vstreams_pa
 NetworkRunner::NetworkRunner(const NetworkParams &params, const std::string &name,
     std::vector<InputVStream> &&input_vstreams, std::vector<OutputVStream> &&output_vstreams)
     : m_params(params), m_name(name), m_input_vstreams(std::move(input_vstreams)),
-      m_output_vstreams(std::move(output_vstreams))
+      m_output_vstreams(std::move(output_vstreams)),
+      m_load_generator((ArrivalProcess::CLOSED_LOOP == params.arrival_process) ? nullptr :
+        std::make_shared<LoadGenerator>(params.arrival_process, static_cast<double>(params.framerate), params.burst_size)),
+      m_write_times(), m_measurement_start(std::chrono::steady_clock::now()), m_measured_frames_count(0),
+      m_closed_loop_latency("closed_loop_latency")
 {
 }
 
 Expected<std::shared_ptr<NetworkRunner>> NetworkRunner::create_shared(VDevice &vdevice, const NetworkParams &params)
 {
+    CHECK_AS_EXPECTED((ArrivalProcess::CLOSED_LOOP == params.arrival_process) || (UNLIMITED_FRAMERATE != params.framerate),
+        HAILO_INVALID_ARGUMENT, "--framerate must be set when using --arrival-process {}",
+        arrival_process_to_string(params.arrival_process));
+
     auto hef = Hef::create(params.hef_path);
     CHECK_EXPECTED(hef);
 
@@ -77,13 +71,21 @@ Expected<std::shared_ptr<NetworkRunner>> NetworkRunner::create_shared(VDevice &v
     return net_runner;
 }
 
-hailo_status NetworkRunner::run_input_vstream(InputVStream &vstream)
+hailo_status NetworkRunner::run_input_vstream(InputVStream &vstream, bool first)
 {
+    if (nullptr != m_load_generator) {
+        return run_input_vstream_open_loop(vstream, first);
+    }
+
     auto dataset = Buffer::create(vstream.get_frame_size(), 0xAB);
     CHECK_EXPECTED_AS_STATUS(dataset);
     auto last_write_time = std::chrono::steady_clock::now();
     auto framerate_interval = std::chrono::duration<double>(1) / m_params.framerate;
     while(true) {
+        if (first) {
+            std::unique_lock<std::mutex> lock(m_closed_loop_mutex);
+            m_write_times.push_back(std::chrono::steady_clock::now());
+        }
         auto status = vstream.write(MemoryView(dataset.value()));
         if (status == HAILO_STREAM_ABORTED_BY_USER) {
             return status;
@@ -99,10 +101,35 @@ hailo_status NetworkRunner::run_input_vstream(InputVStream &vstream)
     return HAILO_SUCCESS;
 }
 
+hailo_status NetworkRunner::run_input_vstream_open_loop(InputVStream &vstream, bool first)
+{
+    auto dataset = Buffer::create(vstream.get_frame_size(), 0xAB);
+    CHECK_EXPECTED_AS_STATUS(dataset);
+    for (size_t frame_index = 0; ; frame_index++) {
+        auto arrival = m_load_generator->wait_for_arrival(frame_index);
+        if (HAILO_SHUTDOWN_EVENT_SIGNALED == arrival.status()) {
+            return HAILO_STREAM_ABORTED_BY_USER;
+        }
+        CHECK_EXPECTED_AS_STATUS(arrival);
+
+        // A frame that arrived while the previous write was blocked is written late - that's the queueing delay
+        auto status = vstream.write(MemoryView(dataset.value()));
+        if (status == HAILO_STREAM_ABORTED_BY_USER) {
+            return status;
+        }
+        CHECK_SUCCESS(status);
+        if (first) {
+            m_load_generator->add_write_done(arrival.value());
+        }
+    }
+    return HAILO_SUCCESS;
+}
+
 hailo_status NetworkRunner::run_output_vstream(OutputVStream &vstream, bool first, std::shared_ptr<NetworkLiveTrack> net_live_track)
 {
     auto result = Buffer::create(vstream.get_frame_size());
     CHECK_EXPECTED_AS_STATUS(result);
+    size_t frame_index = 0;
     while(true) {
         auto status = vstream.read(MemoryView(result.value()));
         if (status == HAILO_STREAM_ABORTED_BY_USER) {
@@ -111,6 +138,12 @@ hailo_status NetworkRunner::run_output_vstream(OutputVStream &vstream, bool firs
         CHECK_SUCCESS(status);
         if (first) {
             net_live_track->progress();
+            if (nullptr != m_load_generator) {
+                m_load_generator->add_read_done(frame_index);
+            } else {
+                add_closed_loop_read_done();
+            }
+            frame_index++;
         }
     }
     return HAILO_SUCCESS;
@@ -119,10 +152,12 @@ hailo_status NetworkRunner::run_output_vstream(OutputVStream &vstream, bool firs
 hailo_status NetworkRunner::run(Event &shutdown_event, LivePrinter &live_printer)
 {
     std::vector<AsyncThreadPtr<hailo_status>> threads;
+    bool first_input = true;
     for (auto &input_vstream : m_input_vstreams) {
-        threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([this, &input_vstream](){
-            return run_input_vstream(input_vstream);
+        threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([this, &input_vstream, first_input](){
+            return run_input_vstream(input_vstream, first_input);
         }));
+        first_input = false;
     }
 
     auto net_live_track = std::make_shared<NetworkLiveTrack>(m_name);
@@ -130,7 +165,7 @@ hailo_status NetworkRunner::run(Event &shutdown_event, LivePrinter &live_printer
 
     bool first = true;//TODO: check with multiple outputs
     for (auto &output_vstream : m_output_vstreams) {
-        threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([&output_vstream, first, net_live_track](){
+        threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([this, &output_vstream, first, net_live_track](){
             return run_output_vstream(output_vstream, first, net_live_track);
         }));
         first = false;
@@ -144,6 +179,9 @@ hailo_status NetworkRunner::run(Event &shutdown_event, LivePrinter &live_printer
 
 void NetworkRunner::stop()
 {
+    if (nullptr != m_load_generator) {
+        m_load_generator->stop();
+    }
     for (auto &input_vstream : m_input_vstreams) {
         (void) input_vstream.abort();
     }
@@ -152,6 +190,77 @@ void NetworkRunner::stop()
     }
 }
 
+const std::string &NetworkRunner::get_name() const
+{
+    return m_name;
+}
+
+bool NetworkRunner::is_open_loop() const
+{
+    return (nullptr != m_load_generator);
+}
+
+void NetworkRunner::start_load_step(double load_scale, std::chrono::milliseconds duration)
+{
+    assert(is_open_loop());
+    m_load_generator->start_step(load_scale, duration);
+}
+
+bool NetworkRunner::wait_for_load_drain(std::chrono::milliseconds timeout)
+{
+    assert(is_open_loop());
+    return m_load_generator->wait_for_drain(timeout);
+}
+
+LoadStepResult NetworkRunner::get_load_step_result()
+{
+    assert(is_open_loop());
+    return m_load_generator->get_step_result(m_name);
+}
+
+void NetworkRunner::start_closed_loop_measurement()
+{
+    assert(!is_open_loop());
+    std::unique_lock<std::mutex> lock(m_closed_loop_mutex);
+    // The frames in flight stay queued, so they are matched to their outputs
+    m_measurement_start = std::chrono::steady_clock::now();
+    m_measured_frames_count = 0;
+    m_closed_loop_latency.snapshot_and_clear();
+}
+
+LoadStepResult NetworkRunner::get_closed_loop_result()
+{
+    assert(!is_open_loop());
+    std::unique_lock<std::mutex> lock(m_closed_loop_mutex);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_measurement_start;
+
+    LoadStepResult result{};
+    result.network_name = m_name;
+    result.arrival_process = ArrivalProcess::CLOSED_LOOP;
+    result.load_scale = 1.0;
+    result.offered_fps = static_cast<double>(m_params.framerate);
+    result.throughput_fps = (elapsed.count() > 0) ? (static_cast<double>(m_measured_frames_count) / elapsed.count()) : 0;
+    result.frames_count = m_measured_frames_count;
+    result.drained = true;
+    result.latency = m_closed_loop_latency.snapshot();
+    return result;
+}
+
+void NetworkRunner::add_closed_loop_read_done()
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(m_closed_loop_mutex);
+    if (m_write_times.empty()) {
+        return;
+    }
+    const auto write_time = m_write_times.front();
+    m_write_times.pop_front();
+    if (write_time >= m_measurement_start) {
+        m_closed_loop_latency.add_data_point(std::chrono::duration<double>(now - write_time).count());
+    }
+    m_measured_frames_count++;
+}
+
 Expected<std::pair<std::vector<InputVStream>, std::vector<OutputVStream>>> NetworkRunner::create_vstreams(
     ConfiguredNetworkGroup &net_group, const std::map<std::string, hailo_vstream_params_t> &params)
 {//TODO: support network name
@@ -18,11 +18,15 @@
 
 #include "live_printer.hpp"
 #include "network_live_track.hpp"
+#include "load_generator.hpp"
 
+#include <deque>
+#include <mutex>
 #include <string>
 #include <vector>
 
 constexpr uint32_t UNLIMITED_FRAMERATE = 0;
+constexpr uint32_t DEFAULT_BURST_SIZE = 8;
 
 struct VStreamParams
 {
@@ -45,6 +49,9 @@ struct NetworkParams
 
     // Run parameters
     uint32_t framerate;
+    // In open loop (any arrival process but CLOSED_LOOP) framerate is the offered rate at load scale 1
+    ArrivalProcess arrival_process;
+    uint32_t burst_size;
 };
 
 class NetworkRunner
@@ -56,17 +63,37 @@ public:
     hailo_status run(hailort::Event &shutdown_event, LivePrinter &live_printer);
     void stop();
 
+    const std::string &get_name() const;
+    bool is_open_loop() const;
+    // Open loop only - see LoadGenerator
+    void start_load_step(double load_scale, std::chrono::milliseconds duration);
+    bool wait_for_load_drain(std::chrono::milliseconds timeout);
+    LoadStepResult get_load_step_result();
+    // Closed loop only - measures the time from writing a frame (to the first input) until its first output is read
+    void start_closed_loop_measurement();
+    LoadStepResult get_closed_loop_result();
+
 private:
     static hailort::Expected<std::pair<std::vector<hailort::InputVStream>, std::vector<hailort::OutputVStream>>> create_vstreams(
         hailort::ConfiguredNetworkGroup &net_group, const std::map<std::string, hailo_vstream_params_t> &params);
-    hailo_status run_input_vstream(hailort::InputVStream &vstream);
-    static hailo_status run_output_vstream(hailort::OutputVStream &vstream, bool first, std::shared_ptr<NetworkLiveTrack> net_live_track);
+    hailo_status run_input_vstream(hailort::InputVStream &vstream, bool first);
+    hailo_status run_input_vstream_open_loop(hailort::InputVStream &vstream, bool first);
+    hailo_status run_output_vstream(hailort::OutputVStream &vstream, bool first, std::shared_ptr<NetworkLiveTrack> net_live_track);
+    void add_closed_loop_read_done();
 
 
     const NetworkParams &m_params;//TODO: copy instead of ref?
     std::string m_name;
     std::vector<hailort::InputVStream> m_input_vstreams;
     std::vector<hailort::OutputVStream> m_output_vstreams;
+    std::shared_ptr<LoadGenerator> m_load_generator;
+
+    // The closed loop frames are read in the order they were written, so the write times are matched in FIFO order
+    std::mutex m_closed_loop_mutex;
+    std::deque<std::chrono::steady_clock::time_point> m_write_times;
+    std::chrono::steady_clock::time_point m_measurement_start;
+    size_t m_measured_frames_count;
+    hailort::HistogramAccumulator<double> m_closed_loop_latency;
 };
 
 #endif /* _HAILO_HAILORTCLI_RUN2_NETWORK_RUNNER_HPP_ */
\ No newline at end of file
@@ -11,17 +11,20 @@
 #include "live_printer.hpp"
 #include "timer_live_track.hpp"
 #include "network_runner.hpp"
+#include "threads_utils.hpp"
 
-#include "common/async_thread.hpp"
 #include "hailo/vdevice.hpp"
 #include "hailo/hef.hpp"
+#include "hailo/network_group_tuner.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 using namespace hailort;
 
 constexpr uint32_t DEFAULT_TIME_TO_RUN_SECONDS = 5;
+constexpr std::chrono::seconds MIN_LOAD_DRAIN_TIMEOUT(10);
 
 /** VStreamNameValidator */
 class VStreamNameValidator : public CLI::Validator {
@@ -190,7 +193,21 @@ NetworkApp::NetworkApp(const std::string &description, const std::string &name)
     net_params->add_option("--scheduler-timeout", m_params.scheduler_timeout_ms, "Scheduler timeout in milliseconds")->default_val(0);
 
     auto run_params = add_option_group("Run Parameters");
-    run_params->add_option("--framerate", m_params.framerate, "Input vStreams framerate")->default_val(UNLIMITED_FRAMERATE);
+    run_params->add_option("--framerate", m_params.framerate, "Input vStreams framerate (the offered rate in open loop)")
+        ->default_val(UNLIMITED_FRAMERATE);
+    run_params->add_option("--arrival-process", m_params.arrival_process,
+        "Frames arrival process. 'closed' writes a frame when the previous write returns, the others generate frames "
+        "at --framerate regardless of the device (open loop) and report latency under load")
+        ->transform(HailoCheckedTransformer<ArrivalProcess>({
+            { "closed", ArrivalProcess::CLOSED_LOOP },
+            { "uniform", ArrivalProcess::UNIFORM },
+            { "poisson", ArrivalProcess::POISSON },
+            { "bursty", ArrivalProcess::BURSTY }
+        }))
+        ->default_val("closed");
+    run_params->add_option("--burst-size", m_params.burst_size, "Frames per burst (for '--arrival-process bursty')")
+        ->default_val(DEFAULT_BURST_SIZE)
+        ->check(CLI::PositiveNumber);
 
     add_vstream_app_subcom(hef_path_option, net_group_name_option);
 }
@@ -235,19 +252,38 @@ public:
 
     const std::vector<NetworkParams>& get_network_params();
     std::chrono::seconds get_time_to_run();
+    const std::vector<double>& get_load_steps();
+    const std::string& get_load_curve_csv_path();
+    const std::string& get_load_curve_json_path();
+    const std::string& get_config_path();
 
 private:
     void add_net_app_subcom();
     std::vector<NetworkParams> m_network_params;
+    std::string m_config_path;
     uint32_t m_time_to_run;
+    std::vector<double> m_load_steps;
+    std::string m_load_curve_csv_path;
+    std::string m_load_curve_json_path;
 };
 
-Run2::Run2() : CLI::App("Run networks (preview)", "run2")
+Run2::Run2() : CLI::App("Run networks (preview)", "run2"), m_load_steps({1.0})
 {
     add_net_app_subcom();
     add_option("-t,--time-to-run", m_time_to_run, "Time to run (seconds)")
         ->default_val(DEFAULT_TIME_TO_RUN_SECONDS)
         ->check(CLI::PositiveNumber);
+    add_option("--config", m_config_path,
+        "Run the networks of a config file (e.g. recommended by \"hailortcli autotune\"), in addition to the set-net ones")
+        ->check(CLI::ExistingFile);
+
+    auto load_params = add_option_group("Open Loop Parameters");
+    load_params->add_option("--load-steps", m_load_steps,
+        "Load scales to sweep, as fractions of each network's --framerate (e.g. 0.5 0.8 1.0 1.2). "
+        "Each step runs for --time-to-run seconds (default: 1.0)")
+        ->check(CLI::PositiveNumber);
+    load_params->add_option("--load-curve-csv", m_load_curve_csv_path, "Write the latency under load results to a CSV file");
+    load_params->add_option("--load-curve-json", m_load_curve_json_path, "Write the latency under load results to a JSON file");
 }
 
 void Run2::add_net_app_subcom()
@@ -286,33 +322,68 @@ std::chrono::seconds Run2::get_time_to_run()
     return std::chrono::seconds(m_time_to_run);
 }
 
+const std::vector<double>& Run2::get_load_steps()
+{
+    return m_load_steps;
+}
+
+const std::string& Run2::get_load_curve_csv_path()
+{
+    return m_load_curve_csv_path;
+}
+
+const std::string& Run2::get_load_curve_json_path()
+{
+    return m_load_curve_json_path;
+}
+
+const std::string& Run2::get_config_path()
+{
+    return m_config_path;
+}
+
 /** Run2Command */
 Run2Command::Run2Command(CLI::App &parent_app) : Command(parent_app.add_subcommand(std::make_shared<Run2>()))
 {
 }
 
-static hailo_status wait_for_threads(std::vector<AsyncThreadPtr<hailo_status>> &threads)
+static Expected<std::vector<NetworkParams>> get_network_params_from_config(const std::string &config_path)
 {
-    auto last_error_status = HAILO_SUCCESS;
-    for (auto& thread : threads) {
-        auto thread_status = thread->get();
-        if ((HAILO_SUCCESS != thread_status) && (HAILO_STREAM_ABORTED_BY_USER != thread_status)) {
-            last_error_status = thread_status;
-            LOGGER__ERROR("Thread failed with with status {}", thread_status);
-        }
+    auto tuned_params = NetworkGroupTuner::load_config(config_path);
+    CHECK_EXPECTED(tuned_params, "Failed loading config file {}", config_path);
+
+    std::vector<NetworkParams> network_params;
+    for (const auto &params : tuned_params.value()) {
+        NetworkParams net_params{};
+        net_params.hef_path = params.hef_path;
+        net_params.net_group_name = params.network_group_name;
+        net_params.batch_size = params.batch_size;
+        net_params.scheduler_threshold = params.scheduler_threshold;
+        net_params.scheduler_timeout_ms = static_cast<uint32_t>(params.scheduler_timeout.count());
+        net_params.framerate = UNLIMITED_FRAMERATE;
+        net_params.arrival_process = ArrivalProcess::CLOSED_LOOP;
+        net_params.burst_size = DEFAULT_BURST_SIZE;
+        network_params.emplace_back(net_params);
     }
-    return last_error_status;
+    return network_params;
 }
 
 hailo_status Run2Command::execute()
 {
     Run2 *app = reinterpret_cast<Run2*>(m_app);
 
-    if (0 == app->get_network_params().size()) {
+    auto network_params = app->get_network_params();
+    if (!app->get_config_path().empty()) {
+        auto network_params_from_config = get_network_params_from_config(app->get_config_path());
+        CHECK_EXPECTED_AS_STATUS(network_params_from_config);
+        network_params.insert(network_params.end(), network_params_from_config->begin(), network_params_from_config->end());
+    }
+
+    if (0 == network_params.size()) {
         LOGGER__ERROR("Nothing to run");
         return HAILO_INVALID_OPERATION;
     }
-    if (1 == app->get_network_params().size()) {
+    if (1 == network_params.size()) {
         LOGGER__WARN("\"hailortcli run2\" is in preview. It is recommended to use \"hailortcli run\" command for a single network group");
     }
 
@@ -324,25 +395,68 @@ hailo_status Run2Command::execute()
 
     // create network runners
     std::vector<std::shared_ptr<NetworkRunner>> net_runners;
-    for (auto &net_params : app->get_network_params()) {
+    for (auto &net_params : network_params) {
         auto net_runner = NetworkRunner::create_shared(*vdevice->get(), net_params);
         CHECK_EXPECTED_AS_STATUS(net_runner);
         net_runners.emplace_back(net_runner.release());
     }
-    LivePrinter live_printer(std::chrono::seconds(1));
-    live_printer.add(std::make_shared<TimerLiveTrack>(app->get_time_to_run()));
-
-    auto shutdown_event = Event::create(Event::State::not_signalled);
-    CHECK_EXPECTED_AS_STATUS(shutdown_event);
-    std::vector<AsyncThreadPtr<hailo_status>> threads;
-    for (auto &net_runner : net_runners) {
-        threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([&net_runner, &shutdown_event, &live_printer](){
-            return net_runner->run(shutdown_event.value(), live_printer);
-        }));
+    const bool is_open_loop = std::any_of(net_runners.begin(), net_runners.end(),
+        [](const std::shared_ptr<NetworkRunner> &net_runner) { return net_runner->is_open_loop(); });
+    const auto load_steps = is_open_loop ? app->get_load_steps() : std::vector<double>{1.0};
+    const auto time_to_run = app->get_time_to_run();
+
+    std::vector<LoadStepResult> load_results;
+    hailo_status status = HAILO_UNINITIALIZED;
+    {
+        LivePrinter live_printer(std::chrono::seconds(1));
+        live_printer.add(std::make_shared<TimerLiveTrack>(time_to_run * load_steps.size()));
+
+        auto shutdown_event = Event::create(Event::State::not_signalled);
+        CHECK_EXPECTED_AS_STATUS(shutdown_event);
+        std::vector<AsyncThreadPtr<hailo_status>> threads;
+        for (auto &net_runner : net_runners) {
+            threads.emplace_back(std::make_unique<AsyncThread<hailo_status>>([&net_runner, &shutdown_event, &live_printer](){
+                return net_runner->run(shutdown_event.value(), live_printer);
+            }));
+        }
+        // TODO: wait for all nets before starting timer. start() should update TimerLiveTrack to start. or maybe append here but first in vector...
+        live_printer.start();
+        if (is_open_loop) {
+            // The backlog of a step is drained before the next one starts, so the steps are measured independently
+            const auto drain_timeout = std::max<std::chrono::milliseconds>(MIN_LOAD_DRAIN_TIMEOUT, time_to_run);
+            for (const auto load_scale : load_steps) {
+                for (auto &net_runner : net_runners) {
+                    if (net_runner->is_open_loop()) {
+                        net_runner->start_load_step(load_scale, time_to_run);
+                    }
+                }
+                std::this_thread::sleep_for(time_to_run);
+                for (auto &net_runner : net_runners) {
+                    if (!net_runner->is_open_loop()) {
+                        continue;
+                    }
+                    if (!net_runner->wait_for_load_drain(drain_timeout)) {
+                        LOGGER__WARNING("Load step x{} wasn't drained after {} ms, the offered load is above the sustainable throughput",
+                            load_scale, drain_timeout.count());
+                    }
+                    load_results.emplace_back(net_runner->get_load_step_result());
+                }
+            }
+        } else {
+            std::this_thread::sleep_for(time_to_run);
+        }
+        shutdown_event->signal();
+        status = wait_for_threads(threads);
+    }
+
+    if (is_open_loop) {
+        LoadCurveReport::print(load_results);
+        if (!app->get_load_curve_csv_path().empty()) {
+            CHECK_SUCCESS(LoadCurveReport::write_csv(load_results, app->get_load_curve_csv_path()));
+        }
+        if (!app->get_load_curve_json_path().empty()) {
+            CHECK_SUCCESS(LoadCurveReport::write_json(load_results, app->get_load_curve_json_path()));
+        }
     }
-    // TODO: wait for all nets before starting timer. start() should update TimerLiveTrack to start. or maybe append here but first in vector...
-    live_printer.start();
-    std::this_thread::sleep_for(app->get_time_to_run());
-    shutdown_event->signal();
-    return wait_for_threads(threads);
+    return status;
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file threads_utils.cpp
+ * @brief Helpers for the run2 threads
+ **/
+
+#include "threads_utils.hpp"
+#include "common/logger_macros.hpp"
+
+using namespace hailort;
+
+hailo_status wait_for_threads(std::vector<AsyncThreadPtr<hailo_status>> &threads)
+{
+    auto last_error_status = HAILO_SUCCESS;
+    for (auto &thread : threads) {
+        auto thread_status = thread->get();
+        if ((HAILO_SUCCESS != thread_status) && (HAILO_STREAM_ABORTED_BY_USER != thread_status)) {
+            last_error_status = thread_status;
+            LOGGER__ERROR("Thread failed with with status {}", thread_status);
+        }
+    }
+    return last_error_status;
+}
@@ -0,0 +1,21 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file threads_utils.hpp
+ * @brief Helpers for the run2 threads
+ **/
+
+#ifndef _HAILO_HAILORTCLI_RUN2_THREADS_UTILS_HPP_
+#define _HAILO_HAILORTCLI_RUN2_THREADS_UTILS_HPP_
+
+#include "hailo/hailort.h"
+#include "common/async_thread.hpp"
+
+#include <vector>
+
+// Joins all of the threads. Returns the last error (a thread that was aborted by the user isn't an error).
+hailo_status wait_for_threads(std::vector<hailort::AsyncThreadPtr<hailo_status>> &threads);
+
+#endif /* _HAILO_HAILORTCLI_RUN2_THREADS_UTILS_HPP_ */
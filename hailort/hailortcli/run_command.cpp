@@ -29,6 +29,7 @@
 #include "hailo/hef.hpp"
 #include "hailo/vstream.hpp"
 #include "hailo/vdevice.hpp"
+#include "hailo/network_rate_calculator.hpp"
 
 #include "spdlog/fmt/fmt.h"
 
@@ -90,6 +91,27 @@ bool should_measure_pipeline_stats(const inference_runner_params& params)
     return std::any_of(measure_flags.cbegin(), measure_flags.cend(), [](bool x){ return x; });
 }
 
+void add_completion_params_options(CLI::App *app, hailo_vdma_output_stream_completion_params_t &completion_params)
+{
+    auto group = app->add_option_group("Output Stream Completion Options");
+    group->add_option("--completion-mode", completion_params.completion_mode,
+        "How output streams wait for transfer completions (PCIE only; ignored otherwise).\n"
+        "busy_poll lowers latency at the cost of CPU usage")
+        ->transform(HailoCheckedTransformer<hailo_stream_completion_mode_t>({
+            { "interrupt", HAILO_STREAM_COMPLETION_MODE_INTERRUPT },
+            { "busy_poll", HAILO_STREAM_COMPLETION_MODE_BUSY_POLL }
+        }))
+        ->default_val("interrupt");
+    group->add_option("--busy-poll-timeout-us", completion_params.busy_poll_timeout_us,
+        "Max polling time (in microseconds) before waiting for an interrupt, used in busy_poll completion mode")
+        ->check(CLI::PositiveNumber)
+        ->default_val(HAILO_DEFAULT_BUSY_POLL_TIMEOUT_US);
+    group->add_option("--transfers-per-interrupt", completion_params.transfers_per_interrupt,
+        "Interrupt moderation - interrupt the host once every N output transfers (PCIE only; ignored otherwise)")
+        ->check(CLI::PositiveNumber)
+        ->default_val(1);
+}
+
 bool use_batch_to_measure_opt(const inference_runner_params& params)
 {
     return params.runtime_data.collect_runtime_data &&
@@ -119,6 +141,7 @@ static void add_run_command_params(CLI::App *run_subcommand, inference_runner_pa
     params.measure_temp = false;
 
     add_vdevice_options(run_subcommand, params.vdevice_params);
+    add_completion_params_options(run_subcommand, params.completion_params);
 
     auto hef_new = run_subcommand->add_option("hef", params.hef_path, "An existing HEF file/directory path")
         ->check(CLI::ExistingFile | CLI::ExistingDirectory);
@@ -152,6 +175,11 @@ static void add_run_command_params(CLI::App *run_subcommand, inference_runner_pa
             { "ultra_performance", hailo_power_mode_t::HAILO_POWER_MODE_ULTRA_PERFORMANCE }
         }))
         ->default_val("performance");
+    run_subcommand->add_option("--eth-fps", params.eth_fps,
+        "Rate limit the ethernet inputs to this fps (the rates are derived from the network's inputs and outputs).\n"
+        "0 disables the rate limiting (ETH only; ignored otherwise)")
+        ->check(CLI::NonNegativeNumber)
+        ->default_val(0);
     run_subcommand->add_option("-m,--mode", params.mode, "Inference mode")
         ->transform(HailoCheckedTransformer<InferMode>({
             { "streaming", InferMode::STREAMING },
@@ -618,6 +646,32 @@ Expected<std::map<std::string, ConfigureNetworkParams>> get_configure_params(con
     }
     for (size_t network_group_idx = 0; network_group_idx < config_params.network_group_params_count; network_group_idx++) {
         config_params.network_group_params[network_group_idx].power_mode = params.power_mode;
+
+        /* The ethernet input rates are derived from the network, so the outputs don't exceed the bandwidth either */
+        std::map<std::string, uint32_t> eth_input_rates;
+        if ((0 != params.eth_fps) && (HAILO_STREAM_INTERFACE_ETH == interface)) {
+            auto rate_calc = NetworkUdpRateCalculator::create(&hef, config_params.network_group_params[network_group_idx].name);
+            CHECK_EXPECTED(rate_calc);
+            auto rates = rate_calc->calculate_inputs_bandwith(params.eth_fps);
+            CHECK_EXPECTED(rates);
+            eth_input_rates = rates.release();
+        }
+
+        for (size_t stream_idx = 0; stream_idx < config_params.network_group_params[network_group_idx].stream_params_by_name_count; stream_idx++) {
+            auto &stream_params = config_params.network_group_params[network_group_idx].stream_params_by_name[stream_idx].stream_params;
+            if (HAILO_H2D_STREAM == stream_params.direction) {
+                const std::string stream_name = config_params.network_group_params[network_group_idx].stream_params_by_name[stream_idx].name;
+                if ((HAILO_STREAM_INTERFACE_ETH == stream_params.stream_interface) && contains(eth_input_rates, stream_name)) {
+                    stream_params.eth_input_params.rate_limit_bytes_per_sec = eth_input_rates.at(stream_name);
+                }
+                continue;
+            }
+            if (HAILO_STREAM_INTERFACE_PCIE == stream_params.stream_interface) {
+                stream_params.pcie_output_params.completion_params = params.completion_params;
+            } else if (HAILO_STREAM_INTERFACE_CORE == stream_params.stream_interface) {
+                stream_params.core_output_params.completion_params = params.completion_params;
+            }
+        }
         configure_params.emplace(std::string(config_params.network_group_params[network_group_idx].name),
             ConfigureNetworkParams(config_params.network_group_params[network_group_idx]));
 
@@ -748,6 +802,13 @@ static hailo_status run_streaming_impl(std::shared_ptr<ConfiguredNetworkGroup> c
     }
 
     if (params.measure_overall_latency) {
+        // Percentiles are queried first, since get_latency(true) clears the measurements
+        for (const auto percentile : AccumulatorResults::reported_percentiles()) {
+            auto latency = overall_latency_meter.get_latency_percentile(percentile);
+            if (latency) {
+                inference_result.m_overall_latency_percentiles.emplace(percentile, latency.value());
+            }
+        }
         auto overall_latency = overall_latency_meter.get_latency(true);
         CHECK_EXPECTED_AS_STATUS(overall_latency);
         inference_result.m_overall_latency = std::make_unique<std::chrono::nanoseconds>(*overall_latency);
@@ -67,14 +67,17 @@ struct inference_runner_params {
     measure_power_params power_measurement;
     uint16_t batch_size;
     hailo_power_mode_t power_mode;
+    uint32_t eth_fps;
     pipeline_stats_measurement_params pipeline_stats;
     runtime_data_params runtime_data;
     std::string dot_output;
     bool measure_temp;
     std::vector<std::string> batch_per_network;
+    hailo_vdma_output_stream_completion_params_t completion_params;
 };
 
 bool should_measure_pipeline_stats(const inference_runner_params& params);
+void add_completion_params_options(CLI::App *app, hailo_vdma_output_stream_completion_params_t &completion_params);
 CLI::App* create_run_command(CLI::App& parent, inference_runner_params& params);
 hailo_status run_command(const inference_runner_params &params);
 Expected<InferResult> run_command_hef(const inference_runner_params &params);
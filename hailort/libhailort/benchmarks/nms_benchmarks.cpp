@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file nms_benchmarks.cpp
+ * @brief Benchmarks of the NMS host-side paths - defused NMS fuse (fuse_buffers) and the d2h NMS transform
+ **/
+
+#include "hailo/transform.hpp"
+#include "hailo/hailort_common.hpp"
+#include "hailo/buffer.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+using namespace hailort;
+
+namespace {
+
+constexpr uint32_t NMS_CLASSES = 80;
+constexpr uint32_t NMS_MAX_BBOXES_PER_CLASS = 100;
+constexpr uint32_t NMS_BBOX_SIZE = 8;
+
+hailo_nms_info_t make_nms_info(uint32_t number_of_classes, uint32_t chunks_per_frame)
+{
+    hailo_nms_info_t nms_info{};
+    nms_info.number_of_classes = number_of_classes;
+    nms_info.max_bboxes_per_class = NMS_MAX_BBOXES_PER_CLASS;
+    nms_info.bbox_size = NMS_BBOX_SIZE;
+    nms_info.chunks_per_frame = chunks_per_frame;
+    return nms_info;
+}
+
+// Fills an NMS hw frame where every class of every chunk has bboxes_per_class bboxes
+void fill_nms_hw_frame(MemoryView frame, const hailo_nms_info_t &nms_info, uint32_t bboxes_per_class)
+{
+    std::memset(frame.data(), 0, frame.size());
+    size_t offset = 0;
+    for (uint32_t chunk = 0; chunk < nms_info.chunks_per_frame; chunk++) {
+        for (uint32_t class_index = 0; class_index < nms_info.number_of_classes; class_index++) {
+            const auto bbox_count = static_cast<nms_bbox_counter_t>(bboxes_per_class);
+            std::memcpy(frame.data() + offset, &bbox_count, sizeof(bbox_count));
+            offset += sizeof(bbox_count);
+            for (uint32_t bbox = 0; bbox < bboxes_per_class; bbox++) {
+                const uint64_t proposal = (static_cast<uint64_t>(0x7FFF) << 48) | (bbox * 0x10010010ULL);
+                std::memcpy(frame.data() + offset, &proposal, sizeof(proposal));
+                offset += nms_info.bbox_size;
+            }
+        }
+    }
+}
+
+// Args: {bboxes per class (detection density), number of defused buffers}
+void BM_FuseNmsBuffers(benchmark::State &state)
+{
+    const auto bboxes_per_class = static_cast<uint32_t>(state.range(0));
+    const auto buffers_count = static_cast<uint32_t>(state.range(1));
+
+    std::vector<Buffer> buffers;
+    std::vector<MemoryView> views;
+    std::vector<hailo_nms_info_t> nms_infos;
+    size_t fused_size = 0;
+    for (uint32_t i = 0; i < buffers_count; i++) {
+        auto nms_info = make_nms_info(NMS_CLASSES / buffers_count, 1);
+        nms_info.is_defused = true;
+        nms_info.defuse_info.class_group_index = i;
+        auto buffer = Buffer::create(HailoRTCommon::get_nms_hw_frame_size(nms_info));
+        if (!buffer) {
+            state.SkipWithError("Failed to allocate buffers");
+            return;
+        }
+        fill_nms_hw_frame(MemoryView(buffer.value()), nms_info, bboxes_per_class);
+        fused_size += buffer->size();
+        nms_infos.emplace_back(nms_info);
+        buffers.emplace_back(buffer.release());
+    }
+    for (auto &buffer : buffers) {
+        views.emplace_back(buffer);
+    }
+    // Only the last buffer's delimiter is kept in the fused frame
+    fused_size -= (buffers_count - 1) * NMS_BBOX_SIZE;
+    auto fused = Buffer::create(fused_size);
+    if (!fused) {
+        state.SkipWithError("Failed to allocate buffers");
+        return;
+    }
+
+    for (auto _ : state) {
+        const auto status = fuse_buffers(views, nms_infos, MemoryView(fused.value()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("fuse_buffers failed");
+            break;
+        }
+        benchmark::DoNotOptimize(fused->data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fused_size));
+}
+BENCHMARK(BM_FuseNmsBuffers)
+    ->ArgNames({"bboxes_per_class", "buffers"})
+    ->Args({0, 2})->Args({1, 2})->Args({10, 2})->Args({100, 2})
+    ->Args({0, 4})->Args({1, 4})->Args({10, 4})->Args({100, 4});
+
+// Args: {bboxes per class (detection density), chunks per frame, host type}
+void BM_NmsOutputTransform(benchmark::State &state)
+{
+    const auto bboxes_per_class = static_cast<uint32_t>(state.range(0));
+    const auto chunks_per_frame = static_cast<uint32_t>(state.range(1));
+    const auto host_type = static_cast<hailo_format_type_t>(state.range(2));
+    // The bboxes of all chunks of a class are merged, so the density is split between the chunks
+    const auto nms_info = make_nms_info(NMS_CLASSES, chunks_per_frame);
+
+    hailo_format_t hw_format{};
+    hw_format.type = HAILO_FORMAT_TYPE_UINT16;
+    hw_format.order = HAILO_FORMAT_ORDER_HAILO_NMS;
+    hw_format.flags = HAILO_FORMAT_FLAGS_QUANTIZED;
+    hailo_format_t host_format = hw_format;
+    host_format.type = host_type;
+    host_format.flags = (HAILO_FORMAT_TYPE_FLOAT32 == host_type) ? HAILO_FORMAT_FLAGS_NONE : HAILO_FORMAT_FLAGS_QUANTIZED;
+    hailo_quant_info_t quant_info{};
+    quant_info.qp_scale = 1.0f / 255;
+
+    auto context = OutputTransformContext::create(hailo_3d_image_shape_t{}, hw_format, hailo_3d_image_shape_t{}, host_format,
+        quant_info, nms_info);
+    if (!context) {
+        state.SkipWithError("Unsupported transformation");
+        return;
+    }
+
+    auto src = Buffer::create(context.value()->get_src_frame_size());
+    auto dst = Buffer::create(context.value()->get_dst_frame_size());
+    if (!src || !dst) {
+        state.SkipWithError("Failed to allocate buffers");
+        return;
+    }
+    fill_nms_hw_frame(MemoryView(src.value()), nms_info, bboxes_per_class / chunks_per_frame);
+
+    for (auto _ : state) {
+        const auto status = context.value()->transform(MemoryView(src.value()), MemoryView(dst.value()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Transform failed");
+            break;
+        }
+        benchmark::DoNotOptimize(dst->data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * NMS_CLASSES * (bboxes_per_class / chunks_per_frame) *
+        chunks_per_frame));
+}
+
+void add_nms_transform_args(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"bboxes_per_class", "chunks", "host_type"});
+    for (const auto bboxes_per_class : {0, 2, 20, 100}) {
+        for (const auto chunks_per_frame : {1, 2}) {
+            for (const auto host_type : {HAILO_FORMAT_TYPE_UINT16, HAILO_FORMAT_TYPE_FLOAT32}) {
+                benchmark->Args({bboxes_per_class, chunks_per_frame, host_type});
+            }
+        }
+    }
+}
+BENCHMARK(BM_NmsOutputTransform)->Apply(add_nms_transform_args);
+
+} /* namespace */
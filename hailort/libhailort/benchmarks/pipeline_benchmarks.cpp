@@ -0,0 +1,331 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file pipeline_benchmarks.cpp
+ * @brief Benchmarks of a full vstream write -> read round trip over loopback streams, measuring the host pipeline
+ *        (queue elements, pre/post infer transforms and buffer pools) without a device.
+ **/
+
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+#include "stream_internal.hpp"
+#include "vstream_internal.hpp"
+#include "hailort_defaults.hpp"
+
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+using namespace hailort;
+
+namespace {
+
+constexpr uint32_t FRAME_FEATURES = 3;
+constexpr size_t LOOPBACK_MAX_FRAMES = 4;
+const std::string STREAM_NAME = "loopback";
+
+// A bounded frame queue connecting a LoopbackInputStream to a LoopbackOutputStream, standing in for the device
+class LoopbackChannel final
+{
+public:
+    LoopbackChannel(size_t frame_size, size_t max_frames) :
+        m_frame_size(frame_size), m_frames(max_frames, std::vector<uint8_t>(frame_size)), m_head(0), m_count(0),
+        m_is_aborted(false)
+    {}
+
+    hailo_status push(const uint8_t *data, size_t size, std::chrono::milliseconds timeout)
+    {
+        CHECK(m_frame_size == size, HAILO_INVALID_ARGUMENT, "Invalid frame size {} (expected {})", size, m_frame_size);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const bool done = m_cv.wait_for(lock, timeout, [this]() { return m_is_aborted || (m_count < m_frames.size()); });
+        if (m_is_aborted) {
+            return HAILO_STREAM_ABORTED_BY_USER;
+        }
+        CHECK(done, HAILO_TIMEOUT, "Loopback push timed out");
+        std::memcpy(m_frames[(m_head + m_count) % m_frames.size()].data(), data, size);
+        m_count++;
+        lock.unlock();
+        m_cv.notify_all();
+        return HAILO_SUCCESS;
+    }
+
+    hailo_status pop(MemoryView buffer, std::chrono::milliseconds timeout)
+    {
+        CHECK(m_frame_size == buffer.size(), HAILO_INVALID_ARGUMENT, "Invalid frame size {} (expected {})", buffer.size(),
+            m_frame_size);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const bool done = m_cv.wait_for(lock, timeout, [this]() { return m_is_aborted || (0 < m_count); });
+        if (m_is_aborted) {
+            return HAILO_STREAM_ABORTED_BY_USER;
+        }
+        CHECK(done, HAILO_TIMEOUT, "Loopback pop timed out");
+        std::memcpy(buffer.data(), m_frames[m_head].data(), buffer.size());
+        m_head = (m_head + 1) % m_frames.size();
+        m_count--;
+        lock.unlock();
+        m_cv.notify_all();
+        return HAILO_SUCCESS;
+    }
+
+    void abort()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_is_aborted = true;
+        }
+        m_cv.notify_all();
+    }
+
+    void clear_abort()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_aborted = false;
+    }
+
+private:
+    const size_t m_frame_size;
+    std::vector<std::vector<uint8_t>> m_frames;
+    size_t m_head;
+    size_t m_count;
+    bool m_is_aborted;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+class LoopbackInputStream : public InputStreamBase
+{
+public:
+    LoopbackInputStream(const hailo_stream_info_t &stream_info, const EventPtr &network_group_activated_event,
+        std::shared_ptr<LoopbackChannel> channel) :
+        InputStreamBase(stream_info, CONTROL_PROTOCOL__nn_stream_config_t{}, network_group_activated_event),
+        m_channel(channel), m_timeout(HAILO_DEFAULT_VSTREAM_TIMEOUT_MS)
+    {}
+
+    virtual hailo_status set_timeout(std::chrono::milliseconds timeout) override
+    {
+        m_timeout = timeout;
+        return HAILO_SUCCESS;
+    }
+    virtual std::chrono::milliseconds get_timeout() const override { return m_timeout; }
+    virtual hailo_stream_interface_t get_interface() const override { return HAILO_STREAM_INTERFACE_PCIE; }
+    virtual hailo_status abort() override
+    {
+        m_channel->abort();
+        return HAILO_SUCCESS;
+    }
+    virtual hailo_status clear_abort() override
+    {
+        m_channel->clear_abort();
+        return HAILO_SUCCESS;
+    }
+
+protected:
+    virtual hailo_status activate_stream(uint16_t /*dynamic_batch_size*/) override { return HAILO_SUCCESS; }
+    virtual hailo_status deactivate_stream() override { return HAILO_SUCCESS; }
+    virtual Expected<size_t> sync_write_raw_buffer(const MemoryView &buffer) override
+    {
+        auto status = m_channel->push(buffer.data(), buffer.size(), m_timeout);
+        CHECK_SUCCESS_AS_EXPECTED(status);
+        return buffer.size();
+    }
+    virtual hailo_status sync_write_all_raw_buffer_no_transform_impl(void *buffer, size_t offset, size_t size) override
+    {
+        const auto frame_size = get_frame_size();
+        for (size_t written = 0; written < size; written += frame_size) {
+            auto status = m_channel->push(static_cast<uint8_t*>(buffer) + offset + written, frame_size, m_timeout);
+            if (HAILO_STREAM_ABORTED_BY_USER == status) {
+                return status;
+            }
+            CHECK_SUCCESS(status);
+        }
+        return HAILO_SUCCESS;
+    }
+
+private:
+    std::shared_ptr<LoopbackChannel> m_channel;
+    std::chrono::milliseconds m_timeout;
+};
+
+class LoopbackOutputStream : public OutputStreamBase
+{
+public:
+    LoopbackOutputStream(const hailo_stream_info_t &stream_info, const EventPtr &network_group_activated_event,
+        std::shared_ptr<LoopbackChannel> channel) :
+        OutputStreamBase(LayerInfo{}, stream_info, CONTROL_PROTOCOL__nn_stream_config_t{}, network_group_activated_event),
+        m_channel(channel), m_timeout(HAILO_DEFAULT_VSTREAM_TIMEOUT_MS)
+    {}
+
+    virtual hailo_status set_timeout(std::chrono::milliseconds timeout) override
+    {
+        m_timeout = timeout;
+        return HAILO_SUCCESS;
+    }
+    virtual std::chrono::milliseconds get_timeout() const override { return m_timeout; }
+    virtual hailo_stream_interface_t get_interface() const override { return HAILO_STREAM_INTERFACE_PCIE; }
+    virtual hailo_status abort() override
+    {
+        m_channel->abort();
+        return HAILO_SUCCESS;
+    }
+    virtual hailo_status clear_abort() override
+    {
+        m_channel->clear_abort();
+        return HAILO_SUCCESS;
+    }
+
+protected:
+    virtual hailo_status activate_stream(uint16_t /*dynamic_batch_size*/) override { return HAILO_SUCCESS; }
+    virtual hailo_status deactivate_stream() override { return HAILO_SUCCESS; }
+    virtual hailo_status read_all(MemoryView &buffer) override
+    {
+        const auto frame_size = get_frame_size();
+        for (size_t read = 0; read < buffer.size(); read += frame_size) {
+            auto status = m_channel->pop(MemoryView(buffer.data() + read, frame_size), m_timeout);
+            if (HAILO_STREAM_ABORTED_BY_USER == status) {
+                return status;
+            }
+            CHECK_SUCCESS(status);
+        }
+        return HAILO_SUCCESS;
+    }
+    virtual Expected<size_t> sync_read_raw_buffer(MemoryView &buffer) override
+    {
+        auto status = m_channel->pop(buffer, m_timeout);
+        CHECK_SUCCESS_AS_EXPECTED(status);
+        return buffer.size();
+    }
+
+private:
+    std::shared_ptr<LoopbackChannel> m_channel;
+    std::chrono::milliseconds m_timeout;
+};
+
+// The user buffer format of the benchmarked vstreams
+enum class UserFormat {
+    HW_FORMAT = 0,      // Same as the hw format - no pre/post infer elements
+    UINT8_NHWC = 1,     // Reordering only
+    FLOAT32_NHWC = 2    // Reordering and (de)quantization
+};
+
+hailo_format_t get_user_format(UserFormat user_format)
+{
+    hailo_format_t format{};
+    switch (user_format) {
+    case UserFormat::HW_FORMAT:
+        format.type = HAILO_FORMAT_TYPE_UINT8;
+        format.order = HAILO_FORMAT_ORDER_NHCW;
+        format.flags = HAILO_FORMAT_FLAGS_QUANTIZED;
+        break;
+    case UserFormat::UINT8_NHWC:
+        format.type = HAILO_FORMAT_TYPE_UINT8;
+        format.order = HAILO_FORMAT_ORDER_NHWC;
+        format.flags = HAILO_FORMAT_FLAGS_QUANTIZED;
+        break;
+    case UserFormat::FLOAT32_NHWC:
+    default:
+        format.type = HAILO_FORMAT_TYPE_FLOAT32;
+        format.order = HAILO_FORMAT_ORDER_NHWC;
+        format.flags = HAILO_FORMAT_FLAGS_NONE;
+        break;
+    }
+    return format;
+}
+
+hailo_stream_info_t make_stream_info(uint32_t frame_size, hailo_stream_direction_t direction)
+{
+    hailo_stream_info_t stream_info{};
+    stream_info.shape = {frame_size, frame_size, FRAME_FEATURES};
+    stream_info.hw_shape = stream_info.shape;
+    stream_info.hw_data_bytes = 1;
+    stream_info.hw_frame_size = frame_size * frame_size * FRAME_FEATURES;
+    stream_info.format.type = HAILO_FORMAT_TYPE_UINT8;
+    stream_info.format.order = HAILO_FORMAT_ORDER_NHCW;
+    stream_info.format.flags = HAILO_FORMAT_FLAGS_QUANTIZED;
+    stream_info.direction = direction;
+    stream_info.index = (HAILO_H2D_STREAM == direction) ? 0 : 1;
+    strncpy(stream_info.name, STREAM_NAME.c_str(), sizeof(stream_info.name) - 1);
+    stream_info.quant_info.qp_scale = 1.0f / 255;
+    stream_info.quant_info.limvals_max = 1.0f;
+    stream_info.is_mux = false;
+    return stream_info;
+}
+
+hailo_vstream_info_t make_vstream_info(const hailo_stream_info_t &stream_info)
+{
+    hailo_vstream_info_t vstream_info{};
+    strncpy(vstream_info.name, stream_info.name, sizeof(vstream_info.name) - 1);
+    strncpy(vstream_info.network_name, STREAM_NAME.c_str(), sizeof(vstream_info.network_name) - 1);
+    vstream_info.direction = stream_info.direction;
+    vstream_info.format = stream_info.format;
+    vstream_info.shape = stream_info.shape;
+    vstream_info.quant_info = stream_info.quant_info;
+    return vstream_info;
+}
+
+// Args: {frame size (square, 3 features), user format}
+void BM_VStreamLoopback(benchmark::State &state)
+{
+    const auto frame_size = static_cast<uint32_t>(state.range(0));
+    const auto user_format = static_cast<UserFormat>(state.range(1));
+
+    auto activated_event = Event::create_shared(Event::State::signalled);
+    if (nullptr == activated_event) {
+        state.SkipWithError("Failed to create the activated event");
+        return;
+    }
+    const auto input_info = make_stream_info(frame_size, HAILO_H2D_STREAM);
+    const auto output_info = make_stream_info(frame_size, HAILO_D2H_STREAM);
+    auto channel = std::make_shared<LoopbackChannel>(input_info.hw_frame_size, LOOPBACK_MAX_FRAMES);
+    auto input_stream = std::make_shared<LoopbackInputStream>(input_info, activated_event, channel);
+    auto output_stream = std::make_shared<LoopbackOutputStream>(output_info, activated_event, channel);
+
+    auto vstream_params = HailoRTDefaults::get_vstreams_params();
+    vstream_params.user_buffer_format = get_user_format(user_format);
+
+    auto inputs = VStreamsBuilderUtils::create_inputs(input_stream, make_vstream_info(input_info), vstream_params);
+    NameToVStreamParamsMap output_params{{STREAM_NAME, vstream_params}};
+    std::map<std::string, hailo_vstream_info_t> output_vstream_infos{{STREAM_NAME, make_vstream_info(output_info)}};
+    auto outputs = VStreamsBuilderUtils::create_outputs(output_stream, output_params, output_vstream_infos);
+    if (!inputs || !outputs) {
+        state.SkipWithError("Failed to create the vstreams");
+        return;
+    }
+    auto &input = inputs->at(0);
+    auto &output = outputs->at(0);
+
+    std::vector<uint8_t> input_frame(input.get_frame_size(), 1);
+    std::vector<uint8_t> output_frame(output.get_frame_size());
+    for (auto _ : state) {
+        auto status = input.write(MemoryView(input_frame.data(), input_frame.size()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Write failed");
+            break;
+        }
+        status = output.read(MemoryView(output_frame.data(), output_frame.size()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Read failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output_frame.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (input_frame.size() + output_frame.size())));
+
+    // Unblock the pipeline threads before the vstreams are destroyed
+    channel->abort();
+}
+BENCHMARK(BM_VStreamLoopback)
+    ->ArgNames({"frame_size", "user_format"})
+    ->Args({224, static_cast<int64_t>(UserFormat::HW_FORMAT)})
+    ->Args({224, static_cast<int64_t>(UserFormat::UINT8_NHWC)})
+    ->Args({224, static_cast<int64_t>(UserFormat::FLOAT32_NHWC)})
+    ->Args({640, static_cast<int64_t>(UserFormat::HW_FORMAT)})
+    ->Args({640, static_cast<int64_t>(UserFormat::UINT8_NHWC)})
+    ->Args({640, static_cast<int64_t>(UserFormat::FLOAT32_NHWC)})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+} /* namespace */
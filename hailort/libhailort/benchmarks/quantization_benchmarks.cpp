@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file quantization_benchmarks.cpp
+ * @brief Benchmarks of the Quantization helpers used by the transform contexts
+ **/
+
+#include "hailo/quantization.hpp"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace hailort;
+
+namespace {
+
+hailo_quant_info_t make_quant_info(bool identity)
+{
+    hailo_quant_info_t quant_info{};
+    quant_info.qp_zp = identity ? 0.0f : 12.0f;
+    quant_info.qp_scale = identity ? 1.0f : 0.0125f;
+    quant_info.limvals_min = identity ? 0.0f : -0.15f;
+    quant_info.limvals_max = identity ? 255.0f : 3.0f;
+    return quant_info;
+}
+
+// Args: {elements count, identity quantization}
+template<typename T, typename Q>
+void BM_QuantizeInput(benchmark::State &state)
+{
+    const auto elements_count = static_cast<uint32_t>(state.range(0));
+    const auto quant_info = make_quant_info(0 != state.range(1));
+    std::vector<T> src(elements_count, static_cast<T>(1.5));
+    std::vector<Q> dst(elements_count);
+
+    for (auto _ : state) {
+        Quantization::quantize_input_buffer<T, Q>(src.data(), dst.data(), elements_count, quant_info);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements_count));
+}
+
+template<typename T, typename Q>
+void BM_DequantizeOutput(benchmark::State &state)
+{
+    const auto elements_count = static_cast<uint32_t>(state.range(0));
+    const auto quant_info = make_quant_info(0 != state.range(1));
+    std::vector<Q> src(elements_count, static_cast<Q>(100));
+    std::vector<T> dst(elements_count);
+
+    for (auto _ : state) {
+        Quantization::dequantize_output_buffer<T, Q>(src.data(), dst.data(), elements_count, quant_info);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements_count));
+}
+
+template<typename T, typename Q>
+void BM_DequantizeOutputInPlace(benchmark::State &state)
+{
+    const auto elements_count = static_cast<uint32_t>(state.range(0));
+    const auto quant_info = make_quant_info(0 != state.range(1));
+    std::vector<T> buffer(elements_count);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::fill_n(reinterpret_cast<Q*>(buffer.data()), elements_count, static_cast<Q>(100));
+        state.ResumeTiming();
+        Quantization::dequantize_output_buffer_in_place<T, Q>(buffer.data(), elements_count, quant_info);
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements_count));
+}
+
+void add_quantization_args(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"elements", "identity"});
+    // A 224x224x3 input frame and a 80x80x255 output frame
+    for (const auto elements_count : {224 * 224 * 3, 80 * 80 * 255}) {
+        for (const auto identity : {0, 1}) {
+            benchmark->Args({elements_count, identity});
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_QuantizeInput, float32_t, uint8_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_QuantizeInput, float32_t, uint16_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_QuantizeInput, uint16_t, uint8_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_DequantizeOutput, float32_t, uint8_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_DequantizeOutput, float32_t, uint16_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_DequantizeOutput, uint16_t, uint8_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_DequantizeOutputInPlace, float32_t, uint8_t)->Apply(add_quantization_args);
+BENCHMARK_TEMPLATE(BM_DequantizeOutputInPlace, float32_t, uint16_t)->Apply(add_quantization_args);
+
+} /* namespace */
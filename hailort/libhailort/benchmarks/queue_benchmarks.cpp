@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file queue_benchmarks.cpp
+ * @brief Benchmarks of the queues connecting the pipeline elements (SpscQueue and SafeQueue)
+ **/
+
+#include "thread_safe_queue.hpp"
+
+#include <benchmark/benchmark.h>
+#include <thread>
+
+using namespace hailort;
+
+namespace {
+
+constexpr std::chrono::milliseconds QUEUE_TIMEOUT(1000);
+
+// Enqueue and dequeue on the same thread - the cost of the queue itself, without any waiting
+void BM_SpscQueueRoundTrip(benchmark::State &state)
+{
+    auto shutdown_event = Event::create_shared(Event::State::not_signalled);
+    auto queue = SpscQueue<size_t>::create(static_cast<size_t>(state.range(0)), shutdown_event, QUEUE_TIMEOUT);
+    if ((nullptr == shutdown_event) || !queue) {
+        state.SkipWithError("Failed to create the queue");
+        return;
+    }
+
+    size_t value = 0;
+    for (auto _ : state) {
+        if (HAILO_SUCCESS != queue->enqueue(value++)) {
+            state.SkipWithError("Enqueue failed");
+            break;
+        }
+        auto dequeued = queue->dequeue();
+        if (!dequeued) {
+            state.SkipWithError("Dequeue failed");
+            break;
+        }
+        benchmark::DoNotOptimize(dequeued.value());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SpscQueueRoundTrip)->ArgName("max_size")->Arg(1)->Arg(4)->Arg(64);
+
+// A frame passed to another thread and back - the hand-off latency between two pipeline elements
+void BM_SpscQueuePingPong(benchmark::State &state)
+{
+    auto shutdown_event = Event::create_shared(Event::State::not_signalled);
+    if (nullptr == shutdown_event) {
+        state.SkipWithError("Failed to create the shutdown event");
+        return;
+    }
+    auto ping_queue = SpscQueue<size_t>::create_shared(1, shutdown_event, QUEUE_TIMEOUT);
+    auto pong_queue = SpscQueue<size_t>::create_shared(1, shutdown_event, QUEUE_TIMEOUT);
+    if ((nullptr == ping_queue) || (nullptr == pong_queue)) {
+        state.SkipWithError("Failed to create the queues");
+        return;
+    }
+
+    std::thread echo_thread([ping_queue, pong_queue]() {
+        while (true) {
+            auto value = ping_queue->dequeue(std::chrono::milliseconds(HAILO_INFINITE));
+            if (!value) {
+                // Shutdown
+                return;
+            }
+            if (HAILO_SUCCESS != pong_queue->enqueue(value.release(), std::chrono::milliseconds(HAILO_INFINITE))) {
+                return;
+            }
+        }
+    });
+
+    size_t value = 0;
+    for (auto _ : state) {
+        if (HAILO_SUCCESS != ping_queue->enqueue(value++)) {
+            state.SkipWithError("Enqueue failed");
+            break;
+        }
+        auto echoed = pong_queue->dequeue();
+        if (!echoed) {
+            state.SkipWithError("Dequeue failed");
+            break;
+        }
+        benchmark::DoNotOptimize(echoed.value());
+    }
+
+    shutdown_event->signal();
+    echo_thread.join();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SpscQueuePingPong)->UseRealTime();
+
+// A producer streaming frames to a consumer thread - the queue throughput when the pipeline is full
+void BM_SpscQueueStreaming(benchmark::State &state)
+{
+    const auto max_size = static_cast<size_t>(state.range(0));
+    auto shutdown_event = Event::create_shared(Event::State::not_signalled);
+    if (nullptr == shutdown_event) {
+        state.SkipWithError("Failed to create the shutdown event");
+        return;
+    }
+    auto queue = SpscQueue<size_t>::create_shared(max_size, shutdown_event, QUEUE_TIMEOUT);
+    if (nullptr == queue) {
+        state.SkipWithError("Failed to create the queue");
+        return;
+    }
+
+    std::atomic_size_t consumed_count(0);
+    std::thread consumer_thread([queue, &consumed_count]() {
+        while (true) {
+            auto value = queue->dequeue(std::chrono::milliseconds(HAILO_INFINITE));
+            if (!value) {
+                return;
+            }
+            consumed_count++;
+        }
+    });
+
+    size_t value = 0;
+    for (auto _ : state) {
+        if (HAILO_SUCCESS != queue->enqueue(value++)) {
+            state.SkipWithError("Enqueue failed");
+            break;
+        }
+    }
+    // Wait for the consumer, so the measured time covers all of the frames
+    while (consumed_count < value) {
+        std::this_thread::yield();
+    }
+
+    shutdown_event->signal();
+    consumer_thread.join();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SpscQueueStreaming)->ArgName("max_size")->Arg(1)->Arg(4)->Arg(64)->UseRealTime();
+
+void BM_SafeQueueRoundTrip(benchmark::State &state)
+{
+    SafeQueue<size_t> queue;
+    size_t value = 0;
+    for (auto _ : state) {
+        queue.push(value++);
+        benchmark::DoNotOptimize(queue.pop());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SafeQueueRoundTrip);
+
+} /* namespace */
@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file transform_benchmarks.cpp
+ * @brief Benchmarks of the input/output transform contexts, for every supported (order, type) pair
+ **/
+
+#include "hailo/transform.hpp"
+#include "hailo/hailort_common.hpp"
+#include "hailo/buffer.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace hailort;
+
+namespace {
+
+struct OrderPair
+{
+    hailo_format_order_t host_order;
+    hailo_format_order_t hw_order;
+    // Features of the host / hw shapes (the hw features are aligned as the device expects)
+    uint32_t host_features;
+    uint32_t hw_features;
+    hailo_format_flags_t extra_host_flags;
+};
+
+const std::vector<OrderPair> INPUT_ORDER_PAIRS = {
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_NHCW, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_NHWC, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NC, HAILO_FORMAT_ORDER_NC, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_FCR, 3, 8, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_FCR, HAILO_FORMAT_ORDER_FCR, 8, 8, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_F8CR, 3, 8, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_F8CR, HAILO_FORMAT_ORDER_F8CR, 8, 8, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_BAYER_RGB, HAILO_FORMAT_ORDER_BAYER_RGB, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_12_BIT_BAYER_RGB, HAILO_FORMAT_ORDER_12_BIT_BAYER_RGB, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_RGB888, 3, 4, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NCHW, HAILO_FORMAT_ORDER_NHCW, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_YUY2, HAILO_FORMAT_ORDER_YUY2, 2, 2, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NV12, HAILO_FORMAT_ORDER_HAILO_YYUV, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NV21, HAILO_FORMAT_ORDER_HAILO_YYVU, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_RGB4, HAILO_FORMAT_ORDER_NHWC, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_RGB4, HAILO_FORMAT_ORDER_NHCW, 3, 3, HAILO_FORMAT_FLAGS_NONE},
+};
+
+// For output pairs, host_* describes the user buffer and hw_* the buffer read from the device
+const std::vector<OrderPair> OUTPUT_ORDER_PAIRS = {
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_NHCW, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NC, HAILO_FORMAT_ORDER_NC, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHW, HAILO_FORMAT_ORDER_NHW, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_FCR, HAILO_FORMAT_ORDER_FCR, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_FCR, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_F8CR, HAILO_FORMAT_ORDER_F8CR, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_F8CR, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_BAYER_RGB, HAILO_FORMAT_ORDER_BAYER_RGB, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NCHW, HAILO_FORMAT_ORDER_NHCW, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NCHW, HAILO_FORMAT_ORDER_NHW, 1, 1, HAILO_FORMAT_FLAGS_NONE},
+    {HAILO_FORMAT_ORDER_NHW, HAILO_FORMAT_ORDER_NHCW, 1, 64, HAILO_FORMAT_FLAGS_HOST_ARGMAX},
+    // Top 3 (the 3 indices followed by the 3 values)
+    {HAILO_FORMAT_ORDER_HAILO_TOP_K, HAILO_FORMAT_ORDER_NHCW, 6, 64, HAILO_FORMAT_FLAGS_HOST_ARGMAX},
+    {HAILO_FORMAT_ORDER_NHWC, HAILO_FORMAT_ORDER_NHWC, 64, 64, HAILO_FORMAT_FLAGS_NONE},
+};
+
+const std::vector<std::pair<hailo_format_type_t, hailo_format_type_t>> INPUT_TYPE_PAIRS = {
+    // {host type, hw type}
+    {HAILO_FORMAT_TYPE_UINT8, HAILO_FORMAT_TYPE_UINT8},
+    {HAILO_FORMAT_TYPE_UINT16, HAILO_FORMAT_TYPE_UINT8},
+    {HAILO_FORMAT_TYPE_UINT16, HAILO_FORMAT_TYPE_UINT16},
+    {HAILO_FORMAT_TYPE_FLOAT32, HAILO_FORMAT_TYPE_UINT8},
+    {HAILO_FORMAT_TYPE_FLOAT32, HAILO_FORMAT_TYPE_UINT16},
+};
+
+const std::vector<std::pair<hailo_format_type_t, hailo_format_type_t>> OUTPUT_TYPE_PAIRS = {
+    // {host type, hw type}
+    {HAILO_FORMAT_TYPE_UINT8, HAILO_FORMAT_TYPE_UINT8},
+    {HAILO_FORMAT_TYPE_UINT16, HAILO_FORMAT_TYPE_UINT8},
+    {HAILO_FORMAT_TYPE_UINT16, HAILO_FORMAT_TYPE_UINT16},
+    {HAILO_FORMAT_TYPE_FLOAT32, HAILO_FORMAT_TYPE_UINT8},
+    {HAILO_FORMAT_TYPE_FLOAT32, HAILO_FORMAT_TYPE_UINT16},
+};
+
+// Frame sizes (height == width) used by every transform benchmark
+void add_frame_sizes(benchmark::internal::Benchmark *benchmark)
+{
+    for (const auto size : {64, 224, 640}) {
+        benchmark->Arg(size);
+    }
+}
+
+hailo_format_t make_format(hailo_format_type_t type, hailo_format_order_t order, hailo_format_flags_t flags)
+{
+    hailo_format_t format{};
+    format.type = type;
+    format.order = order;
+    format.flags = flags;
+    return format;
+}
+
+hailo_quant_info_t make_quant_info()
+{
+    hailo_quant_info_t quant_info{};
+    quant_info.qp_zp = 0;
+    quant_info.qp_scale = 1.0f / 255;
+    quant_info.limvals_min = 0;
+    quant_info.limvals_max = 1;
+    return quant_info;
+}
+
+hailo_3d_image_shape_t make_shape(uint32_t size, uint32_t features, hailo_format_order_t order)
+{
+    switch (order) {
+    case HAILO_FORMAT_ORDER_NC:
+        return {1, 1, size * size};
+    case HAILO_FORMAT_ORDER_NV12:
+    case HAILO_FORMAT_ORDER_NV21:
+    case HAILO_FORMAT_ORDER_HAILO_YYUV:
+    case HAILO_FORMAT_ORDER_HAILO_YYVU:
+        // Y plane rows followed by half as many UV rows (height * features = 1.5 * size)
+        return {size / 2, size, features};
+    default:
+        return {size, size, features};
+    }
+}
+
+// Host buffers are quantized unless they are float32 (which are quantized by the transform)
+hailo_format_flags_t host_quantized_flag(hailo_format_type_t host_type)
+{
+    return (HAILO_FORMAT_TYPE_FLOAT32 == host_type) ? HAILO_FORMAT_FLAGS_NONE : HAILO_FORMAT_FLAGS_QUANTIZED;
+}
+
+void BM_InputTransform(benchmark::State &state, OrderPair orders, hailo_format_type_t host_type, hailo_format_type_t hw_type)
+{
+    const auto size = static_cast<uint32_t>(state.range(0));
+    const auto host_shape = make_shape(size, orders.host_features, orders.host_order);
+    const auto hw_shape = make_shape(size, orders.hw_features, orders.hw_order);
+    const auto host_format = make_format(host_type, orders.host_order,
+        static_cast<hailo_format_flags_t>(host_quantized_flag(host_type) | orders.extra_host_flags));
+    const auto hw_format = make_format(hw_type, orders.hw_order, HAILO_FORMAT_FLAGS_QUANTIZED);
+
+    auto context = InputTransformContext::create(host_shape, host_format, hw_shape, hw_format, make_quant_info());
+    if (!context) {
+        state.SkipWithError("Unsupported transformation");
+        return;
+    }
+
+    auto src = Buffer::create(context.value()->get_src_frame_size(), 0x1);
+    auto dst = Buffer::create(context.value()->get_dst_frame_size(), 0);
+    if (!src || !dst) {
+        state.SkipWithError("Failed to allocate buffers");
+        return;
+    }
+
+    for (auto _ : state) {
+        const auto status = context.value()->transform(MemoryView(src.value()), MemoryView(dst.value()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Transform failed");
+            break;
+        }
+        benchmark::DoNotOptimize(dst->data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src->size()));
+    state.SetLabel(context.value()->description());
+}
+
+void BM_OutputTransform(benchmark::State &state, OrderPair orders, hailo_format_type_t host_type, hailo_format_type_t hw_type)
+{
+    const auto size = static_cast<uint32_t>(state.range(0));
+    const auto hw_shape = make_shape(size, orders.hw_features, orders.hw_order);
+    const auto host_shape = make_shape(size, orders.host_features, orders.host_order);
+    const auto hw_format = make_format(hw_type, orders.hw_order,
+        static_cast<hailo_format_flags_t>(HAILO_FORMAT_FLAGS_QUANTIZED | orders.extra_host_flags));
+    const auto host_format = make_format(host_type, orders.host_order, host_quantized_flag(host_type));
+
+    auto context = OutputTransformContext::create(hw_shape, hw_format, host_shape, host_format, make_quant_info(),
+        hailo_nms_info_t{});
+    if (!context) {
+        state.SkipWithError("Unsupported transformation");
+        return;
+    }
+
+    auto src = Buffer::create(context.value()->get_src_frame_size(), 0x1);
+    auto dst = Buffer::create(context.value()->get_dst_frame_size(), 0);
+    if (!src || !dst) {
+        state.SkipWithError("Failed to allocate buffers");
+        return;
+    }
+
+    for (auto _ : state) {
+        const auto status = context.value()->transform(MemoryView(src.value()), MemoryView(dst.value()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Transform failed");
+            break;
+        }
+        benchmark::DoNotOptimize(dst->data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src->size()));
+    state.SetLabel(context.value()->description());
+}
+
+std::string benchmark_name(const std::string &prefix, const OrderPair &orders, hailo_format_type_t src_type,
+    hailo_format_type_t dst_type, bool is_input)
+{
+    const auto src_order = is_input ? orders.host_order : orders.hw_order;
+    const auto dst_order = is_input ? orders.hw_order : orders.host_order;
+    return prefix + "/" + HailoRTCommon::get_format_order_str(src_order) + "_to_" +
+        HailoRTCommon::get_format_order_str(dst_order) + "/" + HailoRTCommon::get_format_type_str(src_type) + "_to_" +
+        HailoRTCommon::get_format_type_str(dst_type);
+}
+
+// Registration is done at runtime so every (order, type) combination gets its own named benchmark
+int register_transform_benchmarks()
+{
+    for (const auto &orders : INPUT_ORDER_PAIRS) {
+        for (const auto &types : INPUT_TYPE_PAIRS) {
+            benchmark::RegisterBenchmark(benchmark_name("BM_InputTransform", orders, types.first, types.second, true).c_str(),
+                BM_InputTransform, orders, types.first, types.second)->Apply(add_frame_sizes);
+        }
+    }
+    for (const auto &orders : OUTPUT_ORDER_PAIRS) {
+        for (const auto &types : OUTPUT_TYPE_PAIRS) {
+            benchmark::RegisterBenchmark(benchmark_name("BM_OutputTransform", orders, types.second, types.first, false).c_str(),
+                BM_OutputTransform, orders, types.first, types.second)->Apply(add_frame_sizes);
+        }
+    }
+    return 0;
+}
+
+const int TRANSFORM_BENCHMARKS_REGISTERED = register_transform_benchmarks();
+
+} /* namespace */
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file udp_benchmarks.cpp
+ * @brief Benchmarks of sending a frame over UDP (as the ethernet input streams do) - batched by Udp::send_multiple,
+ *        or a packet per Udp::send - to a recvmmsg receiver on the loopback.
+ **/
+
+#include "udp.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace hailort;
+
+namespace {
+
+constexpr size_t RECEIVER_PACKETS_PER_CALL = 64;
+constexpr size_t RECEIVER_MAX_PACKET_SIZE = 2048;
+constexpr int RECEIVER_BUFFER_SIZE = 16 * 1024 * 1024;
+constexpr std::chrono::milliseconds RECEIVER_POLL_INTERVAL(20);
+
+// Receives (and counts) the packets sent to it on the loopback, a batch per recvmmsg call
+class LoopbackReceiver final {
+public:
+    LoopbackReceiver() :
+        m_fd(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)),
+        m_port(0),
+        m_is_running(false),
+        m_received_bytes(0)
+    {}
+
+    ~LoopbackReceiver()
+    {
+        stop();
+        if (0 <= m_fd) {
+            close(m_fd);
+        }
+    }
+
+    bool start()
+    {
+        if (0 > m_fd) {
+            return false;
+        }
+        // Best effort, the size is capped by net.core.rmem_max
+        (void)setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &RECEIVER_BUFFER_SIZE, sizeof(RECEIVER_BUFFER_SIZE));
+        struct timeval timeout = {0, static_cast<suseconds_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(RECEIVER_POLL_INTERVAL).count())};
+        if (0 != setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout))) {
+            return false;
+        }
+
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t address_length = sizeof(address);
+        if ((0 != bind(m_fd, reinterpret_cast<struct sockaddr*>(&address), address_length)) ||
+            (0 != getsockname(m_fd, reinterpret_cast<struct sockaddr*>(&address), &address_length))) {
+            return false;
+        }
+        m_port = ntohs(address.sin_port);
+
+        m_is_running = true;
+        m_thread = std::thread([this]() { receive_loop(); });
+        return true;
+    }
+
+    void stop()
+    {
+        m_is_running = false;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    uint16_t port() const
+    {
+        return m_port;
+    }
+
+    uint64_t received_bytes() const
+    {
+        return m_received_bytes.load();
+    }
+
+private:
+    void receive_loop()
+    {
+        std::vector<uint8_t> buffers(RECEIVER_PACKETS_PER_CALL * RECEIVER_MAX_PACKET_SIZE);
+        std::vector<struct iovec> iovecs(RECEIVER_PACKETS_PER_CALL);
+        std::vector<struct mmsghdr> messages(RECEIVER_PACKETS_PER_CALL);
+        for (size_t i = 0; i < RECEIVER_PACKETS_PER_CALL; i++) {
+            iovecs[i].iov_base = buffers.data() + (i * RECEIVER_MAX_PACKET_SIZE);
+            iovecs[i].iov_len = RECEIVER_MAX_PACKET_SIZE;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Keeps draining the socket until it's stopped (a receive timeout is just a chance to check for it)
+        while (m_is_running) {
+            const auto received_count = recvmmsg(m_fd, messages.data(), static_cast<unsigned int>(messages.size()),
+                MSG_WAITFORONE, nullptr);
+            if (0 >= received_count) {
+                continue;
+            }
+            uint64_t received_bytes = 0;
+            for (int i = 0; i < received_count; i++) {
+                received_bytes += messages[i].msg_len;
+            }
+            m_received_bytes += received_bytes;
+        }
+    }
+
+    int m_fd;
+    uint16_t m_port;
+    std::atomic_bool m_is_running;
+    std::atomic<uint64_t> m_received_bytes;
+    std::thread m_thread;
+};
+
+Expected<Udp> create_loopback_sender(uint16_t receiver_port)
+{
+    struct in_addr loopback_ip = {};
+    loopback_ip.s_addr = htonl(INADDR_LOOPBACK);
+    return Udp::create(loopback_ip, receiver_port, loopback_ip, 0);
+}
+
+hailo_status send_per_packet(Udp &udp, uint8_t *buffer, size_t size, size_t packet_size)
+{
+    size_t offset = 0;
+    while (offset < size) {
+        size_t sent_size = std::min(packet_size, size - offset);
+        auto status = udp.send(buffer + offset, &sent_size, false, packet_size);
+        if (HAILO_SUCCESS != status) {
+            return status;
+        }
+        offset += sent_size;
+    }
+    return HAILO_SUCCESS;
+}
+
+enum class SendMethod {
+    PER_PACKET = 0,
+    MULTIPLE,
+};
+
+// Args: {frame size, packet size, send method}
+void BM_UdpSendFrame(benchmark::State &state)
+{
+    const auto frame_size = static_cast<size_t>(state.range(0));
+    const auto packet_size = static_cast<size_t>(state.range(1));
+    const auto send_method = static_cast<SendMethod>(state.range(2));
+
+    LoopbackReceiver receiver;
+    if (!receiver.start()) {
+        state.SkipWithError("Failed to start the loopback receiver");
+        return;
+    }
+    auto udp = create_loopback_sender(receiver.port());
+    if (!udp) {
+        state.SkipWithError("Failed to create the udp sender");
+        return;
+    }
+
+    std::vector<uint8_t> frame(frame_size, 0xAB);
+    for (auto _ : state) {
+        const auto status = (SendMethod::MULTIPLE == send_method) ?
+            udp->send_multiple(frame.data(), frame.size(), packet_size, false) :
+            send_per_packet(udp.value(), frame.data(), frame.size(), packet_size);
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Send failed");
+            break;
+        }
+    }
+
+    // Let the receiver drain the packets that are still queued on its socket
+    std::this_thread::sleep_for(RECEIVER_POLL_INTERVAL);
+    receiver.stop();
+
+    const auto sent_bytes = static_cast<double>(state.iterations()) * static_cast<double>(frame_size);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(sent_bytes));
+    // Loopback UDP drops packets when the receiver falls behind, so the send rate alone may overstate the throughput
+    state.counters["received_ratio"] = (0 < sent_bytes) ?
+        (static_cast<double>(receiver.received_bytes()) / sent_bytes) : 0;
+}
+BENCHMARK(BM_UdpSendFrame)
+    ->ArgNames({"frame_size", "packet_size", "send_multiple"})
+    ->Args({64 * 1024, HAILO_DEFAULT_ETH_MAX_PAYLOAD_SIZE, static_cast<int64_t>(SendMethod::PER_PACKET)})
+    ->Args({64 * 1024, HAILO_DEFAULT_ETH_MAX_PAYLOAD_SIZE, static_cast<int64_t>(SendMethod::MULTIPLE)})
+    ->Args({640 * 640 * 3, HAILO_DEFAULT_ETH_MAX_PAYLOAD_SIZE, static_cast<int64_t>(SendMethod::PER_PACKET)})
+    ->Args({640 * 640 * 3, HAILO_DEFAULT_ETH_MAX_PAYLOAD_SIZE, static_cast<int64_t>(SendMethod::MULTIPLE)})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+} /* namespace */
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file yolo_post_processing_benchmarks.cpp
+ * @brief Benchmarks of the YOLOv5 host post-processing at various detection densities
+ **/
+
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+#include "net_flow/ops/yolo_post_processing.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace hailort;
+using namespace hailort::net_flow;
+
+namespace {
+
+constexpr uint32_t YOLO_CLASSES = 80;
+constexpr uint32_t YOLO_MAX_BBOXES_PER_CLASS = 100;
+constexpr uint32_t YOLO_IMAGE_SIZE = 640;
+constexpr uint32_t YOLO_ENTRY_SIZE = 5 + YOLO_CLASSES;
+constexpr uint32_t OBJECTNESS_INDEX = 4;
+constexpr float32_t CONFIDENCE_THRESHOLD = 0.3f;
+constexpr float32_t IOU_THRESHOLD = 0.6f;
+
+const std::vector<std::vector<int>> YOLOV5_ANCHORS = {
+    {10, 13, 16, 30, 33, 23},
+    {30, 61, 62, 45, 59, 119},
+    {116, 90, 156, 198, 373, 326}
+};
+const std::vector<uint32_t> YOLOV5_STRIDES = {8, 16, 32};
+
+// Fills a layer where detections_per_mille of the entries pass the confidence threshold. The detections are spread over
+// the classes, so the NMS has both overlapping and non-overlapping boxes to handle.
+Buffer create_layer(const hailo_3d_image_shape_t &shape, size_t anchors_count, uint32_t detections_per_mille)
+{
+    const size_t entries_count = shape.height * shape.width * anchors_count;
+    auto buffer = Buffer::create(entries_count * YOLO_ENTRY_SIZE, 0);
+    assert(buffer);
+    size_t detections_count = 0;
+    for (size_t entry = 0; entry < entries_count; entry++) {
+        // Selects every (1000 / detections_per_mille)-th entry, so the detections are spread uniformly over the grid
+        if (((entry * detections_per_mille) / 1000) == (((entry + 1) * detections_per_mille) / 1000)) {
+            continue;
+        }
+        auto *data = buffer->data() + (entry * YOLO_ENTRY_SIZE);
+        data[0] = 128; // tx
+        data[1] = 128; // ty
+        data[2] = 64;  // tw
+        data[3] = 64;  // th
+        data[OBJECTNESS_INDEX] = 250;
+        data[OBJECTNESS_INDEX + 1 + (detections_count % YOLO_CLASSES)] = 240;
+        detections_count++;
+    }
+    return buffer.release();
+}
+
+// Args: {detections per mille of the entries}
+void BM_YoloV5PostProcess(benchmark::State &state)
+{
+    const auto detections_per_mille = static_cast<uint32_t>(state.range(0));
+
+    std::vector<hailo_3d_image_shape_t> shapes;
+    std::vector<hailo_format_t> formats;
+    std::vector<hailo_quant_info_t> quant_infos;
+    std::vector<Buffer> layers;
+    std::vector<MemoryView> views;
+    for (size_t i = 0; i < YOLOV5_STRIDES.size(); i++) {
+        const auto grid_size = YOLO_IMAGE_SIZE / YOLOV5_STRIDES[i];
+        // The post-process expects the features of all anchors in a single layer
+        const auto anchors_count = YOLOV5_ANCHORS[i].size() / 2;
+        shapes.push_back({grid_size, grid_size, static_cast<uint32_t>(anchors_count * YOLO_ENTRY_SIZE)});
+
+        hailo_format_t format{};
+        format.type = HAILO_FORMAT_TYPE_UINT8;
+        format.order = HAILO_FORMAT_ORDER_NHWC;
+        format.flags = HAILO_FORMAT_FLAGS_QUANTIZED;
+        formats.push_back(format);
+
+        hailo_quant_info_t quant_info{};
+        quant_info.qp_zp = 0;
+        quant_info.qp_scale = 1.0f / 255;
+        quant_infos.push_back(quant_info);
+
+        layers.emplace_back(create_layer(shapes.back(), anchors_count, detections_per_mille));
+    }
+    for (auto &layer : layers) {
+        views.emplace_back(layer);
+    }
+
+    auto op = YOLOv5PostProcessingOp::create(YOLOV5_ANCHORS, shapes, formats, quant_infos, YOLO_IMAGE_SIZE, YOLO_IMAGE_SIZE,
+        CONFIDENCE_THRESHOLD, IOU_THRESHOLD, YOLO_CLASSES, true, YOLO_MAX_BBOXES_PER_CLASS, false);
+    if (!op) {
+        state.SkipWithError("Failed to create the post-process op");
+        return;
+    }
+
+    hailo_format_t dst_format{};
+    dst_format.type = HAILO_FORMAT_TYPE_FLOAT32;
+    dst_format.order = HAILO_FORMAT_ORDER_HAILO_NMS;
+    auto dst = Buffer::create(HailoRTCommon::get_nms_host_frame_size(
+        hailo_nms_shape_t{YOLO_CLASSES, YOLO_MAX_BBOXES_PER_CLASS}, dst_format), 0);
+    if (!dst) {
+        state.SkipWithError("Failed to allocate buffers");
+        return;
+    }
+
+    for (auto _ : state) {
+        const auto status = op->execute<float32_t>(views, MemoryView(dst.value()));
+        if (HAILO_SUCCESS != status) {
+            state.SkipWithError("Post-process failed");
+            break;
+        }
+        benchmark::DoNotOptimize(dst->data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_YoloV5PostProcess)
+    ->ArgName("detections_per_mille")
+    ->Arg(0)->Arg(1)->Arg(10)->Arg(50)->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+
+} /* namespace */
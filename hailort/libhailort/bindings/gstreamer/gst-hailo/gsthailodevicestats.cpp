@@ -235,6 +235,16 @@ hailo_status HailoDeviceStatsImpl::run_measure_loop()
     GST_CHECK_EXPECTED_AS_STATUS(device_string, m_element, RESOURCE, "Getting PCIe device ID string has failed, status = %d", device_string.status());
     const char *device_raw_string = device_string->c_str();
 
+    // Published to the metrics registry for as long as the measurement loop runs (best effort)
+    const MetricLabels labels = {{"device_id", device_string.value()}};
+    auto temperature_gauge = MetricsRegistry::get_instance().get_gauge("hailort_device_temperature_celsius",
+        "Average chip temperature of the device", labels);
+    auto power_gauge = MetricsRegistry::get_instance().get_gauge("hailort_device_power_watts",
+        "Average power measurement of the device", labels);
+    if (!temperature_gauge || !power_gauge) {
+        GST_WARNING("[%s] Creating device metrics failed", device_raw_string);
+    }
+
     while (m_is_thread_running.load()) {
         auto measurement = m_device->get_power_measurement(HAILO_MEASUREMENT_BUFFER_INDEX_0, true);
         GST_CHECK_EXPECTED_AS_STATUS(measurement, m_element, RESOURCE, "Getting power measurement failed, status = %d", measurement.status());
@@ -256,6 +266,10 @@ hailo_status HailoDeviceStatsImpl::run_measure_loop()
             m_power_measure = measurement->average_value;
             m_avg_temp = ts_avg;
         }
+        if (temperature_gauge && power_gauge) {
+            temperature_gauge.value()->set(ts_avg);
+            power_gauge.value()->set(measurement->average_value);
+        }
 
         GstStructure *str = gst_structure_new(HailoDeviceStatsMessage::name,
                                               "device_id", G_TYPE_STRING, device_raw_string,
@@ -22,6 +22,7 @@
 
 #include "common.hpp"
 #include "hailo/expected.hpp"
+#include "hailo/metrics.hpp"
 
 #include <memory>
 #include <mutex>
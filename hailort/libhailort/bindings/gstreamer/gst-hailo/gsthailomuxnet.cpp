@@ -0,0 +1,1016 @@
+/*
+ * Copyright (c) 2021-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the LGPL 2.1 license (https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+#include "gsthailomuxnet.hpp"
+#include "gsthailonet.hpp"
+#include "gsthailosend.hpp"
+#include "gsthailorecv.hpp"
+#include "metadata/tensor_meta.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+GST_DEBUG_CATEGORY_STATIC(gst_hailomuxnet_debug_category);
+#define GST_CAT_DEFAULT gst_hailomuxnet_debug_category
+
+static void gst_hailomuxnet_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void gst_hailomuxnet_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static GstStateChangeReturn gst_hailomuxnet_change_state(GstElement *element, GstStateChange transition);
+static GstPad *gst_hailomuxnet_request_new_pad(GstElement *element, GstPadTemplate *templ, const gchar *name, const GstCaps *caps);
+static void gst_hailomuxnet_release_pad(GstElement *element, GstPad *pad);
+static GstFlowReturn gst_hailomuxnet_sink_chain(GstPad *pad, GstObject *parent, GstBuffer *buffer);
+static gboolean gst_hailomuxnet_sink_event(GstPad *pad, GstObject *parent, GstEvent *event);
+static gboolean gst_hailomuxnet_sink_query(GstPad *pad, GstObject *parent, GstQuery *query);
+static GstIterator *gst_hailomuxnet_iterate_internal_links(GstPad *pad, GstObject *parent);
+
+enum
+{
+    PROP_0,
+    PROP_DEVICE_ID,
+    PROP_HEF_PATH,
+    PROP_NETWORK_NAME,
+    PROP_BATCH_SIZE,
+    PROP_BATCH_TIMEOUT_MS,
+    PROP_OUTPUTS_MIN_POOL_SIZE,
+    PROP_OUTPUTS_MAX_POOL_SIZE,
+    PROP_DEVICE_COUNT,
+    PROP_VDEVICE_KEY,
+    PROP_SCHEDULING_ALGORITHM,
+    PROP_SCHEDULER_TIMEOUT_MS,
+    PROP_SCHEDULER_THRESHOLD,
+    PROP_MULTI_PROCESS_SERVICE,
+};
+
+G_DEFINE_TYPE(GstHailoMuxNet, gst_hailomuxnet, GST_TYPE_ELEMENT);
+
+static void gst_hailomuxnet_class_init(GstHailoMuxNetClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
+
+    gst_element_class_add_pad_template(element_class,
+        gst_pad_template_new("sink_%u", GST_PAD_SINK, GST_PAD_REQUEST, gst_caps_from_string(HAILO_VIDEO_CAPS)));
+    gst_element_class_add_pad_template(element_class,
+        gst_pad_template_new("src_%u", GST_PAD_SRC, GST_PAD_SOMETIMES, gst_caps_from_string(HAILO_VIDEO_CAPS)));
+
+    gst_element_class_set_static_metadata(element_class,
+        "hailomuxnet element", "Hailo/Network",
+        "Configure and Activate Hailo Network, and run it on frames from multiple sources. "
+            "Each requested sink pad (sink_%u) gets a matching src pad (src_%u). Frames from all sink pads are aggregated into "
+            "batches of 'batch-size' frames, and each frame leaves on the src pad matching the sink pad it came from, with the "
+            "network's output tensors attached as metadata.",
+        PLUGIN_AUTHOR);
+
+    element_class->change_state = GST_DEBUG_FUNCPTR(gst_hailomuxnet_change_state);
+    element_class->request_new_pad = GST_DEBUG_FUNCPTR(gst_hailomuxnet_request_new_pad);
+    element_class->release_pad = GST_DEBUG_FUNCPTR(gst_hailomuxnet_release_pad);
+
+    gobject_class->set_property = gst_hailomuxnet_set_property;
+    gobject_class->get_property = gst_hailomuxnet_get_property;
+    g_object_class_install_property(gobject_class, PROP_DEVICE_ID,
+        g_param_spec_string("device-id", "Device ID", "Device ID ([<domain>]:<bus>:<device>.<func>, same as in lspci command). Excludes device-count.", NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_DEVICE_COUNT,
+        g_param_spec_uint("device-count", "Number of devices to use", "Number of physical devices to use. Excludes device-id.", HAILO_DEFAULT_DEVICE_COUNT,
+            std::numeric_limits<uint16_t>::max(), HAILO_DEFAULT_DEVICE_COUNT, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_VDEVICE_KEY,
+        g_param_spec_uint("vdevice-key",
+            "Indicate whether to re-use or re-create vdevice",
+            "Relevant only when 'device-count' is passed. If not passed, the created vdevice will be unique to this element." \
+            "if multiple elements share 'vdevice-key' and 'device-count', the created vdevice will be shared between those elements",
+            MIN_VALID_VDEVICE_KEY, std::numeric_limits<uint32_t>::max(), MIN_VALID_VDEVICE_KEY, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_HEF_PATH,
+        g_param_spec_string("hef-path", "HEF Path Location", "Location of the HEF file to read", NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_NETWORK_NAME,
+        g_param_spec_string("net-name", "Network Name",
+            "Configure and run this specific network. "
+            "If not passed, configure and run the default network - ONLY if there is one network in the HEF!", NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_BATCH_SIZE,
+        g_param_spec_uint("batch-size", "Inference Batch", "How many frames (from all sources together) to send in one batch",
+            MIN_GSTREAMER_BATCH_SIZE, MAX_GSTREAMER_BATCH_SIZE, HAILO_DEFAULT_BATCH_SIZE,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_BATCH_TIMEOUT_MS,
+        g_param_spec_uint("batch-timeout-ms", "Batch aggregation timeout in ms",
+            "The maximum time to wait for frames from all sources to fill a batch, before sending a partial batch. 0 means never wait.",
+            0, std::numeric_limits<uint32_t>::max(), HAILO_DEFAULT_MUX_BATCH_TIMEOUT_MS, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_OUTPUTS_MIN_POOL_SIZE,
+        g_param_spec_uint("outputs-min-pool-size", "Outputs Minimun Pool Size", "The minimum amount of buffers to allocate for each output layer",
+            0, std::numeric_limits<uint32_t>::max(), DEFAULT_OUTPUTS_MIN_POOL_SIZE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_OUTPUTS_MAX_POOL_SIZE,
+        g_param_spec_uint("outputs-max-pool-size", "Outputs Maximum Pool Size",
+            "The maximum amount of buffers to allocate for each output layer or 0 for unlimited", 0, std::numeric_limits<uint32_t>::max(),
+            DEFAULT_OUTPUTS_MAX_POOL_SIZE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_SCHEDULING_ALGORITHM,
+        g_param_spec_enum("scheduling-algorithm", "Scheduling policy for automatic network group switching", "Controls the Model Scheduler algorithm of HailoRT. "
+            "Gets values from the enum GstHailoSchedulingAlgorithms. "
+            "When using the same VDevice across multiple elements, all should have the same 'scheduling-algorithm'. ",
+            GST_TYPE_SCHEDULING_ALGORITHM, HAILO_SCHEDULING_ALGORITHM_ROUND_ROBIN,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_SCHEDULER_TIMEOUT_MS,
+        g_param_spec_uint("scheduler-timeout-ms", "Timeout for for scheduler in ms", "The maximum time period that may pass before getting run time from the scheduler,"
+            " as long as at least one send request has been sent.",
+            HAILO_DEFAULT_SCHEDULER_TIMEOUT_MS, std::numeric_limits<uint32_t>::max(), HAILO_DEFAULT_SCHEDULER_TIMEOUT_MS, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_SCHEDULER_THRESHOLD,
+        g_param_spec_uint("scheduler-threshold", "Frames threshold for scheduler", "The minimum number of send requests required before the network is considered ready to get run time from the scheduler.",
+            HAILO_DEFAULT_SCHEDULER_THRESHOLD, std::numeric_limits<uint32_t>::max(), HAILO_DEFAULT_SCHEDULER_THRESHOLD, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(gobject_class, PROP_MULTI_PROCESS_SERVICE,
+        g_param_spec_boolean("multi-process-service", "Should run over HailoRT service", "Controls wether to run HailoRT over its service. "
+            "To use this property, the service should be active and scheduling-algorithm should be set. Defaults to false.",
+            HAILO_DEFAULT_MULTI_PROCESS_SERVICE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+}
+
+Expected<std::unique_ptr<HailoMuxNetImpl>> HailoMuxNetImpl::create(GstHailoMuxNet *element)
+{
+    if (nullptr == element) {
+        return make_unexpected(HAILO_INVALID_ARGUMENT);
+    }
+
+    auto ptr = make_unique_nothrow<HailoMuxNetImpl>(element);
+    if (nullptr == ptr) {
+        return make_unexpected(HAILO_OUT_OF_HOST_MEMORY);
+    }
+
+    return ptr;
+}
+
+HailoMuxNetImpl::HailoMuxNetImpl(GstHailoMuxNet *element) : m_element(element), m_props(), m_sources(), m_next_pad_index(0),
+    m_input_vstream_infos(), m_net_group_handle(nullptr), m_was_configured(false), m_is_running(false), m_has_failed(false)
+{
+    GST_DEBUG_CATEGORY_INIT(gst_hailomuxnet_debug_category, "hailomuxnet", 0, "debug category for hailomuxnet element");
+}
+
+HailoMuxNetImpl::~HailoMuxNetImpl()
+{
+    (void)stop();
+}
+
+void HailoMuxNetImpl::set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    GST_DEBUG_OBJECT(m_element, "set_property");
+
+    if ((object == nullptr) || (value == nullptr) || (pspec == nullptr)) {
+        g_error("set_property got null parameter!");
+        return;
+    }
+
+    if (m_was_configured && (PROP_BATCH_TIMEOUT_MS != property_id)) {
+        g_warning("The network was already configured so changing the property %s will not take place!", pspec->name);
+        return;
+    }
+
+    switch (property_id) {
+    case PROP_DEVICE_ID:
+        if (0 != m_props.m_device_count.get()) {
+            g_error("device-id and device-count excludes eachother. received device-id=%s, device-count=%d",
+                g_value_get_string(value), m_props.m_device_count.get());
+            break;
+        }
+        if (nullptr != m_props.m_device_id.get()) {
+            g_free(m_props.m_device_id.get());
+        }
+        m_props.m_device_id = g_strdup(g_value_get_string(value));
+        break;
+    case PROP_DEVICE_COUNT:
+        if (nullptr != m_props.m_device_id.get()) {
+            g_error("device-id and device-count excludes eachother. received device-id=%s, device-count=%d",
+                m_props.m_device_id.get(), g_value_get_uint(value));
+            break;
+        }
+        m_props.m_device_count = static_cast<guint16>(g_value_get_uint(value));
+        break;
+    case PROP_VDEVICE_KEY:
+        m_props.m_vdevice_key = static_cast<guint32>(g_value_get_uint(value));
+        break;
+    case PROP_HEF_PATH:
+        if (nullptr != m_props.m_hef_path.get()) {
+            g_free(m_props.m_hef_path.get());
+        }
+        m_props.m_hef_path = g_strdup(g_value_get_string(value));
+        break;
+    case PROP_NETWORK_NAME:
+        if (nullptr != m_props.m_network_name.get()) {
+            g_free(m_props.m_network_name.get());
+        }
+        m_props.m_network_name = g_strdup(g_value_get_string(value));
+        break;
+    case PROP_BATCH_SIZE:
+        m_props.m_batch_size = static_cast<guint16>(g_value_get_uint(value));
+        break;
+    case PROP_BATCH_TIMEOUT_MS:
+        m_props.m_batch_timeout_ms = g_value_get_uint(value);
+        break;
+    case PROP_OUTPUTS_MIN_POOL_SIZE:
+        m_props.m_outputs_min_pool_size = g_value_get_uint(value);
+        break;
+    case PROP_OUTPUTS_MAX_POOL_SIZE:
+        m_props.m_outputs_max_pool_size = g_value_get_uint(value);
+        break;
+    case PROP_SCHEDULING_ALGORITHM:
+        m_props.m_scheduling_algorithm = static_cast<hailo_scheduling_algorithm_t>(g_value_get_enum(value));
+        break;
+    case PROP_SCHEDULER_TIMEOUT_MS:
+        m_props.m_scheduler_timeout_ms = g_value_get_uint(value);
+        break;
+    case PROP_SCHEDULER_THRESHOLD:
+        m_props.m_scheduler_threshold = g_value_get_uint(value);
+        break;
+    case PROP_MULTI_PROCESS_SERVICE:
+        m_props.m_multi_process_service = g_value_get_boolean(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        break;
+    }
+}
+
+void HailoMuxNetImpl::get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    GST_DEBUG_OBJECT(m_element, "get_property");
+
+    if ((object == nullptr) || (value == nullptr) || (pspec == nullptr)) {
+        g_error("get_property got null parameter!");
+        return;
+    }
+
+    switch (property_id) {
+    case PROP_DEVICE_ID:
+        g_value_set_string(value, m_props.m_device_id.get());
+        break;
+    case PROP_DEVICE_COUNT:
+        g_value_set_uint(value, m_props.m_device_count.get());
+        break;
+    case PROP_VDEVICE_KEY:
+        g_value_set_uint(value, m_props.m_vdevice_key.get());
+        break;
+    case PROP_HEF_PATH:
+        g_value_set_string(value, m_props.m_hef_path.get());
+        break;
+    case PROP_NETWORK_NAME:
+        g_value_set_string(value, m_props.m_network_name.get());
+        break;
+    case PROP_BATCH_SIZE:
+        g_value_set_uint(value, m_props.m_batch_size.get());
+        break;
+    case PROP_BATCH_TIMEOUT_MS:
+        g_value_set_uint(value, m_props.m_batch_timeout_ms.get());
+        break;
+    case PROP_OUTPUTS_MIN_POOL_SIZE:
+        g_value_set_uint(value, m_props.m_outputs_min_pool_size.get());
+        break;
+    case PROP_OUTPUTS_MAX_POOL_SIZE:
+        g_value_set_uint(value, m_props.m_outputs_max_pool_size.get());
+        break;
+    case PROP_SCHEDULING_ALGORITHM:
+        g_value_set_enum(value, m_props.m_scheduling_algorithm.get());
+        break;
+    case PROP_SCHEDULER_TIMEOUT_MS:
+        g_value_set_uint(value, m_props.m_scheduler_timeout_ms.get());
+        break;
+    case PROP_SCHEDULER_THRESHOLD:
+        g_value_set_uint(value, m_props.m_scheduler_threshold.get());
+        break;
+    case PROP_MULTI_PROCESS_SERVICE:
+        g_value_set_boolean(value, m_props.m_multi_process_service.get());
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        break;
+    }
+}
+
+GstPad *HailoMuxNetImpl::request_new_pad(GstPadTemplate *templ, const gchar *name)
+{
+    uint32_t pad_index = m_next_pad_index;
+    if ((nullptr != name) && (1 != sscanf(name, "sink_%u", &pad_index))) {
+        GST_ELEMENT_ERROR(m_element, RESOURCE, FAILED, ("Invalid pad name %s, expected sink_%%u", name), (NULL));
+        return nullptr;
+    }
+    m_next_pad_index = std::max(m_next_pad_index, pad_index + 1);
+
+    auto sinkpad_name = "sink_" + std::to_string(pad_index);
+    auto srcpad_name = "src_" + std::to_string(pad_index);
+    GstPad *sinkpad = gst_pad_new_from_template(templ, sinkpad_name.c_str());
+    GstPad *srcpad = gst_pad_new_from_template(gst_element_class_get_pad_template(GST_ELEMENT_GET_CLASS(m_element), "src_%u"),
+        srcpad_name.c_str());
+
+    auto source = make_shared_nothrow<HailoMuxSource>(sinkpad, srcpad);
+    if (nullptr == source) {
+        GST_ELEMENT_ERROR(m_element, RESOURCE, FAILED, ("Failed allocating memory for pad %s!", sinkpad_name.c_str()), (NULL));
+        gst_object_unref(sinkpad);
+        gst_object_unref(srcpad);
+        return nullptr;
+    }
+
+    gst_pad_set_element_private(sinkpad, source.get());
+    gst_pad_set_element_private(srcpad, source.get());
+
+    gst_pad_set_chain_function(sinkpad, GST_DEBUG_FUNCPTR(gst_hailomuxnet_sink_chain));
+    gst_pad_set_event_function(sinkpad, GST_DEBUG_FUNCPTR(gst_hailomuxnet_sink_event));
+    gst_pad_set_query_function(sinkpad, GST_DEBUG_FUNCPTR(gst_hailomuxnet_sink_query));
+    gst_pad_set_iterate_internal_links_function(sinkpad, GST_DEBUG_FUNCPTR(gst_hailomuxnet_iterate_internal_links));
+
+    // The src pad forwards upstream events and queries to its sink pad, and outputs frames with the caps they came with
+    gst_pad_set_iterate_internal_links_function(srcpad, GST_DEBUG_FUNCPTR(gst_hailomuxnet_iterate_internal_links));
+    gst_pad_use_fixed_caps(srcpad);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sources.emplace_back(source);
+    }
+
+    (void)gst_element_add_pad(GST_ELEMENT(m_element), srcpad);
+    (void)gst_element_add_pad(GST_ELEMENT(m_element), sinkpad);
+
+    return sinkpad;
+}
+
+void HailoMuxNetImpl::release_pad(GstPad *pad)
+{
+    std::shared_ptr<HailoMuxSource> source;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto source_it = std::find_if(m_sources.begin(), m_sources.end(),
+            [pad](const std::shared_ptr<HailoMuxSource> &source) { return source->sinkpad == pad; });
+        if (m_sources.end() == source_it) {
+            return;
+        }
+
+        // The queued objects of the source are dropped, and its streaming thread is released if it waits for room in
+        // the queue (so the sink pad can be deactivated). Its in flight frames keep it alive until their outputs are read.
+        source = *source_it;
+        m_sources.erase(source_it);
+        source->is_flushing = true;
+        flush_source(*source);
+    }
+    m_pending_cv.notify_all();
+
+    (void)gst_element_remove_pad(GST_ELEMENT(m_element), source->sinkpad);
+    (void)gst_element_remove_pad(GST_ELEMENT(m_element), source->srcpad);
+}
+
+GstFlowReturn HailoMuxNetImpl::enqueue(HailoMuxSource &source, GstMiniObject *object)
+{
+    const bool is_buffer = GST_IS_BUFFER(object);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Each source may queue a limited amount of frames, so a fast source can't starve the others
+        m_pending_cv.wait(lock, [this, &source, is_buffer] {
+            return !m_is_running || source.is_flushing || !is_buffer || (source.queued_buffers < MAX_QUEUED_BUFFERS_IN_INPUT);
+        });
+        if (m_has_failed) {
+            return GST_FLOW_ERROR;
+        }
+        if (!m_is_running || source.is_flushing) {
+            return GST_FLOW_FLUSHING;
+        }
+
+        if (is_buffer) {
+            source.queued_buffers++;
+        }
+        m_pending.push_back(QueuedObject{source.shared_from_this(), object, source.flush_epoch.load()});
+    }
+    m_pending_cv.notify_all();
+    return GST_FLOW_OK;
+}
+
+// The sticky events that a flush doesn't clear from the pads, so they're kept when their source is flushed
+static bool is_kept_on_flush(GstMiniObject *object)
+{
+    return GST_IS_EVENT(object) &&
+        ((GST_EVENT_STREAM_START == GST_EVENT_TYPE(object)) || (GST_EVENT_CAPS == GST_EVENT_TYPE(object)));
+}
+
+static bool is_dropped_on_flush(const std::shared_ptr<HailoMuxSource> &source, uint32_t flush_epoch, GstMiniObject *object)
+{
+    return (flush_epoch != source->flush_epoch.load()) && !is_kept_on_flush(object);
+}
+
+void HailoMuxNetImpl::flush_source(HailoMuxSource &source)
+{
+    auto is_flushed = [&source](const QueuedObject &queued_object) {
+        return (queued_object.source.get() == &source) && !is_kept_on_flush(queued_object.object);
+    };
+    for (auto &queued_object : m_pending) {
+        if (is_flushed(queued_object)) {
+            gst_mini_object_unref(queued_object.object);
+        }
+    }
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), is_flushed), m_pending.end());
+
+    // The in flight frames were already written, so their outputs are still read (in order) and then dropped
+    source.flush_epoch++;
+    source.queued_buffers = 0;
+    source.last_flow = GST_FLOW_OK;
+}
+
+void HailoMuxNetImpl::set_failed()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_has_failed = true;
+        m_is_running = false;
+    }
+    // Releases the sources waiting for room in the queue, and the other thread
+    m_pending_cv.notify_all();
+    m_in_flight_cv.notify_all();
+}
+
+GstFlowReturn HailoMuxNetImpl::chain(HailoMuxSource &source, GstBuffer *buffer)
+{
+    auto flow = enqueue(source, GST_MINI_OBJECT_CAST(buffer));
+    if (GST_FLOW_OK != flow) {
+        gst_buffer_unref(buffer);
+        return flow;
+    }
+
+    // Errors from downstream of the matching src pad are returned to this source
+    return source.last_flow.load();
+}
+
+gboolean HailoMuxNetImpl::sink_event(HailoMuxSource &source, GstEvent *event)
+{
+    switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_CAPS:
+    {
+        GstCaps *caps = nullptr;
+        gst_event_parse_caps(event, &caps);
+        GstVideoInfo video_info;
+        if (!gst_video_info_from_caps(&video_info, caps)) {
+            GST_ELEMENT_ERROR(m_element, STREAM, FAILED, ("Failed parsing caps of pad %s!", GST_PAD_NAME(source.sinkpad)), (NULL));
+            gst_event_unref(event);
+            return FALSE;
+        }
+        break;
+    }
+    case GST_EVENT_FLUSH_START:
+    case GST_EVENT_FLUSH_STOP:
+    {
+        // The queued objects of the source are dropped on both, since objects may be queued until FLUSH_START arrives
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            source.is_flushing = (GST_EVENT_FLUSH_START == GST_EVENT_TYPE(event));
+            flush_source(source);
+        }
+        m_pending_cv.notify_all();
+        return gst_pad_push_event(source.srcpad, event);
+    }
+    default:
+        break;
+    }
+
+    // Serialized events must leave after the frames that came before them
+    if (GST_EVENT_IS_SERIALIZED(event) && (GST_FLOW_OK == enqueue(source, GST_MINI_OBJECT_CAST(event)))) {
+        return TRUE;
+    }
+
+    return gst_pad_push_event(source.srcpad, event);
+}
+
+gboolean HailoMuxNetImpl::sink_query(HailoMuxSource &source, GstQuery *query)
+{
+    if ((GST_QUERY_CAPS != GST_QUERY_TYPE(query)) || m_input_vstream_infos.empty()) {
+        return gst_pad_query_default(source.sinkpad, GST_OBJECT(m_element), query);
+    }
+
+    GstCaps *caps = create_input_vstream_caps(m_element, m_input_vstream_infos[0]);
+    if (nullptr == caps) {
+        return FALSE;
+    }
+
+    GstCaps *filter = nullptr;
+    gst_query_parse_caps(query, &filter);
+    if (nullptr != filter) {
+        GstCaps *filtered_caps = gst_caps_intersect_full(filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(caps);
+        caps = filtered_caps;
+    }
+
+    gst_query_set_caps_result(query, caps);
+    gst_caps_unref(caps);
+    return TRUE;
+}
+
+hailo_status HailoMuxNetImpl::set_hef()
+{
+    GST_CHECK(nullptr != m_props.m_hef_path.get(), HAILO_INVALID_ARGUMENT, m_element, RESOURCE, "hef-path property has to be set!");
+
+    m_net_group_handle = make_unique_nothrow<NetworkGroupHandle>(GST_ELEMENT(m_element));
+    GST_CHECK(nullptr != m_net_group_handle, HAILO_OUT_OF_HOST_MEMORY, m_element, RESOURCE, "Failed allocating memory for network handle!");
+
+    hailo_status status = m_net_group_handle->set_hef(m_props.m_device_id.get(), m_props.m_device_count.get(),
+        m_props.m_vdevice_key.get(), m_props.m_scheduling_algorithm.get(), static_cast<bool>(m_props.m_multi_process_service.get()),
+        m_props.m_hef_path.get());
+    if (HAILO_SUCCESS != status) {
+        return status;
+    }
+
+    if (m_props.m_multi_process_service.get()) {
+        GST_CHECK(m_props.m_scheduling_algorithm.get() != HAILO_SCHEDULING_ALGORITHM_NONE,
+            HAILO_INVALID_OPERATION, m_element, RESOURCE, "To use multi-process-service please set scheduling-algorithm.");
+    }
+
+    if (nullptr == m_props.m_network_name.get()) {
+        GST_CHECK(m_net_group_handle->hef()->get_network_groups_names().size() == 1, HAILO_INVALID_ARGUMENT, m_element, RESOURCE,
+            "Network group has to be specified when there are more than one network groups in the HEF!");
+        auto networks_infos = m_net_group_handle->hef()->get_network_infos(m_net_group_handle->hef()->get_network_groups_names()[0].c_str());
+        GST_CHECK_EXPECTED_AS_STATUS(networks_infos, m_element, RESOURCE, "Getting network infos from network group name was failed, status %d", networks_infos.status());
+        GST_CHECK(networks_infos.value().size() == 1, HAILO_INVALID_ARGUMENT, m_element, RESOURCE,
+            "Network has to be specified when there are more than one network in the network group!");
+        m_props.m_network_name = g_strdup(networks_infos.release()[0].name);
+    }
+
+    auto input_vstream_infos = m_net_group_handle->hef()->get_input_vstream_infos(m_props.m_network_name.get());
+    GST_CHECK_EXPECTED_AS_STATUS(input_vstream_infos, m_element, RESOURCE, "Getting input vstream infos from HEF has failed, status = %d",
+        input_vstream_infos.status());
+    GST_CHECK(1 == input_vstream_infos->size(), HAILO_INVALID_OPERATION, m_element, RESOURCE, "hailomuxnet element supports only HEFs with one input for now!");
+    m_input_vstream_infos = input_vstream_infos.release();
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status HailoMuxNetImpl::configure_network_group()
+{
+    auto network_group_name = m_net_group_handle->get_network_group_name(m_props.m_network_name.get());
+    GST_CHECK_EXPECTED_AS_STATUS(network_group_name, m_element, RESOURCE, "Could not get network group name from name %s, status = %d",
+        m_props.m_network_name.get(), network_group_name.status());
+
+    hailo_status status = m_net_group_handle->configure_network_group(network_group_name->c_str(), m_props.m_scheduling_algorithm.get(),
+        m_props.m_batch_size.get());
+    if (HAILO_SUCCESS != status) {
+        return status;
+    }
+    m_was_configured = true;
+
+    if (m_props.m_scheduler_timeout_ms.was_changed()) {
+        status = m_net_group_handle->set_scheduler_timeout(m_props.m_network_name.get(), m_props.m_scheduler_timeout_ms.get());
+        GST_CHECK_SUCCESS(status, m_element, RESOURCE, "Setting scheduler timeout failed, status = %d", status);
+    }
+    if (m_props.m_scheduler_threshold.was_changed()) {
+        status = m_net_group_handle->set_scheduler_threshold(m_props.m_network_name.get(), m_props.m_scheduler_threshold.get());
+        GST_CHECK_SUCCESS(status, m_element, RESOURCE, "Setting scheduler threshold failed, status = %d", status);
+    }
+
+    auto vstreams = m_net_group_handle->create_vstreams(m_props.m_network_name.get(), m_props.m_scheduling_algorithm.get(), {});
+    GST_CHECK_EXPECTED_AS_STATUS(vstreams, m_element, RESOURCE, "Creating vstreams failed, status = %d", vstreams.status());
+
+    m_input_vstreams = std::move(vstreams->first);
+    status = set_output_vstreams(std::move(vstreams->second));
+    GST_CHECK_SUCCESS(status, m_element, RESOURCE, "Setting output vstreams failed, status = %d", status);
+
+    if (HAILO_SCHEDULING_ALGORITHM_NONE == m_props.m_scheduling_algorithm.get()) {
+        status = m_net_group_handle->activate_network_group();
+        GST_CHECK_SUCCESS(status, m_element, RESOURCE, "Activating network group failed, status = %d", status);
+    }
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status HailoMuxNetImpl::set_output_vstreams(std::vector<OutputVStream> &&output_vstreams)
+{
+    GST_CHECK((0 == m_props.m_outputs_max_pool_size.get()) || (m_props.m_outputs_min_pool_size.get() <= m_props.m_outputs_max_pool_size.get()),
+        HAILO_INVALID_ARGUMENT, m_element, RESOURCE, "Minimum pool size (=%d) is bigger than maximum (=%d)!", m_props.m_outputs_min_pool_size.get(),
+        m_props.m_outputs_max_pool_size.get());
+
+    m_output_vstreams = std::move(output_vstreams);
+
+    for (auto &out_vstream : m_output_vstreams) {
+        GstHailoBufferPool *hailo_pool = GST_HAILO_BUFFER_POOL(g_object_new(GST_TYPE_HAILO_BUFFER_POOL, NULL));
+        gst_object_ref_sink(hailo_pool);
+        memcpy(hailo_pool->vstream_name, out_vstream.name().c_str(), sizeof(hailo_pool->vstream_name));
+        hailo_pool->element_name = GST_ELEMENT_NAME(m_element);
+
+        GstBufferPool *pool = GST_BUFFER_POOL(hailo_pool);
+
+        GstStructure *config = gst_buffer_pool_get_config(pool);
+        gst_buffer_pool_config_set_params(config, nullptr, static_cast<guint>(out_vstream.get_frame_size()), m_props.m_outputs_min_pool_size.get(),
+            m_props.m_outputs_max_pool_size.get());
+
+        gboolean result = gst_buffer_pool_set_config(pool, config);
+        GST_CHECK(result, HAILO_INTERNAL_FAILURE, m_element, RESOURCE, "Could not set config for vstream %s buffer pool", out_vstream.name().c_str());
+
+        result = gst_buffer_pool_set_active(pool, TRUE);
+        GST_CHECK(result, HAILO_INTERNAL_FAILURE, m_element, RESOURCE, "Could not set buffer pool active for vstream %s", out_vstream.name().c_str());
+
+        m_output_infos.emplace_back(out_vstream, pool);
+    }
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status HailoMuxNetImpl::start()
+{
+    if (!m_was_configured) {
+        hailo_status status = configure_network_group();
+        if (HAILO_SUCCESS != status) {
+            return status;
+        }
+    } else {
+        // The vstreams were aborted by the last stop()
+        for (auto &input_vstream : m_input_vstreams) {
+            auto status = input_vstream.resume();
+            GST_CHECK_SUCCESS(status, m_element, STREAM, "Failed resuming input vstream %s, status = %d", input_vstream.name().c_str(), status);
+        }
+        for (auto &output_vstream : m_output_vstreams) {
+            auto status = output_vstream.resume();
+            GST_CHECK_SUCCESS(status, m_element, STREAM, "Failed resuming output vstream %s, status = %d", output_vstream.name().c_str(), status);
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_running = true;
+        m_has_failed = false;
+    }
+    m_send_thread = std::thread([this]() { send_loop(); });
+    m_recv_thread = std::thread([this]() { recv_loop(); });
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status HailoMuxNetImpl::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_running = false;
+    }
+    m_pending_cv.notify_all();
+    m_in_flight_cv.notify_all();
+
+    // Aborting releases the threads if they are blocked on the vstreams
+    hailo_status status = HAILO_SUCCESS;
+    for (auto &input_vstream : m_input_vstreams) {
+        auto abort_status = input_vstream.abort();
+        if (HAILO_SUCCESS != abort_status) {
+            GST_ERROR_OBJECT(m_element, "Failed aborting input vstream %s, status = %d", input_vstream.name().c_str(), abort_status);
+            status = abort_status;
+        }
+    }
+    for (auto &output_vstream : m_output_vstreams) {
+        auto abort_status = output_vstream.abort();
+        if (HAILO_SUCCESS != abort_status) {
+            GST_ERROR_OBJECT(m_element, "Failed aborting output vstream %s, status = %d", output_vstream.name().c_str(), abort_status);
+            status = abort_status;
+        }
+    }
+
+    if (m_send_thread.joinable()) {
+        m_send_thread.join();
+    }
+    if (m_recv_thread.joinable()) {
+        m_recv_thread.join();
+    }
+
+    clear_queues();
+    return status;
+}
+
+void HailoMuxNetImpl::clear_queues()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto &queued_object : m_pending) {
+        gst_mini_object_unref(queued_object.object);
+    }
+    m_pending.clear();
+    for (auto &queued_object : m_in_flight) {
+        gst_mini_object_unref(queued_object.object);
+    }
+    m_in_flight.clear();
+    for (auto &source : m_sources) {
+        source->queued_buffers = 0;
+        source->is_flushing = false;
+        source->last_flow = GST_FLOW_OK;
+    }
+}
+
+hailo_status HailoMuxNetImpl::release_network_group()
+{
+    // The output infos reference the output vstreams
+    m_output_infos.clear();
+    m_output_vstreams.clear();
+    m_input_vstreams.clear();
+
+    if (m_was_configured && (HAILO_SCHEDULING_ALGORITHM_NONE == m_props.m_scheduling_algorithm.get())) {
+        auto was_deactivated = m_net_group_handle->remove_network_group();
+        GST_CHECK_EXPECTED_AS_STATUS(was_deactivated, m_element, RESOURCE, "Failed removing network, status = %d", was_deactivated.status());
+    }
+
+    m_net_group_handle.reset();
+    m_input_vstream_infos.clear();
+    m_was_configured = false;
+    return HAILO_SUCCESS;
+}
+
+void HailoMuxNetImpl::send_loop()
+{
+    const size_t batch_size = std::max<size_t>(1, m_props.m_batch_size.get());
+    std::vector<QueuedObject> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_pending_cv.wait(lock, [this] { return !m_is_running || !m_pending.empty(); });
+
+            // Wait for frames from any of the sources to fill a whole batch, but not longer than the batch timeout.
+            // Serialized events (e.g. EOS) are passed without waiting, so they don't hold back the last frames of a source
+            const std::chrono::milliseconds batch_timeout(m_props.m_batch_timeout_ms.get());
+            m_pending_cv.wait_for(lock, batch_timeout, [this, batch_size] {
+                // The pending queue may be emptied meanwhile by a flush
+                return !m_is_running || m_pending.empty() || (m_pending.size() >= batch_size) ||
+                    !GST_IS_BUFFER(m_pending.back().object);
+            });
+            if (!m_is_running) {
+                return;
+            }
+
+            size_t buffers_count = 0;
+            while (!m_pending.empty() && (buffers_count < batch_size)) {
+                auto &queued_object = m_pending.front();
+                if (GST_IS_BUFFER(queued_object.object)) {
+                    queued_object.source->queued_buffers--;
+                    buffers_count++;
+                }
+                batch.emplace_back(std::move(queued_object));
+                m_pending.pop_front();
+            }
+        }
+        // Wake sources waiting for room in the pending queue
+        m_pending_cv.notify_all();
+
+        for (size_t i = 0; i < batch.size(); i++) {
+            auto &queued_object = batch[i];
+            if (is_dropped_on_flush(queued_object.source, queued_object.flush_epoch, queued_object.object)) {
+                // The source was flushed after the object was taken from the pending queue
+                gst_mini_object_unref(queued_object.object);
+                continue;
+            }
+
+            hailo_status status = HAILO_SUCCESS;
+            if (GST_IS_BUFFER(queued_object.object)) {
+                status = send_frame(*queued_object.source, GST_BUFFER_CAST(queued_object.object));
+            } else if (GST_EVENT_CAPS == GST_EVENT_TYPE(queued_object.object)) {
+                GstCaps *caps = nullptr;
+                gst_event_parse_caps(GST_EVENT_CAST(queued_object.object), &caps);
+                queued_object.source->has_caps = gst_video_info_from_caps(&queued_object.source->video_info, caps);
+            }
+
+            if (HAILO_SUCCESS != status) {
+                // The element is stopping (or has failed) - drop the rest of the batch
+                for (; i < batch.size(); i++) {
+                    gst_mini_object_unref(batch[i].object);
+                }
+                if (HAILO_STREAM_ABORTED_BY_USER != status) {
+                    // The error was posted by send_frame
+                    set_failed();
+                }
+                return;
+            }
+
+            // Frames are moved to the in-flight queue only after they were written, so their outputs are read in the same order
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_in_flight.emplace_back(std::move(queued_object));
+            }
+            m_in_flight_cv.notify_one();
+        }
+        batch.clear();
+    }
+}
+
+hailo_status HailoMuxNetImpl::send_frame(HailoMuxSource &source, GstBuffer *buffer)
+{
+    GST_CHECK(source.has_caps, HAILO_INVALID_OPERATION, m_element, STREAM, "Got a buffer on pad %s before its caps!",
+        GST_PAD_NAME(source.sinkpad));
+
+    GstVideoFrame frame;
+    gboolean result = gst_video_frame_map(&frame, &source.video_info, buffer, GST_MAP_READ);
+    GST_CHECK(result, HAILO_INTERNAL_FAILURE, m_element, STREAM, "Failed mapping frame of pad %s!", GST_PAD_NAME(source.sinkpad));
+
+    hailo_status status = HAILO_SUCCESS;
+    for (auto &input_vstream : m_input_vstreams) {
+        status = write_frame_to_vstream(input_vstream, &frame);
+        if (HAILO_SUCCESS != status) {
+            break;
+        }
+    }
+    gst_video_frame_unmap(&frame);
+
+    if (HAILO_STREAM_ABORTED_BY_USER == status) {
+        return status;
+    }
+    GST_CHECK_SUCCESS(status, m_element, STREAM, "Failed writing frame of pad %s, status = %d", GST_PAD_NAME(source.sinkpad), status);
+    return HAILO_SUCCESS;
+}
+
+void HailoMuxNetImpl::recv_loop()
+{
+    while (true) {
+        QueuedObject queued_object{};
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_in_flight_cv.wait(lock, [this] { return !m_is_running || !m_in_flight.empty(); });
+            if (!m_is_running) {
+                return;
+            }
+            queued_object = std::move(m_in_flight.front());
+            m_in_flight.pop_front();
+        }
+
+        if (GST_IS_EVENT(queued_object.object)) {
+            if (!is_dropped_on_flush(queued_object.source, queued_object.flush_epoch, queued_object.object)) {
+                (void)gst_pad_push_event(queued_object.source->srcpad, GST_EVENT_CAST(queued_object.object));
+            } else {
+                gst_mini_object_unref(queued_object.object);
+            }
+            continue;
+        }
+
+        hailo_status status = recv_frame(*queued_object.source, GST_BUFFER_CAST(queued_object.object), queued_object.flush_epoch);
+        if (HAILO_SUCCESS != status) {
+            if (HAILO_STREAM_ABORTED_BY_USER != status) {
+                // The error was posted by read_outputs
+                set_failed();
+            }
+            return;
+        }
+    }
+}
+
+hailo_status HailoMuxNetImpl::read_outputs()
+{
+    for (auto &output_info : m_output_infos) {
+        auto output_buffer = output_info.acquire_buffer();
+        GST_CHECK_EXPECTED_AS_STATUS(output_buffer, m_element, RESOURCE, "Failed to acquire buffer!");
+
+        GstMapInfo buffer_info;
+        gboolean result = gst_buffer_map(*output_buffer, &buffer_info, GST_MAP_WRITE);
+        GST_CHECK(result, HAILO_INTERNAL_FAILURE, m_element, RESOURCE, "Failed mapping buffer!");
+
+        auto status = output_info.vstream().read(MemoryView(buffer_info.data, buffer_info.size));
+        gst_buffer_unmap(*output_buffer, &buffer_info);
+        if (HAILO_STREAM_ABORTED_BY_USER == status) {
+            return status;
+        }
+        GST_CHECK_SUCCESS(status, m_element, STREAM, "Reading from vstream %s failed, status = %d", output_info.vstream().name().c_str(), status);
+    }
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status HailoMuxNetImpl::recv_frame(HailoMuxSource &source, GstBuffer *buffer, uint32_t flush_epoch)
+{
+    auto status = read_outputs();
+    if (HAILO_SUCCESS != status) {
+        for (auto &output_info : m_output_infos) {
+            output_info.unref_last_acquired_buffer();
+        }
+        gst_buffer_unref(buffer);
+        return status;
+    }
+
+    if (flush_epoch != source.flush_epoch.load()) {
+        // The source was flushed while the frame was in flight
+        for (auto &output_info : m_output_infos) {
+            output_info.unref_last_acquired_buffer();
+        }
+        gst_buffer_unref(buffer);
+        return HAILO_SUCCESS;
+    }
+
+    buffer = gst_buffer_make_writable(buffer);
+    for (auto &output_info : m_output_infos) {
+        GstHailoTensorMeta *buffer_meta = GST_TENSOR_META_ADD(output_info.last_acquired_buffer());
+        buffer_meta->info = output_info.vstream_info();
+
+        (void)gst_buffer_add_parent_buffer_meta(buffer, output_info.last_acquired_buffer());
+        output_info.unref_last_acquired_buffer();
+    }
+
+    // The result is returned to the source on its next frame (unless it was flushed meanwhile)
+    const auto flow = gst_pad_push(source.srcpad, buffer);
+    if (flush_epoch == source.flush_epoch.load()) {
+        source.last_flow = flow;
+    }
+    return HAILO_SUCCESS;
+}
+
+static void gst_hailomuxnet_init(GstHailoMuxNet *self)
+{
+    auto hailomuxnet_impl = HailoMuxNetImpl::create(self);
+    if (!hailomuxnet_impl) {
+        GST_ELEMENT_ERROR(self, RESOURCE, FAILED, ("Creating hailomuxnet implementation has failed! status = %d", hailomuxnet_impl.status()), (NULL));
+        return;
+    }
+
+    self->impl = hailomuxnet_impl.release();
+}
+
+static void gst_hailomuxnet_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    GST_HAILOMUXNET(object)->impl->set_property(object, property_id, value, pspec);
+}
+
+static void gst_hailomuxnet_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    GST_HAILOMUXNET(object)->impl->get_property(object, property_id, value, pspec);
+}
+
+static GstPad *gst_hailomuxnet_request_new_pad(GstElement *element, GstPadTemplate *templ, const gchar *name, const GstCaps */*caps*/)
+{
+    return GST_HAILOMUXNET(element)->impl->request_new_pad(templ, name);
+}
+
+static void gst_hailomuxnet_release_pad(GstElement *element, GstPad *pad)
+{
+    GST_HAILOMUXNET(element)->impl->release_pad(pad);
+}
+
+static HailoMuxSource &gst_hailomuxnet_get_source(GstPad *pad)
+{
+    return *static_cast<HailoMuxSource*>(gst_pad_get_element_private(pad));
+}
+
+static GstFlowReturn gst_hailomuxnet_sink_chain(GstPad *pad, GstObject *parent, GstBuffer *buffer)
+{
+    return GST_HAILOMUXNET(parent)->impl->chain(gst_hailomuxnet_get_source(pad), buffer);
+}
+
+static gboolean gst_hailomuxnet_sink_event(GstPad *pad, GstObject *parent, GstEvent *event)
+{
+    return GST_HAILOMUXNET(parent)->impl->sink_event(gst_hailomuxnet_get_source(pad), event);
+}
+
+static gboolean gst_hailomuxnet_sink_query(GstPad *pad, GstObject *parent, GstQuery *query)
+{
+    return GST_HAILOMUXNET(parent)->impl->sink_query(gst_hailomuxnet_get_source(pad), query);
+}
+
+static GstIterator *gst_hailomuxnet_iterate_internal_links(GstPad *pad, GstObject */*parent*/)
+{
+    auto &source = gst_hailomuxnet_get_source(pad);
+    GstPad *other_pad = (pad == source.sinkpad) ? source.srcpad : source.sinkpad;
+
+    GValue value = G_VALUE_INIT;
+    g_value_init(&value, GST_TYPE_PAD);
+    g_value_set_object(&value, other_pad);
+    GstIterator *iterator = gst_iterator_new_single(GST_TYPE_PAD, &value);
+    g_value_unset(&value);
+    return iterator;
+}
+
+static GstStateChangeReturn gst_hailomuxnet_change_state(GstElement *element, GstStateChange transition)
+{
+    auto &hailomuxnet = GST_HAILOMUXNET(element)->impl;
+    switch (transition) {
+    case GST_STATE_CHANGE_NULL_TO_READY:
+    {
+        hailo_status status = hailomuxnet->set_hef();
+        GST_CHECK(HAILO_SUCCESS == status, GST_STATE_CHANGE_FAILURE, element, RESOURCE, "Setting HEF has failed, status = %d\n", status);
+        break;
+    }
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+    {
+        hailo_status status = hailomuxnet->start();
+        GST_CHECK(HAILO_SUCCESS == status, GST_STATE_CHANGE_FAILURE, element, RESOURCE, "Starting hailomuxnet failed, status = %d\n", status);
+        break;
+    }
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+    {
+        // Must be done before the pads are deactivated, since the streaming threads may be waiting for room in the queue
+        hailo_status status = hailomuxnet->stop();
+        GST_CHECK(HAILO_SUCCESS == status, GST_STATE_CHANGE_FAILURE, element, RESOURCE, "Stopping hailomuxnet failed, status = %d\n", status);
+        break;
+    }
+    default:
+        break;
+    }
+
+    GstStateChangeReturn ret = GST_ELEMENT_CLASS(gst_hailomuxnet_parent_class)->change_state(element, transition);
+    if (GST_STATE_CHANGE_FAILURE == ret) {
+        return ret;
+    }
+
+    if (GST_STATE_CHANGE_READY_TO_NULL == transition) {
+        hailo_status status = hailomuxnet->release_network_group();
+        GST_CHECK(HAILO_SUCCESS == status, GST_STATE_CHANGE_FAILURE, element, RESOURCE, "Releasing network group failed, status = %d\n", status);
+    }
+
+    return ret;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2021-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the LGPL 2.1 license (https://www.gnu.org/licenses/old-licenses/lgpl-2.1.txt)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef _GST_HAILOMUXNET_HPP_
+#define _GST_HAILOMUXNET_HPP_
+
+#include "common.hpp"
+#include "network_group_handle.hpp"
+#include "hailo_output_info.hpp"
+
+#include <gst/video/video.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_HAILOMUXNET (gst_hailomuxnet_get_type())
+#define GST_HAILOMUXNET(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_HAILOMUXNET,GstHailoMuxNet))
+#define GST_HAILOMUXNET_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_HAILOMUXNET,GstHailoMuxNetClass))
+#define GST_IS_HAILOMUXNET(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_HAILOMUXNET))
+#define GST_IS_HAILOMUXNET_CLASS(obj) (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_HAILOMUXNET))
+
+#define HAILO_DEFAULT_MUX_BATCH_TIMEOUT_MS (10)
+
+class HailoMuxNetImpl;
+struct GstHailoMuxNet
+{
+    GstElement parent;
+    std::unique_ptr<HailoMuxNetImpl> impl;
+};
+
+struct GstHailoMuxNetClass
+{
+    GstElementClass parent;
+};
+
+struct HailoMuxNetProperties final
+{
+public:
+    HailoMuxNetProperties() : m_device_id(nullptr), m_hef_path(nullptr), m_network_name(nullptr), m_batch_size(HAILO_DEFAULT_BATCH_SIZE),
+        m_batch_timeout_ms(HAILO_DEFAULT_MUX_BATCH_TIMEOUT_MS), m_device_count(0), m_vdevice_key(DEFAULT_VDEVICE_KEY),
+        m_scheduling_algorithm(HAILO_SCHEDULING_ALGORITHM_ROUND_ROBIN), m_scheduler_timeout_ms(HAILO_DEFAULT_SCHEDULER_TIMEOUT_MS),
+        m_scheduler_threshold(HAILO_DEFAULT_SCHEDULER_THRESHOLD), m_multi_process_service(HAILO_DEFAULT_MULTI_PROCESS_SERVICE),
+        m_outputs_min_pool_size(DEFAULT_OUTPUTS_MIN_POOL_SIZE), m_outputs_max_pool_size(DEFAULT_OUTPUTS_MAX_POOL_SIZE)
+    {}
+
+    HailoElemProperty<gchar*> m_device_id;
+    HailoElemProperty<gchar*> m_hef_path;
+    HailoElemProperty<gchar*> m_network_name; // This property can be network group name or a network name
+    HailoElemProperty<guint16> m_batch_size;
+    HailoElemProperty<guint32> m_batch_timeout_ms;
+    HailoElemProperty<guint16> m_device_count;
+    HailoElemProperty<guint32> m_vdevice_key;
+    HailoElemProperty<hailo_scheduling_algorithm_t> m_scheduling_algorithm;
+    HailoElemProperty<guint32> m_scheduler_timeout_ms;
+    HailoElemProperty<guint32> m_scheduler_threshold;
+    HailoElemProperty<gboolean> m_multi_process_service;
+    HailoElemProperty<guint> m_outputs_min_pool_size;
+    HailoElemProperty<guint> m_outputs_max_pool_size;
+};
+
+// A pair of request sink pad and its matching src pad - frames received on the sink pad leave on the src pad
+struct HailoMuxSource final : public std::enable_shared_from_this<HailoMuxSource>
+{
+    HailoMuxSource(GstPad *sinkpad, GstPad *srcpad) : sinkpad(GST_PAD(gst_object_ref(sinkpad))), srcpad(GST_PAD(gst_object_ref(srcpad))),
+        video_info(), has_caps(false), queued_buffers(0), is_flushing(false), flush_epoch(0), last_flow(GST_FLOW_OK)
+    {}
+
+    ~HailoMuxSource()
+    {
+        gst_object_unref(sinkpad);
+        gst_object_unref(srcpad);
+    }
+
+    HailoMuxSource(const HailoMuxSource &other) = delete;
+    HailoMuxSource &operator=(const HailoMuxSource &other) = delete;
+
+    GstPad *sinkpad;
+    GstPad *srcpad;
+    // Updated by the send thread when it reaches the caps event, so it always matches the frames being sent
+    GstVideoInfo video_info;
+    bool has_caps;
+    // Buffers of this source waiting in the pending queue (guarded by the element's mutex)
+    uint32_t queued_buffers;
+    // Set between FLUSH_START and FLUSH_STOP, new objects of the source are refused (guarded by the element's mutex)
+    bool is_flushing;
+    // Incremented on every flush - objects queued before it are dropped instead of being sent or pushed
+    std::atomic<uint32_t> flush_epoch;
+    std::atomic<GstFlowReturn> last_flow;
+};
+
+class HailoMuxNetImpl final
+{
+public:
+    static Expected<std::unique_ptr<HailoMuxNetImpl>> create(GstHailoMuxNet *element);
+    HailoMuxNetImpl(GstHailoMuxNet *element);
+    ~HailoMuxNetImpl();
+
+    void set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+    void get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+    GstPad *request_new_pad(GstPadTemplate *templ, const gchar *name);
+    void release_pad(GstPad *pad);
+
+    GstFlowReturn chain(HailoMuxSource &source, GstBuffer *buffer);
+    gboolean sink_event(HailoMuxSource &source, GstEvent *event);
+    gboolean sink_query(HailoMuxSource &source, GstQuery *query);
+
+    hailo_status set_hef();
+    hailo_status start();
+    hailo_status stop();
+    hailo_status release_network_group();
+
+private:
+    hailo_status configure_network_group();
+    hailo_status set_output_vstreams(std::vector<OutputVStream> &&output_vstreams);
+    GstFlowReturn enqueue(HailoMuxSource &source, GstMiniObject *object);
+    void clear_queues();
+    // Called with m_mutex locked
+    void flush_source(HailoMuxSource &source);
+    void set_failed();
+
+    void send_loop();
+    hailo_status send_frame(HailoMuxSource &source, GstBuffer *buffer);
+    void recv_loop();
+    hailo_status read_outputs();
+    hailo_status recv_frame(HailoMuxSource &source, GstBuffer *buffer, uint32_t flush_epoch);
+
+    struct QueuedObject {
+        std::shared_ptr<HailoMuxSource> source;
+        GstMiniObject *object; // A GstBuffer or a serialized GstEvent
+        uint32_t flush_epoch; // The source's flush epoch when the object was queued
+    };
+
+    GstHailoMuxNet *m_element;
+    HailoMuxNetProperties m_props;
+    std::vector<std::shared_ptr<HailoMuxSource>> m_sources;
+    uint32_t m_next_pad_index;
+    std::vector<hailo_vstream_info_t> m_input_vstream_infos;
+    std::unique_ptr<NetworkGroupHandle> m_net_group_handle;
+    bool m_was_configured;
+    std::vector<InputVStream> m_input_vstreams;
+    std::vector<OutputVStream> m_output_vstreams;
+    std::vector<HailoOutputInfo> m_output_infos;
+
+    // Objects received on the sink pads, waiting to be aggregated into a batch
+    std::deque<QueuedObject> m_pending;
+    // Objects that were sent (in this order), waiting for their outputs
+    std::deque<QueuedObject> m_in_flight;
+    std::mutex m_mutex;
+    std::condition_variable m_pending_cv;
+    std::condition_variable m_in_flight_cv;
+    bool m_is_running;
+    // Set when sending or receiving failed, the threads are stopped and the sources get GST_FLOW_ERROR
+    bool m_has_failed;
+    std::thread m_send_thread;
+    std::thread m_recv_thread;
+};
+
+GType gst_hailomuxnet_get_type(void);
+
+G_END_DECLS
+
+#endif /* _GST_HAILOMUXNET_HPP_ */
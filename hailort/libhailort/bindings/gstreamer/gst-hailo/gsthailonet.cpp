@@ -30,8 +30,7 @@
 GST_DEBUG_CATEGORY_STATIC(gst_hailonet_debug_category);
 #define GST_CAT_DEFAULT gst_hailonet_debug_category
 
-#define GST_TYPE_SCHEDULING_ALGORITHM (gst_scheduling_algorithm_get_type ())
-static GType
+GType
 gst_scheduling_algorithm_get_type (void)
 {
     static GType scheduling_algorithm_type = 0;
@@ -594,7 +593,7 @@ hailo_status HailoNetImpl::configure_network_group()
     std::unique_lock<std::mutex> lock(m_mutex);
     g_object_set(m_queue, "max-size-buffers", MAX_BUFFER_COUNT(m_props.m_batch_size.get()), NULL);
 
-    auto network_group_name = get_network_group_name(m_props.m_network_name.get());
+    auto network_group_name = m_net_group_handle->get_network_group_name(m_props.m_network_name.get());
     GST_CHECK_EXPECTED_AS_STATUS(network_group_name, m_element, RESOURCE, "Could not get network group name from name %s, status = %d",
         m_props.m_network_name.get(), network_group_name.status());
 
@@ -648,30 +647,6 @@ hailo_status HailoNetImpl::activate_hailonet()
     return HAILO_SUCCESS;
 }
 
-Expected<std::string> HailoNetImpl::get_network_group_name(const std::string &network_name)
-{
-    for (const auto &network_group_name : m_net_group_handle->hef()->get_network_groups_names()) {
-        // Look for network_group with the given name
-        if (network_name == network_group_name) {
-            return std::string(network_group_name);
-        }
-
-        auto network_infos = m_net_group_handle->hef()->get_network_infos(network_group_name);
-        GST_CHECK_EXPECTED(network_infos, m_element, RESOURCE, "Could not get network infos of group %s, status = %d", network_group_name.c_str(),
-            network_infos.status());
-
-        // Look for network with the given name
-        for (const auto &network_info : network_infos.value()) {
-            if (network_name == network_info.name) {
-                return std::string(network_group_name);
-            }
-        }
-    }
-
-    GST_ELEMENT_ERROR(m_element, RESOURCE, FAILED, ("Failed to get network group name from the name %s!", network_name.c_str()), (NULL));
-    return make_unexpected(HAILO_NOT_FOUND);
-}
-
 hailo_status HailoNetImpl::link_elements()
 {
     /* Link elements here because only here we have the HEF and the Caps format */
@@ -99,7 +99,6 @@ public:
 private:
     void init_ghost_sink();
     void init_ghost_src();
-    Expected<std::string> get_network_group_name(const std::string &network_name);
 
     hailo_status clear_vstreams();
 
@@ -120,6 +119,9 @@ private:
 
 GType gst_hailonet_get_type(void);
 
+#define GST_TYPE_SCHEDULING_ALGORITHM (gst_scheduling_algorithm_get_type ())
+GType gst_scheduling_algorithm_get_type(void);
+
 G_END_DECLS
 
 #endif /* _GST_HAILONET_HPP_ */
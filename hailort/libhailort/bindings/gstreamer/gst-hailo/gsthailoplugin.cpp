@@ -18,6 +18,7 @@
  * Boston, MA 02110-1301, USA.
  */
 #include "gsthailonet.hpp"
+#include "gsthailomuxnet.hpp"
 #include "gsthailosend.hpp"
 #include "gsthailorecv.hpp"
 #include "gsthailodevicestats.hpp"
@@ -29,6 +30,7 @@ static gboolean plugin_init(GstPlugin *plugin)
     (void)gst_tensor_meta_api_get_type();
 
     return gst_element_register(plugin, "hailonet", GST_RANK_PRIMARY, GST_TYPE_HAILONET) &&
+        gst_element_register(plugin, "hailomuxnet", GST_RANK_PRIMARY, GST_TYPE_HAILOMUXNET) &&
         gst_element_register(plugin, "hailodevicestats", GST_RANK_PRIMARY, GST_TYPE_HAILODEVICESTATS) &&
         gst_element_register(nullptr, "hailosend", GST_RANK_PRIMARY, GST_TYPE_HAILOSEND) &&
         gst_element_register(nullptr, "hailorecv", GST_RANK_PRIMARY, GST_TYPE_HAILORECV);
@@ -147,18 +147,17 @@ GstFlowReturn HailoSendImpl::handle_frame(GstVideoFilter */*filter*/, GstVideoFr
         return GST_FLOW_OK;
     }
 
-    guint8 *frame_buffer = reinterpret_cast<guint8*>(GST_VIDEO_FRAME_PLANE_DATA(frame, 0));
     hailo_status status = HAILO_UNINITIALIZED;
 
     if (m_props.m_debug.get()) {
         std::chrono::duration<double, std::milli> latency;
         std::chrono::time_point<std::chrono::system_clock> start_time;
         start_time = std::chrono::system_clock::now();
-        status = write_to_vstreams(frame_buffer, GST_VIDEO_FRAME_SIZE(frame));
+        status = write_to_vstreams(frame);
         latency = std::chrono::system_clock::now() - start_time;
         GST_DEBUG("hailosend latency: %f milliseconds", latency.count());
     } else {
-        status = write_to_vstreams(frame_buffer, GST_VIDEO_FRAME_SIZE(frame));
+        status = write_to_vstreams(frame);
     }
 
     if (HAILO_SUCCESS != status) {
@@ -167,15 +166,47 @@ GstFlowReturn HailoSendImpl::handle_frame(GstVideoFilter */*filter*/, GstVideoFr
     return GST_FLOW_OK;
 }
 
-hailo_status HailoSendImpl::write_to_vstreams(void *buf, size_t size)
+hailo_status HailoSendImpl::write_to_vstreams(GstVideoFrame *frame)
 {
     for (auto &in_vstream : m_input_vstreams) {
-        auto status = in_vstream.write(MemoryView(buf, size));
+        auto status = write_frame_to_vstream(in_vstream, frame);
         GST_CHECK_SUCCESS(status, m_element, STREAM, "Failed writing to input vstream %s, status = %d", in_vstream.name().c_str(), status);
     }
     return HAILO_SUCCESS;
 }
 
+hailo_status write_frame_to_vstream(InputVStream &in_vstream, GstVideoFrame *frame)
+{
+    guint8 *frame_buffer = reinterpret_cast<guint8*>(GST_VIDEO_FRAME_PLANE_DATA(frame, 0));
+    size_t frame_size = GST_VIDEO_FRAME_SIZE(frame);
+
+    // Frames with padded rows (e.g. from hw decoders) or with a crop region are passed with their layout,
+    // so they are packed while being transformed instead of being copied by an upstream videoconvert
+    GstVideoCropMeta *crop_meta = gst_buffer_get_video_crop_meta(frame->buffer);
+    hailo_frame_layout_t layout = {};
+    guint8 *base = reinterpret_cast<guint8*>(frame->map[0].data);
+    for (guint plane = 0; (plane < GST_VIDEO_FRAME_N_PLANES(frame)) && (plane < HAILO_MAX_FRAME_PLANES); plane++) {
+        layout.plane_offsets[plane] = static_cast<size_t>(reinterpret_cast<guint8*>(GST_VIDEO_FRAME_PLANE_DATA(frame, plane)) - base);
+        layout.row_pitches[plane] = static_cast<size_t>(GST_VIDEO_FRAME_PLANE_STRIDE(frame, plane));
+    }
+    if (nullptr != crop_meta) {
+        // The layout holds the origin of the region, and its size is the vstream's frame size
+        const auto vstream_info = in_vstream.get_info();
+        if ((crop_meta->width != vstream_info.shape.width) || (crop_meta->height != get_height_by_order(vstream_info))) {
+            GST_ERROR("Crop region size %ux%u doesn't match input vstream %s (%ux%u)", crop_meta->width, crop_meta->height,
+                in_vstream.name().c_str(), vstream_info.shape.width, get_height_by_order(vstream_info));
+            return HAILO_INVALID_ARGUMENT;
+        }
+        layout.roi_x = crop_meta->x;
+        layout.roi_y = crop_meta->y;
+    }
+
+    if ((nullptr == crop_meta) && (frame_size == in_vstream.get_frame_size())) {
+        return in_vstream.write(MemoryView(frame_buffer, frame_size));
+    }
+    return in_vstream.write(MemoryView(base, frame->map[0].size), layout);
+}
+
 uint32_t get_height_by_order(const hailo_vstream_info_t &input_vstream_info)
 {
     auto original_height = input_vstream_info.shape.height;
@@ -189,25 +220,13 @@ uint32_t get_height_by_order(const hailo_vstream_info_t &input_vstream_info)
     return original_height;
 }
 
-GstCaps *HailoSendImpl::get_caps(GstBaseTransform */*trans*/, GstPadDirection /*direction*/, GstCaps *caps, GstCaps */*filter*/)
+GstCaps *create_input_vstream_caps(const void *element, const hailo_vstream_info_t &input_vstream_info)
 {
-    GST_DEBUG_OBJECT(m_element, "transform_caps");
-
-    if (0 == m_input_vstream_infos.size()) {
-        // Init here because it is guaranteed that we have a parent element
-        m_hailonet = GST_HAILONET(GST_ELEMENT_PARENT(m_element));
-
-        hailo_status status = m_hailonet->impl->set_hef();
-        if (HAILO_SUCCESS != status) {
-            return NULL;
-        }
-    }
-    
     const gchar *format = nullptr;
-    switch (m_input_vstream_infos[0].format.order) {
+    switch (input_vstream_info.format.order) {
     case HAILO_FORMAT_ORDER_RGB4:
     case HAILO_FORMAT_ORDER_NHWC:
-        if (m_input_vstream_infos[0].shape.features == RGBA_FEATURES_SIZE) {
+        if (input_vstream_info.shape.features == RGBA_FEATURES_SIZE) {
             format = "RGBA";
             break;
         }
@@ -216,41 +235,64 @@ GstCaps *HailoSendImpl::get_caps(GstBaseTransform */*trans*/, GstPadDirection /*
     case HAILO_FORMAT_ORDER_FCR:
     case HAILO_FORMAT_ORDER_F8CR:
         format = "RGB";
-        GST_CHECK(RGB_FEATURES_SIZE == m_input_vstream_infos[0].shape.features, NULL, m_element, STREAM,
-            "Features of input vstream %s is not %d for RGB format! (features=%d)", m_input_vstream_infos[0].name, RGB_FEATURES_SIZE,
-            m_input_vstream_infos[0].shape.features);
+        GST_CHECK(RGB_FEATURES_SIZE == input_vstream_info.shape.features, nullptr, element, STREAM,
+            "Features of input vstream %s is not %d for RGB format! (features=%d)", input_vstream_info.name, RGB_FEATURES_SIZE,
+            input_vstream_info.shape.features);
         break;
     case HAILO_FORMAT_ORDER_YUY2:
         format = "YUY2";
-        GST_CHECK(YUY2_FEATURES_SIZE == m_input_vstream_infos[0].shape.features, NULL, m_element, STREAM,
-            "Features of input vstream %s is not %d for YUY2 format! (features=%d)", m_input_vstream_infos[0].name, YUY2_FEATURES_SIZE,
-            m_input_vstream_infos[0].shape.features);
+        GST_CHECK(YUY2_FEATURES_SIZE == input_vstream_info.shape.features, nullptr, element, STREAM,
+            "Features of input vstream %s is not %d for YUY2 format! (features=%d)", input_vstream_info.name, YUY2_FEATURES_SIZE,
+            input_vstream_info.shape.features);
         break;
     case HAILO_FORMAT_ORDER_NV12:
         format = "NV12";
-        GST_CHECK(NV12_FEATURES_SIZE == m_input_vstream_infos[0].shape.features, NULL, m_element, STREAM,
-            "Features of input vstream %s is not %d for NV12 format! (features=%d)", m_input_vstream_infos[0].name, NV12_FEATURES_SIZE,
-            m_input_vstream_infos[0].shape.features);
+        GST_CHECK(NV12_FEATURES_SIZE == input_vstream_info.shape.features, nullptr, element, STREAM,
+            "Features of input vstream %s is not %d for NV12 format! (features=%d)", input_vstream_info.name, NV12_FEATURES_SIZE,
+            input_vstream_info.shape.features);
         break;
     case HAILO_FORMAT_ORDER_NV21:
         format = "NV21";
-        GST_CHECK(NV21_FEATURES_SIZE == m_input_vstream_infos[0].shape.features, NULL, m_element, STREAM,
-            "Features of input vstream %s is not %d for NV21 format! (features=%d)", m_input_vstream_infos[0].name, NV21_FEATURES_SIZE,
-            m_input_vstream_infos[0].shape.features);
+        GST_CHECK(NV21_FEATURES_SIZE == input_vstream_info.shape.features, nullptr, element, STREAM,
+            "Features of input vstream %s is not %d for NV21 format! (features=%d)", input_vstream_info.name, NV21_FEATURES_SIZE,
+            input_vstream_info.shape.features);
         break;
     default:
-        GST_ELEMENT_ERROR(m_element, RESOURCE, FAILED,
-            ("Input VStream %s has an unsupported format order! order = %d", m_input_vstream_infos[0].name, m_input_vstream_infos[0].format.order), (NULL));
+        GST_ELEMENT_ERROR(element, RESOURCE, FAILED,
+            ("Input VStream %s has an unsupported format order! order = %d", input_vstream_info.name, input_vstream_info.format.order), (NULL));
+        return nullptr;
+    }
+
+    return gst_caps_new_simple("video/x-raw",
+                               "format", G_TYPE_STRING, format,
+                               "width", G_TYPE_INT, input_vstream_info.shape.width,
+                               "height", G_TYPE_INT, get_height_by_order(input_vstream_info),
+                               NULL);
+}
+
+GstCaps *HailoSendImpl::get_caps(GstBaseTransform */*trans*/, GstPadDirection /*direction*/, GstCaps *caps, GstCaps */*filter*/)
+{
+    GST_DEBUG_OBJECT(m_element, "transform_caps");
+
+    if (0 == m_input_vstream_infos.size()) {
+        // Init here because it is guaranteed that we have a parent element
+        m_hailonet = GST_HAILONET(GST_ELEMENT_PARENT(m_element));
+
+        hailo_status status = m_hailonet->impl->set_hef();
+        if (HAILO_SUCCESS != status) {
+            return NULL;
+        }
+    }
+    
+    GstCaps *new_caps = create_input_vstream_caps(m_element, m_input_vstream_infos[0]);
+    if (nullptr == new_caps) {
         return NULL;
     }
 
     /* filter against set allowed caps on the pad */
-    GstCaps *new_caps = gst_caps_new_simple("video/x-raw",
-                                            "format", G_TYPE_STRING, format,
-                                            "width", G_TYPE_INT, m_input_vstream_infos[0].shape.width,
-                                            "height", G_TYPE_INT, get_height_by_order(m_input_vstream_infos[0]),
-                                            NULL);
-    return gst_caps_intersect(caps, new_caps);
+    GstCaps *result = gst_caps_intersect(caps, new_caps);
+    gst_caps_unref(new_caps);
+    return result;
 }
 
 void HailoSendImpl::set_input_vstream_infos(std::vector<hailo_vstream_info_t> &&input_vstream_infos)
@@ -315,7 +357,17 @@ static gboolean gst_hailosend_propose_allocation(GstBaseTransform *trans, GstQue
         return FALSE;
     }
 
-    return GST_BASE_TRANSFORM_CLASS(gst_hailosend_parent_class)->propose_allocation(trans, decide_query, query);
+    // Fails when downstream didn't answer the allocation query, in which case only our metas are proposed
+    (void)GST_BASE_TRANSFORM_CLASS(gst_hailosend_parent_class)->propose_allocation(trans, decide_query, query);
+
+    // Padded and cropped frames are written with their layout, so upstream doesn't have to repack them
+    if (!gst_query_find_allocation_meta(query, GST_VIDEO_META_API_TYPE, NULL)) {
+        gst_query_add_allocation_meta(query, GST_VIDEO_META_API_TYPE, NULL);
+    }
+    if (!gst_query_find_allocation_meta(query, GST_VIDEO_CROP_META_API_TYPE, NULL)) {
+        gst_query_add_allocation_meta(query, GST_VIDEO_CROP_META_API_TYPE, NULL);
+    }
+    return TRUE;
 }
 
 static GstStateChangeReturn gst_hailosend_change_state(GstElement *element, GstStateChange transition)
@@ -89,7 +89,7 @@ public:
     }
 
 private:
-    hailo_status write_to_vstreams(void *buf, size_t size);
+    hailo_status write_to_vstreams(GstVideoFrame *frame);
     
     GstHailoSend *m_element;
     GstHailoNet *m_hailonet;
@@ -102,6 +102,10 @@ private:
 
 GType gst_hailosend_get_type(void);
 
+uint32_t get_height_by_order(const hailo_vstream_info_t &input_vstream_info);
+GstCaps *create_input_vstream_caps(const void *element, const hailo_vstream_info_t &input_vstream_info);
+hailo_status write_frame_to_vstream(InputVStream &in_vstream, GstVideoFrame *frame);
+
 G_END_DECLS
 
 #endif /* _GST_HAILOSEND_HPP_ */
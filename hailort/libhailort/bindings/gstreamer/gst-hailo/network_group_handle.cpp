@@ -176,6 +176,30 @@ hailo_status NetworkGroupHandle::set_scheduler_threshold(const char *network_nam
     return m_cng->set_scheduler_threshold(threshold, network_name);
 }
 
+Expected<std::string> NetworkGroupHandle::get_network_group_name(const std::string &network_name)
+{
+    for (const auto &network_group_name : m_hef->get_network_groups_names()) {
+        // Look for network_group with the given name
+        if (network_name == network_group_name) {
+            return std::string(network_group_name);
+        }
+
+        auto network_infos = m_hef->get_network_infos(network_group_name);
+        GST_CHECK_EXPECTED(network_infos, m_element, RESOURCE, "Could not get network infos of group %s, status = %d", network_group_name.c_str(),
+            network_infos.status());
+
+        // Look for network with the given name
+        for (const auto &network_info : network_infos.value()) {
+            if (network_name == network_info.name) {
+                return std::string(network_group_name);
+            }
+        }
+    }
+
+    GST_ELEMENT_ERROR(m_element, RESOURCE, FAILED, ("Failed to get network group name from the name %s!", network_name.c_str()), (NULL));
+    return make_unexpected(HAILO_NOT_FOUND);
+}
+
 Expected<std::pair<std::vector<InputVStream>, std::vector<OutputVStream>>> NetworkGroupHandle::create_vstreams(const char *network_name,
     hailo_scheduling_algorithm_t scheduling_algorithm, const std::vector<hailo_format_with_name_t> &output_formats)
 {
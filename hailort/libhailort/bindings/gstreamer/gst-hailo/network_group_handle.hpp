@@ -89,6 +89,7 @@ public:
 
     hailo_status set_scheduler_timeout(const char *network_name, uint32_t timeout_ms);
     hailo_status set_scheduler_threshold(const char *network_name, uint32_t threshold);
+    Expected<std::string> get_network_group_name(const std::string &network_name);
 
 
     std::shared_ptr<Hef> hef()
@@ -894,6 +894,30 @@ class InferVStreams(object):
         self._total_time = time.time() - time_before_infer_calcs
         return output_buffers
 
+    def infer_batch(self, input_data, output_buffers=None):
+        """Run inference on a batch of frames on the hardware device, in a single call to the C++ library.
+
+        Unlike :func:`infer`, the input data is not cast or copied and nms outputs are not converted,
+        so the per-batch Python overhead is minimal.
+
+        Args:
+            input_data (dict of :obj:`numpy.ndarray`): Where the key is the name of the input_layer,
+                and the value is a C contiguous array of the frames to run inference on (the first
+                dimension is the number of frames), in the input vstream's user buffer format.
+            output_buffers (dict of :obj:`numpy.ndarray`, optional): Preallocated C contiguous arrays to
+                write the outputs into, where the key is the name of the output layer. If not given,
+                the arrays are allocated by the library.
+
+        Returns:
+            dict: Output tensors of all output layers, in the output vstreams' user buffer format.
+        """
+        with ExceptionWrapper():
+            time_before_infer = time.time()
+            output_buffers = self._infer_pipeline.infer_batch(input_data, output_buffers or {})
+            self._hw_time = time.time() - time_before_infer
+        self._total_time = self._hw_time
+        return output_buffers
+
     def get_hw_time(self):
         """Get the hardware device operation time it took to run inference over the last batch.
 
@@ -2773,7 +2797,7 @@ class OutputLayerUtils(object):
 class OutputVStream(object):
     """Represents a single output virtual stream in the device to host direction."""
 
-    def __init__(self, configured_network, recv_object, name, tf_nms_format=False, net_group_name=""):
+    def __init__(self, configured_network, recv_object, name, tf_nms_format=False, net_group_name="", recv_ring_size=0):
         self._recv_object = recv_object
         self._output_layer_utils = OutputLayerUtils(configured_network._hef, name, self._recv_object, net_group_name)
         self._output_dtype = self._output_layer_utils.output_dtype
@@ -2783,6 +2807,8 @@ class OutputVStream(object):
         if self._is_nms:
             self._quantized_empty_bbox = self._output_layer_utils.quantized_empty_bbox
         self._tf_nms_format = tf_nms_format
+        self._recv_ring = [numpy.empty(self._recv_object.shape, dtype=self._output_dtype) for _ in range(recv_ring_size)]
+        self._recv_ring_index = 0
 
     @property
     def shape(self):
@@ -2809,8 +2835,14 @@ class OutputVStream(object):
             In case of nms output and tf_nms_format=False, returns list of :obj:`numpy.ndarray`.
         """
         result_array = None
-        with ExceptionWrapper():
-            result_array = self._recv_object.recv()
+        if self._recv_ring:
+            result_array = self._recv_ring[self._recv_ring_index]
+            self._recv_ring_index = (self._recv_ring_index + 1) % len(self._recv_ring)
+            with ExceptionWrapper():
+                self._recv_object.recv_into(result_array)
+        else:
+            with ExceptionWrapper():
+                result_array = self._recv_object.recv()
 
         if self._is_nms:
             nms_shape = self._vstream_info.nms_shape
@@ -2828,6 +2860,20 @@ class OutputVStream(object):
                     nms_shape.number_of_classes)
         return result_array
 
+    def recv_into(self, output_buffer):
+        """Receive a frame after inference into a preallocated buffer, without allocating a new array per frame.
+
+        Args:
+            output_buffer (:obj:`numpy.ndarray`): C contiguous array to receive the frame into. Its dtype and shape
+                should match :attr:`dtype` and :attr:`shape` (the frame in the user buffer format, without post
+                processing of nms outputs to the formats returned by :func:`recv`).
+        """
+        if output_buffer.dtype != self._output_dtype:
+            raise HailoRTInvalidArgumentException("recv_into expected an array of dtype {}, got {}".format(
+                self._output_dtype, output_buffer.dtype))
+        with ExceptionWrapper():
+            self._recv_object.recv_into(output_buffer)
+
     @property
     def info(self):
         with ExceptionWrapper():
@@ -2836,7 +2882,7 @@ class OutputVStream(object):
 class OutputVStreams(object):
     """Output virtual streams pipelines that allows to receive data, to be used as a context manager."""
 
-    def __init__(self, configured_network, output_vstreams_params, tf_nms_format=False):
+    def __init__(self, configured_network, output_vstreams_params, tf_nms_format=False, recv_ring_size=0):
         """Constructor for the OutputVStreams class.
 
         Args:
@@ -2852,12 +2898,17 @@ class OutputVStreams(object):
                   ``[number_of_detections, BBOX_PARAMS]``
                 * TensorFlow format -- :obj:`numpy.ndarray` of shape
                   ``[class_count, BBOX_PARAMS, detections_count]`` padded with empty bboxes.
+            recv_ring_size (int, optional): If greater than 0, each output vstream preallocates this many output
+                arrays and :func:`OutputVStream.recv` reads into them in a round robin, instead of allocating
+                a new array per frame. An array returned by ``recv`` is overwritten ``recv_ring_size`` frames later,
+                so it should be consumed (or copied) before then. Default is 0 (a new array per frame).
         """
         self._configured_network = configured_network
         self._net_group_name = configured_network.name
         self._output_vstreams_params = output_vstreams_params
         self._output_tensor_info = {}
         self._tf_nms_format = tf_nms_format
+        self._recv_ring_size = recv_ring_size
         self._vstreams = {}
 
     def __enter__(self):
@@ -2865,7 +2916,8 @@ class OutputVStreams(object):
         self._output_vstreams_holder.__enter__()
         for name, vstream in self._output_vstreams_holder.get_all_outputs().items():
             self._vstreams[name] = OutputVStream(self._configured_network, vstream, name,
-                tf_nms_format=self._tf_nms_format, net_group_name=self._net_group_name)
+                tf_nms_format=self._tf_nms_format, net_group_name=self._net_group_name,
+                recv_ring_size=self._recv_ring_size)
         return self
 
     def get(self, name=None):
@@ -539,6 +539,7 @@ PYBIND11_MODULE(_pyhailort, m) {
         .value("YYUV", HAILO_FORMAT_ORDER_HAILO_YYUV)
         .value("NV21", HAILO_FORMAT_ORDER_NV21)
         .value("YYVU", HAILO_FORMAT_ORDER_HAILO_YYVU)
+        .value("HAILO_TOP_K", HAILO_FORMAT_ORDER_HAILO_TOP_K)
         ;
 
     py::enum_<hailo_format_flags_t>(m, "FormatFlags", py::arithmetic())
@@ -719,8 +720,21 @@ PYBIND11_MODULE(_pyhailort, m) {
         .def_readwrite("buffers_threshold", &hailo_eth_input_stream_params_t::buffers_threshold)
         ;
 
+    py::enum_<hailo_stream_completion_mode_t>(m, "StreamCompletionMode")
+        .value("INTERRUPT", HAILO_STREAM_COMPLETION_MODE_INTERRUPT)
+        .value("BUSY_POLL", HAILO_STREAM_COMPLETION_MODE_BUSY_POLL)
+        ;
+
+    py::class_<hailo_vdma_output_stream_completion_params_t>(m, "VdmaOutputStreamCompletionParams")
+        .def(py::init<>())
+        .def_readwrite("completion_mode", &hailo_vdma_output_stream_completion_params_t::completion_mode)
+        .def_readwrite("busy_poll_timeout_us", &hailo_vdma_output_stream_completion_params_t::busy_poll_timeout_us)
+        .def_readwrite("transfers_per_interrupt", &hailo_vdma_output_stream_completion_params_t::transfers_per_interrupt)
+        ;
+
     py::class_<hailo_pcie_output_stream_params_t>(m, "PcieOutputStreamParams")
         .def(py::init<>())
+        .def_readwrite("completion_params", &hailo_pcie_output_stream_params_t::completion_params)
         ;
 
     py::class_<hailo_pcie_input_stream_params_t>(m, "PcieInputStreamParams")
@@ -733,6 +747,7 @@ PYBIND11_MODULE(_pyhailort, m) {
 
     py::class_<hailo_core_output_stream_params_t>(m, "CoreOutputStreamParams")
         .def(py::init<>())
+        .def_readwrite("completion_params", &hailo_core_output_stream_params_t::completion_params)
         ;
 
     py::class_<hailo_mipi_input_stream_params_t>(m, "MipiInputStreamParams")
@@ -756,6 +771,7 @@ PYBIND11_MODULE(_pyhailort, m) {
         .def_readwrite("user_buffer_format", &hailo_vstream_params_t::user_buffer_format)
         .def_readwrite("timeout_ms", &hailo_vstream_params_t::timeout_ms)
         .def_readwrite("queue_size", &hailo_vstream_params_t::queue_size)
+        .def_readwrite("top_k", &hailo_vstream_params_t::top_k)
         ;
 
     py::enum_<hailo_latency_measurement_flags_t>(m, "LatencyMeasurementFlags")
@@ -14,6 +14,8 @@
 #include "bindings_common.hpp"
 #include "utils.hpp"
 
+#include <set>
+
 
 namespace hailort
 {
@@ -23,13 +25,23 @@ void InputVStreamWrapper::add_to_python_module(py::module &m)
     py::class_<InputVStream, std::shared_ptr<InputVStream>>(m, "InputVStream")
     .def("send", [](InputVStream &self, py::array data)
     {
-        hailo_status status = self.write(
-            MemoryView(const_cast<void*>(reinterpret_cast<const void*>(data.data())), data.nbytes()));
+        // Note: data is referenced by the caller's frame for the duration of the call, so it's safe to release the GIL
+        //       while the device consumes it (allowing other Python threads to drive other vstreams/devices meanwhile).
+        MemoryView buffer(const_cast<void*>(reinterpret_cast<const void*>(data.data())), data.nbytes());
+        hailo_status status = HAILO_UNINITIALIZED;
+        {
+            py::gil_scoped_release release;
+            status = self.write(buffer);
+        }
         VALIDATE_STATUS(status);
     })
     .def("flush", [](InputVStream &self)
     {
-        hailo_status status = self.flush();
+        hailo_status status = HAILO_UNINITIALIZED;
+        {
+            py::gil_scoped_release release;
+            status = self.flush();
+        }
         VALIDATE_STATUS(status);
     })
     .def_property_readonly("info", [](InputVStream &self)
@@ -141,7 +153,11 @@ void OutputVStreamWrapper::add_to_python_module(py::module &m)
         auto buffer = Buffer::create(self.get_frame_size());
         VALIDATE_STATUS(buffer.status());
 
-        hailo_status status = self.read(MemoryView(buffer->data(), buffer->size()));
+        hailo_status status = HAILO_UNINITIALIZED;
+        {
+            py::gil_scoped_release release;
+            status = self.read(MemoryView(buffer->data(), buffer->size()));
+        }
         VALIDATE_STATUS(status);
 
         // Note: The ownership of the buffer is transferred to Python wrapped as a py::array.
@@ -151,6 +167,27 @@ void OutputVStreamWrapper::add_to_python_module(py::module &m)
         return py::array(get_dtype(self), get_shape(self), unmanaged_addr,
             py::capsule(unmanaged_addr, [](void *p) { delete reinterpret_cast<uint8_t*>(p); }));
     })
+    .def("recv_into", [](OutputVStream &self, py::array data)
+    {
+        // Reads a frame into a preallocated array, saving the per-frame buffer allocation of recv()
+        if (!(data.flags() & py::array::c_style) || !data.writeable()) {
+            LOGGER__ERROR("recv_into requires a writeable C contiguous array");
+            THROW_STATUS_ERROR(HAILO_INVALID_ARGUMENT);
+        }
+        if (self.get_frame_size() != static_cast<size_t>(data.nbytes())) {
+            LOGGER__ERROR("recv_into array size ({}) doesn't match the frame size ({}) of vstream {}",
+                data.nbytes(), self.get_frame_size(), self.name());
+            THROW_STATUS_ERROR(HAILO_INVALID_ARGUMENT);
+        }
+
+        MemoryView buffer(data.mutable_data(), data.nbytes());
+        hailo_status status = HAILO_UNINITIALIZED;
+        {
+            py::gil_scoped_release release;
+            status = self.read(buffer);
+        }
+        VALIDATE_STATUS(status);
+    })
     .def_property_readonly("info", [](OutputVStream &self)
     {
         return self.get_info();
@@ -256,10 +293,79 @@ void InferVStreamsWrapper::infer(std::map<std::string, py::array> input_data, st
             static_cast<size_t>(name_pair.second.nbytes())));
     }
 
-    hailo_status status = m_infer_pipeline->infer(input_data_c, output_data_c, batch_size);
+    hailo_status status = HAILO_UNINITIALIZED;
+    {
+        // input_data and output_data are held by this frame, so their buffers stay valid while the GIL is released
+        py::gil_scoped_release release;
+        status = m_infer_pipeline->infer(input_data_c, output_data_c, batch_size);
+    }
     VALIDATE_STATUS(status);
 }
 
+py::dict InferVStreamsWrapper::infer_batch(std::map<std::string, py::array> input_data,
+    std::map<std::string, py::array> output_data)
+{
+    // Runs a whole batch in a single call - the arrays are only validated (and outputs allocated if not given) here,
+    // and the frames are streamed through the pipeline without holding the GIL.
+    if (input_data.empty() || (0 == input_data.begin()->second.ndim())) {
+        LOGGER__ERROR("infer_batch requires input arrays with a frames dimension");
+        THROW_STATUS_ERROR(HAILO_INVALID_ARGUMENT);
+    }
+    const auto frames_count = static_cast<size_t>(input_data.begin()->second.shape(0));
+
+    std::map<std::string, MemoryView> input_data_c;
+    std::set<std::string> network_names;
+    for (auto &name_pair : input_data) {
+        auto &input_array = name_pair.second;
+        if ((0 == input_array.ndim()) || (frames_count != static_cast<size_t>(input_array.shape(0)))) {
+            LOGGER__ERROR("The number of frames of all inputs should be {} (input {})", frames_count, name_pair.first);
+            THROW_STATUS_ERROR(HAILO_INVALID_ARGUMENT);
+        }
+        if (!(input_array.flags() & py::array::c_style)) {
+            LOGGER__ERROR("Input {} is not C contiguous", name_pair.first);
+            THROW_STATUS_ERROR(HAILO_INVALID_ARGUMENT);
+        }
+        auto input = m_infer_pipeline->get_input_by_name(name_pair.first);
+        VALIDATE_EXPECTED(input);
+        network_names.insert(input->get().network_name());
+
+        input_data_c.emplace(name_pair.first, MemoryView(const_cast<void*>(input_array.data()),
+            static_cast<size_t>(input_array.nbytes())));
+    }
+
+    if (output_data.empty()) {
+        for (auto &output : m_infer_pipeline->get_output_vstreams()) {
+            if (!contains(network_names, output.get().network_name())) {
+                continue;
+            }
+            auto shape = HailoRTBindingsCommon::get_pybind_shape(output.get().get_info(), output.get().get_user_buffer_format());
+            shape.insert(shape.begin(), frames_count);
+            output_data.emplace(output.get().name(),
+                py::array(HailoRTBindingsCommon::get_dtype(output.get().get_user_buffer_format().type), shape));
+        }
+    }
+
+    std::map<std::string, MemoryView> output_data_c;
+    for (auto &name_pair : output_data) {
+        auto &output_array = name_pair.second;
+        if (!(output_array.flags() & py::array::c_style) || !output_array.writeable()) {
+            LOGGER__ERROR("Output {} is not a writeable C contiguous array", name_pair.first);
+            THROW_STATUS_ERROR(HAILO_INVALID_ARGUMENT);
+        }
+        output_data_c.emplace(name_pair.first, MemoryView(output_array.mutable_data(),
+            static_cast<size_t>(output_array.nbytes())));
+    }
+
+    hailo_status status = HAILO_UNINITIALIZED;
+    {
+        py::gil_scoped_release release;
+        status = m_infer_pipeline->infer(input_data_c, output_data_c, frames_count);
+    }
+    VALIDATE_STATUS(status);
+
+    return py::cast(output_data);
+}
+
 py::dtype InferVStreamsWrapper::get_host_dtype(const std::string &stream_name)
 {
     auto input = m_infer_pipeline->get_input_by_name(stream_name);
@@ -317,6 +423,8 @@ void InferVStreamsWrapper::add_to_python_module(py::module &m)
     .def("get_shape", &InferVStreamsWrapper::get_shape)
     .def("get_user_buffer_format", &InferVStreamsWrapper::get_user_buffer_format)
     .def("infer", &InferVStreamsWrapper::infer)
+    .def("infer_batch", &InferVStreamsWrapper::infer_batch, py::arg("input_data"),
+        py::arg("output_data") = std::map<std::string, py::array>())
     .def("release",  [](InferVStreamsWrapper &self, py::args) { self.release(); })
     ;
 }
@@ -82,6 +82,7 @@ public:
         const std::map<std::string, hailo_vstream_params_t> &output_vstreams_params);
     void infer(std::map<std::string, py::array> input_data, std::map<std::string, py::array> output_data,
         size_t batch_size);
+    py::dict infer_batch(std::map<std::string, py::array> input_data, std::map<std::string, py::array> output_data);
     py::dtype get_host_dtype(const std::string &stream_name);
     hailo_format_t get_user_buffer_format(const std::string &stream_name);
     std::vector<size_t> get_shape(const std::string &stream_name);
@@ -403,6 +403,20 @@ public:
      */
     Expected<hailo_chip_temperature_info_t> get_chip_temperature();
 
+    /**
+     * Get the temperature, a single power measurement and the throttling state of the device.
+     * The controls are sent as one batch. On ethernet devices, setting the HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS
+     * environment variable above 1 puts them in flight at the same time, so this is cheaper than calling
+     * get_chip_temperature(), power_measurement() and get_throttling_state() - e.g. in a monitoring loop. By default,
+     * ethernet controls are sent in lock step.
+     *
+     * @param[in] dvm               Which DVM will be measured, as in power_measurement().
+     * @param[in] measurement_type  The type of the power measurement, as in power_measurement().
+     * @return Upon success, returns @a hailo_device_monitoring_info_t. Otherwise, returns a ::hailo_status error.
+     */
+    Expected<hailo_device_monitoring_info_t> get_monitoring_info(hailo_dvm_options_t dvm,
+        hailo_power_measurement_types_t measurement_type);
+
     /**
      * Reset device.
      * 
@@ -17,12 +17,12 @@
 #include <vector>
 #include <array>
 #include <chrono>
+#include <atomic>
 #if defined(__GNUC__)
 #include <poll.h>
 #endif
 
 #if defined(__QNX__)
-#include <atomic>
 #include <mutex>
 
 // Forward declare neosmart::neosmart_event_t_
@@ -101,6 +101,8 @@ public:
     };
 
     using Waitable::Waitable;
+    Event(underlying_waitable_handle_t handle, const State& initial_state);
+    Event(Event&& other);
 
     static Expected<Event> create(const State& initial_state);
     static EventPtr create_shared(const State& initial_state);
@@ -109,12 +111,18 @@ public:
     virtual hailo_status signal() override;
     virtual bool is_auto_reset() override;
     hailo_status reset();
+
+    // Returns true if signal() was called since the event was last reset, without a system call.
+    // Note: signaling the underlying handle directly is not tracked.
+    bool is_signaled() const;
 #if defined(__QNX__)
     virtual void post_wait() override;
 #endif // defined (__QNX__)
 
 private:
     static underlying_waitable_handle_t open_event_handle(const State& initial_state);
+
+    std::atomic<bool> m_is_signaled {false};
 };
 
 class Semaphore;
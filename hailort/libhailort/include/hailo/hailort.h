@@ -50,6 +50,7 @@ extern "C" {
 #define HAILO_MAX_STREAMS_COUNT (32)
 #define HAILO_DEFAULT_BATCH_SIZE (0)
 #define HAILO_MAX_NETWORK_GROUPS (8)
+#define HAILO_MAX_FRAME_PLANES (2)
 #define HAILO_MAX_NETWORK_GROUP_NAME_SIZE (HAILO_MAX_NAME_SIZE)
 /* Network name is always attached to network group name with '/' separator */
 #define HAILO_MAX_NETWORK_NAME_SIZE (HAILO_MAX_NETWORK_GROUP_NAME_SIZE + 1 + HAILO_MAX_NAME_SIZE)
@@ -57,7 +58,10 @@ extern "C" {
 #define HAILO_PCIE_ANY_DOMAIN (UINT32_MAX)
 #define HAILO_DEFAULT_VSTREAM_QUEUE_SIZE (2)
 #define HAILO_DEFAULT_VSTREAM_TIMEOUT_MS (10000)
+#define HAILO_DEFAULT_VSTREAM_TOP_K (5)
 #define HAILO_DEFAULT_DEVICE_COUNT (1)
+#define HAILO_DEFAULT_BUSY_POLL_TIMEOUT_US (100)
+#define HAILO_DEFAULT_INTERRUPT_MODERATION_MAX_WAIT_MS (1)
 
 #define HAILO_SOC_ID_LENGTH (32)
 #define HAILO_ETH_MAC_LENGTH (6)
@@ -685,6 +689,16 @@ typedef enum {
      */
     HAILO_FORMAT_ORDER_RGB4                 = 17,
 
+    /**
+     * The K highest features of every pixel, supported for output streams of orders ::HAILO_FORMAT_ORDER_NHCW and
+     * ::HAILO_FORMAT_ORDER_NC:
+     * - Host side: [N, H, W, 2K], where the indices of the K highest features of each pixel (from the highest) are
+     *   followed by their values. K is half of the host shape features (set by ::hailo_vstream_params_t.top_k for
+     *   virtual streams).
+     * - Not used for device side
+     */
+    HAILO_FORMAT_ORDER_HAILO_TOP_K          = 18,
+
     /** Max enum value to maintain ABI Integrity */
     HAILO_FORMAT_ORDER_MAX_ENUM             = HAILO_MAX_ENUM
 } hailo_format_order_t;
@@ -798,14 +812,20 @@ typedef struct {
     /**
      * Stream may be rate limited by setting this member to te desired rate other than zero.
      * The limition will only effect the corresponding stream (other network traffic won't be effected).
-     * - On linux the "Traffic Control" tool will be used to limit the network rate (see `man tc`):
+     * - User-mode rate limiting (via a token-bucket) is used:
+     *   - The packets are sent in short bursts (of the data the rate allows in HAILO_ETH_INPUT_PACING_INTERVAL_USEC
+     *     microseconds, 200 by default).
+     *   - User-mode rate limiting is designed to consistently keep the stream at the desired rate, however fluctuations will occur.
+     *     This member parameter provides an upper bound on the bandwidth at which the stream will operate.
+     *   - On linux, setting HAILO_ETH_INPUT_USE_TX_TIME=1 lets the kernel pace the packets (SO_TXTIME), which requires
+     *     the "fq" qdisc on the outgoing interface (`tc qdisc replace dev <interface> root fq`).
+     * - On linux, setting HAILO_ETH_INPUT_USE_TRAFFIC_CONTROL=1 uses the "Traffic Control" tool to limit the network rate instead (see `man tc`):
      *   - This will result in external processes being created at the creation and destruction of the stream
      *   - `sudo` privileges are required.
      *   - Alternatively, use the command line tool `hailortcli udp-rate-limiter`, which is also implemented using "Traffic Control".
      *     In this case this member must be set to zero.
-     * - On Windows user-mode rate limiting (via a token-bucket) is used:
-     *   - User-mode rate limiting is designed to consistently keep the stream at the desired rate, however fluctuations will occur.
-     *     This member parameter provides an upper bound on the bandwidth at which the stream will operate.
+     * - The rates matching a desired fps can be calculated by ::hailo_calculate_eth_input_rate_limits
+     *   (or set by `hailortcli run --eth-fps`).
      */
     uint32_t rate_limit_bytes_per_sec;
 
@@ -826,9 +846,41 @@ typedef struct {
     EMPTY_STRUCT_PLACEHOLDER
 } hailo_pcie_input_stream_params_t;
 
+/** Method used to wait for transfer completions on vDMA (PCIe/core) output streams */
+typedef enum {
+    /** Block on the channel's interrupt (default) */
+    HAILO_STREAM_COMPLETION_MODE_INTERRUPT = 0,
+    /**
+     * Poll the channel's num_processed register for up to @a busy_poll_timeout_us before falling back to blocking
+     * on the channel's interrupt. Lowers the wakeup latency at the cost of CPU usage.
+     */
+    HAILO_STREAM_COMPLETION_MODE_BUSY_POLL,
+
+    /** Max enum value to maintain ABI Integrity */
+    HAILO_STREAM_COMPLETION_MODE_MAX_ENUM = HAILO_MAX_ENUM
+} hailo_stream_completion_mode_t;
+
+/**
+ * vDMA output stream (device to host) completion parameters.
+ * @note Ignored when latency measurement is enabled (the latency meter requires an interrupt per transfer).
+ */
+typedef struct {
+    hailo_stream_completion_mode_t completion_mode;
+
+    /** Max polling time for ::HAILO_STREAM_COMPLETION_MODE_BUSY_POLL (0 means HAILO_DEFAULT_BUSY_POLL_TIMEOUT_US). */
+    uint32_t busy_poll_timeout_us;
+
+    /**
+     * Interrupt moderation - the host is interrupted once every @a transfers_per_interrupt transfers
+     * (0 or 1 means an interrupt per transfer). Transfers that completed without an interrupt are collected
+     * after at most HAILO_DEFAULT_INTERRUPT_MODERATION_MAX_WAIT_MS.
+     */
+    uint16_t transfers_per_interrupt;
+} hailo_vdma_output_stream_completion_params_t;
+
 /** PCIe output stream (device to host) parameters */
 typedef struct {
-    EMPTY_STRUCT_PLACEHOLDER
+    hailo_vdma_output_stream_completion_params_t completion_params;
 } hailo_pcie_output_stream_params_t;
 
 /** Indicates amount of pixels per clock on a MIPI stream **/
@@ -1024,7 +1076,7 @@ typedef struct {
 
 /** Core output stream (device to host) parameters */
 typedef struct {
-    EMPTY_STRUCT_PLACEHOLDER
+    hailo_vdma_output_stream_completion_params_t completion_params;
 } hailo_core_output_stream_params_t;
 
 typedef enum {
@@ -1079,6 +1131,50 @@ typedef enum {
     HAILO_PIPELINE_ELEM_STATS_MAX_ENUM              = HAILO_MAX_ENUM
 } hailo_pipeline_elem_stats_flags_t;
 
+/** Format of the camera frames written to an input virtual stream with host preprocessing */
+typedef enum {
+    /** No preprocessing, the frames are written in the user buffer format */
+    HAILO_PREPROCESS_SRC_FORMAT_NONE    = 0,
+    /** Packed 8 bit RGB */
+    HAILO_PREPROCESS_SRC_FORMAT_RGB     = 1,
+    /** 8 bit Y plane followed by an interleaved UV plane, subsampled by 2 in both axes */
+    HAILO_PREPROCESS_SRC_FORMAT_NV12    = 2,
+    /** 8 bit Y plane followed by U and V planes, each subsampled by 2 in both axes */
+    HAILO_PREPROCESS_SRC_FORMAT_I420    = 3,
+    /** Packed 8 bit Y0 U Y1 V, one (U,V) pair for every 2 pixels */
+    HAILO_PREPROCESS_SRC_FORMAT_YUY2    = 4,
+
+    /** Max enum value to maintain ABI Integrity */
+    HAILO_PREPROCESS_SRC_FORMAT_MAX_ENUM = HAILO_MAX_ENUM
+} hailo_preprocess_src_format_t;
+
+/** How a camera frame is resized to the input shape of the network */
+typedef enum {
+    /** Bilinear resize of the whole frame to the network shape, ignoring the aspect ratio */
+    HAILO_PREPROCESS_RESIZE_STRETCH     = 0,
+    /** Bilinear resize keeping the aspect ratio, the frame is centered and the borders are padded */
+    HAILO_PREPROCESS_RESIZE_LETTERBOX   = 1,
+
+    /** Max enum value to maintain ABI Integrity */
+    HAILO_PREPROCESS_RESIZE_MAX_ENUM    = HAILO_MAX_ENUM
+} hailo_preprocess_resize_mode_t;
+
+/**
+ * Host preprocessing of an input virtual stream - the camera frame (YUV frames use BT.601 limited range) is converted
+ * to RGB and resized to the network's input shape, as part of the quantization and reordering of the frame.
+ */
+typedef struct {
+    /** Format of the written frames, ::HAILO_PREPROCESS_SRC_FORMAT_NONE disables the preprocessing */
+    hailo_preprocess_src_format_t src_format;
+    /** Width of the written frames (must be even for YUV formats) */
+    uint32_t src_width;
+    /** Height of the written frames (must be even for NV12/I420 frames) */
+    uint32_t src_height;
+    hailo_preprocess_resize_mode_t resize_mode;
+    /** Value of all channels of the letterbox padding */
+    uint8_t letterbox_pad_value;
+} hailo_vstream_preprocess_params_t;
+
 /** Virtual stream params */
 typedef struct {
     hailo_format_t user_buffer_format;
@@ -1086,6 +1182,13 @@ typedef struct {
     uint32_t queue_size;
     hailo_vstream_stats_flags_t vstream_stats_flags;
     hailo_pipeline_elem_stats_flags_t pipeline_elements_stats_flags;
+    /** Host preprocessing of input virtual streams (zeroed by default, i.e. disabled) */
+    hailo_vstream_preprocess_params_t preprocess_params;
+    /**
+     * The K of output virtual streams whose user_buffer_format order is ::HAILO_FORMAT_ORDER_HAILO_TOP_K, the frames
+     * read hold 2K features for every pixel. 0 selects ::HAILO_DEFAULT_VSTREAM_TOP_K.
+     */
+    uint32_t top_k;
 } hailo_vstream_params_t;
 
 /** Input virtual stream parameters */
@@ -1113,6 +1216,21 @@ typedef struct {
     uint32_t features;
 } hailo_3d_image_shape_t;
 
+/**
+ * Memory layout of a host frame that isn't tightly packed, e.g. a decoder's frame with padded rows, or a region of
+ * interest inside a bigger frame. The size of the region is the (host) image shape of the frame's stream.
+ */
+typedef struct {
+    /** Offset in bytes of each plane from the start of the buffer (single plane formats use only the first entry) */
+    size_t plane_offsets[HAILO_MAX_FRAME_PLANES];
+    /** Distance in bytes between the starts of two consecutive rows of each plane */
+    size_t row_pitches[HAILO_MAX_FRAME_PLANES];
+    /** Column of the top left pixel of the region of interest (must be even for NV12/NV21 frames) */
+    uint32_t roi_x;
+    /** Row of the top left pixel of the region of interest (must be even for NV12/NV21 frames) */
+    uint32_t roi_y;
+} hailo_frame_layout_t;
+
 typedef struct {
     uint32_t class_group_index;
     char original_name[HAILO_MAX_STREAM_NAME_SIZE];
@@ -1478,6 +1596,13 @@ typedef struct {
     uint32_t requested_temperature_clock_freq;
 } hailo_health_info_t;
 
+/** Device state sampled by ::hailo_get_device_monitoring_info */
+typedef struct {
+    hailo_chip_temperature_info_t temperature_info;
+    float32_t power_measurement;
+    bool throttling_active;
+} hailo_device_monitoring_info_t;
+
 typedef struct {
     void* buffer;
     size_t size;
@@ -1877,6 +2002,22 @@ HAILORTAPI hailo_status hailo_get_device_id(hailo_device device, hailo_device_id
  */
 HAILORTAPI hailo_status hailo_get_chip_temperature(hailo_device device, hailo_chip_temperature_info_t *temp_info);
 
+/**
+ * Get the temperature, a single power measurement and the throttling state of the device.
+ * The controls are sent as one batch. On ethernet devices, setting the HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS
+ * environment variable above 1 puts them in flight at the same time, so this is cheaper than ::hailo_get_chip_temperature,
+ * ::hailo_power_measurement and a throttling state query one after the other. By default, ethernet controls are sent
+ * in lock step.
+ *
+ * @param[in]  device             A ::hailo_device object.
+ * @param[in]  dvm                Which DVM will be measured, as in ::hailo_power_measurement.
+ * @param[in]  measurement_type   The type of the power measurement, as in ::hailo_power_measurement.
+ * @param[out] monitoring_info    A @a hailo_device_monitoring_info_t to be filled.
+ * @return Upon success, returns ::HAILO_SUCCESS. Otherwise, returns a ::hailo_status error.
+ */
+HAILORTAPI hailo_status hailo_get_device_monitoring_info(hailo_device device, hailo_dvm_options_t dvm,
+    hailo_power_measurement_types_t measurement_type, hailo_device_monitoring_info_t *monitoring_info);
+
 /**
  * Reset device
  * 
@@ -26,7 +26,9 @@
 #include "hailo/event.hpp"
 #include "hailo/hailort_common.hpp"
 #include "hailo/runtime_statistics.hpp"
+#include "hailo/metrics.hpp"
 #include "hailo/network_rate_calculator.hpp"
+#include "hailo/network_group_tuner.hpp"
 #include "hailo/quantization.hpp"
 
 #endif /* _HAILORT_HPP_ */
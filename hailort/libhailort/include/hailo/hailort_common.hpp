@@ -201,6 +201,8 @@ public:
             return "YYVU";
         case HAILO_FORMAT_ORDER_RGB4:
             return "RGB4";
+        case HAILO_FORMAT_ORDER_HAILO_TOP_K:
+            return "HAILO TOP K";
         default:
             return "Nan";
         }
@@ -86,15 +86,11 @@ public:
     InferVStreams(const InferVStreams &other) = delete;
     InferVStreams &operator=(const InferVStreams &other) = delete;
     InferVStreams &operator=(InferVStreams &&other) = delete;
-    InferVStreams(InferVStreams &&other) :
-        m_inputs(std::move(other.m_inputs)),
-        m_outputs(std::move(other.m_outputs)),
-        m_is_multi_context(std::move(other.m_is_multi_context)),
-        m_network_name_to_input_count(std::move(other.m_network_name_to_input_count)),
-        m_network_name_to_output_count(std::move(other.m_network_name_to_output_count)),
-        m_batch_size(std::move(other.m_batch_size))
-        {};
+    InferVStreams(InferVStreams &&other);
+    ~InferVStreams();
 private:
+    class VStreamWorker;
+
     InferVStreams(std::vector<InputVStream> &&inputs, std::vector<OutputVStream> &&outputs, bool is_multi_context, uint16_t batch_size);
     hailo_status verify_network_inputs_and_outputs(const std::map<std::string, MemoryView>& inputs_name_mem_view_map,
                                                    const std::map<std::string, MemoryView>& outputs_name_mem_view_map);
@@ -102,6 +98,7 @@ private:
                                          const std::map<std::string, MemoryView>& outputs_name_mem_view_map,
                                          size_t frames_count);
     hailo_status verify_frames_count(size_t frames_count);
+    Expected<std::reference_wrapper<VStreamWorker>> get_worker(const std::string &vstream_name);
 
     std::vector<InputVStream> m_inputs;
     std::vector<OutputVStream> m_outputs;
@@ -109,6 +106,8 @@ private:
     std::map<std::string, size_t> m_network_name_to_input_count;
     std::map<std::string, size_t> m_network_name_to_output_count;
     uint16_t m_batch_size;
+    // Threads running the reads/writes of each vstream in infer(), kept alive between calls
+    std::map<std::string, std::unique_ptr<VStreamWorker>> m_workers;
 };
 
 } /* namespace hailort */
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics.hpp
+ * @brief In-process metrics registry, exported in the OpenMetrics text format
+ *
+ * Runtime components (vstreams, the scheduler, device monitors) publish counters, gauges and histograms
+ * to the process wide MetricsRegistry. Updating a metric is a lock free atomic operation, so it is cheap
+ * enough to be done on every frame. MetricsRegistry::serialize() renders all live metrics as OpenMetrics text,
+ * suitable for a Prometheus scrape.
+ **/
+
+#ifndef _HAILO_METRICS_HPP_
+#define _HAILO_METRICS_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hailort
+{
+
+/** Label names to label values, e.g. {{"network", "yolov5m/yolov5m"}} */
+using MetricLabels = std::map<std::string, std::string>;
+
+/** A monotonically increasing value (e.g. number of frames) */
+class HAILORTAPI MetricCounter final
+{
+public:
+    MetricCounter() : m_value(0) {}
+    MetricCounter(const MetricCounter &) = delete;
+    MetricCounter &operator=(const MetricCounter &) = delete;
+
+    void inc(uint64_t amount = 1)
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> m_value;
+};
+
+/** A value that can go up and down (e.g. queue size, temperature) */
+class HAILORTAPI MetricGauge final
+{
+public:
+    MetricGauge() : m_value(0) {}
+    MetricGauge(const MetricGauge &) = delete;
+    MetricGauge &operator=(const MetricGauge &) = delete;
+
+    void set(double value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    void add(double amount);
+
+    double value() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> m_value;
+};
+
+/** Snapshot of a histogram, as returned by MetricHistogram::snapshot */
+struct MetricHistogramSnapshot
+{
+    std::vector<double> upper_bounds;
+    // Non-cumulative count per bucket. The last entry is the +Inf bucket.
+    std::vector<uint64_t> bucket_counts;
+    uint64_t count;
+    double sum;
+};
+
+/** Distribution of observed values over fixed buckets (e.g. latency in seconds) */
+class HAILORTAPI MetricHistogram final
+{
+public:
+    /**
+     * Creates a histogram with the given bucket upper bounds.
+     *
+     * @param[in] upper_bounds      Strictly increasing bucket upper bounds. The +Inf bucket is implicit.
+     * @return Upon success, returns Expected of a shared pointer to Histogram.
+     *         Otherwise, returns Unexpected of ::hailo_status error.
+     */
+    static Expected<std::shared_ptr<MetricHistogram>> create(const std::vector<double> &upper_bounds);
+
+    /**
+     * @return Bucket upper bounds (in seconds) suitable for inference latencies - 100us up to 10s.
+     */
+    static std::vector<double> default_latency_buckets();
+
+    MetricHistogram(std::vector<double> &&upper_bounds);
+    MetricHistogram(const MetricHistogram &) = delete;
+    MetricHistogram &operator=(const MetricHistogram &) = delete;
+
+    void observe(double value);
+    MetricHistogramSnapshot snapshot() const;
+
+private:
+    const std::vector<double> m_upper_bounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_bucket_counts;
+    std::atomic<double> m_sum;
+};
+
+/**
+ * Interface for components whose metrics are cheaper to sample at scrape time than to update on the fast path.
+ * collect() is called by MetricsRegistry::serialize() before the metrics are rendered.
+ */
+class HAILORTAPI MetricsCollector
+{
+public:
+    virtual ~MetricsCollector() = default;
+    virtual void collect() = 0;
+};
+
+/**
+ * Process wide metrics registry.
+ * The registry only holds weak references to the metrics - a metric is exported as long as its creator keeps it alive.
+ */
+class HAILORTAPI MetricsRegistry final
+{
+public:
+    static MetricsRegistry &get_instance();
+
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    /**
+     * Creates a counter, or returns the existing counter with the same name and labels.
+     *
+     * @param[in] name      Metric family name, without the "_total" suffix.
+     * @param[in] help      Description of the metric family.
+     * @param[in] labels    Labels identifying this instance of the family.
+     * @return Upon success, returns Expected of a shared pointer to MetricCounter.
+     *         Otherwise, returns Unexpected of ::hailo_status error. ::HAILO_INVALID_ARGUMENT is returned if
+     *         @a name is already registered as a different metric type.
+     */
+    Expected<std::shared_ptr<MetricCounter>> get_counter(const std::string &name, const std::string &help,
+        const MetricLabels &labels = {});
+
+    /**
+     * Creates a gauge, or returns the existing gauge with the same name and labels.
+     * See get_counter for the parameters and return values.
+     */
+    Expected<std::shared_ptr<MetricGauge>> get_gauge(const std::string &name, const std::string &help,
+        const MetricLabels &labels = {});
+
+    /**
+     * Creates a histogram, or returns the existing histogram with the same name and labels.
+     * See get_counter for the parameters and return values.
+     *
+     * @param[in] upper_bounds      Bucket upper bounds, used only when a new histogram is created.
+     */
+    Expected<std::shared_ptr<MetricHistogram>> get_histogram(const std::string &name, const std::string &help,
+        const MetricLabels &labels = {}, const std::vector<double> &upper_bounds = MetricHistogram::default_latency_buckets());
+
+    /**
+     * Registers a collector. The registry holds a weak reference, the collector is dropped once it expires.
+     */
+    void add_collector(std::weak_ptr<MetricsCollector> collector);
+
+    /**
+     * @return All live metrics, in the OpenMetrics text exposition format (terminated by "# EOF").
+     */
+    std::string serialize();
+
+private:
+    MetricsRegistry() = default;
+
+    enum class MetricType {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct MetricFamily {
+        MetricType type;
+        std::string help;
+        std::map<MetricLabels, std::weak_ptr<void>> metrics;
+    };
+
+    template<typename T>
+    Expected<std::shared_ptr<T>> get_metric(MetricType type, const std::string &name, const std::string &help,
+        const MetricLabels &labels, std::function<Expected<std::shared_ptr<T>>()> create_func);
+
+    std::mutex m_mutex;
+    std::map<std::string, MetricFamily> m_families;
+    std::vector<std::weak_ptr<MetricsCollector>> m_collectors;
+};
+
+} /* namespace hailort */
+
+#endif /* _HAILO_METRICS_HPP_ */
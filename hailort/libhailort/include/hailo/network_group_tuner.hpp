@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file network_group_tuner.hpp
+ * @brief Automatic tuning of the batch size and the scheduler parameters of network groups.
+ * The tuner sweeps the batch sizes, scheduler thresholds and scheduler timeouts of a set of HEFs running together on a
+ * scheduled VDevice, measures the fps, the p99 latency and the power of every combination (a trial), and recommends
+ * the configuration with the best fps within the latency bound. The recommended configuration can be saved to a
+ * config file, which is loaded by `hailortcli run2 --config` and by applications (see NetworkGroupTuner::configure).
+ **/
+
+#ifndef _HAILO_NETWORK_GROUP_TUNER_HPP_
+#define _HAILO_NETWORK_GROUP_TUNER_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+#include "hailo/network_group.hpp"
+#include "hailo/vdevice.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hailort
+{
+
+/** The tuned parameters of a single network group */
+struct TunedNetworkGroupParams
+{
+    std::string hef_path;
+    std::string network_group_name;
+    uint16_t batch_size;
+    uint32_t scheduler_threshold;
+    std::chrono::milliseconds scheduler_timeout;
+};
+
+/** The parameters of a tuning sweep */
+struct NetworkGroupTunerParams
+{
+    /** The batch sizes to try. A trial is run for every combination of batch size, threshold and timeout. */
+    std::vector<uint16_t> batch_sizes;
+    /** The scheduler thresholds to try. Thresholds above the trial's batch size are skipped. */
+    std::vector<uint32_t> scheduler_thresholds;
+    std::vector<std::chrono::milliseconds> scheduler_timeouts;
+
+    /** The time the network groups run with the trial's parameters before they are measured. */
+    std::chrono::milliseconds warmup_duration;
+    std::chrono::milliseconds trial_duration;
+
+    /** The maximal p99 latency of the recommended configuration (of every network group). 0 means unbounded. */
+    std::chrono::milliseconds max_p99_latency;
+    /** Measure the power of the physical devices during each trial. */
+    bool measure_power;
+};
+
+/** The measurements of a single network group during a trial */
+struct NetworkGroupTrialResult
+{
+    std::string network_group_name;
+    double fps;
+    /** The p99 of the time from writing a frame to reading its first output, or NaN if no frame was read. */
+    double p99_latency_ms;
+};
+
+/** The measurements of a single trial */
+struct NetworkGroupTunerTrial
+{
+    uint16_t batch_size;
+    uint32_t scheduler_threshold;
+    std::chrono::milliseconds scheduler_timeout;
+
+    std::vector<NetworkGroupTrialResult> network_groups;
+    /** The sum of the fps of all network groups. */
+    double total_fps;
+    /** The worst p99 latency of all network groups. */
+    double max_p99_latency_ms;
+    /** The sum of the average power of all physical devices, or NaN if the power wasn't measured. */
+    double power_watts;
+    bool meets_latency_bound;
+};
+
+/** The result of a tuning sweep */
+struct NetworkGroupTunerResult
+{
+    std::vector<NetworkGroupTunerTrial> trials;
+    size_t recommended_trial_index;
+    /** The recommended parameters of every network group (in the order they were configured). */
+    std::vector<TunedNetworkGroupParams> recommended_params;
+};
+
+class HAILORTAPI NetworkGroupTuner final
+{
+public:
+    using TrialCallback = std::function<void(const NetworkGroupTunerTrial &trial)>;
+
+    /**
+     * @return The default parameters of a tuning sweep.
+     * @note When libhailort is built for the emulator, the default sweep is smaller and its trials are longer.
+     */
+    static NetworkGroupTunerParams get_default_params();
+
+    /**
+     * Sweeps the batch sizes and scheduler parameters of all of the network groups in @a hef_paths.
+     * For every trial, a VDevice is created and all of the network groups are configured on it with the trial's
+     * batch size and scheduler parameters (which can't be changed once frames were sent), and run continuously.
+     * The network groups are measured after the warmup duration.
+     *
+     * @param[in] hef_paths           The HEFs to tune. All of their network groups run together.
+     * @param[in] params              The parameters of the sweep.
+     * @param[in] vdevice_params      The parameters of the VDevice the trials run on. Its scheduling_algorithm must
+     *                                not be ::HAILO_SCHEDULING_ALGORITHM_NONE.
+     * @param[in] trial_callback      Called after every trial (e.g. to report progress). May be empty.
+     * @return Upon success, returns Expected of the trials and the recommended configuration.
+     *         Otherwise, returns Unexpected of ::hailo_status error.
+     * @note The recommended trial has the highest total fps among the trials within the latency bound. Trials whose
+     *       fps is within 1% of it are considered equal, and the one with the lower power (or latency, if the power
+     *       wasn't measured) is chosen. If no trial is within the bound, the trial with the lowest latency is chosen.
+     * @note The same batch size and scheduler parameters are applied to all of the network groups in a trial.
+     */
+    static Expected<NetworkGroupTunerResult> tune(const std::vector<std::string> &hef_paths,
+        const NetworkGroupTunerParams &params, const hailo_vdevice_params_t &vdevice_params,
+        const TrialCallback &trial_callback = TrialCallback());
+
+    /**
+     * Saves @a tuned_params to a (JSON) config file.
+     *
+     * @param[in] tuned_params      The parameters of the network groups.
+     * @param[in] config_path       The path of the config file.
+     * @return Upon success, returns ::HAILO_SUCCESS. Otherwise, returns a ::hailo_status error.
+     */
+    static hailo_status save_config(const std::vector<TunedNetworkGroupParams> &tuned_params, const std::string &config_path);
+
+    /**
+     * Loads the parameters of the network groups from a config file saved by save_config().
+     *
+     * @param[in] config_path       The path of the config file.
+     * @return Upon success, returns Expected of the parameters of the network groups.
+     *         Otherwise, returns Unexpected of ::hailo_status error.
+     */
+    static Expected<std::vector<TunedNetworkGroupParams>> load_config(const std::string &config_path);
+
+    /**
+     * Configures the network groups on @a vdevice, with their batch size and scheduler parameters.
+     *
+     * @param[in] vdevice           The VDevice to configure. Should have scheduling enabled.
+     * @param[in] tuned_params      The parameters of the network groups (e.g. loaded with load_config()).
+     * @return Upon success, returns Expected of the configured network groups, in the order of @a tuned_params.
+     *         Otherwise, returns Unexpected of ::hailo_status error.
+     */
+    static Expected<std::vector<std::shared_ptr<ConfiguredNetworkGroup>>> configure(VDevice &vdevice,
+        const std::vector<TunedNetworkGroupParams> &tuned_params);
+
+    NetworkGroupTuner() = delete;
+};
+
+} /* namespace hailort */
+
+#endif /* _HAILO_NETWORK_GROUP_TUNER_HPP_ */
@@ -15,6 +15,9 @@
 
 #include <type_traits>
 #include <memory>
+#include <map>
+#include <string>
+#include <vector>
 
 namespace hailort
 {
@@ -25,14 +28,15 @@ class AccumulatorResults final
 public:
     AccumulatorResults(const Expected<size_t> &count, const Expected<double> &min, const Expected<double> &max,
                        const Expected<double> &mean, const Expected<double> &var, const Expected<double> &sd,
-                       const Expected<double> &mean_sd) :
+                       const Expected<double> &mean_sd, const std::map<double, double> &percentiles = {}) :
         m_count(count),
         m_min(min),
         m_max(max),
         m_mean(mean),
         m_var(var),
         m_sd(sd),
-        m_mean_sd(mean_sd)
+        m_mean_sd(mean_sd),
+        m_percentiles(percentiles)
     {}
 
     AccumulatorResults(AccumulatorResults &&) = default;
@@ -82,6 +86,26 @@ public:
      */
     Expected<double> mean_sd() const { return m_mean_sd; }
 
+    /**
+     * @param[in] percentile    One of AccumulatorResults::reported_percentiles() (e.g. 99.9).
+     * @return Returns Expected of the given percentile of the values added to the Accumulator,
+     *         or Unexpected of ::HAILO_NOT_AVAILABLE if the Accumulator doesn't track the distribution of its values
+     *         (or if no data has been added).
+     */
+    Expected<double> percentile(double percentile) const
+    {
+        const auto iter = m_percentiles.find(percentile);
+        if (m_percentiles.end() == iter) {
+            return make_unexpected(HAILO_NOT_AVAILABLE);
+        }
+        return Expected<double>(iter->second);
+    }
+
+    /**
+     * @return The percentiles reported by Accumulator implementations that track the distribution of their values.
+     */
+    static std::vector<double> reported_percentiles() { return {50.0, 90.0, 99.0, 99.9}; }
+
 private:
     const Expected<size_t> m_count;
     const Expected<double> m_min;
@@ -90,6 +114,7 @@ private:
     const Expected<double> m_var;
     const Expected<double> m_sd;
     const Expected<double> m_mean_sd;
+    const std::map<double, double> m_percentiles;
 };
 
 /*! The Accumulator interface supports the measurement of various statistics incrementally. I.e. upon each addition of
@@ -183,6 +208,18 @@ public:
      */
     virtual Expected<double> mean_sd() const = 0;
 
+    /**
+     * @param[in] percentile    The requested percentile, in the range [0, 100].
+     * @return Returns Expected of the given percentile of the values added to the Accumulator,
+     *         or Unexpected of ::HAILO_NOT_AVAILABLE if the Accumulator doesn't track the distribution of its values
+     *         (or if no data has been added).
+     */
+    virtual Expected<double> percentile(double percentile) const
+    {
+        (void)percentile;
+        return make_unexpected(HAILO_NOT_AVAILABLE);
+    }
+
 private:
     const std::string m_data_type;
 };
@@ -77,6 +77,20 @@ public:
      */
     hailo_status transform(const MemoryView src, MemoryView dst);
 
+    /**
+     * Transforms an input frame that isn't tightly packed (e.g. with padded rows, or a region of interest inside a
+     * bigger frame), referred by @a src, directly to the buffer referred by @a dst.
+     * 
+     * @param[in]  src          A buffer containing the src frame to be transformed.
+     * @param[in]  src_layout   The layout of the src frame inside @a src. The size of the region of interest is the
+     *                          src image shape of the transform_context.
+     * @param[out] dst          A dst buffer that receives the transformed data.
+     * @return Upon success, returns ::HAILO_SUCCESS. Otherwise, returns a ::hailo_status error.
+     * @note The layout is applied while the data is quantized/reordered (without packing the frame first). It is
+     *       supported for row based formats (e.g. NHWC, RGB4, NV12), and isn't supported with transposing.
+     */
+    hailo_status transform(const MemoryView src, const hailo_frame_layout_t &src_layout, MemoryView dst);
+
     /**
      * @return The size of the src frame on the host side in bytes.
      */
@@ -123,8 +137,11 @@ private:
 
     hailo_status transform_inner(const void *src_ptr, void *quant_buffer, void *dst_ptr, 
         MemoryView transpose_buffer);
+    hailo_status transform_quantized(const void *src_ptr, const hailo_format_t &quantized_src_format, void *dst_ptr,
+        MemoryView transpose_buffer);
 
     hailo_status quantize_stream(const void *src_ptr, void *quant_buffer);
+    hailo_status quantize_stream(const void *src_ptr, void *quant_buffer, uint32_t elements_count);
 
     const size_t m_src_frame_size;
     const hailo_3d_image_shape_t m_src_image_shape;
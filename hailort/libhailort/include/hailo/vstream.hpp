@@ -45,6 +45,57 @@ public:
      */
     hailo_status write(const MemoryView &buffer);
 
+    /**
+     * Writes a frame that isn't tightly packed (e.g. a decoder's frame with padded rows, or a region of interest
+     * inside a bigger frame) to hailo device.
+     *
+     * @param[in] buffer            The buffer containing the frame. The frame's format can be obtained by
+     *                              get_user_buffer_format().
+     * @param[in] layout            The layout of the frame inside @a buffer. The size of the region of interest is
+     *                              get_info().shape.
+     * @return Upon success, returns ::HAILO_SUCCESS. Otherwise, returns a ::hailo_status error.
+     * @note If the vstream transforms the data, the layout is applied while transforming it (without an extra copy).
+     *       Otherwise, the frame is packed before it is sent.
+     */
+    hailo_status write(const MemoryView &buffer, const hailo_frame_layout_t &layout);
+
+    /**
+     * Writes @a buffer to hailo device, only if it doesn't have to wait for space in the vstream's pipeline.
+     *
+     * @param[in] buffer            The buffer containing the data to be sent to device.
+     *                              The buffer's format can be obtained by get_user_buffer_format(),
+     *                              and the buffer's shape can be obtained by calling get_info().shape.
+     * @return Upon success, returns ::HAILO_SUCCESS. If there is no space in the vstream's pipeline, returns ::HAILO_TIMEOUT
+     *         (and the buffer isn't written). Otherwise, returns a ::hailo_status error.
+     * @note Supported only for vstreams that transform the data (i.e. that have a queue in their pipeline).
+     */
+    hailo_status try_write(const MemoryView &buffer);
+
+    /**
+     * Gets an event that is signaled while there is space for writing a frame (i.e. try_write() won't return ::HAILO_TIMEOUT).
+     * The event's underlying handle can be polled by an external event loop (e.g. using epoll on Linux), so a single thread
+     * can serve many vstreams.
+     *
+     * @return Upon success, returns Expected of the readiness event. Otherwise, returns Unexpected of ::hailo_status error.
+     * @note The event might be signaled spuriously, and it shouldn't be signaled or reset by the user.
+     * @note Supported only for vstreams that transform the data (i.e. that have a queue in their pipeline).
+     */
+    Expected<EventPtr> get_readiness_event();
+
+    /**
+     * Waits until one of @a vstreams is ready for writing (see get_readiness_event()), or until one of them is shut down
+     * (e.g. aborted, in which case writing to it will fail without blocking).
+     *
+     * @param[in] vstreams            The vstreams to wait on.
+     * @param[in] timeout             The maximum time to wait.
+     * @return Upon success, returns Expected of the index of a ready vstream in @a vstreams. If none of the vstreams is ready
+     *         before the timeout expires, returns Unexpected of ::HAILO_TIMEOUT. Otherwise, returns Unexpected of ::hailo_status error.
+     * @note When a few of the vstreams are ready, the one returned is rotated between calls, so a vstream that is always
+     *       ready doesn't starve the others.
+     */
+    static Expected<size_t> wait_for_any(std::vector<std::reference_wrapper<InputVStream>> &vstreams,
+        std::chrono::milliseconds timeout);
+
     /**
      * Flushes the vstream pipeline buffers. This will block until the vstream pipeline is clear.
      *
@@ -193,6 +244,43 @@ public:
      */
     hailo_status read(MemoryView buffer);
 
+    /**
+     * Reads data from hailo device into @a buffer, only if a frame is ready in the vstream's pipeline.
+     *
+     * @param[in] buffer            The buffer to read data into.
+     *                              The buffer's format can be obtained by get_user_buffer_format(), 
+     *                              and the buffer's shape can be obtained by calling get_info().shape.
+     * @return Upon success, returns ::HAILO_SUCCESS. If there is no frame ready, returns ::HAILO_TIMEOUT.
+     *         Otherwise, returns a ::hailo_status error.
+     * @note Supported only for vstreams that transform the data (i.e. that have a queue in their pipeline).
+     */
+    hailo_status try_read(MemoryView buffer);
+
+    /**
+     * Gets an event that is signaled while a frame is ready for reading (i.e. try_read() won't return ::HAILO_TIMEOUT).
+     * The event's underlying handle can be polled by an external event loop (e.g. using epoll on Linux), so a single thread
+     * can serve many vstreams.
+     *
+     * @return Upon success, returns Expected of the readiness event. Otherwise, returns Unexpected of ::hailo_status error.
+     * @note The event might be signaled spuriously, and it shouldn't be signaled or reset by the user.
+     * @note Supported only for vstreams that transform the data (i.e. that have a queue in their pipeline).
+     */
+    Expected<EventPtr> get_readiness_event();
+
+    /**
+     * Waits until one of @a vstreams is ready for reading (see get_readiness_event()), or until one of them is shut down
+     * (e.g. aborted, in which case reading from it will fail without blocking).
+     *
+     * @param[in] vstreams            The vstreams to wait on.
+     * @param[in] timeout             The maximum time to wait.
+     * @return Upon success, returns Expected of the index of a ready vstream in @a vstreams. If none of the vstreams is ready
+     *         before the timeout expires, returns Unexpected of ::HAILO_TIMEOUT. Otherwise, returns Unexpected of ::hailo_status error.
+     * @note When a few of the vstreams are ready, the one returned is rotated between calls, so a vstream that is always
+     *       ready doesn't starve the others.
+     */
+    static Expected<size_t> wait_for_any(std::vector<std::reference_wrapper<OutputVStream>> &vstreams,
+        std::chrono::milliseconds timeout);
+
     /**
      * Clears the vstreams' pipeline buffers.
      *
@@ -22,6 +22,12 @@ static uint8_t pack_vdma_channel_id(const vdma::ChannelId &channel_id)
         (channel_id.engine_index << CONTEXT_SWITCH_DEFS__PACKED_VDMA_CHANNEL_ID__ENGINE_INDEX_SHIFT));
 }
 
+template<typename ParamsType>
+static size_t host_buffer_info_offset()
+{
+    return sizeof(CONTROL_PROTOCOL__ACTION_HEADER_t) + offsetof(ParamsType, host_buffer_info);
+}
+
 static uint8_t pack_lcu_id(uint8_t cluster_index, uint8_t lcu_index)
 {
     return static_cast<uint8_t>(lcu_index |
@@ -60,6 +66,11 @@ Expected<std::vector<Buffer>> ContextSwitchConfigAction::serialize(const Context
     return buffers;
 }
 
+Expected<size_t> ContextSwitchConfigAction::get_host_buffer_info_offset() const
+{
+    return make_unexpected(HAILO_NOT_FOUND);
+}
+
 ContextSwitchConfigAction::Type ContextSwitchConfigAction::get_type() const
 {
     return m_type;
@@ -143,6 +154,11 @@ Expected<Buffer> ActivateConfigChannelAction::serialize_params(const ContextReso
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateConfigChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_cfg_channel_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> DeactivateConfigChannelAction::create(uint8_t config_stream_index,
     const vdma::ChannelId &channel_id)
 {
@@ -175,17 +191,17 @@ Expected<Buffer> DeactivateConfigChannelAction::serialize_params(const ContextRe
 }
 
 Expected<ContextSwitchConfigActionPtr> WriteDataCcwAction::create(
-    Buffer &&data, uint8_t config_stream_index)
+    const MemoryView &data, uint8_t config_stream_index)
 {
     auto result = ContextSwitchConfigActionPtr(new (std::nothrow) WriteDataCcwAction(
-        std::move(data), config_stream_index));
+        data, config_stream_index));
     CHECK_AS_EXPECTED((nullptr != result), HAILO_OUT_OF_HOST_MEMORY);
     return result;
 }
 
-WriteDataCcwAction::WriteDataCcwAction(Buffer &&data, uint8_t config_stream_index) :
+WriteDataCcwAction::WriteDataCcwAction(const MemoryView &data, uint8_t config_stream_index) :
     ContextSwitchConfigAction(Type::WriteDataCcw),
-    m_data(std::move(data)),
+    m_data(data),
     m_config_stream_index(config_stream_index)
 {}
 
@@ -820,6 +836,11 @@ Expected<Buffer> OpenBoundaryInputChannelAction::serialize_params(const ContextR
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> OpenBoundaryInputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__open_boundary_input_channel_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> OpenBoundaryOutputChannelAction::create(const vdma::ChannelId &channel_id,
     const CONTROL_PROTOCOL__host_buffer_info_t &host_buffer_info)
 {
@@ -851,6 +872,11 @@ Expected<Buffer> OpenBoundaryOutputChannelAction::serialize_params(const Context
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> OpenBoundaryOutputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__open_boundary_output_channel_data_t>();
+}
+
 // TODO HRT-8705: remove nn_stream_config struct (that this function won't be needed)
 static CONTEXT_SWITCH_DEFS__stream_reg_info_t parse_nn_config(const CONTROL_PROTOCOL__nn_stream_config_t &nn_config)
 {
@@ -904,6 +930,11 @@ Expected<Buffer> ActivateBoundaryInputChannelAction::serialize_params(const Cont
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateBoundaryInputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_boundary_input_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> ActivateBoundaryOutputChannelAction::create(const vdma::ChannelId &channel_id,
     uint8_t stream_index, const CONTROL_PROTOCOL__nn_stream_config_t &nn_stream_config,
     const CONTROL_PROTOCOL__host_buffer_info_t &host_buffer_info)
@@ -941,6 +972,11 @@ Expected<Buffer> ActivateBoundaryOutputChannelAction::serialize_params(const Con
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateBoundaryOutputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_boundary_output_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> ActivateInterContextInputChannelAction::create(const vdma::ChannelId &channel_id,
     uint8_t stream_index, const CONTROL_PROTOCOL__nn_stream_config_t &nn_stream_config,
     const CONTROL_PROTOCOL__host_buffer_info_t &host_buffer_info, uint32_t initial_credit_size)
@@ -980,6 +1016,11 @@ Expected<Buffer> ActivateInterContextInputChannelAction::serialize_params(const
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateInterContextInputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_inter_context_input_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> ActivateInterContextOutputChannelAction::create(const vdma::ChannelId &channel_id,
     uint8_t stream_index, uint8_t network_index, const CONTROL_PROTOCOL__nn_stream_config_t &nn_stream_config,
     const CONTROL_PROTOCOL__host_buffer_info_t &host_buffer_info)
@@ -1019,6 +1060,11 @@ Expected<Buffer> ActivateInterContextOutputChannelAction::serialize_params(const
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateInterContextOutputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_inter_context_output_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> ActivateDdrInputChannelAction::create(const vdma::ChannelId &channel_id,
     uint8_t stream_index, const CONTROL_PROTOCOL__nn_stream_config_t &nn_stream_config,
     const CONTROL_PROTOCOL__host_buffer_info_t &host_buffer_info, uint32_t initial_credit_size,
@@ -1062,6 +1108,11 @@ Expected<Buffer> ActivateDdrInputChannelAction::serialize_params(const ContextRe
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateDdrInputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_ddr_buffer_input_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> ActivateDdrOutputChannelAction::create(const vdma::ChannelId &channel_id,
     uint8_t stream_index, const CONTROL_PROTOCOL__nn_stream_config_t &nn_stream_config,
     const CONTROL_PROTOCOL__host_buffer_info_t &host_buffer_info, uint32_t buffered_rows_count)
@@ -1101,6 +1152,11 @@ Expected<Buffer> ActivateDdrOutputChannelAction::serialize_params(const ContextR
     return Buffer::create(reinterpret_cast<uint8_t*>(&params), sizeof(params));
 }
 
+Expected<size_t> ActivateDdrOutputChannelAction::get_host_buffer_info_offset() const
+{
+    return host_buffer_info_offset<CONTEXT_SWITCH_DEFS__activate_ddr_buffer_output_data_t>();
+}
+
 Expected<ContextSwitchConfigActionPtr> ValidateChannelAction::create(const vdma::ChannelId &channel_id,
     hailo_stream_direction_t stream_direction, bool is_inter_context,
     CONTROL_PROTOCOL__HOST_BUFFER_TYPE_t host_buffer_type, uint32_t initial_credit_size)
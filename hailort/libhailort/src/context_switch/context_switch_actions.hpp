@@ -81,6 +81,9 @@ public:
         bool is_repeated=false) const;
 
     virtual bool supports_repeated_block() const = 0;
+    // Actions that refer to a host buffer return the offset of its CONTROL_PROTOCOL__host_buffer_info_t in the
+    // serialized action. The info holds the dma address of a descriptors list allocated by this process.
+    virtual Expected<size_t> get_host_buffer_info_offset() const;
     Type get_type() const;
     CONTEXT_SWITCH_DEFS__ACTION_TYPE_t get_action_list_type() const;
 
@@ -122,6 +125,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateConfigChannelAction(uint8_t config_stream_index, const vdma::ChannelId &channel_id,
@@ -150,7 +154,8 @@ private:
 class WriteDataCcwAction : public ContextSwitchConfigAction
 {
 public:
-    static Expected<ContextSwitchConfigActionPtr> create(Buffer &&data, uint8_t config_stream_index);
+    // Note: data isn't copied, it must outlive the action (it references the hef's proto)
+    static Expected<ContextSwitchConfigActionPtr> create(const MemoryView &data, uint8_t config_stream_index);
     WriteDataCcwAction(WriteDataCcwAction &&) = default;
     WriteDataCcwAction(const WriteDataCcwAction &) = delete;
     WriteDataCcwAction &operator=(WriteDataCcwAction &&) = delete;
@@ -163,12 +168,12 @@ public:
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
 
     uint8_t config_stream_index() const { return m_config_stream_index; }
-    const MemoryView data() const { return MemoryView::create_const(m_data.data(), m_data.size()); }
+    const MemoryView data() const { return m_data; }
 
 private:
-    WriteDataCcwAction(Buffer &&data, uint8_t config_stream_index);
+    WriteDataCcwAction(const MemoryView &data, uint8_t config_stream_index);
 
-    Buffer m_data;
+    const MemoryView m_data;
     const uint8_t m_config_stream_index;
 };
 
@@ -503,6 +508,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     OpenBoundaryInputChannelAction(const vdma::ChannelId &channel_id,
@@ -520,6 +526,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     OpenBoundaryOutputChannelAction(const vdma::ChannelId &channel_id,
@@ -538,6 +545,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateBoundaryInputChannelAction(const vdma::ChannelId &channel_id,
@@ -561,6 +569,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateBoundaryOutputChannelAction(const vdma::ChannelId &channel_id,
@@ -582,6 +591,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateInterContextInputChannelAction(const vdma::ChannelId &channel_id,
@@ -605,6 +615,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateInterContextOutputChannelAction(const vdma::ChannelId &channel_id, uint8_t stream_index,
@@ -628,6 +639,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateDdrInputChannelAction(const vdma::ChannelId &channel_id,
@@ -652,6 +664,7 @@ public:
 
     virtual bool supports_repeated_block() const override;
     virtual Expected<Buffer> serialize_params(const ContextResources &context_resources) const override;
+    virtual Expected<size_t> get_host_buffer_info_offset() const override;
 
 private:
     ActivateDdrOutputChannelAction(const vdma::ChannelId &channel_id,
@@ -13,7 +13,8 @@ namespace hailort
 {
 
 ContextSwitchBufferBuilder::ContextSwitchBufferBuilder(CONTROL_PROTOCOL__context_switch_context_type_t context_type) :
-    m_context_type(context_type)
+    m_context_type(context_type),
+    m_last_action_offset(0)
 {
     // Initialize first control
     start_new_control();
@@ -30,16 +31,39 @@ void ContextSwitchBufferBuilder::write_action(MemoryView action)
     }
 
     auto &control = current_control();
+    m_last_action_offset = control.context_network_data_length;
     memcpy(&control.context_network_data[control.context_network_data_length], action.data(), action_size);
     control.context_network_data_length += action_size;
     control.actions_count++;
 }
 
+void ContextSwitchBufferBuilder::add_host_buffer_relocation(size_t offset_in_action)
+{
+    const auto offset = m_last_action_offset + offset_in_action;
+    assert((offset + sizeof(CONTROL_PROTOCOL__host_buffer_info_t)) <= current_control().context_network_data_length);
+    m_host_buffer_relocations.emplace_back(ContextSwitchHostBufferRelocation{
+        static_cast<uint32_t>(m_controls.size() - 1), static_cast<uint32_t>(offset)});
+}
+
 const std::vector<CONTROL_PROTOCOL__context_switch_context_info_single_control_t> &ContextSwitchBufferBuilder::get_controls() const
 {
     return m_controls;
 }
 
+const std::vector<ContextSwitchHostBufferRelocation> &ContextSwitchBufferBuilder::get_host_buffer_relocations() const
+{
+    return m_host_buffer_relocations;
+}
+
+void ContextSwitchBufferBuilder::set_controls(
+    std::vector<CONTROL_PROTOCOL__context_switch_context_info_single_control_t> &&controls)
+{
+    assert(!controls.empty());
+    m_controls = std::move(controls);
+    m_host_buffer_relocations.clear();
+    m_last_action_offset = 0;
+}
+
 CONTROL_PROTOCOL__context_switch_context_info_single_control_t &ContextSwitchBufferBuilder::current_control()
 {
     assert(!m_controls.empty());
@@ -18,6 +18,14 @@
 namespace hailort
 {
 
+// A host buffer info written to one of the controls. Its dma address is of a descriptors list allocated by this
+// process, so it's relocated when the controls are loaded from the recipe cache.
+struct ContextSwitchHostBufferRelocation {
+    uint32_t control_index;
+    // Offset of the info in the control's context_network_data
+    uint32_t offset;
+};
+
 // This class manages a vector of CONTROL_PROTOCOL__context_switch_context_info_single_control_t controls to be sent
 // to the firmware. Actions are written to the control buffer, until we reach the maximum control size, then we will
 // start a new control. 
@@ -26,7 +34,13 @@ public:
     ContextSwitchBufferBuilder(CONTROL_PROTOCOL__context_switch_context_type_t context_type);
 
     void write_action(MemoryView action);
+    // Marks the host buffer info at the given offset of the last written action
+    void add_host_buffer_relocation(size_t offset_in_action);
     const std::vector<CONTROL_PROTOCOL__context_switch_context_info_single_control_t> &get_controls() const;
+    const std::vector<ContextSwitchHostBufferRelocation> &get_host_buffer_relocations() const;
+
+    // Replaces the written actions with controls built by a previous process (already relocated)
+    void set_controls(std::vector<CONTROL_PROTOCOL__context_switch_context_info_single_control_t> &&controls);
 
 private:
     CONTROL_PROTOCOL__context_switch_context_info_single_control_t &current_control();
@@ -35,6 +49,8 @@ private:
 
     CONTROL_PROTOCOL__context_switch_context_type_t m_context_type;
     std::vector<CONTROL_PROTOCOL__context_switch_context_info_single_control_t> m_controls;
+    std::vector<ContextSwitchHostBufferRelocation> m_host_buffer_relocations;
+    uint32_t m_last_action_offset;
 };
 
 } /* namespace hailort */
@@ -0,0 +1,555 @@
+/**
+ * Copyright (c) 2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+**/
+/**
+ * @file context_switch_recipe_cache.cpp
+ * @brief On-disk (and in-process) cache of the context switch controls built for a network group.
+ **/
+
+#include "context_switch_recipe_cache.hpp"
+#include "common/filesystem.hpp"
+#include "common/file_utils.hpp"
+#include "common/string_utils.hpp"
+#include "os/mmap_buffer.hpp"
+#include "md5.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace hailort
+{
+
+#ifdef _WIN32
+#define PATH_SEPARATOR "\\"
+#else
+#define PATH_SEPARATOR "/"
+#endif
+
+#define RECIPE_CACHE_ENTRY_MAGIC (0x50434352) // "RCCP"
+// Must be bumped whenever the layout of an entry (or of the controls) changes
+#define RECIPE_CACHE_ENTRY_FORMAT_VERSION (1)
+#define RECIPE_CACHE_ENTRY_SUFFIX ".recipe"
+
+namespace
+{
+
+class EntryWriter final {
+public:
+    template<typename T>
+    void write(const T &value)
+    {
+        write(&value, sizeof(value));
+    }
+
+    void write(const void *data, size_t size)
+    {
+        const auto bytes = reinterpret_cast<const uint8_t*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    void write_string(const std::string &str)
+    {
+        write(static_cast<uint32_t>(str.size()));
+        write(str.data(), str.size());
+    }
+
+    std::vector<uint8_t> &data()
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+// Reads from an entry that may be truncated or corrupt, so every read is bounds checked
+class EntryReader final {
+public:
+    EntryReader(const uint8_t *data, size_t size) : m_data(data), m_size(size), m_offset(0)
+    {}
+
+    template<typename T>
+    Expected<T> read()
+    {
+        T value{};
+        auto status = read(&value, sizeof(value));
+        if (HAILO_SUCCESS != status) {
+            return make_unexpected(status);
+        }
+        return value;
+    }
+
+    hailo_status read(void *data, size_t size)
+    {
+        if (size > (m_size - m_offset)) {
+            return HAILO_INVALID_OPERATION;
+        }
+        memcpy(data, m_data + m_offset, size);
+        m_offset += size;
+        return HAILO_SUCCESS;
+    }
+
+    size_t bytes_left() const
+    {
+        return m_size - m_offset;
+    }
+
+private:
+    const uint8_t *m_data;
+    const size_t m_size;
+    size_t m_offset;
+};
+
+// Recipes built or loaded by this process (in LRU order). Like the entries on disk, the cached controls are relocated
+// to the host buffers of each configuration when applied.
+class ProcessRecipeCache final {
+public:
+    using Recipes = std::vector<ContextSwitchCachedRecipe>;
+
+    static ProcessRecipeCache &get_instance()
+    {
+        static ProcessRecipeCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const Recipes> find(const std::vector<uint8_t> &key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = std::find_if(m_entries.begin(), m_entries.end(), [&key](const Entry &cached_entry) {
+            return key == cached_entry.first;
+        });
+        if (m_entries.end() == entry) {
+            return nullptr;
+        }
+
+        // Move the entry to the front (most recently used)
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        return m_entries.front().second;
+    }
+
+    void insert(const std::vector<uint8_t> &key, std::shared_ptr<const Recipes> recipes)
+    {
+        if (!is_enabled()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // The same network group may be built by concurrent configurations
+        m_entries.remove_if([&key](const Entry &cached_entry) {
+            return key == cached_entry.first;
+        });
+        m_entries.emplace_front(key, recipes);
+        while (m_entries.size() > m_capacity) {
+            m_entries.pop_back();
+        }
+    }
+
+    bool is_enabled() const
+    {
+        return (0 != m_capacity);
+    }
+
+private:
+    using Entry = std::pair<std::vector<uint8_t>, std::shared_ptr<const Recipes>>;
+
+    ProcessRecipeCache() :
+        m_capacity(get_hef_process_cache_size())
+    {}
+
+    std::mutex m_mutex;
+    const size_t m_capacity;
+    std::list<Entry> m_entries;
+};
+
+} /* namespace */
+
+static void calculate_md5(const uint8_t *data, size_t size, MD5_SUM_t &md5_sum)
+{
+    MD5_CTX md5 = {};
+    MD5_Init(&md5);
+    MD5_Update(&md5, data, size);
+    MD5_Final(md5_sum, &md5);
+}
+
+static bool is_on_disk_cache_enabled()
+{
+    const auto cache_env = std::getenv(HAILO_RECIPE_CACHE_ENV_VAR);
+    return (nullptr != cache_env) && (std::string("1") == cache_env);
+}
+
+static std::string get_cache_home_directory()
+{
+#ifdef _WIN32
+    const auto local_app_data = std::getenv("LOCALAPPDATA");
+    return (nullptr != local_app_data) ? std::string(local_app_data) : "";
+#else
+    const auto xdg_cache_home = std::getenv("XDG_CACHE_HOME");
+    if ((nullptr != xdg_cache_home) && ('\0' != xdg_cache_home[0])) {
+        return xdg_cache_home;
+    }
+    return Filesystem::get_home_directory() + PATH_SEPARATOR + ".cache";
+#endif
+}
+
+static hailo_status create_cache_directory(const std::string &entry_path)
+{
+    const auto cache_home = get_cache_home_directory();
+    const auto hailort_dir = cache_home + PATH_SEPARATOR + "hailort";
+    for (const auto &dir_path : {cache_home, hailort_dir, hailort_dir + PATH_SEPARATOR + "recipes"}) {
+        auto status = Filesystem::create_directory(dir_path);
+        CHECK_SUCCESS(status, "Failed creating the recipe cache directory of {}", entry_path);
+    }
+    return HAILO_SUCCESS;
+}
+
+static bool is_same_host_buffer(const CONTROL_PROTOCOL__host_buffer_info_t &a, const CONTROL_PROTOCOL__host_buffer_info_t &b)
+{
+    return (a.buffer_type == b.buffer_type) && (a.desc_page_size == b.desc_page_size) &&
+        (a.total_desc_count == b.total_desc_count) && (a.bytes_in_pattern == b.bytes_in_pattern);
+}
+
+ContextSwitchRecipeCache::ContextSwitchRecipeCache(std::vector<uint8_t> &&key, const std::string &entry_path,
+    bool is_stored_on_disk) :
+    m_key(std::move(key)),
+    m_entry_path(entry_path),
+    m_is_stored_on_disk(is_stored_on_disk)
+{}
+
+Expected<ContextSwitchRecipeCache> ContextSwitchRecipeCache::create(const std::string &hef_hash,
+    const NetworkGroupMetadata &network_group_metadata, uint8_t net_group_index,
+    const ConfigureNetworkParams &config_params, const ProtoHEFHwArch &hw_arch,
+    const CONTROL_PROTOCOL__hw_consts_t &hw_consts, const HailoRTDriver &driver)
+{
+    const auto is_stored_on_disk = is_on_disk_cache_enabled();
+    if (!is_stored_on_disk && !ProcessRecipeCache::get_instance().is_enabled()) {
+        return make_unexpected(HAILO_NOT_AVAILABLE);
+    }
+
+    // Everything the controls are built from (besides the dma addresses, which are relocated)
+    EntryWriter key;
+    key.write(static_cast<uint32_t>(HAILORT_MAJOR_VERSION));
+    key.write(static_cast<uint32_t>(HAILORT_MINOR_VERSION));
+    key.write(static_cast<uint32_t>(HAILORT_REVISION_VERSION));
+    key.write(static_cast<uint32_t>(hw_arch));
+    key.write(hw_consts);
+    key.write(static_cast<uint32_t>(driver.dma_type()));
+    key.write(driver.desc_max_page_size());
+    key.write(static_cast<uint64_t>(driver.dma_engines_count()));
+    key.write_string(hef_hash);
+    key.write_string(network_group_metadata.network_group_name());
+    key.write(net_group_index);
+    key.write(config_params.batch_size);
+    key.write(static_cast<uint32_t>(config_params.power_mode));
+    key.write(static_cast<uint32_t>(config_params.latency));
+    for (const auto &network_params : config_params.network_params_by_name) {
+        key.write_string(network_params.first);
+        key.write(network_params.second.batch_size);
+    }
+    for (const auto &stream_params : config_params.stream_params_by_name) {
+        key.write_string(stream_params.first);
+        key.write(static_cast<uint32_t>(stream_params.second.stream_interface));
+        key.write(static_cast<uint32_t>(stream_params.second.direction));
+    }
+
+    MD5_SUM_t key_md5 = {};
+    calculate_md5(key.data().data(), key.data().size(), key_md5);
+    const bool LOWERCASE = false;
+    const auto entry_path = get_cache_home_directory() + PATH_SEPARATOR + "hailort" + PATH_SEPARATOR + "recipes" +
+        PATH_SEPARATOR + StringUtils::to_hex_string(key_md5, MD5_DIGEST_LENGTH, LOWERCASE) + RECIPE_CACHE_ENTRY_SUFFIX;
+
+    return ContextSwitchRecipeCache(std::move(key.data()), entry_path, is_stored_on_disk);
+}
+
+Expected<std::vector<ContextSwitchCachedRecipe>> ContextSwitchRecipeCache::parse_entry(const uint8_t *entry,
+    size_t entry_size) const
+{
+    // The md5 of the rest of the entry is at its end
+    if (entry_size < sizeof(MD5_SUM_t)) {
+        return make_unexpected(HAILO_INVALID_OPERATION);
+    }
+    const auto content_size = entry_size - sizeof(MD5_SUM_t);
+    MD5_SUM_t calculated_md5 = {};
+    calculate_md5(entry, content_size, calculated_md5);
+    if (0 != memcmp(calculated_md5, entry + content_size, sizeof(MD5_SUM_t))) {
+        return make_unexpected(HAILO_INVALID_OPERATION);
+    }
+
+    EntryReader reader(entry, content_size);
+    auto magic = reader.read<uint32_t>();
+    auto format_version = reader.read<uint32_t>();
+    auto key_size = reader.read<uint32_t>();
+    if (!magic || !format_version || !key_size || (RECIPE_CACHE_ENTRY_MAGIC != magic.value()) ||
+        (RECIPE_CACHE_ENTRY_FORMAT_VERSION != format_version.value()) || (m_key.size() != key_size.value())) {
+        return make_unexpected(HAILO_INVALID_OPERATION);
+    }
+    std::vector<uint8_t> key(key_size.value());
+    if ((HAILO_SUCCESS != reader.read(key.data(), key.size())) || (m_key != key)) {
+        return make_unexpected(HAILO_INVALID_OPERATION);
+    }
+
+    auto contexts_count = reader.read<uint32_t>();
+    if (!contexts_count || (contexts_count.value() > CONTROL_PROTOCOL__MAX_CONTEXTS_PER_NETWORK_GROUP)) {
+        return make_unexpected(HAILO_INVALID_OPERATION);
+    }
+    std::vector<ContextSwitchCachedRecipe> recipes(contexts_count.value());
+    for (auto &recipe : recipes) {
+        auto context_type = reader.read<uint8_t>();
+        auto host_buffers_count = reader.read<uint32_t>();
+        auto controls_count = reader.read<uint32_t>();
+        auto relocations_count = reader.read<uint32_t>();
+        if (!context_type || !host_buffers_count || !controls_count || !relocations_count || (0 == controls_count.value()) ||
+            ((controls_count.value() * sizeof(recipe.controls[0])) > reader.bytes_left()) ||
+            ((relocations_count.value() * sizeof(recipe.relocations[0])) > reader.bytes_left())) {
+            return make_unexpected(HAILO_INVALID_OPERATION);
+        }
+        recipe.context_type = context_type.value();
+        recipe.host_buffers_count = host_buffers_count.value();
+
+        recipe.controls.resize(controls_count.value());
+        for (auto &control : recipe.controls) {
+            if ((HAILO_SUCCESS != reader.read(&control, sizeof(control))) ||
+                (control.context_network_data_length > ARRAY_ENTRIES(control.context_network_data))) {
+                return make_unexpected(HAILO_INVALID_OPERATION);
+            }
+        }
+
+        recipe.relocations.resize(relocations_count.value());
+        for (auto &relocation : recipe.relocations) {
+            if (HAILO_SUCCESS != reader.read(&relocation, sizeof(relocation))) {
+                return make_unexpected(HAILO_INVALID_OPERATION);
+            }
+            if ((relocation.relocation.control_index >= recipe.controls.size()) ||
+                (relocation.host_buffer_index >= recipe.host_buffers_count) ||
+                ((relocation.relocation.offset + sizeof(CONTROL_PROTOCOL__host_buffer_info_t)) >
+                    recipe.controls[relocation.relocation.control_index].context_network_data_length)) {
+                return make_unexpected(HAILO_INVALID_OPERATION);
+            }
+        }
+    }
+    if (0 != reader.bytes_left()) {
+        return make_unexpected(HAILO_INVALID_OPERATION);
+    }
+    return recipes;
+}
+
+Expected<std::vector<ContextSwitchCachedRecipe>> ContextSwitchRecipeCache::load() const
+{
+    auto &process_cache = ProcessRecipeCache::get_instance();
+    auto cached_recipes = process_cache.find(m_key);
+    if (nullptr != cached_recipes) {
+        LOGGER__DEBUG("Loaded the context switch recipe from the process cache");
+        // Copied, since the controls are relocated when applied
+        return std::vector<ContextSwitchCachedRecipe>(*cached_recipes);
+    }
+
+    if (!m_is_stored_on_disk) {
+        return make_unexpected(HAILO_NOT_FOUND);
+    }
+    auto recipes = load_entry();
+    if (!recipes) {
+        return make_unexpected(recipes.status());
+    }
+
+    if (process_cache.is_enabled()) {
+        auto recipes_ptr = make_shared_nothrow<const std::vector<ContextSwitchCachedRecipe>>(recipes.value());
+        if (nullptr != recipes_ptr) {
+            process_cache.insert(m_key, recipes_ptr);
+        }
+    }
+    return recipes.release();
+}
+
+Expected<std::vector<ContextSwitchCachedRecipe>> ContextSwitchRecipeCache::load_entry() const
+{
+    if (!Filesystem::does_file_exists(m_entry_path)) {
+        LOGGER__DEBUG("No recipe cache entry at {}", m_entry_path);
+        return make_unexpected(HAILO_NOT_FOUND);
+    }
+
+    const auto parse = [this](const uint8_t *entry, size_t entry_size)
+        -> Expected<std::vector<ContextSwitchCachedRecipe>> {
+        auto recipes = parse_entry(entry, entry_size);
+        if (!recipes) {
+            // Built by another version, for other params (an md5 collision of the key) or corrupt - it'll be rebuilt
+            LOGGER__WARNING("Ignoring an invalid recipe cache entry {}", m_entry_path);
+            (void) std::remove(m_entry_path.c_str());
+            return make_unexpected(HAILO_NOT_FOUND);
+        }
+        return recipes.release();
+    };
+
+    // The entry is mapped (instead of read), so it's validated and parsed straight from the page cache
+    auto entry_mapping = MmapBuffer<uint8_t>::create_file_map_readonly(m_entry_path);
+    if (HAILO_NOT_IMPLEMENTED == entry_mapping.status()) {
+        auto entry = read_binary_file(m_entry_path);
+        if (!entry) {
+            return make_unexpected(HAILO_NOT_FOUND);
+        }
+        return parse(entry->data(), entry->size());
+    }
+    if (!entry_mapping) {
+        // E.g. the entry was removed (as invalid) by another process
+        return make_unexpected(HAILO_NOT_FOUND);
+    }
+    return parse(entry_mapping->get(), entry_mapping->size());
+}
+
+hailo_status ContextSwitchRecipeCache::store(std::vector<ContextResources> &contexts_resources) const
+{
+    auto recipes = create_recipes(contexts_resources);
+    CHECK_EXPECTED_AS_STATUS(recipes);
+
+    auto recipes_ptr = make_shared_nothrow<const std::vector<ContextSwitchCachedRecipe>>(recipes.release());
+    CHECK_NOT_NULL(recipes_ptr, HAILO_OUT_OF_HOST_MEMORY);
+    ProcessRecipeCache::get_instance().insert(m_key, recipes_ptr);
+
+    if (!m_is_stored_on_disk) {
+        return HAILO_SUCCESS;
+    }
+    return store_entry(*recipes_ptr);
+}
+
+Expected<std::vector<ContextSwitchCachedRecipe>> ContextSwitchRecipeCache::create_recipes(
+    std::vector<ContextResources> &contexts_resources)
+{
+    std::vector<ContextSwitchCachedRecipe> recipes;
+    recipes.reserve(contexts_resources.size());
+    for (auto &context_resources : contexts_resources) {
+        const auto &controls = context_resources.get_controls();
+        const auto &relocations = context_resources.builder().get_host_buffer_relocations();
+        const auto host_buffers = get_host_buffers(context_resources);
+
+        ContextSwitchCachedRecipe recipe{};
+        recipe.context_type = controls[0].context_type;
+        recipe.host_buffers_count = static_cast<uint32_t>(host_buffers.size());
+        recipe.controls = controls;
+        for (const auto &relocation : relocations) {
+            const auto &control = controls[relocation.control_index];
+            CONTROL_PROTOCOL__host_buffer_info_t host_buffer_info{};
+            memcpy(&host_buffer_info, &control.context_network_data[relocation.offset], sizeof(host_buffer_info));
+
+            // The dma address identifies the buffer
+            auto host_buffer = std::find_if(host_buffers.begin(), host_buffers.end(),
+                [&host_buffer_info](const CONTROL_PROTOCOL__host_buffer_info_t &info) {
+                    return (info.dma_address == host_buffer_info.dma_address) && is_same_host_buffer(info, host_buffer_info);
+                });
+            CHECK_AS_EXPECTED(host_buffers.end() != host_buffer, HAILO_NOT_FOUND,
+                "Host buffer of the control isn't a buffer of the context, not caching the recipe");
+            recipe.relocations.emplace_back(ContextSwitchCachedRelocation{relocation,
+                static_cast<uint32_t>(std::distance(host_buffers.begin(), host_buffer))});
+        }
+        recipes.emplace_back(std::move(recipe));
+    }
+    return recipes;
+}
+
+hailo_status ContextSwitchRecipeCache::store_entry(const std::vector<ContextSwitchCachedRecipe> &recipes) const
+{
+    EntryWriter entry;
+    entry.write(static_cast<uint32_t>(RECIPE_CACHE_ENTRY_MAGIC));
+    entry.write(static_cast<uint32_t>(RECIPE_CACHE_ENTRY_FORMAT_VERSION));
+    entry.write(static_cast<uint32_t>(m_key.size()));
+    entry.write(m_key.data(), m_key.size());
+    entry.write(static_cast<uint32_t>(recipes.size()));
+    for (const auto &recipe : recipes) {
+        entry.write(recipe.context_type);
+        entry.write(recipe.host_buffers_count);
+        entry.write(static_cast<uint32_t>(recipe.controls.size()));
+        entry.write(static_cast<uint32_t>(recipe.relocations.size()));
+        entry.write(recipe.controls.data(), recipe.controls.size() * sizeof(recipe.controls[0]));
+        entry.write(recipe.relocations.data(), recipe.relocations.size() * sizeof(recipe.relocations[0]));
+    }
+    MD5_SUM_t entry_md5 = {};
+    calculate_md5(entry.data().data(), entry.data().size(), entry_md5);
+    entry.write(entry_md5, sizeof(entry_md5));
+
+    auto status = create_cache_directory(m_entry_path);
+    CHECK_SUCCESS(status);
+
+    // Written to a temporary file and renamed, so other processes never read a partial entry
+    const auto temp_path = m_entry_path + "." +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream entry_file(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        CHECK(entry_file.is_open(), HAILO_OPEN_FILE_FAILURE, "Failed creating the recipe cache entry {}", temp_path);
+        entry_file.write(reinterpret_cast<const char*>(entry.data().data()), entry.data().size());
+        entry_file.close();
+        if (entry_file.fail()) {
+            (void) std::remove(temp_path.c_str());
+            LOGGER__ERROR("Failed writing the recipe cache entry {}", temp_path);
+            return HAILO_FILE_OPERATION_FAILURE;
+        }
+    }
+
+    if (0 != std::rename(temp_path.c_str(), m_entry_path.c_str())) {
+        // rename doesn't replace an existing file on windows
+        (void) std::remove(m_entry_path.c_str());
+        if (0 != std::rename(temp_path.c_str(), m_entry_path.c_str())) {
+            (void) std::remove(temp_path.c_str());
+            LOGGER__ERROR("Failed renaming the recipe cache entry {} to {}", temp_path, m_entry_path);
+            return HAILO_FILE_OPERATION_FAILURE;
+        }
+    }
+
+    LOGGER__INFO("Stored the context switch recipe in {}", m_entry_path);
+    return HAILO_SUCCESS;
+}
+
+hailo_status ContextSwitchRecipeCache::apply(ContextSwitchCachedRecipe &&recipe, ContextResources &context_resources)
+{
+    // The builder is created with a single (empty) control of the context's type
+    CHECK(recipe.context_type == context_resources.get_controls()[0].context_type, HAILO_INVALID_OPERATION,
+        "Cached recipe is of context type {}, expected {}", recipe.context_type,
+        context_resources.get_controls()[0].context_type);
+
+    const auto host_buffers = get_host_buffers(context_resources);
+    CHECK(recipe.host_buffers_count == host_buffers.size(), HAILO_INVALID_OPERATION,
+        "Cached recipe has {} host buffers, but the context has {}", recipe.host_buffers_count, host_buffers.size());
+
+    for (const auto &cached_relocation : recipe.relocations) {
+        const auto &relocation = cached_relocation.relocation;
+        auto &control = recipe.controls[relocation.control_index];
+        CONTROL_PROTOCOL__host_buffer_info_t host_buffer_info{};
+        memcpy(&host_buffer_info, &control.context_network_data[relocation.offset], sizeof(host_buffer_info));
+
+        // Only the dma address may differ between processes
+        const auto &current_host_buffer_info = host_buffers[cached_relocation.host_buffer_index];
+        CHECK(is_same_host_buffer(host_buffer_info, current_host_buffer_info), HAILO_INVALID_OPERATION,
+            "Cached recipe doesn't match host buffer {} of the context", cached_relocation.host_buffer_index);
+        memcpy(&control.context_network_data[relocation.offset], &current_host_buffer_info,
+            sizeof(current_host_buffer_info));
+    }
+
+    context_resources.builder().set_controls(std::move(recipe.controls));
+    return HAILO_SUCCESS;
+}
+
+std::vector<CONTROL_PROTOCOL__host_buffer_info_t> ContextSwitchRecipeCache::get_host_buffers(
+    ContextResources &context_resources)
+{
+    std::vector<CONTROL_PROTOCOL__host_buffer_info_t> host_buffers;
+    for (const auto &config_buffer : context_resources.get_config_buffers()) {
+        host_buffers.emplace_back(config_buffer.get_host_buffer_info());
+    }
+    for (const auto &edge_layer : context_resources.get_boundary_layers()) {
+        host_buffers.emplace_back(edge_layer.buffer_info);
+    }
+    for (const auto &edge_layer : context_resources.get_inter_context_layers()) {
+        host_buffers.emplace_back(edge_layer.buffer_info);
+    }
+    for (const auto &edge_layer : context_resources.get_ddr_channel_layers()) {
+        host_buffers.emplace_back(edge_layer.buffer_info);
+    }
+    return host_buffers;
+}
+
+} /* namespace hailort */
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+**/
+/**
+ * @file context_switch_recipe_cache.hpp
+ * @brief On-disk cache of the context switch controls built for a network group.
+ *
+ * Building the controls of a network group processes and serializes every action in the HEF. When the
+ * HAILO_RECIPE_CACHE environment variable is set to "1", the controls are stored under ~/.cache/hailort/recipes
+ * (or $XDG_CACHE_HOME/hailort/recipes), and the next configuration of the same network group loads them instead.
+ *
+ * An entry is keyed by the HEF's md5, the network group, the configure params, the hw arch, the device's hw consts
+ * and the HailoRT version. The entry holds its full key and a checksum, so a mismatched or corrupt entry is ignored
+ * and rebuilt. The host buffers (config buffers and edge layers) are allocated by each process, so the dma addresses
+ * in the cached controls are relocated to the current buffers.
+ *
+ * When the parsed HEF cache is enabled (HAILO_HEF_CACHE_SIZE, see get_hef_process_cache_size), the recipes
+ * built or loaded by the process are also kept in memory (with the same key and LRU size), so configuring a network
+ * group again in the same process (e.g. when a model is swapped out and back in) skips the build as well.
+ **/
+
+#ifndef _HAILO_CONTEXT_SWITCH_RECIPE_CACHE_HPP_
+#define _HAILO_CONTEXT_SWITCH_RECIPE_CACHE_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+#include "hef_internal.hpp"
+#include "context_switch/multi_context/resource_manager.hpp"
+
+namespace hailort
+{
+
+#define HAILO_RECIPE_CACHE_ENV_VAR "HAILO_RECIPE_CACHE"
+
+struct ContextSwitchCachedRelocation {
+    ContextSwitchHostBufferRelocation relocation;
+    // Index in the context's host buffers (see ContextSwitchRecipeCache::get_host_buffers)
+    uint32_t host_buffer_index;
+};
+
+struct ContextSwitchCachedRecipe {
+    uint8_t context_type;
+    uint32_t host_buffers_count;
+    std::vector<CONTROL_PROTOCOL__context_switch_context_info_single_control_t> controls;
+    std::vector<ContextSwitchCachedRelocation> relocations;
+};
+
+class ContextSwitchRecipeCache final {
+public:
+    // Returns HAILO_NOT_AVAILABLE if neither the on-disk cache nor the in-process cache is enabled
+    static Expected<ContextSwitchRecipeCache> create(const std::string &hef_hash,
+        const NetworkGroupMetadata &network_group_metadata, uint8_t net_group_index,
+        const ConfigureNetworkParams &config_params, const ProtoHEFHwArch &hw_arch,
+        const CONTROL_PROTOCOL__hw_consts_t &hw_consts, const HailoRTDriver &driver);
+
+    // Returns the recipe of each context, or HAILO_NOT_FOUND if there's no valid entry
+    Expected<std::vector<ContextSwitchCachedRecipe>> load() const;
+    hailo_status store(std::vector<ContextResources> &contexts_resources) const;
+
+    // Replaces the context's controls with the cached ones, relocated to the context's host buffers
+    static hailo_status apply(ContextSwitchCachedRecipe &&recipe, ContextResources &context_resources);
+
+private:
+    ContextSwitchRecipeCache(std::vector<uint8_t> &&key, const std::string &entry_path, bool is_stored_on_disk);
+
+    Expected<std::vector<ContextSwitchCachedRecipe>> load_entry() const;
+    // Fails if the entry is corrupt, or was stored for another key
+    Expected<std::vector<ContextSwitchCachedRecipe>> parse_entry(const uint8_t *entry, size_t entry_size) const;
+    hailo_status store_entry(const std::vector<ContextSwitchCachedRecipe> &recipes) const;
+    static Expected<std::vector<ContextSwitchCachedRecipe>> create_recipes(
+        std::vector<ContextResources> &contexts_resources);
+    static std::vector<CONTROL_PROTOCOL__host_buffer_info_t> get_host_buffers(ContextResources &context_resources);
+
+    std::vector<uint8_t> m_key;
+    std::string m_entry_path;
+    bool m_is_stored_on_disk;
+};
+
+} /* namespace hailort */
+
+#endif /* _HAILO_CONTEXT_SWITCH_RECIPE_CACHE_HPP_ */
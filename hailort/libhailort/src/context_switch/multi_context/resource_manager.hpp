@@ -142,6 +142,11 @@ public:
     Expected<std::reference_wrapper<ContextResources>> add_new_context(CONTROL_PROTOCOL__context_switch_context_type_t type,
         const ConfigBufferInfoMap &config_info={});
 
+    std::vector<ContextResources> &get_contexts_resources()
+    {
+        return m_contexts_resources;
+    }
+
     const SupportedFeatures &get_supported_features() const
     {
         return m_network_group_metadata->supported_features();
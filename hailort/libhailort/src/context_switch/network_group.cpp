@@ -431,6 +431,9 @@ hailo_status ConfiguredNetworkGroupBase::create_output_stream_from_config_params
                 const auto stream_index = edge_layer->stream_index;
                 auto vdma_channel_ptr = get_boundary_vdma_channel_by_stream_name(stream_name);
                 CHECK_EXPECTED_AS_STATUS(vdma_channel_ptr, "Failed to get vdma channel for output stream {}", stream_index);
+                auto status = vdma_channel_ptr.value()->set_d2h_completion_params(
+                    stream_params.pcie_output_params.completion_params);
+                CHECK_SUCCESS(status);
 
                 auto output_stream = PcieOutputStream::create(device, vdma_channel_ptr.release(), 
                     edge_layer.value(), batch_size_exp.value(), m_network_group_activated_event);
@@ -445,6 +448,9 @@ hailo_status ConfiguredNetworkGroupBase::create_output_stream_from_config_params
                 const auto stream_index = edge_layer->stream_index;
                 auto vdma_channel_ptr = get_boundary_vdma_channel_by_stream_name(stream_name);
                 CHECK_EXPECTED_AS_STATUS(vdma_channel_ptr, "Failed to get vdma channel for output stream {}", stream_index);
+                auto status = vdma_channel_ptr.value()->set_d2h_completion_params(
+                    stream_params.core_output_params.completion_params);
+                CHECK_SUCCESS(status);
 
                 auto output_stream = CoreOutputStream::create(device, vdma_channel_ptr.release(), 
                     edge_layer.value(), batch_size_exp.value(), m_network_group_activated_event);
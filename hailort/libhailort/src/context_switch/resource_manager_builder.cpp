@@ -8,6 +8,7 @@
  **/
 
 #include "resource_manager_builder.hpp"
+#include "context_switch_recipe_cache.hpp"
 #include "control.hpp"
 
 namespace hailort
@@ -320,50 +321,47 @@ static hailo_status add_ddr_buffers_info(std::vector<ContextSwitchConfigActionPt
 static hailo_status parse_and_fill_edge_layers_mapping(
     ContextResources &context_resources,
     const ContextMetadata &context_metadata,
-    ResourcesManager &resources_manager)
+    ResourcesManager &resources_manager,
+    const CONTROL_PROTOCOL__hw_consts_t &hw_consts,
+    bool should_optimize_credits)
 {
     hailo_status status = HAILO_UNINITIALIZED;
 
-    auto hw_consts = Control::get_hw_consts(resources_manager.get_device());
-    CHECK_EXPECTED_AS_STATUS(hw_consts);
-    const bool should_optimize_credits = hw_consts->should_optimize_credits &&
-        (HAILO_POWER_MODE_PERFORMANCE == resources_manager.get_power_mode());
-
     // Parse the edge layer by order - first output edge layers, then ddr inputs and only then the input edge layers
     // In order to insure that input data can enter the chip only after all other elements are configured.
     // We parse ddr inputs before boundary/inter-context because otherwise on C2C mode we may lose some credit.
 
     for (const auto &output_layer_info : context_metadata.get_ddr_output_layers()) {
-        status = fill_ddr_output_layer(context_resources, resources_manager, output_layer_info, *hw_consts);
+        status = fill_ddr_output_layer(context_resources, resources_manager, output_layer_info, hw_consts);
         CHECK_SUCCESS(status);
     }
 
     for (const auto &output_layer_info : context_metadata.get_boundary_output_layers()) {
         status = fill_boundary_output_layer(context_resources, resources_manager, output_layer_info,
-            *hw_consts, should_optimize_credits);
+            hw_consts, should_optimize_credits);
         CHECK_SUCCESS(status);
     }
 
     for (const auto &output_layer_info : context_metadata.get_inter_context_output_layers()) {
         status = fill_inter_context_output_layer(context_resources, resources_manager, output_layer_info,
-            *hw_consts, should_optimize_credits);
+            hw_consts, should_optimize_credits);
         CHECK_SUCCESS(status);
     }
 
     for (const auto &input_layer_info : context_metadata.get_ddr_input_layers()) {
-        status = fill_ddr_input_layer(context_resources, input_layer_info, *hw_consts);
+        status = fill_ddr_input_layer(context_resources, input_layer_info, hw_consts);
         CHECK_SUCCESS(status);
     }
 
     for (const auto &input_layer_info : context_metadata.get_boundary_input_layers()) {
         status = fill_boundary_input_layer(context_resources, resources_manager, input_layer_info,
-            *hw_consts, should_optimize_credits);
+            hw_consts, should_optimize_credits);
         CHECK_SUCCESS(status);
     }
 
     for (const auto &input_layer_info : context_metadata.get_inter_context_input_layers()) {
         status = fill_inter_context_input_layer(context_resources, resources_manager, input_layer_info,
-            *hw_consts, should_optimize_credits);
+            hw_consts, should_optimize_credits);
         CHECK_SUCCESS(status);
     }
 
@@ -940,6 +938,16 @@ static Expected<std::vector<ContextSwitchConfigActionPtr>> process_operation(con
     return configuration_actions;
 }
 
+// Writes the operation's ccw to the config buffers, without building the rest of its actions (which are loaded from
+// the recipe cache).
+static hailo_status write_operation_config_buffers(const ContextSwitchOperation &operation,
+    const ProtoHEFHwArch &hw_arch, std::vector<ConfigBuffer> &config_resources)
+{
+    auto configuration_actions = operation.actions();
+    const auto support_pre_fetch = is_mercury_device_type(hw_arch);
+    return add_fetch_config_actions(configuration_actions, config_resources, support_pre_fetch);
+}
+
 static hailo_status write_action_list(const ContextResources & context_resources, ContextSwitchBufferBuilder &builder,
     const std::vector<ContextSwitchConfigActionPtr> &actions)
 {
@@ -950,6 +958,13 @@ static hailo_status write_action_list(const ContextResources & context_resources
         for (auto &action_buffer : action_buffers.value()) {
             builder.write_action(MemoryView(action_buffer));
         }
+
+        auto host_buffer_info_offset = action->get_host_buffer_info_offset();
+        if (host_buffer_info_offset) {
+            // Actions with a host buffer aren't repeated, so they're serialized to a single buffer
+            assert(1 == action_buffers->size());
+            builder.add_host_buffer_relocation(host_buffer_info_offset.value());
+        }
     }
 
     return HAILO_SUCCESS;
@@ -993,18 +1008,28 @@ static hailo_status add_edge_layer_end_of_context_actions(const ContextResources
 static hailo_status fill_context_recipes_for_multi_context(const ProtoHEFHwArch &hw_arch,
     ContextResources &context_resources, ResourcesManager &resources_manager,
     uint8_t context_index, const NetworkGroupMetadata &network_group_metadata, const ContextMetadata &context_metadata,
-    bool is_single_context)
+    bool is_single_context, const CONTROL_PROTOCOL__hw_consts_t &hw_consts, bool should_optimize_credits,
+    bool is_recipe_cached)
 {
     hailo_status status = HAILO_UNINITIALIZED;
 
     // Add edge layers mapping
-    status = parse_and_fill_edge_layers_mapping(context_resources, context_metadata, resources_manager);
+    status = parse_and_fill_edge_layers_mapping(context_resources, context_metadata, resources_manager, hw_consts,
+        should_optimize_credits);
     CHECK_SUCCESS(status);
 
     // Parse context
     bool first_operation = true;
     std::vector<ContextSwitchConfigActionPtr> actions;
-    for (const auto &operation : context_metadata.get_operations()) {
+    auto operations = context_metadata.get_operations();
+    CHECK_EXPECTED_AS_STATUS(operations);
+    for (const auto &operation : operations.value()) {
+        if (is_recipe_cached) {
+            status = write_operation_config_buffers(operation, hw_arch, context_resources.get_config_buffers());
+            CHECK_SUCCESS(status);
+            continue;
+        }
+
         static const auto NOT_PRELIMINARY_CONTEXT = false;
         auto new_actions = process_operation(operation, network_group_metadata, hw_arch, context_index, NOT_PRELIMINARY_CONTEXT,
             first_operation, is_single_context, context_resources.get_config_buffers(), resources_manager,
@@ -1015,6 +1040,11 @@ static hailo_status fill_context_recipes_for_multi_context(const ProtoHEFHwArch
         first_operation = false;
     }
 
+    if (is_recipe_cached) {
+        // Only the resources are created, the actions are loaded from the recipe cache
+        return HAILO_SUCCESS;
+    }
+
     status = add_config_channel_activation_actions(actions, context_resources.get_config_buffers());
     CHECK_SUCCESS(status);
 
@@ -1043,21 +1073,17 @@ static hailo_status create_boundary_channels(ResourcesManager &resources_manager
 
 static hailo_status fill_activation_config_recepies_for_multi_context(
     ContextResources &context_resources, ResourcesManager &resources_manager,
-    std::shared_ptr<NetworkGroupMetadata> network_group_metadata)
+    std::shared_ptr<NetworkGroupMetadata> network_group_metadata, const CONTROL_PROTOCOL__hw_consts_t &hw_consts,
+    bool should_optimize_credits, bool is_recipe_cached)
 {
-    auto hw_consts = Control::get_hw_consts(resources_manager.get_device());
-    CHECK_EXPECTED_AS_STATUS(hw_consts);
-    const bool should_optimize_credits = hw_consts->should_optimize_credits &&
-        (HAILO_POWER_MODE_PERFORMANCE == resources_manager.get_power_mode());
-
     for (const auto &layer_info : network_group_metadata->get_output_layer_infos()){
-        auto status = fill_boundary_output_layer(context_resources, resources_manager, layer_info, *hw_consts,
+        auto status = fill_boundary_output_layer(context_resources, resources_manager, layer_info, hw_consts,
             should_optimize_credits);
         CHECK_SUCCESS(status);
     }
 
     for (const auto &layer_info : network_group_metadata->get_input_layer_infos()) {
-        auto status = fill_boundary_input_layer(context_resources, resources_manager, layer_info, *hw_consts,
+        auto status = fill_boundary_input_layer(context_resources, resources_manager, layer_info, hw_consts,
             should_optimize_credits);
         CHECK_SUCCESS(status);
     }
@@ -1065,6 +1091,11 @@ static hailo_status fill_activation_config_recepies_for_multi_context(
     auto status = context_resources.validate_edge_layers();
     CHECK_SUCCESS(status);
 
+    if (is_recipe_cached) {
+        // Only the resources are created, the actions are loaded from the recipe cache
+        return HAILO_SUCCESS;
+    }
+
     std::vector<ContextSwitchConfigActionPtr> actions;
     for (const auto &edge_layer : context_resources.get_boundary_layers()) {
         auto action = edge_layer.layer_info.direction == HAILO_H2D_STREAM ?
@@ -1093,7 +1124,9 @@ static hailo_status fill_batch_switching_context_config_recepies_for_multi_conte
         ContextSwitchConfigAction::Type::EnableLcuDefault,
         ContextSwitchConfigAction::Type::EnableLcuNonDefault
     };
-    for (const auto &operation : network_group_metadata.preliminary_context().get_operations()) {
+    auto preliminary_operations = network_group_metadata.preliminary_context().get_operations();
+    CHECK_EXPECTED_AS_STATUS(preliminary_operations);
+    for (const auto &operation : preliminary_operations.value()) {
         auto operation_actions = operation.get_actions_of_type(BATCH_SWITCHING_ACTIONS);
 
         // Allowing repeated actions
@@ -1109,7 +1142,8 @@ static hailo_status fill_batch_switching_context_config_recepies_for_multi_conte
 static hailo_status fill_preliminary_config_recepies_for_multi_context(const ProtoHEFHwArch &hw_arch,
     ContextResources &context_resources, ResourcesManager &resources_manager,
     std::shared_ptr<NetworkGroupMetadata> network_group_metadata, const PreliminaryContextMetadata &preliminary_context,
-    bool is_single_context)
+    bool is_single_context, const CONTROL_PROTOCOL__hw_consts_t &hw_consts, bool should_optimize_credits,
+    bool is_recipe_cached)
 {
 
     if (resources_manager.get_supported_features().preliminary_run_asap) {
@@ -1117,14 +1151,23 @@ static hailo_status fill_preliminary_config_recepies_for_multi_context(const Pro
         static const auto PRELIMINARY_CONTEXT_INDEX = 0;
         assert(PRELIMINARY_CONTEXT_INDEX < network_group_metadata->dynamic_contexts().size());
         auto status = parse_and_fill_edge_layers_mapping(context_resources,
-            network_group_metadata->dynamic_contexts()[PRELIMINARY_CONTEXT_INDEX], resources_manager);
+            network_group_metadata->dynamic_contexts()[PRELIMINARY_CONTEXT_INDEX], resources_manager, hw_consts,
+            should_optimize_credits);
         CHECK_SUCCESS(status);
     }
 
     // Parse preliminary config
     std::vector<ContextSwitchConfigActionPtr> actions;
     bool first_operation = true;
-    for (const auto &operation : preliminary_context.get_operations()) {
+    auto operations = preliminary_context.get_operations();
+    CHECK_EXPECTED_AS_STATUS(operations);
+    for (const auto &operation : operations.value()) {
+        if (is_recipe_cached) {
+            auto status = write_operation_config_buffers(operation, hw_arch, context_resources.get_config_buffers());
+            CHECK_SUCCESS(status);
+            continue;
+        }
+
         static const auto PRELIMINARY_CONTEXT_INDEX = 0; // First context in the hef
         static const auto PRELIMINARY_CONTEXT = true;
         auto new_actions = process_operation(operation, *network_group_metadata, hw_arch, PRELIMINARY_CONTEXT_INDEX,
@@ -1136,6 +1179,11 @@ static hailo_status fill_preliminary_config_recepies_for_multi_context(const Pro
         first_operation = false;
     }
 
+    if (is_recipe_cached) {
+        // Only the resources are created, the actions are loaded from the recipe cache
+        return HAILO_SUCCESS;
+    }
+
     auto status = add_config_channel_activation_actions(actions, context_resources.get_config_buffers());
     CHECK_SUCCESS(status);
 
@@ -1144,22 +1192,30 @@ static hailo_status fill_preliminary_config_recepies_for_multi_context(const Pro
 
 
 
-Expected<std::shared_ptr<ResourcesManager>> ResourcesManagerBuilder::build(uint8_t net_group_index, VdmaDevice &device,
-    HailoRTDriver &driver, const ConfigureNetworkParams &config_params,
-    std::shared_ptr<NetworkGroupMetadata> network_group_metadata, const ProtoHEFHwArch &hw_arch)
+static hailo_status apply_cached_recipes(ResourcesManager &resources_manager,
+    std::vector<ContextSwitchCachedRecipe> &&cached_recipes)
 {
-    const auto num_contexts = network_group_metadata->dynamic_contexts().size() +
-        CONTROL_PROTOCOL__CONTEXT_SWITCH_NUMBER_OF_NON_DYNAMIC_CONTEXTS;
-    CHECK_AS_EXPECTED(CONTROL_PROTOCOL__MAX_CONTEXTS_PER_NETWORK_GROUP >= num_contexts, HAILO_INVALID_HEF,
-        "App '{}' contains more contexts than allowed ({} > {})",
-        network_group_metadata->network_group_name(), num_contexts, CONTROL_PROTOCOL__MAX_CONTEXTS_PER_NETWORK_GROUP);
+    auto &contexts_resources = resources_manager.get_contexts_resources();
+    CHECK(cached_recipes.size() == contexts_resources.size(), HAILO_INVALID_OPERATION,
+        "Cached recipe has {} contexts, but the network group has {}", cached_recipes.size(), contexts_resources.size());
 
-    for (auto &network_params : config_params.network_params_by_name) {
-        CHECK(HAILO_MAX_BATCH_SIZE >= network_params.second.batch_size, make_unexpected(HAILO_INVALID_ARGUMENT),
-            "Given batch size ({}) for network group {}, network {} is bigger than max allowed ({})", network_params.second.batch_size,
-            network_group_metadata->network_group_name(), network_params.first, HAILO_MAX_BATCH_SIZE);
+    for (size_t context_index = 0; context_index < contexts_resources.size(); context_index++) {
+        auto status = ContextSwitchRecipeCache::apply(std::move(cached_recipes[context_index]),
+            contexts_resources[context_index]);
+        CHECK_SUCCESS(status);
     }
 
+    return HAILO_SUCCESS;
+}
+
+// If cached_recipes isn't empty, only the resources are created, and the controls are loaded from cached_recipes
+static Expected<ResourcesManager> build_resources_manager(uint8_t net_group_index, VdmaDevice &device,
+    HailoRTDriver &driver, const ConfigureNetworkParams &config_params,
+    std::shared_ptr<NetworkGroupMetadata> network_group_metadata, const ProtoHEFHwArch &hw_arch,
+    const CONTROL_PROTOCOL__hw_consts_t &hw_consts, std::vector<ContextSwitchCachedRecipe> &&cached_recipes)
+{
+    const bool is_recipe_cached = !cached_recipes.empty();
+
     auto resources_manager = ResourcesManager::create(device, driver, config_params, network_group_metadata,
         net_group_index);
     CHECK_EXPECTED(resources_manager);
@@ -1167,17 +1223,22 @@ Expected<std::shared_ptr<ResourcesManager>> ResourcesManagerBuilder::build(uint8
     auto status = create_boundary_channels(resources_manager.value(), *network_group_metadata);
     CHECK_SUCCESS_AS_EXPECTED(status);
 
+    const bool should_optimize_credits = hw_consts.should_optimize_credits &&
+        (HAILO_POWER_MODE_PERFORMANCE == resources_manager->get_power_mode());
+
     auto activation_context = resources_manager->add_new_context(CONTROL_PROTOCOL__CONTEXT_SWITCH_CONTEXT_TYPE_ACTIVATION);
     CHECK_EXPECTED(activation_context);
     status = fill_activation_config_recepies_for_multi_context(activation_context.value().get(),
-        resources_manager.value(), network_group_metadata);
+        resources_manager.value(), network_group_metadata, hw_consts, should_optimize_credits, is_recipe_cached);
     CHECK_SUCCESS_AS_EXPECTED(status);
 
     auto batch_switching_context = resources_manager->add_new_context(CONTROL_PROTOCOL__CONTEXT_SWITCH_CONTEXT_TYPE_BATCH_SWITCHING);
     CHECK_EXPECTED(batch_switching_context);
-    status = fill_batch_switching_context_config_recepies_for_multi_context(batch_switching_context.value().get(),
-        *network_group_metadata);
-    CHECK_SUCCESS_AS_EXPECTED(status);
+    if (!is_recipe_cached) {
+        status = fill_batch_switching_context_config_recepies_for_multi_context(batch_switching_context.value().get(),
+            *network_group_metadata);
+        CHECK_SUCCESS_AS_EXPECTED(status);
+    }
 
     const bool is_single_context = network_group_metadata->dynamic_contexts().size() == 1;
 
@@ -1185,7 +1246,8 @@ Expected<std::shared_ptr<ResourcesManager>> ResourcesManagerBuilder::build(uint8
         network_group_metadata->preliminary_context().config_buffers_info());
     CHECK_EXPECTED(preliminary_context);
     status = fill_preliminary_config_recepies_for_multi_context(hw_arch, preliminary_context.value().get(),
-        resources_manager.value(), network_group_metadata, network_group_metadata->preliminary_context(), is_single_context);
+        resources_manager.value(), network_group_metadata, network_group_metadata->preliminary_context(), is_single_context,
+        hw_consts, should_optimize_credits, is_recipe_cached);
     CHECK_SUCCESS_AS_EXPECTED(status);
 
     uint8_t context_index = 0;
@@ -1196,7 +1258,7 @@ Expected<std::shared_ptr<ResourcesManager>> ResourcesManagerBuilder::build(uint8
 
         status = fill_context_recipes_for_multi_context(hw_arch, new_context.value().get(), resources_manager.value(),
             context_index, *network_group_metadata,
-            context_metadata, is_single_context);
+            context_metadata, is_single_context, hw_consts, should_optimize_credits, is_recipe_cached);
         CHECK_SUCCESS_AS_EXPECTED(status);
 
         context_index++;
@@ -1205,9 +1267,67 @@ Expected<std::shared_ptr<ResourcesManager>> ResourcesManagerBuilder::build(uint8
     status = resources_manager->create_internal_vdma_channels();
     CHECK_SUCCESS_AS_EXPECTED(status);
 
+    if (is_recipe_cached) {
+        status = apply_cached_recipes(resources_manager.value(), std::move(cached_recipes));
+        CHECK_SUCCESS_AS_EXPECTED(status);
+    }
+
     status = resources_manager->configure();
     CHECK_SUCCESS_AS_EXPECTED(status);
 
+    return resources_manager;
+}
+
+Expected<std::shared_ptr<ResourcesManager>> ResourcesManagerBuilder::build(uint8_t net_group_index, VdmaDevice &device,
+    HailoRTDriver &driver, const ConfigureNetworkParams &config_params,
+    std::shared_ptr<NetworkGroupMetadata> network_group_metadata, const ProtoHEFHwArch &hw_arch,
+    const std::string &hef_hash)
+{
+    const auto num_contexts = network_group_metadata->dynamic_contexts().size() +
+        CONTROL_PROTOCOL__CONTEXT_SWITCH_NUMBER_OF_NON_DYNAMIC_CONTEXTS;
+    CHECK_AS_EXPECTED(CONTROL_PROTOCOL__MAX_CONTEXTS_PER_NETWORK_GROUP >= num_contexts, HAILO_INVALID_HEF,
+        "App '{}' contains more contexts than allowed ({} > {})",
+        network_group_metadata->network_group_name(), num_contexts, CONTROL_PROTOCOL__MAX_CONTEXTS_PER_NETWORK_GROUP);
+
+    for (auto &network_params : config_params.network_params_by_name) {
+        CHECK(HAILO_MAX_BATCH_SIZE >= network_params.second.batch_size, make_unexpected(HAILO_INVALID_ARGUMENT),
+            "Given batch size ({}) for network group {}, network {} is bigger than max allowed ({})", network_params.second.batch_size,
+            network_group_metadata->network_group_name(), network_params.first, HAILO_MAX_BATCH_SIZE);
+    }
+
+    // Queried once for all of the contexts, since each query is a control round trip to the device
+    auto hw_consts = Control::get_hw_consts(device);
+    CHECK_EXPECTED(hw_consts);
+
+    auto recipe_cache = ContextSwitchRecipeCache::create(hef_hash, *network_group_metadata, net_group_index,
+        config_params, hw_arch, hw_consts.value(), driver);
+    if (recipe_cache) {
+        auto cached_recipes = recipe_cache->load();
+        if (cached_recipes) {
+            auto resources_manager = build_resources_manager(net_group_index, device, driver, config_params,
+                network_group_metadata, hw_arch, hw_consts.value(), cached_recipes.release());
+            if (resources_manager) {
+                auto resources_manager_ptr = make_shared_nothrow<ResourcesManager>(resources_manager.release());
+                CHECK_NOT_NULL_AS_EXPECTED(resources_manager_ptr, HAILO_OUT_OF_HOST_MEMORY);
+                return resources_manager_ptr;
+            }
+            LOGGER__WARNING("Failed building network group {} from the recipe cache with status {}, rebuilding it",
+                network_group_metadata->network_group_name(), resources_manager.status());
+        }
+    }
+
+    auto resources_manager = build_resources_manager(net_group_index, device, driver, config_params,
+        network_group_metadata, hw_arch, hw_consts.value(), {});
+    CHECK_EXPECTED(resources_manager);
+
+    if (recipe_cache) {
+        auto status = recipe_cache->store(resources_manager->get_contexts_resources());
+        if (HAILO_SUCCESS != status) {
+            LOGGER__WARNING("Failed storing the recipe of network group {} in the recipe cache with status {}",
+                network_group_metadata->network_group_name(), status);
+        }
+    }
+
     auto resources_manager_ptr = make_shared_nothrow<ResourcesManager>(resources_manager.release());
     CHECK_NOT_NULL_AS_EXPECTED(resources_manager_ptr, HAILO_OUT_OF_HOST_MEMORY);
 
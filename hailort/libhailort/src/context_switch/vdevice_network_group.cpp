@@ -130,7 +130,8 @@ VDeviceNetworkGroup::VDeviceNetworkGroup(std::vector<std::shared_ptr<VdmaConfigN
         m_network_group_scheduler(network_group_scheduler),
         m_scheduler_handle(INVALID_NETWORK_GROUP_HANDLE),
         m_multiplexer_handle(0),
-        m_multiplexer()
+        m_multiplexer(),
+        m_dispatchers()
 {}
 
 Expected<hailo_stream_interface_t> VDeviceNetworkGroup::get_default_streams_interface()
@@ -216,8 +217,10 @@ hailo_status VDeviceNetworkGroup::create_input_vdevice_stream_from_config_params
         CHECK(stream, HAILO_INTERNAL_FAILURE);
         low_level_streams.emplace_back(dynamic_cast<VdmaInputStream&>(stream.release().get()));
     }
+    auto dispatcher = get_dispatcher(edge_layer->network_name);
+    CHECK_EXPECTED_AS_STATUS(dispatcher);
     auto input_stream = InputVDeviceBaseStream::create(std::move(low_level_streams), edge_layer.value(),
-        scheduler_handle, m_network_group_activated_event, m_network_group_scheduler);
+        scheduler_handle, m_network_group_activated_event, m_network_group_scheduler, dispatcher.release());
     CHECK_EXPECTED_AS_STATUS(input_stream);
     auto input_stream_wrapper = VDeviceInputStreamMultiplexerWrapper::create(input_stream.release(), edge_layer->network_name, multiplexer, scheduler_handle);
     CHECK_EXPECTED_AS_STATUS(input_stream_wrapper);
@@ -242,8 +245,10 @@ hailo_status VDeviceNetworkGroup::create_output_vdevice_stream_from_config_param
         CHECK(stream, HAILO_INTERNAL_FAILURE);
         low_level_streams.emplace_back(dynamic_cast<VdmaOutputStream&>(stream.release().get()));
     }
+    auto dispatcher = get_dispatcher(edge_layer->network_name);
+    CHECK_EXPECTED_AS_STATUS(dispatcher);
     auto output_stream = OutputVDeviceBaseStream::create(std::move(low_level_streams), edge_layer.value(),
-        scheduler_handle, m_network_group_activated_event, m_network_group_scheduler);
+        scheduler_handle, m_network_group_activated_event, m_network_group_scheduler, dispatcher.release());
     CHECK_EXPECTED_AS_STATUS(output_stream);
     auto output_stream_wrapper = VDeviceOutputStreamMultiplexerWrapper::create(output_stream.release(), edge_layer->network_name, multiplexer, scheduler_handle);
     CHECK_EXPECTED_AS_STATUS(output_stream_wrapper);
@@ -252,6 +257,28 @@ hailo_status VDeviceNetworkGroup::create_output_vdevice_stream_from_config_param
     return HAILO_SUCCESS;
 }
 
+Expected<std::shared_ptr<VDeviceDispatcher>> VDeviceNetworkGroup::get_dispatcher(const std::string &network_name)
+{
+    // The scheduler dispatches the frames of scheduled streams by itself
+    if ((1 == m_configured_network_groups.size()) || m_network_group_scheduler.lock() ||
+        !VDeviceDispatcher::should_use_load_aware_dispatch()) {
+        return std::shared_ptr<VDeviceDispatcher>(nullptr);
+    }
+
+    // All of the streams of a network must send each batch to the same device
+    auto dispatcher = m_dispatchers.find(network_name);
+    if (m_dispatchers.end() != dispatcher) {
+        return std::shared_ptr<VDeviceDispatcher>(dispatcher->second);
+    }
+
+    auto new_dispatcher = VDeviceDispatcher::create(m_configured_network_groups.size());
+    CHECK_EXPECTED(new_dispatcher);
+    m_dispatchers.emplace(network_name, new_dispatcher.value());
+    LOGGER__INFO("Using load aware dispatch for network {}", network_name);
+
+    return new_dispatcher.release();
+}
+
 hailo_status VDeviceNetworkGroup::create_vdevice_streams_from_duplicate(std::shared_ptr<VDeviceNetworkGroup> other)
 {
     // TODO - HRT-6931 - raise error on this case 
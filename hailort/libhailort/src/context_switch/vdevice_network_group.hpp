@@ -20,6 +20,7 @@
 #include "network_group_internal.hpp"
 #include "network_group_scheduler.hpp"
 #include "pipeline_multiplexer.hpp"
+#include "vdevice_dispatcher.hpp"
 
 #include <cstdint>
 
@@ -170,11 +171,16 @@ private:
         NetworkGroupSchedulerWeakPtr network_group_scheduler, std::vector<std::shared_ptr<NetFlowElement>> &&net_flow_ops,
         hailo_status &status);
 
+    // Returns nullptr if the streams of the network should be used in turns
+    Expected<std::shared_ptr<VDeviceDispatcher>> get_dispatcher(const std::string &network_name);
+
     std::vector<std::shared_ptr<VdmaConfigNetworkGroup>> m_configured_network_groups;
     NetworkGroupSchedulerWeakPtr m_network_group_scheduler;
     scheduler_ng_handle_t m_scheduler_handle;
     multiplexer_ng_handle_t m_multiplexer_handle;
     std::shared_ptr<PipelineMultiplexer> m_multiplexer;
+    // Load aware dispatchers of the native (non scheduled) multi device streams, by network name
+    std::map<std::string, std::shared_ptr<VDeviceDispatcher>> m_dispatchers;
 };
 
 }
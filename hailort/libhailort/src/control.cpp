@@ -18,6 +18,7 @@
 #include "hw_consts.hpp"
 #include <array>
 #include "hef_internal.hpp"
+#include "device_internal.hpp"
 
 namespace hailort
 {
@@ -2995,6 +2996,69 @@ exit:
     return status;
 }
 
+hailo_status Control::get_monitoring_info(Device &device, CONTROL_PROTOCOL__dvm_options_t dvm,
+    CONTROL_PROTOCOL__power_measurement_types_t measurement_type, hailo_device_monitoring_info_t *monitoring_info)
+{
+    enum { TEMPERATURE = 0, POWER_MEASUREMENT, THROTTLING_STATE, CONTROLS_COUNT };
+    std::array<CONTROL_PROTOCOL__request_t, CONTROLS_COUNT> requests = {};
+    std::array<std::array<uint8_t, RESPONSE_MAX_BUFFER_SIZE>, CONTROLS_COUNT> response_buffers = {};
+    std::array<size_t, CONTROLS_COUNT> request_sizes = {};
+
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(monitoring_info);
+
+    /* The sequence of each request is set when it's sent (see DeviceBase::fw_interact_batch_impl) */
+    auto common_status = CONTROL_PROTOCOL__pack_get_chip_temperature_request(&requests[TEMPERATURE],
+        &request_sizes[TEMPERATURE], device.get_control_sequence());
+    auto status = (HAILO_COMMON_STATUS__SUCCESS == common_status) ? HAILO_SUCCESS : HAILO_INTERNAL_FAILURE;
+    CHECK_SUCCESS(status);
+
+    common_status = CONTROL_PROTOCOL__pack_power_measurement_request(&requests[POWER_MEASUREMENT],
+        &request_sizes[POWER_MEASUREMENT], device.get_control_sequence(), dvm, measurement_type);
+    status = (HAILO_COMMON_STATUS__SUCCESS == common_status) ? HAILO_SUCCESS : HAILO_INTERNAL_FAILURE;
+    CHECK_SUCCESS(status);
+
+    common_status = CONTROL_PROTOCOL__pack_get_throttling_state_request(&requests[THROTTLING_STATE],
+        &request_sizes[THROTTLING_STATE], device.get_control_sequence());
+    status = (HAILO_COMMON_STATUS__SUCCESS == common_status) ? HAILO_SUCCESS : HAILO_INTERNAL_FAILURE;
+    CHECK_SUCCESS(status);
+
+    std::vector<CONTROL_PROTOCOL__transaction_t> transactions;
+    transactions.reserve(CONTROLS_COUNT);
+    for (size_t i = 0; i < CONTROLS_COUNT; i++) {
+        transactions.push_back({(uint8_t*)(&requests[i]), request_sizes[i], response_buffers[i].data(),
+            response_buffers[i].size()});
+    }
+    status = static_cast<DeviceBase&>(device).fw_interact_batch(transactions);
+    CHECK_SUCCESS(status);
+
+    /* Parse responses */
+    std::array<CONTROL_PROTOCOL__payload_t*, CONTROLS_COUNT> payloads = {};
+    for (size_t i = 0; i < CONTROLS_COUNT; i++) {
+        CONTROL_PROTOCOL__response_header_t *header = NULL;
+        status = parse_and_validate_response(response_buffers[i].data(), (uint32_t)(transactions[i].response_size),
+            &header, &payloads[i], &requests[i]);
+        CHECK_SUCCESS(status);
+    }
+
+    const auto *temps = (CONTROL_PROTOCOL__get_chip_temperature_response_t *)(payloads[TEMPERATURE]->parameters);
+    monitoring_info->temperature_info.sample_count = BYTE_ORDER__ntohs(temps->info.sample_count);
+    monitoring_info->temperature_info.ts0_temperature = temps->info.ts0_temperature;
+    monitoring_info->temperature_info.ts1_temperature = temps->info.ts1_temperature;
+
+    const auto *power_response = (CONTROL_PROTOCOL__power_measurement_response_t*)(payloads[POWER_MEASUREMENT]->parameters);
+    if (CONTROL_PROTOCOL__DVM_OPTIONS_OVERCURRENT_PROTECTION == power_response->dvm) {
+        LOGGER__WARN(OVERCURRENT_PROTECTION_WARNING);
+    }
+    monitoring_info->power_measurement = power_response->power_measurement;
+
+    const auto *throttling_state_response =
+        (CONTROL_PROTOCOL__get_throttling_state_response_t *)(payloads[THROTTLING_STATE]->parameters);
+    monitoring_info->throttling_active = throttling_state_response->is_active;
+
+    return HAILO_SUCCESS;
+}
+
 hailo_status Control::enable_debugging(Device &device, bool is_rma)
 {
     hailo_status status = HAILO_UNINITIALIZED;
@@ -349,6 +349,9 @@ public:
     static hailo_status previous_system_state(Device &device, uint8_t cpu_id, CONTROL_PROTOCOL__system_state_t *system_state);
     static hailo_status clear_configured_apps(Device &device);
     static hailo_status get_chip_temperature(Device &device, hailo_chip_temperature_info_t *temp_info);
+    // Sends the temperature, power measurement and throttling state controls in a single batch
+    static hailo_status get_monitoring_info(Device &device, CONTROL_PROTOCOL__dvm_options_t dvm,
+        CONTROL_PROTOCOL__power_measurement_types_t measurement_type, hailo_device_monitoring_info_t *monitoring_info);
     static hailo_status enable_debugging(Device &device, bool is_rma);
     
     static hailo_status config_context_switch_breakpoint(Device &device, uint8_t breakpoint_id,
@@ -30,6 +30,15 @@ typedef struct {
     CONTROL_PROTOCOL__communication_config_prams_t communication_params;
 } CONTROL_PROTOCOL__config_stream_params_t;
 
+/* A control request and the buffer of its response, for sending several controls at once */
+typedef struct {
+    uint8_t *request_buffer;
+    size_t request_size;
+    uint8_t *response_buffer;
+    /* The size of response_buffer, updated to the size of the received response (0 if no response is expected) */
+    size_t response_size;
+} CONTROL_PROTOCOL__transaction_t;
+
 static_assert(sizeof(CONTROL_PROTOCOL__context_switch_context_index_t) <= UINT8_MAX,
         "CONTROL_PROTOCOL__context_switch_context_index_t must fit in uint8_t");
 
@@ -327,6 +327,16 @@ Expected<hailo_chip_temperature_info_t> Device::get_chip_temperature()
     return res;
 }
 
+Expected<hailo_device_monitoring_info_t> Device::get_monitoring_info(hailo_dvm_options_t dvm,
+    hailo_power_measurement_types_t measurement_type)
+{
+    hailo_device_monitoring_info_t res = {};
+    auto status = Control::get_monitoring_info(*this, static_cast<CONTROL_PROTOCOL__dvm_options_t>(dvm),
+        static_cast<CONTROL_PROTOCOL__power_measurement_types_t>(measurement_type), &res);
+    CHECK_SUCCESS_AS_EXPECTED(status);
+    return res;
+}
+
 hailo_status Device::test_chip_memories()
 {
     return Control::test_chip_memories(*this);
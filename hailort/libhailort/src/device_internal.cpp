@@ -11,6 +11,7 @@
 #include "hailo/hailort.h"
 #include "control.hpp"
 #include "sensor_config_utils.hpp"
+#include "byte_order.h"
 
 namespace hailort
 {
@@ -76,6 +77,45 @@ hailo_status DeviceBase::reset(hailo_reset_device_mode_t mode)
     return reset_impl(reset_type);
 }
 
+hailo_status DeviceBase::fw_interact_batch(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions)
+{
+    for (const auto &transaction : transactions) {
+        CHECK_ARG_NOT_NULL(transaction.request_buffer);
+        CHECK_ARG_NOT_NULL(transaction.response_buffer);
+
+        const auto *request = reinterpret_cast<const CONTROL_PROTOCOL__request_t*>(transaction.request_buffer);
+        const auto opcode = BYTE_ORDER__ntohl(request->header.common_header.opcode);
+        CHECK(HAILO_CONTROL_OPCODE_COUNT > opcode, HAILO_INVALID_ARGUMENT, "Invalid control opcode {}", opcode);
+        /* Make sure that the version is supported or opcode is critical */
+        CHECK(m_is_control_version_supported || g_CONTROL_PROTOCOL__is_critical[opcode], HAILO_UNSUPPORTED_FW_VERSION,
+            "Operation {} is not allowed when FW version in not supported. Host supported FW version is {}.{}.{}",
+            opcode, FIRMWARE_VERSION_MAJOR, FIRMWARE_VERSION_MINOR, FIRMWARE_VERSION_REVISION);
+    }
+
+    auto status = fw_interact_batch_impl(transactions);
+    CHECK_SUCCESS(status);
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status DeviceBase::fw_interact_batch_impl(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions)
+{
+    for (auto &transaction : transactions) {
+        /* Each control is sent with its own sequence, as if it was sent by fw_interact */
+        auto *request = reinterpret_cast<CONTROL_PROTOCOL__request_t*>(transaction.request_buffer);
+        request->header.common_header.sequence = BYTE_ORDER__htonl(m_control_sequence);
+        const auto cpu_id = static_cast<hailo_cpu_id_t>(
+            g_CONTROL_PROTOCOL__cpu_id[BYTE_ORDER__ntohl(request->header.common_header.opcode)]);
+        auto status = fw_interact_impl(transaction.request_buffer, transaction.request_size,
+            transaction.response_buffer, &transaction.response_size, cpu_id);
+        // Always increment sequence
+        increment_control_sequence();
+        CHECK_SUCCESS(status);
+    }
+
+    return HAILO_SUCCESS;
+}
+
 hailo_status DeviceBase::set_notification_callback(const NotificationCallback &func, hailo_notification_id_t notification_id, void *opaque)
 {
     CHECK((0 <= notification_id) && (HAILO_NOTIFICATION_ID_COUNT > notification_id), HAILO_INVALID_ARGUMENT,
@@ -26,6 +26,7 @@
 #include "firmware_header.h"
 #include "firmware_header_utils.h"
 #include "control_protocol.h"
+#include "control_protocol.hpp"
 #include "hef_internal.hpp"
 
 #include <thread>
@@ -81,6 +82,10 @@ public:
     virtual hailo_status write_user_config(const MemoryView &buffer) override;
     virtual hailo_status erase_user_config() override;
 
+    // Sends several controls, which may be in flight at once (depending on the device). Each response is written to the
+    // response_buffer of its transaction, and its size to response_size
+    hailo_status fw_interact_batch(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions);
+
 protected:
     struct NotificationThreadSharedParams {
         NotificationThreadSharedParams() : is_running(false) {}
@@ -93,6 +98,8 @@ protected:
     
     virtual hailo_reset_device_mode_t get_default_reset_mode() = 0;
     virtual hailo_status reset_impl(CONTROL_PROTOCOL__reset_type_t reset_type) = 0;
+    // By default, the controls are sent one after the other
+    virtual hailo_status fw_interact_batch_impl(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions);
     virtual Expected<D2H_EVENT_MESSAGE_t> read_notification() = 0;
     virtual hailo_status disable_notifications() = 0;
     void start_d2h_notification_thread(const std::string &device_id);
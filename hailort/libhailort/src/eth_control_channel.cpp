@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file eth_control_channel.cpp
+ * @brief Pipelined control channel of an ethernet device
+ **/
+
+#include "eth_control_channel.hpp"
+#include "control.hpp"
+#include "byte_order.h"
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace hailort
+{
+
+EthernetControlChannel::EthernetControlChannel(Udp &udp) :
+    m_udp(udp),
+    m_max_outstanding_requests(get_max_outstanding_requests()),
+    m_sequence(0),
+    m_pending_controls(),
+    m_is_receiving(false)
+{}
+
+size_t EthernetControlChannel::get_max_outstanding_requests()
+{
+    auto max_outstanding_requests_env = std::getenv(HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS_ENV_VAR);
+    if (nullptr != max_outstanding_requests_env) {
+        char *end = nullptr;
+        const auto max_outstanding_requests = std::strtoull(max_outstanding_requests_env, &end, 10);
+        if ((end != max_outstanding_requests_env) && ('\0' == *end) && (0 < max_outstanding_requests)) {
+            return static_cast<size_t>(max_outstanding_requests);
+        }
+        LOGGER__WARNING("Invalid value for {} ('{}'), ignoring it", HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS_ENV_VAR,
+            max_outstanding_requests_env);
+    }
+    return DEFAULT_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS;
+}
+
+uint32_t EthernetControlChannel::allocate_sequence()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto sequence = m_sequence;
+    m_sequence = (m_sequence + 1) % CONTROL__MAX_SEQUENCE;
+    return sequence;
+}
+
+hailo_status EthernetControlChannel::fw_interact(uint8_t *request_buffer, size_t request_size,
+    uint8_t *response_buffer, size_t *response_size)
+{
+    CHECK_ARG_NOT_NULL(request_buffer);
+    CHECK_ARG_NOT_NULL(response_buffer);
+    CHECK_ARG_NOT_NULL(response_size);
+
+    std::vector<CONTROL_PROTOCOL__transaction_t> transactions{{request_buffer, request_size, response_buffer, *response_size}};
+    auto status = fw_interact_batch(transactions);
+    CHECK_SUCCESS(status);
+
+    *response_size = transactions[0].response_size;
+    return HAILO_SUCCESS;
+}
+
+hailo_status EthernetControlChannel::fw_interact_batch(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions)
+{
+    for (const auto &transaction : transactions) {
+        CHECK_ARG_NOT_NULL(transaction.request_buffer);
+        CHECK_ARG_NOT_NULL(transaction.response_buffer);
+        CHECK(sizeof(CONTROL_PROTOCOL__request_header_t) <= transaction.request_size, HAILO_INVALID_ARGUMENT,
+            "Control request is too small ({} bytes)", transaction.request_size);
+    }
+
+    const auto timeout = m_udp.get_timeout();
+    const auto max_number_of_attempts = m_udp.get_max_number_of_attempts();
+    std::vector<PendingControl> controls(transactions.size());
+    for (size_t i = 0; i < transactions.size(); i++) {
+        controls[i] = PendingControl{&transactions[i], 0, 0, {}, false, false, HAILO_UNINITIALIZED};
+    }
+
+    auto status = HAILO_SUCCESS;
+    size_t sent_count = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (HAILO_SUCCESS == status) {
+        /* Send the next controls, as long as there's room in the window (shared with the other threads) */
+        while ((sent_count < controls.size()) && (m_pending_controls.size() < m_max_outstanding_requests)) {
+            status = send_control(controls[sent_count], timeout);
+            if (HAILO_SUCCESS != status) {
+                break;
+            }
+            sent_count++;
+        }
+        if (HAILO_SUCCESS != status) {
+            break;
+        }
+
+        /* Handle the controls which weren't answered in time */
+        const auto now = std::chrono::steady_clock::now();
+        bool is_in_flight = false;
+        auto next_deadline = std::chrono::steady_clock::time_point::max();
+        for (size_t i = 0; i < sent_count; i++) {
+            auto &control = controls[i];
+            if (!control.is_done && (now >= control.deadline)) {
+                if (0 == control.transaction->response_size) {
+                    // We don't expect a response, so this timeout was predictable
+                    complete_control(control, HAILO_SUCCESS);
+                } else if (control.attempts < max_number_of_attempts) {
+                    LOGGER__WARN("Control response was not received, sending it again. Attempt number: {} (zero indexed)",
+                        control.attempts - 1);
+                    status = send_control(control, timeout);
+                    if (HAILO_SUCCESS != status) {
+                        break;
+                    }
+                } else {
+                    LOGGER__ERROR("Control response (sequence {}) was not received after {} attempts", control.sequence,
+                        control.attempts);
+                    status = HAILO_TIMEOUT;
+                    break;
+                }
+            }
+
+            if (!control.is_done) {
+                is_in_flight = true;
+                next_deadline = std::min(next_deadline, control.deadline);
+            }
+        }
+        if (HAILO_SUCCESS != status) {
+            break;
+        }
+
+        const auto failed_control = std::find_if(controls.begin(), controls.begin() + sent_count,
+            [](const PendingControl &control) { return control.is_done && (HAILO_SUCCESS != control.status); });
+        if (failed_control != (controls.begin() + sent_count)) {
+            status = failed_control->status;
+            break;
+        }
+        if ((controls.size() == sent_count) && !is_in_flight) {
+            break;
+        }
+
+        if (is_in_flight && !m_is_receiving) {
+            /* Receive a single response on behalf of all of the threads (without blocking their sends) */
+            m_is_receiving = true;
+            lock.unlock();
+            uint8_t response_buffer[MAX_UDP_PAYLOAD_SIZE];
+            size_t response_size = sizeof(response_buffer);
+            const auto recv_status = m_udp.recv_control_response(response_buffer, &response_size);
+            lock.lock();
+            m_is_receiving = false;
+
+            if (HAILO_SUCCESS == recv_status) {
+                dispatch_response(response_buffer, response_size);
+            } else if ((HAILO_TIMEOUT != recv_status) && (HAILO_ETH_RECV_FAILURE != recv_status)) {
+                // Timeouts and receive failures are handled by sending the controls again
+                status = recv_status;
+            }
+            m_cv.notify_all();
+        } else if (is_in_flight) {
+            m_cv.wait_until(lock, next_deadline);
+        } else {
+            // Waiting for room in the window
+            m_cv.wait(lock);
+        }
+    }
+
+    /* Remove the controls which won't be waited for anymore (on failure) */
+    for (const auto &control : controls) {
+        if (control.is_sent && !control.is_done) {
+            m_pending_controls.erase(control.sequence);
+        }
+    }
+    lock.unlock();
+    m_cv.notify_all();
+
+    return status;
+}
+
+hailo_status EthernetControlChannel::send_control(PendingControl &control, std::chrono::milliseconds timeout)
+{
+    auto *request = reinterpret_cast<CONTROL_PROTOCOL__request_t*>(control.transaction->request_buffer);
+    if (!control.is_sent) {
+        /* Sequences are allocated while sending (under the lock), so the device gets them in order */
+        control.sequence = m_sequence;
+        m_sequence = (m_sequence + 1) % CONTROL__MAX_SEQUENCE;
+        request->header.common_header.sequence = BYTE_ORDER__htonl(control.sequence);
+        m_pending_controls[control.sequence] = &control;
+        control.is_sent = true;
+    }
+    // A control is sent again with its original sequence, since the FW ignores duplicated controls (so a control whose
+    // response was lost doesn't run twice). It stays mapped under its sequence until it's done, and the responses to
+    // its other attempts are discarded then.
+
+    control.attempts++;
+    control.deadline = std::chrono::steady_clock::now() + timeout;
+
+    size_t request_size = control.transaction->request_size;
+    auto status = m_udp.send(control.transaction->request_buffer, &request_size, false, MAX_UDP_PAYLOAD_SIZE);
+    if (HAILO_ETH_SEND_FAILURE == status) {
+        // The control will be sent again once its deadline passes
+        return HAILO_SUCCESS;
+    }
+    CHECK_SUCCESS(status);
+
+    /* Validate all bytes were actually sent */
+    CHECK(control.transaction->request_size == request_size, HAILO_ETH_FAILURE,
+        "Did not send all data at EthernetControlChannel::send_control. Expected to send: {}, actually sent: {}",
+        control.transaction->request_size, request_size);
+
+    return HAILO_SUCCESS;
+}
+
+void EthernetControlChannel::complete_control(PendingControl &control, hailo_status status)
+{
+    m_pending_controls.erase(control.sequence);
+    control.is_done = true;
+    control.status = status;
+}
+
+void EthernetControlChannel::dispatch_response(uint8_t *buffer, size_t size)
+{
+    uint32_t received_sequence = 0;
+    auto common_status = CONTROL_PROTOCOL__get_sequence_from_response_buffer(buffer, size, &received_sequence);
+    if (HAILO_COMMON_STATUS__SUCCESS != common_status) {
+        LOGGER__WARNING("Invalid control response received ({} bytes). Discarding it.", size);
+        return;
+    }
+
+    auto pending_control = m_pending_controls.find(received_sequence);
+    if (m_pending_controls.end() == pending_control) {
+        /* A response to a control which was sent again, or to a control of a failed batch */
+        LOGGER__WARNING("Invalid sequence received (received {}, not waiting for it). Discarding it.", received_sequence);
+        return;
+    }
+
+    auto &control = *pending_control->second;
+    if (0 == control.transaction->response_size) {
+        // A response wasn't expected, so there's nothing to copy
+        complete_control(control, HAILO_SUCCESS);
+        return;
+    }
+    if (size > control.transaction->response_size) {
+        LOGGER__ERROR("Control response (sequence {}) is too big ({} bytes, buffer size is {})", received_sequence, size,
+            control.transaction->response_size);
+        complete_control(control, HAILO_INSUFFICIENT_BUFFER);
+        return;
+    }
+
+    memcpy(control.transaction->response_buffer, buffer, size);
+    control.transaction->response_size = size;
+    complete_control(control, HAILO_SUCCESS);
+}
+
+} /* namespace hailort */
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file eth_control_channel.hpp
+ * @brief Pipelined control channel of an ethernet device
+ *
+ * By default, controls are sent in lock step - a control is sent only after the response of the previous one was
+ * received, so a monitoring loop pays a full network round trip per control. Setting
+ * HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS allows several controls (of one or more threads) to be in flight at once.
+ * Each control gets its own sequence when it's sent, and the responses are matched to the waiting controls by their
+ * sequence. A single waiting thread receives from the socket at a time, and dispatches every response to the control
+ * it belongs to (the other threads wait for it to do so). Controls which weren't answered in time are sent again with
+ * the same sequence (which the FW ignores if it already handled it), up to the max number of attempts.
+ **/
+
+#ifndef HAILO_ETH_CONTROL_CHANNEL_HPP_
+#define HAILO_ETH_CONTROL_CHANNEL_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+#include "control_protocol.hpp"
+#include "udp.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace hailort
+{
+
+#define HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS_ENV_VAR "HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS"
+#define DEFAULT_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS (1)
+
+class EthernetControlChannel final
+{
+public:
+    EthernetControlChannel(Udp &udp);
+
+    EthernetControlChannel(const EthernetControlChannel &other) = delete;
+    EthernetControlChannel &operator=(const EthernetControlChannel &other) = delete;
+    EthernetControlChannel &operator=(EthernetControlChannel &&other) = delete;
+    EthernetControlChannel(EthernetControlChannel &&other) = delete;
+
+    hailo_status fw_interact(uint8_t *request_buffer, size_t request_size, uint8_t *response_buffer,
+        size_t *response_size);
+    // Sends all of the controls, with up to the max outstanding requests in flight (shared between all threads)
+    hailo_status fw_interact_batch(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions);
+
+    // Returns the sequence of a control sent out of the channel (e.g. when waiting for the device to wake up)
+    uint32_t allocate_sequence();
+
+private:
+    struct PendingControl {
+        CONTROL_PROTOCOL__transaction_t *transaction;
+        uint32_t sequence;
+        uint8_t attempts;
+        std::chrono::steady_clock::time_point deadline;
+        bool is_sent;
+        bool is_done;
+        hailo_status status;
+    };
+
+    static size_t get_max_outstanding_requests();
+
+    // Called with m_mutex locked
+    hailo_status send_control(PendingControl &control, std::chrono::milliseconds timeout);
+    void complete_control(PendingControl &control, hailo_status status);
+    void dispatch_response(uint8_t *buffer, size_t size);
+
+    Udp &m_udp;
+    const size_t m_max_outstanding_requests;
+    uint32_t m_sequence;
+    // The sent controls waiting for a response, by sequence
+    std::map<uint32_t, PendingControl*> m_pending_controls;
+    bool m_is_receiving;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+} /* namespace hailort */
+
+#endif /* HAILO_ETH_CONTROL_CHANNEL_HPP_ */
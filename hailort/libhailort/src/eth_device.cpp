@@ -37,7 +37,12 @@ hailo_status EthernetDevice::fw_interact_impl(uint8_t *request_buffer, size_t re
 {   
     /* CPU id is used only in PCIe, for Eth all control goes to APP CPU.*/
     (void)cpu_id;
-    return m_control_udp.fw_interact(request_buffer, request_size, response_buffer, response_size, m_control_sequence);
+    return m_control_channel.fw_interact(request_buffer, request_size, response_buffer, response_size);
+}
+
+hailo_status EthernetDevice::fw_interact_batch_impl(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions)
+{
+    return m_control_channel.fw_interact_batch(transactions);
 }
 
 hailo_status EthernetDevice::wait_for_wakeup()
@@ -63,15 +68,13 @@ hailo_status EthernetDevice::wait_for_wakeup()
     CHECK_SUCCESS(status);
 
     /* Create and send identify-control until it runs successfully */
-    common_status = CONTROL_PROTOCOL__pack_identify_request(&request, &request_size, m_control_sequence);
+    const auto sequence = m_control_channel.allocate_sequence();
+    common_status = CONTROL_PROTOCOL__pack_identify_request(&request, &request_size, sequence);
     status = (HAILO_COMMON_STATUS__SUCCESS == common_status) ? HAILO_SUCCESS : HAILO_INTERNAL_FAILURE;
     CHECK_SUCCESS(status);
     
     status = udp->fw_interact((uint8_t*)(&request), request_size, (uint8_t*)&response_buffer, &response_size,
-        m_control_sequence);
-
-    // Always increment sequence
-    m_control_sequence = (m_control_sequence + 1) % CONTROL__MAX_SEQUENCE;
+        sequence);
     CHECK_SUCCESS(status);
 
     /* Parse and validate the response */
@@ -109,7 +112,8 @@ Expected<std::unique_ptr<EthernetDevice>> EthernetDevice::create(const std::stri
 EthernetDevice::EthernetDevice(const hailo_eth_device_info_t &device_info, Udp &&control_udp, hailo_status &status) :
     DeviceBase::DeviceBase(Device::Type::ETH),
     m_device_info(device_info),
-    m_control_udp(std::move(control_udp))
+    m_control_udp(std::move(control_udp)),
+    m_control_channel(m_control_udp)
 {
     char ip_buffer[INET_ADDRSTRLEN];
     status = Socket::ntop(AF_INET, &(device_info.device_address.sin_addr), ip_buffer, INET_ADDRSTRLEN);
@@ -292,7 +296,7 @@ Expected<hailo_eth_device_info_t> EthernetDevice::parse_eth_device_info(const st
 
 void EthernetDevice::increment_control_sequence()
 {
-    m_control_sequence = (m_control_sequence + 1) % CONTROL__MAX_SEQUENCE;
+    // The sequence of each control is allocated by m_control_channel when it's sent (controls may be sent concurrently)
 }
 
 hailo_reset_device_mode_t EthernetDevice::get_default_reset_mode()
@@ -16,6 +16,7 @@
 #include "hailo/hailort.h"
 #include "device_internal.hpp"
 #include "udp.hpp"
+#include "eth_control_channel.hpp"
 #include "context_switch/single_context/hcp_config_network_group.hpp"
 
 namespace hailort
@@ -25,6 +26,7 @@ class EthernetDevice : public DeviceBase {
 public:
     virtual hailo_status fw_interact_impl(uint8_t *request_buffer, size_t request_size,
         uint8_t *response_buffer, size_t *response_size, hailo_cpu_id_t cpu_id) override;
+    virtual hailo_status fw_interact_batch_impl(std::vector<CONTROL_PROTOCOL__transaction_t> &transactions) override;
     virtual Expected<size_t> read_log(MemoryView &buffer, hailo_cpu_id_t cpu_id) override;
     virtual hailo_status wait_for_wakeup() override;
     virtual void increment_control_sequence() override;
@@ -69,6 +71,7 @@ private:
     const hailo_eth_device_info_t m_device_info;
     std::string m_device_id;
     Udp m_control_udp;
+    EthernetControlChannel m_control_channel;
     std::vector<std::shared_ptr<HcpConfigNetworkGroup>> m_network_groups;
     ActiveNetGroupHolder m_active_net_group_holder;
 };
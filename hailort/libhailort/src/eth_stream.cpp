@@ -12,6 +12,9 @@
 #include <new>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <cstdlib>
 #include <byte_order.h>
 
 #include <hailo/hailort.h>
@@ -30,6 +33,12 @@ namespace hailort
 
 #define SYNC_PACKET_BARKER (0xa143341a)
 
+static bool is_env_variable_on(const char *env_var_name)
+{
+    auto env_var = std::getenv(env_var_name);
+    return ((nullptr != env_var) && (strnlen(env_var, 2) == 1) && (strncmp(env_var, "1", 1) == 0));
+}
+
 
 typedef struct hailo_output_sync_packet_t {
     uint32_t barker;
@@ -133,6 +142,56 @@ Expected<size_t> EthernetInputStream::sync_write_raw_buffer(const MemoryView &bu
     return size;
 }
 
+hailo_status EthernetInputStream::sync_write_raw_packets(const MemoryView &buffer)
+{
+    hailo_status status = HAILO_UNINITIALIZED;
+
+    status = get_network_group_activated_event()->wait(std::chrono::milliseconds(0));
+    CHECK(HAILO_TIMEOUT != status, HAILO_NETWORK_GROUP_NOT_ACTIVATED, "Trying to write on stream before its network_group is activated");
+    CHECK_SUCCESS(status);
+
+    status = m_udp.send_multiple((uint8_t*)buffer.data(), buffer.size(), get_max_packet_size(),
+        this->configuration.use_dataflow_padding);
+    if (HAILO_STREAM_ABORTED_BY_USER == status) {
+        LOGGER__INFO("Udp send was aborted!");
+        return status;
+    }
+    CHECK_SUCCESS(status, "{} (H2D) failed with status={}", name(), status);
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status EthernetInputStream::sync_write_raw_packets(const MemoryView &buffer,
+    std::chrono::steady_clock::time_point send_time, uint32_t rate_bytes_per_sec)
+{
+    hailo_status status = HAILO_UNINITIALIZED;
+
+    status = get_network_group_activated_event()->wait(std::chrono::milliseconds(0));
+    CHECK(HAILO_TIMEOUT != status, HAILO_NETWORK_GROUP_NOT_ACTIVATED, "Trying to write on stream before its network_group is activated");
+    CHECK_SUCCESS(status);
+
+    status = m_udp.send_multiple_at((uint8_t*)buffer.data(), buffer.size(), get_max_packet_size(),
+        this->configuration.use_dataflow_padding, send_time, rate_bytes_per_sec);
+    if (HAILO_STREAM_ABORTED_BY_USER == status) {
+        LOGGER__INFO("Udp send was aborted!");
+        return status;
+    }
+    CHECK_SUCCESS(status, "{} (H2D) failed with status={}", name(), status);
+
+    return HAILO_SUCCESS;
+}
+
+size_t EthernetInputStream::get_max_packet_size() const
+{
+    size_t packet_size = this->configuration.max_payload_size;
+
+    //if we have padding, consider it when calculating the packet sizes
+    if (this->configuration.use_dataflow_padding) {
+        packet_size -= PADDING_BYTES_SIZE + PADDING_ALIGN_BYTES;
+    }
+    return packet_size;
+}
+
 hailo_status EthernetInputStream::sync_write_all_raw_buffer_no_transform_impl(void *buffer, size_t offset, size_t size)
 {
     hailo_status status = HAILO_UNINITIALIZED;
@@ -160,12 +219,7 @@ hailo_status EthernetInputStream::sync_write_all_raw_buffer_no_transform_impl(vo
 
 hailo_status EthernetInputStream::eth_stream__write_all_no_sync(void *buffer, size_t offset, size_t size) {
     size_t remainder_size = 0;
-    size_t packet_size = this->configuration.max_payload_size;
-
-    //if we have padding, consider it when calculating the packet sizes
-    if (this->configuration.use_dataflow_padding) {
-        packet_size -= PADDING_BYTES_SIZE + PADDING_ALIGN_BYTES;
-    }
+    size_t packet_size = get_max_packet_size();
 
     remainder_size = size % packet_size;
 
@@ -176,18 +230,17 @@ hailo_status EthernetInputStream::eth_stream__write_all_no_sync(void *buffer, si
 }
 
 hailo_status EthernetInputStream::eth_stream__write_with_remainder(void *buffer, size_t offset, size_t size, size_t remainder_size) {
-    size_t transfer_size = 0;
     size_t offset_end_without_remainder = offset + size - remainder_size;
 
-    while (offset < offset_end_without_remainder) {
-        transfer_size = offset_end_without_remainder - offset;
-        auto expected_bytes_written = sync_write_raw_buffer(MemoryView(static_cast<uint8_t*>(buffer) + offset, transfer_size));
-        if (HAILO_STREAM_ABORTED_BY_USER == expected_bytes_written.status()) {
-            LOGGER__INFO("sync_write_raw_buffer was aborted!");
-            return expected_bytes_written.status();
+    if (offset < offset_end_without_remainder) {
+        auto status = sync_write_raw_packets(MemoryView(static_cast<uint8_t*>(buffer) + offset,
+            offset_end_without_remainder - offset));
+        if (HAILO_STREAM_ABORTED_BY_USER == status) {
+            LOGGER__INFO("sync_write_raw_packets was aborted!");
+            return status;
         }
-        CHECK_EXPECTED_AS_STATUS(expected_bytes_written);
-        offset += expected_bytes_written.release();
+        CHECK_SUCCESS(status);
+        offset = offset_end_without_remainder;
     }
     if (0 < remainder_size) {
         auto expected_bytes_written = sync_write_raw_buffer(MemoryView(static_cast<uint8_t*>(buffer) + offset, remainder_size));
@@ -213,49 +266,152 @@ EthernetInputStreamRateLimited::EthernetInputStreamRateLimited(EthernetInputStre
     rate_bytes_per_sec(other.rate_bytes_per_sec)
 {}
 
+const std::chrono::microseconds TokenBucketEthernetInputStream::TX_TIME_MAX_LEAD(1000);
+
+Expected<std::unique_ptr<TokenBucketEthernetInputStream>> TokenBucketEthernetInputStream::create(Device &device,
+    Udp &&udp, EventPtr &&network_group_activated_event, uint32_t rate_bytes_per_sec, const LayerInfo &layer_info)
+{
+    bool use_tx_time = false;
+    if (is_env_variable_on(HAILO_ETH_INPUT_USE_TX_TIME_ENV_VAR)) {
+        const auto status = udp.enable_tx_time();
+        if (HAILO_SUCCESS == status) {
+            use_tx_time = true;
+        } else {
+            LOGGER__WARNING("Kernel pacing (SO_TXTIME) isn't supported, pacing {} in user space", layer_info.name);
+        }
+    }
+
+    auto status = HAILO_UNINITIALIZED;
+    // Note: we don't use make_unique because TokenBucketEthernetInputStream's ctor is private
+    auto stream_ptr = std::unique_ptr<TokenBucketEthernetInputStream>(new (std::nothrow)
+        TokenBucketEthernetInputStream(device, std::move(udp), std::move(network_group_activated_event),
+        rate_bytes_per_sec, layer_info, use_tx_time, status));
+    CHECK_AS_EXPECTED(nullptr != stream_ptr, HAILO_OUT_OF_HOST_MEMORY);
+    CHECK_SUCCESS_AS_EXPECTED(status);
+    return stream_ptr;
+}
+
 TokenBucketEthernetInputStream::TokenBucketEthernetInputStream(Device &device, Udp &&udp,
-    EventPtr &&network_group_activated_event, uint32_t rate_bytes_per_sec, const LayerInfo &layer_info, hailo_status &status) :
+    EventPtr &&network_group_activated_event, uint32_t rate_bytes_per_sec, const LayerInfo &layer_info,
+    bool use_tx_time, hailo_status &status) :
     EthernetInputStreamRateLimited::EthernetInputStreamRateLimited(device, std::move(udp),
         std::move(network_group_activated_event), rate_bytes_per_sec, layer_info, status),
-    token_bucket()
+    token_bucket(),
+    m_pacing_interval(get_pacing_interval()),
+    m_use_tx_time(use_tx_time),
+    m_next_send_time()
 {}
 
 TokenBucketEthernetInputStream::TokenBucketEthernetInputStream(TokenBucketEthernetInputStream &&other) :
     EthernetInputStreamRateLimited(std::move(other)),
-    token_bucket(std::move(other.token_bucket))
+    token_bucket(std::move(other.token_bucket)),
+    m_pacing_interval(other.m_pacing_interval),
+    m_use_tx_time(other.m_use_tx_time),
+    m_next_send_time(other.m_next_send_time)
 {}
 
+std::chrono::microseconds TokenBucketEthernetInputStream::get_pacing_interval()
+{
+    auto pacing_interval_env = std::getenv(HAILO_ETH_INPUT_PACING_INTERVAL_USEC_ENV_VAR);
+    if (nullptr != pacing_interval_env) {
+        char *end = nullptr;
+        const auto pacing_interval = std::strtoull(pacing_interval_env, &end, 10);
+        if ((end != pacing_interval_env) && ('\0' == *end)) {
+            return std::chrono::microseconds(pacing_interval);
+        }
+        LOGGER__WARNING("Invalid value for {} ('{}'), ignoring it", HAILO_ETH_INPUT_PACING_INTERVAL_USEC_ENV_VAR,
+            pacing_interval_env);
+    }
+    return std::chrono::microseconds(DEFAULT_ETH_INPUT_PACING_INTERVAL_USEC);
+}
+
+size_t TokenBucketEthernetInputStream::get_burst_size() const
+{
+    const auto packet_size = get_max_packet_size();
+    if (m_use_tx_time) {
+        // The kernel spreads the packets of the burst, so the burst is as large as a single send allows
+        return packet_size * MAX_DATAGRAMS_PER_CALL;
+    }
+
+    const auto interval_size = static_cast<size_t>(static_cast<uint64_t>(rate_bytes_per_sec) * m_pacing_interval.count() /
+        std::chrono::microseconds(std::chrono::seconds(1)).count());
+    const auto packets_per_burst = std::min(std::max(interval_size / packet_size, static_cast<size_t>(1)),
+        static_cast<size_t>(MAX_DATAGRAMS_PER_CALL));
+    return packets_per_burst * packet_size;
+}
+
+Expected<std::chrono::steady_clock::time_point> TokenBucketEthernetInputStream::acquire_send_time(size_t size,
+    size_t burst_size)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto send_duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(size) / rate_bytes_per_sec));
+
+    if (m_use_tx_time) {
+        // The packets are scheduled back to back (and never before the packets which were already scheduled, otherwise
+        // the qdisc would reorder them). We only sleep to keep the schedule from running too far ahead of the kernel
+        auto send_time = std::max(now, m_next_send_time);
+        m_next_send_time = send_time + send_duration;
+        if ((send_time - now) > TX_TIME_MAX_LEAD) {
+            MicrosecTimer::sleep(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(send_time - now - TX_TIME_MAX_LEAD).count()));
+        }
+        return send_time;
+    }
+
+    // The bucket holds a single burst, so the tokens of a whole burst are acquired at once. Packets smaller than a
+    // burst (e.g. the remainder) may exceed burst_size only if it's a single packet
+    const auto bucket_size = std::max(burst_size, static_cast<size_t>(MAX_UDP_PAYLOAD_SIZE));
+    auto wait_time = token_bucket.consumeWithBorrowNonBlocking(static_cast<double>(size), rate_bytes_per_sec,
+        static_cast<double>(bucket_size));
+    CHECK_EXPECTED(wait_time, "Failed acquiring {} bytes from the token bucket (burst size {})", size, bucket_size);
+    if (0 < wait_time.value()) {
+        MicrosecTimer::sleep(static_cast<uint64_t>(wait_time.value() * std::chrono::microseconds(std::chrono::seconds(1)).count()));
+    }
+    return std::chrono::steady_clock::now();
+}
+
 hailo_status TokenBucketEthernetInputStream::eth_stream__write_with_remainder(void *buffer, size_t offset, size_t size, size_t remainder_size) {
-    size_t transfer_size = 0;
     size_t offset_end_without_remainder = offset + size - remainder_size;
-
-    assert(remainder_size <= MAX_CONSUME_SIZE);
-    static_assert(MAX_CONSUME_SIZE <= BURST_SIZE, "We are asking to consume more bytes than the size of the token bucket, this will fail");
+    const auto burst_size = get_burst_size();
 
     while (offset < offset_end_without_remainder) {
-        (void)token_bucket.consumeWithBorrowAndWait(MAX_CONSUME_SIZE, rate_bytes_per_sec, BURST_SIZE);
-    
-        transfer_size = offset_end_without_remainder - offset;
-        auto expected_bytes_written = sync_write_raw_buffer(MemoryView(static_cast<uint8_t*>(buffer) + offset, transfer_size));
-        if (HAILO_STREAM_ABORTED_BY_USER == expected_bytes_written.status()) {
-            LOGGER__INFO("sync_write_raw_buffer was aborted!");
-            return expected_bytes_written.status();
+        const auto transfer_size = std::min(burst_size, offset_end_without_remainder - offset);
+        auto send_time = acquire_send_time(transfer_size, burst_size);
+        CHECK_EXPECTED_AS_STATUS(send_time);
+
+        const auto burst = MemoryView(static_cast<uint8_t*>(buffer) + offset, transfer_size);
+        auto status = m_use_tx_time ? sync_write_raw_packets(burst, send_time.value(), rate_bytes_per_sec) :
+            sync_write_raw_packets(burst);
+        if (HAILO_STREAM_ABORTED_BY_USER == status) {
+            LOGGER__INFO("sync_write_raw_packets was aborted!");
+            return status;
         }
-        CHECK_EXPECTED_AS_STATUS(expected_bytes_written);
-        offset += expected_bytes_written.release();
+        CHECK_SUCCESS(status);
+        offset += transfer_size;
     }
     if (0 < remainder_size) {
-        // We don't static_assert that "remainder_size <= BURST_SIZE", so the call could fail in theory.
-        // However, since remainder_size is modulo MAX_UDP_PAYLOAD_SIZE and BURST_SIZE == MAX_UDP_PAYLOAD_SIZE, it should be smaller.
-        (void)token_bucket.consumeWithBorrowAndWait(static_cast<double>(remainder_size), rate_bytes_per_sec, BURST_SIZE);
-        
-        auto expected_bytes_written = sync_write_raw_buffer(MemoryView(static_cast<uint8_t*>(buffer) + offset, remainder_size));
-        if (HAILO_STREAM_ABORTED_BY_USER == expected_bytes_written.status()) {
-            LOGGER__INFO("sync_write_raw_buffer was aborted!");
-            return expected_bytes_written.status();
+        auto send_time = acquire_send_time(remainder_size, burst_size);
+        CHECK_EXPECTED_AS_STATUS(send_time);
+
+        const auto remainder = MemoryView(static_cast<uint8_t*>(buffer) + offset, remainder_size);
+        if (m_use_tx_time) {
+            // The remainder must be scheduled as well, an unscheduled packet would be sent before the scheduled ones
+            auto status = sync_write_raw_packets(remainder, send_time.value(), rate_bytes_per_sec);
+            if (HAILO_STREAM_ABORTED_BY_USER == status) {
+                LOGGER__INFO("sync_write_raw_packets was aborted!");
+                return status;
+            }
+            CHECK_SUCCESS(status);
+        } else {
+            auto expected_bytes_written = sync_write_raw_buffer(remainder);
+            if (HAILO_STREAM_ABORTED_BY_USER == expected_bytes_written.status()) {
+                LOGGER__INFO("sync_write_raw_buffer was aborted!");
+                return expected_bytes_written.status();
+            }
+            CHECK_EXPECTED_AS_STATUS(expected_bytes_written);
+            assert(expected_bytes_written.value() == remainder_size);
         }
-        CHECK_EXPECTED_AS_STATUS(expected_bytes_written);
-        assert(expected_bytes_written.value() == remainder_size);
     }
 
     return HAILO_SUCCESS;
@@ -379,18 +535,22 @@ Expected<std::unique_ptr<EthernetInputStream>> EthernetInputStream::create(Devic
             new (std::nothrow) EthernetInputStream(device, udp.release(), std::move(network_group_activated_event), edge_layer, status));
         CHECK_SUCCESS_AS_EXPECTED(status);
     } else {
-#ifdef _MSC_VER
-        // TODO: Add factory class
-        local_stream = std::unique_ptr<EthernetInputStream>(
-            new (std::nothrow) TokenBucketEthernetInputStream(device, udp.release(),
-            std::move(network_group_activated_event), params.rate_limit_bytes_per_sec, edge_layer, status));
-        CHECK_SUCCESS_AS_EXPECTED(status);
-#else
-        auto stream_expected = TrafficControlEthernetInputStream::create(device, udp.release(),
-            std::move(network_group_activated_event), params.rate_limit_bytes_per_sec, edge_layer);
-        CHECK_EXPECTED(stream_expected);
-        local_stream = stream_expected.release();
+        // The inputs are paced in user space (or by the kernel, see TokenBucketEthernetInputStream). Linux tc rate
+        // limiting (which requires root) is used only on demand
+#if defined(__GNUC__)
+        if (is_env_variable_on(HAILO_ETH_INPUT_USE_TRAFFIC_CONTROL_ENV_VAR)) {
+            auto stream_expected = TrafficControlEthernetInputStream::create(device, udp.release(),
+                std::move(network_group_activated_event), params.rate_limit_bytes_per_sec, edge_layer);
+            CHECK_EXPECTED(stream_expected);
+            local_stream = stream_expected.release();
+        } else
 #endif
+        {
+            auto stream_expected = TokenBucketEthernetInputStream::create(device, udp.release(),
+                std::move(network_group_activated_event), params.rate_limit_bytes_per_sec, edge_layer);
+            CHECK_EXPECTED(stream_expected);
+            local_stream = stream_expected.release();
+        }
     }
 
     CHECK_AS_EXPECTED((nullptr != local_stream), HAILO_OUT_OF_HOST_MEMORY);
@@ -509,9 +669,9 @@ hailo_status EthernetOutputStream::read_all_no_sync(void *buffer, size_t offset,
     while (offset < offset_end) {
         transfer_size = offset_end - offset;
         MemoryView buffer_view(static_cast<uint8_t*>(buffer) + offset, transfer_size);
-        auto expected_bytes_read = this->sync_read_raw_buffer(buffer_view);
+        auto expected_bytes_read = this->sync_read_raw_packets(buffer_view);
         if (HAILO_STREAM_ABORTED_BY_USER == expected_bytes_read.status()) {
-            LOGGER__INFO("sync_read_raw_buffer was aborted!");
+            LOGGER__INFO("sync_read_raw_packets was aborted!");
             return expected_bytes_read.status();
         }
         CHECK_EXPECTED_AS_STATUS(expected_bytes_read);
@@ -680,6 +840,27 @@ Expected<size_t> EthernetOutputStream::sync_read_raw_buffer(MemoryView &buffer)
     return buffer_size;
 }
 
+Expected<size_t> EthernetOutputStream::sync_read_raw_packets(MemoryView &buffer)
+{
+    auto status = get_network_group_activated_event()->wait(std::chrono::milliseconds(0));
+    CHECK_AS_EXPECTED(HAILO_TIMEOUT != status, HAILO_NETWORK_GROUP_NOT_ACTIVATED, 
+        "Trying to read on stream before its network_group is activated");
+    CHECK_SUCCESS_AS_EXPECTED(status);
+
+    // The device sends packets of up to max_payload_size bytes
+    const size_t packet_size = std::min(static_cast<size_t>(this->configuration.max_payload_size),
+        static_cast<size_t>(MAX_UDP_PAYLOAD_SIZE));
+    auto buffer_size = buffer.size();
+    status = m_udp.recv_multiple((uint8_t*)buffer.data(), &buffer_size, packet_size);
+    if (HAILO_STREAM_ABORTED_BY_USER == status) {
+        LOGGER__INFO("Udp recv was aborted!");
+        return make_unexpected(status);
+    }
+    CHECK_SUCCESS_AS_EXPECTED(status, "{} (D2H) failed with status={}", name(), status);
+
+    return buffer_size;
+}
+
 hailo_status EthernetOutputStream::fill_output_stream_ptr_with_info(const hailo_eth_output_stream_params_t &params, EthernetOutputStream *stream)
 {
     if ((HAILO_FORMAT_ORDER_HAILO_NMS == stream->m_stream_info.format.order)
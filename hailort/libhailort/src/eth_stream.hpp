@@ -27,6 +27,11 @@
 namespace hailort
 {
 
+#define HAILO_ETH_INPUT_USE_TRAFFIC_CONTROL_ENV_VAR "HAILO_ETH_INPUT_USE_TRAFFIC_CONTROL"
+#define HAILO_ETH_INPUT_USE_TX_TIME_ENV_VAR "HAILO_ETH_INPUT_USE_TX_TIME"
+#define HAILO_ETH_INPUT_PACING_INTERVAL_USEC_ENV_VAR "HAILO_ETH_INPUT_PACING_INTERVAL_USEC"
+#define DEFAULT_ETH_INPUT_PACING_INTERVAL_USEC (200)
+
 // TODO: move those structs to hailort.h when implemented
 typedef struct {
     uint16_t max_payload_size;
@@ -58,8 +63,15 @@ private:
     void set_max_payload_size(uint16_t size);
 
 protected:
+    // The max data size of a single packet (excluding the dataflow padding)
+    size_t get_max_packet_size() const;
     virtual hailo_status eth_stream__write_with_remainder(void *buffer, size_t offset, size_t size, size_t remainder_size);
     virtual Expected<size_t> sync_write_raw_buffer(const MemoryView &buffer) override;
+    // Writes the whole buffer as max size packets (the last one may be smaller), batched to as few syscalls as possible
+    hailo_status sync_write_raw_packets(const MemoryView &buffer);
+    // Like sync_write_raw_packets, but the packets are sent by the kernel at their tx times (see Udp::send_multiple_at)
+    hailo_status sync_write_raw_packets(const MemoryView &buffer, std::chrono::steady_clock::time_point send_time,
+        uint32_t rate_bytes_per_sec);
     virtual hailo_status sync_write_all_raw_buffer_no_transform_impl(void *buffer, size_t offset, size_t size) override;
 
 public:
@@ -98,23 +110,36 @@ public:
     virtual ~EthernetInputStreamRateLimited() = default;
 };
 
+// Paces the packets in bursts - the tokens of a whole burst are acquired at once, and the burst is sent by a single
+// batched send. A burst is what the rate allows in the pacing interval (at least a single packet), so the thread wakes
+// up once per burst instead of once per packet.
+// If HAILO_ETH_INPUT_USE_TX_TIME is set, the packets are paced by the kernel instead (SO_TXTIME, requires the fq qdisc
+// on the outgoing interface): each packet gets its own send time, and the thread only sleeps to stay at most
+// TX_TIME_MAX_LEAD ahead of the schedule.
 class TokenBucketEthernetInputStream : public EthernetInputStreamRateLimited {
 private:
     DynamicTokenBucket token_bucket;
-    // Note:
-    // * We set the token bucket's burst size to be our MTU. If we'd use larger burst sizes
-    //   we could send packets faster than the desired rate.
-    // * We send packets with at most MAX_UDP_PAYLOAD_SIZE bytes of data. Hence we won't
-    //   consume more than MAX_UDP_PAYLOAD_SIZE tokens from the token bucket.
-    static const uint32_t BURST_SIZE = MAX_UDP_PAYLOAD_SIZE;
-    static const uint32_t MAX_CONSUME_SIZE = MAX_UDP_PAYLOAD_SIZE;
+    const std::chrono::microseconds m_pacing_interval;
+    const bool m_use_tx_time;
+    // The send time of the next packet (when m_use_tx_time is set)
+    std::chrono::steady_clock::time_point m_next_send_time;
+
+    static const std::chrono::microseconds TX_TIME_MAX_LEAD;
+
+    TokenBucketEthernetInputStream(Device &device, Udp &&udp, EventPtr &&network_group_activated_event,
+        uint32_t rate_bytes_per_sec, const LayerInfo &layer_info, bool use_tx_time, hailo_status &status);
+
+    static std::chrono::microseconds get_pacing_interval();
+    size_t get_burst_size() const;
+    // Waits until size bytes may be sent, and returns the time they should be sent at
+    Expected<std::chrono::steady_clock::time_point> acquire_send_time(size_t size, size_t burst_size);
 
 protected:
     virtual hailo_status eth_stream__write_with_remainder(void *buffer, size_t offset, size_t size, size_t remainder_size);
 
 public:
-    TokenBucketEthernetInputStream(Device &device, Udp &&udp, EventPtr &&network_group_activated_event,
-        uint32_t rate_bytes_per_sec, const LayerInfo &layer_info, hailo_status &status);
+    static Expected<std::unique_ptr<TokenBucketEthernetInputStream>> create(Device &device, Udp &&udp,
+        EventPtr &&network_group_activated_event, uint32_t rate_bytes_per_sec, const LayerInfo &layer_info);
     TokenBucketEthernetInputStream(TokenBucketEthernetInputStream &&other);
     virtual ~TokenBucketEthernetInputStream() = default;
 };
@@ -190,6 +215,8 @@ public:
     virtual ~EthernetOutputStream();
 
     virtual Expected<size_t> sync_read_raw_buffer(MemoryView &buffer);
+    // Reads the packets which already arrived (at least one) into the buffer, batched to as few syscalls as possible
+    Expected<size_t> sync_read_raw_packets(MemoryView &buffer);
 
     static Expected<std::unique_ptr<EthernetOutputStream>> create(Device &device, const LayerInfo &edge_layer,
         const hailo_eth_output_stream_params_t &params, EventPtr network_group_activated_event);
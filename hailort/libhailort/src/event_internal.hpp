@@ -80,6 +80,10 @@ private:
     static WaitHandleArray create_wait_handle_array(WaitablePtr waitable, EventPtr shutdown_event);
 };
 
+// Waits until any of the events is signaled (the events are not reset).
+// Returns the index of a signaled event, or HAILO_TIMEOUT if none of them was signaled.
+Expected<size_t> wait_for_any_event(const std::vector<EventPtr> &events, std::chrono::milliseconds timeout);
+
 } /* namespace hailort */
 
 #endif /* _EVENT_INTERNAL_HPP_ */
@@ -327,6 +327,17 @@ hailo_status hailo_get_chip_temperature(hailo_device device, hailo_chip_temperat
     return HAILO_SUCCESS;
 }
 
+hailo_status hailo_get_device_monitoring_info(hailo_device device, hailo_dvm_options_t dvm,
+    hailo_power_measurement_types_t measurement_type, hailo_device_monitoring_info_t *monitoring_info)
+{
+    CHECK_ARG_NOT_NULL(device);
+    CHECK_ARG_NOT_NULL(monitoring_info);
+    auto res = (reinterpret_cast<Device*>(device))->get_monitoring_info(dvm, measurement_type);
+    CHECK_EXPECTED_AS_STATUS(res);
+    *monitoring_info = res.release();
+    return HAILO_SUCCESS;
+}
+
 hailo_status hailo_reset_device(hailo_device device, hailo_reset_device_mode_t mode)
 {
     CHECK_ARG_NOT_NULL(device);
@@ -38,7 +38,8 @@ constexpr hailo_format_order_t DEFAULT_FORMAT_ORDER_MAP[] = {
     HAILO_FORMAT_ORDER_MAX_ENUM,            // Not used in device side - HAILO_FORMAT_ORDER_NV21,
     HAILO_FORMAT_ORDER_NV12,                // HAILO_FORMAT_ORDER_HAILO_YYUV,
     HAILO_FORMAT_ORDER_NV21,                // HAILO_FORMAT_ORDER_HAILO_YYVU,
-    HAILO_FORMAT_ORDER_MAX_ENUM             // Not used in device side - HAILO_FORMAT_ORDER_RGB4
+    HAILO_FORMAT_ORDER_MAX_ENUM,            // Not used in device side - HAILO_FORMAT_ORDER_RGB4
+    HAILO_FORMAT_ORDER_MAX_ENUM             // Not used in device side - HAILO_FORMAT_ORDER_HAILO_TOP_K
     };
 
 constexpr hailo_format_order_t DEFAULT_FORMAT_ARGMAX_ORDER_MAP[] = {
@@ -60,7 +61,8 @@ constexpr hailo_format_order_t DEFAULT_FORMAT_ARGMAX_ORDER_MAP[] = {
     HAILO_FORMAT_ORDER_MAX_ENUM,            // Not used in device side - HAILO_FORMAT_ORDER_NV21,
     HAILO_FORMAT_ORDER_NV12,                // HAILO_FORMAT_ORDER_HAILO_YYUV,
     HAILO_FORMAT_ORDER_NV21,                // HAILO_FORMAT_ORDER_HAILO_YYVU,
-    HAILO_FORMAT_ORDER_MAX_ENUM             // Not used in device side - HAILO_FORMAT_ORDER_RGB4
+    HAILO_FORMAT_ORDER_MAX_ENUM,            // Not used in device side - HAILO_FORMAT_ORDER_RGB4
+    HAILO_FORMAT_ORDER_MAX_ENUM             // Not used in device side - HAILO_FORMAT_ORDER_HAILO_TOP_K
 };
 
 
@@ -183,6 +185,7 @@ public:
         params.timeout_ms = HAILO_DEFAULT_VSTREAM_TIMEOUT_MS;
         params.vstream_stats_flags = HAILO_VSTREAM_STATS_NONE;
         params.pipeline_elements_stats_flags = HAILO_PIPELINE_ELEM_STATS_NONE;
+        params.top_k = HAILO_DEFAULT_VSTREAM_TOP_K;
         return params;
     }
 
@@ -225,8 +228,17 @@ public:
         return params;
     }
 
+    static constexpr hailo_vdma_output_stream_completion_params_t get_vdma_output_stream_completion_params() {
+        hailo_vdma_output_stream_completion_params_t params{};
+        params.completion_mode = HAILO_STREAM_COMPLETION_MODE_INTERRUPT;
+        params.busy_poll_timeout_us = HAILO_DEFAULT_BUSY_POLL_TIMEOUT_US;
+        params.transfers_per_interrupt = 1;
+        return params;
+    }
+
     static constexpr hailo_pcie_output_stream_params_t get_pcie_output_stream_params() {
         hailo_pcie_output_stream_params_t params{};
+        params.completion_params = get_vdma_output_stream_completion_params();
         return params;
     }
 
@@ -237,6 +249,7 @@ public:
 
     static constexpr hailo_core_output_stream_params_t get_core_output_stream_params() {
         hailo_core_output_stream_params_t params{};
+        params.completion_params = get_vdma_output_stream_completion_params();
         return params;
     }
 
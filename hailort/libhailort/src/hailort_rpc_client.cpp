@@ -89,6 +89,8 @@ Expected<std::vector<uint32_t>> HailoRtRpcClient::InputVStreams_create(uint32_t
     for (const auto &name_params_pair : inputs_params) {
         ProtoNamedVStreamParams proto_name_param_pair;
         auto vstream_params = name_params_pair.second;
+        CHECK_AS_EXPECTED(HAILO_PREPROCESS_SRC_FORMAT_NONE == vstream_params.preprocess_params.src_format, HAILO_NOT_SUPPORTED,
+            "Preprocessing is not supported with the multi-process service (vstream {})", name_params_pair.first);
 
         proto_name_param_pair.set_name(name_params_pair.first);
         auto proto_vstream_param = proto_name_param_pair.mutable_params();
@@ -146,6 +148,9 @@ Expected<std::vector<uint32_t>> HailoRtRpcClient::OutputVStreams_create(uint32_t
     for (const auto &name_params_pair : output_params) {
         ProtoNamedVStreamParams proto_name_param_pair;
         auto vstream_params = name_params_pair.second;
+        CHECK_AS_EXPECTED((HAILO_FORMAT_ORDER_HAILO_TOP_K != vstream_params.user_buffer_format.order) ||
+            (0 == vstream_params.top_k) || (HAILO_DEFAULT_VSTREAM_TOP_K == vstream_params.top_k), HAILO_NOT_SUPPORTED,
+            "Setting the top k is not supported with the multi-process service (vstream {})", name_params_pair.first);
 
         proto_name_param_pair.set_name(name_params_pair.first);
         auto proto_vstream_param = proto_name_param_pair.mutable_params();
@@ -222,6 +227,12 @@ Expected<std::vector<uint32_t>> HailoRtRpcClient::VDevice_configure(uint32_t vde
             auto stream_params = name_stream_params_pair.second;
             proto_stream_params->set_stream_interface(stream_params.stream_interface);
             proto_stream_params->set_direction(stream_params.direction);
+            if (HAILO_D2H_STREAM == stream_params.direction) {
+                const auto &completion_params = stream_params.pcie_output_params.completion_params;
+                proto_stream_params->set_completion_mode(completion_params.completion_mode);
+                proto_stream_params->set_busy_poll_timeout_us(completion_params.busy_poll_timeout_us);
+                proto_stream_params->set_transfers_per_interrupt(completion_params.transfers_per_interrupt);
+            }
         }
 
         // Init network params map
@@ -745,7 +756,11 @@ Expected<ConfigureNetworkParams> HailoRtRpcClient::ConfiguredNetworkGroup_get_co
                 .stream_interface = static_cast<hailo_stream_interface_t>(proto_streams_params.stream_interface()),
                 .direction = stream_direction,
                 {.pcie_output_params = {
-                    .reserved = 0
+                    .completion_params = {
+                        .completion_mode = static_cast<hailo_stream_completion_mode_t>(proto_streams_params.completion_mode()),
+                        .busy_poll_timeout_us = proto_streams_params.busy_poll_timeout_us(),
+                        .transfers_per_interrupt = static_cast<uint16_t>(proto_streams_params.transfers_per_interrupt())
+                    }
                 }}
             };
         }
@@ -38,12 +38,16 @@
 #include <algorithm>
 #include <cstring>
 #include <numeric>
+#include <list>
+#include <mutex>
 
 namespace hailort
 {
 
 #define HEF__MD5_BUFFER_SIZE (1024)
 #define DEFAULT_BATCH_SIZE (1)
+#define HEF_CACHE_SIZE_ENV_VAR "HAILO_HEF_CACHE_SIZE"
+#define DEFAULT_HEF_CACHE_SIZE (0)
 
 static const uint8_t ENABLE_LCU_CONTROL_WORD[4] = {1, 0, 0, 0};
 
@@ -263,28 +267,78 @@ Expected<Hef::Impl> Hef::Impl::create(const MemoryView &hef_buffer)
     return hef;
 }
 
-static hailo_status calc_istream_md5(std::ifstream &s, MD5_SUM_t &calculated_md5)
+size_t get_hef_process_cache_size()
 {
-    char md5_buffer[HEF__MD5_BUFFER_SIZE] = {};
-    MD5_CTX md5 = {};
+    auto cache_size_env = std::getenv(HEF_CACHE_SIZE_ENV_VAR);
+    if (nullptr == cache_size_env) {
+        return DEFAULT_HEF_CACHE_SIZE;
+    }
 
-    auto beg_pos = s.tellg();
-    CHECK(-1 != beg_pos, HAILO_FILE_OPERATION_FAILURE, "ifstream::tellg() failed");
+    char *end = nullptr;
+    const auto cache_size = std::strtoull(cache_size_env, &end, 10);
+    if ((end == cache_size_env) || ('\0' != *end)) {
+        LOGGER__WARNING("Invalid value for {} ('{}'), ignoring it", HEF_CACHE_SIZE_ENV_VAR, cache_size_env);
+        return DEFAULT_HEF_CACHE_SIZE;
+    }
+    return static_cast<size_t>(cache_size);
+}
 
-    MD5_Init(&md5);
-    while (!s.eof()) {
-        s.read(md5_buffer, HEF__MD5_BUFFER_SIZE);
-        CHECK(!s.bad(), HAILO_FILE_OPERATION_FAILURE, "ifstream::read() failed");
-        MD5_Update(&md5, &md5_buffer, static_cast<size_t>(s.gcount()));
+// Parsed hefs are kept per process (in LRU order), so that loading a hef with an already seen content (e.g. when a model
+// is swapped out and back in) skips the protobuf parsing and the metadata building. The cached state is not modified
+// after parsing, and the protos and metadata are shared (not copied) between the hefs created from the same content.
+// Since each entry keeps its protos and metadata alive for the life of the process (even after all the hefs created
+// from it were released), the cache is opt-in - its size is set with HAILO_HEF_CACHE_SIZE (disabled by default).
+class Hef::Impl::ParsedHefCache final
+{
+public:
+    static ParsedHefCache& get_instance()
+    {
+        static ParsedHefCache instance;
+        return instance;
     }
-    MD5_Final(calculated_md5, &md5);
 
-    s.clear();
-    s.seekg(beg_pos, s.beg);
-    CHECK(s.good(), HAILO_FILE_OPERATION_FAILURE, "ifstream::seekg() failed");
+    std::shared_ptr<const Impl> find(const MD5_SUM_t &md5)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = std::find_if(m_entries.begin(), m_entries.end(), [&md5](const std::shared_ptr<const Impl> &parsed_hef) {
+            return 0 == memcmp(parsed_hef->m_md5, md5, sizeof(MD5_SUM_t));
+        });
+        if (m_entries.end() == entry) {
+            return nullptr;
+        }
+
+        // Move the entry to the front (most recently used)
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        return m_entries.front();
+    }
 
-    return HAILO_SUCCESS;
-}
+    void insert(std::shared_ptr<const Impl> parsed_hef)
+    {
+        if (0 == m_capacity) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.push_front(parsed_hef);
+        while (m_entries.size() > m_capacity) {
+            m_entries.pop_back();
+        }
+    }
+
+    bool is_enabled() const
+    {
+        return (0 != m_capacity);
+    }
+
+private:
+    ParsedHefCache() :
+        m_capacity(get_hef_process_cache_size())
+    {}
+
+    std::mutex m_mutex;
+    const size_t m_capacity;
+    std::list<std::shared_ptr<const Impl>> m_entries;
+};
 
 hailo_status Hef::Impl::validate_hef_header(const hef__header_t &header, MD5_SUM_t &calculated_md5, size_t proto_size)
 {
@@ -323,59 +377,52 @@ void Hef::Impl::init_md5(MD5_SUM_t &calculated_md5)
     memcpy(m_md5, calculated_md5, sizeof(m_md5));
 }
 
+void Hef::Impl::copy_parsed_hef(const Impl &other)
+{
+    m_header = other.m_header;
+    m_included_features = other.m_included_features;
+    m_supported_features = other.m_supported_features;
+    m_groups = other.m_groups;
+    m_core_ops_per_group = other.m_core_ops_per_group;
+    m_post_process_ops_per_group = other.m_post_process_ops_per_group;
+    m_hef_extensions = other.m_hef_extensions;
+    m_hef_optional_extensions = other.m_hef_optional_extensions;
+    m_supported_extensions_bitset = other.m_supported_extensions_bitset;
+    memcpy(m_md5, other.m_md5, sizeof(m_md5));
+    m_network_group_metadata_per_arch = other.m_network_group_metadata_per_arch;
+}
+
 hailo_status Hef::Impl::parse_hef_file(const std::string &hef_path)
 {
+    // The file is mapped (instead of read), so that the md5 validation and the protobuf parsing are done in a single
+    // pass over the page cache, without holding another copy of the file on the heap.
+    auto hef_mapping = MmapBuffer<uint8_t>::create_file_map_readonly(hef_path);
+    if (HAILO_NOT_IMPLEMENTED == hef_mapping.status()) {
+        auto hef_buffer = read_binary_file(hef_path);
+        CHECK_EXPECTED_AS_STATUS(hef_buffer);
+        auto status = parse_hef_memview(MemoryView(hef_buffer.value()));
+        CHECK_SUCCESS(status);
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
-    auto hef_buffer = read_binary_file(hef_path);
-    CHECK_EXPECTED_AS_STATUS(hef_buffer);
-    m_hef_buffer = hef_buffer.release();
+        m_hef_buffer = hef_buffer.release();
 #endif // HAILO_SUPPORT_MULTI_PROCESS
+        return HAILO_SUCCESS;
+    }
+    CHECK_EXPECTED_AS_STATUS(hef_mapping, "Failed to map HEF file \"{}\"", hef_path);
+    CHECK(0 < hef_mapping->size(), HAILO_INVALID_HEF, "HEF file \"{}\" is empty", hef_path);
 
-    auto hef_file = std::ifstream(hef_path, std::ios::in | std::ios::binary);
-    CHECK(hef_file.is_open(), HAILO_OPEN_FILE_FAILURE, "Failed to open HEF file \"{}\". errno: {}", hef_path, errno);
-
-    hef__header_t header = {};
-    hef_file.read((char*)&header, sizeof(header));
-    CHECK(hef_file.good(), HAILO_FILE_OPERATION_FAILURE, "Failed reading HEF header");
-
-    auto proto_size = get_istream_size(hef_file);
-    CHECK_EXPECTED_AS_STATUS(proto_size);
-
-    MD5_SUM_t calculated_md5 = {};
-    auto status = calc_istream_md5(hef_file, calculated_md5);
-    CHECK_SUCCESS(status);
-
-    status = validate_hef_header(header, calculated_md5, proto_size.value());
-    CHECK_SUCCESS(status);
-
-    init_md5(calculated_md5);
-
-    ProtoHEFHef hef_message;
-    auto rb = hef_message.ParseFromIstream(&hef_file);
-    CHECK(rb, HAILO_INVALID_HEF, "Failed parsing HEF file");
-    status = transfer_protobuf_field_ownership(hef_message);
-    CHECK_SUCCESS(status);
-
-    fill_core_ops();
-
-    status = fill_networks_metadata();
+    auto status = parse_hef_memview(MemoryView(hef_mapping->get(), hef_mapping->size()));
     CHECK_SUCCESS(status);
 
-    // Must be called after fill_networks_metadata
-    status = validate_hef_extensions();
-    CHECK_SUCCESS(status);
+#ifdef HAILO_SUPPORT_MULTI_PROCESS
+    // The hef is sent to the service as is, so we keep the (read only, page cache backed) mapping instead of a copy
+    m_hef_mapping = hef_mapping.release();
+#endif // HAILO_SUPPORT_MULTI_PROCESS
 
     return HAILO_SUCCESS;
 }
 
 hailo_status Hef::Impl::parse_hef_memview(const MemoryView &hef_memview)
 {
-#ifdef HAILO_SUPPORT_MULTI_PROCESS
-    auto hef_buffer = Buffer::create(hef_memview.data(), hef_memview.size());
-    CHECK_EXPECTED_AS_STATUS(hef_buffer);
-    m_hef_buffer = hef_buffer.release();
-#endif // HAILO_SUPPORT_MULTI_PROCESS
-
     CHECK(hef_memview.size() >= sizeof(hef__header_t), HAILO_INVALID_HEF, "Invalid HEF header");
     const hef__header_t &header = reinterpret_cast<const hef__header_t&>(*hef_memview.data());
 
@@ -391,6 +438,14 @@ hailo_status Hef::Impl::parse_hef_memview(const MemoryView &hef_memview)
     auto status = validate_hef_header(header, calculated_md5, proto_size);
     CHECK_SUCCESS(status);
 
+    auto &parsed_hef_cache = ParsedHefCache::get_instance();
+    auto parsed_hef = parsed_hef_cache.find(calculated_md5);
+    if (nullptr != parsed_hef) {
+        LOGGER__DEBUG("HEF content was already parsed by this process, skipping parsing");
+        copy_parsed_hef(*parsed_hef);
+        return HAILO_SUCCESS;
+    }
+
     init_md5(calculated_md5);
 
     ProtoHEFHef hef_message;
@@ -408,6 +463,14 @@ hailo_status Hef::Impl::parse_hef_memview(const MemoryView &hef_memview)
     status = validate_hef_extensions();
     CHECK_SUCCESS(status);
 
+    if (parsed_hef_cache.is_enabled()) {
+        // Impl() is private, so make_shared can't be used here
+        auto new_parsed_hef = std::shared_ptr<Impl>(new (std::nothrow) Impl());
+        CHECK_NOT_NULL(new_parsed_hef, HAILO_OUT_OF_HOST_MEMORY);
+        new_parsed_hef->copy_parsed_hef(*this);
+        parsed_hef_cache.insert(new_parsed_hef);
+    }
+
     return HAILO_SUCCESS;
 }
 
@@ -428,7 +491,7 @@ hailo_status Hef::Impl::fill_networks_metadata()
             if (m_supported_features.hailo_net_flow) {
                 for (auto &partial_core_op : core_op.partial_core_ops) {
                     partial_clusters_layout_bitmap = partial_core_op->layout.partial_clusters_layout_bitmap();
-                    auto metadata_per_arch = create_metadata_per_arch(*(partial_core_op->core_op));
+                    auto metadata_per_arch = create_metadata_per_arch(*(partial_core_op->core_op), network_group);
                     CHECK_EXPECTED_AS_STATUS(metadata_per_arch);
                     auto &&arch_metadata = metadata_per_arch.release();
                     auto expected_net_flow_ops = create_network_group_ops(*network_group, arch_metadata);
@@ -448,7 +511,7 @@ hailo_status Hef::Impl::fill_networks_metadata()
                         partial_network_group.network_group().networks_names(),
                         {}
                     };
-                    auto metadata_per_arch = create_metadata_per_arch(partial_core_op);
+                    auto metadata_per_arch = create_metadata_per_arch(partial_core_op, network_group);
                     CHECK_EXPECTED_AS_STATUS(metadata_per_arch);
                     auto &&arch_metadata = metadata_per_arch.release();
                     std::vector<std::shared_ptr<hailort::NetFlowElement>> empty_ops;
@@ -458,7 +521,7 @@ hailo_status Hef::Impl::fill_networks_metadata()
             }
         } else {
             partial_clusters_layout_bitmap = PARTIAL_CLUSTERS_LAYOUT_IGNORE;
-            auto metadata_per_arch = create_metadata_per_arch(core_op);
+            auto metadata_per_arch = create_metadata_per_arch(core_op, network_group);
             CHECK_EXPECTED_AS_STATUS(metadata_per_arch);
             auto &&arch_metadata = metadata_per_arch.release();
             auto expected_net_flow_ops = create_network_group_ops(*network_group, arch_metadata);
@@ -506,12 +569,14 @@ static Expected<std::vector<ConfigChannelInfo>> parse_config_channels_info(const
     return config_channels_info;
 }
 
-Expected<NetworkGroupMetadata> Hef::Impl::create_metadata_per_arch(const ProtoHEFCoreOpMock &core_op)
+Expected<NetworkGroupMetadata> Hef::Impl::create_metadata_per_arch(const ProtoHEFCoreOpMock &core_op,
+    ProtoHEFNetworkGroupPtr network_group_proto)
 {
-    auto preliminary_context = HefUtils::parse_preliminary_context(core_op.preliminary_config, m_supported_features);
+    auto preliminary_context = HefUtils::parse_preliminary_context(core_op.preliminary_config, m_supported_features,
+        network_group_proto);
     CHECK_EXPECTED(preliminary_context);
 
-    auto dynamic_contexts = HefUtils::parse_dynamic_contexts(core_op, m_supported_features);
+    auto dynamic_contexts = HefUtils::parse_dynamic_contexts(core_op, m_supported_features, network_group_proto);
     CHECK_EXPECTED(dynamic_contexts);
 
     auto config_channels_info = parse_config_channels_info(core_op);
@@ -644,6 +709,9 @@ hailo_status Hef::Impl::transfer_protobuf_field_ownership(ProtoHEFHef &hef_messa
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
 const MemoryView Hef::Impl::get_hef_memview()
 {
+    if (m_hef_mapping) {
+        return MemoryView(m_hef_mapping.get(), m_hef_mapping.size());
+    }
     return MemoryView(m_hef_buffer);
 }
 #endif // HAILO_SUPPORT_MULTI_PROCESS
@@ -667,6 +735,16 @@ Hef::Impl::Impl(const MemoryView &hef_memview, hailo_status &status)
     status = HAILO_UNINITIALIZED;
     GOOGLE_PROTOBUF_VERIFY_VERSION;
 
+#ifdef HAILO_SUPPORT_MULTI_PROCESS
+    // The user's buffer may be released after the Hef is created
+    auto hef_buffer = Buffer::create(hef_memview.data(), hef_memview.size());
+    if (!hef_buffer) {
+        status = hef_buffer.status();
+        return;
+    }
+    m_hef_buffer = hef_buffer.release();
+#endif // HAILO_SUPPORT_MULTI_PROCESS
+
     status = parse_hef_memview(hef_memview);
     if (HAILO_SUCCESS != status) {
         LOGGER__ERROR("Failed parsing HEF buffer");
@@ -1632,12 +1710,11 @@ static Expected<ContextSwitchConfigActionPtr> parse_action(const ProtoHEFAction
                 "Invalid cfg channel index");
             const auto config_stream_index = static_cast<uint8_t>(proto_action.write_data_ccw().cfg_channel_index());
 
-            auto data = Buffer::create(
-                reinterpret_cast<const uint8_t*>(proto_action.write_data_ccw().data().data()),
+            // The ccw data is referenced (not copied) - the proto outlives the action (see create_operations_parser)
+            const auto data = MemoryView::create_const(proto_action.write_data_ccw().data().data(),
                 proto_action.write_data_ccw().data().length());
-            CHECK_EXPECTED(data);
 
-            return WriteDataCcwAction::create(data.release(), config_stream_index);
+            return WriteDataCcwAction::create(data, config_stream_index);
         }
         case ProtoHEFAction::kDisableLcu:
             CHECK_AS_EXPECTED(IS_FIT_IN_UINT8(proto_action.disable_lcu().cluster_index()), HAILO_INVALID_HEF,
@@ -1822,28 +1899,62 @@ static Expected<ConfigBufferInfoMap> get_config_buffer_info(
     return results;
 }
 
+struct ParsedOperations final
+{
+    std::mutex mutex;
+    std::unique_ptr<std::vector<ContextSwitchOperation>> operations;
+};
+
+// The operations are parsed when the network group is configured. The parser holds network_group_proto, so the
+// operations proto (and the ccw data referenced by the parsed actions) stays valid.
+// The parsed actions are immutable, so they are kept and shared by all the configurations of the network group (and of
+// other hefs with the same content, see ParsedHefCache).
+static ContextSwitchOperationsParser create_operations_parser(
+    const google::protobuf::RepeatedPtrField<ProtoHEFOperation> &operations_proto,
+    const SupportedFeatures &supported_features, ProtoHEFNetworkGroupPtr network_group_proto)
+{
+    const auto *operations_proto_ptr = &operations_proto;
+    auto parsed_operations = std::make_shared<ParsedOperations>();
+    return [operations_proto_ptr, supported_features, network_group_proto, parsed_operations]()
+        -> Expected<std::vector<ContextSwitchOperation>> {
+        std::lock_guard<std::mutex> lock(parsed_operations->mutex);
+        if (nullptr == parsed_operations->operations) {
+            auto operations = parse_operations(*operations_proto_ptr, supported_features);
+            CHECK_EXPECTED(operations);
+            parsed_operations->operations = make_unique_nothrow<std::vector<ContextSwitchOperation>>(operations.release());
+            CHECK_NOT_NULL_AS_EXPECTED(parsed_operations->operations, HAILO_OUT_OF_HOST_MEMORY);
+        }
+        return std::vector<ContextSwitchOperation>(*parsed_operations->operations);
+    };
+}
+
 Expected<PreliminaryContextMetadata> HefUtils::parse_preliminary_context(const ProtoHEFPreliminaryConfig &preliminary_proto,
-    const SupportedFeatures &supported_features)
+    const SupportedFeatures &supported_features, ProtoHEFNetworkGroupPtr network_group_proto)
 {
-    auto operations = parse_operations(preliminary_proto.operation(), supported_features);
-    CHECK_EXPECTED(operations);
+    CHECK_AS_EXPECTED(IS_FIT_IN_UINT8(preliminary_proto.operation().size()), HAILO_INVALID_HEF,
+        "Failed to parse HEF. Invalid operations_count: {}.", preliminary_proto.operation().size());
 
     auto config_buffer_infos = get_config_buffer_info(preliminary_proto.operation());
     CHECK_EXPECTED(config_buffer_infos);
 
-    return PreliminaryContextMetadata(operations.release(), config_buffer_infos.release());
+    return PreliminaryContextMetadata(
+        create_operations_parser(preliminary_proto.operation(), supported_features, network_group_proto),
+        config_buffer_infos.release());
 }
 
 Expected<ContextMetadata> HefUtils::parse_single_dynamic_context(const ProtoHEFCoreOpMock &core_op,
-    const ProtoHEFContext &context_proto, uint8_t context_index, const SupportedFeatures &supported_features)
+    const ProtoHEFContext &context_proto, uint8_t context_index, const SupportedFeatures &supported_features,
+    ProtoHEFNetworkGroupPtr network_group_proto)
 {
-    auto operations = parse_operations(context_proto.operations(), supported_features);
-    CHECK_EXPECTED(operations);
+    CHECK_AS_EXPECTED(IS_FIT_IN_UINT8(context_proto.operations().size()), HAILO_INVALID_HEF,
+        "Failed to parse HEF. Invalid operations_count: {}.", context_proto.operations().size());
 
     auto config_buffer_infos = get_config_buffer_info(context_proto.operations());
     CHECK_EXPECTED(config_buffer_infos);
 
-    ContextMetadata context_metadata(operations.release(), config_buffer_infos.release());
+    ContextMetadata context_metadata(
+        create_operations_parser(context_proto.operations(), supported_features, network_group_proto),
+        config_buffer_infos.release());
 
     for (const auto &edge_layer : context_proto.metadata().edge_layers()) { 
         if (ProtoHEFEdgeConnectionType::PROTO__EDGE_CONNECTION_TYPE__BOUNDARY ==
@@ -1891,12 +2002,14 @@ static hailo_status validate_unique_boundary_names(const std::vector<ContextMeta
     return HAILO_SUCCESS;
 }
 
-Expected<std::vector<ContextMetadata>> HefUtils::parse_dynamic_contexts(const ProtoHEFCoreOpMock &core_op, const SupportedFeatures &supported_features)
+Expected<std::vector<ContextMetadata>> HefUtils::parse_dynamic_contexts(const ProtoHEFCoreOpMock &core_op, const SupportedFeatures &supported_features,
+    ProtoHEFNetworkGroupPtr network_group_proto)
 {
     std::vector<ContextMetadata> contexts_metadata;
     for (uint8_t context_index = 0; context_index < core_op.contexts.size(); context_index++) {
         auto &context_proto = core_op.contexts[context_index];
-        auto context_metadata = parse_single_dynamic_context(core_op, context_proto, context_index, supported_features);
+        auto context_metadata = parse_single_dynamic_context(core_op, context_proto, context_index, supported_features,
+            network_group_proto);
         CHECK_EXPECTED(context_metadata);
         contexts_metadata.emplace_back(context_metadata.release());
     }
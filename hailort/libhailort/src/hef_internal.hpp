@@ -37,6 +37,7 @@
 #include "pipeline.hpp"
 
 #include "control_protocol.hpp"
+#include "os/mmap_buffer.hpp"
 
 #include <functional>
 #include <bitset>
@@ -188,6 +189,10 @@ class VdmaDevice;
 class HailoRTDriver;
 
 
+// Number of entries kept by the per process caches of the parsed hefs and of the context switch recipes built from
+// them (HAILO_HEF_CACHE_SIZE, 0 if they are disabled)
+size_t get_hef_process_cache_size();
+
 class Hef::Impl final
 {
 public:
@@ -346,6 +351,9 @@ public:
 #endif // HAILO_SUPPORT_MULTI_PROCESS
 
 private:
+    class ParsedHefCache;
+
+    Impl() = default;
     Impl(const std::string &hef_path, hailo_status &status);
     Impl(const MemoryView &hef_memview, hailo_status &status);
 
@@ -356,6 +364,7 @@ private:
     hailo_status fill_networks_metadata();
     void fill_extensions_bitset();
     void init_md5(MD5_SUM_t &calculated_md5);
+    void copy_parsed_hef(const Impl &other);
 
     static bool check_hef_extension(const ProtoHEFExtensionType &extension, const ProtoHEFHeader &header,
         const std::vector<ProtoHEFExtension> &hef_extensions, const ProtoHEFIncludedFeatures &included_features);
@@ -377,7 +386,8 @@ private:
     static Expected<std::string> get_vstream_name_from_original_name_mux(const std::string &original_name, const ProtoHefEdge &layer);
     static Expected<std::vector<std::string>> get_original_names_from_vstream_name_mux(const std::string &vstream_name, const ProtoHefEdge &layer);
 
-    Expected<NetworkGroupMetadata> create_metadata_per_arch(const ProtoHEFCoreOpMock &core_op);
+    Expected<NetworkGroupMetadata> create_metadata_per_arch(const ProtoHEFCoreOpMock &core_op,
+        ProtoHEFNetworkGroupPtr network_group_proto);
 
     // Hef information
     ProtoHEFHeader m_header;
@@ -392,6 +402,8 @@ private:
     MD5_SUM_t m_md5;
 
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
+    // Raw hef - either mapped from the hef file or copied from the user's buffer
+    MmapBuffer<uint8_t> m_hef_mapping;
     Buffer m_hef_buffer;
 #endif // HAILO_SUPPORT_MULTI_PROCESS
 
@@ -456,12 +468,15 @@ public:
         const std::vector<LayerInfo> &context_ddr_input_layers,
         const std::vector<LayerInfo> &context_ddr_output_layers,
         const uint8_t context_index);
+    // Note: network_group_proto owns the given protos. It is kept alive by the returned metadata, which parses
+    //       the context's operations lazily.
     static Expected<PreliminaryContextMetadata> parse_preliminary_context(const ProtoHEFPreliminaryConfig &preliminary_proto,
-        const SupportedFeatures &supported_features);
+        const SupportedFeatures &supported_features, ProtoHEFNetworkGroupPtr network_group_proto);
     static Expected<ContextMetadata> parse_single_dynamic_context(const ProtoHEFCoreOpMock &core_op,
-        const ProtoHEFContext &context_proto, uint8_t context_index, const SupportedFeatures &supported_features);
+        const ProtoHEFContext &context_proto, uint8_t context_index, const SupportedFeatures &supported_features,
+        ProtoHEFNetworkGroupPtr network_group_proto);
     static Expected<std::vector<ContextMetadata>> parse_dynamic_contexts(const ProtoHEFCoreOpMock &core_op,
-        const SupportedFeatures &supported_features);
+        const SupportedFeatures &supported_features, ProtoHEFNetworkGroupPtr network_group_proto);
     static Expected<hailo_nms_info_t> parse_proto_nms_info(const ProtoHEFNmsInfo &proto_nms_info);
     static Expected<LayerInfo> get_boundary_layer_info(const ProtoHEFCoreOpMock &core_op,
         const uint8_t context_index, const ProtoHEFEdgeLayer &layer, const SupportedFeatures &supported_features);
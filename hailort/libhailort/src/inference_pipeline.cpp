@@ -19,6 +19,23 @@
 namespace hailort
 {
 
+class InferVStreams::VStreamWorker final
+{
+public:
+    void run(std::function<hailo_status(void)> func)
+    {
+        m_thread.run(std::move(func));
+    }
+
+    hailo_status get()
+    {
+        return m_thread.get();
+    }
+
+private:
+    ReusableThread<hailo_status> m_thread;
+};
+
 InferVStreams::InferVStreams(std::vector<InputVStream> &&inputs, std::vector<OutputVStream> &&outputs, bool is_multi_context,
     uint16_t batch_size) :
     m_inputs(std::move(inputs)),
@@ -42,6 +59,30 @@ InferVStreams::InferVStreams(std::vector<InputVStream> &&inputs, std::vector<Out
     }
 }
 
+InferVStreams::InferVStreams(InferVStreams &&other) :
+    m_inputs(std::move(other.m_inputs)),
+    m_outputs(std::move(other.m_outputs)),
+    m_is_multi_context(std::move(other.m_is_multi_context)),
+    m_network_name_to_input_count(std::move(other.m_network_name_to_input_count)),
+    m_network_name_to_output_count(std::move(other.m_network_name_to_output_count)),
+    m_batch_size(std::move(other.m_batch_size)),
+    m_workers(std::move(other.m_workers))
+{}
+
+// Defined here since VStreamWorker is incomplete in the header
+InferVStreams::~InferVStreams() = default;
+
+Expected<std::reference_wrapper<InferVStreams::VStreamWorker>> InferVStreams::get_worker(const std::string &vstream_name)
+{
+    auto worker = m_workers.find(vstream_name);
+    if (m_workers.end() == worker) {
+        auto new_worker = make_unique_nothrow<VStreamWorker>();
+        CHECK_NOT_NULL_AS_EXPECTED(new_worker, HAILO_OUT_OF_HOST_MEMORY);
+        worker = m_workers.emplace(vstream_name, std::move(new_worker)).first;
+    }
+    return std::ref(*worker->second);
+}
+
 hailo_status InferVStreams::verify_network_inputs_and_outputs(const std::map<std::string, MemoryView>& inputs_name_mem_view_map,
                                                    const std::map<std::string, MemoryView>& outputs_name_mem_view_map)
 {
@@ -198,14 +239,24 @@ hailo_status InferVStreams::infer(const std::map<std::string, MemoryView>& input
     status = verify_frames_count(frames_count);
     CHECK_SUCCESS(status);
 
-    std::vector<AsyncThreadPtr<hailo_status>> results;
+    // The vstreams' workers are created before launching any read/write, so a failure won't leave jobs running
+    std::vector<std::reference_wrapper<VStreamWorker>> workers;
+    for (const auto &input_name_to_data_pair : input_data) {
+        auto worker = get_worker(input_name_to_data_pair.first);
+        CHECK_EXPECTED_AS_STATUS(worker);
+        workers.emplace_back(worker.release());
+    }
+    for (const auto &output_name_to_data_pair : output_data) {
+        auto worker = get_worker(output_name_to_data_pair.first);
+        CHECK_EXPECTED_AS_STATUS(worker);
+        workers.emplace_back(worker.release());
+    }
 
     // Launch async read/writes
+    auto worker = workers.begin();
     for (auto &input_name_to_data_pair : input_data) {
-        auto input_vstream_exp = get_input_by_name(input_name_to_data_pair.first);
-        CHECK_EXPECTED_AS_STATUS(input_vstream_exp);
-        auto &input_vstream = input_vstream_exp.release().get();
-        results.emplace_back(std::make_unique<AsyncThread<hailo_status>>(
+        auto &input_vstream = get_input_by_name(input_name_to_data_pair.first).release().get();
+        (worker++)->get().run(
             [&input_vstream, &input_name_to_data_pair, frames_count]() -> hailo_status {
                 const auto &input_buffer = input_name_to_data_pair.second;
                 for (uint32_t i = 0; i < frames_count; i++) {
@@ -221,14 +272,12 @@ hailo_status InferVStreams::infer(const std::map<std::string, MemoryView>& input
                 }
                 return HAILO_SUCCESS;
             }
-        ));
+        );
     }
     for (auto &output_name_to_data_pair : output_data) {
-        auto output_vstream_exp = get_output_by_name(output_name_to_data_pair.first);
-        CHECK_EXPECTED_AS_STATUS(output_vstream_exp);
-        auto &output_vstream = output_vstream_exp.release().get();
-        results.emplace_back(std::make_unique<AsyncThread<hailo_status>>(
-            [&output_vstream, &output_name_to_data_pair, frames_count]() {
+        auto &output_vstream = get_output_by_name(output_name_to_data_pair.first).release().get();
+        (worker++)->get().run(
+            [&output_vstream, &output_name_to_data_pair, frames_count]() -> hailo_status {
                 for (size_t i = 0; i < frames_count; i++) {
                     auto status = output_vstream.read(MemoryView(output_name_to_data_pair.second.data() + i * output_vstream.get_frame_size(), output_vstream.get_frame_size()));
                     if (HAILO_SUCCESS != status) {
@@ -237,13 +286,13 @@ hailo_status InferVStreams::infer(const std::map<std::string, MemoryView>& input
                 }
                 return HAILO_SUCCESS;
             }
-        ));
+        );
     }
 
     // Wait for all results
     auto error_status = HAILO_SUCCESS;
-    for (auto& result : results) {
-        status = result->get();
+    for (auto &worker_ref : workers) {
+        status = worker_ref.get().get();
         if (HAILO_STREAM_ABORTED_BY_USER == status) {
             continue;
         }
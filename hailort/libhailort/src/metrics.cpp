@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics.cpp
+ * @brief Implementation of the metrics registry and its OpenMetrics serialization
+ **/
+
+#include "hailo/metrics.hpp"
+#include "common/utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace hailort
+{
+
+void MetricGauge::add(double amount)
+{
+    auto current = m_value.load(std::memory_order_relaxed);
+    while (!m_value.compare_exchange_weak(current, current + amount, std::memory_order_relaxed)) {}
+}
+
+Expected<std::shared_ptr<MetricHistogram>> MetricHistogram::create(const std::vector<double> &upper_bounds)
+{
+    CHECK_AS_EXPECTED(!upper_bounds.empty(), HAILO_INVALID_ARGUMENT, "Histogram must have at least one bucket");
+    for (size_t i = 1; i < upper_bounds.size(); i++) {
+        CHECK_AS_EXPECTED(upper_bounds[i - 1] < upper_bounds[i], HAILO_INVALID_ARGUMENT,
+            "Histogram bucket upper bounds must be strictly increasing");
+    }
+
+    auto bounds = upper_bounds;
+    auto histogram = make_shared_nothrow<MetricHistogram>(std::move(bounds));
+    CHECK_NOT_NULL_AS_EXPECTED(histogram, HAILO_OUT_OF_HOST_MEMORY);
+    return histogram;
+}
+
+std::vector<double> MetricHistogram::default_latency_buckets()
+{
+    return {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+}
+
+MetricHistogram::MetricHistogram(std::vector<double> &&upper_bounds) :
+    m_upper_bounds(std::move(upper_bounds)),
+    // The extra bucket is +Inf
+    m_bucket_counts(new std::atomic<uint64_t>[m_upper_bounds.size() + 1]),
+    m_sum(0)
+{
+    for (size_t i = 0; i <= m_upper_bounds.size(); i++) {
+        m_bucket_counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double value)
+{
+    const auto bucket = static_cast<size_t>(std::distance(m_upper_bounds.begin(),
+        std::lower_bound(m_upper_bounds.begin(), m_upper_bounds.end(), value)));
+    m_bucket_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    auto current = m_sum.load(std::memory_order_relaxed);
+    while (!m_sum.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {}
+}
+
+MetricHistogramSnapshot MetricHistogram::snapshot() const
+{
+    MetricHistogramSnapshot result{};
+    result.upper_bounds = m_upper_bounds;
+    result.bucket_counts.reserve(m_upper_bounds.size() + 1);
+    for (size_t i = 0; i <= m_upper_bounds.size(); i++) {
+        const auto bucket_count = m_bucket_counts[i].load(std::memory_order_relaxed);
+        result.bucket_counts.push_back(bucket_count);
+        result.count += bucket_count;
+    }
+    result.sum = m_sum.load(std::memory_order_relaxed);
+    return result;
+}
+
+MetricsRegistry &MetricsRegistry::get_instance()
+{
+    static MetricsRegistry instance;
+    return instance;
+}
+
+template<typename T>
+Expected<std::shared_ptr<T>> MetricsRegistry::get_metric(MetricType type, const std::string &name, const std::string &help,
+    const MetricLabels &labels, std::function<Expected<std::shared_ptr<T>>()> create_func)
+{
+    CHECK_AS_EXPECTED(!name.empty(), HAILO_INVALID_ARGUMENT, "Metric name must not be empty");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto family_it = m_families.find(name);
+    if (m_families.end() == family_it) {
+        family_it = m_families.emplace(name, MetricFamily{type, help, {}}).first;
+    }
+    auto &family = family_it->second;
+    CHECK_AS_EXPECTED(type == family.type, HAILO_INVALID_ARGUMENT,
+        "Metric {} is already registered with a different type", name);
+
+    auto metric_it = family.metrics.find(labels);
+    if (family.metrics.end() != metric_it) {
+        auto existing = metric_it->second.lock();
+        if (nullptr != existing) {
+            return std::static_pointer_cast<T>(existing);
+        }
+    }
+
+    auto metric = create_func();
+    CHECK_EXPECTED(metric);
+    family.metrics[labels] = metric.value();
+    return metric.release();
+}
+
+Expected<std::shared_ptr<MetricCounter>> MetricsRegistry::get_counter(const std::string &name, const std::string &help,
+    const MetricLabels &labels)
+{
+    return get_metric<MetricCounter>(MetricType::COUNTER, name, help, labels, []() -> Expected<std::shared_ptr<MetricCounter>> {
+        auto counter = make_shared_nothrow<MetricCounter>();
+        CHECK_NOT_NULL_AS_EXPECTED(counter, HAILO_OUT_OF_HOST_MEMORY);
+        return counter;
+    });
+}
+
+Expected<std::shared_ptr<MetricGauge>> MetricsRegistry::get_gauge(const std::string &name, const std::string &help,
+    const MetricLabels &labels)
+{
+    return get_metric<MetricGauge>(MetricType::GAUGE, name, help, labels, []() -> Expected<std::shared_ptr<MetricGauge>> {
+        auto gauge = make_shared_nothrow<MetricGauge>();
+        CHECK_NOT_NULL_AS_EXPECTED(gauge, HAILO_OUT_OF_HOST_MEMORY);
+        return gauge;
+    });
+}
+
+Expected<std::shared_ptr<MetricHistogram>> MetricsRegistry::get_histogram(const std::string &name, const std::string &help,
+    const MetricLabels &labels, const std::vector<double> &upper_bounds)
+{
+    return get_metric<MetricHistogram>(MetricType::HISTOGRAM, name, help, labels, [&upper_bounds]() {
+        return MetricHistogram::create(upper_bounds);
+    });
+}
+
+void MetricsRegistry::add_collector(std::weak_ptr<MetricsCollector> collector)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_collectors.emplace_back(std::move(collector));
+}
+
+// OpenMetrics escapes backslashes, double quotes and newlines in both the label values and the HELP text
+static std::string escape_text(const std::string &value)
+{
+    std::string result;
+    result.reserve(value.size());
+    for (const auto c : value) {
+        switch (c) {
+        case '\\':
+            result += "\\\\";
+            break;
+        case '"':
+            result += "\\\"";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        default:
+            result += c;
+        }
+    }
+    return result;
+}
+
+static std::string format_value(double value)
+{
+    if (std::isinf(value)) {
+        return (value > 0) ? "+Inf" : "-Inf";
+    }
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << value;
+    return stream.str();
+}
+
+// Renders {name="value",...}, with an optional extra label (used for the histogram "le" label)
+static std::string format_labels(const MetricLabels &labels, const std::string &extra_name = "",
+    const std::string &extra_value = "")
+{
+    if (labels.empty() && extra_name.empty()) {
+        return "";
+    }
+
+    std::string result = "{";
+    bool first = true;
+    for (const auto &label : labels) {
+        result += (first ? "" : ",") + label.first + "=\"" + escape_text(label.second) + "\"";
+        first = false;
+    }
+    if (!extra_name.empty()) {
+        result += (first ? "" : ",") + extra_name + "=\"" + extra_value + "\"";
+    }
+    return result + "}";
+}
+
+std::string MetricsRegistry::serialize()
+{
+    // Collectors may create metrics, so they are called without holding the lock
+    std::vector<std::shared_ptr<MetricsCollector>> collectors;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_collectors.erase(std::remove_if(m_collectors.begin(), m_collectors.end(),
+            [](const std::weak_ptr<MetricsCollector> &collector) { return collector.expired(); }), m_collectors.end());
+        for (const auto &collector : m_collectors) {
+            auto collector_ptr = collector.lock();
+            if (nullptr != collector_ptr) {
+                collectors.emplace_back(std::move(collector_ptr));
+            }
+        }
+    }
+    for (const auto &collector : collectors) {
+        collector->collect();
+    }
+
+    std::ostringstream out;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto family_it = m_families.begin(); family_it != m_families.end();) {
+        const auto &name = family_it->first;
+        auto &family = family_it->second;
+
+        std::vector<std::pair<MetricLabels, std::shared_ptr<void>>> live_metrics;
+        for (auto metric_it = family.metrics.begin(); metric_it != family.metrics.end();) {
+            auto metric = metric_it->second.lock();
+            if (nullptr == metric) {
+                metric_it = family.metrics.erase(metric_it);
+                continue;
+            }
+            live_metrics.emplace_back(metric_it->first, std::move(metric));
+            metric_it++;
+        }
+        if (live_metrics.empty()) {
+            family_it = m_families.erase(family_it);
+            continue;
+        }
+
+        switch (family.type) {
+        case MetricType::COUNTER:
+            out << "# TYPE " << name << " counter\n";
+            out << "# HELP " << name << " " << escape_text(family.help) << "\n";
+            for (const auto &metric : live_metrics) {
+                auto counter = std::static_pointer_cast<MetricCounter>(metric.second);
+                out << name << "_total" << format_labels(metric.first) << " " << counter->value() << "\n";
+            }
+            break;
+        case MetricType::GAUGE:
+            out << "# TYPE " << name << " gauge\n";
+            out << "# HELP " << name << " " << escape_text(family.help) << "\n";
+            for (const auto &metric : live_metrics) {
+                auto gauge = std::static_pointer_cast<MetricGauge>(metric.second);
+                out << name << format_labels(metric.first) << " " << format_value(gauge->value()) << "\n";
+            }
+            break;
+        case MetricType::HISTOGRAM:
+            out << "# TYPE " << name << " histogram\n";
+            out << "# HELP " << name << " " << escape_text(family.help) << "\n";
+            for (const auto &metric : live_metrics) {
+                const auto snapshot = std::static_pointer_cast<MetricHistogram>(metric.second)->snapshot();
+                // OpenMetrics buckets are cumulative
+                uint64_t cumulative_count = 0;
+                for (size_t i = 0; i < snapshot.bucket_counts.size(); i++) {
+                    cumulative_count += snapshot.bucket_counts[i];
+                    const auto le = (i < snapshot.upper_bounds.size()) ? format_value(snapshot.upper_bounds[i]) : "+Inf";
+                    out << name << "_bucket" << format_labels(metric.first, "le", le) << " " << cumulative_count << "\n";
+                }
+                out << name << "_sum" << format_labels(metric.first) << " " << format_value(snapshot.sum) << "\n";
+                out << name << "_count" << format_labels(metric.first) << " " << snapshot.count << "\n";
+            }
+            break;
+        }
+        family_it++;
+    }
+    out << "# EOF\n";
+    return out.str();
+}
+
+} /* namespace hailort */
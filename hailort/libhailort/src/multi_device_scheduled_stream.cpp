@@ -14,7 +14,7 @@
 namespace hailort
 {
 
-hailo_status MultiDeviceScheduledInputStream::send_pending_buffer(size_t device_index)
+hailo_status MultiDeviceScheduledInputStream::send_pending_buffer(size_t device_index, bool ring_doorbell)
 {
     auto buffer = dequeue();
     CHECK_EXPECTED_AS_STATUS(buffer);
@@ -22,7 +22,7 @@ hailo_status MultiDeviceScheduledInputStream::send_pending_buffer(size_t device_
     CHECK_SUCCESS(status);
 
     VdmaInputStream &vdma_input = static_cast<VdmaInputStream&>(m_streams[device_index].get());
-    return vdma_input.send_pending_buffer();
+    return vdma_input.send_pending_buffer(0, ring_doorbell);
 }
 
 Expected<size_t> MultiDeviceScheduledInputStream::sync_write_raw_buffer(const MemoryView &buffer,
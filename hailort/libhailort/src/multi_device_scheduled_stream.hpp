@@ -161,7 +161,7 @@ public:
     {
     }
 
-    virtual hailo_status send_pending_buffer(size_t device_index = 0) override;
+    virtual hailo_status send_pending_buffer(size_t device_index = 0, bool ring_doorbell = true) override;
     virtual Expected<size_t> get_pending_frames_count() const override;
 
 protected:
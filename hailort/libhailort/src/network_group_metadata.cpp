@@ -50,15 +50,23 @@ static bool is_edge_under_mux(const LayerInfo &info, const std::string &edge_nam
 }
 
 
-PreliminaryContextMetadata::PreliminaryContextMetadata(std::vector<ContextSwitchOperation> &&operations,
+static Expected<std::vector<ContextSwitchOperation>> parse_operations(const ContextSwitchOperationsParser &operations_parser)
+{
+    if (!operations_parser) {
+        return std::vector<ContextSwitchOperation>();
+    }
+    return operations_parser();
+}
+
+PreliminaryContextMetadata::PreliminaryContextMetadata(ContextSwitchOperationsParser &&operations_parser,
     ConfigBufferInfoMap&& config_buffers_info) :
-    m_operations(std::move(operations)),
+    m_operations_parser(std::move(operations_parser)),
     m_config_buffers_info(std::move(config_buffers_info))
 {}
 
-const std::vector<ContextSwitchOperation> &PreliminaryContextMetadata::get_operations() const
+Expected<std::vector<ContextSwitchOperation>> PreliminaryContextMetadata::get_operations() const
 {
-    return m_operations;
+    return parse_operations(m_operations_parser);
 }
 
 const ConfigBufferInfoMap &PreliminaryContextMetadata::config_buffers_info() const
@@ -66,15 +74,15 @@ const ConfigBufferInfoMap &PreliminaryContextMetadata::config_buffers_info() con
     return m_config_buffers_info;
 }
 
-ContextMetadata::ContextMetadata(std::vector<ContextSwitchOperation> &&operations,
+ContextMetadata::ContextMetadata(ContextSwitchOperationsParser &&operations_parser,
     ConfigBufferInfoMap&& config_buffers_info) :
-    m_operations(std::move(operations)),
+    m_operations_parser(std::move(operations_parser)),
     m_config_buffers_info(std::move(config_buffers_info))
 {}
 
-const std::vector<ContextSwitchOperation> &ContextMetadata::get_operations() const
+Expected<std::vector<ContextSwitchOperation>> ContextMetadata::get_operations() const
 {
-    return m_operations;
+    return parse_operations(m_operations_parser);
 }
 
 const ConfigBufferInfoMap &ContextMetadata::config_buffers_info() const
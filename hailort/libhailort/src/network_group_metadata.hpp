@@ -13,6 +13,8 @@
 #include "layer_info.hpp"
 #include "context_switch/context_switch_actions.hpp"
 
+#include <functional>
+
 namespace hailort
 {
 
@@ -29,25 +31,29 @@ struct SupportedFeatures {
 // For each config_stream_index we store vector of all ccw write length. The vector is used to build the config buffer.g
 using ConfigBufferInfoMap = std::unordered_map<uint8_t, std::vector<uint32_t>>;
 
+// Parses the context's operations from the hef. The operations are parsed only when a network group is configured
+// (and released afterwards), so the hef's action lists and config buffers aren't kept in memory twice.
+using ContextSwitchOperationsParser = std::function<Expected<std::vector<ContextSwitchOperation>>()>;
+
 class PreliminaryContextMetadata final {
 public:
     PreliminaryContextMetadata() = default; // TODO HRT-8478: remove
-    PreliminaryContextMetadata(std::vector<ContextSwitchOperation> &&operations,
+    PreliminaryContextMetadata(ContextSwitchOperationsParser &&operations_parser,
         ConfigBufferInfoMap&& config_buffers_info);
-    const std::vector<ContextSwitchOperation> &get_operations() const;
+    Expected<std::vector<ContextSwitchOperation>> get_operations() const;
     const ConfigBufferInfoMap &config_buffers_info() const;
 
 private:
-    std::vector<ContextSwitchOperation> m_operations;
+    ContextSwitchOperationsParser m_operations_parser;
     ConfigBufferInfoMap m_config_buffers_info;
 };
 
 class ContextMetadata final {
 public:
-    explicit ContextMetadata(std::vector<ContextSwitchOperation> &&operations,
+    explicit ContextMetadata(ContextSwitchOperationsParser &&operations_parser,
         ConfigBufferInfoMap&& config_buffers_info);
 
-    const std::vector<ContextSwitchOperation> &get_operations() const;
+    Expected<std::vector<ContextSwitchOperation>> get_operations() const;
     const ConfigBufferInfoMap &config_buffers_info() const;
 
     void add_boundary_layer(const LayerInfo &layer_info);
@@ -62,7 +68,7 @@ public:
     const std::vector<LayerInfo> &get_ddr_output_layers() const;
 
 private:
-    std::vector<ContextSwitchOperation> m_operations;
+    ContextSwitchOperationsParser m_operations_parser;
     ConfigBufferInfoMap m_config_buffers_info;
 
     std::vector<LayerInfo> m_boundary_input_layers;
@@ -324,6 +324,22 @@ Expected<scheduler_ng_handle_t> NetworkGroupScheduler::add_network_group(std::sh
         m_last_measured_activation_timestamp[network_group_handle] = {};
         m_active_duration[network_group_handle] = 0;
         m_fps_accumulator[network_group_handle] = 0;
+
+        // Metrics are best effort, a failure doesn't fail the network group
+        const MetricLabels labels = {{"network_group", added_cng->name()}};
+        auto read_frames = MetricsRegistry::get_instance().get_counter("hailort_scheduler_read_frames",
+            "Frames read from the network group's output streams", labels);
+        auto active_time = MetricsRegistry::get_instance().get_counter("hailort_scheduler_active_microseconds",
+            "Time the network group was active on a device", labels);
+        auto switches = MetricsRegistry::get_instance().get_counter("hailort_scheduler_switches",
+            "Times the network group was switched to on a device (or had its batch size changed)", labels);
+        if (read_frames && active_time && switches) {
+            m_read_frames_metric[network_group_handle] = read_frames.release();
+            m_active_time_us_metric[network_group_handle] = active_time.release();
+            m_switches_metric[network_group_handle] = switches.release();
+        } else {
+            LOGGER__WARNING("Failed to create scheduler metrics for network group {}", added_cng->name());
+        }
     }
     m_write_read_cv.notify_all();
     return network_group_handle;
@@ -516,6 +532,10 @@ hailo_status NetworkGroupScheduler::switch_network_group(const scheduler_ng_hand
         TRACE(SwitchNetworkGroupTrace, "", network_group_handle);
         auto status = VdmaConfigManager::switch_network_group(current_active_vdma_cng, next_active_cng_expected.value(), batch_size);
         CHECK_SUCCESS(status, "Failed switching network group");
+        auto switches_metric = m_switches_metric.find(network_group_handle);
+        if (m_switches_metric.end() != switches_metric) {
+            switches_metric->second->inc();
+        }
 
         // Register to get interrupts - has to be after network group is activated
         for (auto &output_stream : next_active_cng_expected.value()->get_output_streams()) {
@@ -566,21 +586,23 @@ hailo_status NetworkGroupScheduler::send_all_pending_buffers(const scheduler_ng_
 
     auto scheduled_ng = m_cngs[network_group_handle];
 
-    while(true) {
-        auto finished_send = false;
-        for (const auto &name : scheduled_ng->get_inputs_names()) {
-            if ((scheduled_ng->finished_write_frames(name) == 0) || (((scheduled_ng->use_dynamic_batch_flow()) || (is_multi_device())) &&
-                    ((current_device_info->current_cycle_requested_transferred_frames_h2d[network_group_handle][name] == current_device_info->current_burst_size)))) {
-                finished_send = true;
-                break;
-            }
-        }
-        if (finished_send) {
-            break;
+    // The frames of the current burst are sent with a single doorbell (num_available update) per input channel,
+    // rung with the last frame of the burst
+    uint32_t frames_to_send = scheduled_ng->get_inputs_names().empty() ? 0 : UINT32_MAX;
+    for (const auto &name : scheduled_ng->get_inputs_names()) {
+        uint32_t stream_frames_to_send = scheduled_ng->finished_write_frames(name);
+        if ((scheduled_ng->use_dynamic_batch_flow()) || (is_multi_device())) {
+            const uint32_t requested_frames = current_device_info->current_cycle_requested_transferred_frames_h2d[network_group_handle][name];
+            const uint32_t burst_size = current_device_info->current_burst_size;
+            stream_frames_to_send = std::min(stream_frames_to_send, (requested_frames < burst_size) ? (burst_size - requested_frames) : 0);
         }
+        frames_to_send = std::min(frames_to_send, stream_frames_to_send);
+    }
 
+    for (uint32_t frame_index = 0; frame_index < frames_to_send; frame_index++) {
+        const bool ring_doorbell = ((frame_index + 1) == frames_to_send);
         for (const auto &name : scheduled_ng->get_inputs_names()) {
-            auto status = send_pending_buffer(network_group_handle, name, device_id);
+            auto status = send_pending_buffer(network_group_handle, name, device_id, ring_doorbell);
             if (HAILO_STREAM_ABORTED_BY_USER == status) {
                 LOGGER__INFO("send_pending_buffer has failed with status=HAILO_STREAM_ABORTED_BY_USER");
                 return status;
@@ -594,7 +616,7 @@ hailo_status NetworkGroupScheduler::send_all_pending_buffers(const scheduler_ng_
 }
 
 hailo_status NetworkGroupScheduler::send_pending_buffer(const scheduler_ng_handle_t &network_group_handle, const std::string &stream_name,
-    uint32_t device_id)
+    uint32_t device_id, bool ring_doorbell)
 {
     assert(m_cngs.size() > network_group_handle);
     auto scheduled_ng = m_cngs[network_group_handle];
@@ -605,7 +627,7 @@ hailo_status NetworkGroupScheduler::send_pending_buffer(const scheduler_ng_handl
 
     VDeviceInputStreamMultiplexerWrapper &vdevice_input = static_cast<VDeviceInputStreamMultiplexerWrapper&>(input_stream->get());
     TRACE(InputVdmaEnqueueTrace, "", network_group_handle, stream_name);
-    auto status = vdevice_input.send_pending_buffer(device_id);
+    auto status = vdevice_input.send_pending_buffer(device_id, ring_doorbell);
     if (HAILO_STREAM_ABORTED_BY_USER == status) {
         LOGGER__INFO("send_pending_buffer has failed with status=HAILO_STREAM_ABORTED_BY_USER");
         return status;
@@ -640,6 +662,11 @@ void NetworkGroupScheduler::reset_current_ng_timestamps(uint32_t device_id)
 
     assert(contains(m_active_duration, curr_device_info->current_network_group_handle));
     m_active_duration[curr_device_info->current_network_group_handle] += active_duration_sec;
+
+    auto active_time_metric = m_active_time_us_metric.find(curr_device_info->current_network_group_handle);
+    if (m_active_time_us_metric.end() != active_time_metric) {
+        active_time_metric->second->inc(static_cast<uint64_t>(active_duration_sec * 1000000));
+    }
 }
 
 NetworkGroupScheduler::ReadyInfo NetworkGroupScheduler::is_network_group_ready(const scheduler_ng_handle_t &network_group_handle, bool check_threshold, uint32_t device_id)
@@ -767,6 +794,10 @@ hailo_status NetworkGroupScheduler::signal_read_finish(const scheduler_ng_handle
         scheduled_ng->d2h_finished_transferred_frames().decrease(stream_name);
         scheduled_ng->ongoing_read_frames().decrease(stream_name);
         m_fps_accumulator[network_group_handle]++;
+        auto read_frames_metric = m_read_frames_metric.find(network_group_handle);
+        if (m_read_frames_metric.end() != read_frames_metric) {
+            read_frames_metric->second->inc();
+        }
 
         decrease_ng_counters(network_group_handle);
     }
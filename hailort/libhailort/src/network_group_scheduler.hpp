@@ -13,6 +13,7 @@
 #include "hailo/hailort.h"
 #include "hailo/expected.hpp"
 #include "hailo/network_group.hpp"
+#include "hailo/metrics.hpp"
 #include "common/utils.hpp"
 #include "common/filesystem.hpp"
 #include "scheduler_mon.hpp"
@@ -114,7 +115,8 @@ private:
 
     Expected<bool> should_wait_for_write(const scheduler_ng_handle_t &network_group_handle, const std::string &stream_name);
     hailo_status send_all_pending_buffers(const scheduler_ng_handle_t &network_group_handle, uint32_t device_id);
-    hailo_status send_pending_buffer(const scheduler_ng_handle_t &network_group_handle, const std::string &stream_name, uint32_t device_id);
+    hailo_status send_pending_buffer(const scheduler_ng_handle_t &network_group_handle, const std::string &stream_name, uint32_t device_id,
+        bool ring_doorbell = true);
     
     void decrease_ng_counters(const scheduler_ng_handle_t &network_group_handle);
     bool has_ng_drained_everything(const scheduler_ng_handle_t &network_group_handle, uint32_t device_id);
@@ -157,6 +159,11 @@ private:
     std::unordered_map<scheduler_ng_handle_t, double> m_active_duration;
     std::unordered_map<scheduler_ng_handle_t, std::atomic_uint32_t> m_fps_accumulator;
 
+    // Exported through the MetricsRegistry. Unlike the MON members above, these are never reset.
+    std::unordered_map<scheduler_ng_handle_t, std::shared_ptr<MetricCounter>> m_read_frames_metric;
+    std::unordered_map<scheduler_ng_handle_t, std::shared_ptr<MetricCounter>> m_active_time_us_metric;
+    std::unordered_map<scheduler_ng_handle_t, std::shared_ptr<MetricCounter>> m_switches_metric;
+
     friend class NetworkGroupSchedulerOracle;
 };
 
@@ -0,0 +1,696 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file network_group_tuner.cpp
+ * @brief Automatic tuning of the batch size and the scheduler parameters of network groups
+ **/
+
+#include "network_group_tuner_internal.hpp"
+#include "hailo/hef.hpp"
+#include "hailo/vstream.hpp"
+#include "hailo/buffer.hpp"
+#include "hailort_defaults.hpp"
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+#include "common/async_thread.hpp"
+#include "common/runtime_statistics_internal.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace hailort
+{
+
+#ifndef HAILO_EMULATOR
+static const std::vector<uint16_t> DEFAULT_TUNER_BATCH_SIZES{1, 2, 4, 8};
+static const std::vector<uint32_t> DEFAULT_TUNER_SCHEDULER_THRESHOLDS{1, 2, 4, 8};
+static const std::vector<std::chrono::milliseconds> DEFAULT_TUNER_SCHEDULER_TIMEOUTS{
+    std::chrono::milliseconds(0), std::chrono::milliseconds(10), std::chrono::milliseconds(50)};
+constexpr std::chrono::milliseconds DEFAULT_TUNER_WARMUP_DURATION(500);
+constexpr std::chrono::milliseconds DEFAULT_TUNER_TRIAL_DURATION(2000);
+constexpr uint32_t TUNER_VSTREAM_TIMEOUT_MS = HAILO_DEFAULT_VSTREAM_TIMEOUT_MS;
+#else /* ifndef HAILO_EMULATOR */
+static const std::vector<uint16_t> DEFAULT_TUNER_BATCH_SIZES{1, 2};
+static const std::vector<uint32_t> DEFAULT_TUNER_SCHEDULER_THRESHOLDS{1};
+static const std::vector<std::chrono::milliseconds> DEFAULT_TUNER_SCHEDULER_TIMEOUTS{std::chrono::milliseconds(0)};
+constexpr std::chrono::milliseconds DEFAULT_TUNER_WARMUP_DURATION(10000);
+constexpr std::chrono::milliseconds DEFAULT_TUNER_TRIAL_DURATION(60000);
+constexpr uint32_t TUNER_VSTREAM_TIMEOUT_MS = HAILO_DEFAULT_VSTREAM_TIMEOUT_MS * 100;
+#endif /* ifndef HAILO_EMULATOR */
+
+// Every network group keeps this many batches in flight, so the latency isn't dominated by the vstreams' queues
+constexpr size_t TUNER_BATCHES_IN_FLIGHT = 2;
+constexpr double TUNER_LATENCY_PERCENTILE = 99;
+// Trials whose fps is within this ratio of the best fps are considered equal
+constexpr double TUNER_EQUAL_FPS_RATIO = 0.99;
+
+#define TUNER_CONFIG_NETWORK_GROUPS_KEY ("network_groups")
+#define TUNER_CONFIG_HEF_KEY ("hef")
+#define TUNER_CONFIG_NETWORK_GROUP_NAME_KEY ("network_group_name")
+#define TUNER_CONFIG_BATCH_SIZE_KEY ("batch_size")
+#define TUNER_CONFIG_SCHEDULER_THRESHOLD_KEY ("scheduler_threshold")
+#define TUNER_CONFIG_SCHEDULER_TIMEOUT_KEY ("scheduler_timeout_ms")
+
+/**
+ * Runs a configured network group continuously (in a closed loop, with a bounded number of frames in flight), and
+ * measures its fps and the latency of its frames - from writing a frame to the first input, to reading it from the
+ * first output of the same network.
+ */
+class TunerNetworkGroupRunner final
+{
+public:
+    static Expected<std::unique_ptr<TunerNetworkGroupRunner>> create(std::shared_ptr<ConfiguredNetworkGroup> network_group,
+        uint16_t batch_size);
+
+    TunerNetworkGroupRunner(std::shared_ptr<ConfiguredNetworkGroup> network_group, std::vector<InputVStream> &&inputs,
+        std::vector<OutputVStream> &&outputs, size_t first_output_index, size_t max_frames_in_flight);
+    TunerNetworkGroupRunner(const TunerNetworkGroupRunner &other) = delete;
+    TunerNetworkGroupRunner &operator=(const TunerNetworkGroupRunner &other) = delete;
+
+    hailo_status start();
+    // Returns the first error of the running threads
+    hailo_status stop();
+    hailo_status get_status() const
+    {
+        return m_status.load();
+    }
+
+    void reset_measurement();
+    NetworkGroupTrialResult get_measurement();
+
+private:
+    hailo_status run_input(InputVStream &vstream, bool is_first);
+    hailo_status run_output(OutputVStream &vstream, bool is_first);
+    void set_failure(hailo_status status);
+
+    std::shared_ptr<ConfiguredNetworkGroup> m_network_group;
+    std::vector<InputVStream> m_inputs;
+    std::vector<OutputVStream> m_outputs;
+    const size_t m_first_output_index;
+    const size_t m_max_frames_in_flight;
+    std::vector<AsyncThreadPtr<hailo_status>> m_threads;
+    std::atomic<hailo_status> m_status;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_is_stopped;
+    // The write times of the frames written to the first input, which weren't read from the first output yet
+    std::deque<std::chrono::steady_clock::time_point> m_write_times;
+    // The frames read since the measurement was reset, and their latencies (in milliseconds)
+    uint64_t m_frames_count;
+    std::chrono::steady_clock::time_point m_measurement_start;
+    HistogramAccumulator<double> m_latency;
+};
+
+Expected<std::unique_ptr<TunerNetworkGroupRunner>> TunerNetworkGroupRunner::create(
+    std::shared_ptr<ConfiguredNetworkGroup> network_group, uint16_t batch_size)
+{
+    auto vstream_params = HailoRTDefaults::get_vstreams_params();
+    vstream_params.timeout_ms = TUNER_VSTREAM_TIMEOUT_MS;
+    auto vstreams = VStreamsBuilder::create_vstreams(*network_group, vstream_params);
+    CHECK_EXPECTED(vstreams);
+    CHECK_AS_EXPECTED(!vstreams->first.empty() && !vstreams->second.empty(), HAILO_INVALID_HEF,
+        "Network group {} must have inputs and outputs to be tuned", network_group->name());
+
+    // The latency is measured on an output of the first input's network (a network group may contain a few networks)
+    const auto network_name = vstreams->first[0].network_name();
+    const auto first_output = std::find_if(vstreams->second.begin(), vstreams->second.end(),
+        [&network_name](const OutputVStream &vstream) { return vstream.network_name() == network_name; });
+    const auto first_output_index = (vstreams->second.end() == first_output) ? 0 :
+        static_cast<size_t>(std::distance(vstreams->second.begin(), first_output));
+
+    const size_t frames_per_batch = (HAILO_DEFAULT_BATCH_SIZE == batch_size) ? 1 : batch_size;
+    auto runner = make_unique_nothrow<TunerNetworkGroupRunner>(network_group, std::move(vstreams->first),
+        std::move(vstreams->second), first_output_index, frames_per_batch * TUNER_BATCHES_IN_FLIGHT);
+    CHECK_NOT_NULL_AS_EXPECTED(runner, HAILO_OUT_OF_HOST_MEMORY);
+    return runner;
+}
+
+TunerNetworkGroupRunner::TunerNetworkGroupRunner(std::shared_ptr<ConfiguredNetworkGroup> network_group,
+    std::vector<InputVStream> &&inputs, std::vector<OutputVStream> &&outputs, size_t first_output_index,
+    size_t max_frames_in_flight) :
+    m_network_group(network_group),
+    m_inputs(std::move(inputs)),
+    m_outputs(std::move(outputs)),
+    m_first_output_index(first_output_index),
+    m_max_frames_in_flight(max_frames_in_flight),
+    m_threads(),
+    m_status(HAILO_SUCCESS),
+    m_is_stopped(false),
+    m_write_times(),
+    m_frames_count(0),
+    m_measurement_start(std::chrono::steady_clock::now()),
+    m_latency("latency")
+{}
+
+hailo_status TunerNetworkGroupRunner::start()
+{
+    for (size_t i = 0; i < m_inputs.size(); i++) {
+        auto &vstream = m_inputs[i];
+        const bool is_first = (0 == i);
+        m_threads.emplace_back(make_unique_nothrow<AsyncThread<hailo_status>>([this, &vstream, is_first]() {
+            auto status = run_input(vstream, is_first);
+            set_failure(status);
+            return status;
+        }));
+        CHECK_NOT_NULL(m_threads.back(), HAILO_OUT_OF_HOST_MEMORY);
+    }
+    for (size_t i = 0; i < m_outputs.size(); i++) {
+        auto &vstream = m_outputs[i];
+        const bool is_first = (m_first_output_index == i);
+        m_threads.emplace_back(make_unique_nothrow<AsyncThread<hailo_status>>([this, &vstream, is_first]() {
+            auto status = run_output(vstream, is_first);
+            set_failure(status);
+            return status;
+        }));
+        CHECK_NOT_NULL(m_threads.back(), HAILO_OUT_OF_HOST_MEMORY);
+    }
+    return HAILO_SUCCESS;
+}
+
+hailo_status TunerNetworkGroupRunner::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_stopped = true;
+    }
+    m_cv.notify_all();
+
+    for (auto &vstream : m_inputs) {
+        auto status = vstream.abort();
+        if (HAILO_SUCCESS != status) {
+            LOGGER__WARNING("Failed aborting input vstream {} with status {}", vstream.name(), status);
+        }
+    }
+    for (auto &vstream : m_outputs) {
+        auto status = vstream.abort();
+        if (HAILO_SUCCESS != status) {
+            LOGGER__WARNING("Failed aborting output vstream {} with status {}", vstream.name(), status);
+        }
+    }
+
+    for (auto &thread : m_threads) {
+        if (nullptr != thread) {
+            thread->get();
+        }
+    }
+    m_threads.clear();
+    return m_status.load();
+}
+
+void TunerNetworkGroupRunner::set_failure(hailo_status status)
+{
+    if ((HAILO_SUCCESS == status) || (HAILO_STREAM_ABORTED_BY_USER == status)) {
+        return;
+    }
+    auto expected = HAILO_SUCCESS;
+    m_status.compare_exchange_strong(expected, status);
+}
+
+hailo_status TunerNetworkGroupRunner::run_input(InputVStream &vstream, bool is_first)
+{
+    auto dataset = Buffer::create(vstream.get_frame_size(), 0xAB);
+    CHECK_EXPECTED_AS_STATUS(dataset);
+    while (true) {
+        if (is_first) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_is_stopped || (m_write_times.size() < m_max_frames_in_flight); });
+            if (m_is_stopped) {
+                return HAILO_STREAM_ABORTED_BY_USER;
+            }
+            // The time is taken before writing, as the frame may be read before the write returns
+            m_write_times.push_back(std::chrono::steady_clock::now());
+        }
+
+        auto status = vstream.write(MemoryView(dataset.value()));
+        if (HAILO_STREAM_ABORTED_BY_USER == status) {
+            return status;
+        }
+        CHECK_SUCCESS(status, "Failed writing to {} with status {}", vstream.name(), status);
+    }
+}
+
+hailo_status TunerNetworkGroupRunner::run_output(OutputVStream &vstream, bool is_first)
+{
+    auto result = Buffer::create(vstream.get_frame_size());
+    CHECK_EXPECTED_AS_STATUS(result);
+    while (true) {
+        auto status = vstream.read(MemoryView(result.value()));
+        if (HAILO_STREAM_ABORTED_BY_USER == status) {
+            return status;
+        }
+        CHECK_SUCCESS(status, "Failed reading from {} with status {}", vstream.name(), status);
+
+        if (is_first) {
+            const auto read_time = std::chrono::steady_clock::now();
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if (!m_write_times.empty()) {
+                    const std::chrono::duration<double, std::milli> latency = read_time - m_write_times.front();
+                    m_write_times.pop_front();
+                    m_latency.add_data_point(latency.count());
+                    m_frames_count++;
+                }
+            }
+            m_cv.notify_all();
+        }
+    }
+}
+
+void TunerNetworkGroupRunner::reset_measurement()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_latency.snapshot_and_clear();
+    m_frames_count = 0;
+    m_measurement_start = std::chrono::steady_clock::now();
+}
+
+NetworkGroupTrialResult TunerNetworkGroupRunner::get_measurement()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - m_measurement_start;
+    const auto p99_latency = m_latency.snapshot().percentile(TUNER_LATENCY_PERCENTILE);
+
+    NetworkGroupTrialResult result{};
+    result.network_group_name = m_network_group->name();
+    result.fps = (0 < duration.count()) ? (static_cast<double>(m_frames_count) / duration.count()) : 0;
+    result.p99_latency_ms = p99_latency ? p99_latency.value() : std::numeric_limits<double>::quiet_NaN();
+    return result;
+}
+
+static hailo_status start_power_measurement(std::vector<std::reference_wrapper<Device>> &devices)
+{
+    for (auto &device : devices) {
+        // Stopping a previous measurement (if there is one)
+        auto status = device.get().stop_power_measurement();
+        CHECK_SUCCESS(status);
+        status = device.get().set_power_measurement(HAILO_MEASUREMENT_BUFFER_INDEX_0, HAILO_DVM_OPTIONS_AUTO,
+            HAILO_POWER_MEASUREMENT_TYPES__POWER);
+        CHECK_SUCCESS(status);
+        status = device.get().start_power_measurement(HAILO_AVERAGE_FACTOR_256, HAILO_SAMPLING_PERIOD_1100US);
+        CHECK_SUCCESS(status);
+    }
+    return HAILO_SUCCESS;
+}
+
+// Returns the sum of the average power of the devices, and stops measuring
+static Expected<double> stop_power_measurement(std::vector<std::reference_wrapper<Device>> &devices)
+{
+    double total_power = 0;
+    for (auto &device : devices) {
+        auto measurement = device.get().get_power_measurement(HAILO_MEASUREMENT_BUFFER_INDEX_0, true);
+        CHECK_EXPECTED(measurement);
+        total_power += measurement->average_value;
+        auto status = device.get().stop_power_measurement();
+        CHECK_SUCCESS_AS_EXPECTED(status);
+    }
+    return total_power;
+}
+
+static bool is_equal_fps(double fps, double best_fps)
+{
+    return fps >= (best_fps * TUNER_EQUAL_FPS_RATIO);
+}
+
+bool NetworkGroupTunerSweep::is_within_latency_bound(const NetworkGroupTunerTrial &trial,
+    const NetworkGroupTunerParams &params)
+{
+    const auto max_p99_latency_ms = static_cast<double>(params.max_p99_latency.count());
+    return !std::isnan(trial.max_p99_latency_ms) &&
+        ((0 == params.max_p99_latency.count()) || (trial.max_p99_latency_ms <= max_p99_latency_ms));
+}
+
+size_t NetworkGroupTunerSweep::get_recommended_trial_index(const std::vector<NetworkGroupTunerTrial> &trials)
+{
+    assert(!trials.empty());
+    const auto by_latency = [](const NetworkGroupTunerTrial &a, const NetworkGroupTunerTrial &b) {
+        // NaN latencies (no frame was read) are the worst
+        return !std::isnan(a.max_p99_latency_ms) && (std::isnan(b.max_p99_latency_ms) ||
+            (a.max_p99_latency_ms < b.max_p99_latency_ms));
+    };
+
+    double best_fps = -1;
+    for (const auto &trial : trials) {
+        if (trial.meets_latency_bound) {
+            best_fps = std::max(best_fps, trial.total_fps);
+        }
+    }
+    if (0 > best_fps) {
+        LOGGER__WARNING("No trial is within the latency bound, recommending the trial with the lowest latency");
+        return static_cast<size_t>(std::distance(trials.begin(), std::min_element(trials.begin(), trials.end(), by_latency)));
+    }
+
+    size_t recommended_index = trials.size();
+    for (size_t i = 0; i < trials.size(); i++) {
+        const auto &trial = trials[i];
+        if (!trial.meets_latency_bound || !is_equal_fps(trial.total_fps, best_fps)) {
+            continue;
+        }
+        if (trials.size() == recommended_index) {
+            recommended_index = i;
+            continue;
+        }
+
+        const auto &recommended = trials[recommended_index];
+        const bool is_power_measured = !std::isnan(trial.power_watts) && !std::isnan(recommended.power_watts);
+        if (is_power_measured ? (trial.power_watts < recommended.power_watts) : by_latency(trial, recommended)) {
+            recommended_index = i;
+        }
+    }
+    return recommended_index;
+}
+
+// Runs the network groups (which are configured with the trial's parameters) and measures them
+static Expected<NetworkGroupTunerTrial> measure_trial(std::vector<std::unique_ptr<TunerNetworkGroupRunner>> &runners,
+    std::vector<std::reference_wrapper<Device>> &devices, bool &should_measure_power, uint16_t batch_size,
+    uint32_t threshold, std::chrono::milliseconds timeout, const NetworkGroupTunerParams &params)
+{
+    for (auto &runner : runners) {
+        auto status = runner->start();
+        CHECK_SUCCESS_AS_EXPECTED(status);
+    }
+    std::this_thread::sleep_for(params.warmup_duration);
+
+    if (should_measure_power) {
+        auto status = start_power_measurement(devices);
+        if (HAILO_SUCCESS != status) {
+            LOGGER__WARNING("Failed starting power measurement with status {}, the power won't be measured", status);
+            should_measure_power = false;
+        }
+    }
+    for (auto &runner : runners) {
+        runner->reset_measurement();
+    }
+
+    std::this_thread::sleep_for(params.trial_duration);
+
+    NetworkGroupTunerTrial trial{};
+    trial.batch_size = batch_size;
+    trial.scheduler_threshold = threshold;
+    trial.scheduler_timeout = timeout;
+    trial.total_fps = 0;
+    trial.max_p99_latency_ms = 0;
+    for (auto &runner : runners) {
+        auto status = runner->get_status();
+        CHECK_SUCCESS_AS_EXPECTED(status, "Network group failed during the trial");
+
+        trial.network_groups.emplace_back(runner->get_measurement());
+        const auto &result = trial.network_groups.back();
+        trial.total_fps += result.fps;
+        // NaN latency (no frame was read) propagates to the trial
+        trial.max_p99_latency_ms = (std::isnan(result.p99_latency_ms) || std::isnan(trial.max_p99_latency_ms)) ?
+            std::numeric_limits<double>::quiet_NaN() : std::max(trial.max_p99_latency_ms, result.p99_latency_ms);
+    }
+
+    trial.power_watts = std::numeric_limits<double>::quiet_NaN();
+    if (should_measure_power) {
+        auto power = stop_power_measurement(devices);
+        if (power) {
+            trial.power_watts = power.value();
+        } else {
+            LOGGER__WARNING("Failed getting power measurement with status {}, the power won't be measured", power.status());
+            should_measure_power = false;
+        }
+    }
+
+    return trial;
+}
+
+// The scheduler parameters are set right after configuring, since they can't be changed once frames were sent
+static Expected<std::vector<std::shared_ptr<ConfiguredNetworkGroup>>> configure_hefs(VDevice &vdevice,
+    const std::vector<std::string> &hef_paths, uint16_t batch_size, uint32_t threshold,
+    std::chrono::milliseconds timeout, std::vector<TunedNetworkGroupParams> &tuned_params)
+{
+    auto interface = vdevice.get_default_streams_interface();
+    CHECK_EXPECTED(interface);
+
+    std::vector<std::shared_ptr<ConfiguredNetworkGroup>> network_groups;
+    tuned_params.clear();
+    for (const auto &hef_path : hef_paths) {
+        auto hef = Hef::create(hef_path);
+        CHECK_EXPECTED(hef);
+        auto configure_params = hef->create_configure_params(interface.value());
+        CHECK_EXPECTED(configure_params);
+        for (auto &name_params_pair : configure_params.value()) {
+            name_params_pair.second.batch_size = batch_size;
+        }
+
+        auto configured_network_groups = vdevice.configure(hef.value(), configure_params.value());
+        CHECK_EXPECTED(configured_network_groups);
+        for (auto &network_group : configured_network_groups.value()) {
+            auto status = network_group->set_scheduler_threshold(threshold);
+            CHECK_SUCCESS_AS_EXPECTED(status);
+            status = network_group->set_scheduler_timeout(timeout);
+            CHECK_SUCCESS_AS_EXPECTED(status);
+
+            tuned_params.emplace_back(TunedNetworkGroupParams{hef_path, network_group->name(), batch_size, threshold,
+                timeout});
+            network_groups.emplace_back(network_group);
+        }
+    }
+    return network_groups;
+}
+
+// Runs a single trial on a new VDevice, and fills the parameters of the network groups it ran with.
+// Returns HAILO_NOT_SUPPORTED if the HEFs can't be configured with the trial's parameters.
+static Expected<NetworkGroupTunerTrial> run_trial(const std::vector<std::string> &hef_paths,
+    const hailo_vdevice_params_t &vdevice_params, bool &should_measure_power, uint16_t batch_size, uint32_t threshold,
+    std::chrono::milliseconds timeout, const NetworkGroupTunerParams &params,
+    std::vector<TunedNetworkGroupParams> &tuned_params)
+{
+    auto vdevice = VDevice::create(vdevice_params);
+    CHECK_EXPECTED(vdevice);
+
+    auto network_groups = configure_hefs(*vdevice.value(), hef_paths, batch_size, threshold, timeout, tuned_params);
+    if (!network_groups) {
+        // E.g. the batch size is too big for one of the network groups
+        LOGGER__WARNING("Failed configuring the HEFs with batch size {} (status {})", batch_size,
+            network_groups.status());
+        return make_unexpected(HAILO_NOT_SUPPORTED);
+    }
+
+    std::vector<std::reference_wrapper<Device>> devices;
+    if (should_measure_power) {
+        auto physical_devices = vdevice.value()->get_physical_devices();
+        if (physical_devices) {
+            devices = physical_devices.release();
+        } else {
+            // E.g. the VDevice is served by the multi process service
+            LOGGER__WARNING("Failed getting the physical devices with status {}, the power won't be measured",
+                physical_devices.status());
+            should_measure_power = false;
+        }
+    }
+
+    std::vector<std::unique_ptr<TunerNetworkGroupRunner>> runners;
+    for (auto &network_group : network_groups.value()) {
+        auto runner = TunerNetworkGroupRunner::create(network_group, batch_size);
+        CHECK_EXPECTED(runner);
+        runners.emplace_back(runner.release());
+    }
+
+    auto trial = measure_trial(runners, devices, should_measure_power, batch_size, threshold, timeout, params);
+    auto status = HAILO_SUCCESS;
+    for (auto &runner : runners) {
+        auto runner_status = runner->stop();
+        if (HAILO_SUCCESS != runner_status) {
+            status = runner_status;
+        }
+    }
+    CHECK_EXPECTED(trial);
+    CHECK_SUCCESS_AS_EXPECTED(status);
+    return trial.release();
+}
+
+Expected<NetworkGroupTunerResult> NetworkGroupTunerSweep::run(const NetworkGroupTunerParams &params,
+    const TunerTrialRunner &run_trial, const NetworkGroupTuner::TrialCallback &trial_callback)
+{
+    NetworkGroupTunerResult result{};
+    // The parameters of the network groups of every trial
+    std::vector<std::vector<TunedNetworkGroupParams>> trials_params;
+    for (const auto batch_size : params.batch_sizes) {
+        LOGGER__INFO("Tuning with batch size {}", batch_size);
+        bool is_batch_size_supported = true;
+        for (const auto threshold : params.scheduler_thresholds) {
+            if (!is_batch_size_supported) {
+                break;
+            }
+            if ((HAILO_DEFAULT_BATCH_SIZE != batch_size) && (threshold > batch_size)) {
+                continue;
+            }
+            for (const auto &timeout : params.scheduler_timeouts) {
+                std::vector<TunedNetworkGroupParams> tuned_params;
+                auto trial = run_trial(batch_size, threshold, timeout, tuned_params);
+                if (HAILO_NOT_SUPPORTED == trial.status()) {
+                    LOGGER__WARNING("Skipping batch size {}", batch_size);
+                    is_batch_size_supported = false;
+                    break;
+                }
+                CHECK_EXPECTED(trial, "Failed running trial (batch size {}, threshold {}, timeout {}ms)", batch_size,
+                    threshold, timeout.count());
+                trial->meets_latency_bound = is_within_latency_bound(trial.value(), params);
+                result.trials.emplace_back(trial.release());
+                trials_params.emplace_back(std::move(tuned_params));
+                if (trial_callback) {
+                    trial_callback(result.trials.back());
+                }
+            }
+        }
+    }
+    CHECK_AS_EXPECTED(!result.trials.empty(), HAILO_INVALID_OPERATION, "No tuning trial was run successfully");
+
+    result.recommended_trial_index = get_recommended_trial_index(result.trials);
+    result.recommended_params = trials_params[result.recommended_trial_index];
+    return result;
+}
+
+NetworkGroupTunerParams NetworkGroupTuner::get_default_params()
+{
+    NetworkGroupTunerParams params{};
+    params.batch_sizes = DEFAULT_TUNER_BATCH_SIZES;
+    params.scheduler_thresholds = DEFAULT_TUNER_SCHEDULER_THRESHOLDS;
+    params.scheduler_timeouts = DEFAULT_TUNER_SCHEDULER_TIMEOUTS;
+    params.warmup_duration = DEFAULT_TUNER_WARMUP_DURATION;
+    params.trial_duration = DEFAULT_TUNER_TRIAL_DURATION;
+    params.max_p99_latency = std::chrono::milliseconds(0);
+    params.measure_power = true;
+    return params;
+}
+
+Expected<NetworkGroupTunerResult> NetworkGroupTuner::tune(const std::vector<std::string> &hef_paths,
+    const NetworkGroupTunerParams &params, const hailo_vdevice_params_t &vdevice_params,
+    const TrialCallback &trial_callback)
+{
+    CHECK_AS_EXPECTED(!hef_paths.empty(), HAILO_INVALID_ARGUMENT, "No HEF was given to tune");
+    CHECK_AS_EXPECTED(!params.batch_sizes.empty() && !params.scheduler_thresholds.empty() &&
+        !params.scheduler_timeouts.empty(), HAILO_INVALID_ARGUMENT, "The tuner must be given batch sizes, thresholds and timeouts");
+    CHECK_AS_EXPECTED(HAILO_SCHEDULING_ALGORITHM_NONE != vdevice_params.scheduling_algorithm, HAILO_INVALID_ARGUMENT,
+        "Tuning the network groups requires a VDevice with scheduling enabled");
+
+    bool should_measure_power = params.measure_power;
+    const auto run_trial_on_vdevice = [&hef_paths, &vdevice_params, &should_measure_power, &params](uint16_t batch_size,
+        uint32_t threshold, std::chrono::milliseconds timeout, std::vector<TunedNetworkGroupParams> &tuned_params) {
+        return run_trial(hef_paths, vdevice_params, should_measure_power, batch_size, threshold, timeout, params,
+            tuned_params);
+    };
+    return NetworkGroupTunerSweep::run(params, run_trial_on_vdevice, trial_callback);
+}
+
+hailo_status NetworkGroupTuner::save_config(const std::vector<TunedNetworkGroupParams> &tuned_params,
+    const std::string &config_path)
+{
+    nlohmann::ordered_json network_groups = nlohmann::ordered_json::array();
+    for (const auto &params : tuned_params) {
+        network_groups.push_back({
+            {TUNER_CONFIG_HEF_KEY, params.hef_path},
+            {TUNER_CONFIG_NETWORK_GROUP_NAME_KEY, params.network_group_name},
+            {TUNER_CONFIG_BATCH_SIZE_KEY, params.batch_size},
+            {TUNER_CONFIG_SCHEDULER_THRESHOLD_KEY, params.scheduler_threshold},
+            {TUNER_CONFIG_SCHEDULER_TIMEOUT_KEY, params.scheduler_timeout.count()}
+        });
+    }
+    nlohmann::ordered_json config = {{TUNER_CONFIG_NETWORK_GROUPS_KEY, network_groups}};
+
+    std::ofstream config_file(config_path, std::ios::out | std::ios::trunc);
+    CHECK(config_file.is_open(), HAILO_OPEN_FILE_FAILURE, "Failed opening tuner config file {}", config_path);
+    // Invalid UTF-8 in the paths is replaced (instead of failing the dump)
+    config_file << config.dump(4, ' ', false, nlohmann::ordered_json::error_handler_t::replace) << std::endl;
+    CHECK(config_file.good(), HAILO_FILE_OPERATION_FAILURE, "Failed writing tuner config file {}", config_path);
+    return HAILO_SUCCESS;
+}
+
+Expected<std::vector<TunedNetworkGroupParams>> NetworkGroupTuner::load_config(const std::string &config_path)
+{
+    std::ifstream config_file(config_path);
+    CHECK_AS_EXPECTED(config_file.is_open(), HAILO_OPEN_FILE_FAILURE, "Failed opening tuner config file {}", config_path);
+
+    // libhailort is built without exceptions, so the config is parsed (and its fields are checked) without throwing
+    const auto config = nlohmann::json::parse(config_file, nullptr, false);
+    CHECK_AS_EXPECTED(!config.is_discarded() && config.is_object(), HAILO_INVALID_ARGUMENT,
+        "Tuner config file {} isn't a valid JSON object", config_path);
+    const auto network_groups = config.find(TUNER_CONFIG_NETWORK_GROUPS_KEY);
+    CHECK_AS_EXPECTED((config.end() != network_groups) && network_groups->is_array(), HAILO_INVALID_ARGUMENT,
+        "Tuner config file {} must have a '{}' array", config_path, TUNER_CONFIG_NETWORK_GROUPS_KEY);
+
+    std::vector<TunedNetworkGroupParams> tuned_params;
+    for (const auto &network_group : *network_groups) {
+        CHECK_AS_EXPECTED(network_group.is_object(), HAILO_INVALID_ARGUMENT, "Invalid network group in tuner config file {}",
+            config_path);
+        const auto hef_path = network_group.find(TUNER_CONFIG_HEF_KEY);
+        const auto name = network_group.find(TUNER_CONFIG_NETWORK_GROUP_NAME_KEY);
+        const auto batch_size = network_group.find(TUNER_CONFIG_BATCH_SIZE_KEY);
+        const auto threshold = network_group.find(TUNER_CONFIG_SCHEDULER_THRESHOLD_KEY);
+        const auto timeout = network_group.find(TUNER_CONFIG_SCHEDULER_TIMEOUT_KEY);
+        CHECK_AS_EXPECTED((network_group.end() != hef_path) && hef_path->is_string(), HAILO_INVALID_ARGUMENT,
+            "Network group in tuner config file {} must have a '{}' string", config_path, TUNER_CONFIG_HEF_KEY);
+        CHECK_AS_EXPECTED((network_group.end() == name) || name->is_string(), HAILO_INVALID_ARGUMENT,
+            "'{}' in tuner config file {} must be a string", TUNER_CONFIG_NETWORK_GROUP_NAME_KEY, config_path);
+        CHECK_AS_EXPECTED((network_group.end() != batch_size) && batch_size->is_number_unsigned() &&
+            (batch_size->get<uint64_t>() <= UINT16_MAX), HAILO_INVALID_ARGUMENT,
+            "Network group in tuner config file {} must have a valid '{}'", config_path, TUNER_CONFIG_BATCH_SIZE_KEY);
+        CHECK_AS_EXPECTED((network_group.end() != threshold) && threshold->is_number_unsigned() &&
+            (threshold->get<uint64_t>() <= UINT32_MAX), HAILO_INVALID_ARGUMENT,
+            "Network group in tuner config file {} must have a valid '{}'", config_path, TUNER_CONFIG_SCHEDULER_THRESHOLD_KEY);
+        CHECK_AS_EXPECTED((network_group.end() != timeout) && timeout->is_number_unsigned() &&
+            (timeout->get<uint64_t>() <= UINT32_MAX), HAILO_INVALID_ARGUMENT,
+            "Network group in tuner config file {} must have a valid '{}'", config_path, TUNER_CONFIG_SCHEDULER_TIMEOUT_KEY);
+
+        tuned_params.emplace_back(TunedNetworkGroupParams{
+            hef_path->get<std::string>(),
+            (network_group.end() == name) ? "" : name->get<std::string>(),
+            static_cast<uint16_t>(batch_size->get<uint64_t>()),
+            static_cast<uint32_t>(threshold->get<uint64_t>()),
+            std::chrono::milliseconds(timeout->get<uint64_t>())
+        });
+    }
+    return tuned_params;
+}
+
+Expected<std::vector<std::shared_ptr<ConfiguredNetworkGroup>>> NetworkGroupTuner::configure(VDevice &vdevice,
+    const std::vector<TunedNetworkGroupParams> &tuned_params)
+{
+    auto interface = vdevice.get_default_streams_interface();
+    CHECK_EXPECTED(interface);
+
+    std::vector<std::shared_ptr<ConfiguredNetworkGroup>> network_groups;
+    for (const auto &params : tuned_params) {
+        auto hef = Hef::create(params.hef_path);
+        CHECK_EXPECTED(hef);
+
+        auto network_group_name = params.network_group_name;
+        if (network_group_name.empty()) {
+            const auto names = hef->get_network_groups_names();
+            CHECK_AS_EXPECTED(1 == names.size(), HAILO_INVALID_ARGUMENT,
+                "HEF {} doesn't contain a single network group, so the network group name must be given", params.hef_path);
+            network_group_name = names[0];
+        }
+
+        auto configure_params = hef->create_configure_params(interface.value(), network_group_name);
+        CHECK_EXPECTED(configure_params);
+        configure_params->batch_size = params.batch_size;
+        auto configured_network_groups = vdevice.configure(hef.value(), {{network_group_name, configure_params.value()}});
+        CHECK_EXPECTED(configured_network_groups);
+        assert(1 == configured_network_groups->size());
+        auto network_group = configured_network_groups.value()[0];
+
+        auto status = network_group->set_scheduler_threshold(params.scheduler_threshold);
+        CHECK_SUCCESS_AS_EXPECTED(status);
+        status = network_group->set_scheduler_timeout(params.scheduler_timeout);
+        CHECK_SUCCESS_AS_EXPECTED(status);
+        network_groups.emplace_back(network_group);
+    }
+    return network_groups;
+}
+
+} /* namespace hailort */
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file network_group_tuner_internal.hpp
+ * @brief The sweep of the network group tuner - which trials are run, and which of them is recommended.
+ *        The trials themselves are run by a TunerTrialRunner (on a VDevice, see NetworkGroupTuner::tune).
+ **/
+
+#ifndef _HAILO_NETWORK_GROUP_TUNER_INTERNAL_HPP_
+#define _HAILO_NETWORK_GROUP_TUNER_INTERNAL_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+#include "hailo/network_group_tuner.hpp"
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace hailort
+{
+
+// Runs a single trial, and fills the parameters of the network groups it ran with. The trial's meets_latency_bound is
+// set by the sweep. Returns HAILO_NOT_SUPPORTED if the HEFs can't be configured with the trial's batch size.
+using TunerTrialRunner = std::function<Expected<NetworkGroupTunerTrial>(uint16_t batch_size, uint32_t threshold,
+    std::chrono::milliseconds timeout, std::vector<TunedNetworkGroupParams> &tuned_params)>;
+
+class NetworkGroupTunerSweep final
+{
+public:
+    // Runs a trial for every batch size, threshold (up to the batch size) and timeout in params. The remaining trials
+    // of a batch size are skipped if the HEFs can't be configured with it.
+    static Expected<NetworkGroupTunerResult> run(const NetworkGroupTunerParams &params,
+        const TunerTrialRunner &run_trial, const NetworkGroupTuner::TrialCallback &trial_callback);
+
+    static bool is_within_latency_bound(const NetworkGroupTunerTrial &trial, const NetworkGroupTunerParams &params);
+    static size_t get_recommended_trial_index(const std::vector<NetworkGroupTunerTrial> &trials);
+
+    NetworkGroupTunerSweep() = delete;
+};
+
+} /* namespace hailort */
+
+#endif /* _HAILO_NETWORK_GROUP_TUNER_INTERNAL_HPP_ */
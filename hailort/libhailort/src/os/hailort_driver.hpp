@@ -138,8 +138,9 @@ public:
     Expected<VdmaChannelHandle> vdma_channel_enable(vdma::ChannelId channel_id, DmaDirection data_direction,
         bool enable_timestamps_measure);
     hailo_status vdma_channel_disable(vdma::ChannelId channel_index, VdmaChannelHandle channel_handle);
+    // log_timeout should be false when a timeout is an expected result (e.g. waiting with a short timeout while polling)
     Expected<ChannelInterruptTimestampList> wait_channel_interrupts(vdma::ChannelId channel_id,
-        VdmaChannelHandle channel_handle, const std::chrono::milliseconds &timeout);
+        VdmaChannelHandle channel_handle, const std::chrono::milliseconds &timeout, bool log_timeout = true);
     hailo_status vdma_channel_abort(vdma::ChannelId channel_id, VdmaChannelHandle channel_handle);
     hailo_status vdma_channel_clear_abort(vdma::ChannelId channel_id, VdmaChannelHandle channel_handle);
 
@@ -26,6 +26,9 @@ public:
 
     static Expected<MmapBufferImpl> create_shared_memory(size_t length);
     static Expected<MmapBufferImpl> create_file_map(size_t length, FileDescriptor &file, uintptr_t offset);
+    // Maps the whole file (read only). Returns HAILO_NOT_IMPLEMENTED on platforms that don't support it.
+    // An empty file isn't mapped - an unmapped buffer of size 0 is returned.
+    static Expected<MmapBufferImpl> create_file_map_readonly(const std::string &file_path);
 
     MmapBufferImpl() : m_address(INVALID_ADDR), m_length(0), m_unmappable(false) {}
 
@@ -52,6 +55,10 @@ public:
         return m_address;
     }
 
+    size_t size() const {
+        return m_length;
+    }
+
     explicit operator bool() const
     {
         return (INVALID_ADDR != m_address);
@@ -90,6 +97,16 @@ public:
         return MmapBuffer<T>(std::move(mmap.release()));
     }
 
+    static Expected<MmapBuffer<T>> create_file_map_readonly(const std::string &file_path)
+    {
+        auto mmap = MmapBufferImpl::create_file_map_readonly(file_path);
+        if (HAILO_NOT_IMPLEMENTED == mmap.status()) {
+            return make_unexpected(mmap.status());
+        }
+        CHECK_EXPECTED(mmap);
+        return MmapBuffer<T>(std::move(mmap.release()));
+    }
+
 
     MmapBuffer() = default;
     ~MmapBuffer() = default;
@@ -108,6 +125,11 @@ public:
         return reinterpret_cast<T*>(m_mmap.get());
     }
 
+    // Size of the mapping in bytes
+    size_t size() const {
+        return m_mmap.size();
+    }
+
 
     template<typename U=T>
     std::enable_if_t<!std::is_void<U>::value, U&> operator*()
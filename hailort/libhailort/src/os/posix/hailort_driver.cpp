@@ -508,7 +508,7 @@ hailo_status HailoRTDriver::vdma_channel_disable(vdma::ChannelId channel_id, Vdm
 }
 
 Expected<ChannelInterruptTimestampList> HailoRTDriver::wait_channel_interrupts(vdma::ChannelId channel_id,
-    VdmaChannelHandle channel_handle, const std::chrono::milliseconds &timeout)
+    VdmaChannelHandle channel_handle, const std::chrono::milliseconds &timeout, bool log_timeout)
 {
     CHECK_AS_EXPECTED(is_valid_channel_id(channel_id), HAILO_INVALID_ARGUMENT, "Invalid channel id {} given", channel_id);
     CHECK_AS_EXPECTED(timeout.count() >= 0, HAILO_INVALID_ARGUMENT);
@@ -537,7 +537,9 @@ Expected<ChannelInterruptTimestampList> HailoRTDriver::wait_channel_interrupts(v
     auto status = hailo_ioctl(this->m_fd, HAILO_VDMA_CHANNEL_WAIT_INT, &data, err);
     if (HAILO_SUCCESS != status) {
         if (HAILO_TIMEOUT == status) {
-            LOGGER__ERROR("Waiting for interrupt for channel {} timed-out (errno=ETIMEDOUT)", channel_id);
+            if (log_timeout) {
+                LOGGER__ERROR("Waiting for interrupt for channel {} timed-out (errno=ETIMEDOUT)", channel_id);
+            }
             return make_unexpected(status);
         }
         if (HAILO_STREAM_ABORTED_BY_USER == status) {
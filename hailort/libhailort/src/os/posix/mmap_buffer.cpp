@@ -13,6 +13,8 @@
 #include <sys/ioctl.h>
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <errno.h>
 
 #if defined(__linux__)
@@ -72,6 +74,27 @@ Expected<MmapBufferImpl> MmapBufferImpl::create_file_map(size_t length, FileDesc
     return MmapBufferImpl(address, length);
 }
 
+Expected<MmapBufferImpl> MmapBufferImpl::create_file_map_readonly(const std::string &file_path)
+{
+    FileDescriptor file(open(file_path.c_str(), O_RDONLY | O_CLOEXEC));
+    CHECK_AS_EXPECTED(INVALID_FD != file, HAILO_OPEN_FILE_FAILURE, "Failed to open file \"{}\". errno: {}", file_path, errno);
+
+    struct stat file_stat = {};
+    CHECK_AS_EXPECTED(0 == fstat(file, &file_stat), HAILO_FILE_OPERATION_FAILURE,
+        "Failed to stat file \"{}\". errno: {}", file_path, errno);
+    const auto length = static_cast<size_t>(file_stat.st_size);
+    if (0 == length) {
+        // An empty file can't be mapped. The caller decides whether an empty file is valid.
+        return MmapBufferImpl();
+    }
+
+    // The mapping stays valid after the file is closed
+    void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, /*offset=*/ 0);
+    CHECK_AS_EXPECTED(INVALID_ADDR != address, HAILO_FILE_OPERATION_FAILURE,
+        "Failed to mmap file \"{}\" with errno:{}", file_path, errno);
+    return MmapBufferImpl(address, length);
+}
+
 hailo_status MmapBufferImpl::unmap()
 {
     if (INVALID_ADDR != m_address) {
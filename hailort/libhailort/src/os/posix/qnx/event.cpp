@@ -65,13 +65,23 @@ hailo_status Waitable::wait_for_single_object(underlying_waitable_handle_t handl
     }
 }
 
+Event::Event(underlying_waitable_handle_t handle, const State& initial_state) :
+    Waitable(handle),
+    m_is_signaled(State::signalled == initial_state)
+{}
+
+Event::Event(Event&& other) :
+    Waitable(std::move(other)),
+    m_is_signaled(other.m_is_signaled.load())
+{}
+
 Expected<Event> Event::create(const State& initial_state)
 {
     const auto handle = open_event_handle(initial_state);
     if (INVALID_EVENT_HANDLE == handle) {
         return make_unexpected(HAILO_INTERNAL_FAILURE);
     }
-    return std::move(Event(handle));
+    return std::move(Event(handle, initial_state));
 }
 
 EventPtr Event::create_shared(const State& initial_state)
@@ -81,7 +91,7 @@ EventPtr Event::create_shared(const State& initial_state)
         return nullptr;
     }
 
-    return make_shared_nothrow<Event>(handle);
+    return make_shared_nothrow<Event>(handle, initial_state);
 }
 
 hailo_status Event::wait(std::chrono::milliseconds timeout)
@@ -91,6 +101,7 @@ hailo_status Event::wait(std::chrono::milliseconds timeout)
 
 hailo_status Event::signal()
 {
+    m_is_signaled = true;
     const auto result = neosmart::SetEvent(m_handle);
     CHECK(0 == result, HAILO_INTERNAL_FAILURE, "SetEvent failed with error {}" , result);
 
@@ -102,8 +113,14 @@ bool Event::is_auto_reset()
     return false;
 }
 
+bool Event::is_signaled() const
+{
+    return m_is_signaled;
+}
+
 hailo_status Event::reset()
 {
+    m_is_signaled = false;
     const auto result = neosmart::ResetEvent(m_handle);
     CHECK(0 == result, HAILO_INTERNAL_FAILURE, "ResetEvent failed with error {}", result);
     
@@ -256,6 +273,29 @@ hailo_status WaitOrShutdown::wait(std::chrono::milliseconds timeout)
     }
 }
 
+Expected<size_t> wait_for_any_event(const std::vector<EventPtr> &events, std::chrono::milliseconds timeout)
+{
+    std::vector<underlying_waitable_handle_t> handles;
+    handles.reserve(events.size());
+    for (const auto &event : events) {
+        handles.push_back(event->get_underlying_handle());
+    }
+
+    int wait_index = -1;
+    const uint64_t timeout_ms = (timeout.count() > INT_MAX) ? INT_MAX : static_cast<uint64_t>(timeout.count());
+    const auto wait_result = neosmart::WaitForMultipleEvents(handles.data(), static_cast<int>(handles.size()), false,
+        timeout_ms, wait_index);
+    if (ETIMEDOUT == wait_result) {
+        return make_unexpected(HAILO_TIMEOUT);
+    }
+    CHECK_AS_EXPECTED(0 == wait_result, HAILO_INTERNAL_FAILURE, "WaitForMultipleEvents Failed, error: {}", wait_result);
+    CHECK_AS_EXPECTED((0 <= wait_index) && (static_cast<size_t>(wait_index) < handles.size()), HAILO_INTERNAL_FAILURE,
+        "Invalid event index signalled in WaitForMultipleEvents, index: {}", wait_index);
+
+    // Events are manual reset, so there is nothing to do after the wait (see Event::post_wait)
+    return Expected<size_t>(static_cast<size_t>(wait_index));
+}
+
 hailo_status WaitOrShutdown::signal()
 {
     return m_waitable->signal();
@@ -124,13 +124,23 @@ l_exit:
     return status;
 }
 
+Event::Event(underlying_waitable_handle_t handle, const State& initial_state) :
+    Waitable(handle),
+    m_is_signaled(State::signalled == initial_state)
+{}
+
+Event::Event(Event&& other) :
+    Waitable(std::move(other)),
+    m_is_signaled(other.m_is_signaled.load())
+{}
+
 Expected<Event> Event::create(const State& initial_state)
 {
     const auto handle = open_event_handle(initial_state);
     if (-1 == handle) {
         return make_unexpected(HAILO_INTERNAL_FAILURE);
     }
-    return Event(handle);
+    return Event(handle, initial_state);
 }
 
 EventPtr Event::create_shared(const State& initial_state)
@@ -140,7 +150,7 @@ EventPtr Event::create_shared(const State& initial_state)
         return nullptr;
     }
 
-    return make_shared_nothrow<Event>(handle);
+    return make_shared_nothrow<Event>(handle, initial_state);
 }
 
 hailo_status Event::wait(std::chrono::milliseconds timeout)
@@ -150,6 +160,7 @@ hailo_status Event::wait(std::chrono::milliseconds timeout)
 
 hailo_status Event::signal()
 {
+    m_is_signaled = true;
     return eventfd_write(m_handle);
 }
 
@@ -158,8 +169,14 @@ bool Event::is_auto_reset()
     return false;
 }
 
+bool Event::is_signaled() const
+{
+    return m_is_signaled;
+}
+
 hailo_status Event::reset()
 {
+    m_is_signaled = false;
     if (HAILO_TIMEOUT == wait(std::chrono::seconds(0))) {
         // Event is not set nothing to do, otherwise `eventfd_read` would block forever
         return HAILO_SUCCESS;
@@ -277,6 +294,36 @@ hailo_status WaitOrShutdown::wait(std::chrono::milliseconds timeout)
     return HAILO_SUCCESS;
 }
 
+Expected<size_t> wait_for_any_event(const std::vector<EventPtr> &events, std::chrono::milliseconds timeout)
+{
+    std::vector<struct pollfd> pfds;
+    pfds.reserve(events.size());
+    for (const auto &event : events) {
+        pfds.push_back({event->get_underlying_handle(), POLLIN, 0});
+    }
+
+    const auto timeout_ms = (INT_MAX < timeout.count()) ? INT_MAX : static_cast<int>(timeout.count());
+    int poll_ret = -1;
+    do {
+        poll_ret = poll(pfds.data(), pfds.size(), timeout_ms);
+    } while ((0 > poll_ret) && (EINTR == errno));
+
+    if (0 == poll_ret) {
+        LOGGER__TRACE("Timeout");
+        return make_unexpected(HAILO_TIMEOUT);
+    }
+    CHECK_AS_EXPECTED(0 < poll_ret, HAILO_INTERNAL_FAILURE, "poll failed with errno={}", errno);
+
+    for (size_t i = 0; i < pfds.size(); i++) {
+        if (pfds[i].revents & POLLIN) {
+            return Expected<size_t>(i);
+        }
+    }
+
+    LOGGER__ERROR("None of the pfds is in read state");
+    return make_unexpected(HAILO_INTERNAL_FAILURE);
+}
+
 hailo_status WaitOrShutdown::signal()
 {
     return m_waitable->signal();
@@ -66,13 +66,23 @@ hailo_status Waitable::wait_for_single_object(underlying_waitable_handle_t handl
     }
 }
 
+Event::Event(underlying_waitable_handle_t handle, const State& initial_state) :
+    Waitable(handle),
+    m_is_signaled(State::signalled == initial_state)
+{}
+
+Event::Event(Event&& other) :
+    Waitable(std::move(other)),
+    m_is_signaled(other.m_is_signaled.load())
+{}
+
 Expected<Event> Event::create(const State& initial_state)
 {
     const auto handle = open_event_handle(initial_state);
     if (nullptr == handle) {
         return make_unexpected(HAILO_INTERNAL_FAILURE);
     }
-    return std::move(Event(handle));
+    return std::move(Event(handle, initial_state));
 }
 
 EventPtr Event::create_shared(const State& initial_state)
@@ -82,7 +92,7 @@ EventPtr Event::create_shared(const State& initial_state)
         return nullptr;
     }
 
-    return make_shared_nothrow<Event>(handle);
+    return make_shared_nothrow<Event>(handle, initial_state);
 }
 
 hailo_status Event::wait(std::chrono::milliseconds timeout)
@@ -92,6 +102,7 @@ hailo_status Event::wait(std::chrono::milliseconds timeout)
 
 hailo_status Event::signal()
 {
+    m_is_signaled = true;
     const auto result = SetEvent(m_handle);
     if (0 == result) {
         LOGGER__ERROR("SetEvent on handle={:X} failed with last_error={}", m_handle, GetLastError());
@@ -106,8 +117,14 @@ bool Event::is_auto_reset()
     return false;
 }
 
+bool Event::is_signaled() const
+{
+    return m_is_signaled;
+}
+
 hailo_status Event::reset()
 {
+    m_is_signaled = false;
     const auto result = ResetEvent(m_handle);
     if (0 == result) {
         LOGGER__ERROR("ResetEvent on handle={:X} failed with last_error={}", m_handle, GetLastError());
@@ -210,6 +227,29 @@ hailo_status WaitOrShutdown::wait(std::chrono::milliseconds timeout)
     }
 }
 
+Expected<size_t> wait_for_any_event(const std::vector<EventPtr> &events, std::chrono::milliseconds timeout)
+{
+    CHECK_AS_EXPECTED(events.size() <= MAXIMUM_WAIT_OBJECTS, HAILO_INVALID_ARGUMENT,
+        "Can't wait on more than {} events (got {})", MAXIMUM_WAIT_OBJECTS, events.size());
+
+    std::vector<HANDLE> handles;
+    handles.reserve(events.size());
+    for (const auto &event : events) {
+        handles.push_back(event->get_underlying_handle());
+    }
+
+    static const BOOL WAIT_FOR_ANY = false;
+    const auto wait_result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), WAIT_FOR_ANY,
+        timeout_millies(timeout.count()));
+    if (WAIT_TIMEOUT == wait_result) {
+        return make_unexpected(HAILO_TIMEOUT);
+    }
+    CHECK_AS_EXPECTED((WAIT_OBJECT_0 <= wait_result) && (wait_result < (WAIT_OBJECT_0 + handles.size())),
+        HAILO_INTERNAL_FAILURE, "WaitForMultipleObjects returned {}, last_error={}", wait_result, GetLastError());
+
+    return Expected<size_t>(wait_result - WAIT_OBJECT_0);
+}
+
 hailo_status WaitOrShutdown::signal()
 {
     return m_waitable->signal();
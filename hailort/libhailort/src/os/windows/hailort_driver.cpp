@@ -631,7 +631,7 @@ static Expected<ChannelInterruptTimestampList> create_interrupt_timestamp_list(h
 }
 
 Expected<ChannelInterruptTimestampList> HailoRTDriver::wait_channel_interrupts(vdma::ChannelId channel_id,
-    VdmaChannelHandle channel_handle, const std::chrono::milliseconds &timeout)
+    VdmaChannelHandle channel_handle, const std::chrono::milliseconds &timeout, bool log_timeout)
 {
     CHECK_AS_EXPECTED(is_valid_channel_id(channel_id), HAILO_INVALID_ARGUMENT, "Invalid channel id {} given", channel_id);
     CHECK_AS_EXPECTED(timeout.count() >= 0, HAILO_INVALID_ARGUMENT);
@@ -647,7 +647,9 @@ Expected<ChannelInterruptTimestampList> HailoRTDriver::wait_channel_interrupts(v
     if (0 > ioctl(this->m_fd, HAILO_VDMA_CHANNEL_WAIT_INT, &data)) {
         const auto ioctl_errno = errno;
         if (ERROR_SEM_TIMEOUT == ioctl_errno) {
-            LOGGER__ERROR("Waiting for interrupt for channel {} timed-out", channel_id);
+            if (log_timeout) {
+                LOGGER__ERROR("Waiting for interrupt for channel {} timed-out", channel_id);
+            }
             return make_unexpected(HAILO_TIMEOUT);
         }
         if (ERROR_OPERATION_ABORTED == ioctl_errno) {
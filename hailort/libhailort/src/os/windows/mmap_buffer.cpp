@@ -21,6 +21,12 @@ Expected<MmapBufferImpl> MmapBufferImpl::create_shared_memory(size_t length)
     return MmapBufferImpl(address, length, true);
 }
 
+Expected<MmapBufferImpl> MmapBufferImpl::create_file_map_readonly(const std::string &file_path)
+{
+    (void)file_path;
+    return make_unexpected(HAILO_NOT_IMPLEMENTED);
+}
+
 hailo_status MmapBufferImpl::unmap()
 {
     if (m_unmappable) {
@@ -15,7 +15,9 @@ namespace hailort
 {
 
 PipelineBuffer::Metadata::Metadata(PipelineTimePoint start_time) :
-    m_start_time(start_time)
+    m_start_time(start_time),
+    m_has_frame_layout(false),
+    m_frame_layout()
 {}
 
 PipelineBuffer::Metadata::Metadata() :
@@ -32,6 +34,22 @@ void PipelineBuffer::Metadata::set_start_time(PipelineTimePoint val)
     m_start_time = val;
 }
 
+const hailo_frame_layout_t *PipelineBuffer::Metadata::get_frame_layout() const
+{
+    return m_has_frame_layout ? &m_frame_layout : nullptr;
+}
+
+void PipelineBuffer::Metadata::set_frame_layout(const hailo_frame_layout_t &frame_layout)
+{
+    m_frame_layout = frame_layout;
+    m_has_frame_layout = true;
+}
+
+void PipelineBuffer::Metadata::clear_frame_layout()
+{
+    m_has_frame_layout = false;
+}
+
 PipelineBuffer::PipelineBuffer() :
     PipelineBuffer(Type::DATA)
 {}
@@ -42,7 +60,8 @@ PipelineBuffer::PipelineBuffer(Type type) :
     m_should_release_buffer(false),
     m_pool(nullptr),
     m_view(),
-    m_metadata()
+    m_metadata(),
+    m_shared_buffer()
 {}
 
 PipelineBuffer::PipelineBuffer(MemoryView view, bool should_measure) :
@@ -51,7 +70,8 @@ PipelineBuffer::PipelineBuffer(MemoryView view, bool should_measure) :
     m_should_release_buffer(false),
     m_pool(nullptr),
     m_view(view),
-    m_metadata(Metadata(add_timestamp(should_measure)))
+    m_metadata(Metadata(add_timestamp(should_measure))),
+    m_shared_buffer()
 {}
 
 PipelineBuffer::PipelineBuffer(Buffer &&buffer, BufferPoolPtr pool, bool should_measure) :
@@ -60,7 +80,18 @@ PipelineBuffer::PipelineBuffer(Buffer &&buffer, BufferPoolPtr pool, bool should_
     m_should_release_buffer(true),
     m_pool(pool),
     m_view(m_buffer),
-    m_metadata(Metadata(add_timestamp(should_measure)))
+    m_metadata(Metadata(add_timestamp(should_measure))),
+    m_shared_buffer()
+{}
+
+PipelineBuffer::PipelineBuffer(MemoryView view, std::shared_ptr<PipelineBuffer> shared_buffer) :
+    m_type(Type::DATA),
+    m_buffer(),
+    m_should_release_buffer(false),
+    m_pool(nullptr),
+    m_view(view),
+    m_metadata(shared_buffer->get_metadata()),
+    m_shared_buffer(std::move(shared_buffer))
 {}
 
 PipelineBuffer::PipelineBuffer(PipelineBuffer &&other) :
@@ -69,7 +100,8 @@ PipelineBuffer::PipelineBuffer(PipelineBuffer &&other) :
     m_should_release_buffer(std::exchange(other.m_should_release_buffer, false)),
     m_pool(std::move(other.m_pool)),
     m_view(std::move(other.m_view)),
-    m_metadata(std::move(other.m_metadata))
+    m_metadata(std::move(other.m_metadata)),
+    m_shared_buffer(std::move(other.m_shared_buffer))
 {}
 
 PipelineBuffer &PipelineBuffer::operator=(PipelineBuffer &&other)
@@ -80,6 +112,7 @@ PipelineBuffer &PipelineBuffer::operator=(PipelineBuffer &&other)
     m_pool = std::move(other.m_pool);
     m_view = std::move(other.m_view);
     m_metadata = std::move(other.m_metadata);
+    m_shared_buffer = std::move(other.m_shared_buffer);
     return *this;
 }
 
@@ -140,7 +173,7 @@ Expected<BufferPoolPtr> BufferPool::create(size_t buffer_size, size_t buffer_cou
 {
     AccumulatorPtr queue_size_accumulator = nullptr;
     if ((elem_flags & HAILO_PIPELINE_ELEM_STATS_MEASURE_QUEUE_SIZE) != 0) {
-        queue_size_accumulator = make_shared_nothrow<FullAccumulator<double>>("queue_size");
+        queue_size_accumulator = make_shared_nothrow<HistogramAccumulator<double>>("queue_size");
         CHECK_AS_EXPECTED(nullptr != queue_size_accumulator, HAILO_OUT_OF_HOST_MEMORY);
     }
     const bool measure_vstream_latency = (vstream_flags & HAILO_VSTREAM_STATS_MEASURE_LATENCY) != 0;
@@ -194,6 +227,21 @@ Expected<PipelineBuffer> BufferPool::acquire_buffer(std::chrono::milliseconds ti
     return PipelineBuffer(buffer.release(), shared_from_this(), m_measure_vstream_latency);
 }
 
+Expected<PipelineBuffer> BufferPool::try_acquire_buffer()
+{
+    auto buffer = m_free_buffers.dequeue(std::chrono::milliseconds(0));
+    if ((HAILO_TIMEOUT == buffer.status()) || (HAILO_SHUTDOWN_EVENT_SIGNALED == buffer.status())) {
+        return make_unexpected(buffer.status());
+    }
+    CHECK_EXPECTED(buffer);
+    return PipelineBuffer(buffer.release(), shared_from_this(), m_measure_vstream_latency);
+}
+
+hailo_status BufferPool::add_free_buffer_readiness_event(ReadinessEventPtr readiness_event)
+{
+    return m_free_buffers.add_not_empty_readiness_event(readiness_event);
+}
+
 AccumulatorPtr BufferPool::get_queue_size_accumulator()
 {
     return m_queue_size_accumulator;
@@ -229,7 +277,7 @@ Expected<DurationCollector> DurationCollector::create(hailo_pipeline_elem_stats_
     AccumulatorPtr latency_accumulator = nullptr;
     const auto measure_latency = should_measure_latency(flags);
     if (measure_latency) {
-        latency_accumulator = make_shared_nothrow<FullAccumulator<double>>("latency");
+        latency_accumulator = make_shared_nothrow<HistogramAccumulator<double>>("latency");
         CHECK_AS_EXPECTED(nullptr != latency_accumulator, HAILO_OUT_OF_HOST_MEMORY);
     }
 
@@ -677,7 +725,12 @@ FilterElement::FilterElement(const std::string &name, DurationCollector &&durati
 
 hailo_status FilterElement::run_push(PipelineBuffer &&buffer)
 {
-    auto output = action(std::move(buffer), PipelineBuffer());
+    return run_push_into_buffer(std::move(buffer), PipelineBuffer());
+}
+
+hailo_status FilterElement::run_push_into_buffer(PipelineBuffer &&buffer, PipelineBuffer &&output_buffer)
+{
+    auto output = action(std::move(buffer), std::move(output_buffer));
     if (HAILO_SHUTDOWN_EVENT_SIGNALED == output.status()) {
         return output.status();
     }
@@ -697,6 +750,11 @@ hailo_status FilterElement::run_push(PipelineBuffer &&buffer)
     return HAILO_SUCCESS;
 }
 
+BufferPoolPtr FilterElement::get_buffer_pool() const
+{
+    return nullptr;
+}
+
 Expected<PipelineBuffer> FilterElement::run_pull(PipelineBuffer &&optional, const PipelinePad &/*source*/)
 {
     auto buffer = next_pad().run_pull();
@@ -902,6 +960,31 @@ std::string BaseQueueElement::description() const
     return element_description.str();
 }
 
+Expected<EventPtr> BaseQueueElement::get_queue_not_empty_event()
+{
+    return m_queue.get_not_empty_event();
+}
+
+hailo_status BaseQueueElement::add_queue_not_full_readiness_event(ReadinessEventPtr readiness_event)
+{
+    return m_queue.add_not_full_readiness_event(readiness_event);
+}
+
+bool BaseQueueElement::is_queue_empty() const
+{
+    return m_queue.is_empty();
+}
+
+bool BaseQueueElement::is_queue_full() const
+{
+    return m_queue.is_full();
+}
+
+size_t BaseQueueElement::queue_size_approx()
+{
+    return m_queue.size_approx();
+}
+
 hailo_status BaseQueueElement::pipeline_status()
 {
     auto status = m_pipeline_status->load();
@@ -932,7 +1015,7 @@ Expected<std::shared_ptr<PushQueueElement>> PushQueueElement::create(const std::
 
     AccumulatorPtr queue_size_accumulator = nullptr;
     if ((flags & HAILO_PIPELINE_ELEM_STATS_MEASURE_QUEUE_SIZE) != 0) {
-        queue_size_accumulator = make_shared_nothrow<FullAccumulator<double>>("queue_size");
+        queue_size_accumulator = make_shared_nothrow<HistogramAccumulator<double>>("queue_size");
         CHECK_AS_EXPECTED(nullptr != queue_size_accumulator, HAILO_OUT_OF_HOST_MEMORY);
     }
 
@@ -1075,7 +1158,7 @@ Expected<std::shared_ptr<PullQueueElement>> PullQueueElement::create(const std::
 
     AccumulatorPtr queue_size_accumulator = nullptr;
     if ((flags & HAILO_PIPELINE_ELEM_STATS_MEASURE_QUEUE_SIZE) != 0) {
-        queue_size_accumulator = make_shared_nothrow<FullAccumulator<double>>("queue_size");
+        queue_size_accumulator = make_shared_nothrow<HistogramAccumulator<double>>("queue_size");
         CHECK_AS_EXPECTED(nullptr != queue_size_accumulator, HAILO_OUT_OF_HOST_MEMORY);
     }
 
@@ -1201,7 +1284,7 @@ Expected<std::shared_ptr<UserBufferQueueElement>> UserBufferQueueElement::create
 
     AccumulatorPtr queue_size_accumulator = nullptr;
     if ((flags & HAILO_PIPELINE_ELEM_STATS_MEASURE_QUEUE_SIZE) != 0) {
-        queue_size_accumulator = make_shared_nothrow<FullAccumulator<double>>("queue_size");
+        queue_size_accumulator = make_shared_nothrow<HistogramAccumulator<double>>("queue_size");
         CHECK_AS_EXPECTED(nullptr != queue_size_accumulator, HAILO_OUT_OF_HOST_MEMORY);
     }
 
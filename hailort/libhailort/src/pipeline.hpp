@@ -47,9 +47,15 @@ public:
 
         PipelineTimePoint get_start_time() const;
         void set_start_time(PipelineTimePoint val);
+        // The layout of a user frame that isn't tightly packed (nullptr if the frame is packed)
+        const hailo_frame_layout_t *get_frame_layout() const;
+        void set_frame_layout(const hailo_frame_layout_t &frame_layout);
+        void clear_frame_layout();
 
     private:
         PipelineTimePoint m_start_time;
+        bool m_has_frame_layout;
+        hailo_frame_layout_t m_frame_layout;
     };
 
     enum class Type {
@@ -63,6 +69,9 @@ public:
     PipelineBuffer(Type type);
     PipelineBuffer(MemoryView view, bool should_measure = false);
     PipelineBuffer(Buffer &&buffer, BufferPoolPtr pool, bool should_measure = false);
+    // Creates a view of a buffer shared by several PipelineBuffers (e.g. a muxed frame, shared by the demuxed edges).
+    // The shared buffer is released when the last view is destroyed.
+    PipelineBuffer(MemoryView view, std::shared_ptr<PipelineBuffer> shared_buffer);
     ~PipelineBuffer();
     
     PipelineBuffer(const PipelineBuffer &) = delete;
@@ -85,6 +94,7 @@ private:
     BufferPoolPtr m_pool;
     MemoryView m_view;
     Metadata m_metadata;
+    std::shared_ptr<PipelineBuffer> m_shared_buffer;
 
     static PipelineTimePoint add_timestamp(bool should_measure);
 };
@@ -101,6 +111,10 @@ public:
 
     size_t buffer_size();
     Expected<PipelineBuffer> acquire_buffer(std::chrono::milliseconds timeout);
+    // Returns HAILO_TIMEOUT right away if there is no free buffer (without the warning logged by acquire_buffer)
+    Expected<PipelineBuffer> try_acquire_buffer();
+    // Makes the readiness event depend on the pool having a free buffer (see ReadinessEvent)
+    hailo_status add_free_buffer_readiness_event(ReadinessEventPtr readiness_event);
     AccumulatorPtr get_queue_size_accumulator();
     Expected<PipelineBuffer> get_available_buffer(PipelineBuffer &&optional, std::chrono::milliseconds timeout);
 
@@ -393,6 +407,10 @@ public:
 
     virtual hailo_status run_push(PipelineBuffer &&buffer) override;
     virtual Expected<PipelineBuffer> run_pull(PipelineBuffer &&optional, const PipelinePad &source) override;
+    // Same as run_push, where the output is written to the given buffer (acquired from get_buffer_pool())
+    hailo_status run_push_into_buffer(PipelineBuffer &&buffer, PipelineBuffer &&output_buffer);
+    // The pool that the outputs are acquired from (nullptr if the element has none)
+    virtual BufferPoolPtr get_buffer_pool() const;
 
 protected:
     // The optional buffer functions as an output buffer that the user can write to instead of acquiring a new buffer
@@ -407,6 +425,14 @@ public:
     hailo_status set_timeout(std::chrono::milliseconds timeout);
     virtual std::string description() const override;
 
+    // Used for polling the vstreams readiness (see SpscQueue::get_not_empty_event)
+    Expected<EventPtr> get_queue_not_empty_event();
+    hailo_status add_queue_not_full_readiness_event(ReadinessEventPtr readiness_event);
+    bool is_queue_empty() const;
+    bool is_queue_full() const;
+    // Sampled by the metrics exporter (see VStreamMetrics)
+    size_t queue_size_approx();
+
     static constexpr auto INIFINITE_TIMEOUT() { return std::chrono::milliseconds(HAILO_INFINITE); }
 
 protected:
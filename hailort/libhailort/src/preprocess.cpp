@@ -0,0 +1,415 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file preprocess.cpp
+ * @brief Host preprocessing of input frames - color conversion, bilinear resize and letterbox
+ **/
+
+#include "preprocess.hpp"
+#include "transform_internal.hpp"
+#include "hailort_defaults.hpp"
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace hailort
+{
+
+#define RGB_FEATURES (3)
+// Fixed point precision of the color conversion coefficients
+#define YUV_COEFF_SHIFT (10)
+// Fixed point precision of the bilinear weights (applied twice - horizontally and vertically)
+#define RESIZE_WEIGHT_SHIFT (11)
+#define RESIZE_WEIGHT_ONE (1 << RESIZE_WEIGHT_SHIFT)
+
+static const char *get_preprocess_src_format_str(hailo_preprocess_src_format_t src_format)
+{
+    switch (src_format) {
+    case HAILO_PREPROCESS_SRC_FORMAT_RGB:
+        return "RGB";
+    case HAILO_PREPROCESS_SRC_FORMAT_NV12:
+        return "NV12";
+    case HAILO_PREPROCESS_SRC_FORMAT_I420:
+        return "I420";
+    case HAILO_PREPROCESS_SRC_FORMAT_YUY2:
+        return "YUY2";
+    default:
+        return "Unknown";
+    }
+}
+
+static inline uint8_t clamp_to_uint8(int32_t value)
+{
+    return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+
+// BT.601 limited range YUV to RGB of a pixel pair, sharing the chroma terms
+static inline void yuv_pair_to_rgb(int32_t y0, int32_t y1, int32_t u, int32_t v, uint8_t *rgb)
+{
+    const int32_t round = 1 << (YUV_COEFF_SHIFT - 1);
+    const int32_t r_chroma = (1634 * (v - 128)) + round;
+    const int32_t g_chroma = round - (833 * (v - 128)) - (400 * (u - 128));
+    const int32_t b_chroma = (2066 * (u - 128)) + round;
+    const int32_t luma0 = (y0 - 16) * 1192;
+    const int32_t luma1 = (y1 - 16) * 1192;
+    rgb[0] = clamp_to_uint8((luma0 + r_chroma) >> YUV_COEFF_SHIFT);
+    rgb[1] = clamp_to_uint8((luma0 + g_chroma) >> YUV_COEFF_SHIFT);
+    rgb[2] = clamp_to_uint8((luma0 + b_chroma) >> YUV_COEFF_SHIFT);
+    rgb[3] = clamp_to_uint8((luma1 + r_chroma) >> YUV_COEFF_SHIFT);
+    rgb[4] = clamp_to_uint8((luma1 + g_chroma) >> YUV_COEFF_SHIFT);
+    rgb[5] = clamp_to_uint8((luma1 + b_chroma) >> YUV_COEFF_SHIFT);
+}
+
+// A row with one (u,v) pair for every 2 pixels (width is even), uv_step is the distance between consecutive pairs
+static void yuv_row_to_rgb(const uint8_t *y_row, size_t y_step, const uint8_t *u_row, const uint8_t *v_row,
+    size_t uv_step, uint32_t width, uint8_t *rgb_row)
+{
+    for (uint32_t pair = 0; pair < (width / 2); pair++) {
+        yuv_pair_to_rgb(y_row[(2 * pair) * y_step], y_row[((2 * pair) + 1) * y_step], u_row[pair * uv_step],
+            v_row[pair * uv_step], rgb_row + (pair * 2 * RGB_FEATURES));
+    }
+}
+
+// Horizontal pass of the bilinear resize, the result is scaled by RESIZE_WEIGHT_ONE
+static void resize_row_horizontally(const uint8_t *rgb_row, const uint32_t *x_offsets, const uint32_t *x_next_offsets,
+    const int32_t *x_weights, uint32_t width, int32_t *resized_row)
+{
+    for (uint32_t x = 0; x < width; x++) {
+        const uint8_t *left = rgb_row + x_offsets[x];
+        const uint8_t *right = rgb_row + x_next_offsets[x];
+        const int32_t weight = x_weights[x];
+        for (uint32_t c = 0; c < RGB_FEATURES; c++) {
+            resized_row[(x * RGB_FEATURES) + c] = (left[c] * (RESIZE_WEIGHT_ONE - weight)) + (right[c] * weight);
+        }
+    }
+}
+
+// Vertical pass of the bilinear resize, back to uint8
+static void blend_rows(const int32_t *top, const int32_t *bottom, int32_t weight, size_t elements_count, uint8_t *dst)
+{
+    const int32_t round = 1 << ((2 * RESIZE_WEIGHT_SHIFT) - 1);
+    for (size_t i = 0; i < elements_count; i++) {
+        dst[i] = static_cast<uint8_t>(((top[i] * (RESIZE_WEIGHT_ONE - weight)) + (bottom[i] * weight) + round) >>
+            (2 * RESIZE_WEIGHT_SHIFT));
+    }
+}
+
+// Maps a dst coordinate to the src (pixel centers aligned), returning the first src index and the weight of the next one
+static void map_coordinate(uint32_t dst_index, uint32_t dst_size, uint32_t src_size, uint32_t &src_index, int32_t &weight)
+{
+    const double src_coordinate = std::max(((dst_index + 0.5) * src_size / dst_size) - 0.5, 0.0);
+    src_index = static_cast<uint32_t>(src_coordinate);
+    if (src_index >= (src_size - 1)) {
+        src_index = src_size - 1;
+        weight = 0;
+        return;
+    }
+    weight = static_cast<int32_t>(std::lround((src_coordinate - src_index) * RESIZE_WEIGHT_ONE));
+}
+
+bool FramePreprocessor::is_enabled(const hailo_vstream_preprocess_params_t &params)
+{
+    return (HAILO_PREPROCESS_SRC_FORMAT_NONE != params.src_format);
+}
+
+Expected<size_t> FramePreprocessor::get_src_frame_size(const hailo_vstream_preprocess_params_t &params)
+{
+    CHECK_AS_EXPECTED((0 < params.src_width) && (0 < params.src_height), HAILO_INVALID_ARGUMENT,
+        "Invalid preprocess frame size {}x{}", params.src_width, params.src_height);
+    const size_t pixels_count = static_cast<size_t>(params.src_width) * params.src_height;
+    switch (params.src_format) {
+    case HAILO_PREPROCESS_SRC_FORMAT_RGB:
+        return pixels_count * RGB_FEATURES;
+    case HAILO_PREPROCESS_SRC_FORMAT_NV12:
+    case HAILO_PREPROCESS_SRC_FORMAT_I420:
+        CHECK_AS_EXPECTED((0 == (params.src_width % 2)) && (0 == (params.src_height % 2)), HAILO_INVALID_ARGUMENT,
+            "The size of {} frames must be even (got {}x{})", get_preprocess_src_format_str(params.src_format),
+            params.src_width, params.src_height);
+        return pixels_count + (pixels_count / 2);
+    case HAILO_PREPROCESS_SRC_FORMAT_YUY2:
+        CHECK_AS_EXPECTED(0 == (params.src_width % 2), HAILO_INVALID_ARGUMENT,
+            "The width of YUY2 frames must be even (got {})", params.src_width);
+        return pixels_count * 2;
+    default:
+        LOGGER__ERROR("Invalid preprocess src format {}", params.src_format);
+        return make_unexpected(HAILO_INVALID_ARGUMENT);
+    }
+}
+
+static Expected<FramePreprocessor::ContentRegion> get_content_region(const hailo_vstream_preprocess_params_t &params,
+    const hailo_3d_image_shape_t &image_shape)
+{
+    switch (params.resize_mode) {
+    case HAILO_PREPROCESS_RESIZE_STRETCH:
+        return FramePreprocessor::ContentRegion{0, 0, image_shape.width, image_shape.height};
+    case HAILO_PREPROCESS_RESIZE_LETTERBOX:
+    {
+        // Scaling by min(width ratio, height ratio), so the whole frame fits
+        const uint64_t width_by_height = static_cast<uint64_t>(image_shape.width) * params.src_height;
+        const uint64_t height_by_width = static_cast<uint64_t>(image_shape.height) * params.src_width;
+        uint32_t width = image_shape.width;
+        uint32_t height = image_shape.height;
+        if (width_by_height <= height_by_width) {
+            height = static_cast<uint32_t>((width_by_height + (params.src_width / 2)) / params.src_width);
+        } else {
+            width = static_cast<uint32_t>((height_by_width + (params.src_height / 2)) / params.src_height);
+        }
+        width = std::max(width, 1u);
+        height = std::max(height, 1u);
+        return FramePreprocessor::ContentRegion{(image_shape.width - width) / 2, (image_shape.height - height) / 2, width, height};
+    }
+    default:
+        LOGGER__ERROR("Invalid preprocess resize mode {}", params.resize_mode);
+        return make_unexpected(HAILO_INVALID_ARGUMENT);
+    }
+}
+
+Expected<std::unique_ptr<FramePreprocessor>> FramePreprocessor::create(const hailo_vstream_preprocess_params_t &params,
+    const hailo_3d_image_shape_t &image_shape, const hailo_format_t &image_format,
+    const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info)
+{
+    auto src_frame_size = get_src_frame_size(params);
+    CHECK_EXPECTED(src_frame_size);
+
+    const auto internal_image_format = HailoRTDefaults::expand_auto_format(image_format, dst_format);
+    CHECK_AS_EXPECTED((RGB_FEATURES == image_shape.features) && (HAILO_FORMAT_ORDER_NHWC == internal_image_format.order) &&
+        (HAILO_FORMAT_TYPE_UINT8 == internal_image_format.type), HAILO_NOT_SUPPORTED,
+        "Preprocessing requires an RGB input with a uint8 NHWC user buffer format (got {} features, order {}, type {})",
+        image_shape.features, HailoRTCommon::get_format_order_str(internal_image_format.order), internal_image_format.type);
+
+    auto content = get_content_region(params, image_shape);
+    CHECK_EXPECTED(content);
+
+    const auto dst_frame_size = HailoRTCommon::get_frame_size(dst_image_shape, dst_format);
+    const size_t rgb_row_size = static_cast<size_t>(image_shape.width) * RGB_FEATURES;
+
+    std::unique_ptr<InputTransformContext> row_transform;
+    std::unique_ptr<InputTransformContext> frame_transform;
+    size_t rgb_buffer_size = 0;
+    if (InputTransformContext::is_transformation_required(image_shape, image_format, dst_image_shape, dst_format,
+            dst_quant_info)) {
+        const bool is_row_separable = !TransformContextUtils::should_transpose(image_format.flags, dst_format.flags) &&
+            TransformContextUtils::is_row_separable_reorder(internal_image_format, dst_format) &&
+            (image_shape.height == dst_image_shape.height);
+        if (is_row_separable) {
+            auto image_row_shape = image_shape;
+            image_row_shape.height = 1;
+            auto dst_row_shape = dst_image_shape;
+            dst_row_shape.height = 1;
+            auto transform = InputTransformContext::create(image_row_shape, image_format, dst_row_shape, dst_format,
+                dst_quant_info);
+            CHECK_EXPECTED(transform);
+            row_transform = transform.release();
+            rgb_buffer_size = rgb_row_size;
+        } else {
+            auto transform = InputTransformContext::create(image_shape, image_format, dst_image_shape, dst_format,
+                dst_quant_info);
+            CHECK_EXPECTED(transform);
+            frame_transform = transform.release();
+            rgb_buffer_size = rgb_row_size * image_shape.height;
+        }
+    }
+
+    Buffer rgb_buffer;
+    if (0 != rgb_buffer_size) {
+        auto buffer = Buffer::create(rgb_buffer_size);
+        CHECK_EXPECTED(buffer);
+        rgb_buffer = buffer.release();
+    }
+
+    Buffer src_rgb_row;
+    if (HAILO_PREPROCESS_SRC_FORMAT_RGB != params.src_format) {
+        auto buffer = Buffer::create(static_cast<size_t>(params.src_width) * RGB_FEATURES);
+        CHECK_EXPECTED(buffer);
+        src_rgb_row = buffer.release();
+    }
+
+    auto preprocessor = make_unique_nothrow<FramePreprocessor>(params, image_shape, src_frame_size.value(), dst_frame_size,
+        content.value(), std::move(row_transform), std::move(frame_transform), std::move(rgb_buffer), std::move(src_rgb_row));
+    CHECK_NOT_NULL_AS_EXPECTED(preprocessor, HAILO_OUT_OF_HOST_MEMORY);
+
+    return preprocessor;
+}
+
+FramePreprocessor::FramePreprocessor(const hailo_vstream_preprocess_params_t &params, const hailo_3d_image_shape_t &image_shape,
+    size_t src_frame_size, size_t dst_frame_size, const ContentRegion &content,
+    std::unique_ptr<InputTransformContext> &&row_transform, std::unique_ptr<InputTransformContext> &&frame_transform,
+    Buffer &&rgb_buffer, Buffer &&src_rgb_row) :
+    m_params(params),
+    m_image_shape(image_shape),
+    m_src_frame_size(src_frame_size),
+    m_dst_frame_size(dst_frame_size),
+    m_content(content),
+    m_should_resize((content.width != params.src_width) || (content.height != params.src_height)),
+    m_row_transform(std::move(row_transform)),
+    m_frame_transform(std::move(frame_transform)),
+    m_rgb_buffer(std::move(rgb_buffer)),
+    m_src_rgb_row(std::move(src_rgb_row)),
+    m_resized_rows_indices{{NO_SRC_ROW, NO_SRC_ROW}}
+{
+    if (!m_should_resize) {
+        return;
+    }
+
+    m_x_offsets.resize(m_content.width);
+    m_x_next_offsets.resize(m_content.width);
+    m_x_weights.resize(m_content.width);
+    for (uint32_t x = 0; x < m_content.width; x++) {
+        uint32_t src_x = 0;
+        map_coordinate(x, m_content.width, m_params.src_width, src_x, m_x_weights[x]);
+        m_x_offsets[x] = src_x * RGB_FEATURES;
+        m_x_next_offsets[x] = std::min(src_x + 1, m_params.src_width - 1) * RGB_FEATURES;
+    }
+    for (auto &resized_row : m_resized_rows) {
+        resized_row.resize(static_cast<size_t>(m_content.width) * RGB_FEATURES);
+    }
+}
+
+hailo_status FramePreprocessor::process(const MemoryView src, MemoryView dst)
+{
+    CHECK(src.size() == m_src_frame_size, HAILO_INVALID_ARGUMENT,
+        "src size must be {}. passed size - {}", m_src_frame_size, src.size());
+    CHECK(dst.size() == m_dst_frame_size, HAILO_INVALID_ARGUMENT,
+        "dst_size must be {}. passed size - {}", m_dst_frame_size, dst.size());
+
+    // The cached rows belong to the previous frame
+    m_resized_rows_indices = {{NO_SRC_ROW, NO_SRC_ROW}};
+
+    const size_t rgb_row_size = static_cast<size_t>(m_image_shape.width) * RGB_FEATURES;
+    const size_t dst_row_size = m_dst_frame_size / m_image_shape.height;
+    for (uint32_t row = 0; row < m_image_shape.height; row++) {
+        uint8_t *rgb_row = nullptr;
+        if (nullptr != m_row_transform) {
+            rgb_row = m_rgb_buffer.data();
+        } else if (nullptr != m_frame_transform) {
+            rgb_row = m_rgb_buffer.data() + (row * rgb_row_size);
+        } else {
+            rgb_row = dst.data() + (row * rgb_row_size);
+        }
+
+        build_row(src.data(), row, rgb_row);
+
+        if (nullptr != m_row_transform) {
+            auto status = m_row_transform->transform(MemoryView(rgb_row, rgb_row_size),
+                MemoryView(dst.data() + (row * dst_row_size), dst_row_size));
+            CHECK_SUCCESS(status);
+        }
+    }
+
+    if (nullptr != m_frame_transform) {
+        auto status = m_frame_transform->transform(MemoryView(m_rgb_buffer), dst);
+        CHECK_SUCCESS(status);
+    }
+
+    return HAILO_SUCCESS;
+}
+
+void FramePreprocessor::build_row(const uint8_t *src, uint32_t row, uint8_t *rgb_row)
+{
+    const size_t rgb_row_size = static_cast<size_t>(m_image_shape.width) * RGB_FEATURES;
+    if ((row < m_content.y) || (row >= (m_content.y + m_content.height))) {
+        memset(rgb_row, m_params.letterbox_pad_value, rgb_row_size);
+        return;
+    }
+
+    const size_t left_pad_size = static_cast<size_t>(m_content.x) * RGB_FEATURES;
+    const size_t content_size = static_cast<size_t>(m_content.width) * RGB_FEATURES;
+    memset(rgb_row, m_params.letterbox_pad_value, left_pad_size);
+    memset(rgb_row + left_pad_size + content_size, m_params.letterbox_pad_value, rgb_row_size - left_pad_size - content_size);
+
+    const uint32_t content_row = row - m_content.y;
+    if (!m_should_resize) {
+        convert_src_row(src, content_row, rgb_row + left_pad_size);
+        return;
+    }
+
+    uint32_t src_row = 0;
+    int32_t weight = 0;
+    map_coordinate(content_row, m_content.height, m_params.src_height, src_row, weight);
+    const uint32_t next_src_row = (0 == weight) ? src_row : (src_row + 1);
+    const auto *top = get_resized_src_row(src, src_row, next_src_row);
+    const auto *bottom = get_resized_src_row(src, next_src_row, src_row);
+    blend_rows(top, bottom, weight, content_size, rgb_row + left_pad_size);
+}
+
+const int32_t *FramePreprocessor::get_resized_src_row(const uint8_t *src, uint32_t src_row, uint32_t other_src_row)
+{
+    for (size_t i = 0; i < m_resized_rows.size(); i++) {
+        if (src_row == m_resized_rows_indices[i]) {
+            return m_resized_rows[i].data();
+        }
+    }
+
+    // The output rows go down the frame, so the evicted row is the one which isn't needed for the current output row
+    const size_t slot = (other_src_row == m_resized_rows_indices[0]) ? 1 : 0;
+    const uint8_t *rgb_row = src + (static_cast<size_t>(src_row) * m_params.src_width * RGB_FEATURES);
+    if (HAILO_PREPROCESS_SRC_FORMAT_RGB != m_params.src_format) {
+        convert_src_row(src, src_row, m_src_rgb_row.data());
+        rgb_row = m_src_rgb_row.data();
+    }
+    resize_row_horizontally(rgb_row, m_x_offsets.data(), m_x_next_offsets.data(), m_x_weights.data(), m_content.width,
+        m_resized_rows[slot].data());
+    m_resized_rows_indices[slot] = src_row;
+    return m_resized_rows[slot].data();
+}
+
+void FramePreprocessor::convert_src_row(const uint8_t *src, uint32_t src_row, uint8_t *rgb_row) const
+{
+    const size_t width = m_params.src_width;
+    const size_t y_plane_size = width * m_params.src_height;
+    switch (m_params.src_format) {
+    case HAILO_PREPROCESS_SRC_FORMAT_RGB:
+        memcpy(rgb_row, src + (src_row * width * RGB_FEATURES), width * RGB_FEATURES);
+        break;
+    case HAILO_PREPROCESS_SRC_FORMAT_NV12:
+    {
+        const uint8_t *uv_row = src + y_plane_size + ((src_row / 2) * width);
+        yuv_row_to_rgb(src + (src_row * width), 1, uv_row, uv_row + 1, 2, m_params.src_width, rgb_row);
+        break;
+    }
+    case HAILO_PREPROCESS_SRC_FORMAT_I420:
+    {
+        const size_t chroma_row_size = width / 2;
+        const uint8_t *u_row = src + y_plane_size + ((src_row / 2) * chroma_row_size);
+        const uint8_t *v_row = src + y_plane_size + (y_plane_size / 4) + ((src_row / 2) * chroma_row_size);
+        yuv_row_to_rgb(src + (src_row * width), 1, u_row, v_row, 1, m_params.src_width, rgb_row);
+        break;
+    }
+    case HAILO_PREPROCESS_SRC_FORMAT_YUY2:
+    {
+        const uint8_t *yuyv_row = src + (src_row * width * 2);
+        yuv_row_to_rgb(yuyv_row, 2, yuyv_row + 1, yuyv_row + 3, 4, m_params.src_width, rgb_row);
+        break;
+    }
+    default:
+        // Validated on creation
+        assert(false);
+        break;
+    }
+}
+
+std::string FramePreprocessor::description() const
+{
+    std::stringstream preprocess_description;
+    preprocess_description << "Preprocess - src_format: " << get_preprocess_src_format_str(m_params.src_format) <<
+        ", src_size: (" << m_params.src_width << ", " << m_params.src_height << ")";
+    if (m_should_resize) {
+        preprocess_description << " | Resize - " <<
+            ((HAILO_PREPROCESS_RESIZE_LETTERBOX == m_params.resize_mode) ? "letterbox" : "stretch") <<
+            ", dst_size: (" << m_content.width << ", " << m_content.height << ")";
+    }
+    if (nullptr != m_row_transform) {
+        preprocess_description << " | " << m_row_transform->description() << " (by rows)";
+    } else if (nullptr != m_frame_transform) {
+        preprocess_description << " | " << m_frame_transform->description();
+    }
+    return preprocess_description.str();
+}
+
+} /* namespace hailort */
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file preprocess.hpp
+ * @brief Host preprocessing of input frames - color conversion, bilinear resize and letterbox
+ *
+ * The frame is built one RGB row at a time (in the network's input shape), and each row is quantized and reordered
+ * into the device frame right away, while it's still in the cache. The rows of the camera frame are converted and
+ * horizontally resized once (kept for the next output row), so the camera frame is read once and no full size
+ * intermediate frame is written. Device orders that can't be reordered row by row fall back to an RGB frame buffer,
+ * which is transformed as a whole.
+ **/
+
+#ifndef HAILO_PREPROCESS_HPP_
+#define HAILO_PREPROCESS_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+#include "hailo/buffer.hpp"
+#include "hailo/transform.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hailort
+{
+
+class FramePreprocessor final
+{
+public:
+    static bool is_enabled(const hailo_vstream_preprocess_params_t &params);
+    // The size of the camera frames written to the preprocessor
+    static Expected<size_t> get_src_frame_size(const hailo_vstream_preprocess_params_t &params);
+
+    /**
+     * Creates a preprocessor which converts the camera frames described by @a params to RGB frames of @a image_shape in
+     * @a image_format (the user buffer format of the vstream, must be uint8 NHWC), and transforms them to the device's
+     * @a dst_image_shape and @a dst_format.
+     */
+    static Expected<std::unique_ptr<FramePreprocessor>> create(const hailo_vstream_preprocess_params_t &params,
+        const hailo_3d_image_shape_t &image_shape, const hailo_format_t &image_format,
+        const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info);
+
+    hailo_status process(const MemoryView src, MemoryView dst);
+
+    size_t get_src_frame_size() const
+    {
+        return m_src_frame_size;
+    }
+
+    size_t get_dst_frame_size() const
+    {
+        return m_dst_frame_size;
+    }
+
+    std::string description() const;
+
+    // The region of the network's frame the camera frame is resized to (the rest is letterbox padding)
+    struct ContentRegion {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    FramePreprocessor(const hailo_vstream_preprocess_params_t &params, const hailo_3d_image_shape_t &image_shape,
+        size_t src_frame_size, size_t dst_frame_size, const ContentRegion &content,
+        std::unique_ptr<InputTransformContext> &&row_transform, std::unique_ptr<InputTransformContext> &&frame_transform,
+        Buffer &&rgb_buffer, Buffer &&src_rgb_row);
+
+private:
+    static constexpr uint32_t NO_SRC_ROW = UINT32_MAX;
+
+    void build_row(const uint8_t *src, uint32_t row, uint8_t *rgb_row);
+    const int32_t *get_resized_src_row(const uint8_t *src, uint32_t src_row, uint32_t other_src_row);
+    void convert_src_row(const uint8_t *src, uint32_t src_row, uint8_t *rgb_row) const;
+
+    const hailo_vstream_preprocess_params_t m_params;
+    const hailo_3d_image_shape_t m_image_shape;
+    const size_t m_src_frame_size;
+    const size_t m_dst_frame_size;
+    const ContentRegion m_content;
+    const bool m_should_resize;
+
+    // Transforms each RGB row to the matching device row, or the whole RGB frame (if the reorder isn't row separable)
+    std::unique_ptr<InputTransformContext> m_row_transform;
+    std::unique_ptr<InputTransformContext> m_frame_transform;
+    // A single RGB row for m_row_transform, or the whole RGB frame for m_frame_transform
+    Buffer m_rgb_buffer;
+    // A row of the camera frame converted to RGB
+    Buffer m_src_rgb_row;
+
+    // Bilinear resize plan - the left source pixel of every content column, and the weight of the right one
+    std::vector<uint32_t> m_x_offsets;
+    std::vector<uint32_t> m_x_next_offsets;
+    std::vector<int32_t> m_x_weights;
+    // The last two camera rows which were converted and horizontally resized (in fixed point)
+    std::array<std::vector<int32_t>, 2> m_resized_rows;
+    std::array<uint32_t, 2> m_resized_rows_indices;
+};
+
+} /* namespace hailort */
+
+#endif /* HAILO_PREPROCESS_HPP_ */
@@ -70,9 +70,10 @@ public:
         return m_nn_stream_config;
     };
 
-    virtual hailo_status send_pending_buffer(size_t device_index = 0)
+    virtual hailo_status send_pending_buffer(size_t device_index = 0, bool ring_doorbell = true)
     {
         (void)device_index;
+        (void)ring_doorbell;
         return HAILO_INVALID_OPERATION;
     }
 
@@ -36,6 +36,10 @@
 #include <memory>
 #include <condition_variable>
 #include <chrono>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <vector>
 
 namespace hailort
 {
@@ -111,6 +115,263 @@ protected:
     std::condition_variable m_queue_not_full;
 };
 
+#define SPSC_QUEUE_SPIN_COUNT (1000)
+
+// An event that is kept signaled while all of its conditions hold, so several semaphores (e.g. the space in a queue and
+// the free buffers of a pool) can be polled through a single event. The semaphores call update() whenever their
+// availability changes (see SpinThenWaitSemaphore::add_readiness_event). Each update re-evaluates all of the conditions
+// under the mutex, so the last update always reflects the latest state.
+class ReadinessEvent final
+{
+public:
+    static Expected<std::shared_ptr<ReadinessEvent>> create_shared()
+    {
+        auto event = Event::create_shared(Event::State::not_signalled);
+        CHECK_AS_EXPECTED(nullptr != event, HAILO_OUT_OF_HOST_MEMORY);
+
+        auto readiness_event = make_shared_nothrow<ReadinessEvent>(event);
+        CHECK_AS_EXPECTED(nullptr != readiness_event, HAILO_OUT_OF_HOST_MEMORY);
+        return readiness_event;
+    }
+
+    explicit ReadinessEvent(EventPtr event) :
+        m_event(event),
+        m_conditions(),
+        m_mutex()
+    {}
+
+    hailo_status add_condition(std::function<bool()> &&condition)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_conditions.emplace_back(std::move(condition));
+        }
+        return update();
+    }
+
+    hailo_status update()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto &condition : m_conditions) {
+            if (!condition()) {
+                return m_event->reset();
+            }
+        }
+        return m_event->signal();
+    }
+
+    EventPtr get_event() const
+    {
+        return m_event;
+    }
+
+private:
+    EventPtr m_event;
+    std::vector<std::function<bool()>> m_conditions;
+    std::mutex m_mutex;
+};
+using ReadinessEventPtr = std::shared_ptr<ReadinessEvent>;
+
+// Counting semaphore with a user space fast path (used by SpscQueue):
+// * m_count holds the semaphore's count. When it's negative, it's minus the number of waiters blocked on m_sema.
+// * wait() spins for a bounded number of iterations, trying to decrement a positive count. Only if the count stays
+//   zero, the count is decremented anyway and the waiter blocks on m_sema (or on the shutdown event).
+// * signal() increments the count, and signals m_sema only if there is a blocked waiter.
+// Hence, as long as the waiter doesn't have to block, no system calls are made.
+// Optionally (see add_readiness_event), a ReadinessEvent is updated whenever the count moves between zero and one, so the
+// semaphore's state can be polled from outside. This costs system calls only on these transitions.
+class SpinThenWaitSemaphore final
+{
+public:
+    // Note: sema's count must be zero (the initial count is held by m_count)
+    SpinThenWaitSemaphore(uint32_t initial_count, SemaphorePtr sema, EventPtr shutdown_event) :
+        m_count(initial_count),
+        m_sema(sema),
+        m_shutdown_event(shutdown_event),
+        m_sema_or_shutdown(sema, shutdown_event),
+        m_readiness_event(),
+        m_readiness_event_ptr(nullptr),
+        m_readiness_event_mutex()
+    {}
+
+    SpinThenWaitSemaphore(SpinThenWaitSemaphore &&other) :
+        m_count(other.m_count.load()),
+        m_sema(std::move(other.m_sema)),
+        m_shutdown_event(std::move(other.m_shutdown_event)),
+        m_sema_or_shutdown(std::move(other.m_sema_or_shutdown)),
+        m_readiness_event(),
+        m_readiness_event_ptr(nullptr),
+        m_readiness_event_mutex()
+    {
+        // The readiness conditions refer to the semaphore, so they can't be moved with it
+        assert(nullptr == other.m_readiness_event);
+    }
+
+    // Same semantics as WaitOrShutdown::wait (if ignore_shutdown_event is false)
+    hailo_status wait(std::chrono::milliseconds timeout, bool ignore_shutdown_event) AE_NO_TSAN
+    {
+        if (!ignore_shutdown_event && m_shutdown_event->is_signaled()) {
+            return HAILO_SHUTDOWN_EVENT_SIGNALED;
+        }
+
+        // Spinning on a single core would only delay the thread that's about to signal us
+        static const bool SHOULD_SPIN = (std::thread::hardware_concurrency() > 1);
+        const uint32_t spin_count = (SHOULD_SPIN && (std::chrono::milliseconds(0) != timeout)) ? SPSC_QUEUE_SPIN_COUNT : 1;
+        for (uint32_t i = 0; i < spin_count; i++) {
+            bool became_unavailable = false;
+            if (try_wait(became_unavailable)) {
+                return became_unavailable ? on_unavailable() : HAILO_SUCCESS;
+            }
+            if (!ignore_shutdown_event && m_shutdown_event->is_signaled()) {
+                return HAILO_SHUTDOWN_EVENT_SIGNALED;
+            }
+            cpu_relax();
+        }
+
+        if (std::chrono::milliseconds(0) == timeout) {
+            return HAILO_TIMEOUT;
+        }
+
+        const auto prev_count = m_count.fetch_sub(1, std::memory_order_acquire);
+        if (0 < prev_count) {
+            return (1 == prev_count) ? on_unavailable() : HAILO_SUCCESS;
+        }
+
+        const auto status = ignore_shutdown_event ? m_sema->wait(timeout) : m_sema_or_shutdown.wait(timeout);
+        if ((HAILO_TIMEOUT == status) || (HAILO_SHUTDOWN_EVENT_SIGNALED == status)) {
+            return cancel_wait(status);
+        }
+        return status;
+    }
+
+    hailo_status signal() AE_NO_TSAN
+    {
+        const auto prev_count = m_count.fetch_add(1, std::memory_order_release);
+        if (0 > prev_count) {
+            // There is a blocked waiter
+            return m_sema->signal();
+        }
+        if (0 == prev_count) {
+            auto readiness_event = m_readiness_event_ptr.load(std::memory_order_acquire);
+            if (nullptr != readiness_event) {
+                return readiness_event->update();
+            }
+        }
+        return HAILO_SUCCESS;
+    }
+
+    // Returns true if wait() won't block
+    bool is_available() const
+    {
+        return 0 < m_count.load(std::memory_order_acquire);
+    }
+
+    // Makes readiness_event depend on the count being positive. The readiness event might be signaled spuriously (hence
+    // is_available() should be checked after it's signaled). A semaphore is added to a single readiness event.
+    hailo_status add_readiness_event(ReadinessEventPtr readiness_event)
+    {
+        std::lock_guard<std::mutex> lock(m_readiness_event_mutex);
+        return add_readiness_event_locked(readiness_event);
+    }
+
+    // Returns an event that is signaled while the count is positive. The event is created on the first call (see
+    // add_readiness_event).
+    Expected<EventPtr> get_available_event()
+    {
+        std::lock_guard<std::mutex> lock(m_readiness_event_mutex);
+        if (nullptr == m_readiness_event) {
+            auto readiness_event = ReadinessEvent::create_shared();
+            CHECK_EXPECTED(readiness_event);
+            auto status = add_readiness_event_locked(readiness_event.release());
+            CHECK_SUCCESS_AS_EXPECTED(status);
+        }
+        return m_readiness_event->get_event();
+    }
+
+private:
+    bool try_wait(bool &became_unavailable) AE_NO_TSAN
+    {
+        auto count = m_count.load(std::memory_order_relaxed);
+        while (0 < count) {
+            if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                became_unavailable = (1 == count);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    hailo_status add_readiness_event_locked(ReadinessEventPtr readiness_event)
+    {
+        CHECK(nullptr == m_readiness_event, HAILO_INVALID_OPERATION, "The semaphore already has a readiness event");
+        m_readiness_event = readiness_event;
+        m_readiness_event_ptr.store(readiness_event.get(), std::memory_order_release);
+
+        // Transitions that happened before the event was published aren't reflected in it (add_condition updates it)
+        return readiness_event->add_condition([this]() { return is_available(); });
+    }
+
+    // Called after a wait() brought the count to zero
+    hailo_status on_unavailable()
+    {
+        auto readiness_event = m_readiness_event_ptr.load(std::memory_order_acquire);
+        if (nullptr == readiness_event) {
+            return HAILO_SUCCESS;
+        }
+        // If signal() was called after the decrement, the update re-evaluates the count anyway
+        return readiness_event->update();
+    }
+
+    // Called when the blocking wait returned without consuming m_sema, in order to undo the decrement done by wait().
+    hailo_status cancel_wait(hailo_status wait_status) AE_NO_TSAN
+    {
+        while (true) {
+            auto count = m_count.load(std::memory_order_acquire);
+            if (0 > count) {
+                if (m_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+                    return wait_status;
+                }
+                continue;
+            }
+
+            // signal() was called after the decrement, so m_sema is signaled (or is about to be) for this waiter
+            const auto status = m_sema->wait(std::chrono::milliseconds(0));
+            if (HAILO_SUCCESS == status) {
+                if (HAILO_SHUTDOWN_EVENT_SIGNALED == wait_status) {
+                    // Return the consumed signal, so it won't be lost
+                    const auto signal_status = signal();
+                    CHECK_SUCCESS(signal_status);
+                    return wait_status;
+                }
+                return HAILO_SUCCESS;
+            }
+            if (HAILO_TIMEOUT != status) {
+                return status;
+            }
+            cpu_relax();
+        }
+    }
+
+    static inline void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    std::atomic<int64_t> m_count;
+    SemaphorePtr m_sema;
+    EventPtr m_shutdown_event;
+    WaitOrShutdown m_sema_or_shutdown;
+    ReadinessEventPtr m_readiness_event;
+    std::atomic<ReadinessEvent*> m_readiness_event_ptr;
+    std::mutex m_readiness_event_mutex;
+};
+
 // Single-Producer Single-Consumer Queue
 // The queue's size is limited
 template<typename T, size_t MAX_BLOCK_SIZE = 512>
@@ -125,28 +386,26 @@ public:
     SpscQueue(size_t max_size, SemaphorePtr items_enqueued_sema, SemaphorePtr items_dequeued_sema,
               EventPtr shutdown_event, std::chrono::milliseconds default_timeout) :
         m_inner(max_size),
-        m_items_enqueued_sema_or_shutdown(items_enqueued_sema, shutdown_event),
-        m_items_enqueued_sema(items_enqueued_sema),
-        m_items_dequeued_sema_or_shutdown(items_dequeued_sema, shutdown_event),
-        m_items_dequeued_sema(items_dequeued_sema),
+        m_items_enqueued_sema(0, items_enqueued_sema, shutdown_event),
+        m_items_dequeued_sema(static_cast<uint32_t>(max_size), items_dequeued_sema, shutdown_event),
         m_default_timeout(default_timeout),
         m_size(max_size),
         m_enqueues_count(0),
+        m_has_callbacks(false),
         m_callback_mutex()
     {}
 
     virtual ~SpscQueue() = default;
     SpscQueue(SpscQueue &&other) :
         m_inner(std::move(other.m_inner)),
-        m_items_enqueued_sema_or_shutdown(std::move(other.m_items_enqueued_sema_or_shutdown)),
         m_items_enqueued_sema(std::move(other.m_items_enqueued_sema)),
-        m_items_dequeued_sema_or_shutdown(std::move(other.m_items_dequeued_sema_or_shutdown)),
         m_items_dequeued_sema(std::move(other.m_items_dequeued_sema)),
         m_default_timeout(std::move(other.m_default_timeout)),
         m_size(std::move(other.m_size)),
         m_enqueues_count(std::move(other.m_enqueues_count.load())),
         m_cant_enqueue_callback(std::move(other.m_cant_enqueue_callback)),
         m_can_enqueue_callback(std::move(other.m_can_enqueue_callback)),
+        m_has_callbacks(other.m_has_callbacks),
         m_callback_mutex()
     {}
 
@@ -166,10 +425,12 @@ public:
         //   +1 for each dequeued item
         //   -1 for each enqueued item
         //   Blocks when the queue is full (which happens when it's value reaches zero, hence it starts at queue size)
+        // The counts are held in user space by SpinThenWaitSemaphore, so the underlying semaphores start at zero and
+        // are only signaled when a waiter is blocked on them.
         const auto items_enqueued_sema = Semaphore::create_shared(0);
         CHECK_AS_EXPECTED(nullptr != items_enqueued_sema, HAILO_OUT_OF_HOST_MEMORY, "Failed creating items_enqueued_sema semaphore");
 
-        const auto items_dequeued_sema = Semaphore::create_shared(static_cast<uint32_t>(max_size));
+        const auto items_dequeued_sema = Semaphore::create_shared(0);
         CHECK_AS_EXPECTED(nullptr != items_dequeued_sema, HAILO_OUT_OF_HOST_MEMORY, "Failed creating items_dequeued_sema semaphore");
 
         return SpscQueue(max_size, items_enqueued_sema, items_dequeued_sema, shutdown_event, default_timeout);
@@ -201,12 +462,7 @@ public:
     
     Expected<T> dequeue(std::chrono::milliseconds timeout, bool ignore_shutdown_event = false) AE_NO_TSAN
     {
-        hailo_status wait_result = HAILO_UNINITIALIZED;
-        if (ignore_shutdown_event) {
-            wait_result = m_items_enqueued_sema->wait(timeout);
-        } else {
-            wait_result = m_items_enqueued_sema_or_shutdown.wait(timeout);
-        }
+        const auto wait_result = m_items_enqueued_sema.wait(timeout, ignore_shutdown_event);
 
         if (HAILO_SHUTDOWN_EVENT_SIGNALED == wait_result) {
             LOGGER__TRACE("Shutdown event has been signaled");
@@ -227,15 +483,9 @@ public:
         assert(success);
         AE_UNUSED(success);
 
-        {
-            std::unique_lock<std::mutex> lock(m_callback_mutex);
-            if ((m_size == m_enqueues_count) && m_can_enqueue_callback) {
-                m_can_enqueue_callback();
-            }
-            m_enqueues_count--;
-        }
+        on_item_dequeued();
 
-        const auto signal_result = m_items_dequeued_sema_or_shutdown.signal();
+        const auto signal_result = m_items_dequeued_sema.signal();
         if (HAILO_SUCCESS != signal_result) {
             return make_unexpected(signal_result);
         }
@@ -249,7 +499,7 @@ public:
 
     hailo_status enqueue(const T& result, std::chrono::milliseconds timeout) AE_NO_TSAN
     {
-        const auto wait_result = m_items_dequeued_sema_or_shutdown.wait(timeout);
+        const auto wait_result = m_items_dequeued_sema.wait(timeout, false);
         if (HAILO_SHUTDOWN_EVENT_SIGNALED == wait_result) {
             LOGGER__TRACE("Shutdown event has been signaled");
             return wait_result;
@@ -268,15 +518,9 @@ public:
         assert(success);
         AE_UNUSED(success);
 
-        {
-            std::unique_lock<std::mutex> lock(m_callback_mutex);
-            m_enqueues_count++;
-            if ((m_size == m_enqueues_count) && m_cant_enqueue_callback) {
-                m_cant_enqueue_callback();
-            }
-        }
+        on_item_enqueued();
 
-        return m_items_enqueued_sema_or_shutdown.signal();
+        return m_items_enqueued_sema.signal();
     }
 
     inline hailo_status enqueue(const T& result) AE_NO_TSAN
@@ -287,12 +531,7 @@ public:
     // TODO: Do away with two copies of this function? (SDK-16481)
     hailo_status enqueue(T&& result, std::chrono::milliseconds timeout, bool ignore_shutdown_event = false) AE_NO_TSAN
     {
-        hailo_status wait_result = HAILO_UNINITIALIZED;
-        if (ignore_shutdown_event) {
-            wait_result = m_items_dequeued_sema->wait(timeout);
-        } else {
-            wait_result = m_items_dequeued_sema_or_shutdown.wait(timeout);
-        }
+        const auto wait_result = m_items_dequeued_sema.wait(timeout, ignore_shutdown_event);
 
         if (HAILO_SHUTDOWN_EVENT_SIGNALED == wait_result) {
             LOGGER__TRACE("Shutdown event has been signaled");
@@ -312,15 +551,9 @@ public:
         assert(success);
         AE_UNUSED(success);
 
-        {
-            std::unique_lock<std::mutex> lock(m_callback_mutex);
-            m_enqueues_count++;
-            if ((m_size == m_enqueues_count) && m_cant_enqueue_callback) {
-                m_cant_enqueue_callback();
-            }
-        }
+        on_item_enqueued();
 
-        return m_items_enqueued_sema_or_shutdown.signal();
+        return m_items_enqueued_sema.signal();
     }
 
     // TODO: HRT-3810, remove hacky argument ignore_shutdown_event
@@ -329,6 +562,35 @@ public:
         return enqueue(std::move(result), m_default_timeout, ignore_shutdown_event);
     }
 
+    // Readiness event of the queue, signaled while an item can be dequeued without blocking (see
+    // SpinThenWaitSemaphore::get_available_event)
+    Expected<EventPtr> get_not_empty_event()
+    {
+        return m_items_enqueued_sema.get_available_event();
+    }
+
+    // Make the readiness event depend on an item being dequeued/enqueued without blocking (together with its other
+    // conditions, see ReadinessEvent)
+    hailo_status add_not_empty_readiness_event(ReadinessEventPtr readiness_event)
+    {
+        return m_items_enqueued_sema.add_readiness_event(readiness_event);
+    }
+
+    hailo_status add_not_full_readiness_event(ReadinessEventPtr readiness_event)
+    {
+        return m_items_dequeued_sema.add_readiness_event(readiness_event);
+    }
+
+    bool is_empty() const
+    {
+        return !m_items_enqueued_sema.is_available();
+    }
+
+    bool is_full() const
+    {
+        return !m_items_dequeued_sema.is_available();
+    }
+
     size_t size_approx()
     {
         return m_inner.size_approx();
@@ -348,28 +610,58 @@ public:
         return status;
     }
 
+    // Note: The callbacks should be set before the queue is used
     void set_on_cant_enqueue_callback(std::function<void()> callback)
     {
         m_cant_enqueue_callback = callback;
+        m_has_callbacks = true;
     }
 
     void set_on_can_enqueue_callback(std::function<void()> callback)
     {
         m_can_enqueue_callback = callback;
+        m_has_callbacks = true;
     }
 
 private:
+    void on_item_enqueued()
+    {
+        if (!m_has_callbacks) {
+            m_enqueues_count++;
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_callback_mutex);
+        m_enqueues_count++;
+        if ((m_size == m_enqueues_count) && m_cant_enqueue_callback) {
+            m_cant_enqueue_callback();
+        }
+    }
+
+    void on_item_dequeued()
+    {
+        if (!m_has_callbacks) {
+            m_enqueues_count--;
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_callback_mutex);
+        if ((m_size == m_enqueues_count) && m_can_enqueue_callback) {
+            m_can_enqueue_callback();
+        }
+        m_enqueues_count--;
+    }
+
     ReaderWriterQueue m_inner;
-    WaitOrShutdown m_items_enqueued_sema_or_shutdown;
-    SemaphorePtr m_items_enqueued_sema;
-    WaitOrShutdown m_items_dequeued_sema_or_shutdown;
-    SemaphorePtr m_items_dequeued_sema;
+    SpinThenWaitSemaphore m_items_enqueued_sema;
+    SpinThenWaitSemaphore m_items_dequeued_sema;
     std::chrono::milliseconds m_default_timeout;
 
     const size_t m_size;
     std::atomic_uint32_t m_enqueues_count;
     std::function<void()> m_cant_enqueue_callback;
     std::function<void()> m_can_enqueue_callback;
+    bool m_has_callbacks;
     std::mutex m_callback_mutex;
 };
 
@@ -26,6 +26,13 @@ namespace hailort
 
 #define HW_DATA_ALIGNMENT (8)
 #define RGB_FEATURES (3)
+#define ARGMAX_COLUMNS_PER_TILE (256u)
+#define TOP_K_COLUMNS_PER_TILE (256u)
+// Keys (columns * k) of the running top k kept while scanning the features
+#define TOP_K_TILE_SIZE (4096u)
+#define HAILO_NMS_TRANSFORM_THREADS_ENV_VAR "HAILO_NMS_TRANSFORM_THREADS"
+// The minimal number of bboxes in a frame for each thread merging it
+#define NMS_MIN_BBOXES_PER_THREAD (1024u)
 
 
 bool TransformContextUtils::should_quantize(const hailo_stream_direction_t stream_direction, 
@@ -78,6 +85,7 @@ bool TransformContextUtils::should_reorder(const hailo_3d_image_shape_t &src_ima
         case HAILO_FORMAT_ORDER_NCHW:
         case HAILO_FORMAT_ORDER_NV12:
         case HAILO_FORMAT_ORDER_NV21:
+        case HAILO_FORMAT_ORDER_HAILO_TOP_K:
             return true;
         default:
             LOGGER__WARN("Hailo Internal warning - Unrecognised order. Transformation optimization would not be activated");
@@ -251,10 +259,12 @@ void transform__d2h_NHWC_to_NHWC(const T *src_ptr, hailo_3d_image_shape_t *src_i
 }
 
 template<typename T>
-void transform__h2d_NV12_to_NV12(const T *src_ptr, hailo_3d_image_shape_t *src_image_shape, T *dst_ptr, hailo_3d_image_shape_t *dst_image_shape)
+void transform__h2d_NV12_to_NV12(const T *src_y_ptr, size_t src_y_row_pitch, const T *src_uv_ptr, size_t src_uv_row_pitch,
+    hailo_3d_image_shape_t *src_image_shape, T *dst_ptr, hailo_3d_image_shape_t *dst_image_shape)
 {
     /* Validate arguments */
-    ASSERT(NULL != src_ptr);
+    ASSERT(NULL != src_y_ptr);
+    ASSERT(NULL != src_uv_ptr);
     ASSERT(NULL != dst_ptr);
     uint32_t rows_count = src_image_shape->height * src_image_shape->features;
     ASSERT(0 == fmod(rows_count, 1.5));
@@ -263,29 +273,39 @@ void transform__h2d_NV12_to_NV12(const T *src_ptr, hailo_3d_image_shape_t *src_i
     auto row_leftover = dst_image_shape->width - src_image_shape->width;
 
     size_t src_offset_y = 0;
-    size_t src_offset_uv = ((static_cast<uint32_t>(rows_count / 1.5)) * src_image_shape->width);
+    size_t src_offset_uv = 0;
     size_t dst_offset = 0;
 
     for(uint32_t h = 0; h < (static_cast<uint32_t>(rows_count / 1.5)); h += 2) {
         /* Copy 2 rows of Y for each row of U,V */
         // Copy Y
         for (auto i = 0; i < 2; i++) {
-            memcpy(dst_ptr + dst_offset, src_ptr + src_offset_y, (src_image_shape->width * sizeof(T)));
-            src_offset_y += (src_image_shape->width);
+            memcpy(dst_ptr + dst_offset, src_y_ptr + src_offset_y, (src_image_shape->width * sizeof(T)));
+            src_offset_y += src_y_row_pitch;
             dst_offset += (src_image_shape->width);
             memset((dst_ptr + dst_offset), 0, (row_leftover * sizeof(T)));
             dst_offset += row_leftover;
         }
 
         // Copy U, V
-        memcpy(dst_ptr + dst_offset, (src_ptr + src_offset_uv), (src_image_shape->width * sizeof(T)));
-        src_offset_uv += src_image_shape->width;
+        memcpy(dst_ptr + dst_offset, (src_uv_ptr + src_offset_uv), (src_image_shape->width * sizeof(T)));
+        src_offset_uv += src_uv_row_pitch;
         dst_offset += src_image_shape->width;
         memset((dst_ptr + dst_offset), 0, (row_leftover * sizeof(T)));
         dst_offset += row_leftover;
     }
 }
 
+template<typename T>
+void transform__h2d_NV12_to_NV12(const T *src_ptr, hailo_3d_image_shape_t *src_image_shape, T *dst_ptr, hailo_3d_image_shape_t *dst_image_shape)
+{
+    /* The UV plane follows the Y plane, and the rows of both planes are packed */
+    uint32_t rows_count = src_image_shape->height * src_image_shape->features;
+    const T *src_uv_ptr = src_ptr + ((static_cast<uint32_t>(rows_count / 1.5)) * src_image_shape->width);
+    transform__h2d_NV12_to_NV12<T>(src_ptr, src_image_shape->width, src_uv_ptr, src_image_shape->width, src_image_shape,
+        dst_ptr, dst_image_shape);
+}
+
 template<typename T>
 void transform__h2d_NHWC_to_NHCW(const T *src_ptr, hailo_3d_image_shape_t *src_image_shape,
     T *dst_ptr, hailo_3d_image_shape_t *dst_image_shape)
@@ -380,69 +400,102 @@ void transform__d2h_NC_to_NC(const T *src_ptr, T *dst_ptr, hailo_3d_image_shape_
     memcpy(dst_ptr, src_ptr, dst_image_shape->features * sizeof(T));
 }
 
-static inline void transform__parse_and_copy_bbox (hailo_bbox_t *dst, uint64_t* proposal)
-{
-    dst->y_min = (uint16_t)((*((uint64_t*)proposal) & 0xfff000000000) >> 36);
-    dst->x_min = (uint16_t)((*((uint64_t*)proposal) & 0xfff000000) >> 24);
-    dst->y_max = (uint16_t)((*((uint64_t*)proposal) & 0xfff000) >> 12);
-    dst->x_max = (uint16_t)((*((uint64_t*)proposal) & 0xfff));
-    dst->score = (uint16_t)((*((uint64_t*)proposal) & 0xffff000000000000) >> 48);
-}
-
-void transform__d2h_NMS(const uint8_t *src_ptr, uint8_t *dst_ptr, const hailo_nms_info_t &nms_info, std::vector<size_t> &chunk_offsets)
-{
-    /* Validate arguments */
-    ASSERT(NULL != src_ptr);
-    ASSERT(NULL != dst_ptr);
-
-    uint32_t num_of_classes = nms_info.number_of_classes;
-    uint32_t bbox_size = nms_info.bbox_size;
-
-    size_t bbox_index = 0;
+/**
+ * Locates the bboxes of each class in an NMS frame, in a single pass over the classes' counters.
+ * class_src_offsets[chunk * classes + class] is the offset (in bytes) of the class' counter in the chunk, and
+ * class_dst_offsets[class] is the offset (in elements) of the class' counter in the host frame, where the bboxes of the
+ * class from all chunks are merged. The last entry of class_dst_offsets is the end of the host frame's data.
+ */
+hailo_status transform__d2h_NMS_build_class_index(const uint8_t *src_ptr, size_t src_size, const hailo_nms_info_t &nms_info,
+    std::vector<size_t> &class_src_offsets, std::vector<size_t> &class_dst_offsets)
+{
+    const uint32_t num_of_classes = nms_info.number_of_classes;
+    assert(class_src_offsets.size() == (nms_info.chunks_per_frame * num_of_classes));
+    assert(class_dst_offsets.size() == (num_of_classes + 1));
+
+    // First, count the bboxes of each class (in class_dst_offsets[class + 1])
+    std::fill(class_dst_offsets.begin(), class_dst_offsets.end(), 0);
     size_t src_offset = 0;
-    size_t dst_offset = 0;
-
-    nms_bbox_counter_t class_bboxes_count = 0;
-
-    // For each class, we need to merge bboxes from all nms chunks. Therefore we use chunk_offsets - for
-    // each nms chunk we store its offset, any time we finish parsing some class bboxes, we update the
-    // offset
-
-    // First, init the chunk_offset vector
-    assert(chunk_offsets.size() == nms_info.chunks_per_frame);
-    size_t current_offset = 0;
-    chunk_offsets[0] = current_offset;
-    for (size_t chunk_index = 1; chunk_index < nms_info.chunks_per_frame; chunk_index++) {
-        // Skip all classes. Can be optimized if we store the size of each chunk in the begining of the buffer
-        for (size_t class_index = 0; class_index < num_of_classes; class_index++) {
-            class_bboxes_count = *(reinterpret_cast<const nms_bbox_counter_t*>(src_ptr + current_offset));
-            current_offset += sizeof(nms_bbox_counter_t) + (class_bboxes_count * bbox_size); 
+    for (uint32_t chunk_index = 0; chunk_index < nms_info.chunks_per_frame; chunk_index++) {
+        for (uint32_t class_index = 0; class_index < num_of_classes; class_index++) {
+            CHECK((src_offset + sizeof(nms_bbox_counter_t)) <= src_size, HAILO_INTERNAL_FAILURE,
+                "NMS bboxes exceed the frame size (chunk {}, class {})", chunk_index, class_index);
+            nms_bbox_counter_t class_bboxes_count = 0;
+            memcpy(&class_bboxes_count, src_ptr + src_offset, sizeof(class_bboxes_count));
+
+            class_src_offsets[(chunk_index * num_of_classes) + class_index] = src_offset;
+            class_dst_offsets[class_index + 1] += class_bboxes_count;
+            src_offset += sizeof(nms_bbox_counter_t) + (class_bboxes_count * nms_info.bbox_size);
         }
-        chunk_offsets[chunk_index] = current_offset;
     }
+    CHECK(src_offset <= src_size, HAILO_INTERNAL_FAILURE, "NMS bboxes exceed the frame size ({} > {})",
+        src_offset, src_size);
 
-    // Now, the merge itself
-    for (size_t class_index = 0; class_index < num_of_classes; class_index++) {
-        nms_bbox_counter_t *dst_bbox_counter = reinterpret_cast<nms_bbox_counter_t*>(dst_ptr + dst_offset);
-        *dst_bbox_counter = 0;
+    // Then, turn the counts into offsets (each class has a counter, followed by its bboxes)
+    for (uint32_t class_index = 0; class_index < num_of_classes; class_index++) {
+        class_dst_offsets[class_index + 1] = class_dst_offsets[class_index] + 1 +
+            (HailoRTCommon::BBOX_PARAMS * class_dst_offsets[class_index + 1]);
+    }
 
-        dst_offset += sizeof(nms_bbox_counter_t);
+    return HAILO_SUCCESS;
+}
 
-        for (size_t chunk_index = 0; chunk_index < nms_info.chunks_per_frame; chunk_index++) {
-            // Add bbox from all chunks of current class
-            src_offset = chunk_offsets[chunk_index];
-            class_bboxes_count = *((nms_bbox_counter_t*)((uint8_t*)src_ptr + src_offset));
-            *dst_bbox_counter = static_cast<nms_bbox_counter_t>(*dst_bbox_counter + class_bboxes_count);
+template<typename T, bool should_dequantize>
+static inline T transform__d2h_NMS_bbox_param(uint16_t param, const hailo_quant_info_t &quant_info)
+{
+    return should_dequantize ? Quantization::dequantize_output<T, uint16_t>(param, quant_info) : static_cast<T>(param);
+}
 
-            src_offset += sizeof(nms_bbox_counter_t);
+/**
+ * Merges the bboxes of the classes [first_class, end_class) from all chunks, using the index built by
+ * transform__d2h_NMS_build_class_index. The classes are independent, so ranges of classes may be merged concurrently.
+ * Each 64 bit proposal is unpacked straight into the host bbox (hailo_bbox_t / hailo_bbox_float32_t), dequantizing it
+ * on the way, so the frame is passed only once.
+ */
+template<typename T, bool should_dequantize>
+void transform__d2h_NMS(const uint8_t *src_ptr, T *dst_ptr, const hailo_nms_info_t &nms_info,
+    const std::vector<size_t> &class_src_offsets, const std::vector<size_t> &class_dst_offsets,
+    const hailo_quant_info_t &quant_info, uint32_t first_class, uint32_t end_class)
+{
+    /* Validate arguments */
+    ASSERT(NULL != src_ptr);
+    ASSERT(NULL != dst_ptr);
 
-            for (bbox_index = 0; bbox_index < class_bboxes_count; bbox_index++) {
-                transform__parse_and_copy_bbox((hailo_bbox_t *)(dst_ptr + dst_offset), (uint64_t*)(src_ptr + src_offset));
-                src_offset += bbox_size;
-                dst_offset += sizeof(hailo_bbox_t);
+    auto rounding_tonearest_guard = RoundingToNearestGuard();
+    const uint32_t num_of_classes = nms_info.number_of_classes;
+
+    for (uint32_t class_index = first_class; class_index < end_class; class_index++) {
+        T *dst_class_ptr = dst_ptr + class_dst_offsets[class_index];
+        const size_t class_bboxes_count =
+            (class_dst_offsets[class_index + 1] - class_dst_offsets[class_index] - 1) / HailoRTCommon::BBOX_PARAMS;
+        // The bboxes count isn't dequantized
+        dst_class_ptr[0] = static_cast<T>(class_bboxes_count);
+        T *dst_bbox_ptr = dst_class_ptr + 1;
+
+        for (uint32_t chunk_index = 0; chunk_index < nms_info.chunks_per_frame; chunk_index++) {
+            const uint8_t *src_class_ptr = src_ptr + class_src_offsets[(chunk_index * num_of_classes) + class_index];
+            nms_bbox_counter_t chunk_bboxes_count = 0;
+            memcpy(&chunk_bboxes_count, src_class_ptr, sizeof(chunk_bboxes_count));
+            const uint8_t *proposal_ptr = src_class_ptr + sizeof(nms_bbox_counter_t);
+
+            for (uint32_t bbox_index = 0; bbox_index < chunk_bboxes_count; bbox_index++) {
+                // The proposals aren't aligned (they follow a 16 bit counter)
+                uint64_t proposal = 0;
+                memcpy(&proposal, proposal_ptr, sizeof(proposal));
+                dst_bbox_ptr[0] = transform__d2h_NMS_bbox_param<T, should_dequantize>(
+                    static_cast<uint16_t>((proposal >> 36) & 0xfff), quant_info); // y_min
+                dst_bbox_ptr[1] = transform__d2h_NMS_bbox_param<T, should_dequantize>(
+                    static_cast<uint16_t>((proposal >> 24) & 0xfff), quant_info); // x_min
+                dst_bbox_ptr[2] = transform__d2h_NMS_bbox_param<T, should_dequantize>(
+                    static_cast<uint16_t>((proposal >> 12) & 0xfff), quant_info); // y_max
+                dst_bbox_ptr[3] = transform__d2h_NMS_bbox_param<T, should_dequantize>(
+                    static_cast<uint16_t>(proposal & 0xfff), quant_info); // x_max
+                dst_bbox_ptr[4] = transform__d2h_NMS_bbox_param<T, should_dequantize>(
+                    static_cast<uint16_t>((proposal >> 48) & 0xffff), quant_info); // score
+
+                proposal_ptr += nms_info.bbox_size;
+                dst_bbox_ptr += HailoRTCommon::BBOX_PARAMS;
             }
-
-            chunk_offsets[chunk_index] = src_offset;
         }
     }
 }
@@ -670,6 +723,18 @@ hailo_status transform__d2h_NHCW_to_NCHW(
     return HAILO_SUCCESS;
 }
 
+template<typename T>
+static inline void argmax__update_columns(const T *feature_columns, T feature_index, T *max_values, T *max_indices,
+    uint32_t columns_count)
+{
+    // Branchless, so the compiler vectorizes it
+    for (uint32_t w = 0; w < columns_count; w++) {
+        const bool is_greater = (feature_columns[w] > max_values[w]);
+        max_values[w] = is_greater ? feature_columns[w] : max_values[w];
+        max_indices[w] = is_greater ? feature_index : max_indices[w];
+    }
+}
+
 template<typename T>
 hailo_status transform__d2h_argmax_NHCW_to_NHW(const T *src_ptr, const hailo_3d_image_shape_t &src_image_shape,
     T *dst_ptr, const hailo_3d_image_shape_t &dst_image_shape)
@@ -692,32 +757,145 @@ hailo_status transform__d2h_argmax_NHCW_to_NHW(const T *src_ptr, const hailo_3d_
 
     const auto src_row_size = src_image_shape.width * src_image_shape.features;
     const auto dst_row_size = dst_image_shape.width;
+    T max_values[ARGMAX_COLUMNS_PER_TILE];
+    T max_indices[ARGMAX_COLUMNS_PER_TILE];
     for (uint32_t r = 0; r < src_image_shape.height; r++) {
-        // For each row, we iterate on all columns, and find the max feature. It can be implemented better by iteratre
-        // over all features, and on each iteration save the max value for each column.
+        // Each row holds the columns of every feature contiguously, so we iterate over the features and keep the max
+        // of every column of a tile.
         const T *src_row = src_ptr + (r * src_row_size);
         T *dst_row = dst_ptr + (r * dst_row_size);
-        for (uint32_t w = 0; w < dst_image_shape.width; w++) {
-            const T *offset_in_row = src_row + w;
-            T max_index = 0;
-            T max_value = *offset_in_row;
+        for (uint32_t tile_start = 0; tile_start < dst_image_shape.width; tile_start += ARGMAX_COLUMNS_PER_TILE) {
+            const auto tile_width = std::min(ARGMAX_COLUMNS_PER_TILE, dst_image_shape.width - tile_start);
+            std::copy_n(src_row + tile_start, tile_width, max_values);
+            std::fill_n(max_indices, tile_width, static_cast<T>(0));
 
             for (uint32_t c = 1; c < src_image_shape.features; c++) {
-                offset_in_row += src_image_shape.width;
-                const auto &current_value = *offset_in_row;
-                if (current_value > max_value) {
-                    max_index = static_cast<T>(c);
-                    max_value = current_value;
+                const T *feature_columns = src_row + (c * src_image_shape.width) + tile_start;
+                // The columns count of full tiles is a constant, so the loop is vectorized without a scalar remainder
+                if (ARGMAX_COLUMNS_PER_TILE == tile_width) {
+                    argmax__update_columns(feature_columns, static_cast<T>(c), max_values, max_indices, ARGMAX_COLUMNS_PER_TILE);
+                } else {
+                    argmax__update_columns(feature_columns, static_cast<T>(c), max_values, max_indices, tile_width);
+                }
+            }
+
+            std::copy_n(max_indices, tile_width, dst_row + tile_start);
+        }
+    }
+
+    return HAILO_SUCCESS;
+}
+
+// The top k are kept as keys of the value followed by the inverted feature index, so a single comparison orders them
+// by value, and on ties by the lower feature index (as in argmax)
+template<typename T>
+static inline void top_k__make_keys(const T *feature_columns, uint16_t feature_index, uint32_t *keys, uint32_t columns_count)
+{
+    const uint32_t index_key = std::numeric_limits<uint16_t>::max() - feature_index;
+    for (uint32_t w = 0; w < columns_count; w++) {
+        keys[w] = (static_cast<uint32_t>(feature_columns[w]) << 16) | index_key;
+    }
+}
+
+// Keeps the higher key of every column in the rank, and carries the lower key on to the next rank
+static inline void top_k__merge_rank(uint32_t *carry_keys, uint32_t *rank_keys, uint32_t columns_count)
+{
+    for (uint32_t w = 0; w < columns_count; w++) {
+        const auto higher_key = std::max(carry_keys[w], rank_keys[w]);
+        carry_keys[w] = std::min(carry_keys[w], rank_keys[w]);
+        rank_keys[w] = higher_key;
+    }
+}
+
+template<typename T, typename D>
+hailo_status transform__d2h_top_k_NHCW(const T *src_ptr, const hailo_3d_image_shape_t &src_image_shape,
+    D *dst_ptr, const hailo_3d_image_shape_t &dst_image_shape, bool should_dequantize, const hailo_quant_info_t &quant_info)
+{
+    assert(nullptr != src_ptr);
+    assert(nullptr != dst_ptr);
+    static_assert(sizeof(T) <= sizeof(uint16_t), "Top k keys hold values of up to 16 bits");
+
+    // The shapes were validated when the transform context was created
+    const auto k = dst_image_shape.features / 2;
+    assert((0 < k) && (k <= TOP_K_TILE_SIZE));
+
+    // The keys of every rank are kept contiguously for all of the columns of a tile, so each feature is merged into
+    // the ranks by passes over contiguous columns (as in argmax)
+    uint32_t top_keys[TOP_K_TILE_SIZE];
+    uint32_t carry_keys[TOP_K_COLUMNS_PER_TILE];
+    const auto max_tile_width = std::min(TOP_K_COLUMNS_PER_TILE, TOP_K_TILE_SIZE / k);
+
+    const auto src_row_size = src_image_shape.width * src_image_shape.features;
+    const auto dst_row_size = dst_image_shape.width * dst_image_shape.features;
+    for (uint32_t r = 0; r < src_image_shape.height; r++) {
+        const T *src_row = src_ptr + (r * src_row_size);
+        D *dst_row = dst_ptr + (r * dst_row_size);
+        for (uint32_t tile_start = 0; tile_start < dst_image_shape.width; tile_start += max_tile_width) {
+            const auto tile_width = std::min(max_tile_width, dst_image_shape.width - tile_start);
+            const bool is_full_tile = (TOP_K_COLUMNS_PER_TILE == tile_width);
+
+            for (uint32_t c = 0; c < src_image_shape.features; c++) {
+                const T *feature_columns = src_row + (c * src_image_shape.width) + tile_start;
+                const auto feature_index = static_cast<uint16_t>(c);
+                if (is_full_tile) {
+                    top_k__make_keys(feature_columns, feature_index, carry_keys, TOP_K_COLUMNS_PER_TILE);
+                } else {
+                    top_k__make_keys(feature_columns, feature_index, carry_keys, tile_width);
+                }
+
+                const auto ranks_count = std::min(c, k);
+                for (uint32_t rank = 0; rank < ranks_count; rank++) {
+                    uint32_t *rank_keys = top_keys + (rank * tile_width);
+                    if (is_full_tile) {
+                        top_k__merge_rank(carry_keys, rank_keys, TOP_K_COLUMNS_PER_TILE);
+                    } else {
+                        top_k__merge_rank(carry_keys, rank_keys, tile_width);
+                    }
+                }
+                // The first k features fill the ranks, afterwards the lowest key is dropped
+                if (c < k) {
+                    std::copy_n(carry_keys, tile_width, top_keys + (c * tile_width));
                 }
             }
 
-            dst_row[w] = max_index;
+            // Only the k values of each pixel are dequantized
+            for (uint32_t w = 0; w < tile_width; w++) {
+                D *dst_pixel = dst_row + ((tile_start + w) * dst_image_shape.features);
+                for (uint32_t rank = 0; rank < k; rank++) {
+                    const auto key = top_keys[(rank * tile_width) + w];
+                    const auto value = static_cast<T>(key >> 16);
+                    dst_pixel[rank] = static_cast<D>(std::numeric_limits<uint16_t>::max() - (key & std::numeric_limits<uint16_t>::max()));
+                    dst_pixel[k + rank] = should_dequantize ? Quantization::dequantize_output<D, T>(value, quant_info) :
+                        static_cast<D>(value);
+                }
+            }
         }
     }
 
     return HAILO_SUCCESS;
 }
 
+template<typename T>
+hailo_status transform__d2h_top_k(const T *src_ptr, const hailo_3d_image_shape_t &src_image_shape, void *dst_ptr,
+    const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format, bool should_dequantize,
+    const hailo_quant_info_t &quant_info)
+{
+    switch (dst_format.type) {
+    case HAILO_FORMAT_TYPE_UINT8:
+        return transform__d2h_top_k_NHCW<T, uint8_t>(src_ptr, src_image_shape, (uint8_t*)dst_ptr, dst_image_shape,
+            should_dequantize, quant_info);
+    case HAILO_FORMAT_TYPE_UINT16:
+        return transform__d2h_top_k_NHCW<T, uint16_t>(src_ptr, src_image_shape, (uint16_t*)dst_ptr, dst_image_shape,
+            should_dequantize, quant_info);
+    case HAILO_FORMAT_TYPE_FLOAT32:
+        return transform__d2h_top_k_NHCW<T, float32_t>(src_ptr, src_image_shape, (float32_t*)dst_ptr, dst_image_shape,
+            should_dequantize, quant_info);
+    default:
+        LOGGER__ERROR("Invalid dst-buffer's type format");
+        return HAILO_INVALID_ARGUMENT;
+    }
+}
+
 
 template<typename T>
 hailo_status transform__h2d_YUY2_to_YUY2(const T *src_ptr, T *dst_ptr, uint32_t shape_size)
@@ -801,12 +979,15 @@ hailo_status transform__h2d_RGB4_to_NHCW(const T *src_ptr, const hailo_3d_image_
 
 hailo_status InputTransformContext::quantize_stream(const void *src_ptr, void *quant_buffer)
 {
-    auto shape_size = HailoRTCommon::get_shape_size(m_src_image_shape);
+    return quantize_stream(src_ptr, quant_buffer, HailoRTCommon::get_shape_size(m_src_image_shape));
+}
 
+hailo_status InputTransformContext::quantize_stream(const void *src_ptr, void *quant_buffer, uint32_t elements_count)
+{
     switch (m_src_format.type) {
         case HAILO_FORMAT_TYPE_UINT8:
             if (m_dst_format.type == HAILO_FORMAT_TYPE_UINT8) {
-                Quantization::quantize_input_buffer<uint8_t, uint8_t>((uint8_t*)src_ptr, (uint8_t*)quant_buffer, shape_size, m_dst_quant_info);
+                Quantization::quantize_input_buffer<uint8_t, uint8_t>((uint8_t*)src_ptr, (uint8_t*)quant_buffer, elements_count, m_dst_quant_info);
             }
             else {
                 return HAILO_INVALID_OPERATION;
@@ -814,7 +995,7 @@ hailo_status InputTransformContext::quantize_stream(const void *src_ptr, void *q
             break;
         case HAILO_FORMAT_TYPE_UINT16:
             if (m_dst_format.type == HAILO_FORMAT_TYPE_UINT16) {
-                Quantization::quantize_input_buffer<uint16_t, uint16_t>((uint16_t*)src_ptr, (uint16_t *)quant_buffer, shape_size, m_dst_quant_info);
+                Quantization::quantize_input_buffer<uint16_t, uint16_t>((uint16_t*)src_ptr, (uint16_t *)quant_buffer, elements_count, m_dst_quant_info);
             }
             else {
                 return HAILO_INVALID_OPERATION;
@@ -822,10 +1003,10 @@ hailo_status InputTransformContext::quantize_stream(const void *src_ptr, void *q
             break;
         case HAILO_FORMAT_TYPE_FLOAT32:
             if (m_dst_format.type == HAILO_FORMAT_TYPE_UINT8) {
-                Quantization::quantize_input_buffer<float32_t, uint8_t>((float32_t*)src_ptr, (uint8_t*)quant_buffer, shape_size, m_dst_quant_info);
+                Quantization::quantize_input_buffer<float32_t, uint8_t>((float32_t*)src_ptr, (uint8_t*)quant_buffer, elements_count, m_dst_quant_info);
             }
             else if (m_dst_format.type == HAILO_FORMAT_TYPE_UINT16) {
-                Quantization::quantize_input_buffer<float32_t, uint16_t>((float32_t*)src_ptr, (uint16_t*)quant_buffer, shape_size, m_dst_quant_info);
+                Quantization::quantize_input_buffer<float32_t, uint16_t>((float32_t*)src_ptr, (uint16_t*)quant_buffer, elements_count, m_dst_quant_info);
             }
             else {
                 return HAILO_INVALID_OPERATION;
@@ -1264,11 +1445,116 @@ hailo_status reorder_output_stream(const void *src_ptr, hailo_3d_image_shape_t s
 }
 
 /* Public funcs */
+/* Strided frames funcs */
+struct FramePlane {
+    const uint8_t *first_row;
+    size_t row_pitch;
+    uint32_t rows_count;
+    // The size of a row in the plane of a packed frame
+    size_t packed_row_size;
+};
+
+static Expected<std::vector<FramePlane>> get_frame_planes(const MemoryView src, const hailo_frame_layout_t &src_layout,
+    const hailo_3d_image_shape_t &shape, const hailo_format_t &format)
+{
+    const auto data_bytes = HailoRTCommon::get_format_data_bytes(format);
+    std::vector<FramePlane> planes;
+    switch (format.order) {
+    case HAILO_FORMAT_ORDER_NV12:
+    case HAILO_FORMAT_ORDER_NV21:
+    {
+        CHECK_AS_EXPECTED((0 == (src_layout.roi_x % 2)) && (0 == (src_layout.roi_y % 2)), HAILO_INVALID_ARGUMENT,
+            "The region of interest of {} frames must start at an even row and column (got x={}, y={})",
+            HailoRTCommon::get_format_order_str(format.order), src_layout.roi_x, src_layout.roi_y);
+        const auto y_rows_count = static_cast<uint32_t>((shape.height * shape.features) / 1.5);
+        const size_t row_size = shape.width * data_bytes;
+        const size_t roi_x_offset = src_layout.roi_x * data_bytes;
+        planes.push_back({src.data() + src_layout.plane_offsets[0] + (src_layout.roi_y * src_layout.row_pitches[0]) + roi_x_offset,
+            src_layout.row_pitches[0], y_rows_count, row_size});
+        // The UV plane is subsampled vertically, and horizontally holds one (U,V) pair for every 2 pixels
+        planes.push_back({src.data() + src_layout.plane_offsets[1] + ((src_layout.roi_y / 2) * src_layout.row_pitches[1]) + roi_x_offset,
+            src_layout.row_pitches[1], y_rows_count / 2, row_size});
+        break;
+    }
+    case HAILO_FORMAT_ORDER_NHWC:
+    case HAILO_FORMAT_ORDER_RGB4:
+    case HAILO_FORMAT_ORDER_FCR:
+    case HAILO_FORMAT_ORDER_F8CR:
+    case HAILO_FORMAT_ORDER_BAYER_RGB:
+    case HAILO_FORMAT_ORDER_12_BIT_BAYER_RGB:
+    case HAILO_FORMAT_ORDER_YUY2:
+    {
+        // A YUY2 macropixel holds 2 pixels, which share their U and V
+        CHECK_AS_EXPECTED((HAILO_FORMAT_ORDER_YUY2 != format.order) || (0 == (src_layout.roi_x % 2)), HAILO_INVALID_ARGUMENT,
+            "The region of interest of YUY2 frames must start at an even column (got x={})", src_layout.roi_x);
+        const size_t roi_x_offset = src_layout.roi_x * shape.features * data_bytes;
+        planes.push_back({src.data() + src_layout.plane_offsets[0] + (src_layout.roi_y * src_layout.row_pitches[0]) + roi_x_offset,
+            src_layout.row_pitches[0], shape.height, HailoRTCommon::get_frame_size(shape, format) / shape.height});
+        break;
+    }
+    default:
+        LOGGER__ERROR("Frame layouts are not supported for order {}", HailoRTCommon::get_format_order_str(format.order));
+        return make_unexpected(HAILO_NOT_SUPPORTED);
+    }
+
+    for (const auto &plane : planes) {
+        CHECK_AS_EXPECTED((plane.row_pitch >= plane.packed_row_size) || (1 >= plane.rows_count), HAILO_INVALID_ARGUMENT,
+            "Row pitch ({}) is smaller than the row size ({})", plane.row_pitch, plane.packed_row_size);
+        const size_t plane_end = static_cast<size_t>(plane.first_row - src.data()) +
+            ((plane.rows_count - 1) * plane.row_pitch) + plane.packed_row_size;
+        CHECK_AS_EXPECTED(plane_end <= src.size(), HAILO_INVALID_ARGUMENT,
+            "Frame layout exceeds the src buffer (buffer size {}, layout requires {})", src.size(), plane_end);
+    }
+
+    return planes;
+}
+
+bool TransformContextUtils::is_row_separable_reorder(const hailo_format_t &src_format, const hailo_format_t &dst_format)
+{
+    switch (src_format.order) {
+    case HAILO_FORMAT_ORDER_NHWC:
+        return ((HAILO_FORMAT_ORDER_NHWC == dst_format.order) || (HAILO_FORMAT_ORDER_NHCW == dst_format.order) ||
+            (HAILO_FORMAT_ORDER_FCR == dst_format.order) || (HAILO_FORMAT_ORDER_F8CR == dst_format.order) ||
+            (HAILO_FORMAT_ORDER_RGB888 == dst_format.order));
+    case HAILO_FORMAT_ORDER_RGB4:
+        return ((HAILO_FORMAT_ORDER_NHWC == dst_format.order) || (HAILO_FORMAT_ORDER_NHCW == dst_format.order));
+    case HAILO_FORMAT_ORDER_FCR:
+    case HAILO_FORMAT_ORDER_F8CR:
+    case HAILO_FORMAT_ORDER_BAYER_RGB:
+    case HAILO_FORMAT_ORDER_12_BIT_BAYER_RGB:
+        return (src_format.order == dst_format.order);
+    default:
+        return false;
+    }
+}
+
+static void pack_frame_planes(const std::vector<FramePlane> &planes, uint8_t *dst_ptr)
+{
+    for (const auto &plane : planes) {
+        for (uint32_t r = 0; r < plane.rows_count; r++) {
+            memcpy(dst_ptr, plane.first_row + (r * plane.row_pitch), plane.packed_row_size);
+            dst_ptr += plane.packed_row_size;
+        }
+    }
+}
+
+hailo_status TransformContextUtils::pack_frame(const MemoryView src, const hailo_frame_layout_t &src_layout,
+    const hailo_3d_image_shape_t &shape, const hailo_format_t &format, MemoryView dst)
+{
+    const auto frame_size = HailoRTCommon::get_frame_size(shape, format);
+    CHECK(dst.size() == frame_size, HAILO_INVALID_ARGUMENT, "dst size must be {}. passed size - {}", frame_size, dst.size());
+
+    auto planes = get_frame_planes(src, src_layout, shape, format);
+    CHECK_EXPECTED_AS_STATUS(planes);
+
+    pack_frame_planes(planes.value(), dst.data());
+    return HAILO_SUCCESS;
+}
+
 hailo_status InputTransformContext::transform_inner(const void *src_ptr, void *quant_buffer, void *dst_ptr, 
     MemoryView transpose_buffer)
 {
     void *orig_dst_ptr = nullptr;
-    hailo_3d_image_shape_t transposed_image_shape = m_src_image_shape;
     hailo_format_t quantized_src_format = m_src_format;
 
     if (!(m_should_quantize || m_should_transpose || m_should_reorder)) {
@@ -1288,10 +1574,21 @@ hailo_status InputTransformContext::transform_inner(const void *src_ptr, void *q
         quantized_src_format.type = m_dst_format.type;
     }
 
+    return transform_quantized(src_ptr, quantized_src_format, dst_ptr, transpose_buffer);
+}
+
+hailo_status InputTransformContext::transform_quantized(const void *src_ptr, const hailo_format_t &quantized_src_format,
+    void *dst_ptr, MemoryView transpose_buffer)
+{
+    void *orig_dst_ptr = nullptr;
+    hailo_3d_image_shape_t transposed_image_shape = m_src_image_shape;
+
     if (!(m_should_transpose || m_should_reorder)) {
-        /* If quantize is the only step - need to copy src buffer to dst buffer */
-        auto frame_size = HailoRTCommon::get_frame_size(m_dst_image_shape, m_dst_format);
-        memcpy(dst_ptr, src_ptr, frame_size);
+        /* If quantize is the only step - need to copy src buffer to dst buffer (unless it was quantized into it) */
+        if (src_ptr != dst_ptr) {
+            auto frame_size = HailoRTCommon::get_frame_size(m_dst_image_shape, m_dst_format);
+            memcpy(dst_ptr, src_ptr, frame_size);
+        }
         return HAILO_SUCCESS;
     }
 
@@ -1342,6 +1639,21 @@ hailo_status FrameOutputTransformContext::transform_inner(const void *src_ptr, v
         return HAILO_SUCCESS;
     }
 
+    if (HAILO_FORMAT_ORDER_HAILO_TOP_K == m_dst_format.order) {
+        /* The top k values are dequantized while written, so the whole tensor is never rescaled */
+        switch (m_src_format.type) {
+        case HAILO_FORMAT_TYPE_UINT8:
+            return transform__d2h_top_k<uint8_t>((uint8_t*)src_ptr, m_src_image_shape, dst_ptr, m_dst_image_shape,
+                m_dst_format, m_should_quantize, m_dst_quant_info);
+        case HAILO_FORMAT_TYPE_UINT16:
+            return transform__d2h_top_k<uint16_t>((uint16_t*)src_ptr, m_src_image_shape, dst_ptr, m_dst_image_shape,
+                m_dst_format, m_should_quantize, m_dst_quant_info);
+        default:
+            LOGGER__ERROR("Invalid src-buffer's type format");
+            return HAILO_INVALID_ARGUMENT;
+        }
+    }
+
     if (m_should_reorder) {
         if (m_should_transpose) {
             /* If user needs to reorder and transform - the output of the reorder is the transform buffer*/
@@ -1391,43 +1703,55 @@ hailo_status FrameOutputTransformContext::transform_inner(const void *src_ptr, v
 }
 
 
-hailo_status transform_demux_raw_frame(const void *src, uint32_t offset,
-    hailo_mux_info_t *mux_info, uint32_t mux_row_count)
+static void add_demux_copy_span(std::vector<DemuxCopySpan> &copy_plan, uint32_t src_offset, uint32_t dst_offset,
+    uint32_t size)
+{
+    // Consecutive rows that are contiguous in both the muxed frame and the edge frame are copied at once
+    if (!copy_plan.empty()) {
+        auto &last_span = copy_plan.back();
+        if (((last_span.src_offset + last_span.size) == src_offset) && ((last_span.dst_offset + last_span.size) == dst_offset)) {
+            last_span.size += size;
+            return;
+        }
+    }
+    copy_plan.push_back(DemuxCopySpan{src_offset, dst_offset, size});
+}
+
+// Walks the rows of a muxed frame (in the order they are written by the HW), recording where each row of each edge is
+// copied to, instead of copying it
+static void build_demux_copy_plans_impl(uint32_t offset, hailo_mux_info_t *mux_info, uint32_t mux_row_count,
+    const std::map<const hailo_mux_info_t*, size_t> &edges_indices, std::vector<std::vector<DemuxCopySpan>> &copy_plans)
 {
     // This is a recursive function with a maximum depth of HailoRTCommon::MUX_INFO_COUNT.
-    hailo_status status = HAILO_UNINITIALIZED;
     struct hailo_mux_info_t *predecessor = NULL;
     uint32_t row_size = 0;
 
-    CHECK_ARG_NOT_NULL(src);
-
     for (uint32_t i = 0; i < mux_row_count; i++) {
         for (uint32_t j = 0; j < mux_info->successors_count; j++) {
             predecessor = mux_info->successors[j];
             row_size = predecessor->row_size;
 
             if ((predecessor->info.is_mux) && (i < predecessor->rows_gcd)) {
-                status = transform_demux_raw_frame(src, offset, predecessor, predecessor->info.hw_shape.height / mux_info->rows_gcd);
-                CHECK_SUCCESS(status);                
+                build_demux_copy_plans_impl(offset, predecessor, predecessor->info.hw_shape.height / mux_info->rows_gcd,
+                    edges_indices, copy_plans);
             }
 
             if (!(predecessor->info.is_mux)) {
                 if (predecessor->row_counter < predecessor->info.shape.height) {
-                    memcpy((uint8_t*)predecessor->buffer + predecessor->current_offset, (uint8_t*)src + offset, row_size);
+                    add_demux_copy_span(copy_plans[edges_indices.at(predecessor)], offset, predecessor->current_offset,
+                        row_size);
                     predecessor->current_offset += row_size;
                 }
-                
+
                 predecessor->row_counter++;
                 if (predecessor->row_counter == (predecessor->info.hw_shape.height + 1)) {
                     predecessor->row_counter = 0;
                 }
             }
-            
+
             offset += row_size;
         }
     }
-
-    return HAILO_SUCCESS;
 }
 
 hailo_status validate_input_transform_params(hailo_3d_image_shape_t src_image_shape, hailo_format_t src_format,
@@ -1646,6 +1970,85 @@ hailo_status InputTransformContext::transform(const MemoryView src, MemoryView d
     return HAILO_SUCCESS;
 }
 
+hailo_status InputTransformContext::transform(const MemoryView src, const hailo_frame_layout_t &src_layout, MemoryView dst)
+{
+    CHECK(dst.size() == m_dst_frame_size, HAILO_INVALID_ARGUMENT,
+        "dst_size must be {}. passed size - {}", m_dst_frame_size, dst.size());
+
+    CHECK(!m_should_transpose, HAILO_NOT_SUPPORTED, "Transposing frames with a layout is not supported");
+
+    auto planes = get_frame_planes(src, src_layout, m_src_image_shape, m_src_format);
+    CHECK_EXPECTED_AS_STATUS(planes);
+
+    if (m_should_quantize) {
+        /* The rows are quantized into the (packed) quant buffer, and the rest of the transformation continues from it */
+        CHECK(1 == planes->size(), HAILO_NOT_SUPPORTED, "Quantizing multi-planar frames with a layout is not supported");
+        const auto &plane = planes->at(0);
+        const auto row_elements = static_cast<uint32_t>(plane.packed_row_size / HailoRTCommon::get_data_bytes(m_src_format.type));
+        const auto quant_row_size = row_elements * HailoRTCommon::get_data_bytes(m_dst_format.type);
+        uint8_t *quant_ptr = m_should_reorder ? quant_buffer().data() : dst.data();
+        for (uint32_t r = 0; r < plane.rows_count; r++) {
+            auto status = quantize_stream(plane.first_row + (r * plane.row_pitch), quant_ptr + (r * quant_row_size), row_elements);
+            CHECK_SUCCESS(status);
+        }
+
+        hailo_format_t quantized_src_format = m_src_format;
+        quantized_src_format.type = m_dst_format.type;
+        return transform_quantized(quant_ptr, quantized_src_format, dst.data(), transpose_buffer());
+    }
+
+    /* Reordering YUY2 to YUY2 is a copy of the frame */
+    const bool is_yuy2_copy = (HAILO_FORMAT_ORDER_YUY2 == m_src_format.order) && (HAILO_FORMAT_ORDER_YUY2 == m_dst_format.order);
+    if (!m_should_reorder || is_yuy2_copy) {
+        pack_frame_planes(planes.value(), dst.data());
+        return HAILO_SUCCESS;
+    }
+
+    if ((HAILO_FORMAT_ORDER_NV12 == m_src_format.order) || (HAILO_FORMAT_ORDER_NV21 == m_src_format.order)) {
+        auto src_image_shape = m_src_image_shape;
+        auto dst_image_shape = m_dst_image_shape;
+        const auto &y_plane = planes->at(0);
+        const auto &uv_plane = planes->at(1);
+        switch (m_src_format.type) {
+            case HAILO_FORMAT_TYPE_UINT8:
+                transform__h2d_NV12_to_NV12<uint8_t>(y_plane.first_row, y_plane.row_pitch, uv_plane.first_row,
+                    uv_plane.row_pitch, &src_image_shape, dst.data(), &dst_image_shape);
+                break;
+            case HAILO_FORMAT_TYPE_UINT16:
+                CHECK((0 == (y_plane.row_pitch % sizeof(uint16_t))) && (0 == (uv_plane.row_pitch % sizeof(uint16_t))),
+                    HAILO_INVALID_ARGUMENT, "Row pitches of uint16 frames must be aligned to 2 bytes");
+                transform__h2d_NV12_to_NV12<uint16_t>(reinterpret_cast<const uint16_t*>(y_plane.first_row),
+                    y_plane.row_pitch / sizeof(uint16_t), reinterpret_cast<const uint16_t*>(uv_plane.first_row),
+                    uv_plane.row_pitch / sizeof(uint16_t), &src_image_shape, reinterpret_cast<uint16_t*>(dst.data()),
+                    &dst_image_shape);
+                break;
+            default:
+                LOGGER__ERROR("Invalid src-buffer's type format {}", m_src_format.type);
+                return HAILO_INVALID_ARGUMENT;
+        }
+        return HAILO_SUCCESS;
+    }
+
+    CHECK(TransformContextUtils::is_row_separable_reorder(m_src_format, m_dst_format) && (m_src_image_shape.height == m_dst_image_shape.height),
+        HAILO_NOT_SUPPORTED, "Frame layouts are not supported for reordering from {} to {}",
+        HailoRTCommon::get_format_order_str(m_src_format.order), HailoRTCommon::get_format_order_str(m_dst_format.order));
+
+    /* Each row is reordered straight from the src frame into the matching dst row */
+    const auto &plane = planes->at(0);
+    auto src_row_shape = m_src_image_shape;
+    src_row_shape.height = 1;
+    auto dst_row_shape = m_dst_image_shape;
+    dst_row_shape.height = 1;
+    const auto dst_row_size = m_dst_frame_size / m_dst_image_shape.height;
+    for (uint32_t r = 0; r < plane.rows_count; r++) {
+        auto status = reorder_input_stream(plane.first_row + (r * plane.row_pitch), src_row_shape, m_src_format,
+            dst.data() + (r * dst_row_size), dst_row_shape, m_dst_format);
+        CHECK_SUCCESS(status);
+    }
+
+    return HAILO_SUCCESS;
+}
+
 size_t InputTransformContext::get_src_frame_size() const
 {
     return m_src_frame_size;
@@ -1715,12 +2118,51 @@ FrameOutputTransformContext::FrameOutputTransformContext(size_t src_frame_size,
             m_transpose_buffer(std::move(transpose_buffer))
 {}
 
+static hailo_status validate_top_k_shapes(const hailo_3d_image_shape_t &src_image_shape,
+    const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format)
+{
+    const auto k = dst_image_shape.features / 2;
+    CHECK(src_image_shape.height == dst_image_shape.height, HAILO_INVALID_ARGUMENT,
+        "Top k Transform is supported only when src height ({}) is equal to dst height ({})",
+        src_image_shape.height, dst_image_shape.height);
+    CHECK(src_image_shape.width >= dst_image_shape.width, HAILO_INVALID_ARGUMENT,
+        "Top k Transform is supported only when src width ({}) is equal/larger than dst width ({})",
+        src_image_shape.width, dst_image_shape.width);
+    CHECK((0 < k) && ((k * 2) == dst_image_shape.features), HAILO_INVALID_ARGUMENT,
+        "Top k Transform is supported only when dst features ({}) is a positive even number (the k indices followed by the k values)",
+        dst_image_shape.features);
+    CHECK((k <= src_image_shape.features) && (k <= TOP_K_TILE_SIZE), HAILO_INVALID_ARGUMENT,
+        "Top k Transform is supported only when k ({}) is at most the src features ({}) and at most {}",
+        k, src_image_shape.features, TOP_K_TILE_SIZE);
+    CHECK(src_image_shape.features <= std::numeric_limits<uint16_t>::max(), HAILO_INVALID_ARGUMENT,
+        "Top k Transform is supported only when src features ({}) is at most {}",
+        src_image_shape.features, std::numeric_limits<uint16_t>::max());
+    // The feature indices are written in the dst type
+    CHECK((HAILO_FORMAT_TYPE_UINT8 != dst_format.type) ||
+        (src_image_shape.features <= (static_cast<uint32_t>(std::numeric_limits<uint8_t>::max()) + 1)),
+        HAILO_INVALID_ARGUMENT, "Top k Transform with dst type UINT8 is supported only when src features ({}) is at most {}",
+        src_image_shape.features, static_cast<uint32_t>(std::numeric_limits<uint8_t>::max()) + 1);
+
+    return HAILO_SUCCESS;
+}
+
 Expected<std::unique_ptr<OutputTransformContext>> FrameOutputTransformContext::create(const hailo_3d_image_shape_t &src_image_shape,
     const hailo_format_t &src_format, const hailo_3d_image_shape_t &dst_image_shape,
     const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info)
 {
     const auto internal_dst_format = HailoRTDefaults::expand_auto_format(dst_format, src_format);
 
+    if (HAILO_FORMAT_ORDER_HAILO_TOP_K == internal_dst_format.order) {
+        CHECK_AS_EXPECTED((HAILO_FORMAT_ORDER_NHCW == src_format.order) ||
+            ((HAILO_FORMAT_ORDER_NC == src_format.order) && (1 == src_image_shape.height) && (1 == src_image_shape.width)),
+            HAILO_INVALID_ARGUMENT, "Format order HAILO_FORMAT_ORDER_HAILO_TOP_K is supported only for src orders NHCW and NC (got {})",
+            HailoRTCommon::get_format_order_str(src_format.order));
+        CHECK_AS_EXPECTED(!TransformContextUtils::should_transpose(src_format.flags, dst_format.flags), HAILO_INVALID_ARGUMENT,
+            "Format order HAILO_FORMAT_ORDER_HAILO_TOP_K doesn't support transposed format");
+        auto status = validate_top_k_shapes(src_image_shape, dst_image_shape, internal_dst_format);
+        CHECK_SUCCESS_AS_EXPECTED(status);
+    }
+
     const auto src_frame_size = HailoRTCommon::get_frame_size(src_image_shape, src_format);
     const auto dst_frame_size = HailoRTCommon::get_frame_size(dst_image_shape, internal_dst_format);
 
@@ -1748,11 +2190,29 @@ Expected<std::unique_ptr<OutputTransformContext>> FrameOutputTransformContext::c
 
 NMSOutputTransformContext::NMSOutputTransformContext(size_t src_frame_size, const hailo_format_t &src_format, 
     size_t dst_frame_size, const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info,
-    const hailo_nms_info_t &nms_info, Buffer &&quant_buffer, const bool should_quantize, const bool should_transpose) :
+    const hailo_nms_info_t &nms_info, std::vector<ReusableThreadPtr<hailo_status>> &&workers, const bool should_quantize,
+    const bool should_transpose) :
         OutputTransformContext(src_frame_size, src_format, dst_frame_size, dst_format, dst_quant_info, should_quantize ,should_transpose, 
-        true), m_nms_info(nms_info), m_chunk_offsets(nms_info.chunks_per_frame, 0), m_quant_buffer(std::move(quant_buffer))
+        true), m_nms_info(nms_info), m_class_src_offsets(nms_info.chunks_per_frame * nms_info.number_of_classes, 0),
+        m_class_dst_offsets(nms_info.number_of_classes + 1, 0), m_workers(std::move(workers))
 {}
 
+static size_t get_nms_transform_threads_count()
+{
+    auto threads_count_env = std::getenv(HAILO_NMS_TRANSFORM_THREADS_ENV_VAR);
+    if (nullptr == threads_count_env) {
+        return 1;
+    }
+
+    char *end = nullptr;
+    const auto threads_count = std::strtoull(threads_count_env, &end, 10);
+    if ((end == threads_count_env) || ('\0' != *end) || (0 == threads_count)) {
+        LOGGER__WARNING("Invalid value for {} ('{}'), ignoring it", HAILO_NMS_TRANSFORM_THREADS_ENV_VAR, threads_count_env);
+        return 1;
+    }
+    return static_cast<size_t>(threads_count);
+}
+
 Expected<std::unique_ptr<OutputTransformContext>> NMSOutputTransformContext::create(const hailo_format_t &src_format,
     const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info, const hailo_nms_info_t &nms_info)
 {
@@ -1778,20 +2238,22 @@ Expected<std::unique_ptr<OutputTransformContext>> NMSOutputTransformContext::cre
     const auto src_frame_size = HailoRTCommon::get_nms_hw_frame_size(nms_info);
     auto dst_frame_size = HailoRTCommon::get_nms_host_frame_size(nms_info, internal_dst_format);
 
-    Buffer quant_buffer;
     const bool should_quantize = (src_format.flags & HAILO_FORMAT_FLAGS_QUANTIZED) &&
         !(internal_dst_format.flags & HAILO_FORMAT_FLAGS_QUANTIZED);
-    if (should_quantize) {
-        dst_frame_size = HailoRTCommon::get_nms_host_frame_size(nms_info, internal_dst_format);
-        auto expected_nms_quant_buffer = Buffer::create(dst_frame_size, 0);
-        CHECK_EXPECTED(expected_nms_quant_buffer);
-        quant_buffer = expected_nms_quant_buffer.release();
-    }
 
     auto should_transpose = TransformContextUtils::should_transpose(src_format.flags, dst_format.flags);
 
+    // A thread per class at most (the classes are split between the threads)
+    const auto threads_count = std::min(get_nms_transform_threads_count(), static_cast<size_t>(nms_info.number_of_classes));
+    std::vector<ReusableThreadPtr<hailo_status>> workers;
+    for (size_t i = 1; i < threads_count; i++) {
+        auto worker = make_unique_nothrow<ReusableThread<hailo_status>>();
+        CHECK_NOT_NULL_AS_EXPECTED(worker, HAILO_OUT_OF_HOST_MEMORY);
+        workers.emplace_back(std::move(worker));
+    }
+
     std::unique_ptr<OutputTransformContext> nms_transform_context = std::make_unique<NMSOutputTransformContext>(src_frame_size,
-        src_format, dst_frame_size, internal_dst_format, dst_quant_info, nms_info, std::move(quant_buffer),
+        src_format, dst_frame_size, internal_dst_format, dst_quant_info, nms_info, std::move(workers),
         should_quantize, should_transpose);
     CHECK_AS_EXPECTED(nullptr != nms_transform_context, HAILO_OUT_OF_HOST_MEMORY);
 
@@ -1822,8 +2284,6 @@ hailo_status NMSOutputTransformContext::transform(const MemoryView src, MemoryVi
 
     assert((HAILO_FORMAT_ORDER_HAILO_NMS == m_src_format.order) && (HAILO_FORMAT_ORDER_HAILO_NMS == m_dst_format.order));
 
-    auto shape_size = HailoRTCommon::get_nms_host_shape_size(m_nms_info);
-
     if (!(HAILO_FORMAT_FLAGS_QUANTIZED & m_src_format.flags) && (HAILO_FORMAT_FLAGS_QUANTIZED & m_dst_format.flags)) {
         LOGGER__ERROR("Cannot quantize output data");
         return HAILO_INVALID_OPERATION;
@@ -1834,34 +2294,36 @@ hailo_status NMSOutputTransformContext::transform(const MemoryView src, MemoryVi
         return HAILO_INVALID_OPERATION;
     }
 
+    auto status = transform__d2h_NMS_build_class_index(src.data(), src.size(), m_nms_info, m_class_src_offsets,
+        m_class_dst_offsets);
+    CHECK_SUCCESS(status);
+
+    const uint8_t *src_ptr = src.data();
+    uint8_t *dst_ptr = dst.data();
+    std::function<void(uint32_t, uint32_t)> transform_classes;
     if (!((HAILO_FORMAT_FLAGS_QUANTIZED & m_src_format.flags) &&
         !(HAILO_FORMAT_FLAGS_QUANTIZED & m_dst_format.flags))) {
-            transform__d2h_NMS((uint8_t*)src.data(), (uint8_t*)dst.data(), m_nms_info, m_chunk_offsets);
-    } 
-    else {
-        transform__d2h_NMS((uint8_t*)src.data(), m_quant_buffer.data(), m_nms_info, m_chunk_offsets);
+        transform_classes = [this, src_ptr, dst_ptr](uint32_t first_class, uint32_t end_class) {
+            transform__d2h_NMS<uint16_t, false>(src_ptr, reinterpret_cast<uint16_t*>(dst_ptr), m_nms_info,
+                m_class_src_offsets, m_class_dst_offsets, m_dst_quant_info, first_class, end_class);
+        };
     }
-
-    if ((HAILO_FORMAT_FLAGS_QUANTIZED & m_src_format.flags) && !(HAILO_FORMAT_FLAGS_QUANTIZED & m_dst_format.flags)) {
+    else {
         // NMS has to be uint16 or float32
+        CHECK(HAILO_FORMAT_TYPE_UINT16 == m_src_format.type, HAILO_INVALID_OPERATION,
+            "NMS dequantization is supported only from HAILO_FORMAT_TYPE_UINT16");
         switch (m_dst_format.type) {
             case HAILO_FORMAT_TYPE_UINT16:
-                if (m_src_format.type == HAILO_FORMAT_TYPE_UINT16) {
-                    Quantization::dequantize_output_buffer_nms<uint16_t, uint16_t>((uint16_t*)m_quant_buffer.data(),
-                        (uint16_t*)dst.data(), shape_size, m_dst_quant_info, m_nms_info.number_of_classes);
-                } 
-                else {
-                    return HAILO_INVALID_OPERATION;
-                }
+                transform_classes = [this, src_ptr, dst_ptr](uint32_t first_class, uint32_t end_class) {
+                    transform__d2h_NMS<uint16_t, true>(src_ptr, reinterpret_cast<uint16_t*>(dst_ptr), m_nms_info,
+                        m_class_src_offsets, m_class_dst_offsets, m_dst_quant_info, first_class, end_class);
+                };
                 break;
             case HAILO_FORMAT_TYPE_FLOAT32:
-                if (m_src_format.type == HAILO_FORMAT_TYPE_UINT16) {
-                    Quantization::dequantize_output_buffer_nms<float32_t, uint16_t>((uint16_t*)m_quant_buffer.data(),
-                        (float32_t*)dst.data(), shape_size, m_dst_quant_info, m_nms_info.number_of_classes);
-                }
-                else {
-                    return HAILO_INVALID_OPERATION;
-                }
+                transform_classes = [this, src_ptr, dst_ptr](uint32_t first_class, uint32_t end_class) {
+                    transform__d2h_NMS<float32_t, true>(src_ptr, reinterpret_cast<float32_t*>(dst_ptr), m_nms_info,
+                        m_class_src_offsets, m_class_dst_offsets, m_dst_quant_info, first_class, end_class);
+                };
                 break;
             default:
                 LOGGER__ERROR("Invalid dst-buffer's type format");
@@ -1869,9 +2331,48 @@ hailo_status NMSOutputTransformContext::transform(const MemoryView src, MemoryVi
         }
     }
 
+    run_on_classes(transform_classes);
+
     return HAILO_SUCCESS;
 }
 
+void NMSOutputTransformContext::run_on_classes(const std::function<void(uint32_t first_class, uint32_t end_class)> &transform_classes)
+{
+    const uint32_t num_of_classes = m_nms_info.number_of_classes;
+    const size_t frame_elements_count = m_class_dst_offsets[num_of_classes];
+    const size_t frame_bboxes_count = (frame_elements_count - num_of_classes) / HailoRTCommon::BBOX_PARAMS;
+    // Waking up the workers costs more than merging a few bboxes, so sparse frames are merged on the calling thread
+    const size_t threads_count = std::min(m_workers.size() + 1,
+        std::max(frame_bboxes_count / NMS_MIN_BBOXES_PER_THREAD, static_cast<size_t>(1)));
+    if (1 == threads_count) {
+        transform_classes(0, num_of_classes);
+        return;
+    }
+
+    // Each thread merges a range of classes with about the same number of bboxes
+    uint32_t first_class = 0;
+    for (size_t thread_index = 0; thread_index < threads_count; thread_index++) {
+        uint32_t end_class = num_of_classes;
+        if ((thread_index + 1) < threads_count) {
+            const auto end_offset = (frame_elements_count * (thread_index + 1)) / threads_count;
+            const auto end_class_it = std::lower_bound(m_class_dst_offsets.begin(),
+                m_class_dst_offsets.begin() + num_of_classes, end_offset);
+            end_class = std::max(first_class, static_cast<uint32_t>(end_class_it - m_class_dst_offsets.begin()));
+            m_workers[thread_index]->run([&transform_classes, first_class, end_class]() {
+                transform_classes(first_class, end_class);
+                return HAILO_SUCCESS;
+            });
+        } else {
+            transform_classes(first_class, end_class);
+        }
+        first_class = end_class;
+    }
+
+    for (size_t thread_index = 0; (thread_index + 1) < threads_count; thread_index++) {
+        m_workers[thread_index]->get();
+    }
+}
+
 std::string FrameOutputTransformContext::description() const
 {
     std::stringstream transform_description;
@@ -1952,7 +2453,45 @@ Expected<OutputDemuxerBase> OutputDemuxerBase::create(size_t src_frame_size, con
     auto mux_infos = get_mux_infos_from_layer_info(layer_info);
     CHECK_EXPECTED(mux_infos);
 
-    return OutputDemuxerBase(src_frame_size, mux_infos.release());
+    auto edges_copy_plans = build_edges_copy_plans(mux_infos.value());
+    CHECK_EXPECTED(edges_copy_plans);
+
+    return OutputDemuxerBase(src_frame_size, mux_infos.release(), edges_copy_plans.release());
+}
+
+Expected<std::vector<std::vector<DemuxCopySpan>>> OutputDemuxerBase::build_edges_copy_plans(
+    std::vector<hailo_mux_info_t> &mux_infos)
+{
+    std::map<const hailo_mux_info_t*, size_t> edges_indices;
+    size_t total_mux_sizes = 0;
+    for (auto &mux_edge : mux_infos) {
+        if (!mux_edge.info.is_mux) {
+            mux_edge.current_offset = 0;
+            mux_edge.row_counter = 0;
+            const auto edge_index = edges_indices.size();
+            edges_indices[&mux_edge] = edge_index;
+            total_mux_sizes += mux_edge.info.hw_frame_size;
+        }
+    }
+    // The rows layout is the same for all frames, so it is computed once (and not for every demuxed frame)
+    std::vector<std::vector<DemuxCopySpan>> copy_plans(edges_indices.size());
+    auto &first_mux_info = mux_infos[0];
+    build_demux_copy_plans_impl(0, &first_mux_info, first_mux_info.rows_gcd, edges_indices, copy_plans);
+
+    for (auto &mux_edge : mux_infos) {
+        if (!mux_edge.info.is_mux) {
+            const auto &copy_plan = copy_plans[edges_indices.at(&mux_edge)];
+            for (const auto &span : copy_plan) {
+                CHECK_AS_EXPECTED(((span.src_offset + span.size) <= total_mux_sizes) &&
+                    ((span.dst_offset + span.size) <= mux_edge.info.hw_frame_size), HAILO_INTERNAL_FAILURE,
+                    "Demux of edge {} exceeds the frame boundaries", mux_edge.info.name);
+            }
+            mux_edge.current_offset = 0;
+            mux_edge.row_counter = 0;
+        }
+    }
+
+    return copy_plans;
 }
 
 hailo_status OutputDemuxerBase::get_mux_info_from_layer_info_impl(hailo_mux_info_t &mux_info, const LayerInfo &layer_info,
@@ -2062,61 +2601,97 @@ Expected<std::vector<hailo_mux_info_t>> OutputDemuxerBase::get_mux_infos_from_la
     return res;
 }
 
-OutputDemuxerBase::OutputDemuxerBase(size_t src_frame_size, std::vector<hailo_mux_info_t> &&mux_infos) :
+OutputDemuxerBase::OutputDemuxerBase(size_t src_frame_size, std::vector<hailo_mux_info_t> &&mux_infos,
+    std::vector<std::vector<DemuxCopySpan>> &&edges_copy_plans) :
         OutputDemuxer(src_frame_size),
-        m_mux_infos(std::move(mux_infos)) {}
+        m_mux_infos(std::move(mux_infos)),
+        m_edges_copy_plans(std::move(edges_copy_plans)),
+        m_mux_frame_size(0)
+{
+    for (const auto &mux_edge : m_mux_infos) {
+        if (!mux_edge.info.is_mux) {
+            m_mux_frame_size += mux_edge.info.hw_frame_size;
+        }
+    }
+}
+
+void OutputDemuxerBase::demux_edge(const MemoryView src, size_t edge_index, MemoryView dst) const
+{
+    for (const auto &span : m_edges_copy_plans[edge_index]) {
+        memcpy(dst.data() + span.dst_offset, src.data() + span.src_offset, span.size);
+    }
+}
+
+hailo_status OutputDemuxerBase::transform_demux_edge(const MemoryView src, size_t edge_index, MemoryView dst) const
+{
+    CHECK(edge_index < m_edges_copy_plans.size(), HAILO_INVALID_ARGUMENT, "Invalid edge index {} (edges count is {})",
+        edge_index, m_edges_copy_plans.size());
+    CHECK(m_mux_frame_size == src.size(), HAILO_INVALID_ARGUMENT, "src_size must be: {}, passed_size: {}",
+        m_mux_frame_size, src.size());
+
+    size_t current_edge_index = 0;
+    for (const auto &mux_edge : m_mux_infos) {
+        if (!mux_edge.info.is_mux) {
+            if (current_edge_index == edge_index) {
+                CHECK((mux_edge.info.hw_frame_size == dst.size()), HAILO_INVALID_ARGUMENT,
+                    "Expected buffer size of {}, got {}", mux_edge.info.hw_frame_size, dst.size());
+                break;
+            }
+            current_edge_index++;
+        }
+    }
+
+    demux_edge(src, edge_index, dst);
+    return HAILO_SUCCESS;
+}
 
 hailo_status OutputDemuxerBase::transform_demux(const MemoryView src, std::vector<MemoryView> &raw_buffers)
 {
     size_t raw_buffer_index = 0;
-    size_t total_mux_sizes = 0;
 
-    CHECK(raw_buffers.size() == get_edges_stream_info().size(), HAILO_INVALID_ARGUMENT,
-        "There is a missmatch between mux edges counts ({}) and raw_buffers_size ({})", get_edges_stream_info().size(),
+    CHECK(raw_buffers.size() == m_edges_copy_plans.size(), HAILO_INVALID_ARGUMENT,
+        "There is a missmatch between mux edges counts ({}) and raw_buffers_size ({})", m_edges_copy_plans.size(),
         raw_buffers.size());
+    CHECK(m_mux_frame_size == src.size(), HAILO_INVALID_ARGUMENT, "src_size must be: {}, passed_size: {}",
+        m_mux_frame_size, src.size());
 
-    // Reset the runtime offset
-    for (auto &mux_edge : m_mux_infos) {
+    for (const auto &mux_edge : m_mux_infos) {
         if (!mux_edge.info.is_mux) {
-            mux_edge.buffer = (void*)((uintptr_t)raw_buffers[raw_buffer_index].data());
-            mux_edge.current_offset = 0;
-            mux_edge.row_counter = 0;
             CHECK((mux_edge.info.hw_frame_size == raw_buffers[raw_buffer_index].size()), HAILO_INVALID_ARGUMENT,
                 "Expected buffer size of {}, got {}", mux_edge.info.hw_frame_size, raw_buffers[raw_buffer_index].size());
-            total_mux_sizes += mux_edge.info.hw_frame_size;
             raw_buffer_index++;
         }
     }
-    CHECK(total_mux_sizes == src.size(), HAILO_INVALID_ARGUMENT,
-        "src_size must be: {}, passed_size: {}", total_mux_sizes, src.size());
 
-    // TODO: Optimization - Read directly to user raw buffers (in case of NO_TRANSFORM, INPLACE_TRANSFORM)
+    for (size_t edge_index = 0; edge_index < raw_buffers.size(); edge_index++) {
+        demux_edge(src, edge_index, raw_buffers[edge_index]);
+    }
 
-    auto first_mux_info = m_mux_infos[0];
-    return transform_demux_raw_frame(src.data(), 0, &first_mux_info, first_mux_info.rows_gcd);
+    return HAILO_SUCCESS;
 }
 
 hailo_status OutputDemuxerBase::transform_demux(const MemoryView src, const std::map<std::string, MemoryView> &dst_ptrs)
 {
-    size_t total_mux_sizes = 0;
-    // Reset the runtime offset
-    for (auto &mux_edge : m_mux_infos) {
+    CHECK(m_mux_frame_size == src.size(), HAILO_INVALID_ARGUMENT, "src_size must be: {}, passed_size: {}",
+        m_mux_frame_size, src.size());
+
+    std::vector<MemoryView> raw_buffers;
+    raw_buffers.reserve(m_edges_copy_plans.size());
+    for (const auto &mux_edge : m_mux_infos) {
         if (!mux_edge.info.is_mux) {
             auto name = std::string(mux_edge.info.name);
             CHECK(contains(dst_ptrs, name), HAILO_INVALID_ARGUMENT, "edge name {} is not in dst_ptrs", name);
-            mux_edge.buffer = const_cast<void*>(reinterpret_cast<const void*>((dst_ptrs.at(name)).data()));
-            mux_edge.current_offset = 0;
-            mux_edge.row_counter = 0;
             CHECK((mux_edge.info.hw_frame_size == (dst_ptrs.at(name)).size()), HAILO_INVALID_ARGUMENT,
                 "Expected buffer size of {}, got {}", mux_edge.info.hw_frame_size, (dst_ptrs.at(name)).size());
-            total_mux_sizes += mux_edge.info.hw_frame_size;
+            raw_buffers.push_back(dst_ptrs.at(name));
         }
     }
-    CHECK(total_mux_sizes == src.size(), HAILO_INVALID_ARGUMENT, "src_size must be: {}, passed_size: {}",
-        total_mux_sizes, src.size());
 
-    auto first_mux_info = m_mux_infos[0];
-    return transform_demux_raw_frame(src.data(), 0, &first_mux_info, first_mux_info.rows_gcd);
+    for (size_t edge_index = 0; edge_index < raw_buffers.size(); edge_index++) {
+        demux_edge(src, edge_index, raw_buffers[edge_index]);
+    }
+
+    return HAILO_SUCCESS;
 }
 
 } /* namespace hailort */
@@ -18,7 +18,9 @@
 #include "hailo/transform.hpp"
 #include "stream_internal.hpp"
 #include "layer_info.hpp"
+#include "common/async_thread.hpp"
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -42,6 +44,18 @@ public:
     static std::string make_reorder_description(hailo_format_order_t src_order, hailo_3d_image_shape_t src_shape,
                                                 hailo_format_order_t dst_order, hailo_3d_image_shape_t dst_shape);
     static std::string make_transpose_description(hailo_3d_image_shape_t original_shape, hailo_3d_image_shape_t transposed_shape);
+    // Packs a frame with the given layout into dst (whose size is the frame size of shape and format)
+    static hailo_status pack_frame(const MemoryView src, const hailo_frame_layout_t &src_layout,
+        const hailo_3d_image_shape_t &shape, const hailo_format_t &format, MemoryView dst);
+    // Whether each row of the dst frame is made only of the matching row of the src frame, so the reorder can be done row by row
+    static bool is_row_separable_reorder(const hailo_format_t &src_format, const hailo_format_t &dst_format);
+};
+
+// A copy of consecutive bytes of an edge, from the muxed frame (src_offset) to the edge's frame (dst_offset)
+struct DemuxCopySpan {
+    uint32_t src_offset;
+    uint32_t dst_offset;
+    uint32_t size;
 };
 
 class OutputDemuxerBase : public OutputDemuxer {
@@ -62,14 +76,27 @@ public:
     virtual hailo_status transform_demux(const MemoryView src, const std::map<std::string, MemoryView> &dst_ptrs) override;
     virtual hailo_status transform_demux(const MemoryView src, std::vector<MemoryView> &raw_buffers) override;
 
+    /**
+     * Demultiplexing a single edge (by its index in get_edges_stream_info()) of the frame referred by @a src into @a dst.
+     * The demuxer isn't changed, so the edges of the same frame may be demuxed concurrently (e.g. each by its own vstream).
+     */
+    hailo_status transform_demux_edge(const MemoryView src, size_t edge_index, MemoryView dst) const;
+
 private:
-    OutputDemuxerBase(size_t src_frame_size, std::vector<hailo_mux_info_t> &&mux_infos);
+    OutputDemuxerBase(size_t src_frame_size, std::vector<hailo_mux_info_t> &&mux_infos,
+        std::vector<std::vector<DemuxCopySpan>> &&edges_copy_plans);
+
+    void demux_edge(const MemoryView src, size_t edge_index, MemoryView dst) const;
 
     static Expected<std::vector<hailo_mux_info_t>> get_mux_infos_from_layer_info(const LayerInfo &layer_info);
     static hailo_status get_mux_info_from_layer_info_impl(hailo_mux_info_t &mux_info, const LayerInfo &layer_info,
     uint32_t &offset, uint32_t height_ratio, std::vector<hailo_mux_info_t> &res, size_t &number_of_mux_infos);
+    static Expected<std::vector<std::vector<DemuxCopySpan>>> build_edges_copy_plans(std::vector<hailo_mux_info_t> &mux_infos);
 
     std::vector<hailo_mux_info_t> m_mux_infos;
+    // The copies of each edge (ordered as get_edges_stream_info()), computed once when the demuxer is created
+    std::vector<std::vector<DemuxCopySpan>> m_edges_copy_plans;
+    size_t m_mux_frame_size;
 };
 
 class HAILORTAPI FrameOutputTransformContext final : public OutputTransformContext
@@ -106,18 +133,23 @@ public:
 
     NMSOutputTransformContext(size_t src_frame_size, const hailo_format_t &src_format, size_t dst_frame_size,
         const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info, const hailo_nms_info_t &nms_info, 
-        Buffer &&quant_buffer, const bool should_quantize, const bool should_transpose);
+        std::vector<ReusableThreadPtr<hailo_status>> &&workers, const bool should_quantize, const bool should_transpose);
 
     virtual hailo_status transform(const MemoryView src, MemoryView dst) override;
     virtual std::string description() const override;
 
 private:
+    // Runs transform_classes on ranges of classes - on the workers too, if the frame has enough bboxes to split
+    void run_on_classes(const std::function<void(uint32_t first_class, uint32_t end_class)> &transform_classes);
 
     const hailo_nms_info_t m_nms_info;
 
-    // For each chunk contains offset of current nms class. Used here in order to avoid run-time allocations
-    std::vector<size_t> m_chunk_offsets;
-    Buffer m_quant_buffer;
+    // The location of each class in the src and dst frames (see transform__d2h_NMS_build_class_index). Used here in
+    // order to avoid run-time allocations
+    std::vector<size_t> m_class_src_offsets;
+    std::vector<size_t> m_class_dst_offsets;
+    // Extra threads for many-class frames (empty by default, see HAILO_NMS_TRANSFORM_THREADS)
+    std::vector<ReusableThreadPtr<hailo_status>> m_workers;
 };
 
 } /* namespace hailort */
@@ -10,6 +10,8 @@
 #include <stdint.h>
 #include <errno.h>
 #include <string.h>
+#include <algorithm>
+#include <array>
 
 #include <hailo/hailort.h>
 #include "common/utils.hpp"
@@ -23,9 +25,11 @@ namespace hailort
 
 #define MILLISECONDS_IN_SECOND (1000)
 #define MICROSECONDS_IN_MILLISECOND (1000)
+#define NANOSECONDS_IN_SECOND (1000000000ULL)
 
 //initialize with padding
 uint8_t g_padded_buffer[MAX_UDP_PAYLOAD_SIZE] = {0,};
+static const uint8_t PADDING_BYTES[PADDING_BYTES_SIZE] = {0,};
 
 hailo_status Udp::bind(struct in_addr host_ip, uint16_t host_port)
 {
@@ -55,7 +59,7 @@ Expected<Udp> Udp::create(struct in_addr device_ip, uint16_t device_port, struct
 }
 
 Udp::Udp(struct in_addr device_ip, uint16_t device_port, struct in_addr host_ip, uint16_t host_port,
-    Socket &&socket, hailo_status &status) : m_socket(std::move(socket))
+    Socket &&socket, hailo_status &status) : m_is_segmented_send_supported(true), m_socket(std::move(socket))
 {
     m_device_address.sin_family = AF_INET;
     m_device_address.sin_port = htons(device_port);
@@ -169,6 +173,165 @@ hailo_status Udp::recv(uint8_t *buffer, size_t *size)
     return HAILO_SUCCESS;
 }
 
+hailo_status Udp::send_multiple(uint8_t *buffer, size_t size, size_t packet_size, bool use_padding)
+{
+    return send_multiple_impl(buffer, size, packet_size, use_padding, 0, 0);
+}
+
+hailo_status Udp::enable_tx_time()
+{
+    return m_socket.enable_tx_time();
+}
+
+hailo_status Udp::send_multiple_at(uint8_t *buffer, size_t size, size_t packet_size, bool use_padding,
+    std::chrono::steady_clock::time_point send_time, uint32_t rate_bytes_per_sec)
+{
+    CHECK(0 < rate_bytes_per_sec, HAILO_INVALID_ARGUMENT, "Invalid rate {}", rate_bytes_per_sec);
+
+    // The tx times are in CLOCK_MONOTONIC, which is the clock of steady_clock where SO_TXTIME is supported (linux)
+    const auto send_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(send_time.time_since_epoch()).count();
+    CHECK(0 < send_time_ns, HAILO_INVALID_ARGUMENT, "Invalid send time");
+    return send_multiple_impl(buffer, size, packet_size, use_padding, static_cast<uint64_t>(send_time_ns),
+        rate_bytes_per_sec);
+}
+
+hailo_status Udp::send_multiple_impl(uint8_t *buffer, size_t size, size_t packet_size, bool use_padding,
+    uint64_t send_time_ns, uint32_t rate_bytes_per_sec)
+{
+    hailo_status status = HAILO_UNINITIALIZED;
+    const size_t max_packet_size = use_padding ? MAX_UDP_PADDED_PAYLOAD_SIZE : MAX_UDP_PAYLOAD_SIZE;
+
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(buffer);
+    CHECK((0 < packet_size) && (packet_size <= max_packet_size), HAILO_INVALID_ARGUMENT,
+        "Invalid packet size {} (max {})", packet_size, max_packet_size);
+
+    size_t offset = 0;
+    while (offset < size) {
+        // Segmented sends can't be paced (a single tx time applies to all of the segments)
+        if (!use_padding && m_is_segmented_send_supported && (0 == send_time_ns)) {
+            const size_t max_segmented_send_size =
+                std::min(MAX_SEGMENTED_SEND_SIZE / packet_size, static_cast<size_t>(MAX_SEGMENTS_PER_CALL)) * packet_size;
+            const auto transfer_size = std::min(size - offset, max_segmented_send_size);
+            size_t number_of_sent_bytes = 0;
+            status = m_socket.send_to_segmented(buffer + offset, transfer_size, packet_size, MSG_CONFIRM,
+                (const struct sockaddr *) &m_device_address, m_device_address_length, &number_of_sent_bytes);
+            if (HAILO_NOT_SUPPORTED == status) {
+                LOGGER__INFO("Udp segmentation offload isn't supported, sending the packets in batches");
+                m_is_segmented_send_supported = false;
+                continue;
+            }
+            if (HAILO_STREAM_ABORTED_BY_USER == status) {
+                LOGGER__INFO("Socket send_to_segmented was aborted!");
+                return status;
+            }
+            CHECK_SUCCESS(status);
+            CHECK(transfer_size == number_of_sent_bytes, HAILO_ETH_SEND_FAILURE,
+                "Did not send all data at Udp::send_multiple. Expected to send: {}, actually sent: {}", transfer_size,
+                number_of_sent_bytes);
+            offset += transfer_size;
+            continue;
+        }
+
+        std::array<socket_datagram_t, MAX_DATAGRAMS_PER_CALL> datagrams{};
+        size_t datagrams_count = 0;
+        for (size_t packet_offset = offset; (datagrams_count < datagrams.size()) && (packet_offset < size);
+             datagrams_count++) {
+            const auto current_packet_size = std::min(packet_size, size - packet_offset);
+            const auto tx_time_ns = (0 == send_time_ns) ? 0 :
+                (send_time_ns + (packet_offset * NANOSECONDS_IN_SECOND / rate_bytes_per_sec));
+            datagrams[datagrams_count] = {buffer + packet_offset, current_packet_size, tx_time_ns};
+            packet_offset += current_packet_size;
+        }
+
+        size_t datagrams_sent = 0;
+        status = m_socket.send_to_multiple(datagrams.data(), datagrams_count, use_padding ? PADDING_BYTES : nullptr,
+            use_padding ? PADDING_BYTES_SIZE : 0, MSG_CONFIRM, (const struct sockaddr *) &m_device_address,
+            m_device_address_length, &datagrams_sent);
+        if (HAILO_STREAM_ABORTED_BY_USER == status) {
+            LOGGER__INFO("Socket send_to_multiple was aborted!");
+            return status;
+        }
+        CHECK_SUCCESS(status);
+
+        for (size_t i = 0; i < datagrams_sent; i++) {
+            offset += datagrams[i].size;
+        }
+    }
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status Udp::recv_multiple(uint8_t *buffer, size_t *size, size_t packet_size)
+{
+    hailo_status status = HAILO_UNINITIALIZED;
+
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(buffer);
+    CHECK_ARG_NOT_NULL(size);
+    CHECK(0 < *size, HAILO_INVALID_ARGUMENT, "Can't receive into an empty buffer");
+    CHECK((0 < packet_size) && (packet_size <= MAX_UDP_PAYLOAD_SIZE), HAILO_INVALID_ARGUMENT,
+        "Invalid packet size {} (max {})", packet_size, MAX_UDP_PAYLOAD_SIZE);
+
+    /* Each packet gets a full packet_size slot (only the first one may be smaller, as in Udp::recv), so a packet can't
+       be truncated even if packets before it were smaller than packet_size */
+    std::array<socket_datagram_t, MAX_DATAGRAMS_PER_CALL> datagrams{};
+    size_t datagrams_count = 0;
+    size_t slot_offset = 0;
+    do {
+        const auto slot_size = std::min(packet_size, *size - slot_offset);
+        datagrams[datagrams_count++] = {buffer + slot_offset, slot_size, 0};
+        slot_offset += slot_size;
+    } while ((datagrams_count < datagrams.size()) && ((slot_offset + packet_size) <= *size));
+
+    size_t datagrams_received = 0;
+    status = m_socket.recv_from_multiple(datagrams.data(), datagrams_count, 0, (struct sockaddr *) &m_device_address,
+        m_device_address_length, &datagrams_received);
+    if (HAILO_STREAM_ABORTED_BY_USER == status) {
+        LOGGER__INFO("Socket recv_from_multiple was aborted!");
+        return status;
+    }
+    CHECK_SUCCESS(status);
+
+    /* Packets smaller than their slot (e.g. the last packet of a frame) leave gaps, so the following ones are moved back */
+    uint8_t *received_end = buffer;
+    for (size_t i = 0; i < datagrams_received; i++) {
+        if (datagrams[i].buffer != received_end) {
+            memmove(received_end, datagrams[i].buffer, datagrams[i].size);
+        }
+        received_end += datagrams[i].size;
+    }
+
+    *size = static_cast<size_t>(received_end - buffer);
+    return HAILO_SUCCESS;
+}
+
+hailo_status Udp::recv_control_response(uint8_t *buffer, size_t *size)
+{
+    size_t number_of_received_bytes = 0;
+    UDP__sockaddr_in_t src_address = {};
+    const bool LOG_TIMEOUTS_IN_DEBUG = true;
+
+    /* Validate arguments */
+    CHECK_ARG_NOT_NULL(buffer);
+    CHECK_ARG_NOT_NULL(size);
+
+    if (*size > MAX_UDP_PAYLOAD_SIZE) {
+        *size = MAX_UDP_PAYLOAD_SIZE;
+    }
+
+    /* The source address isn't saved to m_device_address, since requests may be sent to it at the same time */
+    auto status = m_socket.recv_from(buffer, *size, 0, (struct sockaddr *) &src_address, sizeof(src_address),
+        &number_of_received_bytes, LOG_TIMEOUTS_IN_DEBUG);
+    if ((HAILO_STREAM_ABORTED_BY_USER == status) || (HAILO_TIMEOUT == status)) {
+        return status;
+    }
+    CHECK_SUCCESS(status);
+
+    *size = number_of_received_bytes;
+    return HAILO_SUCCESS;
+}
+
 hailo_status Udp::abort()
 {
     return m_socket.abort();
@@ -285,4 +448,14 @@ hailo_status Udp::set_max_number_of_attempts(uint8_t max_number_of_attempts)
 
 }
 
+uint8_t Udp::get_max_number_of_attempts() const
+{
+    return m_max_number_of_attempts;
+}
+
+std::chrono::milliseconds Udp::get_timeout() const
+{
+    return std::chrono::milliseconds((m_timeout.tv_sec * MILLISECONDS_IN_SECOND) + (m_timeout.tv_usec / MICROSECONDS_IN_MILLISECOND));
+}
+
 } /* namespace hailort */
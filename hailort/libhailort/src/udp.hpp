@@ -15,6 +15,8 @@
 #include <hailo/hailort.h>
 #include "hailo/expected.hpp"
 
+#include <chrono>
+
 namespace hailort
 {
 
@@ -29,11 +31,27 @@ public:
     hailo_status set_timeout(const std::chrono::milliseconds timeout_ms);
     hailo_status send(uint8_t *buffer, size_t *size, bool use_padding, size_t max_payload_size);
     hailo_status recv(uint8_t *buffer, size_t *size);
+    // Sends size bytes as packets of packet_size bytes (the last one may be smaller), in as few syscalls as possible -
+    // segmented by the kernel (UDP GSO) when there's no padding and it's supported, otherwise batched by sendmmsg
+    hailo_status send_multiple(uint8_t *buffer, size_t size, size_t packet_size, bool use_padding);
+    // See Socket::enable_tx_time
+    hailo_status enable_tx_time();
+    // Like send_multiple, but the kernel sends the first packet at send_time, and each following packet once the bytes
+    // before it would have been sent at rate_bytes_per_sec. Requires enable_tx_time
+    hailo_status send_multiple_at(uint8_t *buffer, size_t size, size_t packet_size, bool use_padding,
+        std::chrono::steady_clock::time_point send_time, uint32_t rate_bytes_per_sec);
+    // Receives packets of up to packet_size bytes into buffer (one after the other, up to *size bytes). Waits only for
+    // the first packet, and returns the number of bytes received in *size
+    hailo_status recv_multiple(uint8_t *buffer, size_t *size, size_t packet_size);
     hailo_status abort();
     hailo_status has_data(bool log_timeouts_in_debug = false);
     hailo_status fw_interact(uint8_t *request_buffer, size_t request_size, uint8_t *response_buffer,
         size_t *response_size, uint32_t expected_sequence);
     hailo_status set_max_number_of_attempts(uint8_t max_number_of_attempts);
+    uint8_t get_max_number_of_attempts() const;
+    std::chrono::milliseconds get_timeout() const;
+    // Receives a single control response (of any sequence). Timeouts are expected, so they're logged in debug
+    hailo_status recv_control_response(uint8_t *buffer, size_t *size);
 
     UDP__sockaddr_in_t m_host_address;
     socklen_t m_host_address_length;
@@ -46,11 +64,16 @@ private:
         Socket &&socket, hailo_status &status);
 
     hailo_status bind(struct in_addr host_ip, uint16_t host_port);
+    // send_time_ns is the tx time of the first packet (0 sends the packets right away)
+    hailo_status send_multiple_impl(uint8_t *buffer, size_t size, size_t packet_size, bool use_padding,
+        uint64_t send_time_ns, uint32_t rate_bytes_per_sec);
     hailo_status receive_fw_response(uint8_t *buffer, size_t *size, uint32_t expected_sequence);
     hailo_status fw_interact_impl(uint8_t *request_buffer, size_t request_size, uint8_t *response_buffer,
         size_t *response_size, uint32_t expected_sequence);
 
     uint8_t m_max_number_of_attempts;
+    // Cleared after the first segmented send fails as unsupported
+    bool m_is_segmented_send_supported;
     Socket m_socket;
 };
 
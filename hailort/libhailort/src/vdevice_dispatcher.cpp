@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file vdevice_dispatcher.cpp
+ * @brief Load aware dispatching of batches between the physical devices of a VDevice (non scheduled flow)
+ **/
+
+#include "vdevice_dispatcher.hpp"
+#include "common/utils.hpp"
+#include "common/logger_macros.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace hailort
+{
+
+Expected<std::shared_ptr<VDeviceDispatcher>> VDeviceDispatcher::create(size_t devices_count)
+{
+    CHECK_AS_EXPECTED(0 < devices_count, HAILO_INVALID_ARGUMENT, "Dispatcher must have at least one device");
+
+    auto dispatcher = make_shared_nothrow<VDeviceDispatcher>(devices_count);
+    CHECK_NOT_NULL_AS_EXPECTED(dispatcher, HAILO_OUT_OF_HOST_MEMORY);
+
+    return dispatcher;
+}
+
+bool VDeviceDispatcher::should_use_load_aware_dispatch()
+{
+    auto load_aware_dispatch_env = std::getenv(HAILO_ENABLE_LOAD_AWARE_DISPATCH_ENV_VAR);
+    return ((nullptr != load_aware_dispatch_env) &&
+        (strnlen(load_aware_dispatch_env, 2) == 1) && (strncmp(load_aware_dispatch_env, "1", 1) == 0));
+}
+
+VDeviceDispatcher::VDeviceDispatcher(size_t devices_count) :
+    m_batches(),
+    m_first_batch_index(0),
+    m_device_batches(devices_count),
+    m_device_removed_batches_count(devices_count, 0),
+    m_inflight_batches(devices_count, 0),
+    m_last_device_index(devices_count - 1),
+    m_outputs_count(0),
+    m_is_aborted(false)
+{}
+
+void VDeviceDispatcher::register_output_stream()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_outputs_count++;
+}
+
+void VDeviceDispatcher::reset()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batches.clear();
+    m_first_batch_index = 0;
+    for (size_t device_index = 0; device_index < m_device_batches.size(); device_index++) {
+        m_device_batches[device_index].clear();
+        m_device_removed_batches_count[device_index] = 0;
+        m_inflight_batches[device_index] = 0;
+    }
+    m_last_device_index = m_device_batches.size() - 1;
+}
+
+void VDeviceDispatcher::abort()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_is_aborted = true;
+    }
+    m_cv.notify_all();
+}
+
+void VDeviceDispatcher::clear_abort()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_is_aborted = false;
+}
+
+size_t VDeviceDispatcher::get_input_device(uint64_t batch_index,
+    const std::function<size_t(size_t)> &get_pending_frames_count)
+{
+    const auto devices_count = m_inflight_batches.size();
+    auto selected_device = devices_count;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Batches are dispatched in order, since every input stream writes its batches in order
+        if (batch_index < (m_first_batch_index + m_batches.size())) {
+            assert(batch_index >= m_first_batch_index);
+            return m_batches[batch_index - m_first_batch_index].device_index;
+        }
+    }
+
+    // The queue depths are read from the devices, so they're queried without blocking the other streams
+    std::vector<size_t> pending_frames(devices_count);
+    for (size_t device_index = 0; device_index < devices_count; device_index++) {
+        pending_frames[device_index] = get_pending_frames_count(device_index);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Another input stream may have dispatched the batch meanwhile
+        if (batch_index < (m_first_batch_index + m_batches.size())) {
+            assert(batch_index >= m_first_batch_index);
+            return m_batches[batch_index - m_first_batch_index].device_index;
+        }
+        assert(batch_index == (m_first_batch_index + m_batches.size()));
+
+        auto selected_pending_frames = std::numeric_limits<size_t>::max();
+        // Starting after the last selected device, so balanced devices are used in turns (as in the round robin flow)
+        for (size_t i = 1; i <= devices_count; i++) {
+            const auto device_index = (m_last_device_index + i) % devices_count;
+            if ((devices_count == selected_device) || (pending_frames[device_index] < selected_pending_frames) ||
+                ((pending_frames[device_index] == selected_pending_frames) &&
+                 (m_inflight_batches[device_index] < m_inflight_batches[selected_device]))) {
+                selected_device = device_index;
+                selected_pending_frames = pending_frames[device_index];
+            }
+        }
+
+        m_batches.push_back(BatchInfo{selected_device, 0});
+        m_device_batches[selected_device].push_back(batch_index);
+        m_inflight_batches[selected_device]++;
+        m_last_device_index = selected_device;
+    }
+    m_cv.notify_all();
+    return selected_device;
+}
+
+Expected<size_t> VDeviceDispatcher::get_output_device(uint64_t batch_index, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto is_dispatched = m_cv.wait_for(lock, timeout, [this, batch_index]() {
+        return m_is_aborted || (batch_index < (m_first_batch_index + m_batches.size()));
+    });
+    if (m_is_aborted) {
+        return make_unexpected(HAILO_STREAM_ABORTED_BY_USER);
+    }
+    CHECK_AS_EXPECTED(is_dispatched, HAILO_TIMEOUT, "Waiting for batch {} to be dispatched timed out ({}ms)",
+        batch_index, timeout.count());
+    // The reading stream didn't mark the batch as read yet, so it can't be removed
+    assert(batch_index >= m_first_batch_index);
+
+    size_t device_index = m_batches[batch_index - m_first_batch_index].device_index;
+    return device_index;
+}
+
+Expected<uint64_t> VDeviceDispatcher::get_device_batch(size_t device_index, uint64_t device_batch_position)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    assert(device_index < m_device_batches.size());
+    assert(device_batch_position >= m_device_removed_batches_count[device_index]);
+
+    const auto position = device_batch_position - m_device_removed_batches_count[device_index];
+    if (position >= m_device_batches[device_index].size()) {
+        return make_unexpected(HAILO_NOT_AVAILABLE);
+    }
+    uint64_t batch_index = m_device_batches[device_index][static_cast<size_t>(position)];
+    return batch_index;
+}
+
+void VDeviceDispatcher::mark_batch_read(uint64_t batch_index)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    assert((batch_index >= m_first_batch_index) && (batch_index < (m_first_batch_index + m_batches.size())));
+
+    auto &batch = m_batches[batch_index - m_first_batch_index];
+    batch.outputs_read_count++;
+    if (batch.outputs_read_count == m_outputs_count) {
+        assert(0 < m_inflight_batches[batch.device_index]);
+        m_inflight_batches[batch.device_index]--;
+        remove_done_batches();
+    }
+}
+
+bool VDeviceDispatcher::is_batch_done(uint64_t batch_index) const
+{
+    return (batch_index < m_first_batch_index) ||
+        (m_batches[batch_index - m_first_batch_index].outputs_read_count == m_outputs_count);
+}
+
+void VDeviceDispatcher::remove_done_batches()
+{
+    // Batches may be done out of order (the reorder buffer reads ahead), so only a done prefix is removed
+    for (size_t device_index = 0; device_index < m_device_batches.size(); device_index++) {
+        auto &device_batches = m_device_batches[device_index];
+        while (!device_batches.empty() && is_batch_done(device_batches.front())) {
+            device_batches.pop_front();
+            m_device_removed_batches_count[device_index]++;
+        }
+    }
+    while (!m_batches.empty() && (m_batches.front().outputs_read_count == m_outputs_count)) {
+        m_batches.pop_front();
+        m_first_batch_index++;
+    }
+}
+
+} /* namespace hailort */
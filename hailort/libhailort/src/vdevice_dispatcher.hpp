@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file vdevice_dispatcher.hpp
+ * @brief Load aware dispatching of batches between the physical devices of a VDevice (non scheduled flow)
+ *
+ * By default, the native VDevice streams rotate through the devices every dynamic_batch_size frames, so a single
+ * slow (e.g. throttled) device slows down all of the devices. When enabled, all of the streams of a network share a
+ * VDeviceDispatcher, which sends each batch to the least loaded device (the device with the shortest input queue).
+ * The dispatcher records the device of every batch, so all of the inputs write the batch to the same device and the
+ * outputs know from which device to read it. The outputs read the frames of the other devices as soon as they are
+ * ready, into a reorder buffer, so the frames are returned in order without holding back the faster devices.
+ **/
+
+#ifndef HAILO_VDEVICE_DISPATCHER_HPP_
+#define HAILO_VDEVICE_DISPATCHER_HPP_
+
+#include "hailo/hailort.h"
+#include "hailo/expected.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hailort
+{
+
+#define HAILO_ENABLE_LOAD_AWARE_DISPATCH_ENV_VAR "HAILO_ENABLE_LOAD_AWARE_DISPATCH"
+
+class VDeviceDispatcher final
+{
+public:
+    static Expected<std::shared_ptr<VDeviceDispatcher>> create(size_t devices_count);
+    static bool should_use_load_aware_dispatch();
+
+    VDeviceDispatcher(size_t devices_count);
+
+    VDeviceDispatcher(const VDeviceDispatcher &other) = delete;
+    VDeviceDispatcher &operator=(const VDeviceDispatcher &other) = delete;
+    VDeviceDispatcher &operator=(VDeviceDispatcher &&other) = delete;
+    VDeviceDispatcher(VDeviceDispatcher &&other) = delete;
+
+    // A batch is done when all of the registered output streams have read it
+    void register_output_stream();
+
+    // Clears the dispatched batches, called when the network group is activated (before any frame is written)
+    void reset();
+    void abort();
+    void clear_abort();
+
+    /**
+     * Returns the device of @a batch_index. If the batch wasn't dispatched yet, it's dispatched to the device with the
+     * shortest queue - @a get_pending_frames_count returns the h2d queue depth of the calling stream on a given device.
+     * Ties are broken by the batches in flight (dispatched, but not read by all outputs), and then by rotating
+     * through the devices. @a get_pending_frames_count is called without holding the dispatcher's lock.
+     * The outputs read the batches of the other devices ahead once the hw completed them, except for NMS outputs,
+     * which are read in the batches order.
+     */
+    size_t get_input_device(uint64_t batch_index, const std::function<size_t(size_t)> &get_pending_frames_count);
+
+    // Returns the device of @a batch_index, waiting for an input stream to dispatch it.
+    Expected<size_t> get_output_device(uint64_t batch_index, std::chrono::milliseconds timeout);
+
+    /**
+     * Returns the batch at @a device_batch_position of @a device_index - the batches are read from each device in the
+     * order they were dispatched to it. Returns HAILO_NOT_AVAILABLE if no such batch was dispatched yet.
+     */
+    Expected<uint64_t> get_device_batch(size_t device_index, uint64_t device_batch_position);
+
+    // Called by every output stream once it read all of the frames of @a batch_index from the device
+    void mark_batch_read(uint64_t batch_index);
+
+    size_t devices_count() const
+    {
+        return m_inflight_batches.size();
+    }
+
+private:
+    struct BatchInfo {
+        size_t device_index;
+        uint32_t outputs_read_count;
+    };
+
+    bool is_batch_done(uint64_t batch_index) const;
+    void remove_done_batches();
+
+    // Batches from m_first_batch_index, which aren't done yet (or done, but after a batch which isn't)
+    std::deque<BatchInfo> m_batches;
+    uint64_t m_first_batch_index;
+    // The batches dispatched to each device, in dispatch order (done batches are removed from the front)
+    std::vector<std::deque<uint64_t>> m_device_batches;
+    std::vector<uint64_t> m_device_removed_batches_count;
+    std::vector<uint32_t> m_inflight_batches;
+    size_t m_last_device_index;
+    uint32_t m_outputs_count;
+    bool m_is_aborted;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+} /* namespace hailort */
+
+#endif /* HAILO_VDEVICE_DISPATCHER_HPP_ */
@@ -14,25 +14,37 @@
 #include "stream_internal.hpp"
 #include "hailo/hailort.h"
 #include "vdevice_stream.hpp"
+#include "vdevice_dispatcher.hpp"
 #include "hailo/expected.hpp"
 
+#include <map>
+
 namespace hailort
 {
 
 class InputVDeviceNativeStream : public InputVDeviceBaseStream {
 public:
     InputVDeviceNativeStream(InputVDeviceNativeStream &&other) :
-        InputVDeviceBaseStream(std::move(other))
+        InputVDeviceBaseStream(std::move(other)),
+        m_dispatcher(std::move(other.m_dispatcher)),
+        m_frames_written(other.m_frames_written),
+        m_current_device_index(other.m_current_device_index)
     {}
 
+    // If @a dispatcher is nullptr, the batches are sent to the devices in turns
     explicit InputVDeviceNativeStream(
         std::vector<std::reference_wrapper<VdmaInputStream>> &&streams,
         EventPtr &&network_group_activated_event,
         const LayerInfo &layer_info,
+        std::shared_ptr<VDeviceDispatcher> dispatcher,
         hailo_status &status) :
-            InputVDeviceBaseStream(std::move(streams), std::move(network_group_activated_event), layer_info, status)
+            InputVDeviceBaseStream(std::move(streams), std::move(network_group_activated_event), layer_info, status),
+            m_dispatcher(dispatcher),
+            m_frames_written(0),
+            m_current_device_index(0)
     {}
 
+    virtual hailo_status activate_stream(uint16_t dynamic_batch_size) override;
     virtual hailo_status abort() override;
     virtual hailo_status clear_abort() override;
     virtual bool is_scheduled() override { return false; };
@@ -40,28 +52,68 @@ public:
 protected:
     virtual Expected<size_t> sync_write_raw_buffer(const MemoryView &buffer,
         const std::function<bool()> &should_cancel = []() { return false; }) override;
+
+private:
+    Expected<size_t> sync_write_raw_buffer_dispatched(const MemoryView &buffer);
+
+    std::shared_ptr<VDeviceDispatcher> m_dispatcher;
+    uint64_t m_frames_written;
+    size_t m_current_device_index;
 };
 
 class OutputVDeviceNativeStream : public OutputVDeviceBaseStream {
 public:
     OutputVDeviceNativeStream(OutputVDeviceNativeStream &&other) :
-        OutputVDeviceBaseStream(std::move(other))
+        OutputVDeviceBaseStream(std::move(other)),
+        m_dispatcher(std::move(other.m_dispatcher)),
+        m_next_frame_index(other.m_next_frame_index),
+        m_device_frames_read(std::move(other.m_device_frames_read)),
+        m_reordered_frames(std::move(other.m_reordered_frames)),
+        m_free_frame_buffers(std::move(other.m_free_frame_buffers))
     {}
 
+    // If @a dispatcher is nullptr, the batches are read from the devices in turns
     explicit OutputVDeviceNativeStream(
         std::vector<std::reference_wrapper<VdmaOutputStream>> &&streams,
         const LayerInfo &layer_info,
         EventPtr &&network_group_activated_event,
+        std::shared_ptr<VDeviceDispatcher> dispatcher,
         hailo_status &status) :
-            OutputVDeviceBaseStream(std::move(streams), layer_info, std::move(network_group_activated_event), status)
-    {}
+            OutputVDeviceBaseStream(std::move(streams), layer_info, std::move(network_group_activated_event), status),
+            m_dispatcher(dispatcher),
+            m_next_frame_index(0),
+            m_device_frames_read(m_streams.size(), 0),
+            m_reordered_frames(),
+            m_free_frame_buffers()
+    {
+        if (nullptr != m_dispatcher) {
+            m_dispatcher->register_output_stream();
+        }
+    }
 
+    virtual hailo_status activate_stream(uint16_t dynamic_batch_size) override;
     virtual hailo_status abort() override;
     virtual hailo_status clear_abort() override;
     virtual bool is_scheduled() override { return false; };
 
 protected:
-    virtual hailo_status read(MemoryView buffer) override;;
+    virtual hailo_status read(MemoryView buffer) override;
+
+private:
+    // Frames of the other devices which are read ahead while waiting for the next frame, per device
+    static const uint32_t MAX_REORDERED_BATCHES_PER_DEVICE = 2;
+
+    hailo_status read_dispatched(MemoryView buffer);
+    // Reads the batches the other devices completed (by the hw num processed). NMS outputs aren't read ahead.
+    hailo_status read_ready_frames(size_t next_device_index, uint16_t batch_size);
+    Expected<uint64_t> get_next_device_frame_index(size_t device_index, uint16_t batch_size);
+    void mark_device_frame_read(size_t device_index, uint64_t frame_index, uint16_t batch_size);
+
+    std::shared_ptr<VDeviceDispatcher> m_dispatcher;
+    uint64_t m_next_frame_index;
+    std::vector<uint64_t> m_device_frames_read;
+    std::map<uint64_t, Buffer> m_reordered_frames;
+    std::vector<Buffer> m_free_frame_buffers;
 };
 
 } /* namespace hailort */
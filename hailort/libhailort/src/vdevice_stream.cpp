@@ -71,12 +71,12 @@ hailo_status InputVDeviceBaseStream::sync_write_all_raw_buffer_no_transform_impl
     return sync_write_raw_buffer(MemoryView(static_cast<uint8_t*>(buffer) + offset, size)).status();
 }
 
-hailo_status InputVDeviceBaseStream::send_pending_buffer(size_t device_index)
+hailo_status InputVDeviceBaseStream::send_pending_buffer(size_t device_index, bool ring_doorbell)
 {
     assert(1 == m_streams.size());
     CHECK(0 == device_index, HAILO_INVALID_OPERATION);
     VdmaInputStream &vdma_input = static_cast<VdmaInputStream&>(m_streams[m_next_transfer_stream_index].get());
-    return vdma_input.send_pending_buffer();
+    return vdma_input.send_pending_buffer(0, ring_doorbell);
 }
 
 Expected<size_t> InputVDeviceBaseStream::get_buffer_frames_size() const
@@ -105,7 +105,8 @@ Expected<size_t> InputVDeviceBaseStream::get_pending_frames_count() const
 
 Expected<std::unique_ptr<InputVDeviceBaseStream>> InputVDeviceBaseStream::create(std::vector<std::reference_wrapper<VdmaInputStream>> &&low_level_streams,
     const LayerInfo &edge_layer, const scheduler_ng_handle_t &network_group_handle,
-    EventPtr network_group_activated_event, NetworkGroupSchedulerWeakPtr network_group_scheduler)
+    EventPtr network_group_activated_event, NetworkGroupSchedulerWeakPtr network_group_scheduler,
+    std::shared_ptr<VDeviceDispatcher> dispatcher)
 {
     assert(0 < low_level_streams.size());
     auto status = HAILO_UNINITIALIZED;
@@ -129,7 +130,7 @@ Expected<std::unique_ptr<InputVDeviceBaseStream>> InputVDeviceBaseStream::create
         }
     } else {
         local_vdevice_stream = make_unique_nothrow<InputVDeviceNativeStream>(std::move(low_level_streams),
-            std::move(network_group_activated_event), edge_layer,status);
+            std::move(network_group_activated_event), edge_layer, dispatcher, status);
     }
 
     CHECK_AS_EXPECTED((nullptr != local_vdevice_stream), HAILO_OUT_OF_HOST_MEMORY);
@@ -177,12 +178,29 @@ Expected<size_t> ScheduledInputStream::sync_write_raw_buffer(const MemoryView &b
     return sync_write_raw_buffer_impl(buffer, m_network_group_handle, should_cancel);
 }
 
+hailo_status InputVDeviceNativeStream::activate_stream(uint16_t dynamic_batch_size)
+{
+    auto status = InputVDeviceBaseStream::activate_stream(dynamic_batch_size);
+    CHECK_SUCCESS(status);
+
+    if (nullptr != m_dispatcher) {
+        // The frames are counted from the activation, as the devices count them
+        m_frames_written = 0;
+        m_dispatcher->reset();
+    }
+    return HAILO_SUCCESS;
+}
+
 Expected<size_t> InputVDeviceNativeStream::sync_write_raw_buffer(const MemoryView &buffer, const std::function<bool()> &should_cancel)
 {
     if (should_cancel()) {
         return make_unexpected(HAILO_STREAM_ABORTED_BY_USER);
     }
 
+    if (nullptr != m_dispatcher) {
+        return sync_write_raw_buffer_dispatched(buffer);
+    }
+
     auto expected_written_bytes = m_streams[m_next_transfer_stream_index].get().sync_write_raw_buffer(buffer);
     if (HAILO_SUCCESS != expected_written_bytes.status()) {
         LOGGER__INFO("Write to stream has failed! status = {}", expected_written_bytes.status());
@@ -198,6 +216,26 @@ Expected<size_t> InputVDeviceNativeStream::sync_write_raw_buffer(const MemoryVie
     return written_bytes;
 }
 
+Expected<size_t> InputVDeviceNativeStream::sync_write_raw_buffer_dispatched(const MemoryView &buffer)
+{
+    const auto batch_size = m_streams[0].get().get_dynamic_batch_size();
+    if (0 == (m_frames_written % batch_size)) {
+        m_current_device_index = m_dispatcher->get_input_device(m_frames_written / batch_size, [this](size_t device_index) {
+            auto pending_frames_count = m_streams[device_index].get().get_hw_pending_frames_count();
+            return pending_frames_count ? pending_frames_count.value() : 0;
+        });
+    }
+
+    auto expected_written_bytes = m_streams[m_current_device_index].get().sync_write_raw_buffer(buffer);
+    if (HAILO_SUCCESS != expected_written_bytes.status()) {
+        LOGGER__INFO("Write to stream has failed! status = {}", expected_written_bytes.status());
+        return make_unexpected(expected_written_bytes.status());
+    }
+    m_frames_written++;
+
+    return expected_written_bytes.release();
+}
+
 Expected<size_t> ScheduledInputStream::sync_write_raw_buffer_impl(const MemoryView &buffer, scheduler_ng_handle_t network_group_handle,
     const std::function<bool()> &should_cancel)
 {
@@ -247,6 +285,9 @@ hailo_status InputVDeviceNativeStream::abort()
             status = abort_status;
         }
     }
+    if (nullptr != m_dispatcher) {
+        m_dispatcher->abort();
+    }
 
     return status;
 }
@@ -288,6 +329,9 @@ hailo_status InputVDeviceNativeStream::clear_abort()
             status = clear_abort_status;
         }
     }
+    if (nullptr != m_dispatcher) {
+        m_dispatcher->clear_abort();
+    }
 
     return status;
 }
@@ -369,8 +413,29 @@ hailo_status ScheduledOutputStream::read(MemoryView buffer)
     return read_impl(buffer, m_network_group_handle);
 }
 
+hailo_status OutputVDeviceNativeStream::activate_stream(uint16_t dynamic_batch_size)
+{
+    auto status = OutputVDeviceBaseStream::activate_stream(dynamic_batch_size);
+    CHECK_SUCCESS(status);
+
+    if (nullptr != m_dispatcher) {
+        m_next_frame_index = 0;
+        std::fill(m_device_frames_read.begin(), m_device_frames_read.end(), 0);
+        for (auto &reordered_frame : m_reordered_frames) {
+            m_free_frame_buffers.emplace_back(std::move(reordered_frame.second));
+        }
+        m_reordered_frames.clear();
+        m_dispatcher->reset();
+    }
+    return HAILO_SUCCESS;
+}
+
 hailo_status OutputVDeviceNativeStream::read(MemoryView buffer)
 {
+    if (nullptr != m_dispatcher) {
+        return read_dispatched(buffer);
+    }
+
     auto status = m_streams[m_next_transfer_stream_index].get().read(buffer);
     if (HAILO_SUCCESS != status) {
         LOGGER__INFO("Read from stream has failed! status = {}", status);
@@ -386,6 +451,121 @@ hailo_status OutputVDeviceNativeStream::read(MemoryView buffer)
     return HAILO_SUCCESS;
 }
 
+hailo_status OutputVDeviceNativeStream::read_dispatched(MemoryView buffer)
+{
+    const auto batch_size = m_streams[0].get().get_dynamic_batch_size();
+
+    auto reordered_frame = m_reordered_frames.find(m_next_frame_index);
+    if (m_reordered_frames.end() != reordered_frame) {
+        CHECK(buffer.size() == reordered_frame->second.size(), HAILO_INVALID_ARGUMENT,
+            "Read size {} must be the frame size {}", buffer.size(), reordered_frame->second.size());
+        memcpy(buffer.data(), reordered_frame->second.data(), buffer.size());
+        m_free_frame_buffers.emplace_back(std::move(reordered_frame->second));
+        m_reordered_frames.erase(reordered_frame);
+        m_next_frame_index++;
+        return HAILO_SUCCESS;
+    }
+
+    auto device_index = m_dispatcher->get_output_device(m_next_frame_index / batch_size, get_timeout());
+    if (HAILO_STREAM_ABORTED_BY_USER == device_index.status()) {
+        LOGGER__INFO("Read from stream was aborted.");
+        return device_index.status();
+    }
+    CHECK_EXPECTED_AS_STATUS(device_index);
+
+    // Frames that the other devices already finished are read ahead, so they don't wait for the slower device
+    auto status = read_ready_frames(device_index.value(), batch_size);
+    if (HAILO_SUCCESS != status) {
+        LOGGER__INFO("Read from stream has failed! status = {}", status);
+        return status;
+    }
+
+    // The earlier frames of the device were already read, so the next frame of the device is the next frame to return
+    assert(m_next_frame_index == get_next_device_frame_index(device_index.value(), batch_size).value());
+    status = m_streams[device_index.value()].get().read(buffer);
+    if (HAILO_SUCCESS != status) {
+        LOGGER__INFO("Read from stream has failed! status = {}", status);
+        return status;
+    }
+    mark_device_frame_read(device_index.value(), m_next_frame_index, batch_size);
+    m_next_frame_index++;
+
+    return HAILO_SUCCESS;
+}
+
+hailo_status OutputVDeviceNativeStream::read_ready_frames(size_t next_device_index, uint16_t batch_size)
+{
+    if (HAILO_FORMAT_ORDER_HAILO_NMS == get_info().format.order) {
+        // The frames of NMS have variable sizes, so the ready frames can't be counted - NMS is read in order
+        return HAILO_SUCCESS;
+    }
+
+    const auto max_reordered_frames = (m_streams.size() - 1) * MAX_REORDERED_BATCHES_PER_DEVICE * batch_size;
+    for (size_t device_index = 0; device_index < m_streams.size(); device_index++) {
+        if (next_device_index == device_index) {
+            continue;
+        }
+
+        auto ready_frames_count = m_streams[device_index].get().get_hw_ready_frames_count();
+        CHECK_EXPECTED_AS_STATUS(ready_frames_count);
+
+        // The d2h interrupt is raised once per batch and a read waits for it, so only whole batches are read ahead
+        const auto read_frames_in_batch = m_device_frames_read[device_index] % batch_size;
+        const auto ready_batches_end = ((read_frames_in_batch + ready_frames_count.value()) / batch_size) * batch_size;
+        auto frames_to_read = (ready_batches_end > read_frames_in_batch) ? (ready_batches_end - read_frames_in_batch) : 0;
+
+        for (; (frames_to_read > 0) && (m_reordered_frames.size() < max_reordered_frames); frames_to_read--) {
+            auto frame_index = get_next_device_frame_index(device_index, batch_size);
+            if (HAILO_NOT_AVAILABLE == frame_index.status()) {
+                // No frames were sent to the device
+                break;
+            }
+            CHECK_EXPECTED_AS_STATUS(frame_index);
+
+            Buffer frame_buffer;
+            if (m_free_frame_buffers.empty()) {
+                auto new_buffer = Buffer::create(get_info().hw_frame_size);
+                CHECK_EXPECTED_AS_STATUS(new_buffer);
+                frame_buffer = new_buffer.release();
+            } else {
+                frame_buffer = std::move(m_free_frame_buffers.back());
+                m_free_frame_buffers.pop_back();
+            }
+
+            auto status = m_streams[device_index].get().read(MemoryView(frame_buffer));
+            if (HAILO_SUCCESS != status) {
+                m_free_frame_buffers.emplace_back(std::move(frame_buffer));
+                return status;
+            }
+            mark_device_frame_read(device_index, frame_index.value(), batch_size);
+            m_reordered_frames.emplace(frame_index.value(), std::move(frame_buffer));
+        }
+    }
+
+    return HAILO_SUCCESS;
+}
+
+Expected<uint64_t> OutputVDeviceNativeStream::get_next_device_frame_index(size_t device_index, uint16_t batch_size)
+{
+    const auto device_frames_read = m_device_frames_read[device_index];
+    auto batch_index = m_dispatcher->get_device_batch(device_index, device_frames_read / batch_size);
+    if (HAILO_NOT_AVAILABLE == batch_index.status()) {
+        return make_unexpected(batch_index.status());
+    }
+    CHECK_EXPECTED(batch_index);
+
+    uint64_t frame_index = (batch_index.value() * batch_size) + (device_frames_read % batch_size);
+    return frame_index;
+}
+
+void OutputVDeviceNativeStream::mark_device_frame_read(size_t device_index, uint64_t frame_index, uint16_t batch_size)
+{
+    m_device_frames_read[device_index]++;
+    if (0 == (m_device_frames_read[device_index] % batch_size)) {
+        m_dispatcher->mark_batch_read(frame_index / batch_size);
+    }
+}
+
 hailo_status ScheduledOutputStream::read_impl(MemoryView buffer, scheduler_ng_handle_t network_group_handle)
 {
     auto network_group_scheduler = m_network_group_scheduler.lock();
@@ -416,7 +596,7 @@ hailo_status ScheduledOutputStream::read_impl(MemoryView buffer, scheduler_ng_ha
 
 Expected<std::unique_ptr<OutputVDeviceBaseStream>> OutputVDeviceBaseStream::create(std::vector<std::reference_wrapper<VdmaOutputStream>> &&low_level_streams,
     const LayerInfo &edge_layer, const scheduler_ng_handle_t &network_group_handle, EventPtr network_group_activated_event,
-    NetworkGroupSchedulerWeakPtr network_group_scheduler)
+    NetworkGroupSchedulerWeakPtr network_group_scheduler, std::shared_ptr<VDeviceDispatcher> dispatcher)
 {
     assert(0 < low_level_streams.size());
     auto status = HAILO_UNINITIALIZED;
@@ -427,7 +607,7 @@ Expected<std::unique_ptr<OutputVDeviceBaseStream>> OutputVDeviceBaseStream::crea
             edge_layer, std::move(network_group_activated_event), network_group_scheduler, status);
     } else {
         local_vdevice_stream = make_unique_nothrow<OutputVDeviceNativeStream>(std::move(low_level_streams), edge_layer,
-            std::move(network_group_activated_event), status);
+            std::move(network_group_activated_event), dispatcher, status);
     }
 
     CHECK_AS_EXPECTED((nullptr != local_vdevice_stream), HAILO_OUT_OF_HOST_MEMORY);
@@ -472,6 +652,9 @@ hailo_status OutputVDeviceNativeStream::abort()
             status = abort_status;
         }
     }
+    if (nullptr != m_dispatcher) {
+        m_dispatcher->abort();
+    }
 
     return status;
 }
@@ -514,6 +697,9 @@ hailo_status OutputVDeviceNativeStream::clear_abort()
             status = clear_abort_status;
         }
     }
+    if (nullptr != m_dispatcher) {
+        m_dispatcher->clear_abort();
+    }
 
     return status;
 }
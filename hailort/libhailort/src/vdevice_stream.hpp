@@ -27,6 +27,7 @@
 #include "vdevice_internal.hpp"
 #include "vdma_device.hpp"
 #include "vdma_stream.hpp"
+#include "vdevice_dispatcher.hpp"
 #include "hailo/expected.hpp"
 
 namespace hailort
@@ -37,7 +38,8 @@ class InputVDeviceBaseStream : public InputStreamBase {
 public:
     static Expected<std::unique_ptr<InputVDeviceBaseStream>> create(std::vector<std::reference_wrapper<VdmaInputStream>> &&low_level_streams,
         const LayerInfo &edge_layer, const scheduler_ng_handle_t &network_group_handle,
-        EventPtr network_group_activated_event, NetworkGroupSchedulerWeakPtr network_group_scheduler);
+        EventPtr network_group_activated_event, NetworkGroupSchedulerWeakPtr network_group_scheduler,
+        std::shared_ptr<VDeviceDispatcher> dispatcher = nullptr);
 
     InputVDeviceBaseStream(InputVDeviceBaseStream &&other) :
         InputStreamBase(std::move(other)),
@@ -55,7 +57,7 @@ public:
     virtual std::chrono::milliseconds get_timeout() const override;
     virtual hailo_status set_timeout(std::chrono::milliseconds timeout) override;
 
-    virtual hailo_status send_pending_buffer(size_t device_index = 0) override;
+    virtual hailo_status send_pending_buffer(size_t device_index = 0, bool ring_doorbell = true) override;
     virtual Expected<size_t> get_buffer_frames_size() const override;
     virtual Expected<size_t> get_pending_frames_count() const override;
     virtual bool is_scheduled() override = 0;
@@ -113,7 +115,8 @@ public:
 
     static Expected<std::unique_ptr<OutputVDeviceBaseStream>> create(std::vector<std::reference_wrapper<VdmaOutputStream>> &&low_level_streams,
         const LayerInfo &edge_layer, const scheduler_ng_handle_t &network_group_handle,
-        EventPtr network_group_activated_event, NetworkGroupSchedulerWeakPtr network_group_scheduler);
+        EventPtr network_group_activated_event, NetworkGroupSchedulerWeakPtr network_group_scheduler,
+        std::shared_ptr<VDeviceDispatcher> dispatcher = nullptr);
 
     virtual hailo_status activate_stream(uint16_t dynamic_batch_size) override;
     virtual hailo_status deactivate_stream() override;
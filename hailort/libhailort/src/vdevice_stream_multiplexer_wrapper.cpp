@@ -82,9 +82,9 @@ bool VDeviceInputStreamMultiplexerWrapper::is_scheduled()
     return m_vdevice_input_stream->is_scheduled();
 }
 
-hailo_status VDeviceInputStreamMultiplexerWrapper::send_pending_buffer(size_t device_index)
+hailo_status VDeviceInputStreamMultiplexerWrapper::send_pending_buffer(size_t device_index, bool ring_doorbell)
 {
-    return m_vdevice_input_stream->send_pending_buffer(device_index);
+    return m_vdevice_input_stream->send_pending_buffer(device_index, ring_doorbell);
 }
 
 Expected<size_t> VDeviceInputStreamMultiplexerWrapper::get_buffer_frames_size() const
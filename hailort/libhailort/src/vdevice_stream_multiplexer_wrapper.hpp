@@ -52,7 +52,7 @@ public:
     virtual hailo_status clear_abort() override;
     virtual bool is_scheduled() override;
 
-    virtual hailo_status send_pending_buffer(size_t device_index = 0) override;
+    virtual hailo_status send_pending_buffer(size_t device_index = 0, bool ring_doorbell = true) override;
     virtual Expected<size_t> get_buffer_frames_size() const override;
     virtual Expected<size_t> get_pending_frames_count() const override;
 
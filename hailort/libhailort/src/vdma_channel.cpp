@@ -11,6 +11,7 @@
 #include <list>
 #include <chrono>
 #include <thread>
+#include <cstdlib>
 
 #include <iostream>
 
@@ -89,8 +90,10 @@ VdmaChannel::VdmaChannel(vdma::ChannelId channel_id, Direction direction, HailoR
       m_device_registers(driver, channel_id, other_direction(direction)),
       m_desc_page_size(desc_page_size),
       m_stream_name(stream_name), m_latency_meter(latency_meter), m_channel_enabled(false),
-      m_transfers_per_axi_intr(transfers_per_axi_intr), m_pending_buffers_sizes(0), m_pending_num_avail_offset(0), m_is_waiting_for_channel_completion(false),
-      m_is_aborted_by_internal_source(false)
+      m_transfers_per_axi_intr(transfers_per_axi_intr), m_completion_mode(HAILO_STREAM_COMPLETION_MODE_INTERRUPT),
+      m_busy_poll_timeout(HAILO_DEFAULT_BUSY_POLL_TIMEOUT_US), m_transfers_per_host_intr(1), m_pending_buffers_sizes(0), m_pending_num_avail_offset(0), m_is_waiting_for_channel_completion(false),
+      m_is_aborted_by_internal_source(false), m_doorbell_max_latency(get_doorbell_max_latency()),
+      m_first_deferred_doorbell_time(), m_doorbell_timer_thread(nullptr), m_is_doorbell_timer_stopped(false)
 {
     if (m_transfers_per_axi_intr == 0) {
         LOGGER__ERROR("Invalid transfers per axi interrupt");
@@ -116,6 +119,8 @@ VdmaChannel::VdmaChannel(vdma::ChannelId channel_id, Direction direction, HailoR
 
 VdmaChannel::~VdmaChannel()
 {
+    stop_doorbell_timer();
+
     if (m_channel_enabled) {
         stop_channel();
         m_channel_enabled = false;
@@ -153,11 +158,21 @@ VdmaChannel::VdmaChannel(VdmaChannel &&other) noexcept:
  m_channel_handle(std::move(other.m_channel_handle)),
  m_channel_enabled(std::exchange(other.m_channel_enabled, false)),
  m_transfers_per_axi_intr(std::move(other.m_transfers_per_axi_intr)),
+ m_completion_mode(other.m_completion_mode),
+ m_busy_poll_timeout(other.m_busy_poll_timeout),
+ m_transfers_per_host_intr(other.m_transfers_per_host_intr),
  m_pending_buffers_sizes(std::move(other.m_pending_buffers_sizes)),
  m_pending_num_avail_offset(other.m_pending_num_avail_offset.exchange(0)),
  m_is_waiting_for_channel_completion(other.m_is_waiting_for_channel_completion.exchange(false)),
- m_is_aborted_by_internal_source(other.m_is_aborted_by_internal_source.exchange(false))
-{}
+ m_is_aborted_by_internal_source(other.m_is_aborted_by_internal_source.exchange(false)),
+ m_doorbell_max_latency(other.m_doorbell_max_latency),
+ m_first_deferred_doorbell_time(other.m_first_deferred_doorbell_time),
+ m_doorbell_timer_thread(nullptr),
+ m_is_doorbell_timer_stopped(false)
+{
+    // The timer thread refers to the channel, it is started only after the channel was created (and moved)
+    assert(nullptr == other.m_doorbell_timer_thread);
+}
 
 hailo_status VdmaChannel::stop_channel()
 {
@@ -253,6 +268,31 @@ Expected<size_t> VdmaChannel::get_d2h_pending_descs_count()
     return desc_num_ready;
 }
 
+Expected<size_t> VdmaChannel::get_h2d_hw_pending_descs_count()
+{
+    assert(m_state);
+
+    std::lock_guard<State> state_guard(*m_state);
+
+    auto hw_num_processed = get_hw_num_processed();
+    CHECK_EXPECTED(hw_num_processed);
+
+    // Includes the descriptors whose doorbell was deferred
+    return static_cast<size_t>(CB_PROG(m_state->m_descs, CB_HEAD(m_state->m_descs), hw_num_processed.value()));
+}
+
+Expected<size_t> VdmaChannel::get_d2h_hw_ready_descs_count()
+{
+    assert(m_state);
+
+    std::lock_guard<State> state_guard(*m_state);
+
+    auto hw_num_processed = get_hw_num_processed();
+    CHECK_EXPECTED(hw_num_processed);
+
+    return static_cast<size_t>(CB_PROG(m_state->m_descs, hw_num_processed.value(), m_state->m_d2h_read_desc_index));
+}
+
 hailo_status VdmaChannel::prepare_d2h_pending_descriptors(uint32_t transfer_size)
 {
     assert(m_buffer);
@@ -265,9 +305,8 @@ hailo_status VdmaChannel::prepare_d2h_pending_descriptors(uint32_t transfer_size
     const auto first_desc_interrupts_domain = VdmaInterruptsDomain::NONE;
     for (uint32_t i = 0; i < transfers_count; i++) {
         /* Provide FW interrupt only in the end of the last transfer in the batch */
-        auto last_desc_interrutps_domain = 
-            (static_cast<uint32_t>(m_transfers_per_axi_intr - 1) == (i % m_transfers_per_axi_intr)) ? 
-                VdmaInterruptsDomain::BOTH : VdmaInterruptsDomain::HOST;
+        auto last_desc_interrutps_domain = get_d2h_last_desc_interrupts_domain(
+            static_cast<uint32_t>(m_transfers_per_axi_intr - 1) == (i % m_transfers_per_axi_intr));
         auto status = prepare_descriptors(transfer_size, first_desc_interrupts_domain, last_desc_interrutps_domain);
         if (HAILO_STREAM_NOT_ACTIVATED == status) {
             LOGGER__INFO("preparing descriptors failed because channel is not activated");
@@ -327,6 +366,8 @@ hailo_status VdmaChannel::allocate_resources(uint32_t descs_count)
     CB_INIT(m_state->m_buffers, pending_buffers_size);
     m_state->m_previous_tail = 0;
     m_state->m_should_reprogram_buffer = false;
+    m_state->m_pending_doorbell_descs = 0;
+    m_state->m_accumulated_host_transfers = 0;
 
     // Allocate descriptor list (host side)
     auto status = allocate_buffer(descs_count * m_desc_page_size);
@@ -345,6 +386,8 @@ void VdmaChannel::reset_internal_counters()
     m_state->m_d2h_read_desc_index = 0;
     m_state->m_last_timestamp_num_processed = 0;
     m_state->m_accumulated_transfers = 0;
+    m_state->m_accumulated_host_transfers = 0;
+    m_state->m_pending_doorbell_descs = 0;
 }
 
 hailo_status VdmaChannel::complete_channel_activation(uint32_t transfer_size)
@@ -464,6 +507,19 @@ hailo_status VdmaChannel::wait(size_t buffer_size, std::chrono::milliseconds tim
         CHECK(was_successful, HAILO_TIMEOUT);
         return HAILO_SUCCESS;
     }
+
+    if (Direction::H2D == m_direction) {
+        // Descriptors with a deferred doorbell won't be processed (hence won't free space) until the doorbell is rung
+        std::lock_guard<State> state_guard(*m_state);
+        if ((0 != m_state->m_pending_doorbell_descs) && !is_ready_for_transfer_h2d(buffer_size)) {
+            auto status = ring_doorbell_impl();
+            if (HAILO_STREAM_NOT_ACTIVATED == status) {
+                return status;
+            }
+            CHECK_SUCCESS(status);
+        }
+    }
+
     auto is_ready_for_transfer = (Direction::H2D == m_direction) ?
         std::bind(&VdmaChannel::is_ready_for_transfer_h2d, this, buffer_size) :
         std::bind(&VdmaChannel::is_ready_for_transfer_d2h, this, buffer_size);
@@ -609,6 +665,15 @@ hailo_status VdmaChannel::write_buffer(const MemoryView &buffer, std::chrono::mi
                 return false;
             }
 
+            if (0 != m_state->m_pending_doorbell_descs) {
+                // Make sure the hw is working on the deferred descriptors, otherwise no completion will arrive
+                channel_completion_status = ring_doorbell_impl();
+                if (HAILO_SUCCESS != channel_completion_status) {
+                    LOGGER__INFO("ring_doorbell failed with status={}", channel_completion_status);
+                    return true;
+                }
+            }
+
             state_guard.unlock();
             channel_completion_status = wait_for_channel_completion(timeout);
             state_guard.lock();
@@ -633,7 +698,7 @@ hailo_status VdmaChannel::write_buffer(const MemoryView &buffer, std::chrono::mi
     return write_buffer_impl(buffer);
 }
 
-hailo_status VdmaChannel::send_pending_buffer_impl()
+hailo_status VdmaChannel::send_pending_buffer_impl(bool ring_doorbell)
 {
     CHECK(!m_pending_buffers_sizes.empty(), HAILO_INVALID_OPERATION, "There are no pending buffers to send!");
     assert(m_buffer);
@@ -644,7 +709,9 @@ hailo_status VdmaChannel::send_pending_buffer_impl()
     VdmaInterruptsDomain first_desc_interrupts_domain = (m_latency_meter != nullptr) ?
         VdmaInterruptsDomain::HOST : VdmaInterruptsDomain::NONE;
 
-    auto status = prepare_descriptors(m_pending_buffers_sizes.front(), first_desc_interrupts_domain, last_desc_interrupts_domain);
+    ring_doorbell = ring_doorbell || is_doorbell_max_latency_expired();
+    auto status = prepare_descriptors(m_pending_buffers_sizes.front(), first_desc_interrupts_domain, last_desc_interrupts_domain,
+        ring_doorbell);
     if (HAILO_STREAM_NOT_ACTIVATED == status) {
         LOGGER__INFO("sending pending buffer failed because stream is not activated");
         // Stream was aborted during transfer - reset pending buffers
@@ -665,14 +732,14 @@ hailo_status VdmaChannel::send_pending_buffer_impl()
     return HAILO_SUCCESS;
 }
 
-hailo_status VdmaChannel::send_pending_buffer()
+hailo_status VdmaChannel::send_pending_buffer(bool ring_doorbell)
 {
     {
         assert(m_state);
         assert(m_buffer);
         std::lock_guard<State> state_guard(*m_state);
 
-        auto status = send_pending_buffer_impl();
+        auto status = send_pending_buffer_impl(ring_doorbell);
         if (HAILO_STREAM_NOT_ACTIVATED == status) {
             LOGGER__INFO("stream is not activated");
             return HAILO_STREAM_NOT_ACTIVATED;
@@ -712,6 +779,15 @@ hailo_status VdmaChannel::flush(const std::chrono::milliseconds &timeout)
         return HAILO_INVALID_OPERATION;
     }
 
+    {
+        std::lock_guard<State> state_guard(*m_state);
+        auto status = ring_doorbell_impl();
+        if (HAILO_STREAM_NOT_ACTIVATED == status) {
+            return status;
+        }
+        CHECK_SUCCESS(status);
+    }
+
     return wait_for_condition([this] { return CB_HEAD(m_state->m_buffers) == CB_TAIL(m_state->m_buffers); }, timeout);
 }
 
@@ -735,8 +811,6 @@ hailo_status VdmaChannel::transfer_d2h(void *buf, size_t count)
     hailo_status status = HAILO_UNINITIALIZED;
     /* Provide FW interrupt only in the end of the last transfer in the batch */
     VdmaInterruptsDomain first_desc_interrupts_domain = VdmaInterruptsDomain::NONE;
-    VdmaInterruptsDomain last_desc_interrupts_domain = (m_state->m_accumulated_transfers + 1 == m_transfers_per_axi_intr) ? 
-        VdmaInterruptsDomain::BOTH : VdmaInterruptsDomain::HOST;
  
     assert(m_state);
     assert(m_buffer);
@@ -761,6 +835,8 @@ hailo_status VdmaChannel::transfer_d2h(void *buf, size_t count)
 
     // prepare descriptors for next recv
     if (*m_channel_handle != HailoRTDriver::INVALID_VDMA_CHANNEL_HANDLE) {
+        const auto last_desc_interrupts_domain = get_d2h_last_desc_interrupts_domain(
+            m_state->m_accumulated_transfers + 1 == m_transfers_per_axi_intr);
         status = prepare_descriptors(count, first_desc_interrupts_domain, last_desc_interrupts_domain);
         if (HAILO_STREAM_NOT_ACTIVATED == status) {
             LOGGER__INFO("transfer d2h failed because stream is not activated");
@@ -774,6 +850,21 @@ hailo_status VdmaChannel::transfer_d2h(void *buf, size_t count)
     return HAILO_SUCCESS;
 }
 
+VdmaInterruptsDomain VdmaChannel::get_d2h_last_desc_interrupts_domain(bool device_interrupt)
+{
+    assert(m_state);
+
+    // With interrupt moderation, the host is interrupted only on every m_transfers_per_host_intr transfer.
+    // Transfers completed in between are collected by wait_moderated_interrupts.
+    const bool host_interrupt = (m_state->m_accumulated_host_transfers + 1 >= m_transfers_per_host_intr);
+    m_state->m_accumulated_host_transfers = host_interrupt ? 0 : (m_state->m_accumulated_host_transfers + 1);
+
+    if (host_interrupt) {
+        return device_interrupt ? VdmaInterruptsDomain::BOTH : VdmaInterruptsDomain::HOST;
+    }
+    return device_interrupt ? VdmaInterruptsDomain::DEVICE : VdmaInterruptsDomain::NONE;
+}
+
 uint16_t VdmaChannel::get_num_available()
 {
     assert(m_state);
@@ -790,7 +881,9 @@ uint16_t VdmaChannel::get_num_available()
     assert(is_aborted_exp);
 
     if ((HailoRTDriver::INVALID_VDMA_CHANNEL_HANDLE != *m_channel_handle) && !is_aborted_exp.value()) {
-        assert(hw_num_avail.value() == num_available);
+        // The hw num_available lags behind by the descriptors whose doorbell was deferred
+        assert(hw_num_avail.value() ==
+            ((num_available - m_state->m_pending_doorbell_descs) & static_cast<uint32_t>(m_state->m_descs.size_mask)));
     }
 #endif
     return num_available;
@@ -835,7 +928,29 @@ hailo_status VdmaChannel::set_transfers_per_axi_intr(uint16_t transfers_per_axi_
     return HAILO_SUCCESS;
 }
 
-hailo_status VdmaChannel::inc_num_available(uint16_t value)
+hailo_status VdmaChannel::set_d2h_completion_params(const hailo_vdma_output_stream_completion_params_t &completion_params)
+{
+    CHECK(Direction::D2H == m_direction, HAILO_INVALID_OPERATION, "Completion params are supported only on D2H channels");
+    CHECK((HAILO_STREAM_COMPLETION_MODE_INTERRUPT == completion_params.completion_mode) ||
+        (HAILO_STREAM_COMPLETION_MODE_BUSY_POLL == completion_params.completion_mode), HAILO_INVALID_ARGUMENT,
+        "Invalid completion mode {}", completion_params.completion_mode);
+
+    const bool is_default_mode = (HAILO_STREAM_COMPLETION_MODE_INTERRUPT == completion_params.completion_mode) &&
+        (completion_params.transfers_per_interrupt <= 1);
+    if ((nullptr != m_latency_meter) && !is_default_mode) {
+        LOGGER__WARNING("Ignoring completion params of channel {} ({}), since latency measurement is enabled",
+            m_channel_id, m_stream_name);
+        return HAILO_SUCCESS;
+    }
+
+    m_completion_mode = completion_params.completion_mode;
+    m_busy_poll_timeout = std::chrono::microseconds((0 == completion_params.busy_poll_timeout_us) ?
+        HAILO_DEFAULT_BUSY_POLL_TIMEOUT_US : completion_params.busy_poll_timeout_us);
+    m_transfers_per_host_intr = std::max(completion_params.transfers_per_interrupt, static_cast<uint16_t>(1));
+    return HAILO_SUCCESS;
+}
+
+hailo_status VdmaChannel::inc_num_available(uint16_t value, bool ring_doorbell)
 {
     assert(m_state);
 
@@ -849,9 +964,120 @@ hailo_status VdmaChannel::inc_num_available(uint16_t value)
 
     CB_ENQUEUE(m_state->m_descs, value);
     num_available = (num_available + value) & m_state->m_descs.size_mask;
+
+    if (!ring_doorbell) {
+        const bool is_first_deferred = (0 == m_state->m_pending_doorbell_descs);
+        m_state->m_pending_doorbell_descs += value;
+        if (is_first_deferred) {
+            m_first_deferred_doorbell_time = std::chrono::steady_clock::now();
+            // Without the timer the max latency would only be checked on the next buffer, which an idle stream won't send
+            return start_doorbell_timer();
+        }
+        return HAILO_SUCCESS;
+    }
+
+    // Writing the new num_available also submits all of the deferred descriptors
+    m_state->m_pending_doorbell_descs = 0;
     return set_num_avail_value(static_cast<uint16_t>(num_available));
 }
 
+hailo_status VdmaChannel::ring_doorbell_impl()
+{
+    assert(m_state);
+
+    if (0 == m_state->m_pending_doorbell_descs) {
+        return HAILO_SUCCESS;
+    }
+
+    m_state->m_pending_doorbell_descs = 0;
+    return set_num_avail_value(static_cast<uint16_t>(CB_HEAD(m_state->m_descs)));
+}
+
+bool VdmaChannel::is_doorbell_max_latency_expired()
+{
+    assert(m_state);
+
+    if (0 == m_state->m_pending_doorbell_descs) {
+        // The doorbell will be deferred starting from the current buffer
+        return (std::chrono::microseconds(0) == m_doorbell_max_latency);
+    }
+
+    const auto deferred_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_first_deferred_doorbell_time);
+    return deferred_time >= m_doorbell_max_latency;
+}
+
+hailo_status VdmaChannel::start_doorbell_timer()
+{
+    if (std::chrono::microseconds::max() == m_doorbell_max_latency) {
+        // Deferred doorbells are rung only by the next buffer (the scheduler rings one with the last frame of a burst)
+        return HAILO_SUCCESS;
+    }
+
+    if (nullptr != m_doorbell_timer_thread) {
+        m_doorbell_timer_cv.notify_all();
+        return HAILO_SUCCESS;
+    }
+
+    m_doorbell_timer_thread = make_unique_nothrow<std::thread>([this]() {
+        doorbell_timer_loop();
+    });
+    CHECK_NOT_NULL(m_doorbell_timer_thread, HAILO_OUT_OF_HOST_MEMORY);
+    return HAILO_SUCCESS;
+}
+
+void VdmaChannel::stop_doorbell_timer()
+{
+    if ((nullptr == m_doorbell_timer_thread) || !m_doorbell_timer_thread->joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<State> state_guard(*m_state);
+        m_is_doorbell_timer_stopped = true;
+    }
+    m_doorbell_timer_cv.notify_all();
+    m_doorbell_timer_thread->join();
+}
+
+void VdmaChannel::doorbell_timer_loop()
+{
+    std::unique_lock<State> state_guard(*m_state);
+    while (!m_is_doorbell_timer_stopped) {
+        if (0 == m_state->m_pending_doorbell_descs) {
+            m_doorbell_timer_cv.wait(state_guard);
+            continue;
+        }
+
+        const auto deadline = m_first_deferred_doorbell_time + m_doorbell_max_latency;
+        if (std::chrono::steady_clock::now() < deadline) {
+            m_doorbell_timer_cv.wait_until(state_guard, deadline);
+            continue;
+        }
+
+        auto status = ring_doorbell_impl();
+        if ((HAILO_SUCCESS != status) && (HAILO_STREAM_NOT_ACTIVATED != status)) {
+            LOGGER__ERROR("Failed ringing the deferred doorbell of channel {}, status {}", m_channel_id, status);
+        }
+    }
+}
+
+std::chrono::microseconds VdmaChannel::get_doorbell_max_latency()
+{
+    auto max_latency_env = std::getenv(DOORBELL_MAX_LATENCY_US_ENV_VAR);
+    if (nullptr == max_latency_env) {
+        return std::chrono::microseconds::max();
+    }
+
+    char *end = nullptr;
+    const auto max_latency_us = std::strtoull(max_latency_env, &end, 10);
+    if ((end == max_latency_env) || ('\0' != *end)) {
+        LOGGER__WARNING("Invalid value for {} ('{}'), ignoring it", DOORBELL_MAX_LATENCY_US_ENV_VAR, max_latency_env);
+        return std::chrono::microseconds::max();
+    }
+    return std::chrono::microseconds(max_latency_us);
+}
+
 void VdmaChannel::add_pending_buffer(uint32_t first_desc, uint32_t last_desc)
 {
     assert(m_state);
@@ -1087,7 +1313,7 @@ bool VdmaChannel::is_ready_for_transfer_d2h(size_t buffer_size)
 }
 
 hailo_status VdmaChannel::prepare_descriptors(size_t transfer_size, VdmaInterruptsDomain first_desc_interrupts_domain,
-    VdmaInterruptsDomain last_desc_interrupts_domain)
+    VdmaInterruptsDomain last_desc_interrupts_domain, bool ring_doorbell)
 {
     assert(m_buffer);
     assert(m_state);
@@ -1115,7 +1341,7 @@ hailo_status VdmaChannel::prepare_descriptors(size_t transfer_size, VdmaInterrup
     int last_desc_avail = ((num_available + desc_num - 1) & m_state->m_descs.size_mask);
 
     add_pending_buffer(num_available, last_desc_avail);
-    return inc_num_available(desc_num);
+    return inc_num_available(desc_num, ring_doorbell);
 }
 
 uint32_t VdmaChannel::calculate_descriptors_count(uint32_t buffer_size)
@@ -1220,6 +1446,18 @@ Expected<uint16_t> VdmaChannel::wait_interrupts(std::chrono::milliseconds timeou
 {
     assert(m_state);
 
+    if (HAILO_STREAM_COMPLETION_MODE_BUSY_POLL == m_completion_mode) {
+        auto hw_num_processed = poll_num_processed(m_busy_poll_timeout);
+        if (HAILO_TIMEOUT != hw_num_processed.status()) {
+            return hw_num_processed;
+        }
+        // Nothing was processed while polling - fall back to waiting for an interrupt
+    }
+
+    if (m_transfers_per_host_intr > 1) {
+        return wait_moderated_interrupts(timeout);
+    }
+
     auto irq_data = m_driver.wait_channel_interrupts(m_channel_id, *m_channel_handle, timeout);
     if ((HAILO_STREAM_ABORTED_BY_USER == irq_data.status()) ||
         (HAILO_STREAM_NOT_ACTIVATED == irq_data.status())) {
@@ -1241,6 +1479,64 @@ Expected<uint16_t> VdmaChannel::wait_interrupts(std::chrono::milliseconds timeou
     }
 }
 
+Expected<uint16_t> VdmaChannel::wait_moderated_interrupts(std::chrono::milliseconds timeout)
+{
+    // Not every transfer raises a host interrupt, so we wait for the interrupt in short intervals and check for
+    // transfers that were completed silently between them.
+    const auto max_interrupt_wait = std::min(timeout,
+        std::chrono::milliseconds(HAILO_DEFAULT_INTERRUPT_MODERATION_MAX_WAIT_MS));
+    const auto start_time = std::chrono::steady_clock::now();
+    while (true) {
+        auto irq_data = m_driver.wait_channel_interrupts(m_channel_id, *m_channel_handle, max_interrupt_wait, false);
+        if ((HAILO_STREAM_ABORTED_BY_USER == irq_data.status()) ||
+            (HAILO_STREAM_NOT_ACTIVATED == irq_data.status())) {
+            LOGGER__INFO("Wait channel interrupts was aborted!");
+            return make_unexpected(irq_data.status());
+        }
+        if (HAILO_TIMEOUT != irq_data.status()) {
+            CHECK_EXPECTED(irq_data);
+            return get_hw_num_processed();
+        }
+
+        auto hw_num_processed = poll_num_processed(std::chrono::microseconds(0));
+        if (HAILO_TIMEOUT != hw_num_processed.status()) {
+            return hw_num_processed;
+        }
+
+        const auto time_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        if (time_elapsed >= timeout) {
+            LOGGER__ERROR("Waiting for interrupt for channel {} timed-out", m_channel_id);
+            return make_unexpected(HAILO_TIMEOUT);
+        }
+    }
+}
+
+Expected<uint16_t> VdmaChannel::poll_num_processed(std::chrono::microseconds poll_duration)
+{
+    assert(m_state);
+
+    uint16_t last_num_processed = 0;
+    {
+        std::lock_guard<State> state_guard(*m_state);
+        last_num_processed = static_cast<uint16_t>(CB_TAIL(m_state->m_descs));
+    }
+
+    // Note: the num processed register is read through the driver, since the channel registers aren't mapped
+    // to user space.
+    const auto start_time = std::chrono::steady_clock::now();
+    do {
+        auto hw_num_processed = get_hw_num_processed();
+        CHECK_EXPECTED(hw_num_processed);
+        if (last_num_processed != hw_num_processed.value()) {
+            return hw_num_processed.release();
+        }
+    } while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time) <
+        poll_duration);
+
+    return make_unexpected(HAILO_TIMEOUT);
+}
+
 Expected<uint16_t> VdmaChannel::update_latency_meter(const ChannelInterruptTimestampList &timestamp_list)
 {
     assert(m_state);
@@ -30,6 +30,10 @@
 namespace hailort
 {
 
+// Upper bound (in microseconds) on how long descriptors may wait for their num_available doorbell when submitted
+// with ring_doorbell=false. Setting it to 0 rings the doorbell on every buffer (disables coalescing).
+#define DOORBELL_MAX_LATENCY_US_ENV_VAR "HAILO_DOORBELL_MAX_LATENCY_US"
+
 class VdmaChannel final
 {
 public:
@@ -53,7 +57,11 @@ public:
     hailo_status transfer(void *buf, size_t count);
     // Either write_buffer + send_pending_buffer or transfer (h2d) should be used on a given channel, not both
     hailo_status write_buffer(const MemoryView &buffer, std::chrono::milliseconds timeout, const std::function<bool()> &should_cancel);
-    hailo_status send_pending_buffer();
+    // When ring_doorbell is false, the buffer's descriptors are programmed but the hw num_available register is
+    // updated only on the next call with ring_doorbell=true (so a burst of buffers costs one register write).
+    // Deferred descriptors are also submitted when waiting for free descriptors, on flush, or when they have been
+    // pending for longer than the doorbell max latency.
+    hailo_status send_pending_buffer(bool ring_doorbell = true);
     hailo_status trigger_channel_completion(uint16_t hw_num_processed, const std::function<void(uint32_t)> &callback);
     hailo_status allocate_resources(uint32_t descs_count);
     // Call for boundary channels, after the fw has activted them (via ResourcesManager::enable_state_machine)
@@ -66,6 +74,9 @@ public:
     hailo_status flush(const std::chrono::milliseconds &timeout);
     hailo_status set_num_avail_value(uint16_t new_value);
     hailo_status set_transfers_per_axi_intr(uint16_t transfers_per_axi_intr);
+    // Sets the completion mode (busy-poll/interrupt) and host interrupt moderation of a D2H channel.
+    // Ignored when measuring latency, since the latency meter needs an interrupt (timestamp) per transfer.
+    hailo_status set_d2h_completion_params(const hailo_vdma_output_stream_completion_params_t &completion_params);
     hailo_status inc_num_available_for_ddr(uint16_t value, uint32_t size_mask);
     Expected<uint16_t> get_hw_num_processed_ddr(uint32_t size_mask);
 
@@ -100,6 +111,11 @@ public:
     size_t get_buffer_size() const;
     Expected<size_t> get_h2d_pending_frames_count();
     Expected<size_t> get_d2h_pending_descs_count();
+    // Unlike the counts above, which advance when the completions are handled, these read the hw num processed.
+    // Returns the descriptors programmed to the h2d channel, that the hw didn't process yet.
+    Expected<size_t> get_h2d_hw_pending_descs_count();
+    // Returns the descriptors that the hw processed on the d2h channel, and weren't read yet.
+    Expected<size_t> get_d2h_hw_ready_descs_count();
 
     VdmaChannel(const VdmaChannel &other) = delete;
     VdmaChannel &operator=(const VdmaChannel &other) = delete;
@@ -148,7 +164,11 @@ private:
         // Contains the last num_processed of the last interrupt (only used on latency measurement)
         uint16_t m_last_timestamp_num_processed;
         size_t m_accumulated_transfers;
+        // D2H transfers programmed since the last transfer with a host interrupt (interrupt moderation)
+        size_t m_accumulated_host_transfers;
         bool m_channel_is_active;
+        // Descriptors already added to m_descs (sw num_available) whose hw num_available wasn't written yet
+        uint32_t m_pending_doorbell_descs;
     };
 
     hailo_status register_channel_to_driver();
@@ -163,17 +183,25 @@ private:
     static Direction other_direction(const Direction direction);
     hailo_status transfer_h2d(void *buf, size_t count);
     hailo_status write_buffer_impl(const MemoryView &buffer);
-    hailo_status send_pending_buffer_impl();
+    hailo_status send_pending_buffer_impl(bool ring_doorbell = true);
     uint16_t get_num_available();
     Expected<uint16_t> get_hw_num_processed();
     void add_pending_buffer(uint32_t first_desc, uint32_t last_desc);
-    hailo_status inc_num_available(uint16_t value);
+    hailo_status inc_num_available(uint16_t value, bool ring_doorbell = true);
+    hailo_status ring_doorbell_impl();
+    bool is_doorbell_max_latency_expired();
+    static std::chrono::microseconds get_doorbell_max_latency();
+    // Must be called after acquiring the state lock
+    hailo_status start_doorbell_timer();
+    void stop_doorbell_timer();
+    void doorbell_timer_loop();
     hailo_status transfer_d2h(void *buf, size_t count);
     bool is_ready_for_transfer_h2d(size_t buffer_size);
     bool is_ready_for_transfer_d2h(size_t buffer_size);
     hailo_status prepare_descriptors(size_t transfer_size, VdmaInterruptsDomain first_desc_interrupts_domain,
-        VdmaInterruptsDomain last_desc_interrupts_domain);
+        VdmaInterruptsDomain last_desc_interrupts_domain, bool ring_doorbell = true);
     hailo_status prepare_d2h_pending_descriptors(uint32_t transfer_size);
+    VdmaInterruptsDomain get_d2h_last_desc_interrupts_domain(bool device_interrupt);
     void reset_internal_counters();
     hailo_status wait_for_channel_completion(std::chrono::milliseconds timeout, const std::function<void(uint32_t)> &callback = [](uint32_t) { return; });
 
@@ -188,6 +216,13 @@ private:
      * Returns the new hw num_processed of the irq
      */
     Expected<uint16_t> wait_interrupts(std::chrono::milliseconds timeout);
+    Expected<uint16_t> wait_moderated_interrupts(std::chrono::milliseconds timeout);
+
+    /**
+     * Polls the hw num processed for up to poll_duration (a single read if poll_duration is zero).
+     * Returns the new hw num processed, or HAILO_TIMEOUT if no descriptor was processed since the last completion.
+     */
+    Expected<uint16_t> poll_num_processed(std::chrono::microseconds poll_duration);
 
     /**
      * Returns the new hw num processed. 
@@ -219,6 +254,9 @@ private:
     bool m_channel_enabled;
     
     uint16_t m_transfers_per_axi_intr;
+    hailo_stream_completion_mode_t m_completion_mode;
+    std::chrono::microseconds m_busy_poll_timeout;
+    uint16_t m_transfers_per_host_intr;
     // Using CircularArray because it won't allocate or free memory wile pushing and poping. The fact that it is circural is not relevant here
     CircularArray<size_t> m_pending_buffers_sizes;
     std::atomic_uint16_t m_pending_num_avail_offset;
@@ -226,6 +264,15 @@ private:
     std::condition_variable_any m_can_read_buffer_cv;
     std::atomic_bool m_is_waiting_for_channel_completion;
     std::atomic_bool m_is_aborted_by_internal_source;
+    const std::chrono::microseconds m_doorbell_max_latency;
+    // Time in which the first deferred descriptor was programmed (valid only if m_pending_doorbell_descs > 0)
+    std::chrono::steady_clock::time_point m_first_deferred_doorbell_time;
+    // Rings a deferred doorbell once it has been pending for m_doorbell_max_latency, so descriptors of a stream that
+    // went idle are submitted without waiting for the next buffer. Started with the first deferred doorbell (only if
+    // the max latency is bounded). m_doorbell_timer_cv and m_is_doorbell_timer_stopped are guarded by the state lock.
+    std::unique_ptr<std::thread> m_doorbell_timer_thread;
+    std::condition_variable_any m_doorbell_timer_cv;
+    bool m_is_doorbell_timer_stopped;
 };
 
 } /* namespace hailort */
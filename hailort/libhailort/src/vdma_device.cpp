@@ -218,7 +218,7 @@ Expected<std::shared_ptr<ConfiguredNetworkGroup>> VdmaDevice::create_configured_
 
     /* build HEF supported features */
     auto resource_manager = ResourcesManagerBuilder::build(network_group_index,
-        *this, get_driver(), config_params, network_group_metadata, hef.pimpl->get_device_arch());
+        *this, get_driver(), config_params, network_group_metadata, hef.pimpl->get_device_arch(), hef.hash());
     CHECK_EXPECTED(resource_manager);
 
     auto net_flow_ops = hef.pimpl->post_process_ops(network_group_metadata->network_group_name());
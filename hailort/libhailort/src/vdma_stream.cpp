@@ -13,6 +13,11 @@
 namespace hailort
 {
 
+static size_t get_descs_per_frame(size_t frame_size, size_t page_size)
+{
+    return (0 == (frame_size % page_size)) ? (frame_size / page_size) : ((frame_size / page_size) + 1);
+}
+
 Expected<std::unique_ptr<VdmaInputStream>> VdmaInputStream::create(VdmaDevice &device,
     std::shared_ptr<VdmaChannel> channel, const LayerInfo &edge_layer, uint16_t batch_size, 
     EventPtr network_group_activated_event)
@@ -176,7 +181,7 @@ hailo_status VdmaInputStream::write_buffer_only(const MemoryView &buffer,
     return m_channel->write_buffer(buffer, m_channel_timeout, should_cancel);
 }
 
-hailo_status VdmaInputStream::send_pending_buffer(size_t device_index)
+hailo_status VdmaInputStream::send_pending_buffer(size_t device_index, bool ring_doorbell)
 {
     std::unique_lock<std::mutex> lock(m_send_pending_mutex);
     CHECK(0 == device_index, HAILO_INVALID_OPERATION);
@@ -188,7 +193,7 @@ hailo_status VdmaInputStream::send_pending_buffer(size_t device_index)
         "{} (H2D) failed with status={} (timeout={}ms)", name(), HAILO_TIMEOUT, m_channel_timeout.count());
     CHECK_SUCCESS(status);
 
-    return m_channel->send_pending_buffer();
+    return m_channel->send_pending_buffer(ring_doorbell);
 }
 
 uint16_t VdmaInputStream::get_dynamic_batch_size() const
@@ -221,6 +226,16 @@ Expected<size_t> VdmaInputStream::get_pending_frames_count() const
     return m_channel->get_h2d_pending_frames_count();
 }
 
+Expected<size_t> VdmaInputStream::get_hw_pending_frames_count() const
+{
+    auto pending_descs_count = m_channel->get_h2d_hw_pending_descs_count();
+    CHECK_EXPECTED(pending_descs_count);
+
+    // A frame that the hw started processing is still pending
+    const auto descs_per_frame = get_descs_per_frame(m_stream_info.hw_frame_size, m_channel->get_page_size());
+    return (pending_descs_count.value() + descs_per_frame - 1) / descs_per_frame;
+}
+
 hailo_status VdmaInputStream::sync_write_all_raw_buffer_no_transform_impl(void *buffer, size_t offset, size_t size)
 {
     ASSERT(NULL != buffer);
@@ -488,11 +503,20 @@ Expected<size_t> VdmaOutputStream::get_pending_frames_count() const
     auto pending_descs_count = m_channel->get_d2h_pending_descs_count();
     CHECK_EXPECTED(pending_descs_count);
 
-    auto channel_page_size = m_channel->get_page_size();
-    uint32_t descs_per_frame = (0 == (m_stream_info.hw_frame_size % channel_page_size)) ? (m_stream_info.hw_frame_size / channel_page_size) :
-        ((m_stream_info.hw_frame_size / channel_page_size) + 1);
+    const auto descs_per_frame = get_descs_per_frame(m_stream_info.hw_frame_size, m_channel->get_page_size());
+    return static_cast<size_t>(pending_descs_count.value() / descs_per_frame);
+}
+
+Expected<size_t> VdmaOutputStream::get_hw_ready_frames_count() const
+{
+    // The frames of NMS have variable sizes (see get_pending_frames_count)
+    CHECK_AS_EXPECTED(HAILO_FORMAT_ORDER_HAILO_NMS != m_stream_info.format.order, HAILO_NOT_AVAILABLE);
+
+    auto ready_descs_count = m_channel->get_d2h_hw_ready_descs_count();
+    CHECK_EXPECTED(ready_descs_count);
 
-    return static_cast<size_t>(std::floor(pending_descs_count.value() / descs_per_frame));
+    const auto descs_per_frame = get_descs_per_frame(m_stream_info.hw_frame_size, m_channel->get_page_size());
+    return static_cast<size_t>(ready_descs_count.value() / descs_per_frame);
 }
 
 } /* namespace hailort */
@@ -35,12 +35,14 @@ public:
     virtual hailo_status clear_abort() override;
     virtual hailo_status flush() override;
     hailo_status write_buffer_only(const MemoryView &buffer, const std::function<bool()> &should_cancel = []() { return false; });
-    hailo_status send_pending_buffer(size_t device_index = 0);
+    hailo_status send_pending_buffer(size_t device_index = 0, bool ring_doorbell = true);
     uint16_t get_dynamic_batch_size() const;
     const char* get_dev_id() const;
     Expected<VdmaChannel::BufferState> get_buffer_state();
     virtual Expected<size_t> get_buffer_frames_size() const override;
     virtual Expected<size_t> get_pending_frames_count() const override;
+    // The frames written to the channel that the hw didn't process yet
+    Expected<size_t> get_hw_pending_frames_count() const;
 
     // To be used for debugging purposes
     hailo_status sync_channel_state();
@@ -96,6 +98,8 @@ public:
     Expected<VdmaChannel::BufferState> get_buffer_state();
     virtual Expected<size_t> get_buffer_frames_size() const override;
     virtual Expected<size_t> get_pending_frames_count() const override;
+    // The frames the hw processed, that weren't read yet (not available for NMS)
+    Expected<size_t> get_hw_ready_frames_count() const;
 
     virtual hailo_status register_for_d2h_interrupts(const std::function<void(uint32_t)> &callback);
 
@@ -10,12 +10,15 @@
 #include "hailo/vstream.hpp"
 #include "hailort_defaults.hpp"
 #include "vstream_internal.hpp"
+#include "event_internal.hpp"
+#include "transform_internal.hpp"
 #include "common/runtime_statistics_internal.hpp"
 
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
 #include "rpc/rpc_definitions.hpp"
 #endif // HAILO_SUPPORT_MULTI_PROCESS
 
+#include <atomic>
 #include <unordered_set>
 
 namespace hailort
@@ -84,6 +87,11 @@ std::vector<AccumulatorPtr> PreInferElement::get_queue_size_accumulators()
     return {m_pool->get_queue_size_accumulator()};
 }
 
+BufferPoolPtr PreInferElement::get_buffer_pool() const
+{
+    return m_pool;
+}
+
 PipelinePad &PreInferElement::next_pad()
 {
     // Note: The next elem to be run is downstream from this elem (i.e. buffers are pushed)
@@ -112,17 +120,117 @@ Expected<PipelineBuffer> PreInferElement::action(PipelineBuffer &&input, Pipelin
     CHECK_EXPECTED(transformed_buffer);
 
     auto dst = transformed_buffer->as_view();
+    auto metadata = input.get_metadata();
+    const auto *src_layout = metadata.get_frame_layout();
     m_duration_collector.start_measurement();
-    const auto status = m_transform_context->transform(input.as_view(), dst);
+    const auto status = (nullptr != src_layout) ? m_transform_context->transform(input.as_view(), *src_layout, dst) :
+        m_transform_context->transform(input.as_view(), dst);
     m_duration_collector.complete_measurement();
     CHECK_SUCCESS_AS_EXPECTED(status);
 
     // Note: The latency to be measured starts as the input buffer is sent to the InputVStream (via write())
-    transformed_buffer->set_metadata(input.get_metadata());
+    //       The transformed buffer is packed, so the frame layout isn't passed on
+    metadata.clear_frame_layout();
+    transformed_buffer->set_metadata(std::move(metadata));
 
     return transformed_buffer.release();
 }
 
+Expected<std::shared_ptr<PreprocessElement>> PreprocessElement::create(const hailo_3d_image_shape_t &src_image_shape,
+    const hailo_format_t &src_format, const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format,
+    const hailo_quant_info_t &dst_quant_info, const std::string &name, const hailo_vstream_params_t &vstream_params,
+    EventPtr shutdown_event, std::shared_ptr<std::atomic<hailo_status>> pipeline_status)
+{
+    auto preprocessor = FramePreprocessor::create(vstream_params.preprocess_params, src_image_shape, src_format,
+        dst_image_shape, dst_format, dst_quant_info);
+    CHECK_EXPECTED(preprocessor, "Failed Creating FramePreprocessor");
+
+    auto buffer_pool = BufferPool::create(preprocessor.value()->get_dst_frame_size(), vstream_params.queue_size, shutdown_event,
+        vstream_params.pipeline_elements_stats_flags, vstream_params.vstream_stats_flags);
+    CHECK_EXPECTED(buffer_pool, "Failed creating BufferPool for {}", name);
+
+    auto duration_collector = DurationCollector::create(vstream_params.pipeline_elements_stats_flags);
+    CHECK_EXPECTED(duration_collector);
+
+    auto preprocess_elem_ptr = make_shared_nothrow<PreprocessElement>(preprocessor.release(), buffer_pool.release(), name,
+        std::chrono::milliseconds(vstream_params.timeout_ms), duration_collector.release(), std::move(pipeline_status));
+    CHECK_AS_EXPECTED(nullptr != preprocess_elem_ptr, HAILO_OUT_OF_HOST_MEMORY);
+
+    LOGGER__INFO("Created {}", preprocess_elem_ptr->name());
+
+    return preprocess_elem_ptr;
+}
+
+PreprocessElement::PreprocessElement(std::unique_ptr<FramePreprocessor> &&preprocessor, BufferPoolPtr buffer_pool,
+                                     const std::string &name, std::chrono::milliseconds timeout, DurationCollector &&duration_collector,
+                                     std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status) :
+    FilterElement(name, std::move(duration_collector), std::move(pipeline_status)),
+    m_preprocessor(std::move(preprocessor)),
+    m_pool(buffer_pool),
+    m_timeout(timeout)
+{}
+
+Expected<PipelineBuffer> PreprocessElement::run_pull(PipelineBuffer &&/*optional*/, const PipelinePad &/*source*/)
+{
+    LOGGER__ERROR("PreprocessElement does not support run_pull operation");
+    return make_unexpected(HAILO_INVALID_OPERATION);
+}
+
+std::vector<AccumulatorPtr> PreprocessElement::get_queue_size_accumulators()
+{
+    if (nullptr == m_pool->get_queue_size_accumulator()) {
+        return std::vector<AccumulatorPtr>();
+    }
+    return {m_pool->get_queue_size_accumulator()};
+}
+
+BufferPoolPtr PreprocessElement::get_buffer_pool() const
+{
+    return m_pool;
+}
+
+PipelinePad &PreprocessElement::next_pad()
+{
+    // Note: The next elem to be run is downstream from this elem (i.e. buffers are pushed)
+    return *m_sources[0].next();
+}
+
+std::string PreprocessElement::description() const
+{
+    std::stringstream element_description;
+    element_description << "(" << this->name() << " | " << m_preprocessor->description() << ")";
+    return element_description.str();
+}
+
+Expected<PipelineBuffer> PreprocessElement::action(PipelineBuffer &&input, PipelineBuffer &&optional)
+{
+    if (PipelineBuffer::Type::FLUSH == input.get_type()) {
+        return std::move(input);
+    }
+
+    auto metadata = input.get_metadata();
+    CHECK_AS_EXPECTED(nullptr == metadata.get_frame_layout(), HAILO_NOT_SUPPORTED,
+        "Frame layouts are not supported with preprocessing ({})", name());
+
+    auto preprocessed_buffer = m_pool->get_available_buffer(std::move(optional), m_timeout);
+    if (HAILO_SHUTDOWN_EVENT_SIGNALED == preprocessed_buffer.status()) {
+        return make_unexpected(preprocessed_buffer.status());
+    }
+    CHECK_AS_EXPECTED(HAILO_TIMEOUT != preprocessed_buffer.status(), HAILO_TIMEOUT,
+        "{} (H2D) failed with status={} (timeout={}ms)", name(), HAILO_TIMEOUT, m_timeout.count());
+    CHECK_EXPECTED(preprocessed_buffer);
+
+    m_duration_collector.start_measurement();
+    const auto status = m_preprocessor->process(input.as_view(), preprocessed_buffer->as_view());
+    m_duration_collector.complete_measurement();
+    CHECK_SUCCESS_AS_EXPECTED(status);
+
+    // Note: The latency to be measured starts as the input buffer is sent to the InputVStream (via write())
+    preprocessed_buffer->set_metadata(std::move(metadata));
+
+    return preprocessed_buffer.release();
+}
+
 Expected<std::shared_ptr<PostInferElement>> PostInferElement::create(const hailo_3d_image_shape_t &src_image_shape,
     const hailo_format_t &src_format, const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format,
     const hailo_quant_info_t &dst_quant_info, const hailo_nms_info_t &nms_info, const std::string &name,
@@ -384,75 +492,189 @@ Expected<PipelineBuffer> NmsMuxElement::action(std::vector<PipelineBuffer> &&inp
 }
 
 Expected<std::shared_ptr<TransformDemuxElement>> TransformDemuxElement::create(std::shared_ptr<OutputDemuxer> demuxer,
-    const std::string &name, std::chrono::milliseconds timeout, size_t buffer_pool_size, hailo_pipeline_elem_stats_flags_t elem_flags,
-    hailo_vstream_stats_flags_t vstream_flags, EventPtr shutdown_event, std::shared_ptr<std::atomic<hailo_status>> pipeline_status)
+    const std::string &name, std::chrono::milliseconds timeout, hailo_pipeline_elem_stats_flags_t elem_flags,
+    std::shared_ptr<std::atomic<hailo_status>> pipeline_status)
 {
-    std::vector<BufferPoolPtr> pools;
-    pools.reserve(demuxer->get_edges_stream_info().size());
-
-    for (const auto& mux_edge : demuxer->get_edges_stream_info()) {
-        auto buffer_pool = BufferPool::create(mux_edge.hw_frame_size, buffer_pool_size, shutdown_event, elem_flags, vstream_flags);
-        CHECK_EXPECTED(buffer_pool, "Failed creating BufferPool");
-        pools.push_back(buffer_pool.release());
-    }
-
     auto duration_collector = DurationCollector::create(elem_flags);
     CHECK_EXPECTED(duration_collector);
 
-    auto demux_elem_ptr = make_shared_nothrow<TransformDemuxElement>(demuxer, std::move(pools), name, timeout,
+    auto demux_elem_ptr = make_shared_nothrow<TransformDemuxElement>(demuxer, name, timeout,
         duration_collector.release(), std::move(pipeline_status));
     CHECK_AS_EXPECTED(nullptr != demux_elem_ptr, HAILO_OUT_OF_HOST_MEMORY);
 
     return demux_elem_ptr;
 }
 
-TransformDemuxElement::TransformDemuxElement(std::shared_ptr<OutputDemuxer> demuxer, std::vector<BufferPoolPtr> &&pools,
-                                             const std::string &name, std::chrono::milliseconds timeout,
-                                             DurationCollector &&duration_collector,
+TransformDemuxElement::TransformDemuxElement(std::shared_ptr<OutputDemuxer> demuxer, const std::string &name,
+                                             std::chrono::milliseconds timeout, DurationCollector &&duration_collector,
                                              std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status) :
     BaseDemuxElement(demuxer->get_edges_stream_info().size(), name, timeout, std::move(duration_collector),
                      std::move(pipeline_status)),
+    m_demuxer(demuxer)
+{}
+
+Expected<std::vector<PipelineBuffer>> TransformDemuxElement::action(PipelineBuffer &&input)
+{
+    const auto edges_count = m_demuxer->get_edges_stream_info().size();
+    std::vector<PipelineBuffer> outputs;
+    outputs.reserve(edges_count);
+
+    // The muxed frame is returned to the HwReadElement's pool once all of the edges were demuxed from it
+    m_duration_collector.start_measurement();
+    auto shared_input = make_shared_nothrow<PipelineBuffer>(std::move(input));
+    CHECK_AS_EXPECTED(nullptr != shared_input, HAILO_OUT_OF_HOST_MEMORY);
+    for (size_t i = 0; i < edges_count; i++) {
+        outputs.emplace_back(shared_input->as_view(), shared_input);
+    }
+    m_duration_collector.complete_measurement();
+
+    return outputs;
+}
+
+Expected<std::shared_ptr<DemuxEdgeElement>> DemuxEdgeElement::create(std::shared_ptr<OutputDemuxerBase> demuxer, size_t edge_index,
+    const std::string &name, std::chrono::milliseconds timeout, size_t buffer_pool_size, hailo_pipeline_elem_stats_flags_t elem_flags,
+    hailo_vstream_stats_flags_t vstream_flags, EventPtr shutdown_event, std::shared_ptr<std::atomic<hailo_status>> pipeline_status)
+{
+    const auto edges_infos = demuxer->get_edges_stream_info();
+    CHECK_AS_EXPECTED(edge_index < edges_infos.size(), HAILO_INVALID_ARGUMENT, "Invalid edge index {} for {}", edge_index, name);
+
+    BufferPoolPtr buffer_pool = nullptr;
+    if (0 < buffer_pool_size) {
+        auto expected_buffer_pool = BufferPool::create(edges_infos[edge_index].hw_frame_size, buffer_pool_size, shutdown_event,
+            elem_flags, vstream_flags);
+        CHECK_EXPECTED(expected_buffer_pool, "Failed creating BufferPool for {}", name);
+        buffer_pool = expected_buffer_pool.release();
+    }
+
+    auto duration_collector = DurationCollector::create(elem_flags);
+    CHECK_EXPECTED(duration_collector);
+
+    auto demux_edge_elem_ptr = make_shared_nothrow<DemuxEdgeElement>(demuxer, edge_index, buffer_pool, name, timeout,
+        duration_collector.release(), std::move(pipeline_status));
+    CHECK_AS_EXPECTED(nullptr != demux_edge_elem_ptr, HAILO_OUT_OF_HOST_MEMORY);
+
+    LOGGER__INFO("Created {}", demux_edge_elem_ptr->name());
+
+    return demux_edge_elem_ptr;
+}
+
+DemuxEdgeElement::DemuxEdgeElement(std::shared_ptr<OutputDemuxerBase> demuxer, size_t edge_index, BufferPoolPtr buffer_pool,
+                                   const std::string &name, std::chrono::milliseconds timeout, DurationCollector &&duration_collector,
+                                   std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status) :
+    FilterElement(name, std::move(duration_collector), std::move(pipeline_status)),
     m_demuxer(demuxer),
-    m_pools(std::move(pools))
+    m_edge_index(edge_index),
+    m_pool(buffer_pool),
+    m_timeout(timeout)
 {}
 
-std::vector<AccumulatorPtr> TransformDemuxElement::get_queue_size_accumulators()
+hailo_status DemuxEdgeElement::run_push(PipelineBuffer &&/*buffer*/)
 {
-    std::vector<AccumulatorPtr> result;
-    for (const auto& pool : m_pools) {
-        if (nullptr != pool->get_queue_size_accumulator()) {
-            result.emplace_back(pool->get_queue_size_accumulator());
-        }
+    LOGGER__ERROR("DemuxEdgeElement does not support run_push operation");
+    return HAILO_INVALID_OPERATION;
+}
+
+std::vector<AccumulatorPtr> DemuxEdgeElement::get_queue_size_accumulators()
+{
+    if ((nullptr == m_pool) || (nullptr == m_pool->get_queue_size_accumulator())) {
+        return std::vector<AccumulatorPtr>();
     }
-    return result;
+    return {m_pool->get_queue_size_accumulator()};
 }
 
-Expected<std::vector<PipelineBuffer>> TransformDemuxElement::action(PipelineBuffer &&input)
+PipelinePad &DemuxEdgeElement::next_pad()
 {
-    std::vector<PipelineBuffer> outputs;
-    std::vector<MemoryView> raw_buffers;
+    // Note: The next elem to be run is upstream from this elem (i.e. buffers are pulled)
+    return *m_sinks[0].prev();
+}
 
-    auto mux_edges = m_demuxer->get_edges_stream_info();
-    outputs.reserve(mux_edges.size());
-    raw_buffers.reserve(mux_edges.size());
+Expected<PipelineBuffer> DemuxEdgeElement::action(PipelineBuffer &&input, PipelineBuffer &&optional)
+{
+    CHECK_AS_EXPECTED(optional || (nullptr != m_pool), HAILO_INVALID_ARGUMENT, "Optional buffer must be passed to {}!", name());
 
-    for (uint32_t i = 0; i < mux_edges.size(); i++) {
-        auto acquired_buffer = m_pools[i]->acquire_buffer(m_timeout);
-        if (HAILO_SHUTDOWN_EVENT_SIGNALED == acquired_buffer.status()) {
-            return make_unexpected(acquired_buffer.status());
-        }
-        CHECK_EXPECTED(acquired_buffer, "Failed to acquire buffer");
-        outputs.emplace_back(acquired_buffer.release());
-        
-        raw_buffers.push_back(outputs.back().as_view());
+    auto demuxed_buffer = optional ? Expected<PipelineBuffer>(std::move(optional)) :
+        m_pool->get_available_buffer(PipelineBuffer(), m_timeout);
+    if (HAILO_SHUTDOWN_EVENT_SIGNALED == demuxed_buffer.status()) {
+        return make_unexpected(demuxed_buffer.status());
     }
+    CHECK_AS_EXPECTED(HAILO_TIMEOUT != demuxed_buffer.status(), HAILO_TIMEOUT,
+        "{} failed with status={} (timeout={}ms)", name(), HAILO_TIMEOUT, m_timeout.count());
+    CHECK_EXPECTED(demuxed_buffer);
+
+    // Note: The latency to be measured starts as the muxed frame is read from the HW (it's 'input' in this case)
+    demuxed_buffer->set_metadata(input.get_metadata());
 
     m_duration_collector.start_measurement();
-    const auto status = m_demuxer->transform_demux(input.as_view(), raw_buffers);
+    const auto status = m_demuxer->transform_demux_edge(input.as_view(), m_edge_index, demuxed_buffer->as_view());
     m_duration_collector.complete_measurement();
     CHECK_SUCCESS_AS_EXPECTED(status);
 
-    return outputs;
+    return demuxed_buffer.release();
+}
+
+std::shared_ptr<VStreamMetrics> VStreamMetrics::create(const hailo_vstream_info_t &vstream_info,
+    const std::vector<std::shared_ptr<PipelineElement>> &pipeline, bool measure_latency)
+{
+    auto &registry = MetricsRegistry::get_instance();
+    const MetricLabels labels = {{"network", vstream_info.network_name}, {"vstream", vstream_info.name}};
+
+    auto frames = registry.get_counter("hailort_vstream_frames", "Frames transferred through the vstream", labels);
+    if (!frames) {
+        LOGGER__WARNING("Failed to create metrics for vstream {} (status {})", vstream_info.name, frames.status());
+        return nullptr;
+    }
+
+    std::shared_ptr<MetricHistogram> latency;
+    if (measure_latency) {
+        auto latency_exp = registry.get_histogram("hailort_vstream_pipeline_latency_seconds",
+            "Latency of frames through the vstream pipeline", labels);
+        if (!latency_exp) {
+            LOGGER__WARNING("Failed to create metrics for vstream {} (status {})", vstream_info.name, latency_exp.status());
+            return nullptr;
+        }
+        latency = latency_exp.release();
+    }
+
+    std::vector<std::pair<std::weak_ptr<BaseQueueElement>, std::shared_ptr<MetricGauge>>> queue_sizes;
+    for (const auto &element : pipeline) {
+        auto queue = std::dynamic_pointer_cast<BaseQueueElement>(element);
+        if (nullptr == queue) {
+            continue;
+        }
+        auto queue_labels = labels;
+        queue_labels["element"] = queue->name();
+        auto gauge = registry.get_gauge("hailort_vstream_queue_size", "Buffers waiting in a pipeline queue", queue_labels);
+        if (!gauge) {
+            LOGGER__WARNING("Failed to create metrics for vstream {} (status {})", vstream_info.name, gauge.status());
+            return nullptr;
+        }
+        queue_sizes.emplace_back(queue, gauge.release());
+    }
+
+    auto metrics = make_shared_nothrow<VStreamMetrics>(frames.release(), std::move(latency), std::move(queue_sizes));
+    if (nullptr == metrics) {
+        LOGGER__WARNING("Failed to create metrics for vstream {}", vstream_info.name);
+        return nullptr;
+    }
+    registry.add_collector(metrics);
+    return metrics;
+}
+
+VStreamMetrics::VStreamMetrics(std::shared_ptr<MetricCounter> &&frames, std::shared_ptr<MetricHistogram> &&latency,
+    std::vector<std::pair<std::weak_ptr<BaseQueueElement>, std::shared_ptr<MetricGauge>>> &&queue_sizes) :
+    m_frames(std::move(frames)),
+    m_latency(std::move(latency)),
+    m_queue_sizes(std::move(queue_sizes))
+{}
+
+void VStreamMetrics::collect()
+{
+    for (auto &queue_size : m_queue_sizes) {
+        auto queue = queue_size.first.lock();
+        if (nullptr != queue) {
+            queue_size.second->set(static_cast<double>(queue->queue_size_approx()));
+        }
+    }
 }
 
 BaseVStream::BaseVStream(const hailo_vstream_info_t &vstream_info, const hailo_vstream_params_t &vstream_params,
@@ -473,7 +695,8 @@ BaseVStream::BaseVStream(const hailo_vstream_info_t &vstream_info, const hailo_v
     m_fps_accumulators(get_pipeline_accumulators_by_type(m_pipeline, AccumulatorType::FPS)),
     m_latency_accumulators(get_pipeline_accumulators_by_type(m_pipeline, AccumulatorType::LATENCY)),
     m_queue_size_accumulators(get_pipeline_queue_size_accumulators(m_pipeline)),
-    m_pipeline_latency_accumulator(pipeline_latency_accumulator)
+    m_pipeline_latency_accumulator(pipeline_latency_accumulator),
+    m_metrics(VStreamMetrics::create(vstream_info, m_pipeline, m_measure_pipeline_latency))
 {
     output_status = start_vstream();
 }
@@ -492,7 +715,8 @@ BaseVStream::BaseVStream(BaseVStream &&other) noexcept :
     m_fps_accumulators(std::move(other.m_fps_accumulators)),
     m_latency_accumulators(std::move(other.m_latency_accumulators)),
     m_queue_size_accumulators(std::move(other.m_queue_size_accumulators)),
-    m_pipeline_latency_accumulator(std::move(other.m_pipeline_latency_accumulator))
+    m_pipeline_latency_accumulator(std::move(other.m_pipeline_latency_accumulator)),
+    m_metrics(std::move(other.m_metrics))
 {}
 
 BaseVStream& BaseVStream::operator=(BaseVStream &&other) noexcept
@@ -514,6 +738,7 @@ BaseVStream& BaseVStream::operator=(BaseVStream &&other) noexcept
         m_latency_accumulators = std::move(other.m_latency_accumulators);
         m_queue_size_accumulators = std::move(other.m_queue_size_accumulators);
         m_pipeline_latency_accumulator = std::move(other.m_pipeline_latency_accumulator);
+        m_metrics = std::move(other.m_metrics);
     }
     return *this;
 }
@@ -586,8 +811,54 @@ hailo_status BaseVStream::stop_and_clear()
     return HAILO_SUCCESS;
 }
 
+EventPtr BaseVStream::get_shutdown_event() const
+{
+    return m_shutdown_event;
+}
+
+// Waits on the readiness events of the given vstreams, together with their shutdown events (so that a vstream
+// that was aborted or failed won't be waited on forever). Returns the index of the vstream that woke us up.
+static Expected<size_t> wait_for_any_vstream(const std::vector<EventPtr> &readiness_events,
+    const std::vector<EventPtr> &shutdown_events, std::chrono::milliseconds timeout)
+{
+    assert(readiness_events.size() == shutdown_events.size());
+    // The first ready event is returned, so the events are added starting at a different vstream on every call.
+    // Otherwise, a vstream that is always ready would starve the vstreams after it.
+    static std::atomic<size_t> next_first_vstream_index(0);
+    const auto first_vstream_index = next_first_vstream_index++ % readiness_events.size();
+
+    std::vector<EventPtr> events;
+    std::vector<size_t> vstream_indices;
+    std::unordered_set<Event*> added_events;
+    for (size_t j = 0; j < readiness_events.size(); j++) {
+        const auto i = (first_vstream_index + j) % readiness_events.size();
+        // Shutdown events may be shared between vstreams, and the same event can't be waited on twice (on windows)
+        for (const auto &event : { readiness_events[i], shutdown_events[i] }) {
+            if ((nullptr == event) || !added_events.insert(event.get()).second) {
+                continue;
+            }
+            events.push_back(event);
+            vstream_indices.push_back(i);
+        }
+    }
+
+    auto event_index = wait_for_any_event(events, timeout);
+    if (HAILO_TIMEOUT == event_index.status()) {
+        return make_unexpected(HAILO_TIMEOUT);
+    }
+    CHECK_EXPECTED(event_index);
+
+    return Expected<size_t>(vstream_indices[event_index.value()]);
+}
+
 size_t BaseVStream::get_frame_size() const
 {
+    if ((HAILO_H2D_STREAM == m_vstream_info.direction) && FramePreprocessor::is_enabled(m_vstream_params.preprocess_params)) {
+        // The camera frame size, validated when the vstream was created
+        auto src_frame_size = FramePreprocessor::get_src_frame_size(m_vstream_params.preprocess_params);
+        assert(src_frame_size);
+        return src_frame_size.value();
+    }
     if (HAILO_FORMAT_ORDER_HAILO_NMS == m_vstream_info.format.order) {
         return HailoRTCommon::get_nms_host_frame_size(m_vstream_info.nms_shape, m_vstream_params.user_buffer_format);
     }
@@ -659,11 +930,43 @@ hailo_status InputVStream::write(const MemoryView &buffer)
     return m_vstream->write(std::move(buffer));
 }
 
+hailo_status InputVStream::write(const MemoryView &buffer, const hailo_frame_layout_t &layout)
+{
+    return m_vstream->write(buffer, layout);
+}
+
+hailo_status InputVStream::try_write(const MemoryView &buffer)
+{
+    return m_vstream->try_write(buffer);
+}
+
 hailo_status InputVStream::flush()
 {
     return m_vstream->flush();
 }
 
+Expected<EventPtr> InputVStream::get_readiness_event()
+{
+    return m_vstream->get_readiness_event();
+}
+
+Expected<size_t> InputVStream::wait_for_any(std::vector<std::reference_wrapper<InputVStream>> &vstreams,
+    std::chrono::milliseconds timeout)
+{
+    CHECK_AS_EXPECTED(!vstreams.empty(), HAILO_INVALID_ARGUMENT, "No vstreams to wait on");
+
+    std::vector<EventPtr> readiness_events;
+    std::vector<EventPtr> shutdown_events;
+    for (auto &vstream : vstreams) {
+        auto readiness_event = vstream.get().get_readiness_event();
+        CHECK_EXPECTED(readiness_event);
+        readiness_events.emplace_back(readiness_event.release());
+        shutdown_events.emplace_back(vstream.get().m_vstream->get_shutdown_event());
+    }
+
+    return wait_for_any_vstream(readiness_events, shutdown_events, timeout);
+}
+
 hailo_status InputVStream::clear(std::vector<InputVStream> &vstreams)
 {
     for (auto &vstream : vstreams) {
@@ -793,6 +1096,33 @@ hailo_status OutputVStream::read(MemoryView buffer)
     return m_vstream->read(std::move(buffer));
 }
 
+hailo_status OutputVStream::try_read(MemoryView buffer)
+{
+    return m_vstream->try_read(std::move(buffer));
+}
+
+Expected<EventPtr> OutputVStream::get_readiness_event()
+{
+    return m_vstream->get_readiness_event();
+}
+
+Expected<size_t> OutputVStream::wait_for_any(std::vector<std::reference_wrapper<OutputVStream>> &vstreams,
+    std::chrono::milliseconds timeout)
+{
+    CHECK_AS_EXPECTED(!vstreams.empty(), HAILO_INVALID_ARGUMENT, "No vstreams to wait on");
+
+    std::vector<EventPtr> readiness_events;
+    std::vector<EventPtr> shutdown_events;
+    for (auto &vstream : vstreams) {
+        auto readiness_event = vstream.get().get_readiness_event();
+        CHECK_EXPECTED(readiness_event);
+        readiness_events.emplace_back(readiness_event.release());
+        shutdown_events.emplace_back(vstream.get().m_vstream->get_shutdown_event());
+    }
+
+    return wait_for_any_vstream(readiness_events, shutdown_events, timeout);
+}
+
 hailo_status OutputVStream::clear(std::vector<OutputVStream> &vstreams)
 {
     for (auto &vstream : vstreams) {
@@ -976,31 +1306,78 @@ Expected<std::shared_ptr<InputVStreamImpl>> InputVStreamImpl::create(const hailo
 {
     hailo_status status = HAILO_UNINITIALIZED;
 
+    auto vstream_ptr = std::shared_ptr<InputVStreamImpl>(new InputVStreamImpl(vstream_info, vstream_params, std::move(pipeline_entry), std::move(pipeline),
+        std::move(pipeline_status), shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), status));
+    CHECK_SUCCESS_AS_EXPECTED(status, "Failed to create virtual stream");
+
     if (nullptr != pipeline_latency_accumulator) {
-        pipeline_exit->sink().set_push_complete_callback([pipeline_latency_accumulator](const PipelineBuffer::Metadata& metadata) {
+        auto metrics = vstream_ptr->m_metrics;
+        pipeline_exit->sink().set_push_complete_callback([pipeline_latency_accumulator, metrics](const PipelineBuffer::Metadata& metadata) {
                 const auto duration_sec = std::chrono::duration_cast<std::chrono::duration<double>>(
                     std::chrono::steady_clock::now() - metadata.get_start_time()).count();
                 pipeline_latency_accumulator->add_data_point(duration_sec);
+                if (nullptr != metrics) {
+                    metrics->add_latency(duration_sec);
+                }
             });
     }
 
-    auto vstream_ptr = std::shared_ptr<InputVStreamImpl>(new InputVStreamImpl(vstream_info, vstream_params, std::move(pipeline_entry), std::move(pipeline),
-        std::move(pipeline_status), shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), status));
-    CHECK_SUCCESS_AS_EXPECTED(status, "Failed to create virtual stream");
-
     return vstream_ptr;
 }
 
+// Returns the queue element that the input pipeline blocks on when the device doesn't keep up (nullptr if there is none)
+static BaseQueueElement *find_input_readiness_queue(std::shared_ptr<PipelineElement> pipeline_entry)
+{
+    PipelineElement *element = pipeline_entry.get();
+    while (nullptr != element) {
+        auto queue = dynamic_cast<PushQueueElement*>(element);
+        if (nullptr != queue) {
+            return queue;
+        }
+        if ((1 != element->sources().size()) || (nullptr == element->sources()[0].next())) {
+            break;
+        }
+        element = &element->sources()[0].next()->element();
+    }
+    return nullptr;
+}
+
+// Returns the queue element that the output pipeline blocks on while no frame was read from the device (nullptr if there is none)
+static BaseQueueElement *find_output_readiness_queue(std::shared_ptr<PipelineElement> pipeline_entry)
+{
+    PipelineElement *element = pipeline_entry.get();
+    while (nullptr != element) {
+        auto queue = dynamic_cast<PullQueueElement*>(element);
+        // The entry's UserBufferQueueElement holds the user buffers, not the device's frames
+        if ((nullptr != queue) && (nullptr == dynamic_cast<UserBufferQueueElement*>(element))) {
+            return queue;
+        }
+        if ((1 != element->sinks().size()) || (nullptr == element->sinks()[0].prev())) {
+            break;
+        }
+        element = &element->sinks()[0].prev()->element();
+    }
+    return nullptr;
+}
+
 InputVStreamImpl::InputVStreamImpl(const hailo_vstream_info_t &vstream_info, const hailo_vstream_params_t &vstream_params,
     std::shared_ptr<PipelineElement> pipeline_entry, std::vector<std::shared_ptr<PipelineElement>> &&pipeline,
     std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status, EventPtr shutdown_event, AccumulatorPtr pipeline_latency_accumulator,
     EventPtr network_group_activated_event, hailo_status &output_status) :
     InputVStreamInternal(vstream_info, vstream_params, pipeline_entry, std::move(pipeline), std::move(pipeline_status),
-        shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), output_status)
+        shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), output_status),
+    m_readiness_queue(nullptr),
+    m_readiness_pool(nullptr),
+    m_readiness_event(nullptr)
 {
     if (HAILO_SUCCESS != output_status) {
         return;
     }
+    m_readiness_queue = find_input_readiness_queue(m_entry_element);
+    auto entry_filter = dynamic_cast<FilterElement*>(m_entry_element.get());
+    if (nullptr != entry_filter) {
+        m_readiness_pool = entry_filter->get_buffer_pool();
+    }
     LOGGER__INFO("Creating {}...", name());
 }
 
@@ -1015,6 +1392,35 @@ InputVStreamImpl::~InputVStreamImpl()
 }
 
 hailo_status InputVStreamImpl::write(const MemoryView &buffer)
+{
+    return write_buffer(PipelineBuffer(buffer, m_measure_pipeline_latency));
+}
+
+hailo_status InputVStreamImpl::write(const MemoryView &buffer, const hailo_frame_layout_t &layout)
+{
+    CHECK(!FramePreprocessor::is_enabled(m_vstream_params.preprocess_params), HAILO_NOT_SUPPORTED,
+        "Frame layouts are not supported with preprocessing (vstream {})", name());
+    if (nullptr == dynamic_cast<PreInferElement*>(m_entry_element.get())) {
+        /* No transformation in the pipeline - the frame has to be packed before it's sent */
+        if (m_packed_frame.size() != get_frame_size()) {
+            auto packed_frame = Buffer::create(get_frame_size());
+            CHECK_EXPECTED_AS_STATUS(packed_frame);
+            m_packed_frame = packed_frame.release();
+        }
+        auto status = TransformContextUtils::pack_frame(buffer, layout, m_vstream_info.shape,
+            m_vstream_params.user_buffer_format, MemoryView(m_packed_frame));
+        CHECK_SUCCESS(status, "Failed packing frame for vstream {}", name());
+        return write(MemoryView(m_packed_frame));
+    }
+
+    PipelineBuffer pipeline_buffer(buffer, m_measure_pipeline_latency);
+    auto metadata = pipeline_buffer.get_metadata();
+    metadata.set_frame_layout(layout);
+    pipeline_buffer.set_metadata(std::move(metadata));
+    return write_buffer(std::move(pipeline_buffer));
+}
+
+hailo_status InputVStreamImpl::write_buffer(PipelineBuffer &&buffer, PipelineBuffer &&output_buffer)
 {
     if (nullptr != m_network_group_activated_event) {
         CHECK(m_is_activated, HAILO_VSTREAM_PIPELINE_NOT_ACTIVATED, "Failed to write buffer! Virtual stream {} is not activated!", name());
@@ -1023,7 +1429,10 @@ hailo_status InputVStreamImpl::write(const MemoryView &buffer)
             "Trying to write to vstream {} before its network group is activated", name());
     }
 
-    auto status = m_entry_element->run_push(PipelineBuffer(buffer, m_measure_pipeline_latency));
+    // The output buffer is acquired from the entry's pool (see try_write)
+    auto status = output_buffer ?
+        static_cast<FilterElement&>(*m_entry_element).run_push_into_buffer(std::move(buffer), std::move(output_buffer)) :
+        m_entry_element->run_push(std::move(buffer));
     if (HAILO_SHUTDOWN_EVENT_SIGNALED == status) {
         LOGGER__INFO("Sending to VStream was shutdown!");
         status = m_pipeline_status->load();
@@ -1032,9 +1441,55 @@ hailo_status InputVStreamImpl::write(const MemoryView &buffer)
         LOGGER__INFO("Sending to VStream was aborted!");
         return HAILO_STREAM_ABORTED_BY_USER;
     }
+    if ((HAILO_SUCCESS == status) && (nullptr != m_metrics)) {
+        m_metrics->add_frame();
+    }
     return status;
 }
 
+hailo_status InputVStreamImpl::try_write(const MemoryView &buffer)
+{
+    CHECK(nullptr != m_readiness_queue, HAILO_NOT_SUPPORTED,
+        "try_write is not supported for vstream {}, since its pipeline has no queue", name());
+
+    // Only the user's thread pushes into the queue, so if it isn't full now, write won't wait for space in it
+    if (m_readiness_queue->is_queue_full()) {
+        return HAILO_TIMEOUT;
+    }
+    if (nullptr == m_readiness_pool) {
+        return write(buffer);
+    }
+
+    // The transformed frame's buffer is acquired here without waiting, instead of by the entry element
+    auto output_buffer = m_readiness_pool->try_acquire_buffer();
+    if (HAILO_TIMEOUT == output_buffer.status()) {
+        return HAILO_TIMEOUT;
+    }
+    if (HAILO_SHUTDOWN_EVENT_SIGNALED == output_buffer.status()) {
+        return m_pipeline_status->load();
+    }
+    CHECK_EXPECTED_AS_STATUS(output_buffer);
+    return write_buffer(PipelineBuffer(buffer, m_measure_pipeline_latency), output_buffer.release());
+}
+
+Expected<EventPtr> InputVStreamImpl::get_readiness_event()
+{
+    CHECK_AS_EXPECTED(nullptr != m_readiness_queue, HAILO_NOT_SUPPORTED,
+        "Readiness event is not supported for vstream {}, since its pipeline has no queue", name());
+    if (nullptr == m_readiness_event) {
+        auto readiness_event = ReadinessEvent::create_shared();
+        CHECK_EXPECTED(readiness_event);
+        auto status = m_readiness_queue->add_queue_not_full_readiness_event(readiness_event.value());
+        CHECK_SUCCESS_AS_EXPECTED(status);
+        if (nullptr != m_readiness_pool) {
+            status = m_readiness_pool->add_free_buffer_readiness_event(readiness_event.value());
+            CHECK_SUCCESS_AS_EXPECTED(status);
+        }
+        m_readiness_event = readiness_event.release();
+    }
+    return m_readiness_event->get_event();
+}
+
 hailo_status InputVStreamImpl::flush()
 {
     auto status = m_entry_element->run_push(PipelineBuffer(PipelineBuffer::Type::FLUSH));
@@ -1086,6 +1541,24 @@ hailo_status InputVStreamClient::write(const MemoryView &buffer)
     return m_client->InputVStream_write(m_handle, buffer);
 }
 
+hailo_status InputVStreamClient::write(const MemoryView &/*buffer*/, const hailo_frame_layout_t &/*layout*/)
+{
+    LOGGER__ERROR("Writing frames with a layout is not supported for multi process vstreams");
+    return HAILO_NOT_SUPPORTED;
+}
+
+hailo_status InputVStreamClient::try_write(const MemoryView &/*buffer*/)
+{
+    LOGGER__ERROR("try_write is not supported for multi process vstreams");
+    return HAILO_NOT_SUPPORTED;
+}
+
+Expected<EventPtr> InputVStreamClient::get_readiness_event()
+{
+    LOGGER__ERROR("Readiness event is not supported for multi process vstreams");
+    return make_unexpected(HAILO_NOT_SUPPORTED);
+}
+
 hailo_status InputVStreamClient::flush()
 {
     return m_client->InputVStream_flush(m_handle);
@@ -1218,18 +1691,23 @@ Expected<std::shared_ptr<OutputVStreamImpl>> OutputVStreamImpl::create(const hai
     CHECK_AS_EXPECTED(1 == pipeline_entry->sources().size(), HAILO_INVALID_ARGUMENT,
         "OutputVStream's entry element is expected to have one source");
 
+    auto entry_element = pipeline_entry;
+    auto vstream_ptr = std::shared_ptr<OutputVStreamImpl>(new OutputVStreamImpl(vstream_info, vstream_params, std::move(pipeline_entry), std::move(pipeline),
+        std::move(pipeline_status), shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), status));
+    CHECK_SUCCESS_AS_EXPECTED(status, "Failed to create virtual stream");
+
     if (nullptr != pipeline_latency_accumulator) {
-        pipeline_entry->sources()[0].set_pull_complete_callback([pipeline_latency_accumulator](const PipelineBuffer::Metadata& metadata) {
+        auto metrics = vstream_ptr->m_metrics;
+        entry_element->sources()[0].set_pull_complete_callback([pipeline_latency_accumulator, metrics](const PipelineBuffer::Metadata& metadata) {
                 const auto duration_sec = std::chrono::duration_cast<std::chrono::duration<double>>(
                     std::chrono::steady_clock::now() - metadata.get_start_time()).count();
                 pipeline_latency_accumulator->add_data_point(duration_sec);
+                if (nullptr != metrics) {
+                    metrics->add_latency(duration_sec);
+                }
             });
     }
 
-    auto vstream_ptr = std::shared_ptr<OutputVStreamImpl>(new OutputVStreamImpl(vstream_info, vstream_params, std::move(pipeline_entry), std::move(pipeline),
-        std::move(pipeline_status), shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), status));
-    CHECK_SUCCESS_AS_EXPECTED(status, "Failed to create virtual stream");
-
     return vstream_ptr;
 }
 
@@ -1250,12 +1728,15 @@ OutputVStreamImpl::OutputVStreamImpl(const hailo_vstream_info_t &vstream_info, c
                                      AccumulatorPtr pipeline_latency_accumulator,
                                      EventPtr network_group_activated_event, hailo_status &output_status) :
     OutputVStreamInternal(vstream_info, vstream_params, pipeline_entry, std::move(pipeline), std::move(pipeline_status),
-                shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), output_status)
+                shutdown_event, pipeline_latency_accumulator, std::move(network_group_activated_event), output_status),
+    m_readiness_queue(nullptr)
 {
     if (HAILO_SUCCESS != output_status) {
         return;
     }
 
+    m_readiness_queue = find_output_readiness_queue(m_entry_element);
+
     for (auto &element : m_pipeline) {
         element->set_on_cant_pull_callback([this] () {
             if (m_cant_read_callback) {
@@ -1306,9 +1787,31 @@ hailo_status OutputVStreamImpl::read(MemoryView buffer)
         m_entry_element->wait_for_finish();
         return HAILO_STREAM_ABORTED_BY_USER;
     }
+    if ((HAILO_SUCCESS == status) && (nullptr != m_metrics)) {
+        m_metrics->add_frame();
+    }
     return status;
 }
 
+hailo_status OutputVStreamImpl::try_read(MemoryView buffer)
+{
+    CHECK(nullptr != m_readiness_queue, HAILO_NOT_SUPPORTED,
+        "try_read is not supported for vstream {}, since its pipeline has no queue", name());
+
+    // Only the user's thread dequeues from the queue, so if it isn't empty now, read won't wait for a frame
+    if (m_readiness_queue->is_queue_empty()) {
+        return HAILO_TIMEOUT;
+    }
+    return read(std::move(buffer));
+}
+
+Expected<EventPtr> OutputVStreamImpl::get_readiness_event()
+{
+    CHECK_AS_EXPECTED(nullptr != m_readiness_queue, HAILO_NOT_SUPPORTED,
+        "Readiness event is not supported for vstream {}, since its pipeline has no queue", name());
+    return m_readiness_queue->get_queue_not_empty_event();
+}
+
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wreturn-type"
@@ -1349,6 +1852,18 @@ hailo_status OutputVStreamClient::read(MemoryView buffer)
     return m_client->OutputVStream_read(m_handle, buffer);
 }
 
+hailo_status OutputVStreamClient::try_read(MemoryView /*buffer*/)
+{
+    LOGGER__ERROR("try_read is not supported for multi process vstreams");
+    return HAILO_NOT_SUPPORTED;
+}
+
+Expected<EventPtr> OutputVStreamClient::get_readiness_event()
+{
+    LOGGER__ERROR("Readiness event is not supported for multi process vstreams");
+    return make_unexpected(HAILO_NOT_SUPPORTED);
+}
+
 hailo_status OutputVStreamClient::abort()
 {
     auto channel = grpc::CreateChannel(HAILO_DEFAULT_UDS_ADDR, grpc::InsecureChannelCredentials());
@@ -1750,40 +2265,6 @@ std::string HwWriteElement::description() const
     return element_description.str();
 }
 
-Expected<std::shared_ptr<CopyBufferElement>> CopyBufferElement::create(const std::string &name,
-    std::shared_ptr<std::atomic<hailo_status>> pipeline_status)
-{
-    auto duration_collector = DurationCollector::create(HAILO_PIPELINE_ELEM_STATS_NONE);
-    CHECK_EXPECTED(duration_collector);
-    auto elem_ptr = make_shared_nothrow<CopyBufferElement>(name, duration_collector.release(), std::move(pipeline_status));
-    CHECK_AS_EXPECTED(nullptr != elem_ptr, HAILO_OUT_OF_HOST_MEMORY);
-
-    LOGGER__INFO("Created {}", elem_ptr->name());
-
-    return elem_ptr;
-}
-
-CopyBufferElement::CopyBufferElement(const std::string &name, DurationCollector &&duration_collector, 
-                                     std::shared_ptr<std::atomic<hailo_status>> pipeline_status) :
-    FilterElement(name, std::move(duration_collector), std::move(pipeline_status))
-{}
-
-PipelinePad &CopyBufferElement::next_pad()
-{
-    // Note: The next elem to be run is downstream from this elem (i.e. buffers are pushed)
-    return *m_sinks[0].prev();
-}
-
-Expected<PipelineBuffer> CopyBufferElement::action(PipelineBuffer &&input, PipelineBuffer &&optional)
-{
-    CHECK_AS_EXPECTED(optional, HAILO_INVALID_ARGUMENT, "Optional buffer must be passed to CopyBufferElement!");
-
-    CHECK_AS_EXPECTED(optional.size() == input.size(), HAILO_INVALID_ARGUMENT, "Optional buffer size does not equal to the input buffer size!");
-    memcpy(optional.data(), input.data(), optional.size());
-
-    return std::move(optional);
-}
-
 Expected<std::pair<std::vector<InputVStream>, std::vector<OutputVStream>>> VStreamsBuilder::create_vstreams(
     ConfiguredNetworkGroup &net_group, bool quantized, hailo_format_type_t format_type,
     const std::string &network_name)
@@ -1830,9 +2311,33 @@ static hailo_vstream_params_t expand_vstream_params_autos(const hailo_stream_inf
     auto local_vstream_params = vstream_params;
     local_vstream_params.user_buffer_format = HailoRTDefaults::expand_auto_format(vstream_params.user_buffer_format,
         stream_info.format);
+    if (0 == local_vstream_params.top_k) {
+        local_vstream_params.top_k = HAILO_DEFAULT_VSTREAM_TOP_K;
+    }
     return local_vstream_params;
 }
 
+// The top k frames hold the k indices followed by the k values of every pixel, instead of all of the features
+static hailo_3d_image_shape_t get_user_buffer_shape(const hailo_3d_image_shape_t &shape,
+    const hailo_vstream_params_t &vstream_params)
+{
+    auto user_buffer_shape = shape;
+    if (HAILO_FORMAT_ORDER_HAILO_TOP_K == vstream_params.user_buffer_format.order) {
+        user_buffer_shape.features = vstream_params.top_k * 2;
+    }
+    return user_buffer_shape;
+}
+
+static hailo_vstream_info_t get_user_buffer_vstream_info(const hailo_vstream_info_t &vstream_info,
+    const hailo_vstream_params_t &vstream_params)
+{
+    auto user_buffer_vstream_info = vstream_info;
+    if (HAILO_FORMAT_ORDER_HAILO_NMS != vstream_info.format.order) {
+        user_buffer_vstream_info.shape = get_user_buffer_shape(vstream_info.shape, vstream_params);
+    }
+    return user_buffer_vstream_info;
+}
+
 Expected<std::vector<InputVStream>> VStreamsBuilder::create_input_vstreams(ConfiguredNetworkGroup &net_group,
     const std::map<std::string, hailo_vstream_params_t> &inputs_params)
 {
@@ -1881,7 +2386,9 @@ Expected<std::vector<InputVStream>> VStreamsBuilderUtils::create_inputs(std::sha
         vstream_params.user_buffer_format, input_stream->get_info().hw_shape, input_stream->get_info().format, 
         input_stream->get_info().quant_info);
 
-    if (should_transform) {
+    const auto should_preprocess = FramePreprocessor::is_enabled(vstream_params.preprocess_params);
+
+    if (should_transform || should_preprocess) {
         std::shared_ptr<SinkElement> elem_after_post_infer = hw_write_elem.value();
         auto queue_elem = PushQueueElement::create(
             PipelineObject::create_element_name("PushQueueElement", input_stream->get_info().name, input_stream->get_info().index),
@@ -1890,16 +2397,28 @@ Expected<std::vector<InputVStream>> VStreamsBuilderUtils::create_inputs(std::sha
         elements.insert(elements.begin(), queue_elem.value());
         CHECK_SUCCESS_AS_EXPECTED(PipelinePad::link_pads(queue_elem.value(), hw_write_elem.value()));
 
-        auto pre_infer_elem = PreInferElement::create(input_stream->get_info().shape, vstream_params.user_buffer_format,
-             input_stream->get_info().hw_shape, input_stream->get_info().format, input_stream->get_info().quant_info, 
-             PipelineObject::create_element_name("PreInferElement", input_stream->get_info().name, input_stream->get_info().index),
-             vstream_params, shutdown_event, pipeline_status);
-        CHECK_EXPECTED(pre_infer_elem);
-        elements.insert(elements.begin(), pre_infer_elem.value());
-        CHECK_SUCCESS_AS_EXPECTED(PipelinePad::link_pads(pre_infer_elem.value(), queue_elem.value()));
+        std::shared_ptr<FilterElement> pre_infer_elem = nullptr;
+        if (should_preprocess) {
+            // The preprocessing element quantizes and reorders the frame itself, so it replaces the PreInferElement
+            auto preprocess_elem = PreprocessElement::create(input_stream->get_info().shape, vstream_params.user_buffer_format,
+                input_stream->get_info().hw_shape, input_stream->get_info().format, input_stream->get_info().quant_info,
+                PipelineObject::create_element_name("PreprocessElement", input_stream->get_info().name, input_stream->get_info().index),
+                vstream_params, shutdown_event, pipeline_status);
+            CHECK_EXPECTED(preprocess_elem);
+            pre_infer_elem = preprocess_elem.release();
+        } else {
+            auto pre_infer_elem_exp = PreInferElement::create(input_stream->get_info().shape, vstream_params.user_buffer_format,
+                 input_stream->get_info().hw_shape, input_stream->get_info().format, input_stream->get_info().quant_info, 
+                 PipelineObject::create_element_name("PreInferElement", input_stream->get_info().name, input_stream->get_info().index),
+                 vstream_params, shutdown_event, pipeline_status);
+            CHECK_EXPECTED(pre_infer_elem_exp);
+            pre_infer_elem = pre_infer_elem_exp.release();
+        }
+        elements.insert(elements.begin(), pre_infer_elem);
+        CHECK_SUCCESS_AS_EXPECTED(PipelinePad::link_pads(pre_infer_elem, queue_elem.value()));
 
         input_stream->set_timeout(user_timeout);
-        auto vstream = InputVStream::create(vstream_info, vstream_params, pre_infer_elem.release(), hw_write_elem.release(), std::move(elements),
+        auto vstream = InputVStream::create(vstream_info, vstream_params, pre_infer_elem, hw_write_elem.release(), std::move(elements),
             std::move(pipeline_status), shutdown_event, network_group_activated_event, pipeline_latency_accumulator.release());
         CHECK_EXPECTED(vstream);
         vstreams.emplace_back(vstream.release());
@@ -1952,6 +2471,13 @@ Expected<std::vector<OutputVStream>> VStreamsBuilderUtils::create_outputs(std::s
     CHECK_AS_EXPECTED(!(hw_read_stream_stats_flags & HAILO_VSTREAM_STATS_MEASURE_FPS), HAILO_NOT_IMPLEMENTED,
         "Pipeline FPS statistics measurement is not implemented");
 
+    if (output_stream->get_info().is_mux) {
+        // The demuxed edges' queues hold the muxed frames (each frame is released once all of the edges were demuxed
+        // from it), so the frame being demuxed and the frame being read are added on top of them
+        static const size_t MUX_HW_READ_EXTRA_BUFFERS = 2;
+        buffer_pool_size += MUX_HW_READ_EXTRA_BUFFERS;
+    }
+
     auto hw_read_elem = HwReadElement::create(output_stream,
         PipelineObject::create_element_name("HwReadElement", output_stream->name(), output_stream->get_info().index),
         HAILO_INFINITE_TIMEOUT, buffer_pool_size, hw_read_element_stats_flags, hw_read_stream_stats_flags, shutdown_event, pipeline_status);
@@ -1974,7 +2500,7 @@ Expected<std::vector<OutputVStream>> VStreamsBuilderUtils::create_outputs(std::s
         CHECK_EXPECTED(pipeline_latency_accumulator);
 
         auto should_transform = OutputTransformContext::is_transformation_required(output_stream->get_info().hw_shape, 
-            output_stream->get_info().format, output_stream->get_info().shape, 
+            output_stream->get_info().format, get_user_buffer_shape(output_stream->get_info().shape, vstream_params),
             vstream_params.user_buffer_format, output_stream->get_info().quant_info);
 
         if (should_transform) {
@@ -1986,7 +2512,8 @@ Expected<std::vector<OutputVStream>> VStreamsBuilderUtils::create_outputs(std::s
             CHECK_SUCCESS_AS_EXPECTED(PipelinePad::link_pads(hw_read_elem.value(), hw_read_queue_elem.value()));
 
             auto post_infer_elem = PostInferElement::create(output_stream->get_info().hw_shape, output_stream->get_info().format, 
-                output_stream->get_info().shape, vstream_params.user_buffer_format, output_stream->get_info().quant_info, output_stream->get_info().nms_info,
+                get_user_buffer_shape(output_stream->get_info().shape, vstream_params), vstream_params.user_buffer_format,
+                output_stream->get_info().quant_info, output_stream->get_info().nms_info,
                 PipelineObject::create_element_name("PostInferElement", output_stream->name(), output_stream->get_info().index),
                 vstream_params, pipeline_status);
             CHECK_EXPECTED(post_infer_elem);
@@ -2002,13 +2529,15 @@ Expected<std::vector<OutputVStream>> VStreamsBuilderUtils::create_outputs(std::s
 
             output_stream->set_timeout(std::chrono::milliseconds(HAILO_INFINITE));
             hw_read_queue_elem->get()->set_timeout(std::chrono::milliseconds(HAILO_INFINITE));
-            auto vstream = OutputVStream::create(vstream_info->second, vstream_params, post_infer_queue_elem.release(), std::move(elements),
+            auto vstream = OutputVStream::create(get_user_buffer_vstream_info(vstream_info->second, vstream_params), vstream_params,
+                post_infer_queue_elem.release(), std::move(elements),
                 std::move(pipeline_status), shutdown_event, network_group_activated_event, pipeline_latency_accumulator.release());
             CHECK_EXPECTED(vstream);
             vstreams.emplace_back(vstream.release());
         } else {
             output_stream->set_timeout(std::chrono::milliseconds(vstream_params.timeout_ms));
-            auto vstream = OutputVStream::create(vstream_info->second, vstream_params, hw_read_elem.release(), std::move(elements),
+            auto vstream = OutputVStream::create(get_user_buffer_vstream_info(vstream_info->second, vstream_params), vstream_params,
+                hw_read_elem.release(), std::move(elements),
                 std::move(pipeline_status), shutdown_event, network_group_activated_event, pipeline_latency_accumulator.release());
             CHECK_EXPECTED(vstream);
             vstreams.emplace_back(vstream.release());
@@ -2108,8 +2637,10 @@ hailo_status VStreamsBuilderUtils::add_demux(std::shared_ptr<OutputStream> outpu
     auto expected_demuxer = OutputDemuxer::create(*output_stream);
     CHECK_EXPECTED_AS_STATUS(expected_demuxer);
 
-    std::shared_ptr<OutputDemuxer> demuxer_ptr = expected_demuxer.release();
-    CHECK(nullptr != demuxer_ptr, HAILO_OUT_OF_HOST_MEMORY);
+    std::shared_ptr<OutputDemuxer> demuxer = expected_demuxer.release();
+    CHECK(nullptr != demuxer, HAILO_OUT_OF_HOST_MEMORY);
+    // Note: OutputDemuxer::create always creates an OutputDemuxerBase (whose edges can be demuxed separately)
+    auto demuxer_ptr = std::static_pointer_cast<OutputDemuxerBase>(demuxer);
 
     auto status = output_stream->set_timeout(HAILO_INFINITE_TIMEOUT);
     CHECK_SUCCESS(status);
@@ -2117,17 +2648,13 @@ hailo_status VStreamsBuilderUtils::add_demux(std::shared_ptr<OutputStream> outpu
     // Note: In case of multiple values in vstreams_params_map (e.g. in the case of demux), we'll set the
     //       pipeline_elements_stats_flags for the demux_elem as bitwise or of all the flags.
     hailo_pipeline_elem_stats_flags_t demux_elem_stats_flags = HAILO_PIPELINE_ELEM_STATS_NONE;
-    hailo_vstream_stats_flags_t demux_vstream_stats_flags = HAILO_VSTREAM_STATS_NONE;
-    size_t buffer_pool_size = 0;
     for (const auto &elem_name_params : vstreams_params_map) {
         demux_elem_stats_flags |= elem_name_params.second.pipeline_elements_stats_flags;
-        demux_vstream_stats_flags |= elem_name_params.second.vstream_stats_flags;
-        buffer_pool_size += elem_name_params.second.queue_size;
     }
 
     auto demux_elem = TransformDemuxElement::create(demuxer_ptr,
         PipelineObject::create_element_name("TransformDemuxElement", output_stream->name(), output_stream->get_info().index),
-        std::chrono::milliseconds(HAILO_INFINITE), buffer_pool_size, demux_elem_stats_flags, demux_vstream_stats_flags, shutdown_event, pipeline_status);
+        std::chrono::milliseconds(HAILO_INFINITE), demux_elem_stats_flags, pipeline_status);
     CHECK_EXPECTED_AS_STATUS(demux_elem);
     base_elements.push_back(demux_elem.value());
     CHECK_SUCCESS(PipelinePad::link_pads(hw_read_elem, demux_elem.value()));
@@ -2167,16 +2694,29 @@ hailo_status VStreamsBuilderUtils::add_demux(std::shared_ptr<OutputStream> outpu
         CHECK_EXPECTED_AS_STATUS(pipeline_latency_accumulator);
 
         auto should_transform = OutputTransformContext::is_transformation_required(edge_info.hw_shape, 
-            edge_info.format, edge_info.shape, vstream_params.user_buffer_format, edge_info.quant_info);
+            edge_info.format, get_user_buffer_shape(edge_info.shape, vstream_params), vstream_params.user_buffer_format,
+            edge_info.quant_info);
+
+        // Without a transformation, the edge is demuxed directly into the user's buffer. Otherwise, it's demuxed into
+        // a single buffer, which is transformed into the user's buffer right away (on the same thread).
+        const size_t demux_edge_buffer_pool_size = should_transform ? 1 : 0;
+        auto demux_edge_elem = DemuxEdgeElement::create(demuxer_ptr, i,
+            PipelineObject::create_element_name("DemuxEdgeElement", edge_info.name, edge_info.index),
+            std::chrono::milliseconds(HAILO_INFINITE), demux_edge_buffer_pool_size, vstream_params.pipeline_elements_stats_flags,
+            vstream_params.vstream_stats_flags, shutdown_event, pipeline_status);
+        CHECK_EXPECTED_AS_STATUS(demux_edge_elem);
+        current_vstream_elements.push_back(demux_edge_elem.value());
+        CHECK_SUCCESS(PipelinePad::link_pads(demux_queue_elem.value(), demux_edge_elem.value()));
 
         if (should_transform) {
             auto post_infer_elem = PostInferElement::create(edge_info.hw_shape, edge_info.format, 
-                edge_info.shape, vstream_params.user_buffer_format, edge_info.quant_info, edge_info.nms_info,
+                get_user_buffer_shape(edge_info.shape, vstream_params), vstream_params.user_buffer_format, edge_info.quant_info,
+                edge_info.nms_info,
                 PipelineObject::create_element_name("PostInferElement", edge_info.name, edge_info.index),
                 vstream_params, pipeline_status);
             CHECK_EXPECTED_AS_STATUS(post_infer_elem);
             current_vstream_elements.push_back(post_infer_elem.value());
-            CHECK_SUCCESS(PipelinePad::link_pads(demux_queue_elem.value(), post_infer_elem.value()));
+            CHECK_SUCCESS(PipelinePad::link_pads(demux_edge_elem.value(), post_infer_elem.value()));
 
             auto post_infer_queue_elem = UserBufferQueueElement::create(
                 PipelineObject::create_element_name("UserBufferQueueElement_post_infer", edge_info.name, edge_info.index),
@@ -2185,20 +2725,14 @@ hailo_status VStreamsBuilderUtils::add_demux(std::shared_ptr<OutputStream> outpu
             current_vstream_elements.push_back(post_infer_queue_elem.value());
             CHECK_SUCCESS(PipelinePad::link_pads(post_infer_elem.value(), post_infer_queue_elem.value()));
 
-            auto vstream = OutputVStream::create(vstream_info->second, vstream_params, post_infer_queue_elem.release(), std::move(current_vstream_elements),
+            auto vstream = OutputVStream::create(get_user_buffer_vstream_info(vstream_info->second, vstream_params), vstream_params,
+                post_infer_queue_elem.release(), std::move(current_vstream_elements),
                 std::move(pipeline_status_copy), shutdown_event, network_group_activated_event, pipeline_latency_accumulator.release());
             CHECK_EXPECTED_AS_STATUS(vstream);
             vstreams.emplace_back(vstream.release());
         } else {
-            // TODO: HRT-4179
-            auto user_copy_elem = CopyBufferElement::create(
-                PipelineObject::create_element_name("CopyBufferElement", edge_info.name, edge_info.index),
-                pipeline_status);
-            CHECK_EXPECTED_AS_STATUS(user_copy_elem);
-            current_vstream_elements.push_back(user_copy_elem.value());
-            CHECK_SUCCESS(PipelinePad::link_pads(demux_queue_elem.value(), user_copy_elem.value()));
-
-            auto vstream = OutputVStream::create(vstream_info->second, vstream_params, user_copy_elem.release(), std::move(current_vstream_elements),
+            auto vstream = OutputVStream::create(get_user_buffer_vstream_info(vstream_info->second, vstream_params), vstream_params,
+                demux_edge_elem.release(), std::move(current_vstream_elements),
                 std::move(pipeline_status_copy), shutdown_event, network_group_activated_event, pipeline_latency_accumulator.release());
             CHECK_EXPECTED_AS_STATUS(vstream);
             vstreams.emplace_back(vstream.release());
@@ -2415,7 +2949,7 @@ Expected<AccumulatorPtr> VStreamsBuilderUtils::create_pipeline_latency_accumulat
     AccumulatorPtr pipeline_latency_accumulator = nullptr;
     const auto measure_latency = ((vstreams_params.vstream_stats_flags & HAILO_VSTREAM_STATS_MEASURE_LATENCY) != 0);
     if (measure_latency) {
-        pipeline_latency_accumulator = make_shared_nothrow<FullAccumulator<double>>("latency");
+        pipeline_latency_accumulator = make_shared_nothrow<HistogramAccumulator<double>>("latency");
         CHECK_AS_EXPECTED(nullptr != pipeline_latency_accumulator, HAILO_OUT_OF_HOST_MEMORY);
     }
 
@@ -28,9 +28,12 @@
 
 #include "pipeline.hpp"
 #include "hef_internal.hpp"
+#include "transform_internal.hpp"
+#include "preprocess.hpp"
 #include "net_flow/ops/yolo_post_processing.hpp"
 #include "hailo/transform.hpp"
 #include "hailo/stream.hpp"
+#include "hailo/metrics.hpp"
 #include "context_switch/network_group_internal.hpp"
 
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
@@ -40,6 +43,37 @@
 namespace hailort
 {
 
+/*! Publishes a vstream's frame count, pipeline latency and queue sizes to the MetricsRegistry */
+class VStreamMetrics final : public MetricsCollector
+{
+public:
+    // Metrics are best effort - returns nullptr (after logging) if they could not be created
+    static std::shared_ptr<VStreamMetrics> create(const hailo_vstream_info_t &vstream_info,
+        const std::vector<std::shared_ptr<PipelineElement>> &pipeline, bool measure_latency);
+
+    VStreamMetrics(std::shared_ptr<MetricCounter> &&frames, std::shared_ptr<MetricHistogram> &&latency,
+        std::vector<std::pair<std::weak_ptr<BaseQueueElement>, std::shared_ptr<MetricGauge>>> &&queue_sizes);
+
+    void add_frame()
+    {
+        m_frames->inc();
+    }
+
+    void add_latency(double duration_sec)
+    {
+        if (nullptr != m_latency) {
+            m_latency->observe(duration_sec);
+        }
+    }
+
+    virtual void collect() override;
+
+private:
+    std::shared_ptr<MetricCounter> m_frames;
+    std::shared_ptr<MetricHistogram> m_latency;
+    std::vector<std::pair<std::weak_ptr<BaseQueueElement>, std::shared_ptr<MetricGauge>>> m_queue_sizes;
+};
+
 /*! Virtual stream base class */
 class BaseVStream
 {
@@ -65,6 +99,8 @@ public:
     virtual hailo_status stop_vstream();
     virtual hailo_status stop_and_clear();
 
+    EventPtr get_shutdown_event() const;
+
 protected:
     BaseVStream(const hailo_vstream_info_t &vstream_info, const hailo_vstream_params_t &vstream_params,
         std::shared_ptr<PipelineElement> pipeline_entry, std::vector<std::shared_ptr<PipelineElement>> &&pipeline,
@@ -88,6 +124,7 @@ protected:
     std::map<std::string, AccumulatorPtr> m_latency_accumulators;
     std::map<std::string, std::vector<AccumulatorPtr>> m_queue_size_accumulators;
     AccumulatorPtr m_pipeline_latency_accumulator;
+    std::shared_ptr<VStreamMetrics> m_metrics;
 };
 
 /*! Input virtual stream, used to stream data to device */
@@ -104,7 +141,10 @@ public:
     virtual ~InputVStreamInternal() = default;
 
     virtual hailo_status write(const MemoryView &buffer) = 0;
+    virtual hailo_status write(const MemoryView &buffer, const hailo_frame_layout_t &layout) = 0;
+    virtual hailo_status try_write(const MemoryView &buffer) = 0;
     virtual hailo_status flush() = 0;
+    virtual Expected<EventPtr> get_readiness_event() = 0;
 
     virtual std::string get_pipeline_description() const override;
 
@@ -131,6 +171,8 @@ public:
 
 
     virtual hailo_status read(MemoryView buffer) = 0;
+    virtual hailo_status try_read(MemoryView buffer) = 0;
+    virtual Expected<EventPtr> get_readiness_event() = 0;
     virtual std::string get_pipeline_description() const override;
 
 protected:
@@ -156,12 +198,27 @@ public:
     virtual ~InputVStreamImpl();
 
     virtual hailo_status write(const MemoryView &buffer) override;
+    virtual hailo_status write(const MemoryView &buffer, const hailo_frame_layout_t &layout) override;
+    virtual hailo_status try_write(const MemoryView &buffer) override;
     virtual hailo_status flush() override;
+    virtual Expected<EventPtr> get_readiness_event() override;
 private:
     InputVStreamImpl(const hailo_vstream_info_t &vstream_info, const hailo_vstream_params_t &vstream_params,
         std::shared_ptr<PipelineElement> pipeline_entry, std::vector<std::shared_ptr<PipelineElement>> &&pipeline,
         std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status, EventPtr shutdown_event, AccumulatorPtr pipeline_latency_accumulator,
         EventPtr network_group_activated_event, hailo_status &output_status);
+
+    hailo_status write_buffer(PipelineBuffer &&buffer, PipelineBuffer &&output_buffer = PipelineBuffer());
+
+    // The queue whose fill level determines whether a write would block (nullptr if the pipeline has no queue)
+    BaseQueueElement *m_readiness_queue;
+    // The pool that the entry element acquires the transformed frames from, a write blocks while it has no free
+    // buffer as well (nullptr if the entry element has no pool)
+    BufferPoolPtr m_readiness_pool;
+    // Signaled while both the queue has space and the pool has a free buffer (created on the first get_readiness_event)
+    ReadinessEventPtr m_readiness_event;
+    // Used to pack frames with a layout, when the pipeline doesn't transform the data (allocated on first use)
+    Buffer m_packed_frame;
 };
 
 class OutputVStreamImpl : public OutputVStreamInternal
@@ -179,6 +236,8 @@ public:
     virtual ~OutputVStreamImpl();
 
     virtual hailo_status read(MemoryView buffer);
+    virtual hailo_status try_read(MemoryView buffer) override;
+    virtual Expected<EventPtr> get_readiness_event() override;
 
     void set_on_vstream_cant_read_callback(std::function<void()> callback)
     {
@@ -198,6 +257,8 @@ private:
 
     std::function<void()> m_cant_read_callback;
     std::function<void()> m_can_read_callback;
+    // The queue whose fill level determines whether a read would block (nullptr if the pipeline has no queue)
+    BaseQueueElement *m_readiness_queue;
 };
 
 #ifdef HAILO_SUPPORT_MULTI_PROCESS
@@ -212,7 +273,10 @@ public:
     virtual ~InputVStreamClient();
 
     virtual hailo_status write(const MemoryView &buffer) override;
+    virtual hailo_status write(const MemoryView &buffer, const hailo_frame_layout_t &layout) override;
+    virtual hailo_status try_write(const MemoryView &buffer) override;
     virtual hailo_status flush() override;
+    virtual Expected<EventPtr> get_readiness_event() override;
 
     virtual hailo_status abort() override;
     virtual hailo_status resume() override;
@@ -248,6 +312,8 @@ public:
     virtual ~OutputVStreamClient();
 
     virtual hailo_status read(MemoryView buffer);
+    virtual hailo_status try_read(MemoryView buffer) override;
+    virtual Expected<EventPtr> get_readiness_event() override;
 
     virtual hailo_status abort() override;
     virtual hailo_status resume() override;
@@ -289,6 +355,7 @@ public:
     virtual ~PreInferElement() = default;
 
     virtual Expected<PipelineBuffer> run_pull(PipelineBuffer &&optional, const PipelinePad &source) override;
+    virtual BufferPoolPtr get_buffer_pool() const override;
     virtual std::vector<AccumulatorPtr> get_queue_size_accumulators() override;
     virtual PipelinePad &next_pad() override;
     virtual std::string description() const override;
@@ -302,6 +369,34 @@ private:
     std::chrono::milliseconds m_timeout;
 };
 
+// Converts the camera frames to the network's input (see FramePreprocessor), in place of PreInferElement
+class PreprocessElement : public FilterElement
+{
+public:
+    static Expected<std::shared_ptr<PreprocessElement>> create(const hailo_3d_image_shape_t &src_image_shape, const hailo_format_t &src_format,
+        const hailo_3d_image_shape_t &dst_image_shape, const hailo_format_t &dst_format, const hailo_quant_info_t &dst_quant_info,
+        const std::string &name, const hailo_vstream_params_t &vstream_params, EventPtr shutdown_event,
+        std::shared_ptr<std::atomic<hailo_status>> pipeline_status);
+    PreprocessElement(std::unique_ptr<FramePreprocessor> &&preprocessor, BufferPoolPtr buffer_pool,
+        const std::string &name, std::chrono::milliseconds timeout, DurationCollector &&duration_collector,
+        std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status);
+    virtual ~PreprocessElement() = default;
+
+    virtual Expected<PipelineBuffer> run_pull(PipelineBuffer &&optional, const PipelinePad &source) override;
+    virtual BufferPoolPtr get_buffer_pool() const override;
+    virtual std::vector<AccumulatorPtr> get_queue_size_accumulators() override;
+    virtual PipelinePad &next_pad() override;
+    virtual std::string description() const override;
+
+protected:
+    virtual Expected<PipelineBuffer> action(PipelineBuffer &&input, PipelineBuffer &&optional) override;
+
+private:
+    std::unique_ptr<FramePreprocessor> m_preprocessor;
+    BufferPoolPtr m_pool;
+    std::chrono::milliseconds m_timeout;
+};
+
 class PostInferElement : public FilterElement
 {
 public:
@@ -376,23 +471,49 @@ private:
     BufferPoolPtr m_pool;
 };
 
+// Passes the muxed frame to all of the edges (without copying it) - each edge is demuxed by its DemuxEdgeElement
 class TransformDemuxElement : public BaseDemuxElement
 {
 public:
     static Expected<std::shared_ptr<TransformDemuxElement>> create(std::shared_ptr<OutputDemuxer> demuxer,
+        const std::string &name, std::chrono::milliseconds timeout, hailo_pipeline_elem_stats_flags_t elem_flags,
+        std::shared_ptr<std::atomic<hailo_status>> pipeline_status);
+    TransformDemuxElement(std::shared_ptr<OutputDemuxer> demuxer, const std::string &name,
+        std::chrono::milliseconds timeout, DurationCollector &&duration_collector, std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status);
+
+protected:
+    virtual Expected<std::vector<PipelineBuffer>> action(PipelineBuffer &&input) override;
+
+private:
+    std::shared_ptr<OutputDemuxer> m_demuxer;
+};
+
+// Copies the rows of a single edge out of the muxed frame. The edge is demuxed directly into the optional buffer (the
+// user's buffer, when no transformation is needed), otherwise into a buffer acquired from the pool.
+class DemuxEdgeElement : public FilterElement
+{
+public:
+    static Expected<std::shared_ptr<DemuxEdgeElement>> create(std::shared_ptr<OutputDemuxerBase> demuxer, size_t edge_index,
         const std::string &name, std::chrono::milliseconds timeout, size_t buffer_pool_size, hailo_pipeline_elem_stats_flags_t elem_flags,
         hailo_vstream_stats_flags_t vstream_flags, EventPtr shutdown_event, std::shared_ptr<std::atomic<hailo_status>> pipeline_status);
-    TransformDemuxElement(std::shared_ptr<OutputDemuxer> demuxer, std::vector<BufferPoolPtr> &&pools, const std::string &name,
-        std::chrono::milliseconds timeout, DurationCollector &&duration_collector, std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status);
+    DemuxEdgeElement(std::shared_ptr<OutputDemuxerBase> demuxer, size_t edge_index, BufferPoolPtr buffer_pool,
+        const std::string &name, std::chrono::milliseconds timeout, DurationCollector &&duration_collector,
+        std::shared_ptr<std::atomic<hailo_status>> &&pipeline_status);
+    virtual ~DemuxEdgeElement() = default;
 
+    virtual hailo_status run_push(PipelineBuffer &&buffer) override;
     virtual std::vector<AccumulatorPtr> get_queue_size_accumulators() override;
+    virtual PipelinePad &next_pad() override;
 
 protected:
-    virtual Expected<std::vector<PipelineBuffer>> action(PipelineBuffer &&input) override;
+    virtual Expected<PipelineBuffer> action(PipelineBuffer &&input, PipelineBuffer &&optional) override;
 
 private:
-    std::shared_ptr<OutputDemuxer> m_demuxer;
-    std::vector<BufferPoolPtr> m_pools;
+    std::shared_ptr<OutputDemuxerBase> m_demuxer;
+    const size_t m_edge_index;
+    // nullptr if the optional buffer is always passed (i.e. the edge is demuxed into the user's buffer)
+    BufferPoolPtr m_pool;
+    std::chrono::milliseconds m_timeout;
 };
 
 class HwReadElement : public SourceElement
@@ -457,18 +578,6 @@ private:
     EventPtr m_got_flush_event;
 };
 
-class CopyBufferElement : public FilterElement
-{
-public:
-    static Expected<std::shared_ptr<CopyBufferElement>> create(const std::string &name, std::shared_ptr<std::atomic<hailo_status>> pipeline_status);
-    CopyBufferElement(const std::string &name, DurationCollector &&duration_collector, std::shared_ptr<std::atomic<hailo_status>> pipeline_status);
-    virtual ~CopyBufferElement() = default;
-    virtual PipelinePad &next_pad() override;
-
-protected:
-    virtual Expected<PipelineBuffer> action(PipelineBuffer &&input, PipelineBuffer &&optional) override;
-};
-
 class VStreamsBuilderUtils
 {
 public:
@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file eth_control_channel_tests.cpp
+ * @brief Tests of EthernetControlChannel against a local UDP stand-in of the FW control responder
+ **/
+
+#include "eth_control_channel.hpp"
+#include "byte_order.h"
+
+#include <catch2/catch.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace hailort;
+
+namespace {
+
+constexpr std::chrono::milliseconds CONTROL_TIMEOUT(50);
+constexpr uint8_t CONTROL_MAX_ATTEMPTS = 4;
+
+struct FakeFwBehavior {
+    // The first response of every n'th control is dropped (0 never drops)
+    uint32_t drop_first_response_every = 0;
+    bool drop_all_responses = false;
+    // Responses are held, and sent in reverse order once there are this many (or when no request arrives for a while)
+    size_t reorder_window = 1;
+    // Each response is sent again later, after the responses of the following requests
+    bool send_late_duplicates = false;
+};
+
+// A control request echoed by the responder, so every response can be matched to the control it answers
+struct TestRequest {
+    CONTROL_PROTOCOL__request_header_t header;
+    uint32_t value;
+};
+
+struct TestResponse {
+    CONTROL_PROTOCOL__response_header_t header;
+    uint32_t value;
+};
+
+// Answers the controls like the FW - a control is handled once per sequence, and a duplicated control (sent again
+// with the same sequence) is answered again without handling it
+class FakeFwControlResponder final {
+public:
+    explicit FakeFwControlResponder(const FakeFwBehavior &behavior) :
+        m_behavior(behavior), m_socket(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)), m_is_running(true),
+        m_handled_count(0), m_duplicates_count(0)
+    {
+        REQUIRE(0 <= m_socket);
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        REQUIRE(0 == bind(m_socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)));
+        socklen_t address_length = sizeof(address);
+        REQUIRE(0 == getsockname(m_socket, reinterpret_cast<struct sockaddr*>(&address), &address_length));
+        m_port = ntohs(address.sin_port);
+
+        // Held responses are flushed when no request arrives for this long
+        struct timeval timeout = {0, 5000};
+        REQUIRE(0 == setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)));
+
+        m_thread = std::thread([this]() { serve(); });
+    }
+
+    ~FakeFwControlResponder()
+    {
+        m_is_running = false;
+        m_thread.join();
+        close(m_socket);
+    }
+
+    uint16_t port() const { return m_port; }
+    // Valid once the responder is destroyed, or while no controls are sent
+    uint32_t handled_count() const { return m_handled_count; }
+    uint32_t duplicates_count() const { return m_duplicates_count; }
+
+    // How many times each value was handled
+    std::map<uint32_t, uint32_t> handled_values() const { return m_handled_values; }
+
+private:
+    struct HeldResponse {
+        TestResponse response;
+        struct sockaddr_in address;
+    };
+
+    void serve()
+    {
+        std::vector<HeldResponse> held_responses;
+        while (m_is_running) {
+            TestRequest request = {};
+            struct sockaddr_in address = {};
+            socklen_t address_length = sizeof(address);
+            const auto received = recvfrom(m_socket, &request, sizeof(request), 0,
+                reinterpret_cast<struct sockaddr*>(&address), &address_length);
+            if (static_cast<ssize_t>(sizeof(request)) != received) {
+                flush(held_responses);
+                continue;
+            }
+
+            const auto sequence = BYTE_ORDER__ntohl(request.header.common_header.sequence);
+            bool is_dropped = m_behavior.drop_all_responses;
+            auto handled = m_responses.find(sequence);
+            if (m_responses.end() == handled) {
+                TestResponse response = {};
+                response.header.common_header = request.header.common_header;
+                response.value = request.value;
+                handled = m_responses.emplace(sequence, response).first;
+                m_handled_values[BYTE_ORDER__ntohl(request.value)]++;
+                m_handled_count++;
+                is_dropped = is_dropped || ((0 != m_behavior.drop_first_response_every) &&
+                    (0 == (m_handled_count % m_behavior.drop_first_response_every)));
+            } else {
+                m_duplicates_count++;
+            }
+
+            if (!is_dropped) {
+                held_responses.push_back(HeldResponse{handled->second, address});
+            }
+            if (held_responses.size() >= m_behavior.reorder_window) {
+                flush(held_responses);
+            }
+        }
+    }
+
+    void flush(std::vector<HeldResponse> &held_responses)
+    {
+        for (const auto &late_duplicate : m_late_duplicates) {
+            send_response(late_duplicate);
+        }
+        m_late_duplicates.clear();
+
+        for (auto it = held_responses.rbegin(); it != held_responses.rend(); it++) {
+            send_response(*it);
+            if (m_behavior.send_late_duplicates) {
+                m_late_duplicates.push_back(*it);
+            }
+        }
+        held_responses.clear();
+    }
+
+    void send_response(const HeldResponse &held_response)
+    {
+        (void)sendto(m_socket, &held_response.response, sizeof(held_response.response), 0,
+            reinterpret_cast<const struct sockaddr*>(&held_response.address), sizeof(held_response.address));
+    }
+
+    const FakeFwBehavior m_behavior;
+    int m_socket;
+    uint16_t m_port;
+    std::atomic<bool> m_is_running;
+    std::thread m_thread;
+    // The response of every handled sequence
+    std::map<uint32_t, TestResponse> m_responses;
+    std::map<uint32_t, uint32_t> m_handled_values;
+    std::vector<HeldResponse> m_late_duplicates;
+    std::atomic<uint32_t> m_handled_count;
+    std::atomic<uint32_t> m_duplicates_count;
+};
+
+// The env var is read when the channel is created
+class MaxOutstandingRequestsGuard final {
+public:
+    explicit MaxOutstandingRequestsGuard(size_t max_outstanding_requests)
+    {
+        setenv(HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS_ENV_VAR, std::to_string(max_outstanding_requests).c_str(), 1);
+    }
+
+    ~MaxOutstandingRequestsGuard()
+    {
+        unsetenv(HAILO_ETH_CONTROL_MAX_OUTSTANDING_REQUESTS_ENV_VAR);
+    }
+};
+
+Udp create_udp(const FakeFwControlResponder &responder)
+{
+    struct in_addr loopback = {};
+    loopback.s_addr = htonl(INADDR_LOOPBACK);
+    auto udp = Udp::create(loopback, responder.port(), loopback, 0);
+    REQUIRE(udp);
+    REQUIRE(HAILO_SUCCESS == udp->set_timeout(CONTROL_TIMEOUT));
+    REQUIRE(HAILO_SUCCESS == udp->set_max_number_of_attempts(CONTROL_MAX_ATTEMPTS));
+    return udp.release();
+}
+
+TestRequest create_request(uint32_t value)
+{
+    TestRequest request = {};
+    request.header.common_header.version = BYTE_ORDER__htonl(CONTROL_PROTOCOL__PROTOCOL_VERSION);
+    request.header.common_header.opcode = BYTE_ORDER__htonl(HAILO_CONTROL_OPCODE_IDENTIFY);
+    request.value = BYTE_ORDER__htonl(value);
+    return request;
+}
+
+// Sends the values as controls (one batch per call), and checks that each got the response to its own control
+void interact(EthernetControlChannel &channel, const std::vector<uint32_t> &values)
+{
+    std::vector<TestRequest> requests;
+    std::vector<TestResponse> responses(values.size());
+    std::vector<CONTROL_PROTOCOL__transaction_t> transactions;
+    for (const auto value : values) {
+        requests.push_back(create_request(value));
+    }
+    for (size_t i = 0; i < values.size(); i++) {
+        transactions.push_back({reinterpret_cast<uint8_t*>(&requests[i]), sizeof(requests[i]),
+            reinterpret_cast<uint8_t*>(&responses[i]), sizeof(responses[i])});
+    }
+
+    REQUIRE(HAILO_SUCCESS == channel.fw_interact_batch(transactions));
+    for (size_t i = 0; i < values.size(); i++) {
+        REQUIRE(sizeof(responses[i]) == transactions[i].response_size);
+        REQUIRE(requests[i].header.common_header.sequence == responses[i].header.common_header.sequence);
+        REQUIRE(values[i] == BYTE_ORDER__ntohl(responses[i].value));
+    }
+}
+
+void require_handled_once(const FakeFwControlResponder &responder, uint32_t values_count)
+{
+    const auto handled_values = responder.handled_values();
+    REQUIRE(values_count == handled_values.size());
+    for (const auto &handled_value : handled_values) {
+        REQUIRE(1 == handled_value.second);
+    }
+}
+
+} /* namespace */
+
+TEST_CASE("Lock step controls are resent with their sequence when responses are dropped", "[eth_control_channel]")
+{
+    FakeFwBehavior behavior;
+    behavior.drop_first_response_every = 3;
+    FakeFwControlResponder responder(behavior);
+    auto udp = create_udp(responder);
+    EthernetControlChannel channel(udp);
+
+    const uint32_t CONTROLS_COUNT = 12;
+    for (uint32_t value = 0; value < CONTROLS_COUNT; value++) {
+        interact(channel, {value});
+    }
+
+    // Every control was handled once - the resent ones were duplicates
+    require_handled_once(responder, CONTROLS_COUNT);
+    REQUIRE(CONTROLS_COUNT / behavior.drop_first_response_every <= responder.duplicates_count());
+}
+
+TEST_CASE("Pipelined controls are matched to reordered responses", "[eth_control_channel]")
+{
+    MaxOutstandingRequestsGuard max_outstanding_requests(4);
+    FakeFwBehavior behavior;
+    behavior.reorder_window = 4;
+    FakeFwControlResponder responder(behavior);
+    auto udp = create_udp(responder);
+    EthernetControlChannel channel(udp);
+
+    std::vector<uint32_t> values;
+    for (uint32_t value = 0; value < 16; value++) {
+        values.push_back(value);
+    }
+    interact(channel, values);
+    require_handled_once(responder, static_cast<uint32_t>(values.size()));
+}
+
+TEST_CASE("Late duplicate responses are discarded", "[eth_control_channel]")
+{
+    MaxOutstandingRequestsGuard max_outstanding_requests(2);
+    FakeFwBehavior behavior;
+    behavior.send_late_duplicates = true;
+    FakeFwControlResponder responder(behavior);
+    auto udp = create_udp(responder);
+    EthernetControlChannel channel(udp);
+
+    for (uint32_t value = 0; value < 8; value++) {
+        interact(channel, {value});
+    }
+    interact(channel, {8, 9, 10, 11, 12});
+    require_handled_once(responder, 13);
+}
+
+TEST_CASE("Concurrent callers share the channel", "[eth_control_channel]")
+{
+    MaxOutstandingRequestsGuard max_outstanding_requests(4);
+    FakeFwBehavior behavior;
+    behavior.drop_first_response_every = 5;
+    behavior.reorder_window = 3;
+    behavior.send_late_duplicates = true;
+    FakeFwControlResponder responder(behavior);
+    auto udp = create_udp(responder);
+    EthernetControlChannel channel(udp);
+
+    const uint32_t THREADS_COUNT = 4;
+    const uint32_t CONTROLS_PER_THREAD = 20;
+    std::atomic<uint32_t> failures_count(0);
+    std::vector<std::thread> threads;
+    for (uint32_t thread_index = 0; thread_index < THREADS_COUNT; thread_index++) {
+        threads.emplace_back([&channel, &failures_count, thread_index, CONTROLS_PER_THREAD]() {
+            // Catch's assertions aren't thread safe, so the responses are checked here and counted
+            for (uint32_t i = 0; i < CONTROLS_PER_THREAD; i += 2) {
+                const uint32_t first_value = (thread_index * CONTROLS_PER_THREAD) + i;
+                auto requests = std::vector<TestRequest>{create_request(first_value), create_request(first_value + 1)};
+                std::vector<TestResponse> responses(requests.size());
+                std::vector<CONTROL_PROTOCOL__transaction_t> transactions;
+                for (size_t j = 0; j < requests.size(); j++) {
+                    transactions.push_back({reinterpret_cast<uint8_t*>(&requests[j]), sizeof(requests[j]),
+                        reinterpret_cast<uint8_t*>(&responses[j]), sizeof(responses[j])});
+                }
+                if (HAILO_SUCCESS != channel.fw_interact_batch(transactions)) {
+                    failures_count++;
+                    continue;
+                }
+                for (size_t j = 0; j < requests.size(); j++) {
+                    if ((first_value + j) != BYTE_ORDER__ntohl(responses[j].value)) {
+                        failures_count++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(0 == failures_count);
+    require_handled_once(responder, THREADS_COUNT * CONTROLS_PER_THREAD);
+}
+
+TEST_CASE("Controls time out once the attempts run out", "[eth_control_channel]")
+{
+    FakeFwBehavior behavior;
+    behavior.drop_all_responses = true;
+    FakeFwControlResponder responder(behavior);
+    auto udp = create_udp(responder);
+    EthernetControlChannel channel(udp);
+
+    auto request = create_request(0);
+    TestResponse response = {};
+    size_t response_size = sizeof(response);
+    REQUIRE(HAILO_TIMEOUT == channel.fw_interact(reinterpret_cast<uint8_t*>(&request), sizeof(request),
+        reinterpret_cast<uint8_t*>(&response), &response_size));
+
+    // All of the attempts carried the same sequence, so the control was handled once
+    require_handled_once(responder, 1);
+    REQUIRE((CONTROL_MAX_ATTEMPTS - 1) == responder.duplicates_count());
+}
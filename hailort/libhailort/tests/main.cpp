@@ -0,0 +1,11 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file main.cpp
+ * @brief Entry point of the libhailort unit tests
+ **/
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
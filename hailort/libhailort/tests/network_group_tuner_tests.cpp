@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2020-2022 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file network_group_tuner_tests.cpp
+ * @brief Tests of the network group tuner's sweep and recommendation, with injected trial results
+ **/
+
+#include "network_group_tuner_internal.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace hailort;
+
+namespace {
+
+using TrialKey = std::tuple<uint16_t, uint32_t, uint32_t>; // batch size, threshold, timeout (ms)
+
+struct FakeTrialResult {
+    double fps;
+    double p99_latency_ms;
+    double power_watts;
+};
+
+const double NO_VALUE = std::numeric_limits<double>::quiet_NaN();
+
+NetworkGroupTunerParams create_params(const std::vector<uint16_t> &batch_sizes, const std::vector<uint32_t> &thresholds,
+    const std::vector<uint32_t> &timeouts_ms, uint32_t max_p99_latency_ms = 0)
+{
+    NetworkGroupTunerParams params{};
+    params.batch_sizes = batch_sizes;
+    params.scheduler_thresholds = thresholds;
+    for (const auto timeout_ms : timeouts_ms) {
+        params.scheduler_timeouts.emplace_back(timeout_ms);
+    }
+    params.max_p99_latency = std::chrono::milliseconds(max_p99_latency_ms);
+    return params;
+}
+
+// Runs the trials by returning the injected results (a trial without an injected result has 100 fps and 10ms
+// latency), and records the trials it was asked to run
+class FakeTrialRunner final {
+public:
+    std::map<TrialKey, FakeTrialResult> results;
+    std::map<uint16_t, hailo_status> failed_batch_sizes;
+    std::vector<TrialKey> runs;
+
+    TunerTrialRunner get()
+    {
+        return [this](uint16_t batch_size, uint32_t threshold, std::chrono::milliseconds timeout,
+            std::vector<TunedNetworkGroupParams> &tuned_params) -> Expected<NetworkGroupTunerTrial> {
+            const TrialKey key{batch_size, threshold, static_cast<uint32_t>(timeout.count())};
+            runs.emplace_back(key);
+
+            const auto failure = failed_batch_sizes.find(batch_size);
+            if (failed_batch_sizes.end() != failure) {
+                return make_unexpected(failure->second);
+            }
+
+            const auto injected = results.find(key);
+            const auto result = (results.end() == injected) ? FakeTrialResult{100, 10, NO_VALUE} : injected->second;
+
+            NetworkGroupTunerTrial trial{};
+            trial.batch_size = batch_size;
+            trial.scheduler_threshold = threshold;
+            trial.scheduler_timeout = timeout;
+            trial.network_groups.emplace_back(NetworkGroupTrialResult{"net", result.fps, result.p99_latency_ms});
+            trial.total_fps = result.fps;
+            trial.max_p99_latency_ms = result.p99_latency_ms;
+            trial.power_watts = result.power_watts;
+            // Set by the sweep
+            trial.meets_latency_bound = false;
+
+            tuned_params = {TunedNetworkGroupParams{"net.hef", "net", batch_size, threshold, timeout}};
+            return trial;
+        };
+    }
+};
+
+Expected<NetworkGroupTunerResult> run_sweep(const NetworkGroupTunerParams &params, FakeTrialRunner &runner)
+{
+    return NetworkGroupTunerSweep::run(params, runner.get(), NetworkGroupTuner::TrialCallback());
+}
+
+TrialKey get_key(const NetworkGroupTunerTrial &trial)
+{
+    return TrialKey{trial.batch_size, trial.scheduler_threshold, static_cast<uint32_t>(trial.scheduler_timeout.count())};
+}
+
+TrialKey get_recommended_key(const NetworkGroupTunerResult &result)
+{
+    return get_key(result.trials.at(result.recommended_trial_index));
+}
+
+} /* namespace */
+
+TEST_CASE("A trial is run for every combination, skipping thresholds above the batch size", "[network_group_tuner]")
+{
+    FakeTrialRunner runner;
+    const auto params = create_params({1, 2, HAILO_DEFAULT_BATCH_SIZE}, {1, 2, 4}, {0, 10});
+
+    size_t callbacks_count = 0;
+    auto result = NetworkGroupTunerSweep::run(params, runner.get(), [&callbacks_count](const NetworkGroupTunerTrial &) {
+        callbacks_count++;
+    });
+    REQUIRE(result);
+
+    const std::vector<TrialKey> expected_runs{
+        TrialKey{1, 1, 0}, TrialKey{1, 1, 10},
+        TrialKey{2, 1, 0}, TrialKey{2, 1, 10}, TrialKey{2, 2, 0}, TrialKey{2, 2, 10},
+        // The default batch size has no bound on the threshold
+        TrialKey{0, 1, 0}, TrialKey{0, 1, 10}, TrialKey{0, 2, 0}, TrialKey{0, 2, 10}, TrialKey{0, 4, 0}, TrialKey{0, 4, 10},
+    };
+    CHECK(expected_runs == runner.runs);
+    REQUIRE(expected_runs.size() == result->trials.size());
+    for (size_t i = 0; i < expected_runs.size(); i++) {
+        CHECK(expected_runs[i] == get_key(result->trials[i]));
+    }
+    CHECK(expected_runs.size() == callbacks_count);
+}
+
+TEST_CASE("A batch size that can't be configured is skipped", "[network_group_tuner]")
+{
+    FakeTrialRunner runner;
+    runner.failed_batch_sizes[2] = HAILO_NOT_SUPPORTED;
+    const auto params = create_params({1, 2, 4}, {1, 2}, {0, 10});
+
+    auto result = run_sweep(params, runner);
+    REQUIRE(result);
+
+    // Batch size 2 is tried once
+    const std::vector<TrialKey> expected_runs{
+        TrialKey{1, 1, 0}, TrialKey{1, 1, 10},
+        TrialKey{2, 1, 0},
+        TrialKey{4, 1, 0}, TrialKey{4, 1, 10}, TrialKey{4, 2, 0}, TrialKey{4, 2, 10},
+    };
+    CHECK(expected_runs == runner.runs);
+    CHECK(6 == result->trials.size());
+}
+
+TEST_CASE("The sweep fails if a trial fails, or if no trial was run", "[network_group_tuner]")
+{
+    SECTION("Failed trial") {
+        FakeTrialRunner runner;
+        runner.failed_batch_sizes[2] = HAILO_TIMEOUT;
+        auto result = run_sweep(create_params({1, 2, 4}, {1}, {0}), runner);
+        CHECK(HAILO_TIMEOUT == result.status());
+        // The sweep stops at the failed trial
+        CHECK(2 == runner.runs.size());
+    }
+
+    SECTION("No supported batch size") {
+        FakeTrialRunner runner;
+        runner.failed_batch_sizes[1] = HAILO_NOT_SUPPORTED;
+        runner.failed_batch_sizes[2] = HAILO_NOT_SUPPORTED;
+        auto result = run_sweep(create_params({1, 2}, {1}, {0}), runner);
+        CHECK(HAILO_INVALID_OPERATION == result.status());
+    }
+}
+
+TEST_CASE("The trial with the best fps within the latency bound is recommended", "[network_group_tuner]")
+{
+    FakeTrialRunner runner;
+    runner.results[TrialKey{1, 1, 0}] = FakeTrialResult{100, 5, NO_VALUE};
+    runner.results[TrialKey{2, 1, 0}] = FakeTrialResult{150, 15, NO_VALUE};
+    // The best fps, but above the bound
+    runner.results[TrialKey{4, 1, 0}] = FakeTrialResult{300, 25, NO_VALUE};
+    const auto params = create_params({1, 2, 4}, {1}, {0}, 20);
+
+    auto result = run_sweep(params, runner);
+    REQUIRE(result);
+    CHECK(result->trials[0].meets_latency_bound);
+    CHECK(result->trials[1].meets_latency_bound);
+    CHECK_FALSE(result->trials[2].meets_latency_bound);
+    CHECK((TrialKey{2, 1, 0}) == get_recommended_key(result.value()));
+
+    // The recommended parameters are the ones the recommended trial ran with
+    REQUIRE(1 == result->recommended_params.size());
+    CHECK(2 == result->recommended_params[0].batch_size);
+    CHECK(1 == result->recommended_params[0].scheduler_threshold);
+    CHECK(std::chrono::milliseconds(0) == result->recommended_params[0].scheduler_timeout);
+
+    SECTION("Without a bound, the best fps is recommended") {
+        auto unbounded_result = run_sweep(create_params({1, 2, 4}, {1}, {0}), runner);
+        REQUIRE(unbounded_result);
+        CHECK((TrialKey{4, 1, 0}) == get_recommended_key(unbounded_result.value()));
+    }
+}
+
+TEST_CASE("Trials with equal fps are compared by power, or by latency", "[network_group_tuner]")
+{
+    SECTION("Lower power wins") {
+        FakeTrialRunner runner;
+        runner.results[TrialKey{1, 1, 0}] = FakeTrialResult{200, 5, 8};
+        // Within 1% of the best fps, with lower power (and higher latency)
+        runner.results[TrialKey{1, 1, 10}] = FakeTrialResult{199, 9, 6};
+        // Not within 1% of the best fps
+        runner.results[TrialKey{1, 1, 50}] = FakeTrialResult{190, 5, 4};
+        auto result = run_sweep(create_params({1}, {1}, {0, 10, 50}), runner);
+        REQUIRE(result);
+        CHECK((TrialKey{1, 1, 10}) == get_recommended_key(result.value()));
+    }
+
+    SECTION("Lower latency wins when the power wasn't measured") {
+        FakeTrialRunner runner;
+        runner.results[TrialKey{1, 1, 0}] = FakeTrialResult{200, 9, NO_VALUE};
+        runner.results[TrialKey{1, 1, 10}] = FakeTrialResult{199, 5, NO_VALUE};
+        runner.results[TrialKey{1, 1, 50}] = FakeTrialResult{190, 1, NO_VALUE};
+        auto result = run_sweep(create_params({1}, {1}, {0, 10, 50}), runner);
+        REQUIRE(result);
+        CHECK((TrialKey{1, 1, 10}) == get_recommended_key(result.value()));
+    }
+}
+
+TEST_CASE("The lowest latency is recommended when no trial is within the bound", "[network_group_tuner]")
+{
+    FakeTrialRunner runner;
+    runner.results[TrialKey{1, 1, 0}] = FakeTrialResult{300, 40, NO_VALUE};
+    runner.results[TrialKey{2, 1, 0}] = FakeTrialResult{200, 30, NO_VALUE};
+    // No frame was read - the latency is unknown, so it's the worst
+    runner.results[TrialKey{4, 1, 0}] = FakeTrialResult{0, NO_VALUE, NO_VALUE};
+    const auto params = create_params({1, 2, 4}, {1}, {0}, 20);
+
+    auto result = run_sweep(params, runner);
+    REQUIRE(result);
+    for (const auto &trial : result->trials) {
+        CHECK_FALSE(trial.meets_latency_bound);
+    }
+    CHECK((TrialKey{2, 1, 0}) == get_recommended_key(result.value()));
+
+    SECTION("A trial without a latency never meets the bound") {
+        auto unbounded_result = run_sweep(create_params({4}, {1}, {0}), runner);
+        REQUIRE(unbounded_result);
+        CHECK_FALSE(unbounded_result->trials[0].meets_latency_bound);
+    }
+}